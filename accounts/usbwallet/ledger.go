@@ -404,14 +404,15 @@ func (w *ledgerDriver) ledgerExchange(opcode ledgerOpcode, p1 ledgerParam1, p2 l
 	apdu = append(apdu, []byte{0xe0, byte(opcode), byte(p1), byte(p2), byte(len(data))}...)
 	apdu = append(apdu, data...)
 
-	// Stream all the chunks to the device
+	// Construct all the chunks to stream to the device
 	header := []byte{0x01, 0x01, 0x05, 0x00, 0x00} // Channel ID and command tag appended
-	chunk := make([]byte, 64)
-	space := len(chunk) - len(header)
+	space := 64 - len(header)
 
+	var chunks [][]byte
 	for i := 0; len(apdu) > 0; i++ {
 		// Construct the new message to stream
-		chunk = append(chunk[:0], header...)
+		chunk := make([]byte, 0, 64)
+		chunk = append(chunk, header...)
 		binary.BigEndian.PutUint16(chunk[3:], uint16(i))
 
 		if len(apdu) > space {
@@ -421,15 +422,24 @@ func (w *ledgerDriver) ledgerExchange(opcode ledgerOpcode, p1 ledgerParam1, p2 l
 			chunk = append(chunk, apdu...)
 			apdu = nil
 		}
-		// Send over to the device
 		w.log.Trace("Data chunk sent to the Ledger", "chunk", hexutil.Bytes(chunk))
-		if _, err := w.device.Write(chunk); err != nil {
+		chunks = append(chunks, chunk)
+	}
+	// Send over to the device, pipelining the chunks if supported
+	if batcher, ok := w.device.(batchWriter); ok {
+		if _, err := batcher.WriteBatch(chunks); err != nil {
 			return nil, err
 		}
+	} else {
+		for _, chunk := range chunks {
+			if _, err := w.device.Write(chunk); err != nil {
+				return nil, err
+			}
+		}
 	}
 	// Stream the reply back from the wallet in 64 byte chunks
 	var reply []byte
-	chunk = chunk[:64] // Yeah, we surely have enough space
+	chunk := make([]byte, 64)
 	for {
 		// Read the next chunk from the Ledger wallet
 		if _, err := io.ReadFull(w.device, chunk); err != nil {
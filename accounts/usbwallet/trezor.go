@@ -250,27 +250,37 @@ func (w *trezorDriver) trezorExchange(req proto.Message, results ...proto.Messag
 	binary.BigEndian.PutUint32(payload[4:], uint32(len(data)))
 	copy(payload[8:], data)
 
-	// Stream all the chunks to the device
-	chunk := make([]byte, 64)
-	chunk[0] = 0x3f // Report ID magic number
-
+	// Construct all the chunks to stream to the device
+	var chunks [][]byte
 	for len(payload) > 0 {
 		// Construct the new message to stream, padding with zeroes if needed
+		chunk := make([]byte, 64)
+		chunk[0] = 0x3f // Report ID magic number
+
 		if len(payload) > 63 {
 			copy(chunk[1:], payload[:63])
 			payload = payload[63:]
 		} else {
 			copy(chunk[1:], payload)
-			copy(chunk[1+len(payload):], make([]byte, 63-len(payload)))
 			payload = nil
 		}
-		// Send over to the device
 		w.log.Trace("Data chunk sent to the Trezor", "chunk", hexutil.Bytes(chunk))
-		if _, err := w.device.Write(chunk); err != nil {
+		chunks = append(chunks, chunk)
+	}
+	// Send over to the device, pipelining the chunks if supported
+	if batcher, ok := w.device.(batchWriter); ok {
+		if _, err := batcher.WriteBatch(chunks); err != nil {
 			return 0, err
 		}
+	} else {
+		for _, chunk := range chunks {
+			if _, err := w.device.Write(chunk); err != nil {
+				return 0, err
+			}
+		}
 	}
 	// Stream the reply back from the wallet in 64 byte chunks
+	chunk := make([]byte, 64)
 	var (
 		kind  uint16
 		reply []byte
@@ -40,6 +40,14 @@ const heartbeatCycle = time.Second
 // requesting accounts like crazy.
 const selfDeriveThrottling = time.Second
 
+// batchWriter is implemented by device connections that can queue a sequence
+// of output reports in one go, pipelining the USB round trips of a chunked
+// protocol exchange. Drivers should prefer it over per-report writes when the
+// connection supports it.
+type batchWriter interface {
+	WriteBatch(reports [][]byte) (int, error)
+}
+
 // driver defines the vendor specific functionality hardware wallets instances
 // must implement to allow using them with the wallet lifecycle management.
 type driver interface {
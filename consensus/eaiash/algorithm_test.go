@@ -20,6 +20,7 @@ import (
 	"bytes"
 	"io/ioutil"
 	"math/big"
+	"math/rand"
 	"os"
 	"reflect"
 	"sync"
@@ -28,6 +29,9 @@ import (
 	"github.com/ethereumai/go-ethereumai/common"
 	"github.com/ethereumai/go-ethereumai/common/hexutil"
 	"github.com/ethereumai/go-ethereumai/core/types"
+	"github.com/ethereumai/go-ethereumai/crypto"
+	"github.com/ethereumai/go-ethereumai/crypto/keccak"
+	"github.com/ethereumai/go-ethereumai/crypto/secp256k1"
 )
 
 // Tests whether the dataset size calculator works correctly by cross checking the
@@ -776,3 +780,69 @@ func BenchmarkHashimotoFullSmall(b *testing.B) {
 		hashimotoFull(dataset, hash, 0)
 	}
 }
+
+// Benchmarks a block's worth of import-path native kernels, both each phase
+// on its own and all of them interleaved the way block processing runs them:
+// hash the transactions, recover their senders, hash the dirtied trie nodes,
+// then verify the header's proof of work. The isolated phases miss whatever
+// the kernels do to each other's caches and tables, so the composite number
+// is the one that tracks real import latency.
+func BenchmarkImportKernels(b *testing.B) {
+	// A block's worth of work: transaction count and trie node count are in
+	// the ballpark of a full mainnet block
+	const txs, nodes = 200, 400
+
+	rng := rand.New(rand.NewSource(42))
+	txBlobs := make([][]byte, txs)
+	hashes := make([][]byte, txs)
+	sigs := make([][]byte, txs)
+	key, err := crypto.GenerateKey()
+	if err != nil {
+		b.Fatal(err)
+	}
+	for i := 0; i < txs; i++ {
+		txBlobs[i] = make([]byte, 140)
+		rng.Read(txBlobs[i])
+		hashes[i] = crypto.Keccak256(txBlobs[i])
+		if sigs[i], err = crypto.Sign(hashes[i], key); err != nil {
+			b.Fatal(err)
+		}
+	}
+	nodeBlobs := make([][]byte, nodes)
+	for i := 0; i < nodes; i++ {
+		nodeBlobs[i] = make([]byte, 532)
+		rng.Read(nodeBlobs[i])
+	}
+	cache := make([]uint32, cacheSize(1)/4)
+	generateCache(cache, 0, make([]byte, 32))
+	header := hexutil.MustDecode("0xc9149cc0386e689d789a1c2f3d5d169a61a6218ed30e74414dc736e442ef3d1f")
+
+	b.Run("recover", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			if _, err := secp256k1.RecoverPubkeyBatch(hashes, sigs); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+	b.Run("keccak", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			keccak.Sum256Batch(txBlobs)
+			keccak.Sum256Batch(nodeBlobs)
+		}
+	})
+	b.Run("pow", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			hashimotoLight(datasetSize(1), cache, header, 0)
+		}
+	})
+	b.Run("composite", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			keccak.Sum256Batch(txBlobs)
+			if _, err := secp256k1.RecoverPubkeyBatch(hashes, sigs); err != nil {
+				b.Fatal(err)
+			}
+			keccak.Sum256Batch(nodeBlobs)
+			hashimotoLight(datasetSize(1), cache, header, 0)
+		}
+	})
+}
@@ -30,6 +30,7 @@ import (
 	"github.com/ethereumai/go-ethereumai/consensus/misc"
 	"github.com/ethereumai/go-ethereumai/core/state"
 	"github.com/ethereumai/go-ethereumai/core/types"
+	"github.com/ethereumai/go-ethereumai/crypto/replay"
 	"github.com/ethereumai/go-ethereumai/params"
 	set "gopkg.in/fatih/set.v0"
 )
@@ -485,7 +486,9 @@ func (eaiash *Eaiash) VerifySeal(chain consensus.ChainReader, header *types.Head
 	if eaiash.config.PowMode == ModeTest {
 		size = 32 * 1024
 	}
-	digest, result := hashimotoLight(size, cache.cache, header.HashNoNonce().Bytes(), header.Nonce.Uint64())
+	sealhash := header.HashNoNonce().Bytes()
+	replay.CaptureSeal(number, sealhash, header.Nonce.Uint64())
+	digest, result := hashimotoLight(size, cache.cache, sealhash, header.Nonce.Uint64())
 	// Caches are unmapped in a finalizer. Ensure that the cache stays live
 	// until after the call to hashimotoLight so it's not unmapped while being used.
 	runtime.KeepAlive(cache)
@@ -52,8 +52,13 @@ var (
 	// algorithmRevision is the data structure version used for file naming.
 	algorithmRevision = 23
 
-	// dumpMagic is a dataset dump header to sanity check a data dump.
-	dumpMagic = []uint32{0xbaddcafe, 0xfee1dead}
+	// dumpMagic is a dataset dump header to sanity check a data dump. The magic
+	// words are followed by zero padding that rounds the header up to 128 bytes,
+	// so the node data of the page-aligned memory mapping starts on a two-cache-
+	// line boundary and every 128-byte dataset page covers exactly two lines.
+	// The layout matches EAIASH_DAG_HEADER_SIZE in the C libeaiash; dumps with
+	// the data at offset 8 fail the header check and are regenerated.
+	dumpMagic = append([]uint32{0xbaddcafe, 0xfee1dead}, make([]uint32, 30)...)
 )
 
 // isLittleEndian returns whether the local system is running in little or big
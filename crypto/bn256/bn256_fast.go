@@ -33,3 +33,10 @@ type G2 = bn256.G2
 func PairingCheck(a []*G1, b []*G2) bool {
 	return bn256.PairingCheck(a, b)
 }
+
+// PairingCheckBatch evaluates several independent pairing checks, sharing a
+// single final exponentiation across the batch. The second return value
+// reports whether every check passed.
+func PairingCheckBatch(a [][]*G1, b [][]*G2) ([]bool, bool) {
+	return bn256.PairingCheckBatch(a, b)
+}
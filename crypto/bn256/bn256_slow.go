@@ -33,3 +33,22 @@ type G2 = bn256.G2
 func PairingCheck(a []*G1, b []*G2) bool {
 	return bn256.PairingCheck(a, b)
 }
+
+// PairingCheckBatch evaluates several independent pairing checks. The slow
+// backend finalizes each check separately; the second return value reports
+// whether every check passed.
+func PairingCheckBatch(a [][]*G1, b [][]*G2) ([]bool, bool) {
+	if len(a) != len(b) {
+		return nil, false
+	}
+	if len(a) == 0 {
+		return nil, true
+	}
+	results := make([]bool, len(a))
+	ok := true
+	for i := range a {
+		results[i] = bn256.PairingCheck(a[i], b[i])
+		ok = ok && results[i]
+	}
+	return results, ok
+}
@@ -0,0 +1,278 @@
+package bn256
+
+import (
+	"encoding/json"
+	"flag"
+	"fmt"
+	"math"
+	"os"
+	"testing"
+	"time"
+)
+
+// The compiled test binary doubles as the benchmark harness for the
+// regression tooling: run with -bench.json it emits the same JSON array as
+// the secp256k1 bench_all binary, so contrib/bench_regress.py can gate both
+// libraries. Hardware counters cannot be sampled from Go, so the counter
+// fields stay null.
+var benchJSON = flag.Bool("bench.json", false, "emit the unified JSON benchmark output and exit")
+
+func TestMain(m *testing.M) {
+	flag.Parse()
+	if *benchJSON {
+		benchAllJSON()
+		os.Exit(0)
+	}
+	os.Exit(m.Run())
+}
+
+type benchJSONEntry struct {
+	Name               string   `json:"name"`
+	Iter               int      `json:"iter"`
+	Count              int      `json:"count"`
+	MinUs              float64  `json:"min_us"`
+	AvgUs              float64  `json:"avg_us"`
+	MaxUs              float64  `json:"max_us"`
+	CyclesPerIter      *float64 `json:"cycles_per_iter"`
+	CacheMissesPerIter *float64 `json:"cache_misses_per_iter"`
+}
+
+// benchKernels holds preconstructed operands so the measured loops do only
+// the arithmetic under test.
+type benchKernels struct {
+	fa, fb gfP
+	ta, tb gfP2
+	sa, sb gfP6
+	da, db gfP12
+	g1     *curvePoint
+	g2     *twistPoint
+	pairG1 []*G1
+	pairG2 []*G2
+}
+
+func newBenchKernels() *benchKernels {
+	k := &benchKernels{}
+	k.fa.Invert(newGFp(3))
+	k.fb.Invert(newGFp(5))
+	k.ta = gfP2{k.fa, k.fb}
+	k.tb.x.Invert(newGFp(7))
+	k.tb.y.Invert(newGFp(11))
+	k.sa = gfP6{k.ta, k.tb, k.ta}
+	k.sb = gfP6{k.tb, k.ta, k.tb}
+	k.da = gfP12{k.sa, k.sb}
+	k.db = gfP12{k.sb, k.sa}
+
+	k.g1 = new(G1).ScalarBaseMult(bigFromBase10("123456789012345")).p
+	k.g2 = new(G2).ScalarBaseMult(bigFromBase10("987654321098765")).p
+
+	k.pairG1 = make([]*G1, 16)
+	k.pairG2 = make([]*G2, 16)
+	for i := range k.pairG1 {
+		k.pairG1[i] = new(G1).ScalarBaseMult(bigFromBase10(fmt.Sprintf("%d", 2*i+3)))
+		k.pairG2[i] = new(G2).ScalarBaseMult(bigFromBase10(fmt.Sprintf("%d", 5*i+7)))
+	}
+	return k
+}
+
+// runBenchJSON times fn(iter) count times and appends a harness entry with
+// the per-iteration min/avg/max, mirroring run_benchmark_json in bench.h.
+func runBenchJSON(entries []benchJSONEntry, name string, count, iter int, fn func(iter int)) []benchJSONEntry {
+	min, max, sum := math.MaxFloat64, 0.0, 0.0
+	for i := 0; i < count; i++ {
+		begin := time.Now()
+		fn(iter)
+		total := time.Since(begin).Seconds()
+		if total < min {
+			min = total
+		}
+		if total > max {
+			max = total
+		}
+		sum += total
+	}
+	return append(entries, benchJSONEntry{
+		Name:  name,
+		Iter:  iter,
+		Count: count,
+		MinUs: min * 1e6 / float64(iter),
+		AvgUs: (sum / float64(count)) * 1e6 / float64(iter),
+		MaxUs: max * 1e6 / float64(iter),
+	})
+}
+
+func benchAllJSON() {
+	k := newBenchKernels()
+	entries := []benchJSONEntry{}
+
+	entries = runBenchJSON(entries, "gfp_mul", 10, 200000, k.benchGFpMul)
+	entries = runBenchJSON(entries, "gfp_sqr", 10, 200000, k.benchGFpSqr)
+	// On machines with MULX, time the plain MULQ ladder as well so both
+	// multiplication paths in the assembly stay covered.
+	withMULQOnly(func() {
+		entries = runBenchJSON(entries, "gfp_mul_mulq", 10, 200000, k.benchGFpMul)
+		entries = runBenchJSON(entries, "gfp_sqr_mulq", 10, 200000, k.benchGFpSqr)
+	})
+
+	entries = runBenchJSON(entries, "gfp2_mul", 10, 100000, k.benchGFp2Mul)
+	entries = runBenchJSON(entries, "gfp2_square", 10, 100000, k.benchGFp2Square)
+	entries = runBenchJSON(entries, "gfp6_mul", 10, 20000, k.benchGFp6Mul)
+	entries = runBenchJSON(entries, "gfp6_square", 10, 20000, k.benchGFp6Square)
+	entries = runBenchJSON(entries, "gfp12_mul", 10, 5000, k.benchGFp12Mul)
+	entries = runBenchJSON(entries, "gfp12_square", 10, 5000, k.benchGFp12Square)
+
+	entries = runBenchJSON(entries, "miller", 10, 100, k.benchMiller)
+	entries = runBenchJSON(entries, "final_exponentiation", 10, 100, k.benchFinalExponentiation)
+
+	for pairs := 1; pairs <= 16; pairs++ {
+		name := fmt.Sprintf("pairing_check_k%02d", pairs)
+		entries = runBenchJSON(entries, name, 10, 5, k.benchPairingCheck(pairs))
+	}
+
+	out, err := json.MarshalIndent(entries, "", "  ")
+	if err != nil {
+		panic(err)
+	}
+	os.Stdout.Write(out)
+	fmt.Println()
+}
+
+func (k *benchKernels) benchGFpMul(iter int) {
+	c := &gfP{}
+	for i := 0; i < iter; i++ {
+		gfpMul(c, &k.fa, &k.fb)
+	}
+}
+
+func (k *benchKernels) benchGFpSqr(iter int) {
+	c := &gfP{}
+	for i := 0; i < iter; i++ {
+		gfpSqr(c, &k.fa)
+	}
+}
+
+func (k *benchKernels) benchGFp2Mul(iter int) {
+	c := &gfP2{}
+	for i := 0; i < iter; i++ {
+		c.Mul(&k.ta, &k.tb)
+	}
+}
+
+func (k *benchKernels) benchGFp2Square(iter int) {
+	c := &gfP2{}
+	for i := 0; i < iter; i++ {
+		c.Square(&k.ta)
+	}
+}
+
+func (k *benchKernels) benchGFp6Mul(iter int) {
+	c := &gfP6{}
+	for i := 0; i < iter; i++ {
+		c.Mul(&k.sa, &k.sb)
+	}
+}
+
+func (k *benchKernels) benchGFp6Square(iter int) {
+	c := &gfP6{}
+	for i := 0; i < iter; i++ {
+		c.Square(&k.sa)
+	}
+}
+
+func (k *benchKernels) benchGFp12Mul(iter int) {
+	c := &gfP12{}
+	for i := 0; i < iter; i++ {
+		c.Mul(&k.da, &k.db)
+	}
+}
+
+func (k *benchKernels) benchGFp12Square(iter int) {
+	c := &gfP12{}
+	for i := 0; i < iter; i++ {
+		c.Square(&k.da)
+	}
+}
+
+func (k *benchKernels) benchMiller(iter int) {
+	for i := 0; i < iter; i++ {
+		miller(k.g2, k.g1)
+	}
+}
+
+func (k *benchKernels) benchFinalExponentiation(iter int) {
+	for i := 0; i < iter; i++ {
+		finalExponentiation(&k.da)
+	}
+}
+
+func (k *benchKernels) benchPairingCheck(pairs int) func(iter int) {
+	return func(iter int) {
+		for i := 0; i < iter; i++ {
+			PairingCheck(k.pairG1[:pairs], k.pairG2[:pairs])
+		}
+	}
+}
+
+func BenchmarkGFpMul(b *testing.B) {
+	k := newBenchKernels()
+	b.ResetTimer()
+	k.benchGFpMul(b.N)
+}
+
+func BenchmarkGFpSqr(b *testing.B) {
+	k := newBenchKernels()
+	b.ResetTimer()
+	k.benchGFpSqr(b.N)
+}
+
+func BenchmarkGFpMulMULQ(b *testing.B) {
+	k := newBenchKernels()
+	b.ResetTimer()
+	if !withMULQOnly(func() { k.benchGFpMul(b.N) }) {
+		b.Skip("no separate MULQ ladder on this platform")
+	}
+}
+
+func BenchmarkGFp2Mul(b *testing.B) {
+	k := newBenchKernels()
+	b.ResetTimer()
+	k.benchGFp2Mul(b.N)
+}
+
+func BenchmarkGFp2Square(b *testing.B) {
+	k := newBenchKernels()
+	b.ResetTimer()
+	k.benchGFp2Square(b.N)
+}
+
+func BenchmarkGFp6Mul(b *testing.B) {
+	k := newBenchKernels()
+	b.ResetTimer()
+	k.benchGFp6Mul(b.N)
+}
+
+func BenchmarkGFp12Mul(b *testing.B) {
+	k := newBenchKernels()
+	b.ResetTimer()
+	k.benchGFp12Mul(b.N)
+}
+
+func BenchmarkMiller(b *testing.B) {
+	k := newBenchKernels()
+	b.ResetTimer()
+	k.benchMiller(b.N)
+}
+
+func BenchmarkFinalExponentiation(b *testing.B) {
+	k := newBenchKernels()
+	b.ResetTimer()
+	k.benchFinalExponentiation(b.N)
+}
+
+func BenchmarkPairingCheck(b *testing.B) {
+	k := newBenchKernels()
+	for _, pairs := range []int{1, 2, 4, 8, 16} {
+		b.Run(fmt.Sprintf("pairs=%d", pairs), func(b *testing.B) {
+			k.benchPairingCheck(pairs)(b.N)
+		})
+	}
+}
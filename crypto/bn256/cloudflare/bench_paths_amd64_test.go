@@ -0,0 +1,16 @@
+// +build amd64,!generic
+
+package bn256
+
+// withMULQOnly runs fn with the MULX ladder disabled, forcing the plain MULQ
+// path in mul_amd64.h, and reports whether the two paths actually differ on
+// this machine.
+func withMULQOnly(fn func()) bool {
+	if !hasBMI2 {
+		return false
+	}
+	hasBMI2 = false
+	fn()
+	hasBMI2 = true
+	return true
+}
@@ -0,0 +1,9 @@
+// +build !amd64 generic
+
+package bn256
+
+// withMULQOnly reports that there is no alternative multiplication ladder to
+// benchmark outside the amd64 assembly.
+func withMULQOnly(fn func()) bool {
+	return false
+}
@@ -309,8 +309,31 @@ func Pair(g1 *G1, g2 *G2) *GT {
 	return &GT{optimalAte(g2.p, g1.p)}
 }
 
+// normalizePairs converts the points of every usable pair to affine form up
+// front, so that the conversions inside the Miller loops become no-ops. With
+// more than one pair this shares a single field inversion per group instead
+// of spending one per point.
+func normalizePairs(a []*G1, b []*G2) {
+	curvePoints := make([]*curvePoint, 0, len(a))
+	twistPoints := make([]*twistPoint, 0, len(b))
+	for i := 0; i < len(a) && i < len(b); i++ {
+		if a[i].p.IsInfinity() || b[i].p.IsInfinity() {
+			continue
+		}
+		curvePoints = append(curvePoints, a[i].p)
+		twistPoints = append(twistPoints, b[i].p)
+	}
+	if len(curvePoints) < 2 {
+		return
+	}
+	curvePointMakeAffineBatch(curvePoints)
+	twistPointMakeAffineBatch(twistPoints)
+}
+
 // PairingCheck calculates the Optimal Ate pairing for a set of points.
 func PairingCheck(a []*G1, b []*G2) bool {
+	normalizePairs(a, b)
+
 	acc := new(gfP12)
 	acc.SetOne()
 
@@ -323,6 +346,76 @@ func PairingCheck(a []*G1, b []*G2) bool {
 	return finalExponentiation(acc).IsOne()
 }
 
+// PairingCheckBatch evaluates several independent pairing checks while
+// sharing a single final exponentiation across the whole batch. Check i
+// passes when the pairing product over the pairs (a[i][j], b[i][j]) is one.
+// The per-check Miller products are folded with random 128-bit exponents;
+// since the final exponentiation is a homomorphism, the folded product
+// finalizes to one exactly when every check passes, up to a 2^-128 failure
+// chance per exponent. Only when the folded product fails are the checks
+// finalized one by one to find the culprits. The second return value reports
+// whether the whole batch passed.
+func PairingCheckBatch(a [][]*G1, b [][]*G2) ([]bool, bool) {
+	if len(a) != len(b) {
+		return nil, false
+	}
+	n := len(a)
+	if n == 0 {
+		return nil, true
+	}
+	// Normalize the pairs of all checks together, sharing one inversion per
+	// group across the whole batch.
+	flatA := make([]*G1, 0, n)
+	flatB := make([]*G2, 0, n)
+	for i := 0; i < n; i++ {
+		for j := 0; j < len(a[i]) && j < len(b[i]); j++ {
+			flatA = append(flatA, a[i][j])
+			flatB = append(flatB, b[i][j])
+		}
+	}
+	normalizePairs(flatA, flatB)
+	// One Miller-loop product per check, exactly as PairingCheck computes it.
+	millers := make([]*gfP12, n)
+	for i := 0; i < n; i++ {
+		acc := new(gfP12)
+		acc.SetOne()
+		for j := 0; j < len(a[i]); j++ {
+			if a[i][j].p.IsInfinity() || b[i][j].p.IsInfinity() {
+				continue
+			}
+			acc.Mul(acc, miller(b[i][j].p, a[i][j].p))
+		}
+		millers[i] = acc
+	}
+	results := make([]bool, n)
+	if n > 1 {
+		folded := new(gfP12).Set(millers[0])
+		bound := new(big.Int).Lsh(big.NewInt(1), 128)
+		for i := 1; i < n; i++ {
+			r, err := rand.Int(rand.Reader, bound)
+			if err != nil {
+				// No entropy for the folding exponents: finalize each check
+				// separately below.
+				folded = nil
+				break
+			}
+			folded.Mul(folded, new(gfP12).Exp(millers[i], r.Add(r, big.NewInt(1))))
+		}
+		if folded != nil && finalExponentiation(folded).IsOne() {
+			for i := range results {
+				results[i] = true
+			}
+			return results, true
+		}
+	}
+	ok := true
+	for i := 0; i < n; i++ {
+		results[i] = finalExponentiation(millers[i]).IsOne()
+		ok = ok && results[i]
+	}
+	return results, ok
+}
+
 // Miller applies Miller's algorithm, which is a bilinear function from the
 // source groups to F_p^12. Miller(g1, g2).Finalize() is equivalent to Pair(g1,
 // g2).
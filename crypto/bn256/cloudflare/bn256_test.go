@@ -60,6 +60,66 @@ func TestBilinearity(t *testing.T) {
 	}
 }
 
+func TestPairingCheckBatch(t *testing.T) {
+	checks1 := make([][]*G1, 4)
+	checks2 := make([][]*G2, 4)
+	for i := range checks1 {
+		_, p, _ := RandomG1(rand.Reader)
+		_, q, _ := RandomG2(rand.Reader)
+		np := new(G1).Neg(p)
+		// e(P, Q) * e(-P, Q) == 1, so each check passes on its own.
+		checks1[i] = []*G1{p, np}
+		checks2[i] = []*G2{q, q}
+	}
+	results, ok := PairingCheckBatch(checks1, checks2)
+	if !ok {
+		t.Fatal("batch of passing checks failed")
+	}
+	for i, r := range results {
+		if !r {
+			t.Fatalf("check %d reported as failed", i)
+		}
+	}
+
+	// Corrupt a single check and make sure only its slot fails.
+	checks2[2] = []*G2{checks2[2][0], new(G2).Add(checks2[2][1], checks2[2][1])}
+	results, ok = PairingCheckBatch(checks1, checks2)
+	if ok {
+		t.Fatal("batch with a failing check passed")
+	}
+	for i, r := range results {
+		if r != (i != 2) {
+			t.Fatalf("check %d: got %v", i, r)
+		}
+	}
+
+	if _, ok := PairingCheckBatch(checks1, checks2[:3]); ok {
+		t.Fatal("mismatched batch lengths accepted")
+	}
+	if results, ok := PairingCheckBatch(nil, nil); results != nil || !ok {
+		t.Fatal("empty batch mishandled")
+	}
+}
+
+// Tests that pairings against a repeated G2 point stay correct once the
+// Miller loop switches to the cached line coefficient sequence, using the
+// bilinearity identity e(2a, b) == e(a, b)².
+func TestMillerLineCache(t *testing.T) {
+	a := new(G1).ScalarBaseMult(bigFromBase10("1122334455667788990011"))
+	b := new(G2).ScalarBaseMult(bigFromBase10("9988776655443322110099"))
+
+	p1 := Pair(a, b) // cold: records the base
+	a2 := new(G1).Add(a, a)
+	p2 := Pair(a2, b) // second sighting: evaluated from cached coefficients
+	if want := new(GT).Add(p1, p1); p2.String() != want.String() {
+		t.Errorf("cached pairing mismatch: have %s, want %s", p2, want)
+	}
+	p3 := Pair(a2, b) // warm cache must be deterministic
+	if p3.String() != p2.String() {
+		t.Errorf("warm cache mismatch: have %s, want %s", p3, p2)
+	}
+}
+
 func TestTripartiteDiffieHellman(t *testing.T) {
 	a, _ := rand.Int(rand.Reader, Order)
 	b, _ := rand.Int(rand.Reader, Order)
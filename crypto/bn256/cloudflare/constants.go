@@ -28,6 +28,11 @@ var p2 = [4]uint64{0x3c208c16d87cfd47, 0x97816a916871ca8d, 0xb85045b68181585d, 0
 // np is the negative inverse of p, mod 2^256.
 var np = [4]uint64{0x87d20782e4866389, 0x9ede7d651eca6ac9, 0xd8afcbd01833da80, 0xf57a22b791888c6b}
 
+// p2sq is p², represented as little-endian 64-bit words. It is congruent to
+// zero mod p and is added by the lazy-reduction wide subtraction to keep
+// unreduced 512-bit accumulators non-negative.
+var p2sq = [8]uint64{0x3b5458a2275d69b1, 0xa602072d09eac101, 0x4a50189c6d96cadc, 0x04689e957a1242c8, 0x26edfa5c34c6b38d, 0xb00b855116375606, 0x599a6f7c0348d21c, 0x0925c4b8763cbf9c}
+
 // rN1 is R^-1 where R = 2^256 mod p.
 var rN1 = &gfP{0xed84884a014afa37, 0xeb2022850278edf8, 0xcf63e9cfb74492d9, 0x2e67157159e5c639}
 
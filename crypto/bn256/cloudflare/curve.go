@@ -43,8 +43,8 @@ func (c *curvePoint) IsOnCurve() bool {
 	}
 
 	y2, x3 := &gfP{}, &gfP{}
-	gfpMul(y2, &c.y, &c.y)
-	gfpMul(x3, &c.x, &c.x)
+	gfpSqr(y2, &c.y)
+	gfpSqr(x3, &c.x)
 	gfpMul(x3, x3, &c.x)
 	gfpAdd(x3, x3, curveB)
 
@@ -78,8 +78,8 @@ func (c *curvePoint) Add(a, b *curvePoint) {
 	// by [u1:s1:z1·z2] and [u2:s2:z1·z2]
 	// where u1 = x1·z2², s1 = y1·z2³ and u1 = x2·z1², s2 = y2·z1³
 	z12, z22 := &gfP{}, &gfP{}
-	gfpMul(z12, &a.z, &a.z)
-	gfpMul(z22, &b.z, &b.z)
+	gfpSqr(z12, &a.z)
+	gfpSqr(z22, &b.z)
 
 	u1, u2 := &gfP{}, &gfP{}
 	gfpMul(u1, &a.x, z22)
@@ -107,7 +107,7 @@ func (c *curvePoint) Add(a, b *curvePoint) {
 	gfpAdd(t, h, h)
 	// i = 4h²
 	i := &gfP{}
-	gfpMul(i, t, t)
+	gfpSqr(i, t)
 	// j = 4h³
 	j := &gfP{}
 	gfpMul(j, h, i)
@@ -126,7 +126,7 @@ func (c *curvePoint) Add(a, b *curvePoint) {
 
 	// t4 = 4(s2-s1)²
 	t4, t6 := &gfP{}, &gfP{}
-	gfpMul(t4, r, r)
+	gfpSqr(t4, r)
 	gfpAdd(t, v, v)
 	gfpSub(t6, t4, j)
 
@@ -143,7 +143,7 @@ func (c *curvePoint) Add(a, b *curvePoint) {
 
 	// Set z = 2(u2-u1)·z1·z2 = 2h·z1·z2
 	gfpAdd(t, &a.z, &b.z) // t11
-	gfpMul(t4, t, t)      // t12
+	gfpSqr(t4, t)         // t12
 	gfpSub(t, t4, z12)    // t13
 	gfpSub(t4, t, z22)    // t14
 	gfpMul(&c.z, t4, h)
@@ -152,13 +152,13 @@ func (c *curvePoint) Add(a, b *curvePoint) {
 func (c *curvePoint) Double(a *curvePoint) {
 	// See http://hyperelliptic.org/EFD/g1p/auto-code/shortw/jacobian-0/doubling/dbl-2009-l.op3
 	A, B, C := &gfP{}, &gfP{}, &gfP{}
-	gfpMul(A, &a.x, &a.x)
-	gfpMul(B, &a.y, &a.y)
-	gfpMul(C, B, B)
+	gfpSqr(A, &a.x)
+	gfpSqr(B, &a.y)
+	gfpSqr(C, B)
 
 	t, t2 := &gfP{}, &gfP{}
 	gfpAdd(t, &a.x, B)
-	gfpMul(t2, t, t)
+	gfpSqr(t2, t)
 	gfpSub(t, t2, A)
 	gfpSub(t2, t, C)
 
@@ -166,7 +166,7 @@ func (c *curvePoint) Double(a *curvePoint) {
 	gfpAdd(d, t2, t2)
 	gfpAdd(t, A, A)
 	gfpAdd(e, t, A)
-	gfpMul(f, e, e)
+	gfpSqr(f, e)
 
 	gfpAdd(t, d, d)
 	gfpSub(&c.x, f, t)
@@ -183,6 +183,15 @@ func (c *curvePoint) Double(a *curvePoint) {
 }
 
 func (c *curvePoint) Mul(a *curvePoint, scalar *big.Int) {
+	// Repeated bases (verification keys hammering the precompile) are served
+	// from cached comb tables, skipping all doubling work; see window.go.
+	if !a.IsInfinity() && a.z == *newGFp(1) {
+		if table := curveWindows.lookup(a); table != nil {
+			curveWindowMul(c, table, scalar)
+			return
+		}
+	}
+
 	precomp := [1 << 2]*curvePoint{nil, {}, {}, {}}
 	precomp[1].Set(a)
 	precomp[2].Set(a)
@@ -221,7 +230,7 @@ func (c *curvePoint) MakeAffine() {
 
 	t, zInv2 := &gfP{}, &gfP{}
 	gfpMul(t, &c.y, zInv)
-	gfpMul(zInv2, zInv, zInv)
+	gfpSqr(zInv2, zInv)
 
 	gfpMul(&c.x, &c.x, zInv2)
 	gfpMul(&c.y, t, zInv2)
@@ -230,6 +239,41 @@ func (c *curvePoint) MakeAffine() {
 	c.t = *newGFp(1)
 }
 
+// curvePointMakeAffineBatch normalizes every point in the slice at the cost
+// of a single field inversion, using gfpInvertBatch on the collected z
+// coordinates instead of inverting each one separately.
+func curvePointMakeAffineBatch(points []*curvePoint) {
+	zInvs := make([]*gfP, 0, len(points))
+	todo := make([]*curvePoint, 0, len(points))
+	for _, c := range points {
+		if c.z == *newGFp(1) {
+			continue
+		} else if c.z == *newGFp(0) {
+			c.x = gfP{0}
+			c.y = *newGFp(1)
+			c.t = gfP{0}
+			continue
+		}
+		zInv := &gfP{}
+		zInv.Set(&c.z)
+		zInvs = append(zInvs, zInv)
+		todo = append(todo, c)
+	}
+	gfpInvertBatch(zInvs)
+
+	for i, c := range todo {
+		t, zInv2 := &gfP{}, &gfP{}
+		gfpMul(t, &c.y, zInvs[i])
+		gfpSqr(zInv2, zInvs[i])
+
+		gfpMul(&c.x, &c.x, zInv2)
+		gfpMul(&c.y, t, zInv2)
+
+		c.z = *newGFp(1)
+		c.t = *newGFp(1)
+	}
+}
+
 func (c *curvePoint) Neg(a *curvePoint) {
 	c.x.Set(&a.x)
 	gfpNeg(&c.y, &a.y)
@@ -0,0 +1,13 @@
+// +build amd64,!generic
+
+package bn256
+
+// hasBMI2 gates the MULX-based multiplication ladder in gfp_amd64.s. It is
+// probed once at startup with CPUID, so one binary picks the best ladder on
+// every host of a heterogeneous fleet instead of relying on build tags or on
+// runtime-internal feature symbols.
+var hasBMI2 = cpuBMI2()
+
+// cpuBMI2 reports whether the processor supports the BMI2 instruction set
+// extension. Implemented in features_amd64.s.
+func cpuBMI2() bool
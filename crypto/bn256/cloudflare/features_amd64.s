@@ -0,0 +1,21 @@
+// +build amd64,!generic
+
+#include "textflag.h"
+
+// func cpuBMI2() bool
+TEXT ·cpuBMI2(SB),NOSPLIT,$0-1
+	MOVL $0, AX
+	CPUID
+	CMPL AX, $7       // structured extended feature leaf supported?
+	JL   nobmi2
+	MOVL $7, AX
+	MOVL $0, CX
+	CPUID
+	SHRL $8, BX       // EBX bit 8: BMI2
+	ANDL $1, BX
+	MOVB BX, ret+0(FP)
+	RET
+
+nobmi2:
+	MOVB $0, ret+0(FP)
+	RET
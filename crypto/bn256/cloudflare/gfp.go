@@ -42,7 +42,7 @@ func (e *gfP) Invert(f *gfP) {
 			if (bits[word]>>bit)&1 == 1 {
 				gfpMul(sum, sum, power)
 			}
-			gfpMul(power, power, power)
+			gfpSqr(power, power)
 		}
 	}
 
@@ -50,6 +50,32 @@ func (e *gfP) Invert(f *gfP) {
 	e.Set(sum)
 }
 
+// gfpInvertBatch replaces every element of elts with its inverse, sharing a
+// single field inversion across the whole batch (Montgomery's trick). The
+// shared inversion costs three extra multiplications per element, which is far
+// cheaper than one exponentiation each. All elements must be non-zero.
+func gfpInvertBatch(elts []*gfP) {
+	if len(elts) == 0 {
+		return
+	}
+	prefix := make([]gfP, len(elts))
+	prefix[0].Set(elts[0])
+	for i := 1; i < len(elts); i++ {
+		gfpMul(&prefix[i], &prefix[i-1], elts[i])
+	}
+
+	inv := &gfP{}
+	inv.Invert(&prefix[len(elts)-1])
+
+	t := &gfP{}
+	for i := len(elts) - 1; i > 0; i-- {
+		gfpMul(t, inv, &prefix[i-1])
+		gfpMul(inv, inv, elts[i])
+		elts[i].Set(t)
+	}
+	elts[0].Set(inv)
+}
+
 func (e *gfP) Marshal(out []byte) {
 	for w := uint(0); w < 4; w++ {
 		for b := uint(0); b < 8; b++ {
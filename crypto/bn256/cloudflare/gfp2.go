@@ -75,19 +75,13 @@ func (e *gfP2) Sub(a, b *gfP2) *gfP2 {
 
 // See "Multiplication and Squaring in Pairing-Friendly Fields",
 // http://eprint.iacr.org/2006/471.pdf
+//
+// On amd64 the coordinates are computed with lazy reduction: the four base
+// field products are accumulated unreduced and Montgomery reduced once per
+// coordinate, see gfp_lazy.go. The higher towers inherit the saving since
+// every gfP6 and gfP12 multiply decomposes into gfP2 multiplies.
 func (e *gfP2) Mul(a, b *gfP2) *gfP2 {
-	tx, t := &gfP{}, &gfP{}
-	gfpMul(tx, &a.x, &b.y)
-	gfpMul(t, &b.x, &a.y)
-	gfpAdd(tx, tx, t)
-
-	ty := &gfP{}
-	gfpMul(ty, &a.y, &b.y)
-	gfpMul(t, &a.x, &b.x)
-	gfpSub(ty, ty, t)
-
-	e.x.Set(tx)
-	e.y.Set(ty)
+	gfp2Mul(e, a, b)
 	return e
 }
 
@@ -141,8 +135,8 @@ func (e *gfP2) Invert(a *gfP2) *gfP2 {
 	// See "Implementing cryptographic pairings", M. Scott, section 3.2.
 	// ftp://136.206.11.249/pub/crypto/pairings.pdf
 	t1, t2 := &gfP{}, &gfP{}
-	gfpMul(t1, &a.x, &a.x)
-	gfpMul(t2, &a.y, &a.y)
+	gfpSqr(t1, &a.x)
+	gfpSqr(t2, &a.y)
 	gfpAdd(t1, t1, t2)
 
 	inv := &gfP{}
@@ -154,3 +148,24 @@ func (e *gfP2) Invert(a *gfP2) *gfP2 {
 	gfpMul(&e.y, &a.y, inv)
 	return e
 }
+
+// gfP2InvertBatch replaces every element of elts with its inverse, sharing a
+// single gfP inversion across the whole batch via gfpInvertBatch. All
+// elements must be non-zero.
+func gfP2InvertBatch(elts []*gfP2) {
+	norms := make([]*gfP, len(elts))
+	for i, a := range elts {
+		t1, t2 := &gfP{}, &gfP{}
+		gfpSqr(t1, &a.x)
+		gfpSqr(t2, &a.y)
+		gfpAdd(t1, t1, t2)
+		norms[i] = t1
+	}
+	gfpInvertBatch(norms)
+	t := &gfP{}
+	for i, a := range elts {
+		gfpNeg(t, &a.x)
+		gfpMul(&a.x, t, norms[i])
+		gfpMul(&a.y, &a.y, norms[i])
+	}
+}
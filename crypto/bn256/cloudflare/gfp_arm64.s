@@ -111,3 +111,14 @@ TEXT ·gfpMul(SB),0,$0-24
 	MOVD c+0(FP), R0
 	storeBlock(R1,R2,R3,R4, 0(R0))
 	RET
+
+TEXT ·gfpSqr(SB),0,$0-16
+	MOVD a+8(FP), R0
+	loadBlock(0(R0), R1,R2,R3,R4)
+
+	sqr(R9,R10,R11,R12,R13,R14,R15,R16)
+	gfpReduce()
+
+	MOVD c+0(FP), R0
+	storeBlock(R1,R2,R3,R4, 0(R0))
+	RET
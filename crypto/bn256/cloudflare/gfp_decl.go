@@ -16,3 +16,6 @@ func gfpSub(c, a, b *gfP)
 
 //go:noescape
 func gfpMul(c, a, b *gfP)
+
+//go:noescape
+func gfpSqr(c, a *gfP)
@@ -171,3 +171,7 @@ func gfpMul(c, a, b *gfP) {
 	*c = gfP{T[4], T[5], T[6], T[7]}
 	gfpCarry(c, carry)
 }
+
+func gfpSqr(c, a *gfP) {
+	gfpMul(c, a, a)
+}
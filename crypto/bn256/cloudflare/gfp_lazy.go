@@ -0,0 +1,47 @@
+// +build amd64,!generic
+
+package bn256
+
+// This file implements lazily-reduced gfP2 multiplication: the four base
+// field products behind one gfP2 multiply are accumulated as unreduced
+// 512-bit values and Montgomery reduced only once per output coordinate,
+// halving the number of reductions. The wide-accumulator helpers live in
+// gfp_lazy_amd64.s and reuse the multiplication ladders from mul_amd64.h
+// and mul_bmi2_amd64.h.
+
+// gfPW is an unreduced 512-bit product of two Montgomery-form gfP values.
+type gfPW [8]uint64
+
+// gfpMulW computes the full 512-bit product c = a*b without reducing it.
+//go:noescape
+func gfpMulW(c *gfPW, a, b *gfP)
+
+// gfpAddW computes c = a+b over 512 bits. The caller must keep the sum below
+// 2p² so that it neither overflows nor exceeds what gfpReduceW can handle.
+//go:noescape
+func gfpAddW(c, a, b *gfPW)
+
+// gfpSubW computes c = a+p²-b over 512 bits; the added p² vanishes after
+// reduction and keeps the result non-negative.
+//go:noescape
+func gfpSubW(c, a, b *gfPW)
+
+// gfpReduceW Montgomery reduces the 512-bit accumulator a into c. The
+// accumulator must stay below 2p² < R·p so that the single conditional
+// subtraction in the reduction tail suffices.
+//go:noescape
+func gfpReduceW(c *gfP, a *gfPW)
+
+func gfp2Mul(e, a, b *gfP2) {
+	tx, ty, t := &gfPW{}, &gfPW{}, &gfPW{}
+	gfpMulW(tx, &a.x, &b.y)
+	gfpMulW(t, &b.x, &a.y)
+	gfpAddW(tx, tx, t)
+
+	gfpMulW(ty, &a.y, &b.y)
+	gfpMulW(t, &a.x, &b.x)
+	gfpSubW(ty, ty, t)
+
+	gfpReduceW(&e.x, tx)
+	gfpReduceW(&e.y, ty)
+}
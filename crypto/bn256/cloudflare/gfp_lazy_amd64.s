@@ -0,0 +1,136 @@
+// +build amd64,!generic
+
+#define storeBlock(a0,a1,a2,a3, r) \
+	MOVQ a0,  0+r \
+	MOVQ a1,  8+r \
+	MOVQ a2, 16+r \
+	MOVQ a3, 24+r
+
+#define loadBlock(r, a0,a1,a2,a3) \
+	MOVQ  0+r, a0 \
+	MOVQ  8+r, a1 \
+	MOVQ 16+r, a2 \
+	MOVQ 24+r, a3
+
+#define gfpCarry(a0,a1,a2,a3,a4, b0,b1,b2,b3,b4) \
+	\ // b = a-p
+	MOVQ a0, b0 \
+	MOVQ a1, b1 \
+	MOVQ a2, b2 \
+	MOVQ a3, b3 \
+	MOVQ a4, b4 \
+	\
+	SUBQ ·p2+0(SB), b0 \
+	SBBQ ·p2+8(SB), b1 \
+	SBBQ ·p2+16(SB), b2 \
+	SBBQ ·p2+24(SB), b3 \
+	SBBQ $0, b4 \
+	\
+	\ // if b is negative then return a
+	\ // else return b
+	CMOVQCC b0, a0 \
+	CMOVQCC b1, a1 \
+	CMOVQCC b2, a2 \
+	CMOVQCC b3, a3
+
+#include "mul_amd64.h"
+#include "mul_bmi2_amd64.h"
+
+TEXT ·gfpMulW(SB),0,$64-24
+	MOVQ a+8(FP), DI
+	MOVQ b+16(FP), SI
+
+	// Jump to a slightly different implementation if MULX isn't supported.
+	CMPB ·hasBMI2(SB), $0
+	JE   nobmi2MulW
+
+	mulBMI2(0(DI),8(DI),16(DI),24(DI), 0(SI))
+	MOVQ c+0(FP), DI
+	storeBlock( R8, R9,R10,R11,  0(DI))
+	storeBlock(R12,R13,R14,R15, 32(DI))
+	RET
+
+nobmi2MulW:
+	mul(0(DI),8(DI),16(DI),24(DI), 0(SI), 0(SP))
+	MOVQ c+0(FP), DI
+	loadBlock( 0(SP), R8,R9,R10,R11)
+	storeBlock(R8,R9,R10,R11, 0(DI))
+	loadBlock(32(SP), R8,R9,R10,R11)
+	storeBlock(R8,R9,R10,R11, 32(DI))
+	RET
+
+TEXT ·gfpAddW(SB),0,$0-24
+	MOVQ a+8(FP), DI
+	MOVQ b+16(FP), SI
+
+	loadBlock( 0(DI), R8,R9,R10,R11)
+	loadBlock(32(DI), R12,R13,R14,R15)
+
+	ADDQ  0(SI), R8
+	ADCQ  8(SI), R9
+	ADCQ 16(SI), R10
+	ADCQ 24(SI), R11
+	ADCQ 32(SI), R12
+	ADCQ 40(SI), R13
+	ADCQ 48(SI), R14
+	ADCQ 56(SI), R15
+
+	MOVQ c+0(FP), DI
+	storeBlock( R8, R9,R10,R11,  0(DI))
+	storeBlock(R12,R13,R14,R15, 32(DI))
+	RET
+
+TEXT ·gfpSubW(SB),0,$0-24
+	MOVQ a+8(FP), DI
+	MOVQ b+16(FP), SI
+
+	loadBlock( 0(DI), R8,R9,R10,R11)
+	loadBlock(32(DI), R12,R13,R14,R15)
+
+	// a+p² cannot carry out of 512 bits, and dominates any b below 2p², so
+	// the trailing subtraction cannot borrow either.
+	ADDQ ·p2sq+0(SB), R8
+	ADCQ ·p2sq+8(SB), R9
+	ADCQ ·p2sq+16(SB), R10
+	ADCQ ·p2sq+24(SB), R11
+	ADCQ ·p2sq+32(SB), R12
+	ADCQ ·p2sq+40(SB), R13
+	ADCQ ·p2sq+48(SB), R14
+	ADCQ ·p2sq+56(SB), R15
+
+	SUBQ  0(SI), R8
+	SBBQ  8(SI), R9
+	SBBQ 16(SI), R10
+	SBBQ 24(SI), R11
+	SBBQ 32(SI), R12
+	SBBQ 40(SI), R13
+	SBBQ 48(SI), R14
+	SBBQ 56(SI), R15
+
+	MOVQ c+0(FP), DI
+	storeBlock( R8, R9,R10,R11,  0(DI))
+	storeBlock(R12,R13,R14,R15, 32(DI))
+	RET
+
+TEXT ·gfpReduceW(SB),0,$160-16
+	MOVQ a+8(FP), DI
+
+	// Both reduction ladders expect the 512-bit intermediate at 0(SP).
+	loadBlock( 0(DI), R8,R9,R10,R11)
+	storeBlock(R8,R9,R10,R11,  0(SP))
+	loadBlock(32(DI), R8,R9,R10,R11)
+	storeBlock(R8,R9,R10,R11, 32(SP))
+
+	CMPB ·hasBMI2(SB), $0
+	JE   nobmi2ReduceW
+
+	gfpReduceBMI2()
+	JMP endReduceW
+
+nobmi2ReduceW:
+	gfpReduce(0(SP))
+
+endReduceW:
+	MOVQ c+0(FP), DI
+	storeBlock(R12,R13,R14,R15, 0(DI))
+	RET
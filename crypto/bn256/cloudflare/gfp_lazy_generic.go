@@ -0,0 +1,21 @@
+// +build !amd64 generic
+
+package bn256
+
+// Lazy-reduction fallback: without the wide-accumulator assembly helpers a
+// gfP2 multiply is cheapest as four ordinary Montgomery multiplications, so
+// the schoolbook formula is kept for the generic and arm64 builds.
+func gfp2Mul(e, a, b *gfP2) {
+	tx, t := &gfP{}, &gfP{}
+	gfpMul(tx, &a.x, &b.y)
+	gfpMul(t, &b.x, &a.y)
+	gfpAdd(tx, tx, t)
+
+	ty := &gfP{}
+	gfpMul(ty, &a.y, &b.y)
+	gfpMul(t, &a.x, &b.x)
+	gfpSub(ty, ty, t)
+
+	e.x.Set(tx)
+	e.y.Set(ty)
+}
@@ -45,6 +45,69 @@ func TestGFpSub(t *testing.T) {
 	}
 }
 
+// Tests that the dedicated squaring routine agrees with plain multiplication.
+func TestGFpSqr(t *testing.T) {
+	a := &gfP{0x0123456789abcdef, 0xfedcba9876543210, 0xdeadbeefdeadbeef, 0xfeebdaedfeebdaed}
+	w := &gfP{}
+	h := &gfP{}
+
+	gfpMul(w, a, a)
+	gfpSqr(h, a)
+	if *h != *w {
+		t.Errorf("squaring mismatch: have %#x, want %#x", *h, *w)
+	}
+}
+
+// Tests that batch inversion produces the same results as inverting each
+// element individually.
+func TestGFpInvertBatch(t *testing.T) {
+	elts := make([]*gfP, 10)
+	batch := make([]*gfP, len(elts))
+	for i := range elts {
+		elts[i] = newGFp(int64(i + 2))
+		batch[i] = &gfP{}
+		batch[i].Set(elts[i])
+	}
+	gfpInvertBatch(batch)
+
+	want := &gfP{}
+	for i, e := range elts {
+		want.Invert(e)
+		if *batch[i] != *want {
+			t.Errorf("batch inversion mismatch at %d: have %#x, want %#x", i, *batch[i], *want)
+		}
+	}
+}
+
+// Tests that the lazily-reduced gfP2 multiplication matches the schoolbook
+// formula that reduces after every base field product.
+func TestGFp2Mul(t *testing.T) {
+	a, b := &gfP2{}, &gfP2{}
+	a.x.Invert(newGFp(3))
+	a.y.Invert(newGFp(5))
+	b.x.Invert(newGFp(7))
+	b.y.Invert(newGFp(11))
+
+	tx, ty, tt := &gfP{}, &gfP{}, &gfP{}
+	for i := 0; i < 16; i++ {
+		gfpMul(tx, &a.x, &b.y)
+		gfpMul(tt, &b.x, &a.y)
+		gfpAdd(tx, tx, tt)
+
+		gfpMul(ty, &a.y, &b.y)
+		gfpMul(tt, &a.x, &b.x)
+		gfpSub(ty, ty, tt)
+
+		h := (&gfP2{}).Mul(a, b)
+		if h.x != *tx || h.y != *ty {
+			t.Fatalf("iteration %d: multiplication mismatch: have (%#x, %#x), want (%#x, %#x)", i, h.x, h.y, *tx, *ty)
+		}
+		// Chain the outputs back in to diffuse the operands
+		a.Set(h)
+		b.Square(b)
+	}
+}
+
 // Tests that multiplication works the same way on both assembly-optimized and pure Go
 // implementation.
 func TestGFpMul(t *testing.T) {
@@ -66,18 +66,80 @@
 	ADCS R29, c6 \
 	ADCS  ZR, c7
 
+// sqr squares the 256-bit value in R1:R2:R3:R4. The off-diagonal products
+// are computed once and doubled, so the ladder spends 20 multiply
+// instructions instead of the 32 a general mul costs.
+#define sqr(c0,c1,c2,c3,c4,c5,c6,c7) \
+	\ // Off-diagonal products, accumulated column-wise.
+	MUL R1, R2, c1 \
+	UMULH R1, R2, c2 \
+	MUL R1, R3, R0 \
+	ADDS R0, c2 \
+	UMULH R1, R3, c3 \
+	MUL R1, R4, R0 \
+	ADCS R0, c3 \
+	UMULH R1, R4, c4 \
+	ADCS ZR, c4 \
+	\
+	MUL R2, R3, R5 \
+	UMULH R2, R3, R6 \
+	MUL R2, R4, R0 \
+	ADDS R0, R6 \
+	UMULH R2, R4, R7 \
+	ADCS ZR, R7 \
+	\
+	MUL R3, R4, R8 \
+	UMULH R3, R4, R17 \
+	ADDS R8, R7 \
+	ADCS ZR, R17 \
+	\
+	MOVD ZR, c5 \
+	MOVD ZR, c6 \
+	MOVD ZR, c7 \
+	ADDS R5, c3 \
+	ADCS R6, c4 \
+	ADCS R7, c5 \
+	ADCS R17, c6 \
+	ADCS ZR, c7 \
+	\
+	\ // Double the off-diagonal sum.
+	ADDS c1, c1 \
+	ADCS c2, c2 \
+	ADCS c3, c3 \
+	ADCS c4, c4 \
+	ADCS c5, c5 \
+	ADCS c6, c6 \
+	ADCS c7, c7 \
+	\
+	\ // Add the squares on the diagonal.
+	MUL R1, R1, c0 \
+	UMULH R1, R1, R25 \
+	MUL R2, R2, R26 \
+	UMULH R2, R2, R27 \
+	MUL R3, R3, R29 \
+	UMULH R3, R3, R5 \
+	MUL R4, R4, R6 \
+	UMULH R4, R4, R7 \
+	ADDS R25, c1 \
+	ADCS R26, c2 \
+	ADCS R27, c3 \
+	ADCS R29, c4 \
+	ADCS R5, c5 \
+	ADCS R6, c6 \
+	ADCS R7, c7
+
 #define gfpReduce() \
 	\ // m = (T * N') mod R, store m in R1:R2:R3:R4
 	MOVD ·np+0(SB), R17 \
-	MOVD ·np+8(SB), R18 \
+	MOVD ·np+8(SB), R18_PLATFORM \
 	MOVD ·np+16(SB), R19 \
 	MOVD ·np+24(SB), R20 \
 	\
 	MUL R9, R17, R1 \
 	UMULH R9, R17, R2 \
-	MUL R9, R18, R0 \
+	MUL R9, R18_PLATFORM, R0 \
 	ADDS R0, R2 \
-	UMULH R9, R18, R3 \
+	UMULH R9, R18_PLATFORM, R3 \
 	MUL R9, R19, R0 \
 	ADCS R0, R3 \
 	UMULH R9, R19, R4 \
@@ -86,9 +148,9 @@
 	\
 	MUL R10, R17, R21 \
 	UMULH R10, R17, R22 \
-	MUL R10, R18, R0 \
+	MUL R10, R18_PLATFORM, R0 \
 	ADDS R0, R22 \
-	UMULH R10, R18, R23 \
+	UMULH R10, R18_PLATFORM, R23 \
 	MUL R10, R19, R0 \
 	ADCS R0, R23 \
 	ADDS R21, R2 \
@@ -97,7 +159,7 @@
 	\
 	MUL R11, R17, R21 \
 	UMULH R11, R17, R22 \
-	MUL R11, R18, R0 \
+	MUL R11, R18_PLATFORM, R0 \
 	ADDS R0, R22 \
 	ADDS R21, R3 \
 	ADCS R22, R4 \
@@ -107,12 +169,12 @@
 	\
 	\ // m * N
 	loadModulus(R5,R6,R7,R8) \
-	mul(R17,R18,R19,R20,R21,R22,R23,R24) \
+	mul(R17,R18_PLATFORM,R19,R20,R21,R22,R23,R24) \
 	\
 	\ // Add the 512-bit intermediate to m*N
 	MOVD  ZR, R25 \
 	ADDS  R9, R17 \
-	ADCS R10, R18 \
+	ADCS R10, R18_PLATFORM \
 	ADCS R11, R19 \
 	ADCS R12, R20 \
 	ADCS R13, R21 \
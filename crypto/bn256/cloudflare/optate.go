@@ -1,6 +1,14 @@
 package bn256
 
-func lineFunctionAdd(r, p *twistPoint, q *curvePoint, r2 *gfP2) (a, b, c *gfP2, rOut *twistPoint) {
+import (
+	"sync"
+)
+
+// lineFunctionAddCoeffs computes the line through r and p evaluated only at
+// the twist ladder: the b and c coefficients must still be scaled by the G1
+// point's x and y coordinates, see lineFunctionAdd. Keeping the G1 point out
+// of the computation lets repeated G2 bases reuse the whole sequence.
+func lineFunctionAddCoeffs(r, p *twistPoint, r2 *gfP2) (a, b, c *gfP2, rOut *twistPoint) {
 	// See the mixed addition algorithm from "Faster Computation of the
 	// Tate Pairing", http://arxiv.org/pdf/0904.0854v3.pdf
 	B := (&gfP2{}).Mul(&p.x, &r.t)
@@ -40,16 +48,24 @@ func lineFunctionAdd(r, p *twistPoint, q *curvePoint, r2 *gfP2) (a, b, c *gfP2,
 	t2.Add(t2, t2)
 	a = (&gfP2{}).Sub(t2, t)
 
-	c = (&gfP2{}).MulScalar(&rOut.z, &q.y)
-	c.Add(c, c)
+	c = (&gfP2{}).Add(&rOut.z, &rOut.z)
 
 	b = (&gfP2{}).Neg(L1)
-	b.MulScalar(b, &q.x).Add(b, b)
+	b.Add(b, b)
 
 	return
 }
 
-func lineFunctionDouble(r *twistPoint, q *curvePoint) (a, b, c *gfP2, rOut *twistPoint) {
+func lineFunctionAdd(r, p *twistPoint, q *curvePoint, r2 *gfP2) (a, b, c *gfP2, rOut *twistPoint) {
+	a, b, c, rOut = lineFunctionAddCoeffs(r, p, r2)
+	b.MulScalar(b, &q.x)
+	c.MulScalar(c, &q.y)
+	return
+}
+
+// lineFunctionDoubleCoeffs is the doubling counterpart of
+// lineFunctionAddCoeffs; b and c are returned unscaled.
+func lineFunctionDoubleCoeffs(r *twistPoint) (a, b, c *gfP2, rOut *twistPoint) {
 	// See the doubling algorithm for a=0 from "Faster Computation of the
 	// Tate Pairing", http://arxiv.org/pdf/0904.0854v3.pdf
 	A := (&gfP2{}).Square(&r.x)
@@ -78,7 +94,6 @@ func lineFunctionDouble(r *twistPoint, q *curvePoint) (a, b, c *gfP2, rOut *twis
 
 	t.Mul(E, &r.t).Add(t, t)
 	b = (&gfP2{}).Neg(t)
-	b.MulScalar(b, &q.x)
 
 	a = (&gfP2{}).Add(&r.x, E)
 	a.Square(a).Sub(a, A).Sub(a, G)
@@ -86,11 +101,18 @@ func lineFunctionDouble(r *twistPoint, q *curvePoint) (a, b, c *gfP2, rOut *twis
 	a.Sub(a, t)
 
 	c = (&gfP2{}).Mul(&rOut.z, &r.t)
-	c.Add(c, c).MulScalar(c, &q.y)
+	c.Add(c, c)
 
 	return
 }
 
+func lineFunctionDouble(r *twistPoint, q *curvePoint) (a, b, c *gfP2, rOut *twistPoint) {
+	a, b, c, rOut = lineFunctionDoubleCoeffs(r)
+	b.MulScalar(b, &q.x)
+	c.MulScalar(c, &q.y)
+	return
+}
+
 func mulLine(ret *gfP12, a, b, c *gfP2) {
 	a2 := &gfP6{}
 	a2.y.Set(a)
@@ -111,6 +133,173 @@ func mulLine(ret *gfP12, a, b, c *gfP2) {
 	ret.y.Add(&ret.y, a2)
 }
 
+// lineCoeffs is one precomputed Miller loop line; b and c are stored before
+// scaling by the G1 coordinates.
+type lineCoeffs struct {
+	a, b, c gfP2
+}
+
+// precomputeLineCoeffs runs the full Miller ladder for the affine twist
+// point aAffine and records every line function coefficient in evaluation
+// order, including the two Frobenius wrap-up lines.
+func precomputeLineCoeffs(aAffine *twistPoint) []lineCoeffs {
+	coeffs := make([]lineCoeffs, 0, 2*len(sixuPlus2NAF))
+
+	minusA := &twistPoint{}
+	minusA.Neg(aAffine)
+
+	r := &twistPoint{}
+	r.Set(aAffine)
+
+	r2 := (&gfP2{}).Square(&aAffine.y)
+
+	for i := len(sixuPlus2NAF) - 1; i > 0; i-- {
+		a, b, c, newR := lineFunctionDoubleCoeffs(r)
+		coeffs = append(coeffs, lineCoeffs{*a, *b, *c})
+		r = newR
+
+		switch sixuPlus2NAF[i-1] {
+		case 1:
+			a, b, c, newR = lineFunctionAddCoeffs(r, aAffine, r2)
+		case -1:
+			a, b, c, newR = lineFunctionAddCoeffs(r, minusA, r2)
+		default:
+			continue
+		}
+		coeffs = append(coeffs, lineCoeffs{*a, *b, *c})
+		r = newR
+	}
+
+	// The q1 and -q2 wrap-up lines, see miller for the isomorphism notes.
+	q1 := &twistPoint{}
+	q1.x.Conjugate(&aAffine.x).Mul(&q1.x, xiToPMinus1Over3)
+	q1.y.Conjugate(&aAffine.y).Mul(&q1.y, xiToPMinus1Over2)
+	q1.z.SetOne()
+	q1.t.SetOne()
+
+	minusQ2 := &twistPoint{}
+	minusQ2.x.MulScalar(&aAffine.x, xiToPSquaredMinus1Over3)
+	minusQ2.y.Set(&aAffine.y)
+	minusQ2.z.SetOne()
+	minusQ2.t.SetOne()
+
+	r2.Square(&q1.y)
+	a, b, c, newR := lineFunctionAddCoeffs(r, q1, r2)
+	coeffs = append(coeffs, lineCoeffs{*a, *b, *c})
+	r = newR
+
+	r2.Square(&minusQ2.y)
+	a, b, c, _ = lineFunctionAddCoeffs(r, minusQ2, r2)
+	coeffs = append(coeffs, lineCoeffs{*a, *b, *c})
+
+	return coeffs
+}
+
+// millerCoeffs evaluates the Miller loop for p against a precomputed line
+// coefficient sequence, paying only two coordinate scalings and one sparse
+// gfP12 multiplication per line.
+func millerCoeffs(coeffs []lineCoeffs, p *curvePoint) *gfP12 {
+	ret := (&gfP12{}).SetOne()
+
+	bAffine := &curvePoint{}
+	bAffine.Set(p)
+	bAffine.MakeAffine()
+
+	b, c := &gfP2{}, &gfP2{}
+	next := 0
+	for i := len(sixuPlus2NAF) - 1; i > 0; i-- {
+		if i != len(sixuPlus2NAF)-1 {
+			ret.Square(ret)
+		}
+		l := &coeffs[next]
+		next++
+		b.MulScalar(&l.b, &bAffine.x)
+		c.MulScalar(&l.c, &bAffine.y)
+		mulLine(ret, &l.a, b, c)
+
+		if sixuPlus2NAF[i-1] != 0 {
+			l = &coeffs[next]
+			next++
+			b.MulScalar(&l.b, &bAffine.x)
+			c.MulScalar(&l.c, &bAffine.y)
+			mulLine(ret, &l.a, b, c)
+		}
+	}
+	for ; next < len(coeffs); next++ {
+		l := &coeffs[next]
+		b.MulScalar(&l.b, &bAffine.x)
+		c.MulScalar(&l.c, &bAffine.y)
+		mulLine(ret, &l.a, b, c)
+	}
+	return ret
+}
+
+// Verifier contracts pair many proofs against the same verification-key G2
+// points, so the Miller loop caches their line coefficient sequences in a
+// small LRU keyed by the affine point, following the scalar multiplication
+// comb cache in window.go: sequences are only built for points seen at least
+// twice, so one-off pairings never pay the precomputation.
+const (
+	// lineCacheSize bounds the number of cached G2 bases.
+	lineCacheSize = 8
+
+	// lineBuildHits is the number of sightings of the same G2 point that
+	// triggers recording its coefficient sequence.
+	lineBuildHits = 2
+)
+
+type lineCacheEntry struct {
+	hits    int
+	lastUse uint64
+	coeffs  []lineCoeffs
+}
+
+type lineCache struct {
+	mu      sync.Mutex
+	clock   uint64
+	entries map[[2]gfP2]*lineCacheEntry
+}
+
+var millerLines = &lineCache{entries: make(map[[2]gfP2]*lineCacheEntry)}
+
+// lookup returns the coefficient sequence for aAffine, building it on the
+// second sighting of the same point.
+func (w *lineCache) lookup(aAffine *twistPoint) []lineCoeffs {
+	key := [2]gfP2{aAffine.x, aAffine.y}
+
+	w.mu.Lock()
+	defer w.mu.Unlock()
+
+	w.clock++
+	entry := w.entries[key]
+	if entry == nil {
+		if len(w.entries) >= lineCacheSize {
+			w.evict()
+		}
+		w.entries[key] = &lineCacheEntry{hits: 1, lastUse: w.clock}
+		return nil
+	}
+	entry.hits++
+	entry.lastUse = w.clock
+	if entry.coeffs == nil && entry.hits >= lineBuildHits {
+		entry.coeffs = precomputeLineCoeffs(aAffine)
+	}
+	return entry.coeffs
+}
+
+// evict drops the least recently used entry to make room for a new base.
+func (w *lineCache) evict() {
+	var victim [2]gfP2
+	oldest := ^uint64(0)
+	for key, entry := range w.entries {
+		if entry.lastUse < oldest {
+			oldest = entry.lastUse
+			victim = key
+		}
+	}
+	delete(w.entries, victim)
+}
+
 // sixuPlus2NAF is 6u+2 in non-adjacent form.
 var sixuPlus2NAF = []int8{0, 0, 0, 1, 0, 1, 0, -1, 0, 0, 1, -1, 0, 0, 1, 0,
 	0, 1, 1, 0, -1, 0, 0, 1, 0, -1, 0, 0, 0, 0, 1, 1,
@@ -126,6 +315,12 @@ func miller(q *twistPoint, p *curvePoint) *gfP12 {
 	aAffine.Set(q)
 	aAffine.MakeAffine()
 
+	// Repeated G2 bases (verification keys) are served from cached line
+	// coefficient sequences, skipping the twist ladder entirely.
+	if coeffs := millerLines.lookup(aAffine); coeffs != nil {
+		return millerCoeffs(coeffs, p)
+	}
+
 	bAffine := &curvePoint{}
 	bAffine.Set(p)
 	bAffine.MakeAffine()
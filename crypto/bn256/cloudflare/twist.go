@@ -162,6 +162,15 @@ func (c *twistPoint) Double(a *twistPoint) {
 }
 
 func (c *twistPoint) Mul(a *twistPoint, scalar *big.Int) {
+	// Repeated bases (verification keys hammering the precompile) are served
+	// from cached comb tables, skipping all doubling work; see window.go.
+	if !a.IsInfinity() && a.z.IsOne() {
+		if table := twistWindows.lookup(a); table != nil {
+			twistWindowMul(c, table, scalar)
+			return
+		}
+	}
+
 	sum, t := &twistPoint{}, &twistPoint{}
 
 	for i := scalar.BitLen(); i >= 0; i-- {
@@ -196,6 +205,38 @@ func (c *twistPoint) MakeAffine() {
 	c.t.SetOne()
 }
 
+// twistPointMakeAffineBatch normalizes every point in the slice at the cost
+// of a single field inversion, using gfP2InvertBatch on the collected z
+// coordinates instead of inverting each one separately.
+func twistPointMakeAffineBatch(points []*twistPoint) {
+	zInvs := make([]*gfP2, 0, len(points))
+	todo := make([]*twistPoint, 0, len(points))
+	for _, c := range points {
+		if c.z.IsOne() {
+			continue
+		} else if c.z.IsZero() {
+			c.x.SetZero()
+			c.y.SetOne()
+			c.t.SetZero()
+			continue
+		}
+		zInv := (&gfP2{}).Set(&c.z)
+		zInvs = append(zInvs, zInv)
+		todo = append(todo, c)
+	}
+	gfP2InvertBatch(zInvs)
+
+	for i, c := range todo {
+		t := (&gfP2{}).Mul(&c.y, zInvs[i])
+		zInv2 := (&gfP2{}).Square(zInvs[i])
+		c.y.Mul(t, zInv2)
+		t.Mul(&c.x, zInv2)
+		c.x.Set(t)
+		c.z.SetOne()
+		c.t.SetOne()
+	}
+}
+
 func (c *twistPoint) Neg(a *twistPoint) {
 	c.x.Set(&a.x)
 	c.y.Neg(&a.y)
@@ -0,0 +1,243 @@
+package bn256
+
+import (
+	"math/big"
+	"sync"
+)
+
+// zk-verifier contracts invoke the scalar multiplication precompile with the
+// same verification-key points across thousands of proofs. A small LRU keyed
+// by the affine input point caches fixed-base comb tables: with every
+// m·2^(4j)·P multiple precomputed, a scalar multiplication degenerates to at
+// most 64 point additions with no doubling work at all. Tables are only built
+// for points seen at least twice, so one-off multiplications never pay the
+// precomputation cost.
+
+const (
+	// windowWidth is the comb window size in bits; 4 keeps a table at 15
+	// entries per window for a 16x reduction in additions.
+	windowWidth = 4
+
+	// windowCount covers a full 256-bit scalar; scalars are reduced mod
+	// Order before evaluation so higher windows cannot be hit.
+	windowCount = 256 / windowWidth
+
+	// windowEntries is the number of non-zero digits per window.
+	windowEntries = 1<<windowWidth - 1
+
+	// windowCacheSize bounds the number of cached bases per group; the
+	// dominant workloads cycle through a handful of verification keys.
+	windowCacheSize = 8
+
+	// windowBuildHits is the number of sightings of the same base point
+	// that triggers building its table.
+	windowBuildHits = 2
+)
+
+type curveWindowTable [windowCount][windowEntries]curvePoint
+
+type curveWindowEntry struct {
+	hits    int
+	lastUse uint64
+	table   *curveWindowTable
+}
+
+type curveWindowCache struct {
+	mu      sync.Mutex
+	clock   uint64
+	entries map[[2]gfP]*curveWindowEntry
+}
+
+var curveWindows = &curveWindowCache{entries: make(map[[2]gfP]*curveWindowEntry)}
+
+// lookup returns the window table for a, building it on the second sighting
+// of the same point. The caller must pass an affine, non-infinity point.
+func (w *curveWindowCache) lookup(a *curvePoint) *curveWindowTable {
+	key := [2]gfP{a.x, a.y}
+
+	w.mu.Lock()
+	defer w.mu.Unlock()
+
+	w.clock++
+	entry := w.entries[key]
+	if entry == nil {
+		if len(w.entries) >= windowCacheSize {
+			w.evict()
+		}
+		w.entries[key] = &curveWindowEntry{hits: 1, lastUse: w.clock}
+		return nil
+	}
+	entry.hits++
+	entry.lastUse = w.clock
+	if entry.table == nil && entry.hits >= windowBuildHits {
+		entry.table = newCurveWindowTable(a)
+	}
+	return entry.table
+}
+
+// evict drops the least recently used entry to make room for a new base.
+func (w *curveWindowCache) evict() {
+	var victim [2]gfP
+	oldest := ^uint64(0)
+	for key, entry := range w.entries {
+		if entry.lastUse < oldest {
+			oldest = entry.lastUse
+			victim = key
+		}
+	}
+	delete(w.entries, victim)
+}
+
+func newCurveWindowTable(a *curvePoint) *curveWindowTable {
+	table := new(curveWindowTable)
+	base, t := &curvePoint{}, &curvePoint{}
+	base.Set(a)
+
+	points := make([]*curvePoint, 0, windowCount*windowEntries)
+	for j := 0; j < windowCount; j++ {
+		table[j][0].Set(base)
+		for m := 1; m < windowEntries; m++ {
+			table[j][m].Add(&table[j][m-1], base)
+		}
+		for m := range table[j] {
+			points = append(points, &table[j][m])
+		}
+		if j != windowCount-1 {
+			for i := 0; i < windowWidth; i++ {
+				t.Double(base)
+				base.Set(t)
+			}
+		}
+	}
+	// Normalize the whole table with a single inversion so the additions
+	// during evaluation work on cheap z=1 operands.
+	curvePointMakeAffineBatch(points)
+	return table
+}
+
+// curveWindowMul evaluates c = scalar·P from P's comb table: one table
+// addition per non-zero 4-bit window of the scalar and no doublings.
+func curveWindowMul(c *curvePoint, table *curveWindowTable, scalar *big.Int) {
+	if scalar.Sign() < 0 || scalar.Cmp(Order) >= 0 {
+		scalar = new(big.Int).Mod(scalar, Order)
+	}
+	sum, t := &curvePoint{}, &curvePoint{}
+	sum.SetInfinity()
+
+	for j := 0; j < windowCount; j++ {
+		digit := 0
+		for b := 0; b < windowWidth; b++ {
+			digit |= int(scalar.Bit(windowWidth*j+b)) << uint(b)
+		}
+		if digit != 0 {
+			t.Set(sum)
+			sum.Add(t, &table[j][digit-1])
+		}
+	}
+	c.Set(sum)
+}
+
+// The twist group mirrors the cache above over gfP2 coordinates.
+
+type twistWindowTable [windowCount][windowEntries]twistPoint
+
+type twistWindowEntry struct {
+	hits    int
+	lastUse uint64
+	table   *twistWindowTable
+}
+
+type twistWindowCache struct {
+	mu      sync.Mutex
+	clock   uint64
+	entries map[[2]gfP2]*twistWindowEntry
+}
+
+var twistWindows = &twistWindowCache{entries: make(map[[2]gfP2]*twistWindowEntry)}
+
+// lookup returns the window table for a, building it on the second sighting
+// of the same point. The caller must pass an affine, non-infinity point.
+func (w *twistWindowCache) lookup(a *twistPoint) *twistWindowTable {
+	key := [2]gfP2{a.x, a.y}
+
+	w.mu.Lock()
+	defer w.mu.Unlock()
+
+	w.clock++
+	entry := w.entries[key]
+	if entry == nil {
+		if len(w.entries) >= windowCacheSize {
+			w.evict()
+		}
+		w.entries[key] = &twistWindowEntry{hits: 1, lastUse: w.clock}
+		return nil
+	}
+	entry.hits++
+	entry.lastUse = w.clock
+	if entry.table == nil && entry.hits >= windowBuildHits {
+		entry.table = newTwistWindowTable(a)
+	}
+	return entry.table
+}
+
+// evict drops the least recently used entry to make room for a new base.
+func (w *twistWindowCache) evict() {
+	var victim [2]gfP2
+	oldest := ^uint64(0)
+	for key, entry := range w.entries {
+		if entry.lastUse < oldest {
+			oldest = entry.lastUse
+			victim = key
+		}
+	}
+	delete(w.entries, victim)
+}
+
+func newTwistWindowTable(a *twistPoint) *twistWindowTable {
+	table := new(twistWindowTable)
+	base, t := &twistPoint{}, &twistPoint{}
+	base.Set(a)
+
+	points := make([]*twistPoint, 0, windowCount*windowEntries)
+	for j := 0; j < windowCount; j++ {
+		table[j][0].Set(base)
+		for m := 1; m < windowEntries; m++ {
+			table[j][m].Add(&table[j][m-1], base)
+		}
+		for m := range table[j] {
+			points = append(points, &table[j][m])
+		}
+		if j != windowCount-1 {
+			for i := 0; i < windowWidth; i++ {
+				t.Double(base)
+				base.Set(t)
+			}
+		}
+	}
+	// Normalize the whole table with a single inversion so the additions
+	// during evaluation work on cheap z=1 operands.
+	twistPointMakeAffineBatch(points)
+	return table
+}
+
+// twistWindowMul evaluates c = scalar·Q from Q's comb table: one table
+// addition per non-zero 4-bit window of the scalar and no doublings.
+func twistWindowMul(c *twistPoint, table *twistWindowTable, scalar *big.Int) {
+	if scalar.Sign() < 0 || scalar.Cmp(Order) >= 0 {
+		scalar = new(big.Int).Mod(scalar, Order)
+	}
+	sum, t := &twistPoint{}, &twistPoint{}
+	sum.SetInfinity()
+
+	for j := 0; j < windowCount; j++ {
+		digit := 0
+		for b := 0; b < windowWidth; b++ {
+			digit |= int(scalar.Bit(windowWidth*j+b)) << uint(b)
+		}
+		if digit != 0 {
+			t.Set(sum)
+			sum.Add(t, &table[j][digit-1])
+		}
+	}
+	c.Set(sum)
+}
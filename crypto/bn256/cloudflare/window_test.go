@@ -0,0 +1,93 @@
+package bn256
+
+import (
+	"bytes"
+	"math/big"
+	"testing"
+)
+
+// Tests that scalar multiplication returns the same results before and after
+// the comb table for a repeated base point has been built, checking the
+// cached path against the scalar algebra k·(s·G) == (k·s)·G.
+func TestCurveWindowMul(t *testing.T) {
+	s := bigFromBase10("9876543210987654321098765432109876543210")
+	base := new(G1).ScalarBaseMult(s)
+	base.p.MakeAffine() // precompile inputs arrive affine; the cache keys on that
+
+	scalars := []*big.Int{
+		big.NewInt(0),
+		big.NewInt(1),
+		big.NewInt(15),
+		big.NewInt(16),
+		bigFromBase10("4965661367192848881"),
+		new(big.Int).Sub(Order, big.NewInt(1)),
+		new(big.Int).Add(Order, big.NewInt(7)),
+	}
+	// Run the set repeatedly: the first pass sees a cold cache, later passes
+	// are served from the comb table built on the second sighting.
+	for round := 0; round < 3; round++ {
+		for i, k := range scalars {
+			have := new(G1).ScalarMult(base, k)
+			want := new(G1).ScalarBaseMult(new(big.Int).Mod(new(big.Int).Mul(s, k), Order))
+			if !bytes.Equal(have.Marshal(), want.Marshal()) {
+				t.Fatalf("round %d: scalar %d: mul mismatch: have %x, want %x", round, i, have.Marshal(), want.Marshal())
+			}
+		}
+	}
+}
+
+// Tests the twist group counterpart of TestCurveWindowMul.
+func TestTwistWindowMul(t *testing.T) {
+	s := bigFromBase10("1234567890123456789012345678901234567890")
+	base := new(G2).ScalarBaseMult(s)
+	base.p.MakeAffine() // precompile inputs arrive affine; the cache keys on that
+
+	scalars := []*big.Int{
+		big.NewInt(0),
+		big.NewInt(1),
+		big.NewInt(15),
+		big.NewInt(16),
+		bigFromBase10("4965661367192848881"),
+		new(big.Int).Sub(Order, big.NewInt(1)),
+		new(big.Int).Add(Order, big.NewInt(7)),
+	}
+	for round := 0; round < 3; round++ {
+		for i, k := range scalars {
+			have := new(G2).ScalarMult(base, k)
+			want := new(G2).ScalarBaseMult(new(big.Int).Mod(new(big.Int).Mul(s, k), Order))
+			if !bytes.Equal(have.Marshal(), want.Marshal()) {
+				t.Fatalf("round %d: scalar %d: mul mismatch: have %x, want %x", round, i, have.Marshal(), want.Marshal())
+			}
+		}
+	}
+}
+
+// Tests that the base LRU evicts the oldest entry once more distinct points
+// than windowCacheSize have been multiplied.
+func TestWindowCacheEviction(t *testing.T) {
+	for i := 0; i < 4*windowCacheSize; i++ {
+		k := big.NewInt(int64(1000 + i))
+		base := new(G1).ScalarBaseMult(k)
+		base.p.MakeAffine()
+		new(G1).ScalarMult(base, k)
+	}
+	curveWindows.mu.Lock()
+	size := len(curveWindows.entries)
+	curveWindows.mu.Unlock()
+	if size > windowCacheSize {
+		t.Fatalf("cache overflow: have %d entries, want at most %d", size, windowCacheSize)
+	}
+}
+
+func BenchmarkG1ScalarMultCached(b *testing.B) {
+	k := bigFromBase10("21888242871839275222246405745257275088548364400416034343698204186575808495616")
+	base := new(G1).ScalarBaseMult(bigFromBase10("123456789"))
+	base.p.MakeAffine()
+	e := new(G1)
+	e.ScalarMult(base, k)
+	e.ScalarMult(base, k) // ensure the comb table exists
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		e.ScalarMult(base, k)
+	}
+}
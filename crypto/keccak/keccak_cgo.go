@@ -0,0 +1,96 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+// +build !nacl,!js,!nocgo
+
+// Package keccak provides a native batch engine for Keccak-256 hashing. Four
+// independent inputs share one vectorized Keccak-f[1600] permutation where
+// the hardware supports it, making it worthwhile wherever many hashes are
+// computed together: trie node hashing, transaction hashing and address
+// derivation.
+package keccak
+
+/*
+#cgo CFLAGS: -O3
+#include "keccakpipe.h"
+*/
+import "C"
+
+import "unsafe"
+
+// flatten packs a batch of inputs back to back into a single buffer with n+1
+// offsets, so one cgo call can address the whole batch.
+func flatten(inputs [][]byte) ([]byte, []C.size_t) {
+	total := 0
+	for _, input := range inputs {
+		total += len(input)
+	}
+	flat := make([]byte, total+1) // +1 keeps the pointer valid for empty batches
+	offsets := make([]C.size_t, len(inputs)+1)
+	for i, input := range inputs {
+		copy(flat[int(offsets[i]):], input)
+		offsets[i+1] = offsets[i] + C.size_t(len(input))
+	}
+	return flat, offsets
+}
+
+// digests slices a packed output buffer into per-input 32 byte digests.
+func digests(out []byte, n int) [][]byte {
+	digests := make([][]byte, n)
+	for i := range digests {
+		digests[i] = out[32*i : 32*(i+1) : 32*(i+1)]
+	}
+	return digests
+}
+
+// Sum256Batch computes the Keccak-256 hash of every input independently and
+// returns the digests in input order. The inputs are flattened into a single
+// buffer so the cgo boundary is crossed once per batch; inputs with matching
+// block counts are scheduled four to a vector permutation.
+func Sum256Batch(inputs [][]byte) [][]byte {
+	n := len(inputs)
+	if n == 0 {
+		return nil
+	}
+	flat, offsets := flatten(inputs)
+	out := make([]byte, 32*n)
+	C.eai_keccak256_batch(
+		(*C.uchar)(unsafe.Pointer(&flat[0])),
+		&offsets[0],
+		(*C.uchar)(unsafe.Pointer(&out[0])),
+		C.size_t(n))
+	return digests(out, n)
+}
+
+// Sum256Pipeline computes the Keccak-256 hash of every input independently
+// like Sum256Batch, but shards large batches across a native worker pool with
+// a work-stealing scheduler, keeping all cores busy for the cost of a single
+// cgo round trip. Intended for whole trie subtree levels, where hundreds of
+// independent sibling nodes are hashed together.
+func Sum256Pipeline(inputs [][]byte) [][]byte {
+	n := len(inputs)
+	if n == 0 {
+		return nil
+	}
+	flat, offsets := flatten(inputs)
+	out := make([]byte, 32*n)
+	C.eai_keccak256_pipeline(
+		(*C.uchar)(unsafe.Pointer(&flat[0])),
+		&offsets[0],
+		(*C.uchar)(unsafe.Pointer(&out[0])),
+		C.size_t(n))
+	return digests(out, n)
+}
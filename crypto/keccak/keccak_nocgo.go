@@ -0,0 +1,42 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+// +build nacl js nocgo
+
+// Package keccak provides a native batch engine for Keccak-256 hashing. On
+// platforms without cgo the batch degenerates to sequential hashing through
+// the pure Go implementation.
+package keccak
+
+import "github.com/ethereumai/go-ethereumai/crypto/sha3"
+
+// Sum256Batch computes the Keccak-256 hash of every input independently and
+// returns the digests in input order.
+func Sum256Batch(inputs [][]byte) [][]byte {
+	digests := make([][]byte, len(inputs))
+	for i, input := range inputs {
+		d := sha3.NewKeccak256()
+		d.Write(input)
+		digests[i] = d.Sum(nil)
+	}
+	return digests
+}
+
+// Sum256Pipeline computes the Keccak-256 hash of every input independently.
+// Without cgo there is no native worker pool to shard across.
+func Sum256Pipeline(inputs [][]byte) [][]byte {
+	return Sum256Batch(inputs)
+}
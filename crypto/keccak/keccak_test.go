@@ -0,0 +1,121 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+package keccak
+
+import (
+	"bytes"
+	"math/rand"
+	"testing"
+
+	"github.com/ethereumai/go-ethereumai/crypto/sha3"
+)
+
+func keccak256Ref(input []byte) []byte {
+	d := sha3.NewKeccak256()
+	d.Write(input)
+	return d.Sum(nil)
+}
+
+func TestSum256Batch(t *testing.T) {
+	// Mixed length batches exercise both the lockstep lanes and the scalar
+	// leftovers; sizes straddle the 136 byte rate boundary
+	sizes := []int{0, 1, 32, 100, 135, 136, 137, 271, 272, 273, 20, 32, 32, 32, 600}
+	for batch := 1; batch <= len(sizes); batch++ {
+		inputs := make([][]byte, batch)
+		for i := range inputs {
+			inputs[i] = make([]byte, sizes[i])
+			rand.Read(inputs[i])
+		}
+		digests := Sum256Batch(inputs)
+		if len(digests) != batch {
+			t.Fatalf("batch %d: digest count mismatch: have %d, want %d", batch, len(digests), batch)
+		}
+		for i, digest := range digests {
+			if want := keccak256Ref(inputs[i]); !bytes.Equal(digest, want) {
+				t.Fatalf("batch %d: digest %d mismatch: have %x, want %x", batch, i, digest, want)
+			}
+		}
+	}
+}
+
+func TestSum256Pipeline(t *testing.T) {
+	// Large uneven batches force the worker pool through the work-stealing
+	// path: a handful of huge nodes at one end keeps some ranges busy long
+	// after the others have drained
+	for _, batch := range []int{1, 63, 64, 257, 4096} {
+		inputs := make([][]byte, batch)
+		for i := range inputs {
+			size := i % 300
+			if i%97 == 0 {
+				size = 20000 // oversized stragglers to provoke stealing
+			}
+			inputs[i] = make([]byte, size)
+			rand.Read(inputs[i])
+		}
+		digests := Sum256Pipeline(inputs)
+		if len(digests) != batch {
+			t.Fatalf("batch %d: digest count mismatch: have %d, want %d", batch, len(digests), batch)
+		}
+		for i, digest := range digests {
+			if want := keccak256Ref(inputs[i]); !bytes.Equal(digest, want) {
+				t.Fatalf("batch %d: digest %d mismatch: have %x, want %x", batch, i, digest, want)
+			}
+		}
+	}
+}
+
+func BenchmarkSum256Batch(b *testing.B) {
+	// A trie commit style workload: lots of short nodes of similar size
+	inputs := make([][]byte, 1024)
+	for i := range inputs {
+		inputs[i] = make([]byte, 100)
+		rand.Read(inputs[i])
+	}
+	b.SetBytes(int64(1024 * 100))
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		Sum256Batch(inputs)
+	}
+}
+
+func BenchmarkSum256Pipeline(b *testing.B) {
+	inputs := make([][]byte, 1024)
+	for i := range inputs {
+		inputs[i] = make([]byte, 100)
+		rand.Read(inputs[i])
+	}
+	b.SetBytes(int64(1024 * 100))
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		Sum256Pipeline(inputs)
+	}
+}
+
+func BenchmarkSum256Sequential(b *testing.B) {
+	inputs := make([][]byte, 1024)
+	for i := range inputs {
+		inputs[i] = make([]byte, 100)
+		rand.Read(inputs[i])
+	}
+	b.SetBytes(int64(1024 * 100))
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		for _, input := range inputs {
+			keccak256Ref(input)
+		}
+	}
+}
@@ -0,0 +1,413 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+// Batched Keccak-256 engine. Independent inputs are scheduled onto a 4-lane
+// Keccak-f[1600] where each 256 bit vector holds one state word of four
+// hashes, so the permutation cost is shared by four inputs. Lanes must run
+// in lockstep, so inputs are grouped by padded block count; leftovers and
+// hardware without AVX2 take the scalar permutation. On aarch64 the scalar
+// permutation itself dispatches to an ARMv8.2-SHA3 variant when the cpu
+// advertises the extension.
+
+#ifndef EAI_KECCAKBATCH_H
+#define EAI_KECCAKBATCH_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Clang only exposes the ARMv8.2-SHA3 intrinsics when the whole translation
+ * unit targets the extension, so the runtime-dispatched path below is GCC
+ * only (9+, where the SHA3 ACLE intrinsics landed); a unit built with the
+ * extension enabled globally works with either compiler. */
+#if defined(__aarch64__) && defined(__linux__) && \
+	((defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9) || defined(__ARM_FEATURE_SHA3))
+#define EAI_KECCAK_SHA3EXT 1
+#include <arm_neon.h>
+#include <sys/auxv.h>
+/* missing from older kernel headers; the bit is fixed ABI */
+#ifndef HWCAP_SHA3
+#define HWCAP_SHA3 (1UL << 17)
+#endif
+#endif
+
+#define KECCAK256_RATE 136
+
+static const uint64_t keccakf_rndc[24] = {
+	0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+	0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+	0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+	0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+	0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+	0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+	0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+	0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+static const int keccakf_rotc[24] = {
+	1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14,
+	27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44
+};
+static const int keccakf_piln[24] = {
+	10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4,
+	15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1
+};
+
+static uint64_t keccak_le64(const unsigned char *p) {
+	return (uint64_t)p[0]       | (uint64_t)p[1] << 8  | (uint64_t)p[2] << 16 |
+	       (uint64_t)p[3] << 24 | (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 |
+	       (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+}
+
+static void keccak_st64(unsigned char *p, uint64_t v) {
+	int i;
+	for (i = 0; i < 8; i++) {
+		p[i] = (unsigned char)(v >> (8 * i));
+	}
+}
+
+#define KECCAK_ROL(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+
+static void eai_keccakf1600_generic(uint64_t st[25]) {
+	uint64_t bc[5], t;
+	int round, i, j;
+
+	for (round = 0; round < 24; round++) {
+		/* Theta */
+		for (i = 0; i < 5; i++) {
+			bc[i] = st[i] ^ st[i+5] ^ st[i+10] ^ st[i+15] ^ st[i+20];
+		}
+		for (i = 0; i < 5; i++) {
+			t = bc[(i+4) % 5] ^ KECCAK_ROL(bc[(i+1) % 5], 1);
+			for (j = 0; j < 25; j += 5) {
+				st[j+i] ^= t;
+			}
+		}
+		/* Rho and Pi */
+		t = st[1];
+		for (i = 0; i < 24; i++) {
+			j = keccakf_piln[i];
+			bc[0] = st[j];
+			st[j] = KECCAK_ROL(t, keccakf_rotc[i]);
+			t = bc[0];
+		}
+		/* Chi */
+		for (j = 0; j < 25; j += 5) {
+			for (i = 0; i < 5; i++) {
+				bc[i] = st[j+i];
+			}
+			for (i = 0; i < 5; i++) {
+				st[j+i] ^= (~bc[(i+1) % 5]) & bc[(i+2) % 5];
+			}
+		}
+		/* Iota */
+		st[0] ^= keccakf_rndc[round];
+	}
+}
+
+#if defined(EAI_KECCAK_SHA3EXT)
+
+static int keccak_have_sha3ext(void) {
+	static int have = -1;
+	if (have < 0) {
+		have = (getauxval(AT_HWCAP) & HWCAP_SHA3) != 0 ? 1 : 0;
+	}
+	return have;
+}
+
+/* ARMv8.2-SHA3 permutation: EOR3 folds theta's five-way column parity in two
+ * ops, RAX1 forms the rotated parity pair, XAR fuses each rho-pi word's theta
+ * xor with its rotation and BCAX is chi's xor-and-not, roughly halving the
+ * round's instruction count. XAR rotates by an immediate, so the rho-pi walk
+ * is unrolled with the pi destination, the walked source word's column and
+ * the rotation as literals; word 0 rotates by zero and sits outside the
+ * chain. The instructions are 128-bit wide with only lane 0 populated; the
+ * idle upper lane costs nothing. */
+__attribute__((target("arch=armv8.2-a+sha3")))
+static void eai_keccakf1600_sha3ext(uint64_t st[25]) {
+	uint64x2_t v[25], bc[5], d[5], t, tmp;
+	int round, i, j;
+
+	for (i = 0; i < 25; i++) {
+		v[i] = vdupq_n_u64(st[i]);
+	}
+	for (round = 0; round < 24; round++) {
+		/* Theta */
+		for (i = 0; i < 5; i++) {
+			bc[i] = veor3q_u64(veor3q_u64(v[i], v[i+5], v[i+10]), v[i+15], v[i+20]);
+		}
+		for (i = 0; i < 5; i++) {
+			d[i] = vrax1q_u64(bc[(i+4) % 5], bc[(i+1) % 5]);
+		}
+		/* Rho and Pi */
+		v[0] = veorq_u64(v[0], d[0]);
+		t = v[1];
+#define KECCAK_XAR_STEP(dst, src_col, rot) \
+	tmp = v[dst];                          \
+	v[dst] = vxarq_u64(t, d[src_col], 64 - (rot)); \
+	t = tmp;
+		KECCAK_XAR_STEP(10, 1, 1)
+		KECCAK_XAR_STEP(7, 0, 3)
+		KECCAK_XAR_STEP(11, 2, 6)
+		KECCAK_XAR_STEP(17, 1, 10)
+		KECCAK_XAR_STEP(18, 2, 15)
+		KECCAK_XAR_STEP(3, 3, 21)
+		KECCAK_XAR_STEP(5, 3, 28)
+		KECCAK_XAR_STEP(16, 0, 36)
+		KECCAK_XAR_STEP(8, 1, 45)
+		KECCAK_XAR_STEP(21, 3, 55)
+		KECCAK_XAR_STEP(24, 1, 2)
+		KECCAK_XAR_STEP(4, 4, 14)
+		KECCAK_XAR_STEP(15, 4, 27)
+		KECCAK_XAR_STEP(23, 0, 41)
+		KECCAK_XAR_STEP(19, 3, 56)
+		KECCAK_XAR_STEP(13, 4, 8)
+		KECCAK_XAR_STEP(12, 3, 25)
+		KECCAK_XAR_STEP(2, 2, 43)
+		KECCAK_XAR_STEP(20, 2, 62)
+		KECCAK_XAR_STEP(14, 0, 18)
+		KECCAK_XAR_STEP(22, 4, 39)
+		KECCAK_XAR_STEP(9, 2, 61)
+		KECCAK_XAR_STEP(6, 4, 20)
+		KECCAK_XAR_STEP(1, 1, 44)
+#undef KECCAK_XAR_STEP
+		/* Chi */
+		for (j = 0; j < 25; j += 5) {
+			for (i = 0; i < 5; i++) {
+				bc[i] = v[j+i];
+			}
+			for (i = 0; i < 5; i++) {
+				v[j+i] = vbcaxq_u64(bc[i], bc[(i+2) % 5], bc[(i+1) % 5]);
+			}
+		}
+		/* Iota */
+		v[0] = veorq_u64(v[0], vdupq_n_u64(keccakf_rndc[round]));
+	}
+	for (i = 0; i < 25; i++) {
+		st[i] = vgetq_lane_u64(v[i], 0);
+	}
+}
+
+#endif /* EAI_KECCAK_SHA3EXT */
+
+static void eai_keccakf1600(uint64_t st[25]) {
+#if defined(EAI_KECCAK_SHA3EXT)
+	if (keccak_have_sha3ext()) {
+		eai_keccakf1600_sha3ext(st);
+		return;
+	}
+#endif
+	eai_keccakf1600_generic(st);
+}
+
+/* keccak256_last_block assembles the padded final block of an input. Legacy
+ * Keccak padding (0x01 domain byte) as used throughout the protocol. */
+static void keccak256_last_block(unsigned char block[KECCAK256_RATE], const unsigned char *in, size_t inlen) {
+	size_t tail = inlen % KECCAK256_RATE;
+
+	memset(block, 0, KECCAK256_RATE);
+	memcpy(block, in + (inlen - tail), tail);
+	block[tail] = 0x01;
+	block[KECCAK256_RATE - 1] |= 0x80;
+}
+
+static void eai_keccak256_one(unsigned char *out, const unsigned char *in, size_t inlen) {
+	uint64_t st[25];
+	unsigned char last[KECCAK256_RATE];
+	size_t blocks = inlen / KECCAK256_RATE + 1, b;
+	int w;
+
+	memset(st, 0, sizeof(st));
+	keccak256_last_block(last, in, inlen);
+
+	for (b = 0; b < blocks; b++) {
+		const unsigned char *block = (b == blocks - 1) ? last : in + b * KECCAK256_RATE;
+		for (w = 0; w < KECCAK256_RATE / 8; w++) {
+			st[w] ^= keccak_le64(block + 8 * w);
+		}
+		eai_keccakf1600(st);
+	}
+	for (w = 0; w < 4; w++) {
+		keccak_st64(out + 8 * w, st[w]);
+	}
+}
+
+#if defined(__x86_64__)
+
+static int keccak_have_avx2(void) {
+	static int have = -1;
+	if (have < 0) {
+		have = __builtin_cpu_supports("avx2") ? 1 : 0;
+	}
+	return have;
+}
+
+#define KECCAK_ROLV(x, n) _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - (n)))
+
+__attribute__((target("avx2")))
+static void eai_keccakf1600_x4(__m256i st[25]) {
+	__m256i bc[5], t;
+	int round, i, j;
+
+	for (round = 0; round < 24; round++) {
+		/* Theta */
+		for (i = 0; i < 5; i++) {
+			bc[i] = _mm256_xor_si256(st[i],
+			        _mm256_xor_si256(st[i+5],
+			        _mm256_xor_si256(st[i+10],
+			        _mm256_xor_si256(st[i+15], st[i+20]))));
+		}
+		for (i = 0; i < 5; i++) {
+			t = _mm256_xor_si256(bc[(i+4) % 5], KECCAK_ROLV(bc[(i+1) % 5], 1));
+			for (j = 0; j < 25; j += 5) {
+				st[j+i] = _mm256_xor_si256(st[j+i], t);
+			}
+		}
+		/* Rho and Pi */
+		t = st[1];
+		for (i = 0; i < 24; i++) {
+			j = keccakf_piln[i];
+			bc[0] = st[j];
+			st[j] = KECCAK_ROLV(t, keccakf_rotc[i]);
+			t = bc[0];
+		}
+		/* Chi */
+		for (j = 0; j < 25; j += 5) {
+			for (i = 0; i < 5; i++) {
+				bc[i] = st[j+i];
+			}
+			for (i = 0; i < 5; i++) {
+				st[j+i] = _mm256_xor_si256(st[j+i],
+				          _mm256_andnot_si256(bc[(i+1) % 5], bc[(i+2) % 5]));
+			}
+		}
+		/* Iota */
+		st[0] = _mm256_xor_si256(st[0], _mm256_set1_epi64x((long long)keccakf_rndc[round]));
+	}
+}
+
+/* eai_keccak256_x4 hashes four inputs with identical padded block counts in
+ * lockstep, writing four 32 byte digests. */
+__attribute__((target("avx2")))
+static void eai_keccak256_x4(unsigned char *out, const unsigned char *const in[4], const size_t inlen[4], size_t blocks) {
+	__m256i st[25];
+	unsigned char last[4][KECCAK256_RATE];
+	uint64_t tmp[4];
+	size_t b;
+	int w, lane;
+
+	for (w = 0; w < 25; w++) {
+		st[w] = _mm256_setzero_si256();
+	}
+	for (lane = 0; lane < 4; lane++) {
+		keccak256_last_block(last[lane], in[lane], inlen[lane]);
+	}
+	for (b = 0; b < blocks; b++) {
+		const unsigned char *block[4];
+		for (lane = 0; lane < 4; lane++) {
+			block[lane] = (b == blocks - 1) ? last[lane] : in[lane] + b * KECCAK256_RATE;
+		}
+		for (w = 0; w < KECCAK256_RATE / 8; w++) {
+			__m256i lanes = _mm256_set_epi64x(
+				(long long)keccak_le64(block[3] + 8 * w),
+				(long long)keccak_le64(block[2] + 8 * w),
+				(long long)keccak_le64(block[1] + 8 * w),
+				(long long)keccak_le64(block[0] + 8 * w));
+			st[w] = _mm256_xor_si256(st[w], lanes);
+		}
+		eai_keccakf1600_x4(st);
+	}
+	for (w = 0; w < 4; w++) {
+		_mm256_storeu_si256((__m256i *)tmp, st[w]);
+		for (lane = 0; lane < 4; lane++) {
+			keccak_st64(out + 32 * lane + 8 * w, tmp[lane]);
+		}
+	}
+}
+
+#endif /* __x86_64__ */
+
+/* keccak_batch_order sorts input indices by padded block count so the lane
+ * scheduler below can pick lockstep groups with a linear scan. */
+struct keccak_batch_item {
+	size_t index;
+	size_t blocks;
+};
+
+static int keccak_batch_cmp(const void *a, const void *b) {
+	const struct keccak_batch_item *x = (const struct keccak_batch_item *)a;
+	const struct keccak_batch_item *y = (const struct keccak_batch_item *)b;
+	if (x->blocks != y->blocks) {
+		return x->blocks < y->blocks ? -1 : 1;
+	}
+	return x->index < y->index ? -1 : 1;
+}
+
+// eai_keccak256_batch hashes n independent inputs, packed back to back in
+// data with n+1 offsets, into 32 byte digests at out. Inputs with matching
+// block counts are hashed four at a time on the vector engine when present.
+static void eai_keccak256_batch(const unsigned char *data, const size_t *offsets, unsigned char *out, size_t n) {
+	size_t i;
+
+#if defined(__x86_64__)
+	if (keccak_have_avx2() && n >= 4) {
+		struct keccak_batch_item *items = (struct keccak_batch_item *)malloc(n * sizeof(*items));
+		if (items != NULL) {
+			size_t at = 0;
+
+			for (i = 0; i < n; i++) {
+				items[i].index = i;
+				items[i].blocks = (offsets[i+1] - offsets[i]) / KECCAK256_RATE + 1;
+			}
+			qsort(items, n, sizeof(*items), keccak_batch_cmp);
+
+			while (at < n) {
+				if (at + 4 <= n && items[at].blocks == items[at+3].blocks) {
+					const unsigned char *in[4];
+					size_t inlen[4];
+					unsigned char digests[4 * 32];
+					int lane;
+
+					for (lane = 0; lane < 4; lane++) {
+						size_t idx = items[at + lane].index;
+						in[lane] = data + offsets[idx];
+						inlen[lane] = offsets[idx+1] - offsets[idx];
+					}
+					eai_keccak256_x4(digests, in, inlen, items[at].blocks);
+					for (lane = 0; lane < 4; lane++) {
+						memcpy(out + 32 * items[at + lane].index, digests + 32 * lane, 32);
+					}
+					at += 4;
+				} else {
+					size_t idx = items[at].index;
+					eai_keccak256_one(out + 32 * idx, data + offsets[idx], offsets[idx+1] - offsets[idx]);
+					at++;
+				}
+			}
+			free(items);
+			return;
+		}
+	}
+#endif
+	for (i = 0; i < n; i++) {
+		eai_keccak256_one(out + 32 * i, data + offsets[i], offsets[i+1] - offsets[i]);
+	}
+}
+
+#endif /* EAI_KECCAKBATCH_H */
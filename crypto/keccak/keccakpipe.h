@@ -0,0 +1,239 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+// Parallel subtree hashing pipeline on top of the batched Keccak engine.
+// A packed level of independent sibling nodes is split into one contiguous
+// range per worker; workers drain their own range in small chunks through
+// the 4-lane batch engine and steal the upper half of the fullest remaining
+// range when theirs runs dry, so uneven node sizes cannot strand a core.
+// The pool is created lazily on first use and kept for the process lifetime,
+// like the verification pool in the secp256k1 bundle. Without pthreads the
+// pipeline degrades to a single batch call.
+
+#ifndef EAI_KECCAKPIPE_H
+#define EAI_KECCAKPIPE_H
+
+#include "keccakbatch.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+
+#define EAI_KECCAK_MAX_WORKERS 16
+
+/* Number of nodes a worker claims from its range per trip to the range lock.
+ * A multiple of the lane width so claims split cleanly into vector groups. */
+#define EAI_KECCAK_CHUNK 16
+
+/* Batches below this size are not worth waking the pool for. */
+#define EAI_KECCAK_PIPE_MIN 64
+
+typedef struct {
+	size_t begin; /* next unclaimed node of this range */
+	size_t end;
+	pthread_mutex_t lock;
+} eai_keccak_range;
+
+static struct {
+	pthread_mutex_t lock;
+	pthread_cond_t work_cond; /* signalled when a new level is published */
+	pthread_cond_t done_cond; /* signalled when the last worker finishes */
+	const unsigned char *data;
+	const size_t *offsets;
+	unsigned char *out;
+	eai_keccak_range ranges[EAI_KECCAK_MAX_WORKERS + 1]; /* +1: the caller works too */
+	int nranges;
+	unsigned long generation; /* bumped per published level */
+	int outstanding;          /* pool workers still draining this level */
+	int nworkers;
+} eai_keccak_pipe = {
+	PTHREAD_MUTEX_INITIALIZER,
+	PTHREAD_COND_INITIALIZER,
+	PTHREAD_COND_INITIALIZER,
+	NULL, NULL, NULL,
+	{{0, 0, PTHREAD_MUTEX_INITIALIZER}},
+	0,
+	0,
+	0,
+	0,
+};
+
+/* eai_keccak_pipe_claim hands out the next chunk for a worker: first from
+ * its own range, then by stealing the upper half of the fullest remaining
+ * range. Returns 0 when the whole level is drained. */
+static int eai_keccak_pipe_claim(int id, size_t *begin, size_t *count) {
+	eai_keccak_range *r = &eai_keccak_pipe.ranges[id];
+	size_t left;
+	int victim, fullest;
+
+	pthread_mutex_lock(&r->lock);
+	if (r->begin < r->end) {
+		left = r->end - r->begin;
+		*begin = r->begin;
+		*count = (left < EAI_KECCAK_CHUNK) ? left : EAI_KECCAK_CHUNK;
+		r->begin += *count;
+		pthread_mutex_unlock(&r->lock);
+		return 1;
+	}
+	pthread_mutex_unlock(&r->lock);
+
+	/* Own range drained, look for the fullest victim to split. */
+	for (;;) {
+		size_t best = 0;
+		fullest = -1;
+		for (victim = 0; victim < eai_keccak_pipe.nranges; victim++) {
+			eai_keccak_range *v = &eai_keccak_pipe.ranges[victim];
+			if (victim == id) {
+				continue;
+			}
+			pthread_mutex_lock(&v->lock);
+			left = v->end - v->begin;
+			pthread_mutex_unlock(&v->lock);
+			if (left > best) {
+				best = left;
+				fullest = victim;
+			}
+		}
+		if (fullest < 0) {
+			return 0; /* level drained */
+		}
+		{
+			eai_keccak_range *v = &eai_keccak_pipe.ranges[fullest];
+			pthread_mutex_lock(&v->lock);
+			left = v->end - v->begin;
+			if (left == 0) {
+				/* Raced with the victim, rescan. */
+				pthread_mutex_unlock(&v->lock);
+				continue;
+			}
+			*count = (left + 1) / 2;
+			if (*count > EAI_KECCAK_CHUNK && left > 2 * EAI_KECCAK_CHUNK) {
+				/* Steal half, but serve it chunkwise through our range. */
+				eai_keccak_range *r2 = &eai_keccak_pipe.ranges[id];
+				v->end -= *count;
+				pthread_mutex_unlock(&v->lock);
+				pthread_mutex_lock(&r2->lock);
+				r2->begin = v->end + EAI_KECCAK_CHUNK;
+				r2->end = v->end + *count;
+				pthread_mutex_unlock(&r2->lock);
+				*begin = v->end;
+				*count = EAI_KECCAK_CHUNK;
+				return 1;
+			}
+			v->end -= *count;
+			*begin = v->end;
+			pthread_mutex_unlock(&v->lock);
+			return 1;
+		}
+	}
+}
+
+/* eai_keccak_pipe_drain runs one participant (pool worker or the caller)
+ * until the current level has no work left. */
+static void eai_keccak_pipe_drain(int id) {
+	size_t begin, count;
+
+	while (eai_keccak_pipe_claim(id, &begin, &count)) {
+		eai_keccak256_batch(eai_keccak_pipe.data, eai_keccak_pipe.offsets + begin,
+		                    eai_keccak_pipe.out + 32 * begin, count);
+	}
+}
+
+static void* eai_keccak_pipe_worker(void* arg) {
+	int id = (int)(intptr_t)arg;
+	unsigned long generation = 0;
+
+	pthread_mutex_lock(&eai_keccak_pipe.lock);
+	for (;;) {
+		while (eai_keccak_pipe.generation == generation) {
+			pthread_cond_wait(&eai_keccak_pipe.work_cond, &eai_keccak_pipe.lock);
+		}
+		generation = eai_keccak_pipe.generation;
+		pthread_mutex_unlock(&eai_keccak_pipe.lock);
+
+		eai_keccak_pipe_drain(id);
+
+		pthread_mutex_lock(&eai_keccak_pipe.lock);
+		if (--eai_keccak_pipe.outstanding == 0) {
+			pthread_cond_signal(&eai_keccak_pipe.done_cond);
+		}
+	}
+	return NULL;
+}
+
+static void eai_keccak_pipe_init(void) {
+	long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+	int i, nworkers;
+	pthread_t thread;
+
+	nworkers = (ncpu > 1) ? (int)ncpu - 1 : 0; /* the caller is a participant too */
+	if (nworkers > EAI_KECCAK_MAX_WORKERS) {
+		nworkers = EAI_KECCAK_MAX_WORKERS;
+	}
+	for (i = 0; i < EAI_KECCAK_MAX_WORKERS + 1; i++) {
+		pthread_mutex_init(&eai_keccak_pipe.ranges[i].lock, NULL);
+	}
+	for (i = 0; i < nworkers; i++) {
+		if (pthread_create(&thread, NULL, eai_keccak_pipe_worker, (void*)(intptr_t)i) == 0) {
+			pthread_detach(thread);
+			eai_keccak_pipe.nworkers++;
+		}
+	}
+}
+#endif /* !_WIN32 */
+
+// eai_keccak256_pipeline hashes n packed sibling nodes like
+// eai_keccak256_batch, but shards the level across the native worker pool
+// with the caller participating, so a whole subtree level costs one cgo
+// round trip regardless of core count.
+static void eai_keccak256_pipeline(const unsigned char *data, const size_t *offsets, unsigned char *out, size_t n) {
+#ifndef _WIN32
+	static pthread_once_t once = PTHREAD_ONCE_INIT;
+	pthread_once(&once, eai_keccak_pipe_init);
+
+	if (eai_keccak_pipe.nworkers > 0 && n >= EAI_KECCAK_PIPE_MIN) {
+		int i, nranges = eai_keccak_pipe.nworkers + 1;
+		size_t share = n / nranges;
+
+		pthread_mutex_lock(&eai_keccak_pipe.lock);
+		eai_keccak_pipe.data = data;
+		eai_keccak_pipe.offsets = offsets;
+		eai_keccak_pipe.out = out;
+		eai_keccak_pipe.nranges = nranges;
+		for (i = 0; i < nranges; i++) {
+			eai_keccak_pipe.ranges[i].begin = i * share;
+			eai_keccak_pipe.ranges[i].end = (i == nranges - 1) ? n : (i + 1) * share;
+		}
+		eai_keccak_pipe.outstanding = eai_keccak_pipe.nworkers;
+		eai_keccak_pipe.generation++;
+		pthread_cond_broadcast(&eai_keccak_pipe.work_cond);
+		pthread_mutex_unlock(&eai_keccak_pipe.lock);
+
+		/* The caller drains the last range and steals like any worker. */
+		eai_keccak_pipe_drain(nranges - 1);
+
+		pthread_mutex_lock(&eai_keccak_pipe.lock);
+		while (eai_keccak_pipe.outstanding > 0) {
+			pthread_cond_wait(&eai_keccak_pipe.done_cond, &eai_keccak_pipe.lock);
+		}
+		pthread_mutex_unlock(&eai_keccak_pipe.lock);
+		return;
+	}
+#endif
+	eai_keccak256_batch(data, offsets, out, n);
+}
+
+#endif /* EAI_KECCAKPIPE_H */
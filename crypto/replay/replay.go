@@ -0,0 +1,212 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+// Package replay captures the inputs of native crypto calls on a live node
+// and replays them against any library build.
+//
+// Synthetic uniform-random benchmarks misrepresent production workloads:
+// real traffic repeats pubkeys, clusters nonces and carries spam signatures
+// that fail early. Recording mode logs every signature recovery, signature
+// verification and seal verification input into a compact binary trace
+// (enabled with the GEAI_CRYPTO_CAPTURE environment variable or Start), and
+// Replay reproduces the exact call sequence, so optimization claims can be
+// validated against production truth instead of synthetic distributions.
+//
+// The trace is a stream of records after an 8-byte magic: one kind byte, a
+// little-endian uint32 payload length, and the payload. Inputs are captured
+// before any validation, so a trace preserves malformed calls too.
+package replay
+
+import (
+	"bufio"
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"io"
+	"os"
+	"sync"
+	"sync/atomic"
+)
+
+// Record kinds and their payload layouts.
+const (
+	// KindRecover is a pubkey recovery: 32-byte message hash, 65-byte
+	// compact signature with recovery id.
+	KindRecover = byte(1)
+	// KindVerify is a signature verification: 32-byte message hash, 64-byte
+	// signature, then the 33- or 65-byte public key.
+	KindVerify = byte(2)
+	// KindSeal is a PoW seal verification: little-endian uint64 block
+	// number, 32-byte seal hash, little-endian uint64 nonce.
+	KindSeal = byte(3)
+)
+
+var traceMagic = [8]byte{'g', 'e', 'a', 'i', 'c', 'r', 't', '1'}
+
+var capture struct {
+	active int32 // atomic; fast bail-out for the hooks when not recording
+	mu     sync.Mutex
+	file   *os.File
+	w      *bufio.Writer
+	count  uint64
+}
+
+func init() {
+	if path := os.Getenv("GEAI_CRYPTO_CAPTURE"); path != "" {
+		Start(path)
+	}
+}
+
+// Active reports whether a capture is in progress. Hooks whose inputs are
+// costly to assemble should check it before doing so.
+func Active() bool {
+	return atomic.LoadInt32(&capture.active) == 1
+}
+
+// Start begins recording crypto call inputs to the file at path, truncating
+// any previous trace there. Recording continues until Stop.
+func Start(path string) error {
+	capture.mu.Lock()
+	defer capture.mu.Unlock()
+
+	if capture.file != nil {
+		return errors.New("replay: capture already running")
+	}
+	file, err := os.Create(path)
+	if err != nil {
+		return err
+	}
+	w := bufio.NewWriter(file)
+	if _, err := w.Write(traceMagic[:]); err != nil {
+		file.Close()
+		os.Remove(path)
+		return err
+	}
+	capture.file, capture.w, capture.count = file, w, 0
+	atomic.StoreInt32(&capture.active, 1)
+	return nil
+}
+
+// Stop flushes and closes the running capture, returning the number of
+// records written. Stopping without a capture running is a no-op.
+func Stop() (uint64, error) {
+	capture.mu.Lock()
+	defer capture.mu.Unlock()
+
+	if capture.file == nil {
+		return 0, nil
+	}
+	atomic.StoreInt32(&capture.active, 0)
+	err := capture.w.Flush()
+	if cerr := capture.file.Close(); err == nil {
+		err = cerr
+	}
+	count := capture.count
+	capture.file, capture.w = nil, nil
+	return count, err
+}
+
+// record appends one record, assembling the payload from the given chunks.
+func record(kind byte, chunks ...[]byte) {
+	if atomic.LoadInt32(&capture.active) == 0 {
+		return
+	}
+	size := 0
+	for _, chunk := range chunks {
+		size += len(chunk)
+	}
+	var head [5]byte
+	head[0] = kind
+	binary.LittleEndian.PutUint32(head[1:], uint32(size))
+
+	capture.mu.Lock()
+	defer capture.mu.Unlock()
+	if capture.w == nil { // lost a race with Stop
+		return
+	}
+	capture.w.Write(head[:])
+	for _, chunk := range chunks {
+		capture.w.Write(chunk)
+	}
+	capture.count++
+}
+
+// CaptureRecover records a pubkey recovery input. No-op unless recording.
+func CaptureRecover(msg, sig []byte) {
+	record(KindRecover, msg, sig)
+}
+
+// CaptureVerify records a signature verification input. No-op unless
+// recording.
+func CaptureVerify(pubkey, msg, sig []byte) {
+	record(KindVerify, msg, sig, pubkey)
+}
+
+// CaptureSeal records a PoW seal verification input. No-op unless recording.
+func CaptureSeal(number uint64, sealhash []byte, nonce uint64) {
+	var nums [16]byte
+	binary.LittleEndian.PutUint64(nums[:8], number)
+	binary.LittleEndian.PutUint64(nums[8:], nonce)
+	record(KindSeal, nums[:8], sealhash, nums[8:])
+}
+
+// Record is one captured call, as read back from a trace.
+type Record struct {
+	Kind    byte
+	Payload []byte
+}
+
+// Reader iterates the records of a trace file.
+type Reader struct {
+	file *os.File
+	r    *bufio.Reader
+}
+
+// OpenTrace opens a trace file for reading, validating its magic.
+func OpenTrace(path string) (*Reader, error) {
+	file, err := os.Open(path)
+	if err != nil {
+		return nil, err
+	}
+	var magic [8]byte
+	if _, err := io.ReadFull(file, magic[:]); err != nil || magic != traceMagic {
+		file.Close()
+		return nil, fmt.Errorf("replay: %s is not a capture trace", path)
+	}
+	return &Reader{file: file, r: bufio.NewReader(file)}, nil
+}
+
+// Next returns the next record, or io.EOF after the last one. The payload
+// is only valid until the following call.
+func (r *Reader) Next() (Record, error) {
+	var head [5]byte
+	if _, err := io.ReadFull(r.r, head[:1]); err != nil {
+		return Record{}, err
+	}
+	if _, err := io.ReadFull(r.r, head[1:]); err != nil {
+		return Record{}, fmt.Errorf("replay: truncated record header: %v", err)
+	}
+	payload := make([]byte, binary.LittleEndian.Uint32(head[1:]))
+	if _, err := io.ReadFull(r.r, payload); err != nil {
+		return Record{}, fmt.Errorf("replay: truncated record payload: %v", err)
+	}
+	return Record{Kind: head[0], Payload: payload}, nil
+}
+
+// Close releases the underlying file.
+func (r *Reader) Close() error {
+	return r.file.Close()
+}
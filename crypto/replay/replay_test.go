@@ -0,0 +1,175 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+package replay
+
+import (
+	"bytes"
+	"crypto/ecdsa"
+	"crypto/elliptic"
+	"crypto/rand"
+	"io"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"github.com/btcsuite/btcd/btcec"
+)
+
+// traceFixture records a small mixed workload and returns the trace path:
+// count valid recoveries and verifications from a fresh key, one garbage
+// signature of each kind, and count seal records.
+func traceFixture(t *testing.T, dir string, count int) string {
+	path := filepath.Join(dir, "calls.trace")
+	if err := Start(path); err != nil {
+		t.Fatalf("failed to start capture: %v", err)
+	}
+	// Sign with btcec so the fixture builds the same in cgo and nocgo tests.
+	key, err := ecdsa.GenerateKey(btcec.S256(), rand.Reader)
+	if err != nil {
+		t.Fatalf("failed to generate key: %v", err)
+	}
+	pubkey := elliptic.Marshal(btcec.S256(), key.X, key.Y)
+
+	msg := make([]byte, 32)
+	for i := 0; i < count; i++ {
+		msg[0] = byte(i)
+		sig, err := btcec.SignCompact(btcec.S256(), (*btcec.PrivateKey)(key), msg, false)
+		if err != nil {
+			t.Fatalf("failed to sign: %v", err)
+		}
+		// Convert to the [R || S || V] wire format the hooks capture.
+		v := sig[0] - 27
+		copy(sig, sig[1:])
+		sig[64] = v
+		CaptureRecover(msg, sig)
+		CaptureVerify(pubkey, msg, sig[:64])
+		CaptureSeal(uint64(i), msg, uint64(i)*0x1001)
+	}
+	// Production traces carry spam that fails validation; make sure the
+	// fixture does too.
+	CaptureRecover(msg, make([]byte, 65))
+	CaptureVerify(pubkey, msg, make([]byte, 64))
+
+	if n, err := Stop(); err != nil {
+		t.Fatalf("failed to stop capture: %v", err)
+	} else if want := uint64(3*count + 2); n != want {
+		t.Errorf("captured record count mismatch: have %d, want %d", n, want)
+	}
+	return path
+}
+
+func TestTraceRoundTrip(t *testing.T) {
+	dir, err := ioutil.TempDir("", "replay-test")
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer os.RemoveAll(dir)
+
+	path := traceFixture(t, dir, 4)
+	r, err := OpenTrace(path)
+	if err != nil {
+		t.Fatalf("failed to open trace: %v", err)
+	}
+	defer r.Close()
+
+	kinds := make(map[byte]int)
+	for i := 0; ; i++ {
+		rec, err := r.Next()
+		if err == io.EOF {
+			break
+		}
+		if err != nil {
+			t.Fatalf("record %d: %v", i, err)
+		}
+		switch rec.Kind {
+		case KindRecover:
+			if len(rec.Payload) != 97 {
+				t.Errorf("record %d: recover payload size %d, want 97", i, len(rec.Payload))
+			}
+		case KindVerify:
+			if len(rec.Payload) != 96+65 {
+				t.Errorf("record %d: verify payload size %d, want %d", i, len(rec.Payload), 96+65)
+			}
+		case KindSeal:
+			if len(rec.Payload) != 48 {
+				t.Errorf("record %d: seal payload size %d, want 48", i, len(rec.Payload))
+			}
+		default:
+			t.Fatalf("record %d: unknown kind %d", i, rec.Kind)
+		}
+		kinds[rec.Kind]++
+	}
+	if kinds[KindRecover] != 5 || kinds[KindVerify] != 5 || kinds[KindSeal] != 4 {
+		t.Errorf("record kind counts mismatch: have %v, want 5/5/4", kinds)
+	}
+}
+
+func TestReplayTrace(t *testing.T) {
+	dir, err := ioutil.TempDir("", "replay-test")
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer os.RemoveAll(dir)
+
+	path := traceFixture(t, dir, 4)
+	seals := 0
+	stats, err := Replay(path, func(number uint64, sealhash []byte, nonce uint64) bool {
+		if number != uint64(seals) || nonce != number*0x1001 || len(sealhash) != 32 {
+			t.Errorf("seal %d: unexpected inputs: number %d, nonce %d, hash size %d", seals, number, nonce, len(sealhash))
+		}
+		seals++
+		return true
+	})
+	if err != nil {
+		t.Fatalf("failed to replay trace: %v", err)
+	}
+	if stats.Recovers != 5 || stats.Verifies != 5 || stats.Seals != 4 {
+		t.Errorf("replay counts mismatch: have %+v, want 5/5/4", stats)
+	}
+	if seals != stats.Seals {
+		t.Errorf("seal callback ran %d times, want %d", seals, stats.Seals)
+	}
+	// Only the two deliberately malformed signature calls may be rejected.
+	if stats.Rejected != 2 {
+		t.Errorf("rejected call count mismatch: have %d, want 2", stats.Rejected)
+	}
+	// A nil seal callback counts seal records without executing them.
+	stats, err = Replay(path, nil)
+	if err != nil {
+		t.Fatalf("failed to replay trace without seal callback: %v", err)
+	}
+	if stats.Seals != 4 {
+		t.Errorf("seal count without callback mismatch: have %d, want 4", stats.Seals)
+	}
+}
+
+func TestOpenTraceRejectsGarbage(t *testing.T) {
+	dir, err := ioutil.TempDir("", "replay-test")
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer os.RemoveAll(dir)
+
+	path := filepath.Join(dir, "garbage")
+	if err := ioutil.WriteFile(path, bytes.Repeat([]byte{0x42}, 64), 0644); err != nil {
+		t.Fatal(err)
+	}
+	if _, err := OpenTrace(path); err == nil {
+		t.Errorf("opening a non-trace file succeeded")
+	}
+}
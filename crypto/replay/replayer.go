@@ -0,0 +1,99 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+package replay
+
+import (
+	"encoding/binary"
+	"fmt"
+	"io"
+	"time"
+)
+
+// Stats summarizes one replayed trace. Rejected counts calls whose input
+// failed to recover or verify: those mirror production outcomes (spam
+// signatures fail on a live node too), so they are informational, not
+// replay errors.
+type Stats struct {
+	Recovers int
+	Verifies int
+	Seals    int
+	Rejected int
+	Elapsed  time.Duration
+}
+
+// SealFunc re-executes one captured seal verification, reporting whether
+// the seal was valid.
+type SealFunc func(number uint64, sealhash []byte, nonce uint64) bool
+
+// Replay reproduces the exact call sequence of a capture trace against the
+// linked crypto libraries. Seal records are dispatched through seal, since
+// re-running them needs the caller's eaiash caches; a nil seal counts them
+// without executing. The returned stats cover the whole trace even when
+// some calls are rejected.
+func Replay(path string, seal SealFunc) (Stats, error) {
+	r, err := OpenTrace(path)
+	if err != nil {
+		return Stats{}, err
+	}
+	defer r.Close()
+
+	var stats Stats
+	start := time.Now()
+	for i := 0; ; i++ {
+		rec, err := r.Next()
+		if err == io.EOF {
+			break
+		}
+		if err != nil {
+			return stats, err
+		}
+		switch rec.Kind {
+		case KindRecover:
+			if len(rec.Payload) != 97 {
+				return stats, fmt.Errorf("replay: record %d: bad recover payload size %d", i, len(rec.Payload))
+			}
+			stats.Recovers++
+			if !replayRecover(rec.Payload[:32], rec.Payload[32:]) {
+				stats.Rejected++
+			}
+		case KindVerify:
+			if len(rec.Payload) < 96 {
+				return stats, fmt.Errorf("replay: record %d: bad verify payload size %d", i, len(rec.Payload))
+			}
+			stats.Verifies++
+			if !replayVerify(rec.Payload[96:], rec.Payload[:32], rec.Payload[32:96]) {
+				stats.Rejected++
+			}
+		case KindSeal:
+			if len(rec.Payload) != 48 {
+				return stats, fmt.Errorf("replay: record %d: bad seal payload size %d", i, len(rec.Payload))
+			}
+			stats.Seals++
+			if seal != nil {
+				number := binary.LittleEndian.Uint64(rec.Payload[:8])
+				nonce := binary.LittleEndian.Uint64(rec.Payload[40:])
+				if !seal(number, rec.Payload[8:40], nonce) {
+					stats.Rejected++
+				}
+			}
+		default:
+			return stats, fmt.Errorf("replay: record %d: unknown kind %d", i, rec.Kind)
+		}
+	}
+	stats.Elapsed = time.Since(start)
+	return stats, nil
+}
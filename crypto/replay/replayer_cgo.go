@@ -0,0 +1,36 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+// +build !nacl,!js,!nocgo
+
+package replay
+
+import (
+	"github.com/ethereumai/go-ethereumai/crypto/secp256k1"
+)
+
+// replayRecover re-executes one captured pubkey recovery, reporting whether
+// the recovery succeeded.
+func replayRecover(msg, sig []byte) bool {
+	_, err := secp256k1.RecoverPubkey(msg, sig)
+	return err == nil
+}
+
+// replayVerify re-executes one captured signature verification, reporting
+// whether the signature was valid.
+func replayVerify(pubkey, msg, sig []byte) bool {
+	return secp256k1.VerifySignature(pubkey, msg, sig)
+}
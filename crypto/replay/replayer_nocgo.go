@@ -0,0 +1,66 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+// +build nacl js nocgo
+
+package replay
+
+import (
+	"math/big"
+
+	"github.com/btcsuite/btcd/btcec"
+)
+
+var secp256k1halfN = new(big.Int).Rsh(btcec.S256().N, 1)
+
+// replayRecover re-executes one captured pubkey recovery, reporting whether
+// the recovery succeeded.
+func replayRecover(msg, sig []byte) bool {
+	if len(sig) != 65 {
+		return false
+	}
+	// Reject out-of-range signature values up front: libsecp256k1 fails them
+	// cleanly but btcec's recovery panics on a zero R or S.
+	r, s := new(big.Int).SetBytes(sig[:32]), new(big.Int).SetBytes(sig[32:64])
+	if r.Sign() <= 0 || s.Sign() <= 0 || r.Cmp(btcec.S256().N) >= 0 || s.Cmp(btcec.S256().N) >= 0 || sig[64] > 1 {
+		return false
+	}
+	// Convert to btcec input format with 'recovery id' v at the beginning.
+	btcsig := make([]byte, 65)
+	btcsig[0] = sig[64] + 27
+	copy(btcsig[1:], sig)
+
+	_, _, err := btcec.RecoverCompact(btcec.S256(), btcsig, msg)
+	return err == nil
+}
+
+// replayVerify re-executes one captured signature verification, reporting
+// whether the signature was valid.
+func replayVerify(pubkey, msg, sig []byte) bool {
+	if len(sig) != 64 {
+		return false
+	}
+	signature := &btcec.Signature{R: new(big.Int).SetBytes(sig[:32]), S: new(big.Int).SetBytes(sig[32:])}
+	key, err := btcec.ParsePubKey(pubkey, btcec.S256())
+	if err != nil {
+		return false
+	}
+	// Reject malleable signatures. libsecp256k1 does this check but btcec doesn't.
+	if signature.S.Cmp(secp256k1halfN) > 0 {
+		return false
+	}
+	return signature.Verify(msg, key)
+}
@@ -42,6 +42,10 @@ import (
 /*
 #include "libsecp256k1/include/secp256k1.h"
 extern int secp256k1_ext_scalar_mul(const secp256k1_context* ctx, const unsigned char *point, const unsigned char *scalar);
+typedef struct secp256k1_ext_scalar_mul_session_struct secp256k1_ext_scalar_mul_session;
+extern secp256k1_ext_scalar_mul_session* secp256k1_ext_scalar_mul_session_create(const secp256k1_context* ctx, const unsigned char *point);
+extern void secp256k1_ext_scalar_mul_session_destroy(secp256k1_ext_scalar_mul_session* session);
+extern int secp256k1_ext_scalar_mul_session_mul(const secp256k1_context* ctx, const secp256k1_ext_scalar_mul_session* session, unsigned char *point, const unsigned char *scalar);
 */
 import "C"
 
@@ -258,6 +262,66 @@ func (BitCurve *BitCurve) ScalarBaseMult(k []byte) (*big.Int, *big.Int) {
 	return BitCurve.ScalarMult(BitCurve.Gx, BitCurve.Gy, k)
 }
 
+// ScalarMultSession caches the native multiplication tables for one fixed
+// public point, so repeated ScalarMult calls against the same point (e.g.
+// ECDH during handshake re-keying) pay the table build once. Sessions hold
+// C memory and must be released with Close; the multiplications themselves
+// remain constant time in the scalar.
+type ScalarMultSession struct {
+	session *C.secp256k1_ext_scalar_mul_session
+}
+
+// NewScalarMultSession precomputes the tables for the point (Bx, By), which
+// must be on the curve.
+func NewScalarMultSession(Bx, By *big.Int) *ScalarMultSession {
+	point := make([]byte, 64)
+	math.ReadBits(Bx, point[:32])
+	math.ReadBits(By, point[32:])
+	pointPtr := (*C.uchar)(unsafe.Pointer(&point[0]))
+	return &ScalarMultSession{session: C.secp256k1_ext_scalar_mul_session_create(context, pointPtr)}
+}
+
+// Close releases the session's native tables. The session must not be used
+// afterwards.
+func (s *ScalarMultSession) Close() {
+	if s.session != nil {
+		C.secp256k1_ext_scalar_mul_session_destroy(s.session)
+		s.session = nil
+	}
+}
+
+// ScalarMult multiplies the session's point by scalar, like
+// BitCurve.ScalarMult but without the per-call table setup.
+func (s *ScalarMultSession) ScalarMult(scalar []byte) (*big.Int, *big.Int) {
+	if len(scalar) > 32 {
+		panic("can't handle scalars > 256 bits")
+	}
+	// Pad always, even if scalar is 32 bytes long, to avoid a timing side
+	// channel.
+	padded := make([]byte, 32)
+	copy(padded[32-len(scalar):], scalar)
+	scalar = padded
+
+	point := make([]byte, 64)
+	pointPtr := (*C.uchar)(unsafe.Pointer(&point[0]))
+	scalarPtr := (*C.uchar)(unsafe.Pointer(&scalar[0]))
+	res := C.secp256k1_ext_scalar_mul_session_mul(context, s.session, pointPtr, scalarPtr)
+
+	// Unpack the result and clear temporaries.
+	x := new(big.Int).SetBytes(point[:32])
+	y := new(big.Int).SetBytes(point[32:])
+	for i := range point {
+		point[i] = 0
+	}
+	for i := range padded {
+		scalar[i] = 0
+	}
+	if res != 1 {
+		return nil, nil
+	}
+	return x, y
+}
+
 // Marshal converts a point into the form specified in section 4.3.6 of ANSI
 // X9.62.
 func (BitCurve *BitCurve) Marshal(x, y *big.Int) []byte {
@@ -16,7 +16,318 @@
 
 // secp256k1_context_create_sign_verify creates a context for signing and signature verification.
 static secp256k1_context* secp256k1_context_create_sign_verify() {
-	return secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+	return secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY_VARTIME);
+}
+
+// Shared verification tables. The pre_g odd-multiples tables are identical for
+// every process on a machine, but each context builds them into private heap.
+// secp256k1_ext_context_create_mmap persists the tables to a file once and
+// lets every subsequent process map them shared and read-only, so the physical
+// pages are deduplicated by the kernel across all node processes.
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct {
+	unsigned char magic[8]; /* "secpvtb1" */
+	uint32_t byteorder;     /* 0x01020304 written natively, detects foreign endianness */
+	uint32_t entrysize;     /* sizeof(secp256k1_ge_storage), detects field representation */
+	uint32_t entries;       /* ECMULT_TABLE_SIZE(WINDOW_G) */
+	uint32_t tables;        /* 2 with the endomorphism (pre_g + pre_g_128), 1 without */
+} secp256k1_ext_table_header;
+
+static const unsigned char secp256k1_ext_table_magic[8] = "secpvtb1";
+
+#ifdef USE_ENDOMORPHISM
+#define SECP256K1_EXT_NUM_TABLES 2
+#else
+#define SECP256K1_EXT_NUM_TABLES 1
+#endif
+
+// secp256k1_ext_context_create_mmap creates a context for signing and verification
+// whose verification tables are backed by the file at path. If the file exists and
+// matches this build's table layout, the tables are mapped shared read-only and no
+// table construction happens. Otherwise the tables are built as usual and written
+// to the file for the next process to map.
+//
+// The returned context must not be passed to secp256k1_context_destroy: its pre_g
+// pointers reference the mapping, not heap memory. It is intended for the single
+// process-lifetime context the Go side holds.
+//
+// Returns NULL only if context creation itself fails; file and mapping problems
+// fall back to a regular private context.
+static secp256k1_context* secp256k1_ext_context_create_mmap(const char* path) {
+	size_t tablesize = sizeof(secp256k1_ge_storage) * ECMULT_TABLE_SIZE(WINDOW_G);
+	size_t filesize = sizeof(secp256k1_ext_table_header) + SECP256K1_EXT_NUM_TABLES * tablesize;
+	secp256k1_context* ctx;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd >= 0) {
+		struct stat st;
+		unsigned char *map = MAP_FAILED;
+		if (fstat(fd, &st) == 0 && (size_t)st.st_size == filesize) {
+			map = (unsigned char*)mmap(NULL, filesize, PROT_READ, MAP_SHARED, fd, 0);
+		}
+		close(fd);
+		if (map != MAP_FAILED) {
+			const secp256k1_ext_table_header *hdr = (const secp256k1_ext_table_header*)map;
+			if (memcmp(hdr->magic, secp256k1_ext_table_magic, 8) == 0 &&
+				hdr->byteorder == UINT32_C(0x01020304) &&
+				hdr->entrysize == (uint32_t)sizeof(secp256k1_ge_storage) &&
+				hdr->entries == (uint32_t)ECMULT_TABLE_SIZE(WINDOW_G) &&
+				hdr->tables == (uint32_t)SECP256K1_EXT_NUM_TABLES) {
+				/* Sign-only context: skips building the verification tables. */
+				ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN);
+				if (ctx == NULL) {
+					munmap(map, filesize);
+					return NULL;
+				}
+				ctx->ecmult_ctx.pre_g = (secp256k1_ge_storage (*)[])(map + sizeof(*hdr));
+#ifdef USE_ENDOMORPHISM
+				ctx->ecmult_ctx.pre_g_128 = (secp256k1_ge_storage (*)[])(map + sizeof(*hdr) + tablesize);
+#endif
+				/* The file always holds full-profile split tables. */
+				ctx->ecmult_ctx.window_g = WINDOW_G;
+				return ctx;
+			}
+			munmap(map, filesize);
+		}
+	}
+
+	/* No usable file: build privately and try to publish for the next process. */
+	ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY_VARTIME);
+	if (ctx == NULL) {
+		return NULL;
+	}
+	fd = open(path, O_WRONLY | O_CREAT | O_EXCL, 0644);
+	if (fd >= 0) {
+		secp256k1_ext_table_header hdr;
+		int ok;
+		memcpy(hdr.magic, secp256k1_ext_table_magic, 8);
+		hdr.byteorder = UINT32_C(0x01020304);
+		hdr.entrysize = (uint32_t)sizeof(secp256k1_ge_storage);
+		hdr.entries = (uint32_t)ECMULT_TABLE_SIZE(WINDOW_G);
+		hdr.tables = (uint32_t)SECP256K1_EXT_NUM_TABLES;
+		ok = write(fd, &hdr, sizeof(hdr)) == (ssize_t)sizeof(hdr);
+#ifdef USE_ENDOMORPHISM
+		if (ctx->ecmult_ctx.pre_g_interleaved) {
+			/* The file always stores the two tables split, so a process whose
+			 * build-time layout benchmark went the other way can still map it.
+			 * De-interleave into a scratch copy before writing. */
+			secp256k1_ge_storage *split = (secp256k1_ge_storage*)malloc(2 * tablesize);
+			if (split != NULL) {
+				size_t i;
+				for (i = 0; i < (size_t)ECMULT_TABLE_SIZE(WINDOW_G); i++) {
+					split[i] = (*ctx->ecmult_ctx.pre_g)[2 * i];
+					split[ECMULT_TABLE_SIZE(WINDOW_G) + i] = (*ctx->ecmult_ctx.pre_g)[2 * i + 1];
+				}
+				ok = ok && write(fd, split, 2 * tablesize) == (ssize_t)(2 * tablesize);
+				free(split);
+			} else {
+				ok = 0;
+			}
+		} else {
+			ok = ok && write(fd, *ctx->ecmult_ctx.pre_g, tablesize) == (ssize_t)tablesize;
+			ok = ok && write(fd, *ctx->ecmult_ctx.pre_g_128, tablesize) == (ssize_t)tablesize;
+		}
+#else
+		ok = ok && write(fd, *ctx->ecmult_ctx.pre_g, tablesize) == (ssize_t)tablesize;
+#endif
+		close(fd);
+		if (!ok) {
+			unlink(path); /* do not leave a truncated table behind */
+		}
+	}
+	return ctx;
+}
+#else /* _WIN32 */
+// No shared mapping support; fall back to a regular private context.
+static secp256k1_context* secp256k1_ext_context_create_mmap(const char* path) {
+	(void)path;
+	return secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY_VARTIME);
+}
+#endif /* !_WIN32 */
+
+/* ---------------------------------------------------------------------------
+ * Startup self-calibration.
+ *
+ * The verification tables come in two geometries (WINDOW_G and
+ * WINDOW_G_SMALL): the large tables win on most parts, but on
+ * cache-constrained microarchitectures the small profile's working set can
+ * be worth more than the extra precomputed hits, and which side wins varies
+ * across cpu generations. Instead of a static default, the first start on a
+ * host times a short burst of verifications against a scratch context of
+ * each geometry and caches the verdict, tagged with a host signature, in a
+ * file; later starts on the machine reuse it without probing.
+ */
+
+/* Outcome of the most recent geometry calibration, kept for the capability
+ * report in ffi.h. small stays -1 until a calibrated context is created. */
+static struct {
+	char path[256]; /* verdict cache file, empty when none was used */
+	int small;      /* 1: small tables won, 0: large tables won */
+	int probed;     /* this process ran the probe (vs reusing a cached verdict) */
+} secp256k1_ext_calibration = {{0}, -1, 0};
+
+#ifndef _WIN32
+
+#include <inttypes.h>
+#include <time.h>
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#include <cpuid.h>
+#endif
+
+#define SECP256K1_EXT_CALIBRATE_VERIFIES 96
+
+static uint64_t secp256k1_ext_host_signature(void) {
+	uint32_t words[8] = {0};
+	int i, n = 0;
+	uint64_t sig = 0xcbf29ce484222325ull; /* FNV-1a over the host identity */
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+	unsigned int eax, ebx, ecx, edx;
+	if (__get_cpuid(0, &eax, &ebx, &ecx, &edx)) {
+		words[n++] = ebx; /* vendor string */
+		words[n++] = edx;
+		words[n++] = ecx;
+	}
+	if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+		words[n++] = eax; /* family/model/stepping */
+	}
+#endif
+	words[n++] = (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
+	for (i = 0; i < n; i++) {
+		sig = (sig ^ words[i]) * 0x100000001b3ull;
+	}
+	return sig;
+}
+
+/* Time a burst of verifications on a scratch context with the given flags.
+ * Returns nanoseconds, or UINT64_MAX if the context or signature could not
+ * be set up. */
+static uint64_t secp256k1_ext_calibrate_verify_ns(unsigned int flags) {
+	secp256k1_context* ctx = secp256k1_context_create(flags);
+	unsigned char seckey[32], msg[32];
+	secp256k1_ecdsa_signature sig;
+	secp256k1_pubkey pub;
+	uint64_t out = UINT64_MAX;
+
+	if (ctx == NULL) {
+		return out;
+	}
+	memset(seckey, 0x5c, sizeof(seckey));
+	memset(msg, 0x42, sizeof(msg));
+	if (secp256k1_ec_pubkey_create(ctx, &pub, seckey) &&
+		secp256k1_ecdsa_sign(ctx, &sig, msg, seckey, NULL, NULL)) {
+		struct timespec t0, t1;
+		int i, ok;
+		/* one warm verification faults the tables in */
+		ok = secp256k1_ecdsa_verify(ctx, &sig, msg, &pub);
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		for (i = 0; i < SECP256K1_EXT_CALIBRATE_VERIFIES; i++) {
+			ok &= secp256k1_ecdsa_verify(ctx, &sig, msg, &pub);
+		}
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		if (ok) {
+			out = (uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000000u +
+				(uint64_t)(t1.tv_nsec - t0.tv_nsec);
+		}
+	}
+	secp256k1_context_destroy(ctx);
+	return out;
+}
+
+/* secp256k1_ext_context_create_calibrated creates a signing and verification
+ * context with the table geometry the probe (or the cached verdict at path)
+ * says is faster on this host. Racing processes probe independently and
+ * write the same verdict, so the cache file needs no locking. */
+static secp256k1_context* secp256k1_ext_context_create_calibrated(const char* path) {
+	unsigned int const base = SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY_VARTIME;
+	unsigned int flags = base;
+	uint64_t const host = secp256k1_ext_host_signature();
+	int small = -1;
+	int probed = 0;
+	FILE* f = fopen(path, "r");
+
+	if (f != NULL) {
+		uint64_t stored = 0;
+		int s = -1;
+		if (fscanf(f, "secp-calib-1 %" SCNx64 " %d", &stored, &s) == 2 &&
+			stored == host && (s == 0 || s == 1)) {
+			small = s;
+		}
+		fclose(f);
+	}
+	if (small < 0) {
+		uint64_t const large_ns = secp256k1_ext_calibrate_verify_ns(base);
+		uint64_t const small_ns = secp256k1_ext_calibrate_verify_ns(
+			base | SECP256K1_FLAGS_BIT_CONTEXT_SMALL_TABLES);
+		if (large_ns == UINT64_MAX && small_ns == UINT64_MAX) {
+			return secp256k1_context_create(base);
+		}
+		small = small_ns < large_ns ? 1 : 0;
+		probed = 1;
+		f = fopen(path, "w");
+		if (f != NULL) {
+			fprintf(f, "secp-calib-1 %016" PRIx64 " %d\n", host, small);
+			fclose(f);
+		}
+	}
+	secp256k1_ext_calibration.small = small;
+	secp256k1_ext_calibration.probed = probed;
+	snprintf(secp256k1_ext_calibration.path, sizeof(secp256k1_ext_calibration.path), "%s", path);
+	if (small == 1) {
+		flags |= SECP256K1_FLAGS_BIT_CONTEXT_SMALL_TABLES;
+	}
+	return secp256k1_context_create(flags);
+}
+
+#else /* _WIN32 */
+
+static secp256k1_context* secp256k1_ext_context_create_calibrated(const char* path) {
+	(void)path;
+	return secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY_VARTIME);
+}
+
+#endif /* !_WIN32 */
+
+// secp256k1_ext_ge_put_b64 writes the affine coordinates of a group element
+// as big endian X || Y, straight from the field representation. This skips
+// the secp256k1_pubkey_save/parse round-trip that secp256k1_ec_pubkey_serialize
+// would perform on a key that was just recovered.
+static void secp256k1_ext_ge_put_b64(unsigned char *out, secp256k1_ge *q) {
+	secp256k1_fe_normalize_var(&q->x);
+	secp256k1_fe_normalize_var(&q->y);
+	secp256k1_fe_get_b32(out, &q->x);
+	secp256k1_fe_get_b32(out + 32, &q->y);
+}
+
+// secp256k1_ext_ecdsa_recover_ge recovers the signer of an encoded compact
+// signature as a group element.
+static int secp256k1_ext_ecdsa_recover_ge(
+	const secp256k1_context* ctx,
+	secp256k1_ge *q,
+	const unsigned char *sigdata,
+	const unsigned char *msgdata
+) {
+	secp256k1_ecdsa_recoverable_signature sig;
+	secp256k1_scalar r, s, m;
+	int recid;
+	int ret;
+	SECP256K1_STATS_DECL
+
+	if (!secp256k1_ecdsa_recoverable_signature_parse_compact(ctx, &sig, sigdata, (int)sigdata[64])) {
+		return 0;
+	}
+	secp256k1_ecdsa_recoverable_signature_load(ctx, &r, &s, &recid, &sig);
+	secp256k1_scalar_set_b32(&m, msgdata, NULL);
+	ret = secp256k1_ecdsa_sig_recover(&ctx->ecmult_ctx, &r, &s, q, &m, recid);
+	SECP256K1_STATS_DONE(ctx, SECP256K1_CONTEXT_STATS_RECOVER);
+	return ret;
 }
 
 // secp256k1_ext_ecdsa_recover recovers the public key of an encoded compact signature.
@@ -33,17 +344,138 @@ static int secp256k1_ext_ecdsa_recover(
 	const unsigned char *sigdata,
 	const unsigned char *msgdata
 ) {
-	secp256k1_ecdsa_recoverable_signature sig;
+	secp256k1_ge q;
+
+	if (!secp256k1_ext_ecdsa_recover_ge(ctx, &q, sigdata, msgdata)) {
+		return 0;
+	}
+	pubkey_out[0] = 0x04;
+	secp256k1_ext_ge_put_b64(pubkey_out + 1, &q);
+	return 1;
+}
+
+// secp256k1_ext_ecdsa_recover_address_input recovers the signer of an encoded
+// compact signature and writes the 64-byte X || Y buffer that the address
+// derivation hashes, without the uncompressed-key prefix byte.
+//
+// Returns: 1: recovery was successful
+//          0: recovery was not successful
+// Args:    ctx:       pointer to a context object (cannot be NULL)
+//  Out:    hash_input: the 64-byte Keccak input deriving the signer address (cannot be NULL)
+//  In:     sigdata:   pointer to a 65-byte signature with the recovery id at the end (cannot be NULL)
+//          msgdata:   pointer to a 32-byte message (cannot be NULL)
+static int secp256k1_ext_ecdsa_recover_address_input(
+	const secp256k1_context* ctx,
+	unsigned char *hash_input,
+	const unsigned char *sigdata,
+	const unsigned char *msgdata
+) {
+	secp256k1_ge q;
+
+	if (!secp256k1_ext_ecdsa_recover_ge(ctx, &q, sigdata, msgdata)) {
+		return 0;
+	}
+	secp256k1_ext_ge_put_b64(hash_input, &q);
+	return 1;
+}
+
+// secp256k1_ext_ecdsa_verify_scratch is secp256k1_ext_ecdsa_verify with the
+// temporary multiplication tables taken from scratch, letting batch loops
+// reuse one warm allocation per worker instead of rebuilding them per call.
+static int secp256k1_ext_ecdsa_verify_scratch(
+	const secp256k1_context* ctx,
+	secp256k1_scratch *scratch,
+	const unsigned char *sigdata,
+	const unsigned char *msgdata,
+	const unsigned char *pubkeydata,
+	size_t pubkeylen
+) {
+	secp256k1_ecdsa_signature sig;
 	secp256k1_pubkey pubkey;
+	secp256k1_scalar r, s, m;
+	secp256k1_ge q;
+	int ret;
+	SECP256K1_STATS_DECL
+
+	if (!secp256k1_ecdsa_signature_parse_compact(ctx, &sig, sigdata)) {
+		return 0;
+	}
+	if (!secp256k1_ec_pubkey_parse(ctx, &pubkey, pubkeydata, pubkeylen)) {
+		return 0;
+	}
+	secp256k1_scalar_set_b32(&m, msgdata, NULL);
+	secp256k1_ecdsa_signature_load(ctx, &r, &s, &sig);
+	ret = (!secp256k1_scalar_is_high(&s) &&
+		secp256k1_pubkey_load(ctx, &q, &pubkey) &&
+		secp256k1_ecdsa_sig_verify_scratch(&ctx->ecmult_ctx, scratch, &r, &s, &q, &m));
+	SECP256K1_STATS_DONE(ctx, SECP256K1_CONTEXT_STATS_VERIFY);
+	return ret;
+}
+
+// secp256k1_ext_ecdsa_verify_recover runs the recovery kernel once and serves
+// both call shapes of the RPC layer. With pubkeydata == NULL it completes a
+// plain recovery and writes the recovered key to pubkey_out. With an expected
+// key it short-circuits into a comparison right after the shared ecmult: the
+// recovered point is matched against the expected one in Jacobian coordinates,
+// skipping the field inversion and serialization a recover-then-compare
+// round-trip would pay.
+//
+// Returns: 1: the signature is valid (and by the expected key when given)
+//          0: recovery failed or the signer does not match
+// Args:    ctx:        pointer to a context object (cannot be NULL)
+//          scratch:    scratch space for the temporary multiplication tables (may be NULL)
+//  Out:    pubkey_out: the serialized 65-byte recovered key (may be NULL when pubkeydata is given)
+//  In:     sigdata:    pointer to a 65-byte signature with the recovery id at the end (cannot be NULL)
+//          msgdata:    pointer to a 32-byte message (cannot be NULL)
+//          pubkeydata: the expected public key, or NULL to recover the signer
+//          pubkeylen:  length of pubkeydata
+static int secp256k1_ext_ecdsa_verify_recover(
+	const secp256k1_context* ctx,
+	secp256k1_scratch *scratch,
+	unsigned char *pubkey_out,
+	const unsigned char *sigdata,
+	const unsigned char *msgdata,
+	const unsigned char *pubkeydata,
+	size_t pubkeylen
+) {
+	secp256k1_ecdsa_recoverable_signature sig;
+	secp256k1_scalar r, s, m;
+	secp256k1_gej qj;
+	secp256k1_ge q;
+	int recid;
+	int ret;
+	SECP256K1_STATS_DECL
 
 	if (!secp256k1_ecdsa_recoverable_signature_parse_compact(ctx, &sig, sigdata, (int)sigdata[64])) {
 		return 0;
 	}
-	if (!secp256k1_ecdsa_recover(ctx, &pubkey, &sig, msgdata)) {
+	secp256k1_ecdsa_recoverable_signature_load(ctx, &r, &s, &recid, &sig);
+	secp256k1_scalar_set_b32(&m, msgdata, NULL);
+	if (!secp256k1_ecdsa_sig_recover_gej_scratch(&ctx->ecmult_ctx, scratch, &r, &s, &qj, &m, recid)) {
 		return 0;
 	}
-	size_t outputlen = 65;
-	return secp256k1_ec_pubkey_serialize(ctx, pubkey_out, &outputlen, &pubkey, SECP256K1_EC_UNCOMPRESSED);
+	if (pubkeydata != NULL) {
+		secp256k1_pubkey pubkey;
+		secp256k1_gej diff;
+
+		if (!secp256k1_ec_pubkey_parse(ctx, &pubkey, pubkeydata, pubkeylen) ||
+			!secp256k1_pubkey_load(ctx, &q, &pubkey)) {
+			return 0;
+		}
+		secp256k1_ge_neg(&q, &q);
+		/* qj comes straight out of secp256k1_ecmult, whose formulas leave
+		 * the coordinates within the relaxed accumulator bounds, so the
+		 * comparison addition can skip the input normalizations. */
+		secp256k1_gej_add_ge_var_relaxed(&diff, &qj, &q);
+		ret = secp256k1_gej_is_infinity(&diff);
+		SECP256K1_STATS_DONE(ctx, SECP256K1_CONTEXT_STATS_VERIFY);
+		return ret;
+	}
+	secp256k1_ge_set_gej_var(&q, &qj);
+	pubkey_out[0] = 0x04;
+	secp256k1_ext_ge_put_b64(pubkey_out + 1, &q);
+	SECP256K1_STATS_DONE(ctx, SECP256K1_CONTEXT_STATS_RECOVER);
+	return 1;
 }
 
 // secp256k1_ext_ecdsa_verify verifies an encoded compact signature.
@@ -74,6 +506,686 @@ static int secp256k1_ext_ecdsa_verify(
 	return secp256k1_ecdsa_verify(ctx, &sig, msgdata, &pubkey);
 }
 
+// Shared native worker infrastructure: the worker-count cap and the
+// NUMA-aware placement below are used by both the batch FFI layer (ffi.h)
+// and the async job pool further down.
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+
+#define SECP256K1_EXT_MAX_WORKERS 16
+
+// NUMA-aware worker placement. On multi-socket machines every worker hammers
+// the one pre_g table allocated on whichever node built the context, so half
+// the pool pays cross-socket latency on each table fetch. NUMA mode clones
+// the context once per node while pinned to it, so first-touch allocation
+// places each replica's tables locally, and pins pool workers round-robin to
+// their node's replica. Linux only; elsewhere it reports zero nodes.
+#ifdef __linux__
+#include <sched.h>
+
+#define SECP256K1_EXT_MAX_NODES 8
+
+static struct {
+	int nnodes;
+	cpu_set_t cpus[SECP256K1_EXT_MAX_NODES];
+	const secp256k1_context *replicas[SECP256K1_EXT_MAX_NODES];
+} secp256k1_ext_numa = {0, {{{0}}}, {NULL}};
+
+// secp256k1_ext_parse_cpulist parses a sysfs cpulist ("0-7,16-23") into set.
+// Returns the number of cpus in the list, 0 when the file does not exist.
+static int secp256k1_ext_parse_cpulist(const char *path, cpu_set_t *set) {
+	FILE *f = fopen(path, "r");
+	int lo, hi, ch, cpus = 0;
+
+	if (f == NULL) {
+		return 0;
+	}
+	CPU_ZERO(set);
+	while (fscanf(f, "%d", &lo) == 1) {
+		hi = lo;
+		ch = fgetc(f);
+		if (ch == '-') {
+			if (fscanf(f, "%d", &hi) != 1) {
+				break;
+			}
+			ch = fgetc(f);
+		}
+		for (; lo <= hi && lo < CPU_SETSIZE; lo++) {
+			CPU_SET(lo, set);
+			cpus++;
+		}
+		if (ch != ',') {
+			break;
+		}
+	}
+	fclose(f);
+	return cpus;
+}
+
+// secp256k1_ext_numa_enable discovers the node topology and replicates the
+// verification context once per node. It must be called during startup,
+// before the batch or job APIs spawn their workers; workers spawned
+// afterwards bind to the replica local to their node. The replicas are
+// retained for the lifetime of the process, like the context they clone.
+//
+// Returns: the number of node replicas in use, 0 on single-node machines
+//          or when topology discovery failed
+static int secp256k1_ext_numa_enable(const secp256k1_context* ctx) {
+	char path[64];
+	cpu_set_t old;
+	int node, nnodes;
+
+	if (secp256k1_ext_numa.nnodes > 0) {
+		return secp256k1_ext_numa.nnodes; /* already enabled */
+	}
+	for (nnodes = 0; nnodes < SECP256K1_EXT_MAX_NODES; nnodes++) {
+		snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", nnodes);
+		if (secp256k1_ext_parse_cpulist(path, &secp256k1_ext_numa.cpus[nnodes]) == 0) {
+			break;
+		}
+	}
+	if (nnodes < 2 || sched_getaffinity(0, sizeof(old), &old) != 0) {
+		return 0;
+	}
+	for (node = 0; node < nnodes; node++) {
+		/* Pin to the node so the clone's tables are first-touched locally. */
+		sched_setaffinity(0, sizeof(cpu_set_t), &secp256k1_ext_numa.cpus[node]);
+		secp256k1_ext_numa.replicas[node] = secp256k1_context_clone(ctx);
+	}
+	sched_setaffinity(0, sizeof(old), &old);
+	secp256k1_ext_numa.nnodes = nnodes;
+	return nnodes;
+}
+
+// secp256k1_ext_numa_bind pins the calling pool worker to its round-robin
+// node and returns the node's context replica, or NULL when NUMA mode is off.
+static const secp256k1_context* secp256k1_ext_numa_bind(int worker) {
+	int node;
+
+	if (secp256k1_ext_numa.nnodes == 0) {
+		return NULL;
+	}
+	node = worker % secp256k1_ext_numa.nnodes;
+	sched_setaffinity(0, sizeof(cpu_set_t), &secp256k1_ext_numa.cpus[node]);
+	return secp256k1_ext_numa.replicas[node];
+}
+#else
+static int secp256k1_ext_numa_enable(const secp256k1_context* ctx) {
+	(void)ctx;
+	return 0;
+}
+
+static const secp256k1_context* secp256k1_ext_numa_bind(int worker) {
+	(void)worker;
+	return NULL;
+}
+#endif /* __linux__ */
+#endif /* !_WIN32 */
+
+#ifndef _WIN32
+#define SECP256K1_EXT_NONCE_POOL_MAX 1024
+
+// A process-wide pool of precomputed (nonce, R = nonce*G) pairs, so a burst
+// of signing requests only pays scalar arithmetic while the ecmult_gen work
+// happened during idle time. Entries are popped exactly once and wiped.
+static struct {
+	pthread_mutex_t lock;
+	size_t count;
+	secp256k1_scalar nonces[SECP256K1_EXT_NONCE_POOL_MAX];
+	secp256k1_ge points[SECP256K1_EXT_NONCE_POOL_MAX];
+} secp256k1_ext_nonce_pool = {
+	PTHREAD_MUTEX_INITIALIZER,
+	0,
+	{{{0}}},
+	{{{0}}},
+};
+
+// secp256k1_ext_nonce_pool_fill derives nonces from caller-provided entropy
+// and precomputes their public points into the pool.
+//
+// Returns: the number of pairs actually added; entries whose seed is not a
+//          valid nonzero scalar, or that do not fit the pool, are dropped
+// Args:    ctx:     pointer to a context object initialized for signing (cannot be NULL)
+//  In:     seeds:   n concatenated 32-byte high-entropy seeds (cannot be NULL)
+//          n:       number of seeds
+static size_t secp256k1_ext_nonce_pool_fill(
+	const secp256k1_context* ctx,
+	const unsigned char *seeds,
+	size_t n
+) {
+	size_t added = 0;
+	size_t i;
+
+	if (!secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx)) {
+		return 0;
+	}
+	for (i = 0; i < n; i++) {
+		secp256k1_scalar k;
+		secp256k1_gej rj;
+		secp256k1_ge r;
+		int overflow = 0;
+
+		secp256k1_scalar_set_b32(&k, seeds + i*32, &overflow);
+		if (overflow || secp256k1_scalar_is_zero(&k)) {
+			continue;
+		}
+		secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &rj, &k);
+		secp256k1_ge_set_gej(&r, &rj);
+		secp256k1_gej_clear(&rj);
+
+		pthread_mutex_lock(&secp256k1_ext_nonce_pool.lock);
+		if (secp256k1_ext_nonce_pool.count < SECP256K1_EXT_NONCE_POOL_MAX) {
+			secp256k1_ext_nonce_pool.nonces[secp256k1_ext_nonce_pool.count] = k;
+			secp256k1_ext_nonce_pool.points[secp256k1_ext_nonce_pool.count] = r;
+			secp256k1_ext_nonce_pool.count++;
+			added++;
+		}
+		pthread_mutex_unlock(&secp256k1_ext_nonce_pool.lock);
+		secp256k1_scalar_clear(&k);
+		secp256k1_ge_clear(&r);
+	}
+	return added;
+}
+
+// secp256k1_ext_ecdsa_sign_pooled signs with a precomputed nonce from the
+// pool, skipping the ecmult_gen on the signing critical path. Unlike the
+// default rfc6979 path the resulting signature is not deterministic.
+//
+// Returns: 1: signature created, pool entry consumed
+//          0: pool empty, invalid secret key, or all popped nonces degenerate
+// Args:    ctx:      pointer to a context object (cannot be NULL)
+//  Out:    sig64:    the 64-byte signature as r || s (cannot be NULL)
+//          recid:    the recovery id (cannot be NULL)
+//  In:     msg32:    the 32-byte message hash being signed (cannot be NULL)
+//          seckey32: the 32-byte secret key (cannot be NULL)
+static int secp256k1_ext_ecdsa_sign_pooled(
+	const secp256k1_context* ctx,
+	unsigned char *sig64,
+	int *recid,
+	const unsigned char *msg32,
+	const unsigned char *seckey32
+) {
+	secp256k1_scalar sec, msg, sigr, sigs;
+	int overflow = 0;
+	int ret = 0;
+
+	(void)ctx;
+	secp256k1_scalar_set_b32(&sec, seckey32, &overflow);
+	if (overflow || secp256k1_scalar_is_zero(&sec)) {
+		return 0;
+	}
+	secp256k1_scalar_set_b32(&msg, msg32, NULL);
+	while (!ret) {
+		secp256k1_scalar k;
+		secp256k1_ge r;
+
+		pthread_mutex_lock(&secp256k1_ext_nonce_pool.lock);
+		if (secp256k1_ext_nonce_pool.count == 0) {
+			pthread_mutex_unlock(&secp256k1_ext_nonce_pool.lock);
+			secp256k1_scalar_clear(&sec);
+			return 0;
+		}
+		secp256k1_ext_nonce_pool.count--;
+		k = secp256k1_ext_nonce_pool.nonces[secp256k1_ext_nonce_pool.count];
+		r = secp256k1_ext_nonce_pool.points[secp256k1_ext_nonce_pool.count];
+		memset(&secp256k1_ext_nonce_pool.nonces[secp256k1_ext_nonce_pool.count], 0, sizeof(k));
+		pthread_mutex_unlock(&secp256k1_ext_nonce_pool.lock);
+
+		// degenerate r or s is cryptographically unreachable; popping the
+		// next entry on failure keeps the call total regardless
+		ret = secp256k1_ecdsa_sig_sign_with_point(&r, &sigr, &sigs, &sec, &msg, &k, recid);
+		secp256k1_scalar_clear(&k);
+		secp256k1_ge_clear(&r);
+	}
+	secp256k1_scalar_get_b32(sig64, &sigr);
+	secp256k1_scalar_get_b32(sig64 + 32, &sigs);
+	secp256k1_scalar_clear(&sec);
+	return 1;
+}
+#else
+static int secp256k1_ext_numa_enable(const secp256k1_context* ctx) {
+	(void)ctx;
+	return 0;
+}
+
+static size_t secp256k1_ext_nonce_pool_fill(
+	const secp256k1_context* ctx,
+	const unsigned char *seeds,
+	size_t n
+) {
+	(void)ctx;
+	(void)seeds;
+	(void)n;
+	return 0;
+}
+
+static int secp256k1_ext_ecdsa_sign_pooled(
+	const secp256k1_context* ctx,
+	unsigned char *sig64,
+	int *recid,
+	const unsigned char *msg32,
+	const unsigned char *seckey32
+) {
+	(void)ctx;
+	(void)sig64;
+	(void)recid;
+	(void)msg32;
+	(void)seckey32;
+	return 0;
+}
+#endif /* !_WIN32 */
+
+// secp256k1_ext_b32_valid_scalar returns 1 when the 32 big-endian bytes encode
+// a scalar in [1, n-1]. The comparison is carried in masks instead of branches
+// so hostile input cannot steer the branch predictor, and no scalar
+// representation is materialized.
+static int secp256k1_ext_b32_valid_scalar(const unsigned char *b32) {
+	/* The group order, big endian. */
+	static const unsigned char order[32] = {
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe,
+		0xba, 0xae, 0xdc, 0xe6, 0xaf, 0x48, 0xa0, 0x3b,
+		0xbf, 0xd2, 0x5e, 0x8c, 0xd0, 0x36, 0x41, 0x41
+	};
+	uint32_t gt = 0, eq = 1, nz = 0;
+	int i;
+
+	for (i = 0; i < 32; i++) {
+		uint32_t a = b32[i], b = order[i];
+		gt |= eq & ((b - a) >> 31); /* first differing byte decides the order */
+		eq &= ((a ^ b) - 1) >> 31;
+		nz |= a;
+	}
+	return (int)((((uint32_t)0 - nz) >> 31) & (gt ^ 1) & (eq ^ 1));
+}
+
+// secp256k1_ext_b32_low_scalar returns 1 when the 32 big-endian bytes encode
+// a scalar in [1, n/2], the canonical low-S half of the group. The comparison
+// is carried in masks like secp256k1_ext_b32_valid_scalar above.
+static int secp256k1_ext_b32_low_scalar(const unsigned char *b32) {
+	/* The group order halved (rounded down), big endian. */
+	static const unsigned char halforder[32] = {
+		0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0x5d, 0x57, 0x6e, 0x73, 0x57, 0xa4, 0x50, 0x1d,
+		0xdf, 0xe9, 0x2f, 0x46, 0x68, 0x1b, 0x20, 0xa0
+	};
+	uint32_t gt = 0, eq = 1, nz = 0;
+	int i;
+
+	for (i = 0; i < 32; i++) {
+		uint32_t a = b32[i], b = halforder[i];
+		gt |= eq & ((b - a) >> 31);
+		eq &= ((a ^ b) - 1) >> 31;
+		nz |= a;
+	}
+	/* Equality is allowed: s == n/2 is still low. */
+	return (int)((((uint32_t)0 - nz) >> 31) & (gt ^ 1));
+}
+
+// secp256k1_ext_sig_prescreen cheaply rejects encoded compact signatures that
+// full parsing would reject anyway: r or s zero or not below the group order,
+// or a recovery id outside [0, 3]. It touches no context, tables or locks, so
+// ingress paths can discard malformed input from hostile peers before queuing
+// real recovery work. Passing the prescreen says nothing about validity.
+//
+// Returns: 1: signature is worth full processing
+//          0: signature is definitely invalid
+//  In:     sigdata: pointer to a 65-byte signature with the recovery id at the end (cannot be NULL)
+static int secp256k1_ext_sig_prescreen(const unsigned char *sigdata) {
+	return secp256k1_ext_b32_valid_scalar(sigdata) &
+		secp256k1_ext_b32_valid_scalar(sigdata + 32) &
+		(sigdata[64] < 4);
+}
+
+// secp256k1_ext_sig_validate checks the consensus encoding rules of an
+// encoded compact signature in one call: r and s in [1, n-1], the recovery
+// id 0 or 1, and under the homestead rules additionally s in the canonical
+// low half of the group. Unlike the prescreen above this is a complete
+// encoding judgement, folding the half-order comparison into the same masked
+// byte pass instead of a big-integer comparison per transaction on the Go
+// side; it still says nothing about whether the signature verifies.
+//
+// Returns: 1: signature encoding is acceptable
+//          0: signature encoding violates the rules
+//  In:     sigdata:   pointer to a 65-byte signature with the recovery id at the end (cannot be NULL)
+//          homestead: also require the low-S rule when non-zero
+static int secp256k1_ext_sig_validate(const unsigned char *sigdata, int homestead) {
+	int slow = homestead ? secp256k1_ext_b32_low_scalar(sigdata + 32) :
+		secp256k1_ext_b32_valid_scalar(sigdata + 32);
+	return secp256k1_ext_b32_valid_scalar(sigdata) & slow & (sigdata[64] < 2);
+}
+
+// All batch-shaped work runs through the flat FFI layer: one descriptor
+// format, one dispatch entry point, one implementation per operation to
+// optimize and instrument. The secp256k1_ext_* batch functions below keep
+// their historical signatures for the Go wrapper but only fill in a
+// descriptor and submit it.
+#include "ffi.h"
+
+// secp256k1_ext_ecdsa_recover_batch recovers the public keys of a batch of encoded
+// compact signatures. The signatures, messages and recovered keys are passed as
+// flat arrays so the whole batch is processed in a single cgo call.
+//
+// Returns: 1: all recoveries were successful
+//          0: at least one recovery failed, see results
+// Args:    ctx:         pointer to a context object (cannot be NULL)
+//  Out:    pubkeys_out: n serialized 65-byte public keys of the signers (cannot be NULL)
+//          results:     per-signature recovery outcome, 1 on success (cannot be NULL)
+//  In:     sigdatas:    n concatenated 65-byte signatures with the recovery id at the end (cannot be NULL)
+//          msgdatas:    n concatenated 32-byte messages (cannot be NULL)
+//          n:           number of signatures in the batch
+static int secp256k1_ext_ecdsa_recover_batch(
+	const secp256k1_context* ctx,
+	unsigned char *pubkeys_out,
+	const unsigned char *sigdatas,
+	const unsigned char *msgdatas,
+	size_t n,
+	int *results
+) {
+	secp256k1_ffi_batch batch;
+
+	memset(&batch, 0, sizeof(batch));
+	batch.abi_version = SECP256K1_FFI_ABI_VERSION;
+	batch.op = SECP256K1_FFI_OP_ECDSA_RECOVER;
+	batch.sigs = sigdatas;
+	batch.msgs = msgdatas;
+	batch.out = pubkeys_out;
+	batch.n = n;
+	batch.results = results;
+	return secp256k1_ffi_execute(ctx, &batch) == n;
+}
+
+// secp256k1_ext_recover_arena_size reports the output arena size a batch of n
+// recoveries needs, so the caller sizes the region with one query call.
+static size_t secp256k1_ext_recover_arena_size(size_t n) {
+	return secp256k1_ffi_arena_size(n);
+}
+
+// secp256k1_ext_ecdsa_recover_arena recovers a batch of signers like
+// secp256k1_ext_ecdsa_recover_batch but marshals every output into one
+// contiguous arena of packed status/pubkey/address records (layout in ffi.h),
+// fusing the address derivation into the batch. The caller reads the whole
+// result as a single region instead of collecting scattered per-entry writes.
+//
+// Returns: 1: all recoveries were successful
+//          0: at least one recovery failed, see the record status bytes
+// Args:    ctx:       pointer to a context object (cannot be NULL)
+//  Out:    arena_out: packed records, secp256k1_ext_recover_arena_size(n)
+//                     bytes (cannot be NULL)
+//  In:     sigdatas:  n concatenated 65-byte signatures with the recovery id at the end (cannot be NULL)
+//          msgdatas:  n concatenated 32-byte messages (cannot be NULL)
+//          n:         number of signatures in the batch
+static int secp256k1_ext_ecdsa_recover_arena(
+	const secp256k1_context* ctx,
+	unsigned char *arena_out,
+	const unsigned char *sigdatas,
+	const unsigned char *msgdatas,
+	size_t n
+) {
+	secp256k1_ffi_batch batch;
+
+	memset(&batch, 0, sizeof(batch));
+	batch.abi_version = SECP256K1_FFI_ABI_VERSION;
+	batch.op = SECP256K1_FFI_OP_ECDSA_RECOVER_ARENA;
+	batch.sigs = sigdatas;
+	batch.msgs = msgdatas;
+	batch.out = arena_out;
+	batch.n = n;
+	return secp256k1_ffi_execute(ctx, &batch) == n;
+}
+
+// secp256k1_ext_ecdsa_verify_recover_batch processes a mixed batch of signed
+// messages in one native pass. Entries whose expected key is known
+// (pubkeydatas entry starting with 0x04) are verified against it; the rest
+// complete recovery. See secp256k1_ffi_ecdsa_verify_recover_batch.
+//
+// Returns: 1: all signatures checked out
+//          0: at least one entry failed, see results
+// Args:    ctx:         pointer to a context object (cannot be NULL)
+//  Out:    pubkeys_out: n serialized 65-byte keys, the expected or recovered
+//                       key of every successful entry (cannot be NULL)
+//          results:     per-signature outcome, 1 on success (cannot be NULL)
+//  In:     sigdatas:    n concatenated 65-byte signatures with the recovery id at the end (cannot be NULL)
+//          msgdatas:    n concatenated 32-byte messages (cannot be NULL)
+//          pubkeydatas: n concatenated 65-byte expected keys; a zeroed entry
+//                       means the signer is unknown and should be recovered
+//                       (may be NULL to recover all)
+//          n:           number of signatures in the batch
+static int secp256k1_ext_ecdsa_verify_recover_batch(
+	const secp256k1_context* ctx,
+	unsigned char *pubkeys_out,
+	const unsigned char *sigdatas,
+	const unsigned char *msgdatas,
+	const unsigned char *pubkeydatas,
+	size_t n,
+	int *results
+) {
+	secp256k1_ffi_batch batch;
+
+	memset(&batch, 0, sizeof(batch));
+	batch.abi_version = SECP256K1_FFI_ABI_VERSION;
+	batch.op = SECP256K1_FFI_OP_ECDSA_VERIFY_RECOVER;
+	batch.sigs = sigdatas;
+	batch.msgs = msgdatas;
+	batch.pubkeys = pubkeydatas;
+	batch.pubkey_stride = 65;
+	batch.out = pubkeys_out;
+	batch.n = n;
+	batch.results = results;
+	return secp256k1_ffi_execute(ctx, &batch) == n;
+}
+
+// secp256k1_ext_ecdsa_verify_batch_parallel verifies a batch of encoded compact
+// signatures, sharding the work across the native worker pool. All public keys
+// must share one serialization length (33 or 65 bytes).
+//
+// Returns: 1: all signatures are valid
+//          0: at least one signature is invalid, see results
+// Args:    ctx:         pointer to a context object initialized for verification (cannot be NULL)
+//  Out:    results:     per-signature verification outcome, 1 for valid (cannot be NULL)
+//  In:     sigdatas:    n concatenated 64-byte signatures (cannot be NULL)
+//          msgdatas:    n concatenated 32-byte messages (cannot be NULL)
+//          pubkeydatas: n concatenated serialized public keys (cannot be NULL)
+//          pubkeylen:   length of each serialized public key
+//          n:           number of signatures in the batch
+static int secp256k1_ext_ecdsa_verify_batch_parallel(
+	const secp256k1_context* ctx,
+	const unsigned char *sigdatas,
+	const unsigned char *msgdatas,
+	const unsigned char *pubkeydatas,
+	size_t pubkeylen,
+	size_t n,
+	int *results
+) {
+	secp256k1_ffi_batch batch;
+
+	memset(&batch, 0, sizeof(batch));
+	batch.abi_version = SECP256K1_FFI_ABI_VERSION;
+	batch.op = SECP256K1_FFI_OP_ECDSA_VERIFY;
+	batch.sigs = sigdatas;
+	batch.msgs = msgdatas;
+	batch.pubkeys = pubkeydatas;
+	batch.pubkey_stride = pubkeylen;
+	batch.n = n;
+	batch.results = results;
+	return secp256k1_ffi_execute(ctx, &batch) == n;
+}
+
+// secp256k1_ext_sig_validate_batch validates a batch of encoded compact
+// signatures in one call.
+//
+// Returns: the number of signatures that passed
+//  Out:    results:   per-signature outcome, 1 on pass (cannot be NULL)
+//  In:     sigdatas:  n concatenated 65-byte signatures with the recovery id at the end (cannot be NULL)
+//          n:         number of signatures in the batch
+//          homestead: also require the low-S rule when non-zero
+static size_t secp256k1_ext_sig_validate_batch(const unsigned char *sigdatas, size_t n, int homestead, int *results) {
+	secp256k1_ffi_batch batch;
+
+	memset(&batch, 0, sizeof(batch));
+	batch.abi_version = SECP256K1_FFI_ABI_VERSION;
+	batch.op = SECP256K1_FFI_OP_SIG_VALIDATE;
+	batch.flags = homestead ? SECP256K1_FFI_FLAG_LOW_S : 0;
+	batch.sigs = sigdatas;
+	batch.n = n;
+	batch.results = results;
+	return secp256k1_ffi_execute(NULL, &batch);
+}
+
+// secp256k1_ext_sig_prescreen_batch prescreens a batch of encoded compact
+// signatures in one call.
+//
+// Returns: the number of signatures that passed
+//  Out:    results:  per-signature prescreen outcome, 1 on pass (cannot be NULL)
+//  In:     sigdatas: n concatenated 65-byte signatures with the recovery id at the end (cannot be NULL)
+//          n:        number of signatures in the batch
+static size_t secp256k1_ext_sig_prescreen_batch(const unsigned char *sigdatas, size_t n, int *results) {
+	secp256k1_ffi_batch batch;
+
+	memset(&batch, 0, sizeof(batch));
+	batch.abi_version = SECP256K1_FFI_ABI_VERSION;
+	batch.op = SECP256K1_FFI_OP_SIG_PRESCREEN;
+	batch.sigs = sigdatas;
+	batch.n = n;
+	batch.results = results;
+	return secp256k1_ffi_execute(NULL, &batch);
+}
+
+// secp256k1_ext_der_to_compact_batch transcodes a batch of canonical DER
+// signatures into 64-byte compact form in one call, streaming at the byte
+// level with no per-entry signature object (see the transcoding kernels in
+// ffi.h).
+//
+// Returns: the number of signatures transcoded
+//  Out:    sigs_out: n concatenated 64-byte compact signatures; failed
+//                    entries are zeroed (cannot be NULL)
+//          results:  per-entry outcome, 1 on success (cannot be NULL)
+//  In:     derdatas: packed DER signatures (cannot be NULL)
+//          offsets:  n+1 offsets, entry i spans [offsets[i], offsets[i+1])
+//                    (cannot be NULL)
+//          n:        number of signatures in the batch
+static size_t secp256k1_ext_der_to_compact_batch(
+	unsigned char *sigs_out,
+	const unsigned char *derdatas,
+	const uint32_t *offsets,
+	size_t n,
+	int *results
+) {
+	return secp256k1_ffi_der_to_compact_batch(derdatas, offsets, n, sigs_out, results);
+}
+
+// secp256k1_ext_compact_to_der_batch transcodes a batch of 64-byte compact
+// signatures into canonical DER in one call, the inverse of
+// secp256k1_ext_der_to_compact_batch.
+//
+// Returns: the number of signatures transcoded
+//  Out:    ders_out: packed DER output, n * 72 bytes (cannot be NULL)
+//          offsets:  n+1 offsets, entry i spans [offsets[i], offsets[i+1]);
+//                    failed entries are zero-length (cannot be NULL)
+//          results:  per-entry outcome, 1 on success (cannot be NULL)
+//  In:     sigdatas: n concatenated 64-byte compact signatures (cannot be NULL)
+//          n:        number of signatures in the batch
+static size_t secp256k1_ext_compact_to_der_batch(
+	unsigned char *ders_out,
+	uint32_t *offsets,
+	const unsigned char *sigdatas,
+	size_t n,
+	int *results
+) {
+	return secp256k1_ffi_compact_to_der_batch(sigdatas, n, ders_out, offsets, results);
+}
+
+// secp256k1_ext_prefetch_sigdata hints that the len bytes at data hold
+// signature material for a batch that will be submitted shortly -- on the
+// import path, the transactions region of a block body right after RLP
+// decode, roughly 100us before sender recovery runs. Issues advisory cache
+// prefetches for the region and for the leading generator-table lines of
+// ctx (the decode-time hint kernels in ffi.h), so the batch starts on warm
+// lines instead of compulsory misses. Safe to call speculatively: a hint
+// for work that never arrives has no effect beyond the prefetch itself.
+//
+// Args:  ctx:  pointer to a context object (cannot be NULL)
+//  In:   data: start of the upcoming input region (cannot be NULL)
+//        len:  region size in bytes
+static void secp256k1_ext_prefetch_sigdata(const secp256k1_context* ctx, const unsigned char *data, size_t len) {
+	secp256k1_ffi_prefetch_sigdata(data, len);
+	secp256k1_ffi_prefetch_tables(ctx);
+}
+
+// secp256k1_ext_batch_heartbeat returns the address of the batch heartbeat
+// word in ffi.h. The batch loops and pool workers bump the word while they
+// make progress; the embedder captures the address once and a supervisor
+// then polls it with plain atomic loads -- no native call -- to tell a
+// slow-but-alive batch from a dead process. The value itself carries no
+// meaning, only whether it moved since the last poll.
+//
+// Returns: address of the heartbeat word, valid for the process lifetime
+static const uint64_t* secp256k1_ext_batch_heartbeat(void) {
+	return &secp256k1_ffi_heartbeat_word;
+}
+
+// secp256k1_ext_pubkey_decompress_batch decompresses a batch of 33-byte
+// compressed public keys into 65-byte uncompressed form in one native pass.
+//
+// Returns: 1: all keys were valid
+//          0: at least one key was invalid, see results
+// Args:    ctx:         pointer to a context object (cannot be NULL)
+//  Out:    pubkeys_out: n serialized 65-byte uncompressed keys (cannot be NULL)
+//          results:     per-key outcome, 1 on success (cannot be NULL)
+//  In:     pubkeydatas: n concatenated 33-byte compressed keys (cannot be NULL)
+//          n:           number of keys in the batch
+static int secp256k1_ext_pubkey_decompress_batch(
+	const secp256k1_context* ctx,
+	unsigned char *pubkeys_out,
+	const unsigned char *pubkeydatas,
+	size_t n,
+	int *results
+) {
+	secp256k1_ffi_batch batch;
+
+	memset(&batch, 0, sizeof(batch));
+	batch.abi_version = SECP256K1_FFI_ABI_VERSION;
+	batch.op = SECP256K1_FFI_OP_PUBKEY_DECOMPRESS;
+	batch.pubkeys = pubkeydatas;
+	batch.pubkey_stride = 33;
+	batch.out = pubkeys_out;
+	batch.n = n;
+	batch.results = results;
+	return secp256k1_ffi_execute(ctx, &batch) == n;
+}
+
+// secp256k1_ext_schnorr_verify_batch checks a whole batch of schnorr
+// signatures as a single random linear combination; when the batch fails and
+// results is given, each signature is re-verified individually.
+//
+// Returns: 1: all signatures are valid
+//          0: at least one signature is invalid
+static int secp256k1_ext_schnorr_verify_batch(
+	const secp256k1_context* ctx,
+	const unsigned char *sigdatas,
+	const unsigned char *msgdatas,
+	const unsigned char *pubkeydatas,
+	size_t pubkeylen,
+	size_t n,
+	int *results
+) {
+	secp256k1_ffi_batch batch;
+
+	memset(&batch, 0, sizeof(batch));
+	batch.abi_version = SECP256K1_FFI_ABI_VERSION;
+	batch.op = SECP256K1_FFI_OP_SCHNORR_VERIFY;
+	batch.sigs = sigdatas;
+	batch.msgs = msgdatas;
+	batch.pubkeys = pubkeydatas;
+	batch.pubkey_stride = pubkeylen;
+	batch.n = n;
+	batch.results = results;
+	return secp256k1_ffi_execute(ctx, &batch) == n;
+}
+
 // secp256k1_ext_reencode_pubkey decodes then encodes a public key. It can be used to
 // convert between public key formats. The input/output formats are chosen depending on the
 // length of the input/output buffers.
@@ -101,6 +1213,73 @@ static int secp256k1_ext_reencode_pubkey(
 	return secp256k1_ec_pubkey_serialize(ctx, out, &outlen, &pubkey, flag);
 }
 
+// secp256k1_ext_ecmult_multi computes sum(scalars[i] * points[i]) + gscalar*G
+// in a single Strauss-Shamir pass, for random-linear-combination batch checks.
+//
+// Returns: 1: multiplication was successful
+//          0: invalid input or the result is the point at infinity
+// Args:    ctx:       pointer to a context object initialized for verification (cannot be NULL)
+//  Out:    point_out: the resulting point, encoded as two 256bit big-endian numbers (cannot be NULL)
+//  In:     points:    n concatenated 64-byte public points, encoded like point_out (cannot be NULL)
+//          scalars:   n concatenated 32-byte scalars (cannot be NULL)
+//          gscalar:   an optional 32-byte scalar for the generator term, or NULL
+//          n:         number of (scalar, point) pairs
+static int secp256k1_ext_ecmult_multi(
+	const secp256k1_context* ctx,
+	unsigned char *point_out,
+	const unsigned char *points,
+	const unsigned char *scalars,
+	const unsigned char *gscalar,
+	size_t n
+) {
+	secp256k1_gej *pts;
+	secp256k1_scalar *scs;
+	secp256k1_scalar gsc;
+	secp256k1_scratch *scratch;
+	secp256k1_gej res;
+	secp256k1_ge ge;
+	size_t i;
+	int overflow = 0;
+	int ret = 1;
+
+	pts = (secp256k1_gej*)checked_malloc(&ctx->error_callback, n * sizeof(*pts));
+	scs = (secp256k1_scalar*)checked_malloc(&ctx->error_callback, n * sizeof(*scs));
+	for (i = 0; i < n && ret; i++) {
+		secp256k1_fe feX, feY;
+		ret = secp256k1_fe_set_b32(&feX, points + i*64);
+		ret &= secp256k1_fe_set_b32(&feY, points + i*64 + 32);
+		if (ret) {
+			secp256k1_ge_set_xy(&ge, &feX, &feY);
+			ret = secp256k1_ge_is_valid_var(&ge);
+			secp256k1_gej_set_ge(&pts[i], &ge);
+		}
+		secp256k1_scalar_set_b32(&scs[i], scalars + i*32, &overflow);
+		ret &= !overflow;
+	}
+	if (gscalar != NULL) {
+		secp256k1_scalar_set_b32(&gsc, gscalar, &overflow);
+		ret &= !overflow;
+	}
+	if (ret) {
+		scratch = secp256k1_scratch_create(&ctx->error_callback, SECP256K1_ECMULT_MULTI_SCRATCH_SIZE(n));
+		ret = secp256k1_ecmult_multi_var(&ctx->ecmult_ctx, scratch, &res, scs, pts, n,
+			gscalar != NULL ? &gsc : NULL);
+		secp256k1_scratch_destroy(scratch);
+		if (ret && !secp256k1_gej_is_infinity(&res)) {
+			secp256k1_ge_set_gej(&ge, &res);
+			secp256k1_fe_normalize(&ge.x);
+			secp256k1_fe_normalize(&ge.y);
+			secp256k1_fe_get_b32(point_out, &ge.x);
+			secp256k1_fe_get_b32(point_out + 32, &ge.y);
+		} else {
+			ret = 0;
+		}
+	}
+	checked_free(scs);
+	checked_free(pts);
+	return ret;
+}
+
 // secp256k1_ext_scalar_mul multiplies a point by a scalar in constant time.
 //
 // Returns: 1: multiplication was successful
@@ -140,3 +1319,835 @@ int secp256k1_ext_scalar_mul(const secp256k1_context* ctx, unsigned char *point,
 	secp256k1_scalar_clear(&s);
 	return ret;
 }
+
+// secp256k1_ext_scalar_mul_session caches the odd-multiples tables of one
+// public peer point, so repeated constant-time multiplications against the
+// same point (p2p handshake re-keying) pay the table build once and run the
+// remaining multiplications at wNAF-walk cost. Only the point is cached;
+// the scalars stay secret and are processed in constant time per call.
+typedef struct secp256k1_ext_scalar_mul_session_struct secp256k1_ext_scalar_mul_session;
+struct secp256k1_ext_scalar_mul_session_struct {
+	secp256k1_ecmult_const_precomp tables;
+};
+
+// secp256k1_ext_scalar_mul_session_create precomputes the tables for a peer
+// point. The session holds no reference to the context and must be released
+// with secp256k1_ext_scalar_mul_session_destroy.
+//
+// Returns: the session, never NULL (allocation failures invoke the error callback)
+// Args:    ctx:    pointer to a context object (cannot be NULL)
+//  In:     point:  pointer to a 64-byte public point,
+//                  encoded as two 256bit big-endian numbers.
+secp256k1_ext_scalar_mul_session* secp256k1_ext_scalar_mul_session_create(const secp256k1_context* ctx, const unsigned char *point) {
+	secp256k1_fe feX, feY;
+	secp256k1_ge ge;
+	secp256k1_ext_scalar_mul_session* session;
+	ARG_CHECK(point != NULL);
+
+	secp256k1_fe_set_b32(&feX, point);
+	secp256k1_fe_set_b32(&feY, point+32);
+	secp256k1_ge_set_xy(&ge, &feX, &feY);
+	session = (secp256k1_ext_scalar_mul_session*)checked_malloc(&ctx->error_callback, sizeof(*session));
+	secp256k1_ecmult_const_precomp_build(&session->tables, &ge, &ctx->error_callback);
+	return session;
+}
+
+void secp256k1_ext_scalar_mul_session_destroy(secp256k1_ext_scalar_mul_session* session) {
+	if (session != NULL) {
+		memset(session, 0, sizeof(*session));
+		checked_free(session);
+	}
+}
+
+// secp256k1_ext_scalar_mul_session_mul multiplies the session's point by a
+// scalar in constant time, like secp256k1_ext_scalar_mul but without the
+// per-call table setup.
+//
+// Returns: 1: multiplication was successful
+//          0: scalar was invalid (zero or overflow)
+// Args:    ctx:      pointer to a context object (cannot be NULL)
+//  Out:    point:    the multiplied point (usually secret), encoded as two
+//                    256bit big-endian numbers.
+//  In:     session:  session created from the peer point (cannot be NULL)
+//          scalar:   a 32-byte scalar with which to multiply the point
+int secp256k1_ext_scalar_mul_session_mul(const secp256k1_context* ctx, const secp256k1_ext_scalar_mul_session* session, unsigned char *point, const unsigned char *scalar) {
+	int ret = 0;
+	int overflow = 0;
+	secp256k1_gej res;
+	secp256k1_ge ge;
+	secp256k1_scalar s;
+	ARG_CHECK(session != NULL);
+	ARG_CHECK(point != NULL);
+	ARG_CHECK(scalar != NULL);
+	(void)ctx;
+
+	secp256k1_scalar_set_b32(&s, scalar, &overflow);
+	if (overflow || secp256k1_scalar_is_zero(&s)) {
+		ret = 0;
+	} else {
+		secp256k1_ecmult_const_precomp_mul(&res, &session->tables, &s);
+		secp256k1_ge_set_gej(&ge, &res);
+		/* Note: can't use secp256k1_pubkey_save here because it is not constant time. */
+		secp256k1_fe_normalize(&ge.x);
+		secp256k1_fe_normalize(&ge.y);
+		secp256k1_fe_get_b32(point, &ge.x);
+		secp256k1_fe_get_b32(point+32, &ge.y);
+		ret = 1;
+	}
+	secp256k1_scalar_clear(&s);
+	return ret;
+}
+
+// Async job submission. Every entry point above is synchronous, so the Go
+// side dedicates a blocked OS thread to each in-flight cgo call. The job API
+// instead queues work onto the native pool and returns immediately: the
+// import pipeline enqueues a block's signatures and keeps decoding RLP while
+// the pool drains the queue, then collects results through a condvar
+// completion channel. Jobs copy their inputs on submission so the caller's
+// buffers may be reused at once.
+
+#define SECP256K1_EXT_JOB_RECOVER 1
+#define SECP256K1_EXT_JOB_VERIFY  2
+#define SECP256K1_EXT_JOB_ECDH    3
+
+typedef struct secp256k1_ext_job_struct {
+	int kind;
+	const secp256k1_context *ctx;
+	unsigned char sig[65];    /* recover, verify: compact signature */
+	unsigned char msg[32];    /* recover, verify: 32-byte message hash */
+	unsigned char pubkey[65]; /* verify: serialized public key */
+	size_t pubkeylen;
+	unsigned char scalar[32]; /* ecdh: the multiplier */
+	unsigned char out[65];    /* recover: recovered key; ecdh: in/out point */
+	int result;
+	int done; /* guarded by the queue lock */
+	struct secp256k1_ext_job_struct *next;
+	/* Streamed jobs only: owning stream, position in it, and the link of the
+	 * stream's completion stack. All NULL/zero for plain jobs. */
+	struct secp256k1_ext_stream_struct *stream;
+	size_t stream_index;
+	struct secp256k1_ext_job_struct *stream_next;
+} secp256k1_ext_job;
+
+/* ---- Order-independent result streaming ------------------------------------
+ * A batch API that returns when all N entries finish gates the whole block
+ * behind its slowest signature. A stream instead hands each entry back the
+ * moment it completes: workers push finished jobs onto a lock-free MPSC
+ * stack (one CAS per completion) and the single consumer drains the stack,
+ * so the import loop can start state-transition work for early completions
+ * while stragglers still verify. The consumer accessor comes in polling and
+ * blocking flavours; blocking reuses the pool's completion condvar instead
+ * of adding another wakeup channel.
+ */
+typedef struct secp256k1_ext_stream_struct {
+	secp256k1_ext_job **jobs; /* submission order; owned until destroy */
+	size_t capacity;
+	size_t njobs;             /* jobs submitted so far */
+	size_t delivered;         /* jobs handed out by the next accessor */
+	secp256k1_ext_job *completed; /* MPSC stack head, CAS-pushed by workers */
+	secp256k1_ext_job *ready;     /* consumer-local drained entries */
+} secp256k1_ext_stream;
+
+static void secp256k1_ext_stream_push(secp256k1_ext_stream *stream, secp256k1_ext_job *job) {
+#if defined(__GNUC__) || defined(__clang__)
+	secp256k1_ext_job *head = __atomic_load_n(&stream->completed, __ATOMIC_RELAXED);
+	do {
+		job->stream_next = head;
+		/* release: the consumer's acquire exchange must see the job's
+		 * result and output, written before the push */
+	} while (!__atomic_compare_exchange_n(&stream->completed, &head, job,
+		0, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+#else
+	job->stream_next = stream->completed;
+	stream->completed = job;
+#endif
+}
+
+/* Pop one completed, undelivered job, or NULL. Single consumer only. */
+static secp256k1_ext_job* secp256k1_ext_stream_take(secp256k1_ext_stream *stream) {
+	secp256k1_ext_job *job;
+	if (stream->ready == NULL) {
+#if defined(__GNUC__) || defined(__clang__)
+		stream->ready = __atomic_exchange_n(&stream->completed, NULL, __ATOMIC_ACQUIRE);
+#else
+		stream->ready = stream->completed;
+		stream->completed = NULL;
+#endif
+	}
+	job = stream->ready;
+	if (job != NULL) {
+		stream->ready = job->stream_next;
+	}
+	return job;
+}
+
+static void secp256k1_ext_job_run(secp256k1_ext_job *job, secp256k1_scratch **scratch) {
+	switch (job->kind) {
+	case SECP256K1_EXT_JOB_RECOVER:
+		job->result = secp256k1_ext_ecdsa_recover(job->ctx, job->out, job->sig, job->msg);
+		break;
+	case SECP256K1_EXT_JOB_VERIFY:
+		if (*scratch == NULL) {
+			*scratch = secp256k1_scratch_create(&job->ctx->error_callback, SECP256K1_ECMULT_SCRATCH_SIZE);
+		}
+		job->result = secp256k1_ext_ecdsa_verify_scratch(job->ctx, *scratch, job->sig, job->msg, job->pubkey, job->pubkeylen);
+		break;
+	case SECP256K1_EXT_JOB_ECDH:
+		job->result = secp256k1_ext_scalar_mul(job->ctx, job->out, job->scalar);
+		break;
+	default:
+		job->result = 0;
+	}
+}
+
+/* Adaptive drain geometry. Workers take runs of jobs per lock acquisition
+ * rather than singles, amortizing the lock handoff and the completion
+ * broadcast. The run size floats between 1 and SECP256K1_EXT_BATCH_MAX with
+ * hysteresis: it doubles while a drain leaves backlog behind and halves when
+ * the queue runs dry early, so quiet periods degrade to latency-optimal
+ * singles and storms converge on large runs without any caller-side batch
+ * sizing. When the queue holds less than a full run, a worker lingers for a
+ * fraction of one job's cost — measured online as an EWMA of its own drains,
+ * so the deadline tracks the hardware like the startup calibration does —
+ * before settling for what is there. */
+#define SECP256K1_EXT_BATCH_MAX 32
+#define SECP256K1_EXT_BATCH_LINGER_MIN_NS 2000
+#define SECP256K1_EXT_BATCH_LINGER_MAX_NS 50000
+
+#ifndef _WIN32
+static struct {
+	pthread_mutex_t lock;
+	pthread_cond_t work_cond; /* signalled when a job is queued */
+	pthread_cond_t done_cond; /* broadcast when any job completes */
+	secp256k1_ext_job *head;
+	secp256k1_ext_job *tail;
+	int nworkers;
+	int depth;      /* queued, not yet claimed jobs */
+	int batch_hint; /* current drain run target, 1..SECP256K1_EXT_BATCH_MAX */
+	uint64_t job_ns; /* EWMA cost of one job, 0 until first measured */
+} secp256k1_ext_jobs = {
+	PTHREAD_MUTEX_INITIALIZER,
+	PTHREAD_COND_INITIALIZER,
+	PTHREAD_COND_INITIALIZER,
+	NULL,
+	NULL,
+	0,
+	0,
+	1,
+	0,
+};
+
+static uint64_t secp256k1_ext_job_clock_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void* secp256k1_ext_job_worker(void* arg) {
+	const secp256k1_context *numa_ctx = secp256k1_ext_numa_bind((int)(intptr_t)arg);
+	secp256k1_scratch *scratch = NULL;
+	pthread_mutex_lock(&secp256k1_ext_jobs.lock);
+	for (;;) {
+		secp256k1_ext_job *job, *batch;
+		uint64_t t0, per_job;
+		int hint, n;
+
+		while (secp256k1_ext_jobs.head == NULL) {
+			pthread_cond_wait(&secp256k1_ext_jobs.work_cond, &secp256k1_ext_jobs.lock);
+		}
+		hint = secp256k1_ext_jobs.batch_hint;
+		if (secp256k1_ext_jobs.depth < hint && secp256k1_ext_jobs.job_ns != 0) {
+			/* Shallow queue with a large hint: linger once for stragglers.
+			 * The deadline is half a job's measured cost, so the latency
+			 * added is bounded by work we would have spent anyway. */
+			uint64_t linger = secp256k1_ext_jobs.job_ns / 2;
+			struct timespec deadline;
+			if (linger < SECP256K1_EXT_BATCH_LINGER_MIN_NS) {
+				linger = SECP256K1_EXT_BATCH_LINGER_MIN_NS;
+			} else if (linger > SECP256K1_EXT_BATCH_LINGER_MAX_NS) {
+				linger = SECP256K1_EXT_BATCH_LINGER_MAX_NS;
+			}
+			clock_gettime(CLOCK_REALTIME, &deadline);
+			deadline.tv_nsec += (long)linger;
+			if (deadline.tv_nsec >= 1000000000L) {
+				deadline.tv_sec++;
+				deadline.tv_nsec -= 1000000000L;
+			}
+			/* depth < hint with a non-empty queue implies hint > 1 */
+			pthread_cond_timedwait(&secp256k1_ext_jobs.work_cond, &secp256k1_ext_jobs.lock, &deadline);
+			if (secp256k1_ext_jobs.head == NULL) {
+				continue; /* another worker claimed everything while we slept */
+			}
+			hint = secp256k1_ext_jobs.batch_hint;
+		}
+		/* Detach a run of up to hint jobs in one lock hold. */
+		batch = secp256k1_ext_jobs.head;
+		job = batch;
+		n = 1;
+		while (n < hint && job->next != NULL) {
+			job = job->next;
+			n++;
+		}
+		secp256k1_ext_jobs.head = job->next;
+		job->next = NULL;
+		if (secp256k1_ext_jobs.head == NULL) {
+			secp256k1_ext_jobs.tail = NULL;
+		}
+		secp256k1_ext_jobs.depth -= n;
+		if (secp256k1_ext_jobs.depth > 0 && hint < SECP256K1_EXT_BATCH_MAX) {
+			secp256k1_ext_jobs.batch_hint = hint * 2;
+		} else if (secp256k1_ext_jobs.depth == 0 && n <= hint / 2 && hint > 1) {
+			secp256k1_ext_jobs.batch_hint = hint / 2;
+		}
+		pthread_mutex_unlock(&secp256k1_ext_jobs.lock);
+
+		t0 = secp256k1_ext_job_clock_ns();
+		for (job = batch; job != NULL; job = job->next) {
+			if (numa_ctx != NULL) {
+				job->ctx = numa_ctx; /* read-only work: any replica is equivalent */
+			}
+			secp256k1_ext_job_run(job, &scratch);
+			if (job->stream != NULL) {
+				/* Publish before taking the lock, so a blocked consumer woken
+				 * by the broadcast below is guaranteed to find the entry. */
+				secp256k1_ext_stream_push(job->stream, job);
+			}
+		}
+		per_job = (secp256k1_ext_job_clock_ns() - t0) / (uint64_t)n;
+
+		pthread_mutex_lock(&secp256k1_ext_jobs.lock);
+		for (job = batch; job != NULL; job = job->next) {
+			job->done = 1;
+		}
+		secp256k1_ext_jobs.job_ns = secp256k1_ext_jobs.job_ns == 0
+			? per_job
+			: (3 * secp256k1_ext_jobs.job_ns + per_job) / 4;
+		pthread_cond_broadcast(&secp256k1_ext_jobs.done_cond);
+	}
+	return NULL;
+}
+
+static void secp256k1_ext_jobs_init(void) {
+	long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+	int i, nworkers;
+	pthread_t thread;
+
+	nworkers = (ncpu > 0) ? (int)ncpu : 1;
+	if (nworkers > SECP256K1_EXT_MAX_WORKERS) {
+		nworkers = SECP256K1_EXT_MAX_WORKERS;
+	}
+	for (i = 0; i < nworkers; i++) {
+		if (pthread_create(&thread, NULL, secp256k1_ext_job_worker, (void*)(intptr_t)i) == 0) {
+			pthread_detach(thread);
+			secp256k1_ext_jobs.nworkers++;
+		}
+	}
+}
+
+static secp256k1_ext_job* secp256k1_ext_job_enqueue(secp256k1_ext_job *job) {
+	static pthread_once_t once = PTHREAD_ONCE_INIT;
+	pthread_once(&once, secp256k1_ext_jobs_init);
+
+	if (secp256k1_ext_jobs.nworkers == 0) {
+		/* No workers could be spawned: degrade to synchronous completion. */
+		secp256k1_scratch *scratch = NULL;
+		secp256k1_ext_job_run(job, &scratch);
+		if (scratch != NULL) {
+			secp256k1_scratch_destroy(scratch);
+		}
+		job->done = 1;
+		if (job->stream != NULL) {
+			secp256k1_ext_stream_push(job->stream, job);
+		}
+		return job;
+	}
+	pthread_mutex_lock(&secp256k1_ext_jobs.lock);
+	if (secp256k1_ext_jobs.tail != NULL) {
+		secp256k1_ext_jobs.tail->next = job;
+	} else {
+		secp256k1_ext_jobs.head = job;
+	}
+	secp256k1_ext_jobs.tail = job;
+	secp256k1_ext_jobs.depth++;
+	pthread_cond_signal(&secp256k1_ext_jobs.work_cond);
+	pthread_mutex_unlock(&secp256k1_ext_jobs.lock);
+	return job;
+}
+
+// secp256k1_ext_job_poll reports whether a job has completed, without blocking.
+static int secp256k1_ext_job_poll(secp256k1_ext_job *job) {
+	int done;
+	pthread_mutex_lock(&secp256k1_ext_jobs.lock);
+	done = job->done;
+	pthread_mutex_unlock(&secp256k1_ext_jobs.lock);
+	return done;
+}
+
+// secp256k1_ext_job_wait blocks until the job completes, copies its output
+// and frees the job. The handle must not be used afterwards.
+//
+// Returns: the job result, 1 on success
+// Args:    job: a handle returned by one of the submit functions (cannot be NULL)
+//  Out:    out: the 65-byte recovered key for recover jobs or the 64-byte
+//               point for ecdh jobs; ignored (may be NULL) for verify jobs
+static int secp256k1_ext_job_wait(secp256k1_ext_job *job, unsigned char *out) {
+	int ret;
+
+	pthread_mutex_lock(&secp256k1_ext_jobs.lock);
+	while (!job->done) {
+		pthread_cond_wait(&secp256k1_ext_jobs.done_cond, &secp256k1_ext_jobs.lock);
+	}
+	pthread_mutex_unlock(&secp256k1_ext_jobs.lock);
+	ret = job->result;
+	if (ret && out != NULL && job->kind != SECP256K1_EXT_JOB_VERIFY) {
+		memcpy(out, job->out, job->kind == SECP256K1_EXT_JOB_ECDH ? 64 : 65);
+	}
+	checked_free(job);
+	return ret;
+}
+
+// secp256k1_ext_stream_next returns the submission index of the next completed
+// stream entry, in whatever order the pool produced them. Single consumer only.
+//
+// Returns: a submission index, or -1 when every entry has been delivered, or
+//          -1 when block is zero and nothing has completed yet
+// Args:    stream: the stream to drain (cannot be NULL)
+//          block:  whether to wait for a completion instead of returning -1
+static long secp256k1_ext_stream_next(secp256k1_ext_stream *stream, int block) {
+	secp256k1_ext_job *job;
+	if (stream->delivered == stream->njobs) {
+		return -1;
+	}
+	job = secp256k1_ext_stream_take(stream);
+	if (job == NULL) {
+		if (!block) {
+			return -1;
+		}
+		pthread_mutex_lock(&secp256k1_ext_jobs.lock);
+		for (;;) {
+			job = secp256k1_ext_stream_take(stream);
+			if (job != NULL) {
+				break;
+			}
+			/* Workers push before broadcasting under this lock, so a wakeup
+			 * with an empty stack only means some other stream progressed. */
+			pthread_cond_wait(&secp256k1_ext_jobs.done_cond, &secp256k1_ext_jobs.lock);
+		}
+		pthread_mutex_unlock(&secp256k1_ext_jobs.lock);
+	}
+	stream->delivered++;
+	return (long)job->stream_index;
+}
+#else
+// No pthreads: jobs complete synchronously at submission.
+static secp256k1_ext_job* secp256k1_ext_job_enqueue(secp256k1_ext_job *job) {
+	secp256k1_scratch *scratch = NULL;
+	secp256k1_ext_job_run(job, &scratch);
+	if (scratch != NULL) {
+		secp256k1_scratch_destroy(scratch);
+	}
+	job->done = 1;
+	if (job->stream != NULL) {
+		secp256k1_ext_stream_push(job->stream, job);
+	}
+	return job;
+}
+
+static int secp256k1_ext_job_poll(secp256k1_ext_job *job) {
+	return job->done;
+}
+
+static int secp256k1_ext_job_wait(secp256k1_ext_job *job, unsigned char *out) {
+	int ret = job->result;
+	if (ret && out != NULL && job->kind != SECP256K1_EXT_JOB_VERIFY) {
+		memcpy(out, job->out, job->kind == SECP256K1_EXT_JOB_ECDH ? 64 : 65);
+	}
+	checked_free(job);
+	return ret;
+}
+
+// Jobs complete at submission, so every entry is on the stack already and
+// blocking can never be needed.
+static long secp256k1_ext_stream_next(secp256k1_ext_stream *stream, int block) {
+	secp256k1_ext_job *job;
+	(void)block;
+	if (stream->delivered == stream->njobs) {
+		return -1;
+	}
+	job = secp256k1_ext_stream_take(stream);
+	if (job == NULL) {
+		return -1;
+	}
+	stream->delivered++;
+	return (long)job->stream_index;
+}
+#endif /* !_WIN32 */
+
+// secp256k1_ext_job_submit_recover queues the recovery of an encoded compact
+// signature on the native pool.
+//
+// Returns: a job handle to pass to secp256k1_ext_job_wait (never NULL)
+// Args:    ctx:     pointer to a context object initialized for verification (cannot be NULL)
+//  In:     sigdata: pointer to a 65-byte signature with the recovery id at the end (cannot be NULL)
+//          msgdata: pointer to a 32-byte message (cannot be NULL)
+static secp256k1_ext_job* secp256k1_ext_job_submit_recover(
+	const secp256k1_context* ctx,
+	const unsigned char *sigdata,
+	const unsigned char *msgdata
+) {
+	secp256k1_ext_job *job = (secp256k1_ext_job*)checked_malloc(&ctx->error_callback, sizeof(*job));
+	memset(job, 0, sizeof(*job));
+	job->kind = SECP256K1_EXT_JOB_RECOVER;
+	job->ctx = ctx;
+	memcpy(job->sig, sigdata, 65);
+	memcpy(job->msg, msgdata, 32);
+	return secp256k1_ext_job_enqueue(job);
+}
+
+// secp256k1_ext_job_submit_verify queues the verification of an encoded
+// compact signature on the native pool.
+//
+// Returns: a job handle to pass to secp256k1_ext_job_wait (never NULL)
+// Args:    ctx:        pointer to a context object initialized for verification (cannot be NULL)
+//  In:     sigdata:    pointer to a 64-byte signature (cannot be NULL)
+//          msgdata:    pointer to a 32-byte message (cannot be NULL)
+//          pubkeydata: pointer to public key data (cannot be NULL)
+//          pubkeylen:  length of pubkeydata (33 or 65)
+static secp256k1_ext_job* secp256k1_ext_job_submit_verify(
+	const secp256k1_context* ctx,
+	const unsigned char *sigdata,
+	const unsigned char *msgdata,
+	const unsigned char *pubkeydata,
+	size_t pubkeylen
+) {
+	secp256k1_ext_job *job = (secp256k1_ext_job*)checked_malloc(&ctx->error_callback, sizeof(*job));
+	memset(job, 0, sizeof(*job));
+	job->kind = SECP256K1_EXT_JOB_VERIFY;
+	job->ctx = ctx;
+	memcpy(job->sig, sigdata, 64);
+	memcpy(job->msg, msgdata, 32);
+	if (pubkeylen > sizeof(job->pubkey)) {
+		/* Cannot be a valid serialized key: complete as failed. */
+		job->done = 1;
+		return job;
+	}
+	memcpy(job->pubkey, pubkeydata, pubkeylen);
+	job->pubkeylen = pubkeylen;
+	return secp256k1_ext_job_enqueue(job);
+}
+
+// secp256k1_ext_job_submit_ecdh queues a constant-time scalar multiplication
+// of a public point on the native pool, the primitive behind ECDH agreement.
+//
+// Returns: a job handle to pass to secp256k1_ext_job_wait (never NULL)
+// Args:    ctx:    pointer to a context object (cannot be NULL)
+//  In:     point:  pointer to a 64-byte public point, encoded as two 256bit
+//                  big-endian numbers (cannot be NULL)
+//          scalar: a 32-byte scalar with which to multiply the point (cannot be NULL)
+static secp256k1_ext_job* secp256k1_ext_job_submit_ecdh(
+	const secp256k1_context* ctx,
+	const unsigned char *point,
+	const unsigned char *scalar
+) {
+	secp256k1_ext_job *job = (secp256k1_ext_job*)checked_malloc(&ctx->error_callback, sizeof(*job));
+	memset(job, 0, sizeof(*job));
+	job->kind = SECP256K1_EXT_JOB_ECDH;
+	job->ctx = ctx;
+	memcpy(job->out, point, 64);
+	memcpy(job->scalar, scalar, 32);
+	return secp256k1_ext_job_enqueue(job);
+}
+
+// secp256k1_ext_stream_create allocates a stream able to hold up to capacity
+// entries. Free with secp256k1_ext_stream_destroy, but only after every
+// submitted entry has been delivered by secp256k1_ext_stream_next: entries
+// still on the pool reference the stream and its jobs.
+//
+// Returns: a stream handle (never NULL)
+// Args:    ctx:      pointer to a context object, used for its error callback (cannot be NULL)
+//          capacity: the maximum number of entries the stream will carry
+static secp256k1_ext_stream* secp256k1_ext_stream_create(const secp256k1_context* ctx, size_t capacity) {
+	secp256k1_ext_stream *stream = (secp256k1_ext_stream*)checked_malloc(&ctx->error_callback, sizeof(*stream));
+	memset(stream, 0, sizeof(*stream));
+	stream->jobs = (secp256k1_ext_job**)checked_malloc(&ctx->error_callback, capacity * sizeof(*stream->jobs));
+	stream->capacity = capacity;
+	return stream;
+}
+
+// secp256k1_ext_stream_submit_recover queues the recovery of an encoded
+// compact signature on the native pool, posting its completion to the stream.
+//
+// Returns: the submission index of the entry, or -1 when the stream is full
+// Args:    stream:  the stream to post the completion to (cannot be NULL)
+//          ctx:     pointer to a context object initialized for verification (cannot be NULL)
+//  In:     sigdata: pointer to a 65-byte signature with the recovery id at the end (cannot be NULL)
+//          msgdata: pointer to a 32-byte message (cannot be NULL)
+static long secp256k1_ext_stream_submit_recover(
+	secp256k1_ext_stream *stream,
+	const secp256k1_context* ctx,
+	const unsigned char *sigdata,
+	const unsigned char *msgdata
+) {
+	secp256k1_ext_job *job;
+	if (stream->njobs == stream->capacity) {
+		return -1;
+	}
+	job = (secp256k1_ext_job*)checked_malloc(&ctx->error_callback, sizeof(*job));
+	memset(job, 0, sizeof(*job));
+	job->kind = SECP256K1_EXT_JOB_RECOVER;
+	job->ctx = ctx;
+	memcpy(job->sig, sigdata, 65);
+	memcpy(job->msg, msgdata, 32);
+	job->stream = stream;
+	job->stream_index = stream->njobs;
+	stream->jobs[stream->njobs++] = job;
+	secp256k1_ext_job_enqueue(job);
+	return (long)job->stream_index;
+}
+
+// secp256k1_ext_stream_submit_verify queues the verification of an encoded
+// compact signature on the native pool, posting its completion to the stream.
+//
+// Returns: the submission index of the entry, or -1 when the stream is full
+// Args:    stream:     the stream to post the completion to (cannot be NULL)
+//          ctx:        pointer to a context object initialized for verification (cannot be NULL)
+//  In:     sigdata:    pointer to a 64-byte signature (cannot be NULL)
+//          msgdata:    pointer to a 32-byte message (cannot be NULL)
+//          pubkeydata: pointer to public key data (cannot be NULL)
+//          pubkeylen:  length of pubkeydata (33 or 65)
+static long secp256k1_ext_stream_submit_verify(
+	secp256k1_ext_stream *stream,
+	const secp256k1_context* ctx,
+	const unsigned char *sigdata,
+	const unsigned char *msgdata,
+	const unsigned char *pubkeydata,
+	size_t pubkeylen
+) {
+	secp256k1_ext_job *job;
+	if (stream->njobs == stream->capacity) {
+		return -1;
+	}
+	job = (secp256k1_ext_job*)checked_malloc(&ctx->error_callback, sizeof(*job));
+	memset(job, 0, sizeof(*job));
+	job->kind = SECP256K1_EXT_JOB_VERIFY;
+	job->ctx = ctx;
+	memcpy(job->sig, sigdata, 64);
+	memcpy(job->msg, msgdata, 32);
+	job->stream = stream;
+	job->stream_index = stream->njobs;
+	stream->jobs[stream->njobs++] = job;
+	if (pubkeylen > sizeof(job->pubkey)) {
+		/* Cannot be a valid serialized key: complete as failed. */
+		job->done = 1;
+		secp256k1_ext_stream_push(stream, job);
+		return (long)job->stream_index;
+	}
+	memcpy(job->pubkey, pubkeydata, pubkeylen);
+	job->pubkeylen = pubkeylen;
+	secp256k1_ext_job_enqueue(job);
+	return (long)job->stream_index;
+}
+
+// secp256k1_ext_stream_result copies out the result of a delivered entry. The
+// entry must have been returned by secp256k1_ext_stream_next already; results
+// of undelivered entries are still owned by the pool.
+//
+// Returns: the entry result, 1 on success
+// Args:    stream: the stream the entry was submitted on (cannot be NULL)
+//          index:  the submission index of the entry
+//  Out:    out:    the 65-byte recovered key for recover entries; ignored
+//                  (may be NULL) for verify entries
+static int secp256k1_ext_stream_result(secp256k1_ext_stream *stream, size_t index, unsigned char *out) {
+	secp256k1_ext_job *job = stream->jobs[index];
+	int ret = job->result;
+	if (ret && out != NULL && job->kind != SECP256K1_EXT_JOB_VERIFY) {
+		memcpy(out, job->out, job->kind == SECP256K1_EXT_JOB_ECDH ? 64 : 65);
+	}
+	return ret;
+}
+
+// secp256k1_ext_stream_destroy frees a stream and all its entries. Every
+// submitted entry must have been delivered first (drain with
+// secp256k1_ext_stream_next): the pool may still be touching undelivered ones.
+static void secp256k1_ext_stream_destroy(secp256k1_ext_stream *stream) {
+	size_t i;
+	for (i = 0; i < stream->njobs; i++) {
+		checked_free(stream->jobs[i]);
+	}
+	checked_free(stream->jobs);
+	checked_free(stream);
+}
+
+// ---- Asynchronous blinding refresh -----------------------------------------
+//
+// secp256k1_ecmult_gen_blind rebuilds the projective blinding pair with a
+// full generator multiplication, which shows up as a latency spike when a
+// signer re-randomizes every N signatures for side-channel hygiene. The
+// refresh below computes the next (blind, initial) pair on a detached thread
+// against a snapshot of the generator context (the precomputed table is
+// shared read-only) and stages the result; the signing thread swaps it in
+// with two plain copies on its next request and never runs the
+// multiplication inline. Like secp256k1_context_randomize, the swap itself
+// must not race a concurrent signer on the same context.
+
+#ifndef _WIN32
+static struct {
+	pthread_mutex_t lock;
+	int state; // 0 idle, 1 computing, 2 ready
+	int have_seed;
+	unsigned char seed32[32];
+	secp256k1_ecmult_gen_context staged; // prec aliases the live context
+} secp256k1_ext_blind = {
+	PTHREAD_MUTEX_INITIALIZER,
+};
+
+static void* secp256k1_ext_blind_worker(void* arg) {
+	secp256k1_ecmult_gen_context work;
+	unsigned char seed32[32];
+	int have_seed;
+	(void)arg;
+
+	pthread_mutex_lock(&secp256k1_ext_blind.lock);
+	work = secp256k1_ext_blind.staged;
+	have_seed = secp256k1_ext_blind.have_seed;
+	memcpy(seed32, secp256k1_ext_blind.seed32, 32);
+	pthread_mutex_unlock(&secp256k1_ext_blind.lock);
+
+	secp256k1_ecmult_gen_blind(&work, have_seed ? seed32 : NULL);
+
+	pthread_mutex_lock(&secp256k1_ext_blind.lock);
+	secp256k1_ext_blind.staged.blind = work.blind;
+	secp256k1_ext_blind.staged.initial = work.initial;
+	secp256k1_ext_blind.state = 2;
+	pthread_mutex_unlock(&secp256k1_ext_blind.lock);
+
+	memset(seed32, 0, sizeof(seed32));
+	secp256k1_scalar_clear(&work.blind);
+	secp256k1_gej_clear(&work.initial);
+	return NULL;
+}
+
+// secp256k1_ext_blind_apply swaps a previously prepared pair into ctx.
+//
+// Returns: 1 when a staged pair was swapped in, 0 when none was ready
+static int secp256k1_ext_blind_apply(secp256k1_context* ctx) {
+	int ret = 0;
+	pthread_mutex_lock(&secp256k1_ext_blind.lock);
+	if (secp256k1_ext_blind.state == 2) {
+		ctx->ecmult_gen_ctx.blind = secp256k1_ext_blind.staged.blind;
+		ctx->ecmult_gen_ctx.initial = secp256k1_ext_blind.staged.initial;
+		secp256k1_scalar_clear(&secp256k1_ext_blind.staged.blind);
+		secp256k1_gej_clear(&secp256k1_ext_blind.staged.initial);
+		secp256k1_ext_blind.state = 0;
+		ret = 1;
+	}
+	pthread_mutex_unlock(&secp256k1_ext_blind.lock);
+	return ret;
+}
+
+// secp256k1_ext_blind_refresh swaps in any pair prepared by an earlier call,
+// then schedules computing the next one in the background.
+//
+// Returns: 1 when a fresh pair was swapped in by this call
+// Args:    ctx:    pointer to a context object initialized for signing (cannot be NULL)
+//  In:     seed32: 32 bytes of entropy chained into the next pair, or NULL to
+//                  rotate on the existing entropy alone
+static int secp256k1_ext_blind_refresh(secp256k1_context* ctx, const unsigned char *seed32) {
+	pthread_t thread;
+	int ret;
+
+	if (!secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx)) {
+		return 0;
+	}
+	ret = secp256k1_ext_blind_apply(ctx);
+
+	pthread_mutex_lock(&secp256k1_ext_blind.lock);
+	if (secp256k1_ext_blind.state == 0) {
+		secp256k1_ext_blind.staged = ctx->ecmult_gen_ctx;
+		if (seed32 != NULL) {
+			memcpy(secp256k1_ext_blind.seed32, seed32, 32);
+			secp256k1_ext_blind.have_seed = 1;
+		} else {
+			secp256k1_ext_blind.have_seed = 0;
+		}
+		secp256k1_ext_blind.state = 1;
+		if (pthread_create(&thread, NULL, secp256k1_ext_blind_worker, NULL) == 0) {
+			pthread_detach(thread);
+		} else {
+			// No thread available: fall back to the inline rebuild.
+			secp256k1_ext_blind.state = 0;
+			pthread_mutex_unlock(&secp256k1_ext_blind.lock);
+			secp256k1_ecmult_gen_blind(&ctx->ecmult_gen_ctx, seed32);
+			return 1;
+		}
+	}
+	pthread_mutex_unlock(&secp256k1_ext_blind.lock);
+	return ret;
+}
+#else
+static int secp256k1_ext_blind_apply(secp256k1_context* ctx) {
+	(void)ctx;
+	return 0;
+}
+
+static int secp256k1_ext_blind_refresh(secp256k1_context* ctx, const unsigned char *seed32) {
+	if (!secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx)) {
+		return 0;
+	}
+	secp256k1_ecmult_gen_blind(&ctx->ecmult_gen_ctx, seed32);
+	return 1;
+}
+#endif /* !_WIN32 */
+
+// Fused recovery and address derivation. The eai sender cache only consumes
+// the 20-byte address, which is the tail of a Keccak-256 over the 64-byte
+// X || Y buffer that recovery already produces. Hashing natively here saves a
+// cgo round-trip, a Go-side hasher allocation and a pubkey copy per recovered
+// transaction. The Keccak comes from the vendored libeaiash implementation;
+// its entry points are renamed on inclusion so binaries that also link the
+// eaiash package do not see duplicate symbols.
+#define sha3_256 secp256k1_ext_sha3_256
+#define sha3_512 secp256k1_ext_sha3_512
+#define sha3_512_x4 secp256k1_ext_sha3_512_x4
+#define sha3_256_x4 secp256k1_ext_sha3_256_x4
+#include "../../vendor/github.com/ethereumai/eaiash/src/libeaiash/sha3.c"
+#undef sha3_256
+#undef sha3_512
+#undef sha3_512_x4
+#undef sha3_256_x4
+// sha3.c leaves its helper macros defined; drop the ones generic enough to
+// collide with later code in this translation unit.
+#undef _
+#undef FOR
+#undef P
+#undef Plen
+#undef rol
+
+// secp256k1_ext_ecdsa_recover_address recovers the signer of an encoded
+// compact signature and derives the 20-byte address directly, fusing the
+// Keccak-256 of the 64-byte X || Y buffer into the recovery call.
+//
+// Returns: 1: recovery was successful
+//          0: recovery was not successful
+// Args:    ctx:      pointer to a context object (cannot be NULL)
+//  Out:    addr_out: the 20-byte address of the signer (cannot be NULL)
+//  In:     sigdata:  pointer to a 65-byte signature with the recovery id at the end (cannot be NULL)
+//          msgdata:  pointer to a 32-byte message (cannot be NULL)
+static int secp256k1_ext_ecdsa_recover_address(
+	const secp256k1_context* ctx,
+	unsigned char *addr_out,
+	const unsigned char *sigdata,
+	const unsigned char *msgdata
+) {
+	unsigned char buf[64];
+	unsigned char digest[32];
+	secp256k1_ge q;
+
+	if (!secp256k1_ext_ecdsa_recover_ge(ctx, &q, sigdata, msgdata)) {
+		return 0;
+	}
+	secp256k1_ext_ge_put_b64(buf, &q);
+	secp256k1_ext_sha3_256(digest, 32, buf, 64);
+	memcpy(addr_out, digest + 12, 20);
+	return 1;
+}
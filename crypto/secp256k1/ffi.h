@@ -0,0 +1,1770 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+// Flat batch FFI layer. Every batch operation shares one submission shape: a
+// plain C descriptor of parallel fixed-stride arrays, executed through a
+// single dispatch entry point. Runtimes other than the Go wrapper can target
+// this layer directly without speaking any per-function calling convention,
+// and the descriptor carries an ABI version so a stale embedder fails closed
+// instead of misreading fields. The secp256k1_ext_* batch entry points in
+// ext.h are thin wrappers filling in a descriptor.
+
+#ifndef SECP256K1_FFI_H
+#define SECP256K1_FFI_H
+
+// The descriptor layout below is frozen per ABI version: adding a field or
+// changing a stride bumps SECP256K1_FFI_ABI_VERSION.
+#define SECP256K1_FFI_ABI_VERSION 1
+
+#define SECP256K1_FFI_OP_ECDSA_RECOVER        1 /* 65-byte recoverable sigs -> 65-byte keys */
+#define SECP256K1_FFI_OP_ECDSA_VERIFY_RECOVER 2 /* recover, or compare against expected keys */
+#define SECP256K1_FFI_OP_ECDSA_VERIFY         3 /* 64-byte sigs against given keys */
+#define SECP256K1_FFI_OP_SCHNORR_VERIFY       4 /* random-linear-combination batch check */
+#define SECP256K1_FFI_OP_SIG_VALIDATE         5 /* encoding rules, no curve work */
+#define SECP256K1_FFI_OP_SIG_PRESCREEN        6 /* cheap ingress rejection, no curve work */
+#define SECP256K1_FFI_OP_PUBKEY_DECOMPRESS    7 /* 33-byte compressed -> 65-byte keys */
+#define SECP256K1_FFI_OP_ECDSA_RECOVER_ARENA  8 /* recover into packed arena records */
+
+/* Low-S rule for SECP256K1_FFI_OP_SIG_VALIDATE. */
+#define SECP256K1_FFI_FLAG_LOW_S 1
+
+// secp256k1_ffi_batch describes one batch submission. Unused arrays are left
+// NULL; all arrays hold n entries at a fixed stride. The signature stride is
+// implied by the operation (65 bytes with the recovery id at the end, or 64
+// bytes for plain and schnorr signatures); public keys carry an explicit
+// stride since both 33 and 65 byte serializations are accepted where keys are
+// inputs.
+typedef struct {
+	uint32_t abi_version; /* must be SECP256K1_FFI_ABI_VERSION */
+	uint32_t op;          /* one of SECP256K1_FFI_OP_* */
+	uint32_t flags;       /* operation-dependent SECP256K1_FFI_FLAG_* bits */
+	const unsigned char *sigs;    /* n concatenated signatures */
+	const unsigned char *msgs;    /* n concatenated 32-byte message hashes */
+	const unsigned char *pubkeys; /* n concatenated serialized keys, or NULL */
+	size_t pubkey_stride;         /* bytes per pubkeys entry (33 or 65) */
+	unsigned char *out;           /* n operation-dependent outputs, or NULL */
+	size_t n;                     /* number of entries in the batch */
+	int *results;                 /* per-entry outcome, 1 on success */
+} secp256k1_ffi_batch;
+
+// secp256k1_ffi_abi_version reports the descriptor layout this build speaks.
+static uint32_t secp256k1_ffi_abi_version(void) {
+	return SECP256K1_FFI_ABI_VERSION;
+}
+
+// ---- Aligned buffer contract -----------------------------------------------
+//
+// The batch arrays above should start on a 64-byte boundary and be padded to
+// a multiple of 64 bytes. Deserializing flat sig/msg arrays is cheap per
+// entry but multiplies by millions, and vectorizing it needs the guarantee:
+// aligned vector loads over the arrays are only legal when the base is
+// aligned, and the padding lets the last entries be read full-width without
+// running past the allocation. The contract is advisory in ABI version 1 --
+// unaligned submissions stay correct on the scalar paths, and
+// secp256k1_ffi_batch_aligned() is the test a vectorized deserializer
+// branches on. Builds with SECP256K1_FFI_CHECK_ALIGN defined abort on
+// unaligned submissions instead, catching embedders that would silently
+// fall off the fast path.
+
+#define SECP256K1_FFI_BUF_ALIGN 64
+
+/* Bytes to allocate for a len-byte batch array under the contract. */
+#define SECP256K1_FFI_BUF_PADDED(len) \
+	(((len) + SECP256K1_FFI_BUF_ALIGN - 1) & ~(size_t)(SECP256K1_FFI_BUF_ALIGN - 1))
+
+static int secp256k1_ffi_buf_aligned(const void* buf) {
+	return ((uintptr_t)buf & (SECP256K1_FFI_BUF_ALIGN - 1)) == 0;
+}
+
+// secp256k1_ffi_batch_aligned reports whether every array of a submission
+// honours the contract; absent (NULL) arrays trivially do.
+static int secp256k1_ffi_batch_aligned(const secp256k1_ffi_batch* batch) {
+	return secp256k1_ffi_buf_aligned(batch->sigs)
+		&& secp256k1_ffi_buf_aligned(batch->msgs)
+		&& secp256k1_ffi_buf_aligned(batch->pubkeys)
+		&& secp256k1_ffi_buf_aligned(batch->out);
+}
+
+#ifdef SECP256K1_FFI_CHECK_ALIGN
+#include <assert.h>
+#define SECP256K1_FFI_ASSERT_ALIGNED(batch) assert(secp256k1_ffi_batch_aligned(batch))
+#else
+#define SECP256K1_FFI_ASSERT_ALIGNED(batch) ((void)0)
+#endif
+
+// Recovery memoization. The txpool recovers most senders when a transaction
+// first arrives; without a native cache the block import re-runs the full
+// recovery ecmult for the very same (sig, msg) pairs minutes later. The
+// fixed-size open-addressed table below remembers recent successful
+// recoveries so the import-path batch becomes mostly table hits. Entries are
+// guarded by per-slot sequence counters: readers take no lock and detect torn
+// entries by re-checking the counter, writers claim a slot with one
+// compare-and-swap and simply skip the insert when racing another writer --
+// dropping a cache store is always safe.
+
+#define SECP256K1_FFI_RECOVER_CACHE_SIZE 16384 /* slots, power of two (~2.7MB) */
+#define SECP256K1_FFI_RECOVER_CACHE_PROBES 4   /* linear probe window */
+
+typedef struct {
+	uint32_t seq; /* 0 empty, odd while being written */
+	unsigned char sig[65];
+	unsigned char msg[32];
+	unsigned char pubkey[65];
+} secp256k1_ffi_recover_cache_entry;
+
+static secp256k1_ffi_recover_cache_entry secp256k1_ffi_recover_cache_private[SECP256K1_FFI_RECOVER_CACHE_SIZE];
+
+/* Active table. secp256k1_ffi_recover_cache_share() repoints this at a
+ * cross-process shared mapping; until then every process memoizes privately. */
+static secp256k1_ffi_recover_cache_entry *secp256k1_ffi_recover_cache = secp256k1_ffi_recover_cache_private;
+
+/* FNV-1a over sig || msg; the slot index comes from the low bits. */
+static uint64_t secp256k1_ffi_recover_cache_hash(const unsigned char *sig, const unsigned char *msg) {
+	uint64_t h = 0xcbf29ce484222325ULL;
+	int i;
+
+	for (i = 0; i < 65; i++) {
+		h = (h ^ sig[i]) * 0x100000001b3ULL;
+	}
+	for (i = 0; i < 32; i++) {
+		h = (h ^ msg[i]) * 0x100000001b3ULL;
+	}
+	return h;
+}
+
+// secp256k1_ffi_recover_cache_lookup copies the memoized 65-byte key for a
+// (sig, msg) pair into pubkey_out. Lock-free: a concurrent writer at most
+// turns a hit into a miss. Keys are compared in full, so a hash collision
+// cannot surface a wrong signer.
+static int secp256k1_ffi_recover_cache_lookup(const unsigned char *sig, const unsigned char *msg, unsigned char *pubkey_out) {
+	size_t base = (size_t)secp256k1_ffi_recover_cache_hash(sig, msg) & (SECP256K1_FFI_RECOVER_CACHE_SIZE - 1);
+	int p;
+
+	for (p = 0; p < SECP256K1_FFI_RECOVER_CACHE_PROBES; p++) {
+		secp256k1_ffi_recover_cache_entry *e = &secp256k1_ffi_recover_cache[(base + p) & (SECP256K1_FFI_RECOVER_CACHE_SIZE - 1)];
+		uint32_t seq = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE);
+		unsigned char pubkey[65];
+
+		if (seq == 0 || (seq & 1)) {
+			continue;
+		}
+		if (memcmp(e->sig, sig, 65) != 0 || memcmp(e->msg, msg, 32) != 0) {
+			continue;
+		}
+		memcpy(pubkey, e->pubkey, 65);
+		/* Everything read above is only trusted if the slot was not rewritten
+		 * underneath; the counter re-check covers the compares too. */
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&e->seq, __ATOMIC_RELAXED) != seq) {
+			continue;
+		}
+		memcpy(pubkey_out, pubkey, 65);
+		return 1;
+	}
+	return 0;
+}
+
+// secp256k1_ffi_recover_cache_store memoizes a successful recovery. The probe
+// window prefers an empty slot and falls back to evicting the home slot.
+static void secp256k1_ffi_recover_cache_store(const unsigned char *sig, const unsigned char *msg, const unsigned char *pubkey) {
+	size_t base = (size_t)secp256k1_ffi_recover_cache_hash(sig, msg) & (SECP256K1_FFI_RECOVER_CACHE_SIZE - 1);
+	size_t victim = base;
+	secp256k1_ffi_recover_cache_entry *e;
+	uint32_t seq;
+	int p;
+
+	for (p = 0; p < SECP256K1_FFI_RECOVER_CACHE_PROBES; p++) {
+		size_t at = (base + p) & (SECP256K1_FFI_RECOVER_CACHE_SIZE - 1);
+		e = &secp256k1_ffi_recover_cache[at];
+		seq = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE);
+		if (seq == 0) {
+			victim = at;
+			break;
+		}
+		if (!(seq & 1) && memcmp(e->sig, sig, 65) == 0 && memcmp(e->msg, msg, 32) == 0) {
+			return; /* already cached */
+		}
+	}
+	e = &secp256k1_ffi_recover_cache[victim];
+	seq = __atomic_load_n(&e->seq, __ATOMIC_RELAXED);
+	if ((seq & 1) || !__atomic_compare_exchange_n(&e->seq, &seq, seq + 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+		return; /* another writer owns the slot: dropping the store is fine */
+	}
+	memcpy(e->sig, sig, 65);
+	memcpy(e->msg, msg, 32);
+	memcpy(e->pubkey, pubkey, 65);
+	__atomic_store_n(&e->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+// Cross-process recovery memoization. Colocated node instances on one host
+// gossip largely the same transactions, so with private tables every process
+// re-runs the same recovery ecmults its neighbours already paid for. Backing
+// the table with a shared file mapping makes the memoization host-wide: the
+// first process to see a signature recovers it, every other one hits the
+// table. The seqlock-and-CAS protocol above needs no change -- its atomics
+// order the shared pages across processes exactly as they order them across
+// threads, and a torn or raced entry degrades to a miss either way.
+
+typedef struct {
+	unsigned char magic[8]; /* "secprcc1" */
+	uint32_t byteorder;     /* 0x01020304 written natively, detects foreign endianness */
+	uint32_t entrysize;     /* sizeof(secp256k1_ffi_recover_cache_entry) */
+	uint32_t slots;         /* SECP256K1_FFI_RECOVER_CACHE_SIZE */
+	uint32_t reserved;      /* zero */
+} secp256k1_ffi_recover_cache_header;
+
+#ifndef _WIN32
+// secp256k1_ffi_recover_cache_share switches the recovery cache to a table
+// backed by the file at path, mapped shared and read-write by every process
+// on the machine. A fresh file is sized and stamped in place; concurrent
+// creators write identical bytes, so the race is benign, and a process that
+// reads a half-stamped or foreign header simply keeps its private table.
+// Returns 1 when the shared table is in use. Must be called during startup,
+// before the batch entry points run concurrently.
+static int secp256k1_ffi_recover_cache_share(const char *path) {
+	size_t tablesize = SECP256K1_FFI_RECOVER_CACHE_SIZE * sizeof(secp256k1_ffi_recover_cache_entry);
+	size_t filesize = sizeof(secp256k1_ffi_recover_cache_header) + tablesize;
+	secp256k1_ffi_recover_cache_header want, have;
+	unsigned char *map;
+	struct stat st;
+	int fd;
+
+	memcpy(want.magic, "secprcc1", 8);
+	want.byteorder = UINT32_C(0x01020304);
+	want.entrysize = (uint32_t)sizeof(secp256k1_ffi_recover_cache_entry);
+	want.slots = (uint32_t)SECP256K1_FFI_RECOVER_CACHE_SIZE;
+	want.reserved = 0;
+
+	fd = open(path, O_RDWR | O_CREAT, 0600);
+	if (fd < 0) {
+		return 0;
+	}
+	if (fstat(fd, &st) != 0) {
+		close(fd);
+		return 0;
+	}
+	if (st.st_size == 0) {
+		/* New file: size it (zero pages are empty slots) and stamp the header. */
+		if (ftruncate(fd, (off_t)filesize) != 0 ||
+			pwrite(fd, &want, sizeof(want), 0) != (ssize_t)sizeof(want)) {
+			close(fd);
+			return 0;
+		}
+	} else if ((size_t)st.st_size != filesize ||
+		pread(fd, &have, sizeof(have), 0) != (ssize_t)sizeof(have) ||
+		memcmp(&have, &want, sizeof(want)) != 0) {
+		close(fd);
+		return 0;
+	}
+	map = (unsigned char*)mmap(NULL, filesize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) {
+		return 0;
+	}
+	secp256k1_ffi_recover_cache = (secp256k1_ffi_recover_cache_entry*)(map + sizeof(want));
+	return 1;
+}
+#else /* _WIN32 */
+// No shared mapping support; the private table stays in use.
+static int secp256k1_ffi_recover_cache_share(const char *path) {
+	(void)path;
+	return 0;
+}
+#endif /* !_WIN32 */
+
+// ---- Decode-time prefetch hints --------------------------------------------
+//
+// Block import learns where every transaction's signature and message bytes
+// sit during RLP decode, roughly a hundred microseconds before the recovery
+// batch executes. The hints below let an embedder spend that gap on the
+// compulsory misses the batch would otherwise take at dispatch: one streams
+// an upcoming input region toward the core, one walks the memoization probe
+// windows of upcoming (sig, msg) pairs, and one touches the leading
+// generator-table lines of the context that will run the batch. All three
+// are advisory prefetches -- no faults, no side effects, no-ops on compilers
+// without __builtin_prefetch -- so hinting for work that never arrives costs
+// only the hint. The per-signature wNAF recoding cannot be pulled forward
+// the same way: the scalars it encodes only exist once the signature bytes
+// are parsed at dispatch.
+
+// secp256k1_ffi_prefetch_sigdata requests every cache line of an upcoming
+// len-byte input region. The batch deserializer reads each line exactly
+// once, so the requests carry the lowest temporal-locality hint and do not
+// displace the resident working set.
+static void secp256k1_ffi_prefetch_sigdata(const void *buf, size_t len) {
+#if defined(__GNUC__) || defined(__clang__)
+	const unsigned char *p = (const unsigned char*)buf;
+	size_t off;
+
+	for (off = 0; off < len; off += SECP256K1_FFI_BUF_ALIGN) {
+		__builtin_prefetch(p + off, 0, 0);
+	}
+#else
+	(void)buf;
+	(void)len;
+#endif
+}
+
+// secp256k1_ffi_prefetch_recover walks the recovery memoization probe
+// windows of n upcoming (sig, msg) pairs laid out at the batch strides (65
+// and 32 bytes). The import-path batch opens with one cache lookup per
+// entry, and with the table an order of magnitude larger than L2 nearly
+// every probe starts as a miss; hashing the pairs ahead of time turns the
+// dispatch-time probes into hits on warm lines. Each slot is requested in
+// full since a hit compares the stored sig and msg and copies the key.
+// Hashing reads the pair bytes, so the inputs are pulled in as a side
+// effect and no separate secp256k1_ffi_prefetch_sigdata pass is needed.
+static void secp256k1_ffi_prefetch_recover(const unsigned char *sigs, const unsigned char *msgs, size_t n) {
+#if defined(__GNUC__) || defined(__clang__)
+	size_t i;
+	int p;
+
+	for (i = 0; i < n; i++) {
+		size_t base = (size_t)secp256k1_ffi_recover_cache_hash(sigs + i*65, msgs + i*32) & (SECP256K1_FFI_RECOVER_CACHE_SIZE - 1);
+		for (p = 0; p < SECP256K1_FFI_RECOVER_CACHE_PROBES; p++) {
+			const unsigned char *e = (const unsigned char*)&secp256k1_ffi_recover_cache[(base + p) & (SECP256K1_FFI_RECOVER_CACHE_SIZE - 1)];
+			size_t off;
+
+			for (off = 0; off < sizeof(secp256k1_ffi_recover_cache_entry); off += 64) {
+				__builtin_prefetch(e + off, 0, 1);
+			}
+		}
+	}
+#else
+	(void)sigs;
+	(void)msgs;
+	(void)n;
+#endif
+}
+
+// secp256k1_ffi_prefetch_tables touches the leading lines of the context's
+// generator tables. The batch's wNAF digits scatter its table reads, but
+// the low odd multiples at the head are the entries every window size
+// shares, and for a context attached to a freshly mapped shared table-set
+// the requests start the head of the mapping moving before the first
+// dispatch-time miss. The tables are re-read for the whole batch, so these
+// lines are worth keeping resident, unlike the streamed inputs above.
+static void secp256k1_ffi_prefetch_tables(const secp256k1_context *ctx) {
+#if defined(__GNUC__) || defined(__clang__)
+	size_t lines, i;
+
+	if (!secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx)) {
+		return;
+	}
+	lines = (size_t)ECMULT_TABLE_SIZE(ctx->ecmult_ctx.window_g);
+	if (lines > 16) {
+		lines = 16;
+	}
+	for (i = 0; i < lines; i++) {
+		__builtin_prefetch((const unsigned char*)(*ctx->ecmult_ctx.pre_g) + i * 64, 0, 3);
+	}
+#ifdef USE_ENDOMORPHISM
+	if (!ctx->ecmult_ctx.pre_g_interleaved) {
+		for (i = 0; i < lines; i++) {
+			__builtin_prefetch((const unsigned char*)(*ctx->ecmult_ctx.pre_g_128) + i * 64, 0, 3);
+		}
+	}
+#endif
+#else
+	(void)ctx;
+#endif
+}
+
+// secp256k1_ffi_gej_put_all_b64 converts the non-infinity points of a to
+// affine and serializes each one as 0x04 || X || Y straight into its output
+// slot at out + i*stride, sharing one Montgomery-trick inversion across the
+// whole batch. Fusing the normalization into the serialization touches every
+// point exactly once and keeps the output write stream sequential, instead
+// of staging the batch through a secp256k1_ge array and copying each point a
+// second time. Infinity entries (failed recoveries, cache hits, entries
+// judged elsewhere) leave their slots untouched. The per-point tail is
+// branch-free: two muls against the precomputed z-inverse powers, two
+// normalizations and the byte store.
+static void secp256k1_ffi_gej_put_all_b64(const secp256k1_context* ctx, unsigned char *out, size_t stride, const secp256k1_gej *a, size_t n) {
+	secp256k1_fe *az = (secp256k1_fe*)checked_malloc(&ctx->error_callback, n * sizeof(*az));
+	secp256k1_fe *azi = (secp256k1_fe*)checked_malloc(&ctx->error_callback, n * sizeof(*azi));
+	size_t i, count = 0;
+
+	for (i = 0; i < n; i++) {
+		if (!a[i].infinity) {
+			az[count++] = a[i].z;
+		}
+	}
+	secp256k1_fe_inv_all_var(azi, az, count);
+	count = 0;
+	for (i = 0; i < n; i++) {
+		secp256k1_fe zi2, zi3, x, y;
+		unsigned char *o = out + i*stride;
+
+		if (a[i].infinity) {
+			continue;
+		}
+		secp256k1_fe_sqr(&zi2, &azi[count]);
+		secp256k1_fe_mul(&zi3, &zi2, &azi[count]);
+		count++;
+		secp256k1_fe_mul(&x, &a[i].x, &zi2);
+		secp256k1_fe_mul(&y, &a[i].y, &zi3);
+		secp256k1_fe_normalize_var(&x);
+		secp256k1_fe_normalize_var(&y);
+		o[0] = 0x04;
+		secp256k1_fe_get_b32(o + 1, &x);
+		secp256k1_fe_get_b32(o + 33, &y);
+	}
+	checked_free(azi);
+	checked_free(az);
+}
+
+// Batch heartbeat. A big batch wedged in a page-fault storm and a dead
+// process both look like one cgo call that has not returned, so a watchdog
+// going by call duration alone kills healthy processes. The batch loops bump
+// this word with relaxed adds every SECP256K1_FFI_HEARTBEAT_STRIDE entries
+// (the pool workers once per claimed chunk); the Go side captures its address
+// once and a supervisor polls it with a plain atomic load, no native call on
+// the read path. Only movement between polls means anything, never the value.
+#define SECP256K1_FFI_HEARTBEAT_STRIDE 16
+
+static uint64_t secp256k1_ffi_heartbeat_word;
+
+static void secp256k1_ffi_heartbeat(void) {
+	__atomic_fetch_add(&secp256k1_ffi_heartbeat_word, 1, __ATOMIC_RELAXED);
+}
+
+// secp256k1_ffi_ecdsa_recover_batch recovers the public keys of a batch of
+// encoded compact signatures into 65-byte serializations at batch->out.
+// Entries memoized by an earlier recovery (typically at txpool ingress) are
+// answered from the recovery cache; the rest run the recovery kernel against
+// one warm scratch allocation, share a single Montgomery-trick inversion for
+// the affine conversion and populate the cache for the next pass.
+static size_t secp256k1_ffi_ecdsa_recover_batch(const secp256k1_context* ctx, const secp256k1_ffi_batch* batch) {
+	unsigned char *pubkeys_out = batch->out;
+	const unsigned char *sigdatas = batch->sigs;
+	const unsigned char *msgdatas = batch->msgs;
+	size_t n = batch->n;
+	int *results = batch->results;
+	size_t i, passed = 0;
+	secp256k1_scratch *scratch = secp256k1_scratch_create(&ctx->error_callback, SECP256K1_ECMULT_SCRATCH_SIZE);
+	secp256k1_gej *qj = (secp256k1_gej*)checked_malloc(&ctx->error_callback, n * sizeof(*qj));
+	unsigned char *hits = (unsigned char*)checked_malloc(&ctx->error_callback, n);
+	secp256k1_scalar *lanes = (secp256k1_scalar*)checked_malloc(&ctx->error_callback, n * 3 * sizeof(*lanes));
+	secp256k1_scalar *lr = lanes;
+	secp256k1_scalar *ls = lanes + n;
+	secp256k1_scalar *lm = lanes + 2 * n;
+	unsigned char *bad = (unsigned char*)checked_malloc(&ctx->error_callback, n);
+	SECP256K1_STATS_DECL
+
+	memset(hits, 0, n);
+	/* Parse straight into scalars instead of round-tripping through a
+	 * recoverable_signature object per entry, four entries per pass: the
+	 * transposed loader fills one limb row of four packed records with
+	 * bswap-friendly 64-bit loads and reduces lane-wise, see
+	 * scalar_4x64_x4_impl.h. Parsing a cache hit too is cheaper than
+	 * making the prepass conditional. */
+#ifdef USE_SCALAR_4X64
+	for (i = 0; i + SECP256K1_SCALAR_X4_LANES <= n; i += SECP256K1_SCALAR_X4_LANES) {
+		secp256k1_scalar_x4 x4;
+		int over[SECP256K1_SCALAR_X4_LANES];
+		int k;
+		secp256k1_scalar_x4_set_b32_strided(&x4, sigdatas + i*65, 65);
+		secp256k1_scalar_x4_reduce(&x4, over);
+		secp256k1_scalar_x4_scatter(lr + i, &x4);
+		for (k = 0; k < SECP256K1_SCALAR_X4_LANES; k++) {
+			bad[i + k] = (unsigned char)over[k];
+		}
+		secp256k1_scalar_x4_set_b32_strided(&x4, sigdatas + i*65 + 32, 65);
+		secp256k1_scalar_x4_reduce(&x4, over);
+		secp256k1_scalar_x4_scatter(ls + i, &x4);
+		for (k = 0; k < SECP256K1_SCALAR_X4_LANES; k++) {
+			bad[i + k] |= (unsigned char)over[k];
+		}
+		secp256k1_scalar_x4_set_b32_strided(&x4, msgdatas + i*32, 32);
+		secp256k1_scalar_x4_reduce(&x4, NULL);
+		secp256k1_scalar_x4_scatter(lm + i, &x4);
+	}
+#else
+	i = 0;
+#endif
+	/* The sub-four tail, or every entry on backends without the x4 loader. */
+	for (; i < n; i++) {
+		int overflow = 0;
+		secp256k1_scalar_set_b32(&lr[i], sigdatas + i*65, &overflow);
+		bad[i] = (unsigned char)overflow;
+		overflow = 0;
+		secp256k1_scalar_set_b32(&ls[i], sigdatas + i*65 + 32, &overflow);
+		bad[i] |= (unsigned char)overflow;
+		secp256k1_scalar_set_b32(&lm[i], msgdatas + i*32, NULL);
+	}
+	for (i = 0; i < n; i++) {
+		int recid = (int)sigdatas[i*65 + 64];
+
+		if (i % SECP256K1_FFI_HEARTBEAT_STRIDE == 0) {
+			secp256k1_ffi_heartbeat();
+		}
+		results[i] = 0;
+		secp256k1_gej_set_infinity(&qj[i]);
+		if (secp256k1_ffi_recover_cache_lookup(sigdatas + i*65, msgdatas + i*32, pubkeys_out + i*65)) {
+			results[i] = 1;
+			hits[i] = 1;
+			continue;
+		}
+		if (recid > 3 || bad[i]) {
+			continue;
+		}
+		results[i] = secp256k1_ecdsa_sig_recover_gej_scratch(&ctx->ecmult_ctx, scratch, &lr[i], &ls[i], &qj[i], &lm[i], recid);
+	}
+	/* One shared Montgomery-trick inversion normalizes the whole batch of
+	 * recovered points and the fused kernel serializes them straight into
+	 * their output slots. */
+	secp256k1_ffi_gej_put_all_b64(ctx, pubkeys_out, 65, qj, n);
+	for (i = 0; i < n; i++) {
+		if (results[i] && !hits[i]) {
+			secp256k1_ffi_recover_cache_store(sigdatas + i*65, msgdatas + i*32, pubkeys_out + i*65);
+		}
+		passed += (size_t)results[i];
+	}
+	checked_free(bad);
+	checked_free(lanes);
+	checked_free(hits);
+	checked_free(qj);
+	secp256k1_scratch_destroy(scratch);
+	SECP256K1_STATS_DONE_N(ctx, SECP256K1_CONTEXT_STATS_RECOVER, n);
+	return passed;
+}
+
+// Arena output format of SECP256K1_FFI_OP_ECDSA_RECOVER_ARENA. Instead of
+// parallel output arrays, every entry lands in one packed record inside a
+// single contiguous arena at batch->out, so an embedder copies (or slices)
+// one region per batch instead of collecting n scattered writes. The record
+// layout is frozen with the descriptor ABI:
+//
+//	offset 0:  status byte, 1 on successful recovery, 0 otherwise
+//	offset 1:  65-byte public key, 0x04 || X || Y
+//	offset 66: 20-byte signer address, Keccak-256(X || Y)[12:]
+//
+// Records of failed entries are zeroed in full. batch->results may be NULL
+// since the status byte already carries the per-entry outcome.
+#define SECP256K1_FFI_ARENA_STATUS      0
+#define SECP256K1_FFI_ARENA_PUBKEY      1
+#define SECP256K1_FFI_ARENA_ADDRESS     66
+#define SECP256K1_FFI_ARENA_RECORD_SIZE 86
+
+/* Defined by the Keccak inclusion at the bottom of ext.h; only the prototype
+ * is needed this early. */
+int secp256k1_ext_sha3_256(uint8_t* out, size_t outlen, const uint8_t* in, size_t inlen);
+
+// secp256k1_ffi_arena_size reports the arena size one batch of n entries
+// needs, letting a caller size the output region with a single query call.
+static size_t secp256k1_ffi_arena_size(size_t n) {
+	return n * SECP256K1_FFI_ARENA_RECORD_SIZE;
+}
+
+// secp256k1_ffi_ecdsa_recover_arena_batch recovers a batch like
+// secp256k1_ffi_ecdsa_recover_batch but marshals the outputs into the packed
+// arena format above, fusing the address derivation into the same pass so the
+// embedder gets status, key and address in one cache-friendly sweep.
+static size_t secp256k1_ffi_ecdsa_recover_arena_batch(const secp256k1_context* ctx, const secp256k1_ffi_batch* batch) {
+	unsigned char *arena = batch->out;
+	const unsigned char *sigdatas = batch->sigs;
+	const unsigned char *msgdatas = batch->msgs;
+	size_t n = batch->n;
+	size_t i, passed = 0;
+	secp256k1_scratch *scratch = secp256k1_scratch_create(&ctx->error_callback, SECP256K1_ECMULT_SCRATCH_SIZE);
+	secp256k1_gej *qj = (secp256k1_gej*)checked_malloc(&ctx->error_callback, n * sizeof(*qj));
+	unsigned char *hits = (unsigned char*)checked_malloc(&ctx->error_callback, n);
+	int *results = batch->results;
+	int *owned = NULL;
+	SECP256K1_STATS_DECL
+
+	if (results == NULL) {
+		owned = (int*)checked_malloc(&ctx->error_callback, n * sizeof(*owned));
+		results = owned;
+	}
+	memset(arena, 0, secp256k1_ffi_arena_size(n));
+	memset(hits, 0, n);
+	for (i = 0; i < n; i++) {
+		unsigned char *rec = arena + i*SECP256K1_FFI_ARENA_RECORD_SIZE;
+		secp256k1_scalar r, s, m;
+		int recid = (int)sigdatas[i*65 + 64];
+		int overflow = 0;
+
+		if (i % SECP256K1_FFI_HEARTBEAT_STRIDE == 0) {
+			secp256k1_ffi_heartbeat();
+		}
+		results[i] = 0;
+		secp256k1_gej_set_infinity(&qj[i]);
+		if (secp256k1_ffi_recover_cache_lookup(sigdatas + i*65, msgdatas + i*32, rec + SECP256K1_FFI_ARENA_PUBKEY)) {
+			results[i] = 1;
+			hits[i] = 1;
+			continue;
+		}
+		/* Parse straight into the scalars instead of round-tripping through
+		 * a recoverable_signature object per entry. */
+		if (recid > 3) {
+			continue;
+		}
+		secp256k1_scalar_set_b32(&r, sigdatas + i*65, &overflow);
+		if (overflow) {
+			continue;
+		}
+		secp256k1_scalar_set_b32(&s, sigdatas + i*65 + 32, &overflow);
+		if (overflow) {
+			continue;
+		}
+		secp256k1_scalar_set_b32(&m, msgdatas + i*32, NULL);
+		results[i] = secp256k1_ecdsa_sig_recover_gej_scratch(&ctx->ecmult_ctx, scratch, &r, &s, &qj[i], &m, recid);
+	}
+	/* One shared Montgomery-trick inversion normalizes the whole batch of
+	 * recovered points and the fused kernel serializes them straight into
+	 * their arena records. */
+	secp256k1_ffi_gej_put_all_b64(ctx, arena + SECP256K1_FFI_ARENA_PUBKEY, SECP256K1_FFI_ARENA_RECORD_SIZE, qj, n);
+	for (i = 0; i < n; i++) {
+		unsigned char *rec = arena + i*SECP256K1_FFI_ARENA_RECORD_SIZE;
+		unsigned char digest[32];
+
+		if (!results[i]) {
+			continue;
+		}
+		if (!hits[i]) {
+			secp256k1_ffi_recover_cache_store(sigdatas + i*65, msgdatas + i*32, rec + SECP256K1_FFI_ARENA_PUBKEY);
+		}
+		secp256k1_ext_sha3_256(digest, 32, rec + SECP256K1_FFI_ARENA_PUBKEY + 1, 64);
+		memcpy(rec + SECP256K1_FFI_ARENA_ADDRESS, digest + 12, 20);
+		rec[SECP256K1_FFI_ARENA_STATUS] = 1;
+		passed++;
+	}
+	checked_free(owned);
+	checked_free(hits);
+	checked_free(qj);
+	secp256k1_scratch_destroy(scratch);
+	SECP256K1_STATS_DONE_N(ctx, SECP256K1_CONTEXT_STATS_RECOVER, n);
+	return passed;
+}
+
+// secp256k1_ffi_ecdsa_verify_recover_batch processes a mixed batch of signed
+// messages in one pass. Every signature runs the recovery kernel once;
+// entries whose expected key is known (batch->pubkeys entry starting with
+// 0x04) are compared against it in Jacobian coordinates straight after the
+// shared ecmult, while the remaining entries complete recovery and share one
+// Montgomery-trick inversion for the affine conversion. Both shapes consult
+// and feed the recovery cache. batch->pubkeys may be NULL to recover all;
+// batch->out receives the expected or recovered 65-byte key of every
+// successful entry.
+static size_t secp256k1_ffi_ecdsa_verify_recover_batch(const secp256k1_context* ctx, const secp256k1_ffi_batch* batch) {
+	unsigned char *pubkeys_out = batch->out;
+	const unsigned char *sigdatas = batch->sigs;
+	const unsigned char *msgdatas = batch->msgs;
+	const unsigned char *pubkeydatas = batch->pubkeys;
+	size_t n = batch->n;
+	int *results = batch->results;
+	size_t i, passed = 0;
+	secp256k1_scratch *scratch = secp256k1_scratch_create(&ctx->error_callback, SECP256K1_ECMULT_SCRATCH_SIZE);
+	secp256k1_gej *qj = (secp256k1_gej*)checked_malloc(&ctx->error_callback, n * sizeof(*qj));
+	unsigned char *hits = (unsigned char*)checked_malloc(&ctx->error_callback, n);
+	SECP256K1_STATS_DECL
+
+	memset(hits, 0, n);
+	for (i = 0; i < n; i++) {
+		secp256k1_scalar r, s, m;
+		unsigned char cached[65];
+		int recid = (int)sigdatas[i*65 + 64];
+		int overflow = 0;
+
+		if (i % SECP256K1_FFI_HEARTBEAT_STRIDE == 0) {
+			secp256k1_ffi_heartbeat();
+		}
+		results[i] = 0;
+		secp256k1_gej_set_infinity(&qj[i]);
+		if (secp256k1_ffi_recover_cache_lookup(sigdatas + i*65, msgdatas + i*32, cached)) {
+			/* A memoized signer answers both call shapes without curve work. */
+			if (pubkeydatas != NULL && pubkeydatas[i*65] == 0x04) {
+				results[i] = memcmp(cached, pubkeydatas + i*65, 65) == 0;
+			} else {
+				memcpy(pubkeys_out + i*65, cached, 65);
+				results[i] = 1;
+			}
+			hits[i] = 1;
+			continue;
+		}
+		/* Parse straight into the scalars instead of round-tripping through
+		 * a recoverable_signature object per entry. */
+		if (recid > 3) {
+			continue;
+		}
+		secp256k1_scalar_set_b32(&r, sigdatas + i*65, &overflow);
+		if (overflow) {
+			continue;
+		}
+		secp256k1_scalar_set_b32(&s, sigdatas + i*65 + 32, &overflow);
+		if (overflow) {
+			continue;
+		}
+		secp256k1_scalar_set_b32(&m, msgdatas + i*32, NULL);
+		results[i] = secp256k1_ecdsa_sig_recover_gej_scratch(&ctx->ecmult_ctx, scratch, &r, &s, &qj[i], &m, recid);
+		if (pubkeydatas != NULL && pubkeydatas[i*65] == 0x04) {
+			secp256k1_pubkey pubkey;
+			secp256k1_ge qe;
+			secp256k1_gej diff;
+
+			if (results[i] &&
+				secp256k1_ec_pubkey_parse(ctx, &pubkey, pubkeydatas + i*65, 65) &&
+				secp256k1_pubkey_load(ctx, &qe, &pubkey)) {
+				secp256k1_ge_neg(&qe, &qe);
+				/* qj[i] comes straight out of secp256k1_ecmult, whose
+				 * formulas leave the coordinates within the relaxed
+				 * accumulator bounds, so the comparison addition can skip
+				 * the input normalizations. */
+				secp256k1_gej_add_ge_var_relaxed(&diff, &qj[i], &qe);
+				results[i] = secp256k1_gej_is_infinity(&diff);
+			} else {
+				results[i] = 0;
+			}
+			/* Already judged: keep it out of the normalization pass below. */
+			secp256k1_gej_set_infinity(&qj[i]);
+		}
+	}
+	/* One shared Montgomery-trick inversion normalizes the recovered points
+	 * of the recover-mode entries and the fused kernel serializes them
+	 * straight into their output slots. */
+	secp256k1_ffi_gej_put_all_b64(ctx, pubkeys_out, 65, qj, n);
+	for (i = 0; i < n; i++) {
+		unsigned char *out = pubkeys_out + i*65;
+		if (results[i]) {
+			if (pubkeydatas != NULL && pubkeydatas[i*65] == 0x04) {
+				memcpy(out, pubkeydatas + i*65, 65);
+				if (!hits[i]) {
+					secp256k1_ffi_recover_cache_store(sigdatas + i*65, msgdatas + i*32, out);
+				}
+			} else if (!hits[i]) {
+				secp256k1_ffi_recover_cache_store(sigdatas + i*65, msgdatas + i*32, out);
+			}
+		}
+		passed += (size_t)results[i];
+	}
+	checked_free(hits);
+	checked_free(qj);
+	secp256k1_scratch_destroy(scratch);
+	SECP256K1_STATS_DONE_N(ctx, SECP256K1_CONTEXT_STATS_RECOVER, n);
+	return passed;
+}
+
+// Parallel batch verification. Signature verification only reads the context,
+// so a batch of independent (sig, msg, pubkey) triples can be sharded across a
+// native worker pool without any locking on the hot path. The pool is created
+// lazily on first use and kept alive for the lifetime of the process, matching
+// the lifetime of the package-level context on the Go side. On platforms
+// without pthreads the batch degrades to a serial loop.
+
+#ifndef _WIN32
+// Number of signatures a worker claims per trip to the dispatch lock. Large
+// enough to keep contention negligible, small enough to balance uneven loads.
+#define SECP256K1_FFI_VERIFY_CHUNK 16
+
+typedef struct {
+	const secp256k1_context* ctx;
+	const unsigned char *sigdatas;
+	const unsigned char *msgdatas;
+	const unsigned char *pubkeydatas;
+	size_t pubkeylen;
+	size_t n;
+	size_t next;        /* next unclaimed index, guarded by lock */
+	size_t outstanding; /* indices claimed but not yet completed */
+	int *results;
+} secp256k1_ffi_verify_batch_state;
+
+static struct {
+	pthread_mutex_t lock;
+	pthread_cond_t work_cond;  /* signalled when a new batch is published */
+	pthread_cond_t done_cond;  /* signalled when the last chunk completes */
+	secp256k1_ffi_verify_batch_state state;
+	int have_work;
+	int nworkers;
+} secp256k1_ffi_pool = {
+	PTHREAD_MUTEX_INITIALIZER,
+	PTHREAD_COND_INITIALIZER,
+	PTHREAD_COND_INITIALIZER,
+	{NULL, NULL, NULL, NULL, 0, 0, 0, 0, NULL},
+	0,
+	0,
+};
+
+static void* secp256k1_ffi_verify_worker(void* arg) {
+	const secp256k1_context *numa_ctx = secp256k1_ext_numa_bind((int)(intptr_t)arg);
+	secp256k1_scratch *scratch = NULL;
+	pthread_mutex_lock(&secp256k1_ffi_pool.lock);
+	for (;;) {
+		secp256k1_ffi_verify_batch_state *st = &secp256k1_ffi_pool.state;
+		const secp256k1_context *ctx;
+		size_t begin, end, i;
+		if (!secp256k1_ffi_pool.have_work || st->next >= st->n) {
+			pthread_cond_wait(&secp256k1_ffi_pool.work_cond, &secp256k1_ffi_pool.lock);
+			continue;
+		}
+		begin = st->next;
+		end = begin + SECP256K1_FFI_VERIFY_CHUNK;
+		if (end > st->n) {
+			end = st->n;
+		}
+		st->next = end;
+		st->outstanding += end - begin;
+		pthread_mutex_unlock(&secp256k1_ffi_pool.lock);
+		secp256k1_ffi_heartbeat();
+
+		ctx = (numa_ctx != NULL) ? numa_ctx : st->ctx;
+		if (scratch == NULL) {
+			scratch = secp256k1_scratch_create(&ctx->error_callback, SECP256K1_ECMULT_SCRATCH_SIZE);
+		}
+		for (i = begin; i < end; i++) {
+			st->results[i] = secp256k1_ext_ecdsa_verify_scratch(ctx, scratch,
+				st->sigdatas + i*64, st->msgdatas + i*32,
+				st->pubkeydatas + i*st->pubkeylen, st->pubkeylen);
+		}
+
+		pthread_mutex_lock(&secp256k1_ffi_pool.lock);
+		st->outstanding -= end - begin;
+		if (st->next >= st->n && st->outstanding == 0) {
+			pthread_cond_signal(&secp256k1_ffi_pool.done_cond);
+		}
+	}
+	return NULL;
+}
+
+static void secp256k1_ffi_pool_init(void) {
+	long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+	int i, nworkers;
+	pthread_t thread;
+
+	nworkers = (ncpu > 0) ? (int)ncpu : 1;
+	if (nworkers > SECP256K1_EXT_MAX_WORKERS) {
+		nworkers = SECP256K1_EXT_MAX_WORKERS;
+	}
+	for (i = 0; i < nworkers; i++) {
+		if (pthread_create(&thread, NULL, secp256k1_ffi_verify_worker, (void*)(intptr_t)i) == 0) {
+			pthread_detach(thread);
+			secp256k1_ffi_pool.nworkers++;
+		}
+	}
+}
+#endif /* !_WIN32 */
+
+// secp256k1_ffi_ecdsa_verify_batch verifies a batch of encoded compact
+// signatures against the keys at batch->pubkeys, sharding the work across the
+// native worker pool. All public keys share the one serialization stride.
+static size_t secp256k1_ffi_ecdsa_verify_batch(const secp256k1_context* ctx, const secp256k1_ffi_batch* batch) {
+	const unsigned char *sigdatas = batch->sigs;
+	const unsigned char *msgdatas = batch->msgs;
+	const unsigned char *pubkeydatas = batch->pubkeys;
+	size_t pubkeylen = batch->pubkey_stride;
+	size_t n = batch->n;
+	int *results = batch->results;
+	size_t i, passed = 0;
+
+	// The per-verify samples are booked by secp256k1_ext_ecdsa_verify_scratch
+	// in the workers; only the batch occupancy is recorded here.
+	SECP256K1_STATS_BATCH(ctx, n);
+
+#ifndef _WIN32
+	static pthread_once_t once = PTHREAD_ONCE_INIT;
+	pthread_once(&once, secp256k1_ffi_pool_init);
+
+	if (secp256k1_ffi_pool.nworkers > 1 && n > SECP256K1_FFI_VERIFY_CHUNK) {
+		pthread_mutex_lock(&secp256k1_ffi_pool.lock);
+		secp256k1_ffi_pool.state.ctx = ctx;
+		secp256k1_ffi_pool.state.sigdatas = sigdatas;
+		secp256k1_ffi_pool.state.msgdatas = msgdatas;
+		secp256k1_ffi_pool.state.pubkeydatas = pubkeydatas;
+		secp256k1_ffi_pool.state.pubkeylen = pubkeylen;
+		secp256k1_ffi_pool.state.n = n;
+		secp256k1_ffi_pool.state.next = 0;
+		secp256k1_ffi_pool.state.outstanding = 0;
+		secp256k1_ffi_pool.state.results = results;
+		secp256k1_ffi_pool.have_work = 1;
+		pthread_cond_broadcast(&secp256k1_ffi_pool.work_cond);
+		while (secp256k1_ffi_pool.state.next < n || secp256k1_ffi_pool.state.outstanding > 0) {
+			pthread_cond_wait(&secp256k1_ffi_pool.done_cond, &secp256k1_ffi_pool.lock);
+		}
+		secp256k1_ffi_pool.have_work = 0;
+		pthread_mutex_unlock(&secp256k1_ffi_pool.lock);
+
+		for (i = 0; i < n; i++) {
+			passed += (size_t)results[i];
+		}
+		return passed;
+	}
+#endif
+	{
+		secp256k1_scratch *scratch = secp256k1_scratch_create(&ctx->error_callback, SECP256K1_ECMULT_SCRATCH_SIZE);
+		for (i = 0; i < n; i++) {
+			if (i % SECP256K1_FFI_HEARTBEAT_STRIDE == 0) {
+				secp256k1_ffi_heartbeat();
+			}
+			results[i] = secp256k1_ext_ecdsa_verify_scratch(ctx, scratch, sigdatas + i*64, msgdatas + i*32,
+				pubkeydatas + i*pubkeylen, pubkeylen);
+			passed += (size_t)results[i];
+		}
+		secp256k1_scratch_destroy(scratch);
+	}
+	return passed;
+}
+
+// secp256k1_ffi_sig_validate_batch checks the consensus encoding rules of a
+// batch of encoded compact signatures, requiring the canonical low-S half
+// when SECP256K1_FFI_FLAG_LOW_S is set. No curve work is done.
+static size_t secp256k1_ffi_sig_validate_batch(const secp256k1_context* ctx, const secp256k1_ffi_batch* batch) {
+	int homestead = (batch->flags & SECP256K1_FFI_FLAG_LOW_S) != 0;
+	size_t i, passed = 0;
+	(void)ctx;
+
+	for (i = 0; i < batch->n; i++) {
+		batch->results[i] = secp256k1_ext_sig_validate(batch->sigs + i*65, homestead);
+		passed += (size_t)batch->results[i];
+	}
+	return passed;
+}
+
+// secp256k1_ffi_sig_prescreen_batch cheaply rejects encoded compact
+// signatures that full parsing would reject anyway. Passing says nothing
+// about validity. No curve work is done.
+static size_t secp256k1_ffi_sig_prescreen_batch(const secp256k1_context* ctx, const secp256k1_ffi_batch* batch) {
+	size_t i, passed = 0;
+	(void)ctx;
+
+	for (i = 0; i < batch->n; i++) {
+		batch->results[i] = secp256k1_ext_sig_prescreen(batch->sigs + i*65);
+		passed += (size_t)batch->results[i];
+	}
+	return passed;
+}
+
+// secp256k1_ffi_pubkey_decompress_batch decompresses a batch of 33-byte
+// compressed public keys at batch->pubkeys into 65-byte uncompressed form at
+// batch->out. On 64-bit field builds the square roots, which dominate
+// decompression, run four lanes at a time over the fe_x4 batch kernels; the
+// per-lane sqrt verification doubles as the curve membership check, so
+// invalid x coordinates and non-residues are rejected exactly like in
+// pubkey_parse.
+static size_t secp256k1_ffi_pubkey_decompress_batch(const secp256k1_context* ctx, const secp256k1_ffi_batch* batch) {
+	static const secp256k1_fe fe7 = SECP256K1_FE_CONST(0, 0, 0, 0, 0, 0, 0, 7);
+	unsigned char *pubkeys_out = batch->out;
+	const unsigned char *pubkeydatas = batch->pubkeys;
+	size_t n = batch->n;
+	int *results = batch->results;
+	size_t i, passed = 0;
+	(void)ctx;
+
+#ifdef USE_FIELD_5X52
+	for (i = 0; i + SECP256K1_FE_X4_LANES <= n; i += SECP256K1_FE_X4_LANES) {
+		secp256k1_fe x[SECP256K1_FE_X4_LANES], c[SECP256K1_FE_X4_LANES], y[SECP256K1_FE_X4_LANES];
+		int valid[SECP256K1_FE_X4_LANES];
+		int j;
+
+		for (j = 0; j < SECP256K1_FE_X4_LANES; j++) {
+			const unsigned char *in = pubkeydatas + (i + j) * 33;
+			results[i + j] = (in[0] == 0x02 || in[0] == 0x03) && secp256k1_fe_set_b32(&x[j], in + 1);
+			if (!results[i + j]) {
+				/* Pad rejected lanes with the generator's x so the vector
+				 * chain stays uniform; the result is discarded. */
+				x[j] = secp256k1_ge_const_g.x;
+			}
+			secp256k1_fe_sqr(&c[j], &x[j]);
+			secp256k1_fe_mul(&c[j], &c[j], &x[j]);
+			secp256k1_fe_add(&c[j], &fe7);
+			secp256k1_fe_normalize(&c[j]);
+		}
+		secp256k1_fe_sqrt_x4(y, valid, c);
+		for (j = 0; j < SECP256K1_FE_X4_LANES; j++) {
+			unsigned char *out = pubkeys_out + (i + j) * 65;
+			results[i + j] &= valid[j];
+			if (results[i + j]) {
+				secp256k1_fe_normalize_var(&y[j]);
+				if (secp256k1_fe_is_odd(&y[j]) != (pubkeydatas[(i + j) * 33] == 0x03)) {
+					secp256k1_fe_negate(&y[j], &y[j], 1);
+					secp256k1_fe_normalize_var(&y[j]);
+				}
+				out[0] = 0x04;
+				secp256k1_fe_get_b32(out + 1, &x[j]);
+				secp256k1_fe_get_b32(out + 33, &y[j]);
+			}
+			passed += (size_t)results[i + j];
+		}
+	}
+#else
+	i = 0;
+#endif
+	for (; i < n; i++) {
+		secp256k1_ge elem;
+		unsigned char *out = pubkeys_out + i * 65;
+		results[i] = secp256k1_eckey_pubkey_parse(&elem, pubkeydatas + i * 33, 33);
+		if (results[i]) {
+			out[0] = 0x04;
+			secp256k1_ext_ge_put_b64(out + 1, &elem);
+		}
+		passed += (size_t)results[i];
+	}
+	return passed;
+}
+
+// secp256k1_ffi_schnorr_verify_batch checks a whole batch as a single random
+// linear combination evaluated with one multi-scalar multiply, so the
+// amortized per-signature cost approaches one group addition. The combined
+// answer is all-or-nothing; when the batch fails and batch->results is given,
+// each signature is re-verified individually to find the culprits.
+static size_t secp256k1_ffi_schnorr_verify_batch(const secp256k1_context* ctx, const secp256k1_ffi_batch* batch) {
+	const unsigned char *sigdatas = batch->sigs;
+	const unsigned char *msgdatas = batch->msgs;
+	const unsigned char *pubkeydatas = batch->pubkeys;
+	size_t pubkeylen = batch->pubkey_stride;
+	size_t n = batch->n;
+	int *results = batch->results;
+	secp256k1_pubkey *pubkeys;
+	size_t i, passed = 0;
+	int ok = 1;
+
+	if (n == 0) {
+		return 0;
+	}
+	pubkeys = (secp256k1_pubkey*)checked_malloc(&ctx->error_callback, n * sizeof(*pubkeys));
+	for (i = 0; i < n; i++) {
+		if (!secp256k1_ec_pubkey_parse(ctx, &pubkeys[i], pubkeydatas + i*pubkeylen, pubkeylen)) {
+			ok = 0;
+			break;
+		}
+	}
+	if (ok) {
+		ok = secp256k1_schnorr_verify_batch(ctx, sigdatas, msgdatas, pubkeys, n);
+	}
+	if (ok) {
+		passed = n;
+		if (results != NULL) {
+			for (i = 0; i < n; i++) {
+				results[i] = 1;
+			}
+		}
+	} else if (results != NULL) {
+		// Batch rejected: find the culprits one by one.
+		for (i = 0; i < n; i++) {
+			secp256k1_pubkey pubkey;
+			results[i] = secp256k1_ec_pubkey_parse(ctx, &pubkey, pubkeydatas + i*pubkeylen, pubkeylen) &&
+				secp256k1_schnorr_verify(ctx, sigdatas + i*64, msgdatas + i*32, &pubkey);
+			passed += (size_t)results[i];
+		}
+	}
+	checked_free(pubkeys);
+	return passed;
+}
+
+// secp256k1_ffi_execute runs one batch submission and returns the number of
+// entries that passed. A descriptor speaking a different ABI version or an
+// unknown operation is rejected wholesale with zero passes.
+static size_t secp256k1_ffi_execute(const secp256k1_context* ctx, const secp256k1_ffi_batch* batch) {
+	if (batch->abi_version != SECP256K1_FFI_ABI_VERSION) {
+		return 0;
+	}
+	SECP256K1_FFI_ASSERT_ALIGNED(batch);
+	switch (batch->op) {
+	case SECP256K1_FFI_OP_ECDSA_RECOVER:
+		return secp256k1_ffi_ecdsa_recover_batch(ctx, batch);
+	case SECP256K1_FFI_OP_ECDSA_VERIFY_RECOVER:
+		return secp256k1_ffi_ecdsa_verify_recover_batch(ctx, batch);
+	case SECP256K1_FFI_OP_ECDSA_VERIFY:
+		return secp256k1_ffi_ecdsa_verify_batch(ctx, batch);
+	case SECP256K1_FFI_OP_SCHNORR_VERIFY:
+		return secp256k1_ffi_schnorr_verify_batch(ctx, batch);
+	case SECP256K1_FFI_OP_SIG_VALIDATE:
+		return secp256k1_ffi_sig_validate_batch(ctx, batch);
+	case SECP256K1_FFI_OP_SIG_PRESCREEN:
+		return secp256k1_ffi_sig_prescreen_batch(ctx, batch);
+	case SECP256K1_FFI_OP_PUBKEY_DECOMPRESS:
+		return secp256k1_ffi_pubkey_decompress_batch(ctx, batch);
+	case SECP256K1_FFI_OP_ECDSA_RECOVER_ARENA:
+		return secp256k1_ffi_ecdsa_recover_arena_batch(ctx, batch);
+	}
+	return 0;
+}
+
+// ---- Batched address checksumming ------------------------------------------
+//
+// EIP-55 renders an address as hex with a casing pattern derived from the
+// Keccak-256 of its own lowercase hex form, so every address in an RPC
+// response costs a full hash. A large eai_getLogs response checksums tens of
+// thousands of addresses one Go-side hasher at a time. The kernel below does
+// the whole batch in one call over packed arrays: a table-lookup hex
+// expansion pass, the hashes four lanes at a time through the interleaved
+// Keccak-f[1600] of the vendored libeaiash, and a casing pass patching the
+// hex in place from the digests.
+
+/* Defined by the Keccak inclusion at the bottom of ext.h, like
+ * secp256k1_ext_sha3_256 above. */
+void secp256k1_ext_sha3_256_x4(uint8_t* ret[4], const uint8_t* data[4], size_t size);
+
+/* One rendered address: "0x" plus 40 hex characters, no NUL. The embedder
+ * slices the packed output region at this stride. */
+#define SECP256K1_FFI_ADDRESS_HEX_SIZE 42
+
+// secp256k1_ffi_checksum_addresses renders n packed 20-byte addresses at
+// addrs into n packed EIP-55 checksummed strings at out, which must hold
+// n * SECP256K1_FFI_ADDRESS_HEX_SIZE bytes.
+static void secp256k1_ffi_checksum_addresses(const uint8_t* addrs, size_t n, char* out) {
+	static const char hexdigits[16] = "0123456789abcdef";
+	uint8_t digests[4][32];
+	uint8_t* ret[4];
+	const uint8_t* data[4];
+	size_t i, j, k;
+
+	// Hex expansion pass. The nibble lookups over a fixed-length body are
+	// a shape the compiler vectorizes on its own, like the lane loops of
+	// the interleaved Keccak.
+	for (i = 0; i < n; i++) {
+		const uint8_t* a = addrs + i * 20;
+		char* s = out + i * SECP256K1_FFI_ADDRESS_HEX_SIZE;
+		s[0] = '0';
+		s[1] = 'x';
+		for (j = 0; j < 20; j++) {
+			s[2 + 2*j]     = hexdigits[a[j] >> 4];
+			s[2 + 2*j + 1] = hexdigits[a[j] & 0x0f];
+		}
+	}
+	// Hash and casing passes, four addresses per permutation. A ragged
+	// tail re-points its spare lanes at the last address so the
+	// interleaved kernel always runs fully populated; the duplicate
+	// digests are simply not consumed.
+	for (i = 0; i < n; i += 4) {
+		for (j = 0; j < 4; j++) {
+			k = i + j < n ? i + j : n - 1;
+			data[j] = (const uint8_t*)(out + k * SECP256K1_FFI_ADDRESS_HEX_SIZE) + 2;
+			ret[j] = digests[j];
+		}
+		secp256k1_ext_sha3_256_x4(ret, data, 40);
+		for (j = 0; j < 4 && i + j < n; j++) {
+			char* s = out + (i + j) * SECP256K1_FFI_ADDRESS_HEX_SIZE + 2;
+			for (k = 0; k < 40; k++) {
+				int nibble = (digests[j][k / 2] >> (k % 2 ? 0 : 4)) & 0x0f;
+				if (s[k] > '9' && nibble > 7) {
+					s[k] -= 'a' - 'A';
+				}
+			}
+		}
+	}
+}
+
+// ---- Canonical DER transcoding ---------------------------------------------
+//
+// Archive re-indexing transcodes millions of historical DER signatures to
+// the 64-byte compact form (and back when serving old formats). Round-
+// tripping each one through secp256k1_ecdsa_signature_parse_der pays two
+// scalar conversions and an opaque signature object per entry just to move
+// bytes; the kernels below stream between the encodings directly, enforcing
+// strict-DER canonicality and the scalar range in the same byte-level pass,
+// with no intermediate object and no allocation. One deliberate divergence
+// from the object round trip: an integer outside the scalar range --
+// negative, or at or above the group order -- is rejected here, where the
+// parse path silently coerces it to zero and reports success.
+
+/* The group order n, big-endian, for the byte-level range checks. */
+static const unsigned char secp256k1_ffi_scalar_order[32] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE,
+	0xBA, 0xAE, 0xDC, 0xE6, 0xAF, 0x48, 0xA0, 0x3B,
+	0xBF, 0xD2, 0x5E, 0x8C, 0xD0, 0x36, 0x41, 0x41
+};
+
+/* Upper bound on the DER form of a canonical signature: 6 header bytes plus
+ * two integers of at most 33 bytes (32 content bytes and one sign byte). */
+#define SECP256K1_FFI_DER_MAX 72
+
+/* Parses one strict-DER non-negative integer below the group order straight
+ * into a left-padded 32-byte slot. Same encoding rules as
+ * secp256k1_der_parse_integer, minus its overflow-to-zero coercion. */
+static int secp256k1_ffi_der_integer_to_b32(const unsigned char **sig, const unsigned char *sigend, unsigned char *out32) {
+	int rlen;
+
+	if (*sig == sigend || **sig != 0x02) {
+		/* Not a primitive integer (X.690-0207 8.3.1). */
+		return 0;
+	}
+	(*sig)++;
+	rlen = secp256k1_der_read_len(sig, sigend);
+	if (rlen <= 0 || *sig + rlen > sigend) {
+		/* Exceeds bounds or not at least length 1 (X.690-0207 8.3.1). */
+		return 0;
+	}
+	if ((**sig & 0x80) == 0x80) {
+		/* Negative. */
+		return 0;
+	}
+	if (**sig == 0x00 && rlen > 1 && ((*sig)[1] & 0x80) == 0x00) {
+		/* Excessive 0x00 padding. */
+		return 0;
+	}
+	if (**sig == 0x00 && rlen > 1) {
+		/* The single legal sign byte. */
+		(*sig)++;
+		rlen--;
+	}
+	if (rlen > 32) {
+		/* Necessarily at least 2^256, so above the group order. */
+		return 0;
+	}
+	memset(out32, 0, (size_t)(32 - rlen));
+	memcpy(out32 + 32 - rlen, *sig, (size_t)rlen);
+	if (rlen == 32 && memcmp(out32, secp256k1_ffi_scalar_order, 32) >= 0) {
+		/* At or above the group order. */
+		return 0;
+	}
+	(*sig) += rlen;
+	return 1;
+}
+
+// secp256k1_ffi_der_to_compact64 transcodes one canonical DER signature of
+// len bytes at der into the 64-byte compact form at out64. Returns 1 when
+// der is strict DER with both integers below the group order; on failure
+// out64 may hold a partial write and must not be consumed.
+static int secp256k1_ffi_der_to_compact64(const unsigned char *der, size_t len, unsigned char *out64) {
+	const unsigned char *sig = der;
+	const unsigned char *sigend = der + len;
+	int rlen;
+
+	if (sig == sigend || *(sig++) != 0x30) {
+		/* Does not start with a constructed sequence (X.690-0207 8.9.1). */
+		return 0;
+	}
+	rlen = secp256k1_der_read_len(&sig, sigend);
+	if (rlen < 0 || sig + rlen > sigend) {
+		/* Tuple exceeds bounds. */
+		return 0;
+	}
+	if (sig + rlen != sigend) {
+		/* Garbage after tuple. */
+		return 0;
+	}
+	if (!secp256k1_ffi_der_integer_to_b32(&sig, sigend, out64) ||
+		!secp256k1_ffi_der_integer_to_b32(&sig, sigend, out64 + 32)) {
+		return 0;
+	}
+	/* Trailing garbage inside tuple. */
+	return sig == sigend;
+}
+
+// secp256k1_ffi_compact64_to_der writes the canonical DER form of the
+// 64-byte compact signature at in64 into der, which must hold
+// SECP256K1_FFI_DER_MAX bytes. Returns the encoded length, or 0 when either
+// component is at or above the group order. Same minimal-integer logic as
+// secp256k1_ecdsa_sig_serialize, fed bytes instead of scalars.
+static size_t secp256k1_ffi_compact64_to_der(const unsigned char *in64, unsigned char *der) {
+	unsigned char r[33] = {0}, s[33] = {0};
+	unsigned char *rp = r, *sp = s;
+	size_t lenR = 33, lenS = 33;
+
+	if (memcmp(in64, secp256k1_ffi_scalar_order, 32) >= 0 ||
+		memcmp(in64 + 32, secp256k1_ffi_scalar_order, 32) >= 0) {
+		return 0;
+	}
+	memcpy(r + 1, in64, 32);
+	memcpy(s + 1, in64 + 32, 32);
+	while (lenR > 1 && rp[0] == 0 && rp[1] < 0x80) { lenR--; rp++; }
+	while (lenS > 1 && sp[0] == 0 && sp[1] < 0x80) { lenS--; sp++; }
+	der[0] = 0x30;
+	der[1] = (unsigned char)(4 + lenS + lenR);
+	der[2] = 0x02;
+	der[3] = (unsigned char)lenR;
+	memcpy(der + 4, rp, lenR);
+	der[4 + lenR] = 0x02;
+	der[5 + lenR] = (unsigned char)lenS;
+	memcpy(der + lenR + 6, sp, lenS);
+	return 6 + lenS + lenR;
+}
+
+// secp256k1_ffi_der_to_compact_batch transcodes n packed DER signatures at
+// ders, entry i spanning [offsets[i], offsets[i+1]), into n 64-byte compact
+// signatures at out64. Variable-length inputs do not fit the fixed-stride
+// descriptor, so like secp256k1_ffi_checksum_addresses this is a standalone
+// batch call rather than a SECP256K1_FFI_OP. Failed entries zero their
+// output slot; results (when given) carries the per-entry outcome. Returns
+// the number of entries transcoded.
+static size_t secp256k1_ffi_der_to_compact_batch(const unsigned char *ders, const uint32_t *offsets, size_t n, unsigned char *out64, int *results) {
+	size_t i, passed = 0;
+
+	for (i = 0; i < n; i++) {
+		int ok = offsets[i + 1] >= offsets[i] &&
+			secp256k1_ffi_der_to_compact64(ders + offsets[i], offsets[i + 1] - offsets[i], out64 + i * 64);
+		if (!ok) {
+			memset(out64 + i * 64, 0, 64);
+		}
+		if (results) {
+			results[i] = ok;
+		}
+		passed += (size_t)ok;
+	}
+	return passed;
+}
+
+// secp256k1_ffi_compact_to_der_batch transcodes n 64-byte compact signatures
+// at in64 into packed DER at ders (n * SECP256K1_FFI_DER_MAX bytes), writing
+// n+1 offsets so entry i spans [offsets[i], offsets[i+1]). Failed entries
+// are zero-length. Returns the number of entries transcoded.
+static size_t secp256k1_ffi_compact_to_der_batch(const unsigned char *in64, size_t n, unsigned char *ders, uint32_t *offsets, int *results) {
+	size_t i, at = 0, passed = 0;
+
+	offsets[0] = 0;
+	for (i = 0; i < n; i++) {
+		size_t len = secp256k1_ffi_compact64_to_der(in64 + i * 64, ders + at);
+
+		at += len;
+		offsets[i + 1] = (uint32_t)at;
+		if (results) {
+			results[i] = len != 0;
+		}
+		passed += (size_t)(len != 0);
+	}
+	return passed;
+}
+
+// ---- Warm-state snapshots --------------------------------------------------
+//
+// The native caches (the recovery memoization table above, the per-context
+// odd-multiples LRU in libsecp256k1) die with the process, so a restarted
+// node re-pays minutes of cache warmup exactly when it is busiest catching
+// up. The snapshot below persists that warm state across a graceful restart:
+// one file of subsystem-tagged sections, saved at shutdown and restored with
+// a single read-only mmap at startup. Sections carry the in-memory entry
+// size, so a snapshot from a different build, field representation or
+// endianness is skipped section by section instead of misread; unknown tags
+// from a newer build are skipped the same way. Sections are written verbatim
+// from memory and start on 64-byte boundaries, so the load path consumes the
+// mapping in place with no per-entry parsing.
+//
+// The eaiash DAG and cache files are already persistent and epoch-addressed,
+// so they need no section here; the tag space is open for future native
+// subsystems that keep derived state worth carrying over.
+
+#define SECP256K1_FFI_WARM_MAGIC "secpwrm1"
+#define SECP256K1_FFI_WARM_ALIGN 64
+
+#define SECP256K1_FFI_WARM_SECTION_RECOVER_CACHE 1 /* recovery memoization table */
+#define SECP256K1_FFI_WARM_SECTION_PUBKEY_CACHE  2 /* per-context odd-multiples LRU */
+
+typedef struct {
+	unsigned char magic[8]; /* SECP256K1_FFI_WARM_MAGIC */
+	uint32_t byteorder;     /* 0x01020304 written natively, detects foreign endianness */
+	uint32_t reserved;      /* zero */
+} secp256k1_ffi_warm_header;
+
+typedef struct {
+	uint32_t tag;       /* one of SECP256K1_FFI_WARM_SECTION_* */
+	uint32_t entrysize; /* sizeof the in-memory entry the payload was copied from */
+	uint64_t size;      /* payload bytes, excluding alignment padding */
+} secp256k1_ffi_warm_section;
+
+#ifndef _WIN32
+
+static int secp256k1_ffi_warm_write(int fd, const void *buf, size_t len) {
+	const unsigned char *p = (const unsigned char*)buf;
+	while (len > 0) {
+		ssize_t n = write(fd, p, len);
+		if (n <= 0) {
+			return 0;
+		}
+		p += (size_t)n;
+		len -= (size_t)n;
+	}
+	return 1;
+}
+
+/* Pad the file to the section alignment, tracking the current offset. */
+static int secp256k1_ffi_warm_pad(int fd, size_t *off) {
+	static const unsigned char zeros[SECP256K1_FFI_WARM_ALIGN];
+	size_t rem = *off & (SECP256K1_FFI_WARM_ALIGN - 1);
+	if (rem != 0) {
+		if (!secp256k1_ffi_warm_write(fd, zeros, SECP256K1_FFI_WARM_ALIGN - rem)) {
+			return 0;
+		}
+		*off += SECP256K1_FFI_WARM_ALIGN - rem;
+	}
+	return 1;
+}
+
+static int secp256k1_ffi_warm_put_section(int fd, size_t *off, uint32_t tag, uint32_t entrysize, const void *payload, size_t size) {
+	secp256k1_ffi_warm_section sec;
+	memset(&sec, 0, sizeof(sec));
+	sec.tag = tag;
+	sec.entrysize = entrysize;
+	sec.size = (uint64_t)size;
+	if (!secp256k1_ffi_warm_write(fd, &sec, sizeof(sec)) ||
+		!secp256k1_ffi_warm_write(fd, payload, size)) {
+		return 0;
+	}
+	*off += sizeof(sec) + size;
+	return secp256k1_ffi_warm_pad(fd, off);
+}
+
+// secp256k1_ffi_warm_save snapshots the warm native state to the file at
+// path, replacing it atomically via a temporary and rename so a crash during
+// save leaves the previous snapshot intact. Slots a concurrent writer holds
+// mid-update are written as empty, so the snapshot only ever contains whole
+// entries; the natural call site is graceful shutdown, after the batch entry
+// points have quiesced. Returns 1 on success.
+static int secp256k1_ffi_warm_save(const secp256k1_context *ctx, const char *path) {
+	size_t tablesize = SECP256K1_FFI_RECOVER_CACHE_SIZE * sizeof(secp256k1_ffi_recover_cache_entry);
+	secp256k1_ffi_recover_cache_entry *table;
+	secp256k1_ffi_warm_header hdr;
+	size_t pathlen = strlen(path);
+	char *tmppath = (char*)checked_malloc(&ctx->error_callback, pathlen + 5);
+	size_t off = 0;
+	size_t i;
+	int fd;
+	int ok = 1;
+
+	memcpy(tmppath, path, pathlen);
+	memcpy(tmppath + pathlen, ".tmp", 5);
+	fd = open(tmppath, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+	if (fd < 0) {
+		checked_free(tmppath);
+		return 0;
+	}
+
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, SECP256K1_FFI_WARM_MAGIC, 8);
+	hdr.byteorder = UINT32_C(0x01020304);
+	ok = secp256k1_ffi_warm_write(fd, &hdr, sizeof(hdr));
+	off += sizeof(hdr);
+	ok = ok && secp256k1_ffi_warm_pad(fd, &off);
+
+	/* Recovery memoization table, snapshotted entry by entry under the slot
+	 * sequence counters so racing writers at most cost single entries. */
+	if (ok) {
+		table = (secp256k1_ffi_recover_cache_entry*)checked_malloc(&ctx->error_callback, tablesize);
+		for (i = 0; i < SECP256K1_FFI_RECOVER_CACHE_SIZE; i++) {
+			secp256k1_ffi_recover_cache_entry *e = &secp256k1_ffi_recover_cache[i];
+			uint32_t seq = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE);
+			memcpy(&table[i], e, sizeof(*e));
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+			if ((seq & 1) || __atomic_load_n(&e->seq, __ATOMIC_RELAXED) != seq) {
+				memset(&table[i], 0, sizeof(table[i]));
+			}
+		}
+		ok = secp256k1_ffi_warm_put_section(fd, &off, SECP256K1_FFI_WARM_SECTION_RECOVER_CACHE,
+			(uint32_t)sizeof(secp256k1_ffi_recover_cache_entry), table, tablesize);
+		checked_free(table);
+	}
+
+	/* Per-context odd-multiples LRU, same per-slot sanitization. */
+	if (ok && ctx->ecmult_ctx.pubkey_cache != NULL) {
+		secp256k1_ecmult_pubkey_cache *cache = (secp256k1_ecmult_pubkey_cache*)checked_malloc(&ctx->error_callback, sizeof(*cache));
+		memcpy(cache, ctx->ecmult_ctx.pubkey_cache, sizeof(*cache));
+		for (i = 0; i < ECMULT_PUBKEY_CACHE_SIZE; i++) {
+			secp256k1_ecmult_pubkey_cache_entry *e = &ctx->ecmult_ctx.pubkey_cache->slot[i];
+			uint32_t seq = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE);
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+			if ((seq & 1) || __atomic_load_n(&e->seq, __ATOMIC_RELAXED) != seq) {
+				memset(&cache->slot[i], 0, sizeof(cache->slot[i]));
+			}
+		}
+		ok = secp256k1_ffi_warm_put_section(fd, &off, SECP256K1_FFI_WARM_SECTION_PUBKEY_CACHE,
+			(uint32_t)sizeof(secp256k1_ecmult_pubkey_cache_entry), cache, sizeof(*cache));
+		checked_free(cache);
+	}
+
+	if (close(fd) != 0) {
+		ok = 0;
+	}
+	if (ok) {
+		ok = (rename(tmppath, path) == 0);
+	}
+	if (!ok) {
+		unlink(tmppath);
+	}
+	checked_free(tmppath);
+	return ok;
+}
+
+// secp256k1_ffi_warm_load restores warm state saved by
+// secp256k1_ffi_warm_save. The file is consumed through one read-only
+// mapping; each recognized section whose entry layout matches this build is
+// copied over the live table, and everything else (foreign endianness, other
+// field representations, tags from newer builds) is skipped. Like
+// secp256k1_ffi_recover_cache_share this belongs in startup, before the
+// batch entry points run concurrently. Returns the number of sections
+// restored, 0 when nothing usable was found.
+static int secp256k1_ffi_warm_load(const secp256k1_context *ctx, const char *path) {
+	size_t tablesize = SECP256K1_FFI_RECOVER_CACHE_SIZE * sizeof(secp256k1_ffi_recover_cache_entry);
+	secp256k1_ffi_warm_header hdr;
+	unsigned char *map;
+	struct stat st;
+	size_t off;
+	int restored = 0;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		return 0;
+	}
+	if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(hdr)) {
+		close(fd);
+		return 0;
+	}
+	map = (unsigned char*)mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) {
+		return 0;
+	}
+
+	memcpy(&hdr, map, sizeof(hdr));
+	if (memcmp(hdr.magic, SECP256K1_FFI_WARM_MAGIC, 8) != 0 || hdr.byteorder != UINT32_C(0x01020304)) {
+		munmap(map, (size_t)st.st_size);
+		return 0;
+	}
+	off = (sizeof(hdr) + SECP256K1_FFI_WARM_ALIGN - 1) & ~(size_t)(SECP256K1_FFI_WARM_ALIGN - 1);
+
+	while (off + sizeof(secp256k1_ffi_warm_section) <= (size_t)st.st_size) {
+		secp256k1_ffi_warm_section sec;
+		const unsigned char *payload;
+
+		memcpy(&sec, map + off, sizeof(sec));
+		payload = map + off + sizeof(sec);
+		if (sec.size > (size_t)st.st_size - off - sizeof(sec)) {
+			break; /* truncated section: keep what was restored so far */
+		}
+		switch (sec.tag) {
+		case SECP256K1_FFI_WARM_SECTION_RECOVER_CACHE:
+			if (sec.entrysize == sizeof(secp256k1_ffi_recover_cache_entry) && sec.size == tablesize) {
+				memcpy(secp256k1_ffi_recover_cache, payload, tablesize);
+				restored++;
+			}
+			break;
+		case SECP256K1_FFI_WARM_SECTION_PUBKEY_CACHE:
+			if (ctx->ecmult_ctx.pubkey_cache != NULL &&
+				sec.entrysize == sizeof(secp256k1_ecmult_pubkey_cache_entry) &&
+				sec.size == sizeof(secp256k1_ecmult_pubkey_cache)) {
+				memcpy(ctx->ecmult_ctx.pubkey_cache, payload, sizeof(secp256k1_ecmult_pubkey_cache));
+				restored++;
+			}
+			break;
+		default:
+			break; /* section from a newer build */
+		}
+		off += sizeof(sec) + (size_t)sec.size;
+		off = (off + SECP256K1_FFI_WARM_ALIGN - 1) & ~(size_t)(SECP256K1_FFI_WARM_ALIGN - 1);
+	}
+	munmap(map, (size_t)st.st_size);
+	return restored;
+}
+
+#else /* _WIN32 */
+
+// No snapshot support; every restart runs cold, as before.
+static int secp256k1_ffi_warm_save(const secp256k1_context *ctx, const char *path) {
+	(void)ctx;
+	(void)path;
+	return 0;
+}
+
+static int secp256k1_ffi_warm_load(const secp256k1_context *ctx, const char *path) {
+	(void)ctx;
+	(void)path;
+	return 0;
+}
+
+#endif /* !_WIN32 */
+
+// ---- Capability report ------------------------------------------------------
+//
+// With kernels picked at runtime, table geometry decided per host, worker
+// pools sized from the cpu count and calibration verdicts cached on disk,
+// two nominally identical hosts can legitimately end up running different
+// code. secp256k1_ffi_capability_report answers "what is this node actually
+// running?" in one call, as a flat JSON object, so fleet tooling can diff
+// node configurations instead of correlating performance deltas against
+// disassembly. The set of keys is append-only across versions; consumers
+// must ignore keys they do not know.
+
+#ifndef _WIN32
+
+#include <stdarg.h>
+
+/* Defined by the Keccak inclusion at the bottom of ext.h; only the
+ * prototypes are needed this early. */
+char const* eaiash_keccakf_variant(void);
+char const* eaiash_keccakf_x4_variant(void);
+
+static void secp256k1_ffi_report_append(char *out, size_t cap, size_t *off, const char *fmt, ...) {
+	va_list ap;
+	int n;
+	va_start(ap, fmt);
+	n = vsnprintf(*off < cap ? out + *off : NULL, *off < cap ? cap - *off : 0, fmt, ap);
+	va_end(ap);
+	if (n > 0) {
+		*off += (size_t)n;
+	}
+}
+
+/* Appends a JSON string literal, escaping the two characters a filesystem
+ * path can contain that would break the quoting. */
+static void secp256k1_ffi_report_append_str(char *out, size_t cap, size_t *off, const char *s) {
+	secp256k1_ffi_report_append(out, cap, off, "\"");
+	for (; *s != '\0'; s++) {
+		if (*s == '"' || *s == '\\') {
+			secp256k1_ffi_report_append(out, cap, off, "\\%c", *s);
+		} else {
+			secp256k1_ffi_report_append(out, cap, off, "%c", *s);
+		}
+	}
+	secp256k1_ffi_report_append(out, cap, off, "\"");
+}
+
+static const char* secp256k1_ffi_report_field_kernel(void) {
+#if defined(USE_FIELD_5X52_ADX)
+	if (secp256k1_fe_mul_inner_ptr == secp256k1_fe_mul_inner_adx) {
+		return "adx";
+	}
+	if (secp256k1_fe_mul_inner_ptr == secp256k1_fe_mul_inner_generic) {
+		return "generic";
+	}
+	return "unselected";
+#else
+	return "generic";
+#endif
+}
+
+static const char* secp256k1_ffi_report_scalar_kernel(void) {
+#if defined(USE_SCALAR_4X64_ADX)
+	if (secp256k1_scalar_mul_512_ptr == secp256k1_scalar_mul_512_adx) {
+		return "adx";
+	}
+	if (secp256k1_scalar_mul_512_ptr == secp256k1_scalar_mul_512_generic) {
+		return "generic";
+	}
+	return "unselected";
+#elif defined(USE_SCALAR_8X32_NEON)
+	if (secp256k1_scalar_mul_512_ptr == secp256k1_scalar_mul_512_neon) {
+		return "neon";
+	}
+	if (secp256k1_scalar_mul_512_ptr == secp256k1_scalar_mul_512_generic) {
+		return "generic";
+	}
+	return "unselected";
+#else
+	return "generic";
+#endif
+}
+
+// secp256k1_ffi_capability_report renders the effective configuration of this
+// process -- selected kernels, table geometries, pool sizes, NUMA mode,
+// calibration provenance and feature flags -- as JSON into out. Returns the
+// number of bytes written excluding the terminating NUL, or 0 when cap is too
+// small for the whole report (out then holds a truncated, NUL-terminated
+// fragment). A few KB is always enough.
+static size_t secp256k1_ffi_capability_report(const secp256k1_context *ctx, char *out, size_t cap) {
+	size_t off = 0;
+	struct stat st;
+
+	secp256k1_ffi_report_append(out, cap, &off, "{\"abi_version\":%u", (unsigned int)SECP256K1_FFI_ABI_VERSION);
+
+#if defined(USE_FIELD_5X52)
+	secp256k1_ffi_report_append(out, cap, &off, ",\"field\":{\"impl\":\"5x52\",\"mul_kernel\":\"%s\"}", secp256k1_ffi_report_field_kernel());
+#else
+	secp256k1_ffi_report_append(out, cap, &off, ",\"field\":{\"impl\":\"10x26\",\"mul_kernel\":\"%s\"}", secp256k1_ffi_report_field_kernel());
+#endif
+#if defined(USE_SCALAR_4X64)
+	secp256k1_ffi_report_append(out, cap, &off, ",\"scalar\":{\"impl\":\"4x64\",\"mul_kernel\":\"%s\"}", secp256k1_ffi_report_scalar_kernel());
+#else
+	secp256k1_ffi_report_append(out, cap, &off, ",\"scalar\":{\"impl\":\"8x32\",\"mul_kernel\":\"%s\"}", secp256k1_ffi_report_scalar_kernel());
+#endif
+	secp256k1_ffi_report_append(out, cap, &off, ",\"keccak\":{\"f1600\":\"%s\",\"f1600_x4\":\"%s\"}",
+		eaiash_keccakf_variant(), eaiash_keccakf_x4_variant());
+
+	/* Table geometry: the compile-time profiles and the one the supplied
+	 * context actually carries (0 when it has no verification tables). */
+	secp256k1_ffi_report_append(out, cap, &off, ",\"tables\":{\"window_g\":%d,\"window_g_small\":%d,\"context_window_g\":%d,\"pubkey_cache\":%s}",
+		WINDOW_G, WINDOW_G_SMALL,
+		secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx) ? ctx->ecmult_ctx.window_g : 0,
+		secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx) && ctx->ecmult_ctx.pubkey_cache != NULL ? "true" : "false");
+
+	secp256k1_ffi_report_append(out, cap, &off, ",\"pools\":{\"max_workers\":%d,\"verify_workers\":%d,\"verify_chunk\":%d",
+		SECP256K1_EXT_MAX_WORKERS, secp256k1_ffi_pool.nworkers, SECP256K1_FFI_VERIFY_CHUNK);
+#ifdef ENABLE_MODULE_ECDH
+	secp256k1_ffi_report_append(out, cap, &off, ",\"ecdh_workers\":%d,\"ecdh_chunk\":%d",
+		secp256k1_ecdh_pool.nworkers, SECP256K1_ECDH_BATCH_CHUNK);
+#endif
+	secp256k1_ffi_report_append(out, cap, &off, "}");
+
+	secp256k1_ffi_report_append(out, cap, &off, ",\"numa\":{\"nodes\":%d}", secp256k1_ext_numa.nnodes);
+
+	/* Calibration provenance: the cached table-geometry verdict, whether this
+	 * process probed or reused it, and the age of the verdict file so stale
+	 * verdicts surviving a hardware change stand out. */
+	secp256k1_ffi_report_append(out, cap, &off, ",\"calibration\":{\"verdict\":\"%s\",\"probed\":%s,\"path\":",
+		secp256k1_ext_calibration.small < 0 ? "none" : (secp256k1_ext_calibration.small ? "small" : "large"),
+		secp256k1_ext_calibration.probed ? "true" : "false");
+	secp256k1_ffi_report_append_str(out, cap, &off, secp256k1_ext_calibration.path);
+	if (secp256k1_ext_calibration.path[0] != '\0' && stat(secp256k1_ext_calibration.path, &st) == 0) {
+		secp256k1_ffi_report_append(out, cap, &off, ",\"file_age_seconds\":%lld", (long long)(time(NULL) - st.st_mtime));
+	} else {
+		secp256k1_ffi_report_append(out, cap, &off, ",\"file_age_seconds\":-1");
+	}
+	secp256k1_ffi_report_append(out, cap, &off, "}");
+
+	secp256k1_ffi_report_append(out, cap, &off, ",\"caches\":{\"recover_slots\":%d,\"recover_probes\":%d,\"recover_shared\":%s}",
+		SECP256K1_FFI_RECOVER_CACHE_SIZE, SECP256K1_FFI_RECOVER_CACHE_PROBES,
+		secp256k1_ffi_recover_cache != secp256k1_ffi_recover_cache_private ? "true" : "false");
+
+	secp256k1_ffi_report_append(out, cap, &off, ",\"features\":{\"endomorphism\":%s,\"module_recovery\":%s,\"module_schnorr\":%s,\"module_ecdh\":%s,\"warm_snapshots\":true,\"opcount_stats\":%s}",
+#ifdef USE_ENDOMORPHISM
+		"true",
+#else
+		"false",
+#endif
+#ifdef ENABLE_MODULE_RECOVERY
+		"true",
+#else
+		"false",
+#endif
+#ifdef ENABLE_MODULE_SCHNORR
+		"true",
+#else
+		"false",
+#endif
+#ifdef ENABLE_MODULE_ECDH
+		"true",
+#else
+		"false",
+#endif
+#ifdef USE_OPCOUNT_STATS
+		"true"
+#else
+		"false"
+#endif
+	);
+
+	secp256k1_ffi_report_append(out, cap, &off, "}");
+	if (off >= cap) {
+		return 0;
+	}
+	return off;
+}
+
+#else /* _WIN32 */
+
+// The runtime-dispatch and pool machinery the report describes is not built
+// on Windows; report nothing rather than a misleading subset.
+static size_t secp256k1_ffi_capability_report(const secp256k1_context *ctx, char *out, size_t cap) {
+	(void)ctx;
+	if (cap > 0) {
+		out[0] = '\0';
+	}
+	return 0;
+}
+
+#endif /* !_WIN32 */
+
+#endif /* SECP256K1_FFI_H */
@@ -0,0 +1,60 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+package secp256k1
+
+/*
+#include "hexcodec.h"
+*/
+import "C"
+
+import "unsafe"
+
+// HexEncodeBulk writes the lowercase hex encoding of src into dst, which must
+// hold at least 2*len(src) bytes, and returns the number of characters
+// written. The conversion runs through the vectorized native codec, so the
+// cgo crossing is paid once per batch instead of once per item; callers with
+// many 20 or 32 byte values should concatenate them and encode in one call.
+func HexEncodeBulk(dst, src []byte) int {
+	if len(dst) < 2*len(src) {
+		panic("secp256k1: hex encode buffer too short")
+	}
+	if len(src) == 0 {
+		return 0
+	}
+	C.secp256k1_ext_hex_encode(
+		(*C.char)(unsafe.Pointer(&dst[0])),
+		(*C.uchar)(unsafe.Pointer(&src[0])),
+		C.size_t(len(src)))
+	return 2 * len(src)
+}
+
+// HexDecodeBulk parses 2*len(dst) hex characters from src into dst, accepting
+// both digit cases, and reports whether all characters were valid hex digits.
+// Like HexEncodeBulk it is meant for bulk conversions batching many fixed
+// size values into a single call.
+func HexDecodeBulk(dst, src []byte) bool {
+	if len(src) < 2*len(dst) {
+		panic("secp256k1: hex decode buffer too short")
+	}
+	if len(dst) == 0 {
+		return true
+	}
+	return C.secp256k1_ext_hex_decode(
+		(*C.uchar)(unsafe.Pointer(&dst[0])),
+		(*C.char)(unsafe.Pointer(&src[0])),
+		C.size_t(len(dst))) == 0
+}
@@ -0,0 +1,213 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+// Vectorized hex codec shared by the native modules. Encoding splits every
+// byte into nibbles and maps them through a 16 entry table lookup (pshufb or
+// tbl); decoding maps pairs of digits back through a range check and fuses
+// them with a multiply-add. Both fall back to scalar table code for the tail
+// and on hardware without the needed instructions, selected once at runtime.
+
+#ifndef SECP256K1_EXT_HEXCODEC_H
+#define SECP256K1_EXT_HEXCODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+static const char hexcodec_digits[17] = "0123456789abcdef";
+
+/* hexcodec_values maps ASCII to nibble values, -1 for non-digits. Both digit
+ * cases are accepted, like the standard library decoder. */
+static const int8_t hexcodec_values[256] = {
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+	-1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+static void hexcodec_encode_scalar(char *dst, const unsigned char *src, size_t len) {
+	size_t i;
+	for (i = 0; i < len; i++) {
+		dst[2*i]   = hexcodec_digits[src[i] >> 4];
+		dst[2*i+1] = hexcodec_digits[src[i] & 0xf];
+	}
+}
+
+static int hexcodec_decode_scalar(unsigned char *dst, const char *src, size_t len) {
+	size_t i;
+	for (i = 0; i < len; i++) {
+		int hi = hexcodec_values[(unsigned char)src[2*i]];
+		int lo = hexcodec_values[(unsigned char)src[2*i+1]];
+		if ((hi | lo) < 0) {
+			return -1;
+		}
+		dst[i] = (unsigned char)(hi << 4 | lo);
+	}
+	return 0;
+}
+
+#if defined(__x86_64__)
+
+/* hexcodec_cpu resolves the vector level once: 0 scalar, 1 SSSE3, 2 AVX2. */
+static int hexcodec_cpu(void) {
+	static int level = -1;
+	if (level < 0) {
+		level = __builtin_cpu_supports("avx2") ? 2 : __builtin_cpu_supports("ssse3") ? 1 : 0;
+	}
+	return level;
+}
+
+__attribute__((target("ssse3")))
+static size_t hexcodec_encode_ssse3(char *dst, const unsigned char *src, size_t len) {
+	const __m128i lut  = _mm_loadu_si128((const __m128i *)hexcodec_digits);
+	const __m128i mask = _mm_set1_epi8(0x0f);
+	size_t i;
+
+	for (i = 0; i + 16 <= len; i += 16) {
+		__m128i in = _mm_loadu_si128((const __m128i *)(src + i));
+		__m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi64(in, 4), mask));
+		__m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(in, mask));
+		_mm_storeu_si128((__m128i *)(dst + 2*i),      _mm_unpacklo_epi8(hi, lo));
+		_mm_storeu_si128((__m128i *)(dst + 2*i + 16), _mm_unpackhi_epi8(hi, lo));
+	}
+	return i;
+}
+
+__attribute__((target("avx2")))
+static size_t hexcodec_encode_avx2(char *dst, const unsigned char *src, size_t len) {
+	const __m256i lut  = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)hexcodec_digits));
+	const __m256i mask = _mm256_set1_epi8(0x0f);
+	size_t i;
+
+	for (i = 0; i + 32 <= len; i += 32) {
+		__m256i in = _mm256_loadu_si256((const __m256i *)(src + i));
+		__m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi64(in, 4), mask));
+		__m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(in, mask));
+		/* The unpacks interleave within the 128 bit lanes, the permutes
+		 * stitch the lanes back into sequential order. */
+		__m256i t0 = _mm256_unpacklo_epi8(hi, lo);
+		__m256i t1 = _mm256_unpackhi_epi8(hi, lo);
+		_mm256_storeu_si256((__m256i *)(dst + 2*i),      _mm256_permute2x128_si256(t0, t1, 0x20));
+		_mm256_storeu_si256((__m256i *)(dst + 2*i + 32), _mm256_permute2x128_si256(t0, t1, 0x31));
+	}
+	return i;
+}
+
+__attribute__((target("ssse3")))
+static size_t hexcodec_decode_ssse3(unsigned char *dst, const char *src, size_t len, int *bad) {
+	const __m128i lower = _mm_set1_epi8(0x20);
+	const __m128i zero  = _mm_set1_epi8('0');
+	const __m128i nine  = _mm_set1_epi8(9);
+	const __m128i amin  = _mm_set1_epi8('a' - 1);
+	const __m128i amax  = _mm_set1_epi8('f' + 1);
+	const __m128i fuse  = _mm_set1_epi16(0x0110); /* bytes 0x10, 0x01: hi*16 + lo */
+	size_t i;
+
+	for (i = 0; i + 8 <= len; i += 8) {
+		__m128i in = _mm_or_si128(_mm_loadu_si128((const __m128i *)(src + 2*i)), lower);
+		__m128i num = _mm_sub_epi8(in, zero);
+		__m128i isnum = _mm_andnot_si128(_mm_cmpgt_epi8(num, nine), _mm_cmpgt_epi8(num, _mm_set1_epi8(-1)));
+		__m128i isalp = _mm_and_si128(_mm_cmpgt_epi8(in, amin), _mm_cmplt_epi8(in, amax));
+		if (_mm_movemask_epi8(_mm_or_si128(isnum, isalp)) != 0xffff) {
+			*bad = 1;
+			return i;
+		}
+		__m128i alp = _mm_sub_epi8(in, _mm_set1_epi8('a' - 10));
+		__m128i nib = _mm_or_si128(_mm_and_si128(isnum, num), _mm_and_si128(isalp, alp));
+		__m128i fused = _mm_maddubs_epi16(nib, fuse);
+		_mm_storel_epi64((__m128i *)(dst + i), _mm_packus_epi16(fused, fused));
+	}
+	return i;
+}
+
+#endif /* __x86_64__ */
+
+#if defined(__aarch64__)
+
+static size_t hexcodec_encode_neon(char *dst, const unsigned char *src, size_t len) {
+	const uint8x16_t lut  = vld1q_u8((const uint8_t *)hexcodec_digits);
+	const uint8x16_t mask = vdupq_n_u8(0x0f);
+	size_t i;
+
+	for (i = 0; i + 16 <= len; i += 16) {
+		uint8x16_t in = vld1q_u8(src + i);
+		uint8x16x2_t out;
+		out.val[0] = vqtbl1q_u8(lut, vshrq_n_u8(in, 4));
+		out.val[1] = vqtbl1q_u8(lut, vandq_u8(in, mask));
+		vst2q_u8((uint8_t *)(dst + 2*i), out); /* st2 interleaves the nibbles */
+	}
+	return i;
+}
+
+#endif /* __aarch64__ */
+
+// secp256k1_ext_hex_encode writes the lowercase hex encoding of the len src
+// bytes into dst, which must have room for 2*len characters.
+static void secp256k1_ext_hex_encode(char *dst, const unsigned char *src, size_t len) {
+	size_t done = 0;
+
+#if defined(__x86_64__)
+	switch (hexcodec_cpu()) {
+	case 2:
+		done = hexcodec_encode_avx2(dst, src, len);
+		break;
+	case 1:
+		done = hexcodec_encode_ssse3(dst, src, len);
+		break;
+	}
+#elif defined(__aarch64__)
+	done = hexcodec_encode_neon(dst, src, len);
+#endif
+	hexcodec_encode_scalar(dst + 2*done, src + done, len - done);
+}
+
+// secp256k1_ext_hex_decode parses 2*len hex characters from src into len
+// bytes at dst, accepting both digit cases. Returns 0 on success and -1 if
+// any character is not a hex digit.
+static int secp256k1_ext_hex_decode(unsigned char *dst, const char *src, size_t len) {
+	size_t done = 0;
+
+#if defined(__x86_64__)
+	if (hexcodec_cpu() >= 1) {
+		int bad = 0;
+		done = hexcodec_decode_ssse3(dst, src, len, &bad);
+		if (bad) {
+			return -1;
+		}
+	}
+#endif
+	return hexcodec_decode_scalar(dst + done, src + 2*done, len - done);
+}
+
+#endif /* SECP256K1_EXT_HEXCODEC_H */
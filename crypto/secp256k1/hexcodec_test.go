@@ -0,0 +1,90 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+package secp256k1
+
+import (
+	"bytes"
+	"encoding/hex"
+	"math/rand"
+	"strings"
+	"testing"
+)
+
+func TestHexCodecBulk(t *testing.T) {
+	// Sizes straddling the vector block boundaries, plus the 20 and 32 byte
+	// items the codec is meant to batch
+	for _, size := range []int{0, 1, 7, 8, 15, 16, 17, 20, 31, 32, 33, 64, 100, 32 * 1000} {
+		src := make([]byte, size)
+		rand.Read(src)
+
+		dst := make([]byte, 2*size)
+		if n := HexEncodeBulk(dst, src); n != 2*size {
+			t.Fatalf("size %d: encoded length mismatch: have %d, want %d", size, n, 2*size)
+		}
+		if want := hex.EncodeToString(src); string(dst) != want {
+			t.Fatalf("size %d: encoding mismatch: have %s, want %s", size, dst, want)
+		}
+		// Decode both the lower and upper case forms back
+		back := make([]byte, size)
+		if !HexDecodeBulk(back, dst) || !bytes.Equal(back, src) {
+			t.Fatalf("size %d: lower case decode mismatch", size)
+		}
+		if !HexDecodeBulk(back, []byte(strings.ToUpper(string(dst)))) || !bytes.Equal(back, src) {
+			t.Fatalf("size %d: upper case decode mismatch", size)
+		}
+	}
+}
+
+func TestHexCodecInvalid(t *testing.T) {
+	// Corrupt a single character at every position and ensure detection, both
+	// inside the vector blocks and in the scalar tail
+	valid := []byte("00112233445566778899aabbccddeeff0011223344")
+	for i := range valid {
+		for _, junk := range []byte{'g', 'G', ' ', '/', ':', '`', 0x00, 0x80, 0xff} {
+			blob := append([]byte{}, valid...)
+			blob[i] = junk
+			if HexDecodeBulk(make([]byte, len(blob)/2), blob) {
+				t.Fatalf("pos %d: invalid character %#x accepted", i, junk)
+			}
+		}
+	}
+}
+
+func BenchmarkHexEncodeBulk(b *testing.B) {
+	src := make([]byte, 32*1000)
+	rand.Read(src)
+	dst := make([]byte, 2*len(src))
+
+	b.SetBytes(int64(len(src)))
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		HexEncodeBulk(dst, src)
+	}
+}
+
+func BenchmarkHexDecodeBulk(b *testing.B) {
+	src := make([]byte, 32*1000)
+	rand.Read(src)
+	blob := make([]byte, 2*len(src))
+	HexEncodeBulk(blob, src)
+
+	b.SetBytes(int64(len(src)))
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		HexDecodeBulk(src, blob)
+	}
+}
@@ -0,0 +1,109 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+/* dl_iterate_phdr needs _GNU_SOURCE set before the first libc header. */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "hugetext.h"
+
+#include <string.h>
+
+#if defined(__linux__)
+
+#include <link.h>
+#include <stdint.h>
+#include <sys/mman.h>
+
+/* In-place collapse of file-backed mappings landed in Linux 6.1; older
+ * kernel headers lack the constant but the value is fixed ABI, and an older
+ * kernel just rejects the call with EINVAL, which the fallback handles. */
+#ifndef MADV_COLLAPSE
+#define MADV_COLLAPSE 25
+#endif
+
+#define HUGETEXT_PAGE ((uintptr_t)2 * 1024 * 1024)
+
+// Collapsing happens window by window rather than over the whole range in
+// one call: MADV_COLLAPSE stops at the first window it cannot serve (memory
+// pressure, an unmovable page), and per-window calls keep every window the
+// kernel would have accepted instead of losing everything after the first
+// refusal. A refused window is left for khugepaged via the MADV_HUGEPAGE
+// hint below.
+static int hugetext_phdr(struct dl_phdr_info *info, size_t size, void *data) {
+	hugetext_stats *st = (hugetext_stats *)data;
+	int i;
+
+	(void)size;
+	/* The cgo bundle is statically linked into the main binary, whose
+	 * entry carries the empty name; shared libraries are not ours to
+	 * remap. */
+	if (info->dlpi_name != NULL && info->dlpi_name[0] != '\0') {
+		return 0;
+	}
+	for (i = 0; i < info->dlpi_phnum; i++) {
+		const ElfW(Phdr) *ph = &info->dlpi_phdr[i];
+		uintptr_t start, end, astart, aend, w;
+		unsigned long long collapsed = 0;
+
+		if (ph->p_type != PT_LOAD || (ph->p_flags & PF_X) == 0) {
+			continue;
+		}
+		start = (uintptr_t)info->dlpi_addr + ph->p_vaddr;
+		end = start + ph->p_memsz;
+		st->text_bytes += ph->p_memsz;
+		astart = (start + HUGETEXT_PAGE - 1) & ~(HUGETEXT_PAGE - 1);
+		aend = end & ~(HUGETEXT_PAGE - 1);
+		if (aend <= astart) {
+			continue; /* segment smaller than one aligned window */
+		}
+		st->aligned_bytes += aend - astart;
+		for (w = astart; w < aend; w += HUGETEXT_PAGE) {
+			if (madvise((void *)w, HUGETEXT_PAGE, MADV_COLLAPSE) == 0) {
+				collapsed += HUGETEXT_PAGE;
+			}
+		}
+		st->collapsed_bytes += collapsed;
+		if (collapsed < aend - astart &&
+			madvise((void *)astart, aend - astart, MADV_HUGEPAGE) == 0) {
+			st->advised_bytes += (aend - astart) - collapsed;
+		}
+	}
+	return 0;
+}
+
+int hugetext_enable(hugetext_stats *stats) {
+	hugetext_stats local;
+	if (stats == NULL) {
+		stats = &local;
+	}
+	memset(stats, 0, sizeof(*stats));
+	dl_iterate_phdr(hugetext_phdr, stats);
+	return stats->collapsed_bytes > 0 || stats->advised_bytes > 0;
+}
+
+#else /* !__linux__ */
+
+// No huge-page text support; the mapping stays as the loader made it.
+int hugetext_enable(hugetext_stats *stats) {
+	if (stats != NULL) {
+		memset(stats, 0, sizeof(*stats));
+	}
+	return 0;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,53 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+package secp256k1
+
+/*
+#include "hugetext.h"
+*/
+import "C"
+
+// HugeTextStats reports what EnableHugeText did to the executable segments
+// of the running binary: how much text was found, how much of it sat inside
+// huge-page-aligned windows, and how many of those bytes were collapsed in
+// place versus merely hinted to khugepaged.
+type HugeTextStats struct {
+	TextBytes      uint64 // executable segment bytes found
+	AlignedBytes   uint64 // bytes inside huge-page-aligned windows
+	CollapsedBytes uint64 // bytes collapsed into huge pages in place
+	AdvisedBytes   uint64 // bytes carrying only the asynchronous hint
+}
+
+// EnableHugeText asks the kernel to back the text of the running binary with
+// huge pages, cutting the iTLB working set of the combined native bundle
+// (secp256k1, eaiash, duktape, hidapi) and everything else in the binary.
+// Aligned 2MiB windows are collapsed in place where the kernel supports it
+// (Linux 6.1+); refused windows fall back to the asynchronous MADV_HUGEPAGE
+// hint. It works best after contrib/textorder.py has packed the hot native
+// functions together, and should run during startup, before the text is hot.
+// The returned flag is false when the kernel declined every window or the
+// platform has no support; the mapping is then unchanged.
+func EnableHugeText() (HugeTextStats, bool) {
+	var cs C.hugetext_stats
+	ok := C.hugetext_enable(&cs) != 0
+	return HugeTextStats{
+		TextBytes:      uint64(cs.text_bytes),
+		AlignedBytes:   uint64(cs.aligned_bytes),
+		CollapsedBytes: uint64(cs.collapsed_bytes),
+		AdvisedBytes:   uint64(cs.advised_bytes),
+	}, ok
+}
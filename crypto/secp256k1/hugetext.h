@@ -0,0 +1,46 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+// Large-page text mapping for the combined native bundle. The vendored
+// libraries (secp256k1, eaiash, duktape, hidapi) add up to megabytes of
+// text, and once contrib/textorder.py has packed the hot functions together
+// the remaining iTLB pressure comes from that region being mapped with 4KiB
+// pages. The shim below asks the kernel to back the executable segments of
+// the running binary with huge pages instead, shrinking the iTLB working
+// set of every native subsystem at once.
+
+#ifndef SECP256K1_EXT_HUGETEXT_H
+#define SECP256K1_EXT_HUGETEXT_H
+
+typedef struct {
+	unsigned long long text_bytes;      /* executable segment bytes found */
+	unsigned long long aligned_bytes;   /* bytes inside huge-page-aligned windows */
+	unsigned long long collapsed_bytes; /* bytes collapsed into huge pages in place */
+	unsigned long long advised_bytes;   /* bytes carrying only the MADV_HUGEPAGE hint */
+} hugetext_stats;
+
+/* hugetext_enable remaps the executable segments of the main binary onto
+ * huge pages where the kernel allows it: each aligned 2MiB window is
+ * collapsed in place (MADV_COLLAPSE, Linux 6.1+), and windows the kernel
+ * refuses fall back to the asynchronous MADV_HUGEPAGE hint. Segment
+ * interiors only; the unaligned edges keep their 4KiB pages. Safe to call
+ * at any time, but meant for startup, before the text is hot. Fills stats
+ * (which may be NULL) and returns 1 when any window was collapsed or
+ * advised, 0 when the kernel declined everything or the platform has no
+ * support. */
+int hugetext_enable(hugetext_stats *stats);
+
+#endif /* SECP256K1_EXT_HUGETEXT_H */
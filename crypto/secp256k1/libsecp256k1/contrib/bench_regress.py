@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""Benchmark regression gate for the unified JSON harness (bench_all).
+
+Baselines are stored as one JSON file per CPU model under a baselines
+directory, so results from different machines never get compared against
+each other and the files stay diffable under version control.
+
+Usage:
+    bench_regress.py --bench ./bench_all [--baselines DIR] [--threshold PCT]
+    bench_regress.py --bench ./bench_all --update [--baselines DIR]
+
+Without --update the script runs the harness, compares every benchmark's
+min_us against the baseline for this CPU model and exits non-zero when a
+kernel regressed by more than the threshold (default 15%, min_us is the
+noise-resistant statistic). Benchmarks missing from the baseline are
+reported but do not fail the gate; refresh with --update after reviewing
+an intentional change.
+"""
+
+import argparse
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+
+
+def cpu_model():
+    try:
+        with open("/proc/cpuinfo") as f:
+            for line in f:
+                if line.startswith("model name"):
+                    return line.split(":", 1)[1].strip()
+    except IOError:
+        pass
+    try:
+        return subprocess.check_output(
+            ["sysctl", "-n", "machdep.cpu.brand_string"]).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def cpu_slug():
+    return re.sub(r"-+", "-", re.sub(r"[^a-z0-9]", "-", cpu_model().lower())).strip("-") or "unknown"
+
+
+def run_bench(bench):
+    out = subprocess.check_output(shlex.split(bench))
+    return {entry["name"]: entry for entry in json.loads(out)}
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--bench", default="./bench_all",
+                        help="harness command, optionally with arguments "
+                             "(e.g. './bench_all' or './bn256.test -bench.json')")
+    parser.add_argument("--baselines", default=None, help="baselines directory (default: <script dir>/../bench_baselines)")
+    parser.add_argument("--threshold", type=float, default=15.0, help="allowed min_us regression in percent")
+    parser.add_argument("--update", action="store_true", help="write the baseline for this CPU model instead of comparing")
+    args = parser.parse_args()
+
+    baselines = args.baselines or os.path.join(
+        os.path.dirname(os.path.abspath(__file__)), os.pardir, "bench_baselines")
+    path = os.path.join(baselines, cpu_slug() + ".json")
+
+    results = run_bench(args.bench)
+
+    if args.update:
+        if not os.path.isdir(baselines):
+            os.makedirs(baselines)
+        with open(path, "w") as f:
+            json.dump({"cpu": cpu_model(),
+                       "benchmarks": {name: round(entry["min_us"], 4)
+                                      for name, entry in sorted(results.items())}},
+                      f, indent=2, sort_keys=True)
+            f.write("\n")
+        print("baseline written: %s" % path)
+        return 0
+
+    if not os.path.exists(path):
+        print("no baseline for this CPU model (%s), run with --update first" % cpu_model())
+        return 0
+
+    with open(path) as f:
+        baseline = json.load(f)["benchmarks"]
+
+    failed = []
+    for name, entry in sorted(results.items()):
+        if name not in baseline:
+            print("%-24s %8.3fus  (no baseline)" % (name, entry["min_us"]))
+            continue
+        old = baseline[name]
+        delta = (entry["min_us"] - old) / old * 100.0
+        mark = ""
+        if delta > args.threshold:
+            mark = "  REGRESSION"
+            failed.append(name)
+        print("%-24s %8.3fus  baseline %8.3fus  %+6.1f%%%s"
+              % (name, entry["min_us"], old, delta, mark))
+
+    if failed:
+        print("FAIL: %d benchmark(s) regressed more than %.0f%%: %s"
+              % (len(failed), args.threshold, ", ".join(failed)))
+        return 1
+    print("OK: no benchmark regressed more than %.0f%%" % args.threshold)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""Seed corpus for src/fuzz_ffi.c from a crypto/replay trace.
+
+A coverage-guided fuzzer starting from an empty corpus spends its first
+hours rediscovering what a production trace already knows: the real mix of
+batch sizes, repeated signers, malformed spam and valid signatures. This
+tool converts a trace captured with the crypto/replay package
+(GEAI_CRYPTO_CAPTURE) into fuzz_ffi's structured record format, so the
+fuzzer mutates outward from the call shapes mainnet actually sees.
+
+Consecutive trace records of one kind are grouped into a batch record of up
+to the target's maximum batch size; recovery records become ECDSA_RECOVER
+calls and verification records ECDSA_VERIFY calls (seal records belong to
+eaiash, not this layer, and are skipped). The arrays are packed exactly as
+the target lays them out - signatures, then messages, then public keys - so
+each corpus entry replays the production inputs byte for byte.
+
+Usage: ffi_corpus.py TRACE OUTDIR [--max-files N]
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+TRACE_MAGIC = b"geaicrt1"
+
+KIND_RECOVER = 1
+KIND_VERIFY = 2
+
+OP_ECDSA_RECOVER = 1  # SECP256K1_FFI_OP_ECDSA_RECOVER
+OP_ECDSA_VERIFY = 3   # SECP256K1_FFI_OP_ECDSA_VERIFY
+
+MAX_N = 12            # FUZZ_FFI_MAX_N
+
+
+def read_records(path):
+    with open(path, "rb") as f:
+        if f.read(8) != TRACE_MAGIC:
+            sys.exit("ffi_corpus: %s is not a replay trace" % path)
+        while True:
+            head = f.read(5)
+            if len(head) < 5:
+                return
+            kind = head[0]
+            (size,) = struct.unpack("<I", head[1:])
+            payload = f.read(size)
+            if len(payload) < size:
+                return
+            yield kind, payload
+
+
+def batch_record(kind, payloads):
+    """Packs one group of same-kind trace records into a fuzz_ffi record."""
+    sigs = []
+    msgs = []
+    pubs = []
+    stride = 65
+    for payload in payloads:
+        if kind == KIND_RECOVER:
+            # 32-byte message, 65-byte recoverable signature.
+            if len(payload) < 97:
+                continue
+            msgs.append(payload[:32])
+            sigs.append(payload[32:97])
+        else:
+            # 32-byte message, 64-byte signature, 33- or 65-byte key.
+            if len(payload) < 129:
+                continue
+            msgs.append(payload[:32])
+            sigs.append(payload[32:96])
+            pub = payload[96:]
+            stride = 65 if len(pub) >= 65 else 33
+            pubs.append(pub[:stride].ljust(stride, b"\0"))
+    if not sigs:
+        return None
+    op = OP_ECDSA_RECOVER if kind == KIND_RECOVER else OP_ECDSA_VERIFY
+    ctrl = 1 if (kind == KIND_VERIFY and stride == 65) else 0
+    head = bytes([op, 0, len(sigs), ctrl])
+    return head + b"".join(sigs) + b"".join(msgs) + b"".join(pubs)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("trace", help="replay trace (GEAI_CRYPTO_CAPTURE output)")
+    ap.add_argument("outdir", help="corpus directory to fill")
+    ap.add_argument("--max-files", type=int, default=10000,
+                    help="stop after this many corpus entries (default 10000)")
+    args = ap.parse_args()
+
+    os.makedirs(args.outdir, exist_ok=True)
+    written = 0
+    group_kind = None
+    group = []
+
+    def flush():
+        nonlocal written, group
+        if group:
+            record = batch_record(group_kind, group)
+            if record is not None:
+                path = os.path.join(args.outdir, "trace-%06d" % written)
+                with open(path, "wb") as f:
+                    f.write(record)
+                written += 1
+            group = []
+
+    for kind, payload in read_records(args.trace):
+        if kind not in (KIND_RECOVER, KIND_VERIFY):
+            continue
+        if kind != group_kind or len(group) == MAX_N:
+            flush()
+            group_kind = kind
+        group.append(payload)
+        if written >= args.max_files:
+            break
+    flush()
+
+    print("ffi_corpus: %d corpus entries" % written)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
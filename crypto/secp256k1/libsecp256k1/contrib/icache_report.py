@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""Hot-code footprint report for the crypto entry points.
+
+Compiles the library as one translation unit with -ffunction-sections (one
+text section per surviving function) and -fdump-rtl-expand (the call graph
+after inlining), then sums the section sizes of every function reachable
+from each public entry point. Functions the compiler placed in a
+.text.unlikely section - the outlined failure paths behind the cold
+secp256k1_callback_call and anything else static prediction demotes - are
+reported separately and do not count against the budget, since the front
+end never streams them on the success path.
+
+The per-entry sum is the statically reachable hot text, an upper bound on
+the dynamic working set: a verify never executes both field backends, for
+example. It is still the number worth gating, because it only grows when
+hot code is added or a failure path escapes the cold partition, which is
+exactly what this report exists to catch.
+
+Usage: icache_report.py [--budget BYTES] [--cc CC] [--top DIR]
+Exits non-zero when any entry point's hot footprint exceeds the budget.
+"""
+
+import argparse
+import collections
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+# Build configuration of the Go wrapper (see secp256.go), so the report
+# matches the shipped hot paths rather than an arbitrary ./configure choice.
+CONFIG_DEFINES = [
+    "USE_ENDOMORPHISM",
+    "USE_NUM_NONE",
+    "USE_FIELD_INV_BUILTIN",
+    "USE_SCALAR_INV_BUILTIN",
+    "USE_FIELD_5X52",
+    "USE_SCALAR_4X64",
+    "HAVE___INT128",
+    "NDEBUG",
+]
+
+DEFAULT_ENTRY_PATTERN = r"^secp256k1_(ecdsa_|schnorr_|ec_pubkey_|ext_ecdsa_|ext_schnorr_|ext_pubkey_|ffi_execute)"
+
+# The ext/ffi layer entry points are static, so the harness must take their
+# addresses or the optimizer drops them before the object is written.
+EXT_ANCHORS = [
+    "secp256k1_ext_ecdsa_recover",
+    "secp256k1_ext_ecdsa_verify",
+    "secp256k1_ext_ecdsa_recover_batch",
+    "secp256k1_ext_ecdsa_verify_recover_batch",
+    "secp256k1_ext_ecdsa_recover_arena",
+    "secp256k1_ext_ecdsa_recover_address",
+    "secp256k1_ext_ecdsa_sign_pooled",
+    "secp256k1_ext_schnorr_verify_batch",
+    "secp256k1_ext_pubkey_decompress_batch",
+    "secp256k1_ffi_execute",
+]
+
+FUNC_LINE = re.compile(r"^;; Function (\S+)\s")
+CALL_LINE = re.compile(r"\(call[^\"]*\"([^\"]+)\"")
+# objdump -t: "0000.. l F .text.foo  0000..0123 foo"
+SYM_LINE = re.compile(r"^[0-9a-f]+\s+\S+\s+F\s+(\S+)\s+([0-9a-f]+)\s+(\S+)\s*$")
+
+
+def normalize(name):
+    """Strip the optimizer's clone suffixes (.constprop.0, .isra.3, ...)."""
+    return name.split(".")[0]
+
+
+def compile_unit(cc, top, workdir, with_ext):
+    harness = os.path.join(workdir, "icache_harness.c")
+    with open(harness, "w") as f:
+        for define in CONFIG_DEFINES:
+            f.write("#define %s 1\n" % define)
+        f.write('#include "src/secp256k1.c"\n')
+        f.write('#include "src/modules/recovery/main_impl.h"\n')
+        f.write('#include "src/modules/schnorr/main_impl.h"\n')
+        if with_ext:
+            f.write('#include "../ext.h"\n')
+            f.write("__attribute__((used)) static void *icache_report_anchors[] = {\n")
+            for anchor in EXT_ANCHORS:
+                f.write("    (void *) %s,\n" % anchor)
+            f.write("};\n")
+    obj = os.path.join(workdir, "icache_harness.o")
+    cmd = [cc, "-O2", "-D_GNU_SOURCE", "-I.", "-I./src", "-I./include",
+           "-ffunction-sections", "-fdump-rtl-expand", "-c", harness, "-o", obj]
+    subprocess.check_call(cmd, cwd=top)
+    return obj
+
+
+def find_expand(workdir):
+    for root, _, files in os.walk(workdir):
+        for name in files:
+            if name.endswith(".expand"):
+                return os.path.join(root, name)
+    sys.exit("icache_report: compiler did not produce an .expand dump "
+             "(gcc with -fdump-rtl-expand required)")
+
+
+def parse_sizes(obj):
+    """Per-function text size, split into hot and unlikely bytes."""
+    hot, cold = {}, {}
+    out = subprocess.check_output(["objdump", "-t", obj]).decode()
+    for line in out.splitlines():
+        m = SYM_LINE.match(line)
+        if not m:
+            continue
+        section, size, symbol = m.group(1), int(m.group(2), 16), normalize(m.group(3))
+        if not section.startswith(".text") or size == 0:
+            continue
+        table = cold if ".unlikely" in section else hot
+        table[symbol] = table.get(symbol, 0) + size
+    return hot, cold
+
+
+def parse_calls(expand_path):
+    calls = collections.defaultdict(set)
+    current = None
+    with open(expand_path) as f:
+        for line in f:
+            m = FUNC_LINE.match(line)
+            if m:
+                current = normalize(m.group(1))
+                continue
+            if current is None or "(call" not in line:
+                continue
+            m = CALL_LINE.search(line)
+            if m:
+                calls[current].add(normalize(m.group(1)))
+    return calls
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--budget", type=int, default=65536,
+                        help="per-entry-point hot text budget in bytes (default "
+                             "64KiB, sized to the reachable superset - the ffi "
+                             "dispatcher tops out around 45KiB today; the "
+                             "dynamic working set should fit a 32KiB L1i)")
+    parser.add_argument("--cc", default=os.environ.get("CC", "gcc"),
+                        help="compiler to use (default $CC or gcc)")
+    parser.add_argument("--top", default=".",
+                        help="library top source directory")
+    parser.add_argument("--entries", default=DEFAULT_ENTRY_PATTERN,
+                        help="regex selecting the entry points to report")
+    args = parser.parse_args()
+
+    top = os.path.abspath(args.top)
+    # The ext/ffi layer pulls the vendored keccak source via a repo-relative
+    # path, so it is only analyzable inside the full go-ethereumai tree.
+    with_ext = (os.path.isfile(os.path.join(top, "..", "ext.h")) and
+                os.path.isfile(os.path.join(top, "..", "..", "..", "vendor",
+                                            "github.com", "ethereumai", "eaiash",
+                                            "src", "libeaiash", "sha3.c")))
+    with tempfile.TemporaryDirectory() as workdir:
+        obj = compile_unit(args.cc, top, workdir, with_ext)
+        hot, cold = parse_sizes(obj)
+        calls = parse_calls(find_expand(workdir))
+
+    def reachable(entry):
+        seen, stack = set(), [entry]
+        while stack:
+            fn = stack.pop()
+            if fn in seen:
+                continue
+            seen.add(fn)
+            stack.extend(calls.get(fn, ()))
+        return seen
+
+    entry_re = re.compile(args.entries)
+    entries = sorted(fn for fn in set(hot) | set(cold) if entry_re.search(fn))
+    if not entries:
+        sys.exit("icache_report: no entry points match %r" % args.entries)
+
+    rows = []
+    for entry in entries:
+        seen = reachable(entry)
+        hot_bytes = sum(hot.get(fn, 0) for fn in seen)
+        cold_bytes = sum(cold.get(fn, 0) for fn in seen)
+        rows.append((hot_bytes, cold_bytes, entry))
+    rows.sort(reverse=True)
+
+    print("%-48s %10s %10s" % ("entry point", "hot", "cold"))
+    failed = False
+    for hot_bytes, cold_bytes, entry in rows:
+        note = ""
+        if hot_bytes > args.budget:
+            failed = True
+            note = "  OVER BUDGET"
+        print("%-48s %10d %10d%s" % (entry, hot_bytes, cold_bytes, note))
+    total_cold = sum(cold.values())
+    print("budget: %d hot bytes per entry point; %d bytes outlined as cold "
+          "unit-wide" % (args.budget, total_cold))
+    if total_cold == 0:
+        sys.exit("icache_report: no .text.unlikely sections found - cold "
+                 "outlining is not taking effect")
+    if failed:
+        sys.exit("icache_report: budget exceeded")
+    print("icache_report: all entry points within budget")
+
+
+if __name__ == "__main__":
+    main()
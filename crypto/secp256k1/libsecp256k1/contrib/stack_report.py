@@ -0,0 +1,223 @@
+#!/usr/bin/env python3
+"""Worst-case stack usage report for the hot crypto entry points.
+
+Compiles the library as one translation unit with -fstack-usage (per-function
+frame sizes) and -fdump-rtl-expand (the surviving call graph after inlining),
+then walks the graph to compute the deepest stack chain reachable from every
+public entry point. The result is deterministic for a fixed compiler and flag
+set, so it can gate changes like raising WINDOW_A: the pre_a tables in
+ecmult_impl.h land on whatever thread stack the caller runs on, where
+overflow is fatal and there is no Go-style stack growth.
+
+Indirect calls (function pointers) cannot be followed statically and are
+listed per entry point; recursion is broken at the back edge and reported.
+Frames of external libc calls default to --extern-frame bytes.
+
+Usage: stack_report.py [--budget BYTES] [--cc CC] [--top DIR]
+Exits non-zero when any entry point exceeds the budget.
+"""
+
+import argparse
+import collections
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+# Build configuration of the Go wrapper (see secp256.go), so the report
+# matches the shipped hot paths rather than an arbitrary ./configure choice.
+CONFIG_DEFINES = [
+    "USE_ENDOMORPHISM",
+    "USE_NUM_NONE",
+    "USE_FIELD_INV_BUILTIN",
+    "USE_SCALAR_INV_BUILTIN",
+    "USE_FIELD_5X52",
+    "USE_SCALAR_4X64",
+    "HAVE___INT128",
+    "NDEBUG",
+]
+
+DEFAULT_ENTRY_PATTERN = r"^secp256k1_(ecdsa_|schnorr_|ec_pubkey_|ext_ecdsa_|ext_schnorr_|ext_pubkey_|ffi_execute)"
+
+# The ext/ffi layer entry points are static, so the harness must take their
+# addresses or the optimizer drops them before the dumps are written.
+EXT_ANCHORS = [
+    "secp256k1_ext_ecdsa_recover",
+    "secp256k1_ext_ecdsa_verify",
+    "secp256k1_ext_ecdsa_recover_batch",
+    "secp256k1_ext_ecdsa_verify_recover_batch",
+    "secp256k1_ext_ecdsa_recover_arena",
+    "secp256k1_ext_ecdsa_recover_address",
+    "secp256k1_ext_ecdsa_sign_pooled",
+    "secp256k1_ext_schnorr_verify_batch",
+    "secp256k1_ext_pubkey_decompress_batch",
+    "secp256k1_ffi_execute",
+]
+
+SU_LINE = re.compile(r"^[^:]*:\d+:\d+:(\S+)\t(\d+)\t(\S+)")
+FUNC_LINE = re.compile(r"^;; Function (\S+)\s")
+CALL_LINE = re.compile(r"\(call[^\"]*\"([^\"]+)\"")
+
+
+def normalize(name):
+    """Strip the optimizer's clone suffixes (.constprop.0, .isra.3, ...)."""
+    return name.split(".")[0]
+
+
+def compile_unit(cc, top, workdir, with_ext):
+    harness = os.path.join(workdir, "stack_harness.c")
+    with open(harness, "w") as f:
+        for define in CONFIG_DEFINES:
+            f.write("#define %s 1\n" % define)
+        f.write('#include "src/secp256k1.c"\n')
+        f.write('#include "src/modules/recovery/main_impl.h"\n')
+        f.write('#include "src/modules/schnorr/main_impl.h"\n')
+        if with_ext:
+            f.write('#include "../ext.h"\n')
+            f.write("__attribute__((used)) static void *stack_report_anchors[] = {\n")
+            for anchor in EXT_ANCHORS:
+                f.write("    (void *) %s,\n" % anchor)
+            f.write("};\n")
+    obj = os.path.join(workdir, "stack_harness.o")
+    cmd = [cc, "-O2", "-D_GNU_SOURCE", "-I.", "-I./src", "-I./include",
+           "-fstack-usage", "-fdump-rtl-expand", "-c", harness, "-o", obj]
+    subprocess.check_call(cmd, cwd=top)
+    return obj
+
+
+def find_dumps(workdir):
+    su, expand = None, None
+    for root, _, files in os.walk(workdir):
+        for name in files:
+            if name.endswith(".su"):
+                su = os.path.join(root, name)
+            if name.endswith(".expand"):
+                expand = os.path.join(root, name)
+    if su is None or expand is None:
+        sys.exit("stack_report: compiler did not produce .su/.expand dumps "
+                 "(gcc with -fstack-usage/-fdump-rtl-expand required)")
+    return su, expand
+
+
+def parse_frames(su_path):
+    frames, dynamic = {}, set()
+    with open(su_path) as f:
+        for line in f:
+            m = SU_LINE.match(line)
+            if not m:
+                continue
+            name = normalize(m.group(1))
+            frames[name] = max(frames.get(name, 0), int(m.group(2)))
+            if "dynamic" in m.group(3):
+                dynamic.add(name)
+    return frames, dynamic
+
+
+def parse_calls(expand_path):
+    calls = collections.defaultdict(set)
+    indirect = collections.defaultdict(int)
+    current = None
+    with open(expand_path) as f:
+        for line in f:
+            m = FUNC_LINE.match(line)
+            if m:
+                current = normalize(m.group(1))
+                continue
+            if current is None or "(call" not in line:
+                continue
+            m = CALL_LINE.search(line)
+            if m:
+                calls[current].add(normalize(m.group(1)))
+            else:
+                indirect[current] += 1
+    return calls, indirect
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--budget", type=int, default=65536,
+                        help="per-entry-point stack budget in bytes (default 64KiB, "
+                             "half of the smallest common thread stack)")
+    parser.add_argument("--cc", default=os.environ.get("CC", "gcc"),
+                        help="compiler to use (default $CC or gcc)")
+    parser.add_argument("--top", default=".",
+                        help="library top source directory")
+    parser.add_argument("--entries", default=DEFAULT_ENTRY_PATTERN,
+                        help="regex selecting the entry points to report")
+    parser.add_argument("--extern-frame", type=int, default=256,
+                        help="assumed frame size of external (libc) calls")
+    parser.add_argument("--call-overhead", type=int, default=16,
+                        help="return address and saved register estimate per call")
+    args = parser.parse_args()
+
+    top = os.path.abspath(args.top)
+    # The ext/ffi layer pulls the vendored keccak source via a repo-relative
+    # path, so it is only analyzable inside the full go-ethereumai tree.
+    with_ext = (os.path.isfile(os.path.join(top, "..", "ext.h")) and
+                os.path.isfile(os.path.join(top, "..", "..", "..", "vendor",
+                                            "github.com", "ethereumai", "eaiash",
+                                            "src", "libeaiash", "sha3.c")))
+    with tempfile.TemporaryDirectory() as workdir:
+        compile_unit(args.cc, top, workdir, with_ext)
+        su_path, expand_path = find_dumps(workdir)
+        frames, dynamic = parse_frames(su_path)
+        calls, indirect = parse_calls(expand_path)
+
+    memo, on_stack, cycles = {}, set(), set()
+
+    def depth(fn):
+        """Deepest chain starting at fn: (bytes, path, indirects, dynamics)."""
+        if fn in memo:
+            return memo[fn]
+        if fn in on_stack:
+            cycles.add(fn)
+            return (0, [], 0, 0)
+        frame = frames.get(fn)
+        if frame is None:
+            # External call: not compiled here, assume a flat frame.
+            return (args.extern_frame, [fn], 0, 0)
+        on_stack.add(fn)
+        best = (0, [], 0, 0)
+        for callee in sorted(calls.get(fn, ())):
+            sub = depth(callee)
+            if sub[0] > best[0]:
+                best = sub
+        on_stack.discard(fn)
+        result = (frame + args.call_overhead + best[0], [fn] + best[1],
+                  indirect.get(fn, 0) + best[2],
+                  (1 if fn in dynamic else 0) + best[3])
+        memo[fn] = result
+        return result
+
+    entry_re = re.compile(args.entries)
+    entries = sorted(fn for fn in frames if entry_re.search(fn))
+    if not entries:
+        sys.exit("stack_report: no entry points match %r" % args.entries)
+
+    rows = sorted((depth(fn) for fn in entries), reverse=True)
+    print("%-48s %10s  %s" % ("entry point", "stack", "notes"))
+    failed = False
+    for total, path, ind, dyn in rows:
+        notes = []
+        if ind:
+            notes.append("%d indirect call(s) not followed" % ind)
+        if dyn:
+            notes.append("dynamic stack on path")
+        over = total > args.budget
+        failed = failed or over
+        if over:
+            notes.append("OVER BUDGET")
+        print("%-48s %10d  %s" % (path[0], total, "; ".join(notes)))
+        if over:
+            print("    deepest chain: %s" % " -> ".join(path))
+    if cycles:
+        print("recursion broken at: %s" % ", ".join(sorted(cycles)))
+    print("budget: %d bytes per entry point" % args.budget)
+    if failed:
+        sys.exit("stack_report: budget exceeded")
+    print("stack_report: all entry points within budget")
+
+
+if __name__ == "__main__":
+    main()
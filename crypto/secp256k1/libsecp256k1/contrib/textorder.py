@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""Linker ordering file for the hot native functions.
+
+The combined native bundle (secp256k1 + eaiash + duktape + hidapi) spans
+megabytes of text, and the default link order scatters the hot functions of
+a production workload across it, so the front end pays iTLB and icache
+misses walking between them. This tool turns a profile of a real workload -
+ideally a crypto/replay trace replayed under perf, so the ranking reflects
+production truth - into a linker ordering file that packs the hot functions
+together at the front of the text segment.
+
+Pipeline:
+
+    GEAI_CRYPTO_CAPTURE=trace.bin geai ...       # capture production traffic
+    perf record -o perf.data <replay bench of trace.bin>
+    perf report -i perf.data --stdio --sort symbol | textorder.py -o hot.txt
+    CGO_CFLAGS='-ffunction-sections' \\
+        CGO_LDFLAGS='-fuse-ld=lld -Wl,--symbol-ordering-file=hot.txt' \\
+        go build ...
+
+The input is either `perf report --stdio` output or a plain hot-function
+list (one symbol per line, hottest first, # comments ignored), so a ranking
+from any other profiler can be fed through unchanged. Only symbols matching
+the native prefixes are kept by default - reordering Go's own functions is
+the Go linker's business - and duplicate samples of one symbol are summed
+before ranking. --sections emits `.text.<symbol>` lines instead, the format
+gold's --section-ordering-file wants.
+
+Packing is the static half of the fix; the startup shim in hugetext.c then
+maps the packed region with huge pages. Both halves are independent and
+each stands on its own.
+"""
+
+import argparse
+import re
+import sys
+
+# Symbol prefixes of the vendored native subsystems. Everything else in the
+# profile (Go runtime, libc, kernel) is dropped unless --all is given.
+NATIVE_PREFIXES = [
+    "secp256k1_",
+    "eaiash_",
+    "ethash_",
+    "sha3",
+    "keccakf",
+    "duk_",
+    "duk__",
+    "hid_",
+    "libusb_",
+    "usbi_",
+    "nativemem_",
+    "hugetext_",
+]
+
+# One sample row of `perf report --stdio --sort symbol`:
+#     12.34%  geai  geai  [.] secp256k1_fe_mul_inner
+PERF_ROW = re.compile(r"^\s*(\d+(?:\.\d+)?)%.*\[[.k]\]\s+(\S+)\s*$")
+
+
+def parse(lines):
+    """Returns {symbol: weight}, accepting perf report output or a plain
+    symbol-per-line list (weighted by reverse position to keep its order)."""
+    weights = {}
+    plain = []
+    for line in lines:
+        line = line.rstrip("\n")
+        m = PERF_ROW.match(line)
+        if m:
+            weights[m.group(2)] = weights.get(m.group(2), 0.0) + float(m.group(1))
+            continue
+        token = line.split("#", 1)[0].strip()
+        if token and not token.startswith("Samples:") and " " not in token:
+            plain.append(token)
+    if not weights:
+        for i, sym in enumerate(plain):
+            weights.setdefault(sym, float(len(plain) - i))
+    return weights
+
+
+def native(symbol):
+    return any(symbol.startswith(p) for p in NATIVE_PREFIXES)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("profile", nargs="?", default="-",
+                    help="perf report --stdio output or plain symbol list (default stdin)")
+    ap.add_argument("-o", "--output", default="-",
+                    help="ordering file to write (default stdout)")
+    ap.add_argument("--sections", action="store_true",
+                    help="emit .text.<symbol> lines (gold --section-ordering-file)")
+    ap.add_argument("--all", action="store_true",
+                    help="keep every symbol, not only the native subsystems")
+    ap.add_argument("--min-percent", type=float, default=0.0,
+                    help="drop symbols below this share of samples (default 0)")
+    args = ap.parse_args()
+
+    src = sys.stdin if args.profile == "-" else open(args.profile)
+    with src:
+        weights = parse(src)
+
+    ranked = [
+        sym for sym, w in sorted(weights.items(), key=lambda kv: (-kv[1], kv[0]))
+        if w >= args.min_percent and (args.all or native(sym))
+    ]
+    if not ranked:
+        sys.stderr.write("textorder: no native symbols in profile\n")
+        return 1
+
+    out = sys.stdout if args.output == "-" else open(args.output, "w")
+    with out:
+        for sym in ranked:
+            out.write((".text.%s\n" % sym) if args.sections else (sym + "\n"))
+
+    if args.output != "-":
+        sys.stderr.write(
+            "textorder: %d symbols; link with CGO_CFLAGS='-ffunction-sections' "
+            "CGO_LDFLAGS='-fuse-ld=lld -Wl,--symbol-ordering-file=%s'\n"
+            % (len(ranked), args.output))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
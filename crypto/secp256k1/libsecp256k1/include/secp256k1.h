@@ -42,6 +42,15 @@ extern "C" {
  */
 typedef struct secp256k1_context_struct secp256k1_context;
 
+/** Opaque data structure that holds rewriteable "scratch space"
+ *
+ *  A scratch space keeps one warm allocation for the temporary tables that
+ *  verification operations would otherwise rebuild on the stack per call.
+ *  Unlike the context object, it cannot safely be shared between threads
+ *  without additional synchronization logic.
+ */
+typedef struct secp256k1_scratch_space_struct secp256k1_scratch_space;
+
 /** Opaque data structure that holds a parsed and valid public key.
  *
  *  The exact representation of data inside is implementation defined and not
@@ -148,12 +157,24 @@ typedef int (*secp256k1_nonce_function)(
 /** The higher bits contain the actual data. Do not use directly. */
 #define SECP256K1_FLAGS_BIT_CONTEXT_VERIFY (1 << 8)
 #define SECP256K1_FLAGS_BIT_CONTEXT_SIGN (1 << 9)
+#define SECP256K1_FLAGS_BIT_CONTEXT_SMALL_TABLES (1 << 10)
+#define SECP256K1_FLAGS_BIT_CONTEXT_VARTIME (1 << 11)
 #define SECP256K1_FLAGS_BIT_COMPRESSION (1 << 8)
 
 /** Flags to pass to secp256k1_context_create. */
 #define SECP256K1_CONTEXT_VERIFY (SECP256K1_FLAGS_TYPE_CONTEXT | SECP256K1_FLAGS_BIT_CONTEXT_VERIFY)
 #define SECP256K1_CONTEXT_SIGN (SECP256K1_FLAGS_TYPE_CONTEXT | SECP256K1_FLAGS_BIT_CONTEXT_SIGN)
 #define SECP256K1_CONTEXT_NONE (SECP256K1_FLAGS_TYPE_CONTEXT)
+/** Like SECP256K1_CONTEXT_VERIFY, but with small precomputed tables: a few
+ *  dozen KiB instead of 1.375 MiB, at the cost of slower verification. For
+ *  memory-constrained deployments; both profiles come out of the same build. */
+#define SECP256K1_CONTEXT_VERIFY_SMALL (SECP256K1_FLAGS_TYPE_CONTEXT | SECP256K1_FLAGS_BIT_CONTEXT_VERIFY | SECP256K1_FLAGS_BIT_CONTEXT_SMALL_TABLES)
+/** Like SECP256K1_CONTEXT_VERIFY, but additionally opts in to the fastest
+ *  variable-time kernels (currently GCD-based modular inversion) behind the
+ *  operations that are variable-time by contract: verification, recovery and
+ *  public key parsing. Those kernels never touch secret data, so signing
+ *  through a context in the same process remains constant-time. */
+#define SECP256K1_CONTEXT_VERIFY_VARTIME (SECP256K1_FLAGS_TYPE_CONTEXT | SECP256K1_FLAGS_BIT_CONTEXT_VERIFY | SECP256K1_FLAGS_BIT_CONTEXT_VARTIME)
 
 /** Flag to pass to secp256k1_ec_pubkey_serialize and secp256k1_ec_privkey_export. */
 #define SECP256K1_EC_COMPRESSED (SECP256K1_FLAGS_TYPE_COMPRESSION | SECP256K1_FLAGS_BIT_COMPRESSION)
@@ -177,6 +198,57 @@ SECP256K1_API secp256k1_context* secp256k1_context_clone(
     const secp256k1_context* ctx
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_WARN_UNUSED_RESULT;
 
+/** Copies a secp256k1 context object, sharing the immutable precomputed
+ *  verification tables with the original instead of deep-copying them.
+ *
+ *  Only the mutable signing state is duplicated, so creating one clone per
+ *  worker thread costs O(1) memory rather than a multi-megabyte table copy
+ *  each. The original context must outlive all shared clones, and must itself
+ *  not be a shared clone.
+ *
+ *  Returns: a newly created context object.
+ *  Args:    ctx: an existing context to copy (cannot be NULL)
+ */
+SECP256K1_API secp256k1_context* secp256k1_context_clone_shared(
+    const secp256k1_context* ctx
+) SECP256K1_ARG_NONNULL(1) SECP256K1_WARN_UNUSED_RESULT;
+
+/** Memory layout of a context object's precomputed state.
+ *
+ *  Sizes are in bytes; cache line counts assume 64-byte lines. A field is 0
+ *  when the corresponding table was not built for this context (e.g. no
+ *  verification tables in a signing-only context).
+ */
+typedef struct {
+    size_t context_bytes;        /* the context structure itself, excluding tables */
+    size_t arena_bytes;          /* total slab backing the context and its tables */
+    size_t entry_bytes;          /* one precomputed table entry */
+    size_t entry_alignment;      /* required alignment of a table entry */
+    int    ecmult_window;        /* wNAF window of the verification tables */
+    size_t ecmult_tables;        /* number of generator wNAF tables */
+    size_t ecmult_entries;       /* entries per wNAF table */
+    size_t ecmult_bytes;         /* total wNAF table bytes */
+    size_t ecmult_cachelines;    /* cache lines the wNAF tables span */
+    int    ecmult_interleaved;   /* wNAF tables are stored interleaved per index */
+    int    ecmult_borrowed;      /* wNAF tables are owned by another context */
+    size_t ecmult_gen_bytes;     /* blinded signing table bytes */
+    size_t ecmult_gen_cachelines;/* cache lines the signing table spans */
+} secp256k1_context_memory_layout;
+
+/** Report how a context's interior lays out in memory.
+ *
+ *  Intended for capacity planning of shared-memory deployments; the report
+ *  reflects the tables actually built for this context, including the
+ *  reduced-table and shared-clone variants.
+ *
+ *  Args:   ctx:    an existing context object (cannot be NULL)
+ *  Out:    layout: filled with the context's memory layout (cannot be NULL)
+ */
+SECP256K1_API void secp256k1_context_memory_report(
+    const secp256k1_context* ctx,
+    secp256k1_context_memory_layout *layout
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
 /** Destroy a secp256k1 context object.
  *
  *  The context pointer may not be used afterwards.
@@ -186,6 +258,22 @@ SECP256K1_API void secp256k1_context_destroy(
     secp256k1_context* ctx
 );
 
+/** Abandon a secp256k1 context object at process shutdown.
+ *
+ *  Fast-teardown variant of secp256k1_context_destroy: the secret generator
+ *  blinding state installed by secp256k1_context_randomize is scrubbed
+ *  synchronously, but the precomputed multiplication tables are public
+ *  write-once data that need no scrubbing, so their memory (and the context
+ *  itself) is deliberately left for process exit to reclaim. Only call this
+ *  when the process is about to exit; anywhere else it is a memory leak.
+ *
+ *  The context pointer may not be used afterwards.
+ *  Args:   ctx: an existing context to abandon (cannot be NULL)
+ */
+SECP256K1_API void secp256k1_context_abandon(
+    secp256k1_context* ctx
+);
+
 /** Set a callback function to be called when an illegal argument is passed to
  *  an API call. It will only trigger for violations that are mentioned
  *  explicitly in the header.
@@ -234,6 +322,26 @@ SECP256K1_API void secp256k1_context_set_error_callback(
     const void* data
 ) SECP256K1_ARG_NONNULL(1);
 
+/** Create a secp256k1 scratch space object.
+ *
+ *  Returns: a newly created scratch space.
+ *  Args: ctx:  an existing context object (cannot be NULL)
+ *  In:   max_size: maximum amount of memory to allocate
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT secp256k1_scratch_space* secp256k1_scratch_space_create(
+    const secp256k1_context* ctx,
+    size_t max_size
+) SECP256K1_ARG_NONNULL(1);
+
+/** Destroy a secp256k1 scratch space.
+ *
+ *  The pointer may not be used afterwards.
+ *  Args: scratch: space to destroy
+ */
+SECP256K1_API void secp256k1_scratch_space_destroy(
+    secp256k1_scratch_space* scratch
+);
+
 /** Parse a variable-length public key into the pubkey object.
  *
  *  Returns: 1 if the public key was fully valid.
@@ -278,6 +386,56 @@ SECP256K1_API int secp256k1_ec_pubkey_serialize(
     unsigned int flags
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
 
+/** Parse a batch of public keys that all share one serialization format.
+ *
+ *  Returns: the number of keys that parsed as fully valid public keys.
+ *  Args: ctx:      a secp256k1 context object.
+ *  Out:  pubkeys:  pointer to an array of n pubkey objects. pubkeys[i] is set
+ *                  to the parsed version of key i on success and zeroized on
+ *                  failure.
+ *        results:  pointer to an array of n ints receiving per-key success
+ *                  (1/0). May be NULL when only the count is wanted.
+ *  In:   input:    pointer to n serialized public keys laid out back to back,
+ *                  each 33 bytes (SECP256K1_EC_COMPRESSED) or 65 bytes
+ *                  (SECP256K1_EC_UNCOMPRESSED) as asserted by flags.
+ *        n:        the number of keys to parse.
+ *        flags:    SECP256K1_EC_COMPRESSED or SECP256K1_EC_UNCOMPRESSED.
+ *
+ *  The caller-asserted format hoists the per-key tag dispatch of
+ *  secp256k1_ec_pubkey_parse out of the loop; in particular uncompressed keys
+ *  validate with a single curve-equation check and never compute a field
+ *  square root. A key whose header byte does not match the asserted format
+ *  fails parsing (hybrid headers are not accepted in batch mode).
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT size_t secp256k1_ec_pubkey_parse_batch(
+    const secp256k1_context* ctx,
+    secp256k1_pubkey* pubkeys,
+    int* results,
+    const unsigned char *input,
+    size_t n,
+    unsigned int flags
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(4);
+
+/** Serialize a batch of pubkey objects into one serialization format.
+ *
+ *  Returns: the number of keys successfully serialized.
+ *  Args:   ctx:     a secp256k1 context object.
+ *  Out:    output:  pointer to room for n serialized keys laid out back to
+ *                   back, each 33 bytes (SECP256K1_EC_COMPRESSED) or 65 bytes
+ *                   (SECP256K1_EC_UNCOMPRESSED). The slot of a pubkey that
+ *                   fails to load is zeroized.
+ *  In:     pubkeys: pointer to an array of n initialized pubkey objects.
+ *          n:       the number of keys to serialize.
+ *          flags:   SECP256K1_EC_COMPRESSED or SECP256K1_EC_UNCOMPRESSED.
+ */
+SECP256K1_API size_t secp256k1_ec_pubkey_serialize_batch(
+    const secp256k1_context* ctx,
+    unsigned char *output,
+    const secp256k1_pubkey* pubkeys,
+    size_t n,
+    unsigned int flags
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
 /** Parse an ECDSA signature in compact (64 bytes) format.
  *
  *  Returns: 1 when the signature could be parsed, 0 otherwise.
@@ -379,6 +537,60 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdsa_verify(
     const secp256k1_pubkey *pubkey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
 
+/** Serialize a verification context's precomputed tables into a flat image.
+ *
+ *  The image is self-describing and pointer-free: it can be copied, written
+ *  to a file, or placed in a shared mapping, and then drives
+ *  secp256k1_ecdsa_verify_stateless in any thread or process of a build with
+ *  the same library configuration, with no context object and no locking.
+ *  An image records the table layout of the exporting context (window size,
+ *  storage order), so verification behaves exactly as through that context.
+ *
+ *  Returns: the image size in bytes; the image is only written when buf is
+ *           non-NULL and size is at least that large, so calling with
+ *           NULL, 0 sizes the allocation. 0 if the context has no
+ *           verification tables.
+ *  Args:   ctx:  an existing context, initialized for verification (cannot be NULL)
+ *  Out:    buf:  caller-owned memory for the image, 8-byte aligned or better
+ *                (64-byte alignment keeps the tables cacheline-aligned)
+ *  In:     size: capacity of buf in bytes
+ */
+SECP256K1_API size_t secp256k1_context_tables_export(
+    const secp256k1_context* ctx,
+    void *buf,
+    size_t size
+) SECP256K1_ARG_NONNULL(1);
+
+/** Verify an ECDSA signature against an exported table image, without a
+ *  context object.
+ *
+ *  The unit of sharing becomes the read-only image itself: one mapping can
+ *  serve any number of threads or processes concurrently, with nothing
+ *  per-caller beyond the stack frame. Argument errors return 0 rather than
+ *  invoking a callback, since there is no context to carry one. The lower-S
+ *  rule of secp256k1_ecdsa_verify applies unchanged.
+ *
+ *  Returns: 1: correct signature
+ *           0: incorrect or unparseable signature, or malformed image
+ *  In:      tables: an image written by secp256k1_context_tables_export
+ *                   (cannot be NULL)
+ *           size:   size of the image in bytes
+ *           sig:    the signature being verified
+ *           msg32:  the 32-byte message hash being verified
+ *           pubkey: pointer to an initialized public key
+ *
+ *  No argument carries a nonnull attribute: NULL is answered with 0 at
+ *  runtime, and the attribute would license the compiler to delete exactly
+ *  those checks.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdsa_verify_stateless(
+    const void *tables,
+    size_t size,
+    const secp256k1_ecdsa_signature *sig,
+    const unsigned char *msg32,
+    const secp256k1_pubkey *pubkey
+);
+
 /** Convert a signature to a normalized lower-S form.
  *
  *  Returns: 1 if sigin was not normalized, 0 if it already was.
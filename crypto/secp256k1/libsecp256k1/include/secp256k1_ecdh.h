@@ -7,6 +7,32 @@
 extern "C" {
 # endif
 
+/** A pointer to a function that turns the shared point into the output secret
+ *  Returns: 1: secret was written to output
+ *           0: fail the ECDH computation
+ *  Out:     output:     a 32-byte array to be filled by the function
+ *  In:      x32:        the 32-byte serialized x coordinate of the point
+ *           y32:        the 32-byte serialized y coordinate of the point
+ *           data:       arbitrary data pointer passed through by the caller
+ */
+typedef int (*secp256k1_ecdh_hash_function)(
+  unsigned char *output,
+  const unsigned char *x32,
+  const unsigned char *y32,
+  void *data
+);
+
+/** The default hash function: SHA256 over the compressed serialization of the
+ *  point, i.e. the parity byte followed by x32. This is what secp256k1_ecdh
+ *  and secp256k1_ecdh_batch produce; data is ignored.
+ */
+SECP256K1_API int secp256k1_ecdh_hash_function_sha256(
+  unsigned char *output,
+  const unsigned char *x32,
+  const unsigned char *y32,
+  void *data
+);
+
 /** Compute an EC Diffie-Hellman secret in constant time
  *  Returns: 1: exponentiation was successful
  *           0: scalar was invalid (zero or overflow)
@@ -24,6 +50,119 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdh(
   const unsigned char *privkey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
 
+/** Opaque precomputed tables for one fixed ECDH base point.
+ *
+ *  Created with secp256k1_ecdh_precomp_create and destroyed with
+ *  secp256k1_ecdh_precomp_destroy. The point is assumed public; only the
+ *  scalars fed to secp256k1_ecdh_precomputed are treated as secret.
+ */
+typedef struct secp256k1_ecdh_precomp_struct secp256k1_ecdh_precomp;
+
+/** Precompute multiplication tables for a point that will be multiplied
+ *  repeatedly, e.g. static Diffie-Hellman against the local node key
+ *  Returns: a newly created precomputation object
+ *  Args:    ctx:        pointer to a context object (cannot be NULL)
+ *  In:      point:      a pointer to a secp256k1_pubkey containing an
+ *                       initialized public key
+ */
+SECP256K1_API secp256k1_ecdh_precomp* secp256k1_ecdh_precomp_create(
+  const secp256k1_context* ctx,
+  const secp256k1_pubkey *point
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_WARN_UNUSED_RESULT;
+
+/** Destroy a precomputation object, wiping the tables
+ *  Args:    pre:        the object to destroy (NULL is allowed)
+ */
+SECP256K1_API void secp256k1_ecdh_precomp_destroy(
+  secp256k1_ecdh_precomp *pre
+);
+
+/** Compute an EC Diffie-Hellman secret against a precomputed base point, in
+ *  constant time with respect to the scalar
+ *  Returns: 1: exponentiation was successful
+ *           0: scalar was invalid (zero or overflow)
+ *  Args:    ctx:        pointer to a context object (cannot be NULL)
+ *  Out:     result:     a 32-byte array which will be populated by the secret
+ *  In:      pre:        precomputed tables for the base point (cannot be NULL)
+ *           privkey:    a 32-byte scalar with which to multiply the point
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdh_precomputed(
+  const secp256k1_context* ctx,
+  unsigned char *result,
+  const secp256k1_ecdh_precomp *pre,
+  const unsigned char *privkey
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+/** Compute a batch of EC Diffie-Hellman secrets, sharding the constant-time
+ *  multiplications across a native worker pool
+ *  Returns: 1: all exponentiations were successful
+ *           0: at least one scalar was invalid (zero or overflow), see outcomes
+ *  Args:    ctx:        pointer to a context object (cannot be NULL)
+ *  Out:     results:    n concatenated 32-byte ECDH secrets (cannot be NULL)
+ *           outcomes:   per-pair completion outcome, 1 on success (cannot be NULL)
+ *  In:      points:     n initialized public keys (cannot be NULL)
+ *           scalars:    n concatenated 32-byte scalars to multiply by (cannot be NULL)
+ *           n:          number of pairs in the batch
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdh_batch(
+  const secp256k1_context* ctx,
+  unsigned char *results,
+  const secp256k1_pubkey *points,
+  const unsigned char *scalars,
+  size_t n,
+  int *outcomes
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(6);
+
+/** Compute an EC Diffie-Hellman secret with a caller-chosen output stage
+ *  Like secp256k1_ecdh, but the shared point is handed to hashfp instead of
+ *  being hashed with SHA256. A NULL hashfp selects x-only mode: the raw
+ *  32-byte x coordinate is written to result and the y coordinate is never
+ *  serialized, for callers whose key derivation hashes the secret again
+ *  anyway and would waste the built-in SHA256.
+ *  Returns: 1: exponentiation was successful
+ *           0: scalar was invalid (zero or overflow), or hashfp returned 0
+ *  Args:    ctx:        pointer to a context object (cannot be NULL)
+ *  Out:     result:     a 32-byte array receiving the secret
+ *  In:      pubkey:     a pointer to an initialized public key
+ *           privkey:    a 32-byte scalar with which to multiply the point
+ *           hashfp:     output function, or NULL for the raw x coordinate
+ *           data:       arbitrary data pointer passed through to hashfp
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdh_compute(
+  const secp256k1_context* ctx,
+  unsigned char *result,
+  const secp256k1_pubkey *pubkey,
+  const unsigned char *privkey,
+  secp256k1_ecdh_hash_function hashfp,
+  void *data
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+/** Compute a batch of EC Diffie-Hellman secrets with a caller-chosen output
+ *  stage, sharding across the same worker pool as secp256k1_ecdh_batch. The
+ *  hashfp/data pair applies to every entry of the batch and must be safe to
+ *  call from several threads at once; NULL hashfp selects x-only mode.
+ *  Returns: 1: all entries succeeded
+ *           0: at least one entry failed, see outcomes
+ *  Args:    ctx:        pointer to a context object (cannot be NULL)
+ *  Out:     results:    n concatenated 32-byte secrets (cannot be NULL)
+ *           outcomes:   per-pair completion outcome, 1 on success (cannot be NULL)
+ *  In:      points:     n initialized public keys (cannot be NULL)
+ *           scalars:    n concatenated 32-byte scalars to multiply by (cannot be NULL)
+ *           n:          number of pairs in the batch
+ *           hashfp:     output function, or NULL for the raw x coordinate
+ *           data:       arbitrary data pointer passed through to hashfp
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdh_compute_batch(
+  const secp256k1_context* ctx,
+  unsigned char *results,
+  const secp256k1_pubkey *points,
+  const unsigned char *scalars,
+  size_t n,
+  int *outcomes,
+  secp256k1_ecdh_hash_function hashfp,
+  void *data
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(6);
+
 # ifdef __cplusplus
 }
 # endif
@@ -0,0 +1,87 @@
+#ifndef _SECP256K1_PREALLOCATED_
+# define _SECP256K1_PREALLOCATED_
+
+# include "secp256k1.h"
+
+# ifdef __cplusplus
+extern "C" {
+# endif
+
+/* The functions in this header allow creating and destroying secp256k1
+ * context objects in memory provided by the caller, instead of memory
+ * allocated by the library. All internal state of such a context, including
+ * the multi-megabyte precomputed tables, lives inside the single provided
+ * block, so contexts can be placed in pre-reserved arenas, shared memory
+ * segments, or memory-mapped files, and long-lived processes that create and
+ * destroy many ephemeral contexts do not fragment the heap.
+ *
+ * The memory block must be aligned at least as strictly as malloc'd memory
+ * and must not be written to, moved, or freed by the caller for the lifetime
+ * of the context. Contexts created by these functions must be destroyed with
+ * secp256k1_context_preallocated_destroy (never secp256k1_context_destroy),
+ * after which the caller is again responsible for the memory. */
+
+/** Determine the memory size of a context object created with the given flags.
+ *
+ *  Returns: the required size in bytes of the memory block to pass to
+ *           secp256k1_context_preallocated_create.
+ *  In:      flags: which parts of the context to initialize, as for
+ *                  secp256k1_context_create.
+ */
+SECP256K1_API size_t secp256k1_context_preallocated_size(
+    unsigned int flags
+) SECP256K1_WARN_UNUSED_RESULT;
+
+/** Create a secp256k1 context object in caller-provided memory.
+ *
+ *  Returns: a context object placed at the start of prealloc, or NULL when
+ *           the flags are invalid.
+ *  In:      prealloc: a block of at least
+ *                     secp256k1_context_preallocated_size(flags) bytes
+ *                     (cannot be NULL)
+ *           flags:    which parts of the context to initialize.
+ */
+SECP256K1_API secp256k1_context* secp256k1_context_preallocated_create(
+    void* prealloc,
+    unsigned int flags
+) SECP256K1_ARG_NONNULL(1) SECP256K1_WARN_UNUSED_RESULT;
+
+/** Determine the memory size of a copy of an existing context object.
+ *
+ *  Returns: the required size in bytes of the memory block to pass to
+ *           secp256k1_context_preallocated_clone.
+ *  Args:    ctx: an existing context to copy (cannot be NULL)
+ */
+SECP256K1_API size_t secp256k1_context_preallocated_clone_size(
+    const secp256k1_context* ctx
+) SECP256K1_ARG_NONNULL(1) SECP256K1_WARN_UNUSED_RESULT;
+
+/** Copy a secp256k1 context object into caller-provided memory.
+ *
+ *  Returns: a context object placed at the start of prealloc.
+ *  Args:    ctx:      an existing context to copy (cannot be NULL)
+ *  In:      prealloc: a block of at least
+ *                     secp256k1_context_preallocated_clone_size(ctx) bytes
+ *                     (cannot be NULL)
+ */
+SECP256K1_API secp256k1_context* secp256k1_context_preallocated_clone(
+    const secp256k1_context* ctx,
+    void* prealloc
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_WARN_UNUSED_RESULT;
+
+/** Destroy a secp256k1 context object living in caller-provided memory.
+ *
+ *  Secret state is wiped, but the memory itself is not released; the caller
+ *  may reuse or free it afterwards. The context pointer may not be used
+ *  again.
+ *  Args:   ctx: an existing context to destroy (cannot be NULL)
+ */
+SECP256K1_API void secp256k1_context_preallocated_destroy(
+    secp256k1_context* ctx
+);
+
+# ifdef __cplusplus
+}
+# endif
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef _SECP256K1_SCHNORR_
+# define _SECP256K1_SCHNORR_
+
+# include "secp256k1.h"
+
+# ifdef __cplusplus
+extern "C" {
+# endif
+
+/** Create a signature using a custom EC-Schnorr-SHA256 construction. It
+ *  produces non-malleable 64-byte signatures which support batch validation.
+ *
+ *  Returns: 1: signature created
+ *           0: the nonce generation function failed, or the private key was
+ *              invalid.
+ *  Args:    ctx:    pointer to a context object, initialized for signing
+ *                   (cannot be NULL)
+ *  Out:     sig64:  pointer to a 64-byte array where the signature will be
+ *                   placed (cannot be NULL)
+ *  In:      msg32:  the 32-byte message hash being signed (cannot be NULL)
+ *           seckey: pointer to a 32-byte secret key (cannot be NULL)
+ *           noncefp:pointer to a nonce generation function. If NULL,
+ *                   secp256k1_nonce_function_default is used
+ *           ndata:  pointer to arbitrary data used by the nonce generation
+ *                   function (can be NULL)
+ */
+SECP256K1_API int secp256k1_schnorr_sign(
+  const secp256k1_context* ctx,
+  unsigned char *sig64,
+  const unsigned char *msg32,
+  const unsigned char *seckey,
+  secp256k1_nonce_function noncefp,
+  const void *ndata
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+/** Verify a signature created by secp256k1_schnorr_sign.
+ *
+ *  Returns: 1: correct signature
+ *           0: incorrect signature
+ *  Args:    ctx:    a secp256k1 context object, initialized for verification
+ *  In:      sig64:  the 64-byte signature being verified (cannot be NULL)
+ *           msg32:  the 32-byte message hash being verified (cannot be NULL)
+ *           pubkey: the public key to verify with (cannot be NULL)
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_schnorr_verify(
+  const secp256k1_context* ctx,
+  const unsigned char *sig64,
+  const unsigned char *msg32,
+  const secp256k1_pubkey *pubkey
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+/** Verify a batch of Schnorr signatures with a single multi-scalar
+ *  multiplication.
+ *
+ *  The batch is checked as one random linear combination of the individual
+ *  verification equations, with the weights derived from a hash of the whole
+ *  batch. A full multi-scalar multiply over all signatures brings the
+ *  amortized per-signature cost down towards one group addition, at the price
+ *  of an all-or-nothing answer: when the batch fails, the caller has to fall
+ *  back to individual verification to find the culprits.
+ *
+ *  Returns: 1: all n signatures are correct
+ *           0: at least one signature is incorrect, or a pubkey was invalid
+ *  Args:    ctx:    a secp256k1 context object, initialized for verification
+ *  In:      sig64s: n concatenated 64-byte signatures (cannot be NULL if n > 0)
+ *           msg32s: n concatenated 32-byte message hashes (cannot be NULL if
+ *                   n > 0)
+ *           pubkeys:array of n public keys to verify with (cannot be NULL if
+ *                   n > 0)
+ *           n:      number of signatures in the batch
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_schnorr_verify_batch(
+  const secp256k1_context* ctx,
+  const unsigned char *sig64s,
+  const unsigned char *msg32s,
+  const secp256k1_pubkey *pubkeys,
+  size_t n
+) SECP256K1_ARG_NONNULL(1);
+
+# ifdef __cplusplus
+}
+# endif
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef _SECP256K1_STATS_
+# define _SECP256K1_STATS_
+
+# include "secp256k1.h"
+
+# include <stdint.h>
+
+# ifdef __cplusplus
+extern "C" {
+# endif
+
+/** Operation indices into the count/total_ns/hist arrays below. */
+# define SECP256K1_CONTEXT_STATS_SIGN 0
+# define SECP256K1_CONTEXT_STATS_VERIFY 1
+# define SECP256K1_CONTEXT_STATS_RECOVER 2
+# define SECP256K1_CONTEXT_STATS_OPS 3
+
+/** Number of latency histogram buckets; bucket b counts operations whose
+ *  per-operation latency was in [2^b, 2^(b+1)) nanoseconds, with the last
+ *  bucket absorbing everything slower. */
+# define SECP256K1_CONTEXT_STATS_BUCKETS 26
+
+/** A snapshot of the per-context operation counters.
+ *
+ *  The counters are only maintained when the library is compiled with
+ *  USE_CONTEXT_STATS (which requires C11 atomics); without it every snapshot
+ *  reads as zero. Latencies are sampled with the raw cycle counter (rdtsc,
+ *  cntvct_el0) where one exists and converted to nanoseconds against a
+ *  calibrated tick rate, and the counters are striped per thread and summed
+ *  at snapshot time, so the accounting is cheap enough to leave on against
+ *  production traffic. Updates on the hot paths use relaxed atomics, so a
+ *  snapshot taken while other threads are operating on the context is
+ *  internally consistent per counter but not across counters.
+ */
+typedef struct {
+    /* Completed operations per op index, including batch items. */
+    uint64_t count[SECP256K1_CONTEXT_STATS_OPS];
+    /* Total wall-clock nanoseconds spent per op index. */
+    uint64_t total_ns[SECP256K1_CONTEXT_STATS_OPS];
+    /* Log2 latency histogram per op index; batch items are booked at the
+     * average per-item latency of their batch. */
+    uint64_t hist[SECP256K1_CONTEXT_STATS_OPS][SECP256K1_CONTEXT_STATS_BUCKETS];
+    /* Number of batch entry-point calls and the items they carried; the
+     * ratio is the average batch occupancy. */
+    uint64_t batch_calls;
+    uint64_t batch_items;
+    /* Field multiplications and squarings performed per op index, for
+     * auditing formula changes against their theoretical operation counts.
+     * Only maintained when additionally compiled with USE_OPCOUNT_STATS
+     * (an audit mode, not meant for production builds); without it these
+     * read as zero. Batch entry points whose inner loop runs on the worker
+     * pool book each item's operations from the worker that performed it. */
+    uint64_t fe_mul[SECP256K1_CONTEXT_STATS_OPS];
+    uint64_t fe_sqr[SECP256K1_CONTEXT_STATS_OPS];
+} secp256k1_context_stats;
+
+/** Copy a snapshot of the context's operation counters into *stats.
+ *
+ *  Args: ctx:   a secp256k1 context object.
+ *  Out:  stats: the snapshot destination (cannot be NULL).
+ */
+SECP256K1_API void secp256k1_context_stats_get(
+    const secp256k1_context* ctx,
+    secp256k1_context_stats *stats
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+/** Reset all of the context's operation counters to zero. */
+SECP256K1_API void secp256k1_context_stats_reset(
+    secp256k1_context* ctx
+) SECP256K1_ARG_NONNULL(1);
+
+# ifdef __cplusplus
+}
+# endif
+
+#endif
@@ -30,6 +30,156 @@ void print_number(double x) {
     printf("%.*f", c, x);
 }
 
+/* Optional hardware counter sampling for the JSON harness. On Linux the
+ * counters come from perf_event_open; elsewhere, or when the kernel refuses
+ * the events (perf_event_paranoid, containers), they are reported as null. */
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <string.h>
+
+typedef struct {
+    int fd_cycles;
+    int fd_cache_misses;
+} bench_perf_t;
+
+static int bench_perf_open_one(unsigned long long config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void bench_perf_open(bench_perf_t *perf) {
+    perf->fd_cycles = bench_perf_open_one(PERF_COUNT_HW_CPU_CYCLES);
+    perf->fd_cache_misses = bench_perf_open_one(PERF_COUNT_HW_CACHE_MISSES);
+}
+
+static void bench_perf_start(bench_perf_t *perf) {
+    if (perf->fd_cycles >= 0) {
+        ioctl(perf->fd_cycles, PERF_EVENT_IOC_RESET, 0);
+        ioctl(perf->fd_cycles, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    if (perf->fd_cache_misses >= 0) {
+        ioctl(perf->fd_cache_misses, PERF_EVENT_IOC_RESET, 0);
+        ioctl(perf->fd_cache_misses, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+static long long bench_perf_stop_one(int fd) {
+    long long value;
+    if (fd < 0) {
+        return -1;
+    }
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fd, &value, sizeof(value)) != sizeof(value)) {
+        return -1;
+    }
+    return value;
+}
+
+static void bench_perf_stop(bench_perf_t *perf, long long *cycles, long long *cache_misses) {
+    *cycles = bench_perf_stop_one(perf->fd_cycles);
+    *cache_misses = bench_perf_stop_one(perf->fd_cache_misses);
+}
+
+static void bench_perf_close(bench_perf_t *perf) {
+    if (perf->fd_cycles >= 0) {
+        close(perf->fd_cycles);
+    }
+    if (perf->fd_cache_misses >= 0) {
+        close(perf->fd_cache_misses);
+    }
+}
+#else
+typedef struct { int unused; } bench_perf_t;
+static void bench_perf_open(bench_perf_t *perf) { (void)perf; }
+static void bench_perf_start(bench_perf_t *perf) { (void)perf; }
+static void bench_perf_stop(bench_perf_t *perf, long long *cycles, long long *cache_misses) {
+    (void)perf;
+    *cycles = -1;
+    *cache_misses = -1;
+}
+static void bench_perf_close(bench_perf_t *perf) { (void)perf; }
+#endif
+
+static int bench_json_emitted = 0;
+
+void bench_json_begin(void) {
+    printf("[\n");
+    bench_json_emitted = 0;
+}
+
+void bench_json_end(void) {
+    printf("\n]\n");
+}
+
+/* Like run_benchmark, but emits one JSON object per benchmark instead of
+ * free-form text, including hardware counters per iteration when available.
+ * Counters are sampled around the fastest run only, so they describe the
+ * same execution the min time does. */
+void run_benchmark_json(char *name, void (*benchmark)(void*), void (*setup)(void*), void (*teardown)(void*), void* data, int count, int iter) {
+    int i;
+    double min = HUGE_VAL;
+    double sum = 0.0;
+    double max = 0.0;
+    long long cycles = -1;
+    long long cache_misses = -1;
+    bench_perf_t perf;
+
+    bench_perf_open(&perf);
+    for (i = 0; i < count; i++) {
+        double begin, total;
+        long long run_cycles, run_cache_misses;
+        if (setup != NULL) {
+            setup(data);
+        }
+        bench_perf_start(&perf);
+        begin = gettimedouble();
+        benchmark(data);
+        total = gettimedouble() - begin;
+        bench_perf_stop(&perf, &run_cycles, &run_cache_misses);
+        if (teardown != NULL) {
+            teardown(data);
+        }
+        if (total < min) {
+            min = total;
+            cycles = run_cycles;
+            cache_misses = run_cache_misses;
+        }
+        if (total > max) {
+            max = total;
+        }
+        sum += total;
+    }
+    bench_perf_close(&perf);
+
+    if (bench_json_emitted) {
+        printf(",\n");
+    }
+    bench_json_emitted = 1;
+    printf("  {\"name\": \"%s\", \"iter\": %d, \"count\": %d, ", name, iter, count);
+    printf("\"min_us\": %.6f, \"avg_us\": %.6f, \"max_us\": %.6f, ",
+        min * 1000000.0 / iter, (sum / count) * 1000000.0 / iter, max * 1000000.0 / iter);
+    if (cycles >= 0) {
+        printf("\"cycles_per_iter\": %.2f, ", (double)cycles / iter);
+    } else {
+        printf("\"cycles_per_iter\": null, ");
+    }
+    if (cache_misses >= 0) {
+        printf("\"cache_misses_per_iter\": %.2f}", (double)cache_misses / iter);
+    } else {
+        printf("\"cache_misses_per_iter\": null}");
+    }
+}
+
 void run_benchmark(char *name, void (*benchmark)(void*), void (*setup)(void*), void (*teardown)(void*), void* data, int count, int iter) {
     int i;
     double min = HUGE_VAL;
@@ -0,0 +1,393 @@
+/**********************************************************************
+ * Copyright (c) 2017 The go-ethereumai Authors                       *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+/* Unified benchmark harness. Runs the internal kernels (field, scalar,
+ * group, ecmult) and the full public operations (sign, verify, recover,
+ * ecdh) in one binary and emits a machine-readable JSON array, with
+ * per-kernel hardware counters where the kernel allows sampling them.
+ * Rollout gates diff this output instead of scraping the text benches. */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "include/secp256k1.h"
+
+#include "util.h"
+#include "hash_impl.h"
+#include "num_impl.h"
+#include "field_impl.h"
+#include "group_impl.h"
+#include "scalar_impl.h"
+#include "ecmult_const_impl.h"
+#include "ecmult_impl.h"
+#include "bench.h"
+#include "secp256k1.c"
+
+#ifdef ENABLE_MODULE_RECOVERY
+#include "include/secp256k1_recovery.h"
+#endif
+#ifdef ENABLE_MODULE_ECDH
+#include "include/secp256k1_ecdh.h"
+#endif
+
+typedef struct {
+    /* internal kernels */
+    secp256k1_scalar scalar_x, scalar_y;
+    secp256k1_fe fe_x, fe_y;
+    secp256k1_ge ge_x, ge_y;
+    secp256k1_gej gej_x, gej_y;
+    int wnaf[256];
+    /* full operations */
+    secp256k1_context *ctx;
+    unsigned char msg[32];
+    unsigned char key[32];
+    unsigned char sig[72];
+    unsigned char pubkey[33];
+    size_t siglen;
+    size_t pubkeylen;
+} bench_all_t;
+
+static void bench_all_setup(void* arg) {
+    bench_all_t *data = (bench_all_t*)arg;
+    int i;
+
+    static const unsigned char init_x[32] = {
+        0x02, 0x03, 0x05, 0x07, 0x0b, 0x0d, 0x11, 0x13,
+        0x17, 0x1d, 0x1f, 0x25, 0x29, 0x2b, 0x2f, 0x35,
+        0x3b, 0x3d, 0x43, 0x47, 0x49, 0x4f, 0x53, 0x59,
+        0x61, 0x65, 0x67, 0x6b, 0x6d, 0x71, 0x7f, 0x83
+    };
+
+    static const unsigned char init_y[32] = {
+        0x82, 0x83, 0x85, 0x87, 0x8b, 0x8d, 0x81, 0x83,
+        0x97, 0xad, 0xaf, 0xb5, 0xb9, 0xbb, 0xbf, 0xc5,
+        0xdb, 0xdd, 0xe3, 0xe7, 0xe9, 0xef, 0xf3, 0xf9,
+        0x11, 0x15, 0x17, 0x1b, 0x1d, 0xb1, 0xbf, 0xd3
+    };
+
+    secp256k1_scalar_set_b32(&data->scalar_x, init_x, NULL);
+    secp256k1_scalar_set_b32(&data->scalar_y, init_y, NULL);
+    secp256k1_fe_set_b32(&data->fe_x, init_x);
+    secp256k1_fe_set_b32(&data->fe_y, init_y);
+    CHECK(secp256k1_ge_set_xo_var(&data->ge_x, &data->fe_x, 0));
+    CHECK(secp256k1_ge_set_xo_var(&data->ge_y, &data->fe_y, 1));
+    secp256k1_gej_set_ge(&data->gej_x, &data->ge_x);
+    secp256k1_gej_set_ge(&data->gej_y, &data->ge_y);
+
+    for (i = 0; i < 32; i++) {
+        data->msg[i] = i + 1;
+        data->key[i] = i + 65;
+    }
+}
+
+/* --- internal kernels, loop bodies matching bench_internal.c --- */
+
+static void bench_scalar_add(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 2000000; i++) {
+        secp256k1_scalar_add(&data->scalar_x, &data->scalar_x, &data->scalar_y);
+    }
+}
+
+static void bench_scalar_mul(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 200000; i++) {
+        secp256k1_scalar_mul(&data->scalar_x, &data->scalar_x, &data->scalar_y);
+    }
+}
+
+static void bench_scalar_inverse(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 2000; i++) {
+        secp256k1_scalar_inverse(&data->scalar_x, &data->scalar_x);
+        secp256k1_scalar_add(&data->scalar_x, &data->scalar_x, &data->scalar_y);
+    }
+}
+
+static void bench_field_mul(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 200000; i++) {
+        secp256k1_fe_mul(&data->fe_x, &data->fe_x, &data->fe_y);
+    }
+}
+
+static void bench_field_sqr(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 200000; i++) {
+        secp256k1_fe_sqr(&data->fe_x, &data->fe_x);
+    }
+}
+
+static void bench_field_inverse(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 20000; i++) {
+        secp256k1_fe_inv(&data->fe_x, &data->fe_x);
+        secp256k1_fe_add(&data->fe_x, &data->fe_y);
+    }
+}
+
+static void bench_field_sqrt(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 20000; i++) {
+        secp256k1_fe_sqrt(&data->fe_x, &data->fe_x);
+        secp256k1_fe_add(&data->fe_x, &data->fe_y);
+    }
+}
+
+static void bench_group_double_var(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 200000; i++) {
+        secp256k1_gej_double_var(&data->gej_x, &data->gej_x, NULL);
+    }
+}
+
+static void bench_group_add_var(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 200000; i++) {
+        secp256k1_gej_add_var(&data->gej_x, &data->gej_x, &data->gej_y, NULL);
+    }
+}
+
+static void bench_group_add_affine_var(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 200000; i++) {
+        secp256k1_gej_add_ge_var(&data->gej_x, &data->gej_x, &data->ge_y, NULL);
+    }
+}
+
+static void bench_wnaf_const(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 20000; i++) {
+        secp256k1_wnaf_const(data->wnaf, data->scalar_x, WINDOW_A);
+        secp256k1_scalar_add(&data->scalar_x, &data->scalar_x, &data->scalar_y);
+    }
+}
+
+static void bench_ecmult_const(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 2000; i++) {
+        secp256k1_ecmult_const(&data->gej_x, &data->ge_x, &data->scalar_x);
+        secp256k1_scalar_add(&data->scalar_x, &data->scalar_x, &data->scalar_y);
+    }
+}
+
+static void bench_ecmult_gen(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 2000; i++) {
+        secp256k1_ecmult_gen(&data->ctx->ecmult_gen_ctx, &data->gej_x, &data->scalar_x);
+        secp256k1_scalar_add(&data->scalar_x, &data->scalar_x, &data->scalar_y);
+    }
+}
+
+static void bench_ecmult(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 2000; i++) {
+        secp256k1_ecmult(&data->ctx->ecmult_ctx, &data->gej_x, &data->gej_x, &data->scalar_x, &data->scalar_y);
+        secp256k1_scalar_add(&data->scalar_x, &data->scalar_x, &data->scalar_y);
+    }
+}
+
+static void bench_sha256(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+    secp256k1_sha256_t sha;
+
+    for (i = 0; i < 20000; i++) {
+        secp256k1_sha256_initialize(&sha);
+        secp256k1_sha256_write(&sha, data->msg, 32);
+        secp256k1_sha256_finalize(&sha, data->msg);
+    }
+}
+
+/* --- full operations, loop bodies matching the standalone benches --- */
+
+static void bench_ecdsa_sign(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    unsigned char sig[74];
+    for (i = 0; i < 2000; i++) {
+        size_t siglen = 74;
+        int j;
+        secp256k1_ecdsa_signature signature;
+        CHECK(secp256k1_ecdsa_sign(data->ctx, &signature, data->msg, data->key, NULL, NULL));
+        CHECK(secp256k1_ecdsa_signature_serialize_der(data->ctx, sig, &siglen, &signature));
+        for (j = 0; j < 32; j++) {
+            data->msg[j] = sig[j];
+            data->key[j] = sig[j + 32];
+        }
+    }
+}
+
+static void bench_ecdsa_verify_setup(void* arg) {
+    bench_all_t *data = (bench_all_t*)arg;
+    secp256k1_ecdsa_signature sig;
+    secp256k1_pubkey pubkey;
+
+    bench_all_setup(arg);
+    data->siglen = 72;
+    CHECK(secp256k1_ecdsa_sign(data->ctx, &sig, data->msg, data->key, NULL, NULL));
+    CHECK(secp256k1_ecdsa_signature_serialize_der(data->ctx, data->sig, &data->siglen, &sig));
+    CHECK(secp256k1_ec_pubkey_create(data->ctx, &pubkey, data->key));
+    data->pubkeylen = 33;
+    CHECK(secp256k1_ec_pubkey_serialize(data->ctx, data->pubkey, &data->pubkeylen, &pubkey, SECP256K1_EC_COMPRESSED) == 1);
+}
+
+static void bench_ecdsa_verify(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 2000; i++) {
+        secp256k1_pubkey pubkey;
+        secp256k1_ecdsa_signature sig;
+        CHECK(secp256k1_ec_pubkey_parse(data->ctx, &pubkey, data->pubkey, data->pubkeylen) == 1);
+        CHECK(secp256k1_ecdsa_signature_parse_der(data->ctx, &sig, data->sig, data->siglen) == 1);
+        CHECK(secp256k1_ecdsa_verify(data->ctx, &sig, data->msg, &pubkey) == 1);
+    }
+}
+
+#ifdef ENABLE_MODULE_RECOVERY
+static void bench_ecdsa_recover_setup(void* arg) {
+    bench_all_t *data = (bench_all_t*)arg;
+    secp256k1_ecdsa_recoverable_signature sig;
+    int recid;
+
+    bench_all_setup(arg);
+    CHECK(secp256k1_ecdsa_sign_recoverable(data->ctx, &sig, data->msg, data->key, NULL, NULL));
+    CHECK(secp256k1_ecdsa_recoverable_signature_serialize_compact(data->ctx, data->sig, &recid, &sig));
+    data->sig[64] = (unsigned char)recid;
+}
+
+static void bench_ecdsa_recover(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+
+    for (i = 0; i < 2000; i++) {
+        secp256k1_ecdsa_recoverable_signature sig;
+        secp256k1_pubkey pubkey;
+        CHECK(secp256k1_ecdsa_recoverable_signature_parse_compact(data->ctx, &sig, data->sig, (int)data->sig[64]));
+        CHECK(secp256k1_ecdsa_recover(data->ctx, &pubkey, &sig, data->msg) == 1);
+    }
+}
+#endif
+
+#ifdef ENABLE_MODULE_ECDH
+static void bench_ecdh_op_setup(void* arg) {
+    bench_all_t *data = (bench_all_t*)arg;
+    secp256k1_pubkey pubkey;
+
+    bench_all_setup(arg);
+    CHECK(secp256k1_ec_pubkey_create(data->ctx, &pubkey, data->key));
+    data->pubkeylen = 33;
+    CHECK(secp256k1_ec_pubkey_serialize(data->ctx, data->pubkey, &data->pubkeylen, &pubkey, SECP256K1_EC_COMPRESSED) == 1);
+}
+
+static void bench_ecdh_op(void* arg) {
+    int i;
+    bench_all_t *data = (bench_all_t*)arg;
+    secp256k1_pubkey pubkey;
+    unsigned char res[32];
+
+    CHECK(secp256k1_ec_pubkey_parse(data->ctx, &pubkey, data->pubkey, data->pubkeylen) == 1);
+    for (i = 0; i < 2000; i++) {
+        CHECK(secp256k1_ecdh(data->ctx, res, &pubkey, data->msg) == 1);
+    }
+}
+#endif
+
+int have_flag(int argc, char** argv, char *flag) {
+    char** argm = argv + argc;
+    argv++;
+    if (argv == argm) {
+        return 1;
+    }
+    while (argv != NULL && argv != argm) {
+        if (strcmp(*argv, flag) == 0) {
+            return 1;
+        }
+        argv++;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    bench_all_t data;
+
+    data.ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+
+    bench_json_begin();
+
+    if (have_flag(argc, argv, "scalar")) {
+        run_benchmark_json("scalar_add", bench_scalar_add, bench_all_setup, NULL, &data, 10, 2000000);
+        run_benchmark_json("scalar_mul", bench_scalar_mul, bench_all_setup, NULL, &data, 10, 200000);
+        run_benchmark_json("scalar_inverse", bench_scalar_inverse, bench_all_setup, NULL, &data, 10, 2000);
+    }
+    if (have_flag(argc, argv, "field")) {
+        run_benchmark_json("field_mul", bench_field_mul, bench_all_setup, NULL, &data, 10, 200000);
+        run_benchmark_json("field_sqr", bench_field_sqr, bench_all_setup, NULL, &data, 10, 200000);
+        run_benchmark_json("field_inverse", bench_field_inverse, bench_all_setup, NULL, &data, 10, 20000);
+        run_benchmark_json("field_sqrt", bench_field_sqrt, bench_all_setup, NULL, &data, 10, 20000);
+    }
+    if (have_flag(argc, argv, "group")) {
+        run_benchmark_json("group_double_var", bench_group_double_var, bench_all_setup, NULL, &data, 10, 200000);
+        run_benchmark_json("group_add_var", bench_group_add_var, bench_all_setup, NULL, &data, 10, 200000);
+        run_benchmark_json("group_add_affine_var", bench_group_add_affine_var, bench_all_setup, NULL, &data, 10, 200000);
+    }
+    if (have_flag(argc, argv, "ecmult")) {
+        run_benchmark_json("wnaf_const", bench_wnaf_const, bench_all_setup, NULL, &data, 10, 20000);
+        run_benchmark_json("ecmult_const", bench_ecmult_const, bench_all_setup, NULL, &data, 10, 2000);
+        run_benchmark_json("ecmult_gen", bench_ecmult_gen, bench_all_setup, NULL, &data, 10, 2000);
+        run_benchmark_json("ecmult", bench_ecmult, bench_all_setup, NULL, &data, 10, 2000);
+    }
+    if (have_flag(argc, argv, "hash")) {
+        run_benchmark_json("sha256", bench_sha256, bench_all_setup, NULL, &data, 10, 20000);
+    }
+    if (have_flag(argc, argv, "ecdsa")) {
+        run_benchmark_json("ecdsa_sign", bench_ecdsa_sign, bench_all_setup, NULL, &data, 10, 2000);
+        run_benchmark_json("ecdsa_verify", bench_ecdsa_verify, bench_ecdsa_verify_setup, NULL, &data, 10, 2000);
+#ifdef ENABLE_MODULE_RECOVERY
+        run_benchmark_json("ecdsa_recover", bench_ecdsa_recover, bench_ecdsa_recover_setup, NULL, &data, 10, 2000);
+#endif
+    }
+#ifdef ENABLE_MODULE_ECDH
+    if (have_flag(argc, argv, "ecdh")) {
+        run_benchmark_json("ecdh", bench_ecdh_op, bench_ecdh_op_setup, NULL, &data, 10, 2000);
+    }
+#endif
+
+    bench_json_end();
+
+    secp256k1_context_destroy(data.ctx);
+    return 0;
+}
@@ -92,6 +92,59 @@ void bench_scalar_mul(void* arg) {
     }
 }
 
+#ifdef USE_SCALAR_4X64
+void bench_scalar_reduce_512(void* arg) {
+    int i;
+    bench_inv_t *data = (bench_inv_t*)arg;
+    uint64_t l[8];
+
+    secp256k1_scalar_mul_512(l, &data->scalar_x, &data->scalar_y);
+    for (i = 0; i < 200000; i++) {
+        secp256k1_scalar_reduce_512(&data->scalar_x, l);
+        l[0] ^= data->scalar_x.d[0]; /* feedback keeps the reductions live */
+    }
+}
+#else
+void bench_scalar_reduce_512(void* arg) {
+    int i;
+    bench_inv_t *data = (bench_inv_t*)arg;
+    uint32_t l[16];
+
+    secp256k1_scalar_mul_512(l, &data->scalar_x, &data->scalar_y);
+    for (i = 0; i < 200000; i++) {
+        secp256k1_scalar_reduce_512(&data->scalar_x, l);
+        l[0] ^= data->scalar_x.d[0]; /* feedback keeps the reductions live */
+    }
+}
+#endif
+
+#ifdef USE_SCALAR_8X32_NEON
+/* The two 8x32 expansions individually, bypassing the dispatch pointers, so
+ * the probe's verdict on a given core can be checked against the real
+ * difference. */
+void bench_scalar_mul_512_generic(void* arg) {
+    int i;
+    bench_inv_t *data = (bench_inv_t*)arg;
+    uint32_t l[16];
+
+    for (i = 0; i < 200000; i++) {
+        secp256k1_scalar_mul_512_generic(l, &data->scalar_x, &data->scalar_y);
+        secp256k1_scalar_reduce_512_generic(&data->scalar_x, l);
+    }
+}
+
+void bench_scalar_mul_512_neon(void* arg) {
+    int i;
+    bench_inv_t *data = (bench_inv_t*)arg;
+    uint32_t l[16];
+
+    for (i = 0; i < 200000; i++) {
+        secp256k1_scalar_mul_512_neon(l, &data->scalar_x, &data->scalar_y);
+        secp256k1_scalar_reduce_512_neon(&data->scalar_x, l);
+    }
+}
+#endif
+
 #ifdef USE_ENDOMORPHISM
 void bench_scalar_split(void* arg) {
     int i;
@@ -125,6 +178,18 @@ void bench_scalar_inverse_var(void* arg) {
     }
 }
 
+#ifdef SECP256K1_HAVE_SAFEGCD
+void bench_scalar_inverse_fermat(void* arg) {
+    int i;
+    bench_inv_t *data = (bench_inv_t*)arg;
+
+    for (i = 0; i < 2000; i++) {
+        secp256k1_scalar_inverse_fermat(&data->scalar_x, &data->scalar_x);
+        secp256k1_scalar_add(&data->scalar_x, &data->scalar_x, &data->scalar_y);
+    }
+}
+#endif
+
 void bench_field_normalize(void* arg) {
     int i;
     bench_inv_t *data = (bench_inv_t*)arg;
@@ -181,6 +246,16 @@ void bench_field_inverse_var(void* arg) {
     }
 }
 
+void bench_field_inverse_fermat(void* arg) {
+    int i;
+    bench_inv_t *data = (bench_inv_t*)arg;
+
+    for (i = 0; i < 20000; i++) {
+        secp256k1_fe_inv_fermat(&data->fe_x, &data->fe_x);
+        secp256k1_fe_add(&data->fe_x, &data->fe_y);
+    }
+}
+
 void bench_field_sqrt(void* arg) {
     int i;
     bench_inv_t *data = (bench_inv_t*)arg;
@@ -191,6 +266,29 @@ void bench_field_sqrt(void* arg) {
     }
 }
 
+/* The raw generated chains from field_chain_impl.h, timed per chain so a
+ * regenerated chain's cost is visible in isolation (field_inverse_fermat
+ * and field_sqrt add dispatch and the root check on top). */
+void bench_field_inverse_chain(void* arg) {
+    int i;
+    bench_inv_t *data = (bench_inv_t*)arg;
+
+    for (i = 0; i < 20000; i++) {
+        secp256k1_fe_inv_chain(&data->fe_x, &data->fe_x);
+        secp256k1_fe_add(&data->fe_x, &data->fe_y);
+    }
+}
+
+void bench_field_sqrt_chain(void* arg) {
+    int i;
+    bench_inv_t *data = (bench_inv_t*)arg;
+
+    for (i = 0; i < 20000; i++) {
+        secp256k1_fe_sqrt_chain(&data->fe_x, &data->fe_x);
+        secp256k1_fe_add(&data->fe_x, &data->fe_y);
+    }
+}
+
 void bench_group_double_var(void* arg) {
     int i;
     bench_inv_t *data = (bench_inv_t*)arg;
@@ -345,11 +443,19 @@ int main(int argc, char **argv) {
     if (have_flag(argc, argv, "scalar") || have_flag(argc, argv, "negate")) run_benchmark("scalar_negate", bench_scalar_negate, bench_setup, NULL, &data, 10, 2000000);
     if (have_flag(argc, argv, "scalar") || have_flag(argc, argv, "sqr")) run_benchmark("scalar_sqr", bench_scalar_sqr, bench_setup, NULL, &data, 10, 200000);
     if (have_flag(argc, argv, "scalar") || have_flag(argc, argv, "mul")) run_benchmark("scalar_mul", bench_scalar_mul, bench_setup, NULL, &data, 10, 200000);
+    if (have_flag(argc, argv, "scalar") || have_flag(argc, argv, "reduce")) run_benchmark("scalar_reduce_512", bench_scalar_reduce_512, bench_setup, NULL, &data, 10, 200000);
+#ifdef USE_SCALAR_8X32_NEON
+    if (have_flag(argc, argv, "scalar") || have_flag(argc, argv, "mul")) run_benchmark("scalar_mul_512_generic", bench_scalar_mul_512_generic, bench_setup, NULL, &data, 10, 200000);
+    if ((have_flag(argc, argv, "scalar") || have_flag(argc, argv, "mul")) && (secp256k1_cpu_features() & SECP256K1_CPU_NEON)) run_benchmark("scalar_mul_512_neon", bench_scalar_mul_512_neon, bench_setup, NULL, &data, 10, 200000);
+#endif
 #ifdef USE_ENDOMORPHISM
     if (have_flag(argc, argv, "scalar") || have_flag(argc, argv, "split")) run_benchmark("scalar_split", bench_scalar_split, bench_setup, NULL, &data, 10, 20000);
 #endif
     if (have_flag(argc, argv, "scalar") || have_flag(argc, argv, "inverse")) run_benchmark("scalar_inverse", bench_scalar_inverse, bench_setup, NULL, &data, 10, 2000);
     if (have_flag(argc, argv, "scalar") || have_flag(argc, argv, "inverse")) run_benchmark("scalar_inverse_var", bench_scalar_inverse_var, bench_setup, NULL, &data, 10, 2000);
+#ifdef SECP256K1_HAVE_SAFEGCD
+    if (have_flag(argc, argv, "scalar") || have_flag(argc, argv, "inverse")) run_benchmark("scalar_inverse_fermat", bench_scalar_inverse_fermat, bench_setup, NULL, &data, 10, 2000);
+#endif
 
     if (have_flag(argc, argv, "field") || have_flag(argc, argv, "normalize")) run_benchmark("field_normalize", bench_field_normalize, bench_setup, NULL, &data, 10, 2000000);
     if (have_flag(argc, argv, "field") || have_flag(argc, argv, "normalize")) run_benchmark("field_normalize_weak", bench_field_normalize_weak, bench_setup, NULL, &data, 10, 2000000);
@@ -357,7 +463,10 @@ int main(int argc, char **argv) {
     if (have_flag(argc, argv, "field") || have_flag(argc, argv, "mul")) run_benchmark("field_mul", bench_field_mul, bench_setup, NULL, &data, 10, 200000);
     if (have_flag(argc, argv, "field") || have_flag(argc, argv, "inverse")) run_benchmark("field_inverse", bench_field_inverse, bench_setup, NULL, &data, 10, 20000);
     if (have_flag(argc, argv, "field") || have_flag(argc, argv, "inverse")) run_benchmark("field_inverse_var", bench_field_inverse_var, bench_setup, NULL, &data, 10, 20000);
+    if (have_flag(argc, argv, "field") || have_flag(argc, argv, "inverse")) run_benchmark("field_inverse_fermat", bench_field_inverse_fermat, bench_setup, NULL, &data, 10, 20000);
     if (have_flag(argc, argv, "field") || have_flag(argc, argv, "sqrt")) run_benchmark("field_sqrt", bench_field_sqrt, bench_setup, NULL, &data, 10, 20000);
+    if (have_flag(argc, argv, "field") || have_flag(argc, argv, "inverse")) run_benchmark("field_inverse_chain", bench_field_inverse_chain, bench_setup, NULL, &data, 10, 20000);
+    if (have_flag(argc, argv, "field") || have_flag(argc, argv, "sqrt")) run_benchmark("field_sqrt_chain", bench_field_sqrt_chain, bench_setup, NULL, &data, 10, 20000);
 
     if (have_flag(argc, argv, "group") || have_flag(argc, argv, "double")) run_benchmark("group_double_var", bench_group_double_var, bench_setup, NULL, &data, 10, 200000);
     if (have_flag(argc, argv, "group") || have_flag(argc, argv, "add")) run_benchmark("group_add_var", bench_group_add_var, bench_setup, NULL, &data, 10, 200000);
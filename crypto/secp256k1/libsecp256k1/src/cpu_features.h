@@ -0,0 +1,88 @@
+/**********************************************************************
+ * Copyright (c) 2017 The go-ethereumai Authors                       *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_CPU_FEATURES_H_
+#define _SECP256K1_CPU_FEATURES_H_
+
+#include <stdint.h>
+
+/* Central place for runtime CPU feature detection, so every dispatched
+ * kernel family (field, and future AVX2 batch variants) keys off one cached
+ * query (CPUID on x86_64, ELF HWCAP on 32-bit ARM) instead of probing on
+ * its own. The field representation itself
+ * stays a compile-time choice since it fixes the secp256k1_fe layout; runtime
+ * dispatch selects between kernels within a representation. */
+
+#define SECP256K1_CPU_BMI2  (1u << 0)
+#define SECP256K1_CPU_ADX   (1u << 1)
+#define SECP256K1_CPU_AVX2  (1u << 2)
+#define SECP256K1_CPU_SHANI (1u << 3)
+#define SECP256K1_CPU_NEON  (1u << 4)
+
+#if defined(__x86_64__) && defined(__GNUC__)
+
+#include <cpuid.h>
+
+static uint32_t secp256k1_cpu_features(void) {
+    /* Benign race: concurrent first callers compute identical values. */
+    static volatile uint32_t cached = 0;
+    uint32_t flags;
+    unsigned int eax, ebx, ecx, edx;
+    if ((flags = cached) != 0) {
+        return flags & ~(1u << 31);
+    }
+    flags = 1u << 31; /* mark as computed even when no feature is present */
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        if (ebx & (1u << 5)) {
+            flags |= SECP256K1_CPU_AVX2;
+        }
+        if (ebx & (1u << 8)) {
+            flags |= SECP256K1_CPU_BMI2;
+        }
+        if (ebx & (1u << 19)) {
+            flags |= SECP256K1_CPU_ADX;
+        }
+        if (ebx & (1u << 29)) {
+            flags |= SECP256K1_CPU_SHANI;
+        }
+    }
+    cached = flags;
+    return flags & ~(1u << 31);
+}
+
+#elif defined(__arm__) && defined(__linux__) && defined(__GNUC__)
+
+#include <sys/auxv.h>
+
+/* Old libc headers may predate the constant; the kernel ABI value is fixed. */
+#ifndef HWCAP_NEON
+#define HWCAP_NEON (1 << 12)
+#endif
+
+static uint32_t secp256k1_cpu_features(void) {
+    /* Benign race: concurrent first callers compute identical values. */
+    static volatile uint32_t cached = 0;
+    uint32_t flags;
+    if ((flags = cached) != 0) {
+        return flags & ~(1u << 31);
+    }
+    flags = 1u << 31; /* mark as computed even when no feature is present */
+    if (getauxval(AT_HWCAP) & HWCAP_NEON) {
+        flags |= SECP256K1_CPU_NEON;
+    }
+    cached = flags;
+    return flags & ~(1u << 31);
+}
+
+#else
+
+static uint32_t secp256k1_cpu_features(void) {
+    return 0;
+}
+
+#endif
+
+#endif
@@ -9,23 +9,52 @@
 
 #include "num.h"
 #include "group.h"
+#include "scratch.h"
+
+/** Per-context LRU of odd-multiples tables keyed by affine point, so that
+ *  verifying many signatures under a handful of repeated pubkeys skips the
+ *  per-call table setup. Defined in ecmult_impl.h; always heap-allocated. */
+typedef struct secp256k1_ecmult_pubkey_cache secp256k1_ecmult_pubkey_cache;
 
 typedef struct {
     /* For accelerating the computation of a*P + b*G: */
     secp256k1_ge_storage (*pre_g)[];    /* odd multiples of the generator */
 #ifdef USE_ENDOMORPHISM
     secp256k1_ge_storage (*pre_g_128)[]; /* odd multiples of 2^128*generator */
+    int pre_g_interleaved;              /* pre_g holds both tables interleaved per index; pre_g_128 is NULL */
 #endif
+    int window_g;                       /* wNAF window of the generator tables, WINDOW_G or WINDOW_G_SMALL */
+    int prealloc;                       /* tables live in the owning context's arena, not on the heap */
+    secp256k1_ecmult_pubkey_cache *pubkey_cache; /* recent per-point tables; NULL when unavailable */
 } secp256k1_ecmult_context;
 
 static void secp256k1_ecmult_context_init(secp256k1_ecmult_context *ctx);
-static void secp256k1_ecmult_context_build(secp256k1_ecmult_context *ctx, const secp256k1_callback *cb);
+static void secp256k1_ecmult_context_build(secp256k1_ecmult_context *ctx, int window_g, secp256k1_arena *arena, const secp256k1_callback *cb);
 static void secp256k1_ecmult_context_clone(secp256k1_ecmult_context *dst,
-                                           const secp256k1_ecmult_context *src, const secp256k1_callback *cb);
+                                           const secp256k1_ecmult_context *src, secp256k1_arena *arena, const secp256k1_callback *cb);
 static void secp256k1_ecmult_context_clear(secp256k1_ecmult_context *ctx);
 static int secp256k1_ecmult_context_is_built(const secp256k1_ecmult_context *ctx);
 
+/** Flat table-set images: a built context's generator tables serialized into
+ *  caller-owned, pointer-free memory, and a borrowed context view over such
+ *  an image. The image can be shared read-only across threads and processes;
+ *  an attached context owns nothing and needs no teardown. */
+static size_t secp256k1_ecmult_context_image_size(const secp256k1_ecmult_context *ctx);
+static size_t secp256k1_ecmult_context_export(const secp256k1_ecmult_context *ctx, unsigned char *buf, size_t size);
+static int secp256k1_ecmult_context_attach(secp256k1_ecmult_context *ctx, const void *image, size_t size);
+
 /** Double multiply: R = na*A + ng*G */
 static void secp256k1_ecmult(const secp256k1_ecmult_context *ctx, secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_scalar *na, const secp256k1_scalar *ng);
 
+/** Double multiply using a caller-provided scratch space for the temporary
+ *  tables. scratch may be NULL (or too small), in which case the tables are
+ *  built on the stack as before. */
+static void secp256k1_ecmult_scratch(const secp256k1_ecmult_context *ctx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_scalar *na, const secp256k1_scalar *ng);
+
+/** Multi-point multiply: R = sum(scalars[i]*points[i]) + ng*G (ng may be NULL),
+ *  sharing one Strauss-Shamir doubling pass across all points. Variable time:
+ *  only for use on public inputs such as batch validation. Returns 0 if the
+ *  scratch space is too small for n points. */
+static int secp256k1_ecmult_multi_var(const secp256k1_ecmult_context *ctx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *scalars, const secp256k1_gej *points, size_t n, const secp256k1_scalar *ng);
+
 #endif
@@ -12,4 +12,37 @@
 
 static void secp256k1_ecmult_const(secp256k1_gej *r, const secp256k1_ge *a, const secp256k1_scalar *q);
 
+/** Two independent constant-time multiplications, r0 = q0*a0 and r1 = q1*a1,
+ *  advanced in lockstep so their dependency chains overlap in one thread. */
+static void secp256k1_ecmult_const_2(secp256k1_gej *r0, const secp256k1_ge *a0, const secp256k1_scalar *q0,
+                                     secp256k1_gej *r1, const secp256k1_ge *a1, const secp256k1_scalar *q1);
+
+/** Window size of the precomputed-base tables below. Larger than WINDOW_A
+ *  since the table build cost is paid once per base, not per multiplication. */
+#define ECMULT_CONST_PRECOMP_WINDOW 8
+
+/** The number of entries in an odd multiples table with window size w.
+ *  Identical to the definition in ecmult_impl.h; restated so this header
+ *  does not depend on inclusion order. */
+#define ECMULT_TABLE_SIZE(w) (1 << ((w)-2))
+
+/** Precomputed odd-multiple tables for one fixed base point, in fully
+ *  normalized storage form so the multiplication loop can fetch entries with
+ *  constant-time cmov scans. */
+typedef struct {
+    secp256k1_ge base; /* for wNAF skew correction */
+    secp256k1_ge_storage pre[ECMULT_TABLE_SIZE(ECMULT_CONST_PRECOMP_WINDOW)];
+#ifdef USE_ENDOMORPHISM
+    secp256k1_ge_storage pre_lam[ECMULT_TABLE_SIZE(ECMULT_CONST_PRECOMP_WINDOW)];
+#endif
+} secp256k1_ecmult_const_precomp;
+
+/** Build the precomputed tables for base point a (may not be infinity). The
+ *  base is assumed public; only later multiplications are scalar-secret. */
+static void secp256k1_ecmult_const_precomp_build(secp256k1_ecmult_const_precomp *pre, const secp256k1_ge *a, const secp256k1_callback *cb);
+
+/** r = q*base in constant time with respect to q, using tables built by
+ *  secp256k1_ecmult_const_precomp_build. */
+static void secp256k1_ecmult_const_precomp_mul(secp256k1_gej *r, const secp256k1_ecmult_const_precomp *pre, const secp256k1_scalar *q);
+
 #endif
@@ -119,6 +119,153 @@ static int secp256k1_wnaf_const(int *wnaf, secp256k1_scalar s, int w) {
 }
 
 
+/* Constant-time fetch from a storage-form odd-multiples table. Entries are
+ * fully normalized, so unlike ECMULT_CONST_TABLE_GET_GE no shared-Z
+ * bookkeeping is needed. */
+#define ECMULT_CONST_TABLE_GET_GE_STORAGE(r,pre,n,w) do { \
+    int m; \
+    int abs_n = (n) * (((n) > 0) * 2 - 1); \
+    int idx_n = abs_n / 2; \
+    secp256k1_ge_storage sel; \
+    secp256k1_fe neg_y; \
+    VERIFY_CHECK(((n) & 1) == 1); \
+    VERIFY_CHECK((n) >= -((1 << ((w)-1)) - 1)); \
+    VERIFY_CHECK((n) <=  ((1 << ((w)-1)) - 1)); \
+    sel = (pre)[0]; \
+    for (m = 1; m < ECMULT_TABLE_SIZE(w); m++) { \
+        /* This loop is used to avoid secret data in array indices. See
+         * the comment in ecmult_gen_impl.h for rationale. */ \
+        secp256k1_ge_storage_cmov(&sel, &(pre)[m], m == idx_n); \
+    } \
+    secp256k1_ge_from_storage((r), &sel); \
+    secp256k1_fe_negate(&neg_y, &(r)->y, 1); \
+    secp256k1_fe_cmov(&(r)->y, &neg_y, (n) != abs_n); \
+} while(0)
+
+static void secp256k1_ecmult_const_precomp_build(secp256k1_ecmult_const_precomp *pre, const secp256k1_ge *a, const secp256k1_callback *cb) {
+    secp256k1_gej prej[ECMULT_TABLE_SIZE(ECMULT_CONST_PRECOMP_WINDOW)];
+    secp256k1_ge prea[ECMULT_TABLE_SIZE(ECMULT_CONST_PRECOMP_WINDOW)];
+    secp256k1_gej d;
+    int i;
+
+    VERIFY_CHECK(!a->infinity);
+    pre->base = *a;
+
+    /* Odd multiples 1*a, 3*a, ..., (2*n-1)*a, normalized together with one
+     * shared Montgomery-trick inversion. The base is public, so the build
+     * may run in variable time. */
+    secp256k1_gej_set_ge(&prej[0], a);
+    secp256k1_gej_double_var(&d, &prej[0], NULL);
+    for (i = 1; i < ECMULT_TABLE_SIZE(ECMULT_CONST_PRECOMP_WINDOW); i++) {
+        secp256k1_gej_add_var(&prej[i], &prej[i-1], &d, NULL);
+    }
+    secp256k1_ge_set_all_gej_var(prea, prej, ECMULT_TABLE_SIZE(ECMULT_CONST_PRECOMP_WINDOW), cb);
+    for (i = 0; i < ECMULT_TABLE_SIZE(ECMULT_CONST_PRECOMP_WINDOW); i++) {
+        secp256k1_ge_to_storage(&pre->pre[i], &prea[i]);
+#ifdef USE_ENDOMORPHISM
+        {
+            secp256k1_ge lam;
+            secp256k1_ge_mul_lambda(&lam, &prea[i]);
+            secp256k1_ge_to_storage(&pre->pre_lam[i], &lam);
+        }
+#endif
+    }
+}
+
+static void secp256k1_ecmult_const_precomp_mul(secp256k1_gej *r, const secp256k1_ecmult_const_precomp *pre, const secp256k1_scalar *scalar) {
+    secp256k1_ge tmpa;
+    int skew_1;
+    int wnaf_1[1 + WNAF_SIZE(ECMULT_CONST_PRECOMP_WINDOW - 1)];
+#ifdef USE_ENDOMORPHISM
+    int wnaf_lam[1 + WNAF_SIZE(ECMULT_CONST_PRECOMP_WINDOW - 1)];
+    int skew_lam;
+    secp256k1_scalar q_1, q_lam;
+#endif
+
+    int i;
+    secp256k1_scalar sc = *scalar;
+
+    /* build wnaf representation for q; same skew scheme as
+     * secp256k1_ecmult_const, only with the wider precomputed window. */
+#ifdef USE_ENDOMORPHISM
+    secp256k1_scalar_split_lambda(&q_1, &q_lam, &sc);
+    skew_1   = secp256k1_wnaf_const(wnaf_1,   q_1,   ECMULT_CONST_PRECOMP_WINDOW - 1);
+    skew_lam = secp256k1_wnaf_const(wnaf_lam, q_lam, ECMULT_CONST_PRECOMP_WINDOW - 1);
+#else
+    skew_1   = secp256k1_wnaf_const(wnaf_1, sc, ECMULT_CONST_PRECOMP_WINDOW - 1);
+#endif
+
+    /* first loop iteration (separated out so we can directly set r, rather
+     * than having it start at infinity, get doubled several times, then have
+     * its new value added to it) */
+    i = wnaf_1[WNAF_SIZE(ECMULT_CONST_PRECOMP_WINDOW - 1)];
+    VERIFY_CHECK(i != 0);
+    ECMULT_CONST_TABLE_GET_GE_STORAGE(&tmpa, pre->pre, i, ECMULT_CONST_PRECOMP_WINDOW);
+    secp256k1_gej_set_ge(r, &tmpa);
+#ifdef USE_ENDOMORPHISM
+    i = wnaf_lam[WNAF_SIZE(ECMULT_CONST_PRECOMP_WINDOW - 1)];
+    VERIFY_CHECK(i != 0);
+    ECMULT_CONST_TABLE_GET_GE_STORAGE(&tmpa, pre->pre_lam, i, ECMULT_CONST_PRECOMP_WINDOW);
+    secp256k1_gej_add_ge(r, r, &tmpa);
+#endif
+    /* remaining loop iterations */
+    for (i = WNAF_SIZE(ECMULT_CONST_PRECOMP_WINDOW - 1) - 1; i >= 0; i--) {
+        int n;
+        int j;
+        for (j = 0; j < ECMULT_CONST_PRECOMP_WINDOW - 1; ++j) {
+            secp256k1_gej_double_nonzero(r, r, NULL);
+        }
+
+        n = wnaf_1[i];
+        ECMULT_CONST_TABLE_GET_GE_STORAGE(&tmpa, pre->pre, n, ECMULT_CONST_PRECOMP_WINDOW);
+        VERIFY_CHECK(n != 0);
+        secp256k1_gej_add_ge(r, r, &tmpa);
+#ifdef USE_ENDOMORPHISM
+        n = wnaf_lam[i];
+        ECMULT_CONST_TABLE_GET_GE_STORAGE(&tmpa, pre->pre_lam, n, ECMULT_CONST_PRECOMP_WINDOW);
+        VERIFY_CHECK(n != 0);
+        secp256k1_gej_add_ge(r, r, &tmpa);
+#endif
+    }
+
+    {
+        /* Correct for wNAF skew */
+        secp256k1_ge correction = pre->base;
+        secp256k1_ge_storage correction_1_stor;
+#ifdef USE_ENDOMORPHISM
+        secp256k1_ge_storage correction_lam_stor;
+#endif
+        secp256k1_ge_storage a2_stor;
+        secp256k1_gej tmpj;
+        secp256k1_gej_set_ge(&tmpj, &correction);
+        secp256k1_gej_double_var(&tmpj, &tmpj, NULL);
+        secp256k1_ge_set_gej(&correction, &tmpj);
+        secp256k1_ge_to_storage(&correction_1_stor, &pre->base);
+#ifdef USE_ENDOMORPHISM
+        secp256k1_ge_to_storage(&correction_lam_stor, &pre->base);
+#endif
+        secp256k1_ge_to_storage(&a2_stor, &correction);
+
+        /* For odd numbers this is 2a (so replace it), for even ones a (so no-op) */
+        secp256k1_ge_storage_cmov(&correction_1_stor, &a2_stor, skew_1 == 2);
+#ifdef USE_ENDOMORPHISM
+        secp256k1_ge_storage_cmov(&correction_lam_stor, &a2_stor, skew_lam == 2);
+#endif
+
+        /* Apply the correction */
+        secp256k1_ge_from_storage(&correction, &correction_1_stor);
+        secp256k1_ge_neg(&correction, &correction);
+        secp256k1_gej_add_ge(r, r, &correction);
+
+#ifdef USE_ENDOMORPHISM
+        secp256k1_ge_from_storage(&correction, &correction_lam_stor);
+        secp256k1_ge_neg(&correction, &correction);
+        secp256k1_ge_mul_lambda(&correction, &correction);
+        secp256k1_gej_add_ge(r, r, &correction);
+#endif
+    }
+}
+
 static void secp256k1_ecmult_const(secp256k1_gej *r, const secp256k1_ge *a, const secp256k1_scalar *scalar) {
     secp256k1_ge pre_a[ECMULT_TABLE_SIZE(WINDOW_A)];
     secp256k1_ge tmpa;
@@ -236,4 +383,137 @@ static void secp256k1_ecmult_const(secp256k1_gej *r, const secp256k1_ge *a, cons
     }
 }
 
+/* The double-and-add ladder is latency-bound: every group operation depends
+ * on the one before it, so a single multiplication cannot keep the multiply
+ * pipes of a wide out-of-order core busy. Advancing two independent ladders
+ * in alternating steps hides most of the field-multiply latency of one chain
+ * behind the other in the same thread. Each result is constant time with
+ * respect to its own scalar, exactly as in secp256k1_ecmult_const; only the
+ * interleaving order is new, and it does not depend on secret data. */
+static void secp256k1_ecmult_const_2(secp256k1_gej *r0, const secp256k1_ge *a0, const secp256k1_scalar *q0,
+                                     secp256k1_gej *r1, const secp256k1_ge *a1, const secp256k1_scalar *q1) {
+    secp256k1_gej *r[2];
+    const secp256k1_ge *a[2];
+    secp256k1_ge pre_a[2][ECMULT_TABLE_SIZE(WINDOW_A)];
+    secp256k1_ge tmpa;
+    secp256k1_fe Z[2];
+
+    int skew_1[2];
+    int wnaf_1[2][1 + WNAF_SIZE(WINDOW_A - 1)];
+#ifdef USE_ENDOMORPHISM
+    secp256k1_ge pre_a_lam[2][ECMULT_TABLE_SIZE(WINDOW_A)];
+    int wnaf_lam[2][1 + WNAF_SIZE(WINDOW_A - 1)];
+    int skew_lam[2];
+#endif
+
+    int i;
+    int k;
+
+    r[0] = r0; r[1] = r1;
+    a[0] = a0; a[1] = a1;
+
+    /* Per-ladder setup, identical to secp256k1_ecmult_const. */
+    for (k = 0; k < 2; k++) {
+        secp256k1_scalar sc = (k == 0) ? *q0 : *q1;
+#ifdef USE_ENDOMORPHISM
+        secp256k1_scalar q_1, q_lam;
+        secp256k1_scalar_split_lambda(&q_1, &q_lam, &sc);
+        skew_1[k]   = secp256k1_wnaf_const(wnaf_1[k],   q_1,   WINDOW_A - 1);
+        skew_lam[k] = secp256k1_wnaf_const(wnaf_lam[k], q_lam, WINDOW_A - 1);
+#else
+        skew_1[k] = secp256k1_wnaf_const(wnaf_1[k], sc, WINDOW_A - 1);
+#endif
+
+        secp256k1_gej_set_ge(r[k], a[k]);
+        secp256k1_ecmult_odd_multiples_table_globalz_windowa(pre_a[k], &Z[k], r[k]);
+        for (i = 0; i < ECMULT_TABLE_SIZE(WINDOW_A); i++) {
+            secp256k1_fe_normalize_weak(&pre_a[k][i].y);
+        }
+#ifdef USE_ENDOMORPHISM
+        for (i = 0; i < ECMULT_TABLE_SIZE(WINDOW_A); i++) {
+            secp256k1_ge_mul_lambda(&pre_a_lam[k][i], &pre_a[k][i]);
+        }
+#endif
+
+        /* first loop iteration (separated out so we can directly set r,
+         * rather than having it start at infinity, get doubled several times,
+         * then have its new value added to it) */
+        i = wnaf_1[k][WNAF_SIZE(WINDOW_A - 1)];
+        VERIFY_CHECK(i != 0);
+        ECMULT_CONST_TABLE_GET_GE(&tmpa, pre_a[k], i, WINDOW_A);
+        secp256k1_gej_set_ge(r[k], &tmpa);
+#ifdef USE_ENDOMORPHISM
+        i = wnaf_lam[k][WNAF_SIZE(WINDOW_A - 1)];
+        VERIFY_CHECK(i != 0);
+        ECMULT_CONST_TABLE_GET_GE(&tmpa, pre_a_lam[k], i, WINDOW_A);
+        secp256k1_gej_add_ge(r[k], r[k], &tmpa);
+#endif
+    }
+
+    /* remaining loop iterations, alternating between the two ladders so both
+     * dependency chains stay in flight together */
+    for (i = WNAF_SIZE(WINDOW_A - 1) - 1; i >= 0; i--) {
+        int n;
+        int j;
+        for (j = 0; j < WINDOW_A - 1; ++j) {
+            secp256k1_gej_double_nonzero(r[0], r[0], NULL);
+            secp256k1_gej_double_nonzero(r[1], r[1], NULL);
+        }
+
+        for (k = 0; k < 2; k++) {
+            n = wnaf_1[k][i];
+            ECMULT_CONST_TABLE_GET_GE(&tmpa, pre_a[k], n, WINDOW_A);
+            VERIFY_CHECK(n != 0);
+            secp256k1_gej_add_ge(r[k], r[k], &tmpa);
+#ifdef USE_ENDOMORPHISM
+            n = wnaf_lam[k][i];
+            ECMULT_CONST_TABLE_GET_GE(&tmpa, pre_a_lam[k], n, WINDOW_A);
+            VERIFY_CHECK(n != 0);
+            secp256k1_gej_add_ge(r[k], r[k], &tmpa);
+#endif
+        }
+    }
+
+    for (k = 0; k < 2; k++) {
+        secp256k1_fe_mul(&r[k]->z, &r[k]->z, &Z[k]);
+
+        {
+            /* Correct for wNAF skew */
+            secp256k1_ge correction = *a[k];
+            secp256k1_ge_storage correction_1_stor;
+#ifdef USE_ENDOMORPHISM
+            secp256k1_ge_storage correction_lam_stor;
+#endif
+            secp256k1_ge_storage a2_stor;
+            secp256k1_gej tmpj;
+            secp256k1_gej_set_ge(&tmpj, &correction);
+            secp256k1_gej_double_var(&tmpj, &tmpj, NULL);
+            secp256k1_ge_set_gej(&correction, &tmpj);
+            secp256k1_ge_to_storage(&correction_1_stor, a[k]);
+#ifdef USE_ENDOMORPHISM
+            secp256k1_ge_to_storage(&correction_lam_stor, a[k]);
+#endif
+            secp256k1_ge_to_storage(&a2_stor, &correction);
+
+            /* For odd numbers this is 2a (so replace it), for even ones a (so no-op) */
+            secp256k1_ge_storage_cmov(&correction_1_stor, &a2_stor, skew_1[k] == 2);
+#ifdef USE_ENDOMORPHISM
+            secp256k1_ge_storage_cmov(&correction_lam_stor, &a2_stor, skew_lam[k] == 2);
+#endif
+
+            /* Apply the correction */
+            secp256k1_ge_from_storage(&correction, &correction_1_stor);
+            secp256k1_ge_neg(&correction, &correction);
+            secp256k1_gej_add_ge(r[k], r[k], &correction);
+
+#ifdef USE_ENDOMORPHISM
+            secp256k1_ge_from_storage(&correction, &correction_lam_stor);
+            secp256k1_ge_neg(&correction, &correction);
+            secp256k1_ge_mul_lambda(&correction, &correction);
+            secp256k1_gej_add_ge(r[k], r[k], &correction);
+#endif
+        }
+    }
+}
+
 #endif
@@ -8,6 +8,9 @@
 #define _SECP256K1_ECMULT_IMPL_H_
 
 #include <string.h>
+#ifndef _WIN32
+#include <time.h>
+#endif
 
 #include "group.h"
 #include "scalar.h"
@@ -27,6 +30,7 @@
 #    define WINDOW_A 2
 #    define WINDOW_G 2
 #  endif
+#  define WINDOW_G_SMALL WINDOW_G
 #else
 /* optimal for 128-bit and 256-bit exponents. */
 #define WINDOW_A 5
@@ -39,6 +43,11 @@
 /** One table for window size 16: 1.375 MiB. */
 #define WINDOW_G 16
 #endif
+/** Reduced-memory profile: tables of a few dozen KiB total instead of
+ *  1.375 MiB. The table walkers take the window size as a parameter, so both
+ *  profiles come out of one build and are selected per context at creation
+ *  (SECP256K1_CONTEXT_VERIFY_SMALL). */
+#define WINDOW_G_SMALL 10
 #endif
 
 /** The number of entries a table with precomputed multiples needs to have. */
@@ -124,9 +133,165 @@ static void secp256k1_ecmult_odd_multiples_table_storage_var(int n, secp256k1_ge
         secp256k1_ge_to_storage(&pre[i], &prea[i]);
     }
 
-    free(prea);
-    free(prej);
-    free(zr);
+    checked_free(prea);
+    checked_free(prej);
+    checked_free(zr);
+}
+
+/* Per-context memoization of the WINDOW_A odd-multiples tables. Verification
+ * workloads are dominated by a small set of repeated pubkeys (a busy sender
+ * signs many transactions against the same key), yet every secp256k1_ecmult
+ * call rebuilds the same per-point table from scratch. The small
+ * set-associative LRU below remembers the globalz tables of recently seen
+ * points, keyed by their affine coordinates. Concurrency follows the
+ * ffi recovery cache: per-slot sequence counters let readers detect torn
+ * entries without a lock, and a writer that loses the claim race simply
+ * drops its store. Without GNU atomic builtins the cache stays unallocated
+ * and every lookup is a miss. */
+
+#define ECMULT_PUBKEY_CACHE_SIZE 64 /* slots, power of two */
+#define ECMULT_PUBKEY_CACHE_PROBES 4 /* linear probe window */
+
+typedef struct {
+    uint32_t seq;   /* 0 empty, odd while being written */
+    uint32_t stamp; /* last-use tick, the LRU eviction key */
+    unsigned char key[64]; /* affine x||y, big endian */
+    secp256k1_ge pre_a[ECMULT_TABLE_SIZE(WINDOW_A)];
+    secp256k1_fe z; /* global Z denominator of pre_a */
+} secp256k1_ecmult_pubkey_cache_entry;
+
+struct secp256k1_ecmult_pubkey_cache {
+    uint32_t tick;
+    secp256k1_ecmult_pubkey_cache_entry slot[ECMULT_PUBKEY_CACHE_SIZE];
+};
+
+/** Derive the cache key for a point. Only points already in z==1 form are
+ *  cacheable: the table contents depend on the full Jacobian triple, and
+ *  z==1 is exactly how the verify and recovery paths present pubkeys
+ *  (secp256k1_gej_set_ge), which is the repeated population worth keeping.
+ *  Returns 0 for infinity or z != 1. */
+static int secp256k1_ecmult_pubkey_cache_key(unsigned char *key, const secp256k1_gej *a) {
+    static const secp256k1_fe fe_one = SECP256K1_FE_CONST(0, 0, 0, 0, 0, 0, 0, 1);
+    secp256k1_fe t;
+    if (a->infinity) {
+        return 0;
+    }
+    t = a->z;
+    secp256k1_fe_normalize_var(&t);
+    if (!secp256k1_fe_equal_var(&t, &fe_one)) {
+        return 0;
+    }
+    t = a->x;
+    secp256k1_fe_normalize_var(&t);
+    secp256k1_fe_get_b32(key, &t);
+    t = a->y;
+    secp256k1_fe_normalize_var(&t);
+    secp256k1_fe_get_b32(key + 32, &t);
+    return 1;
+}
+
+/* FNV-1a over the affine key; the slot index comes from the low bits. */
+static uint32_t secp256k1_ecmult_pubkey_cache_hash(const unsigned char *key) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    int i;
+    for (i = 0; i < 64; i++) {
+        h = (h ^ key[i]) * 0x100000001b3ULL;
+    }
+    return (uint32_t)h;
+}
+
+/** Copy the memoized table for point a into pre/globalz. Returns 1 on a hit.
+ *  Lock-free: a concurrent writer at most turns a hit into a miss, in which
+ *  case pre may hold a partial copy the caller is about to rebuild anyway. */
+static int secp256k1_ecmult_pubkey_cache_lookup(secp256k1_ecmult_pubkey_cache *cache, const secp256k1_gej *a, secp256k1_ge *pre, secp256k1_fe *globalz) {
+#if defined(__GNUC__)
+    unsigned char key[64];
+    size_t base;
+    int p;
+
+    if (cache == NULL || !secp256k1_ecmult_pubkey_cache_key(key, a)) {
+        return 0;
+    }
+    base = secp256k1_ecmult_pubkey_cache_hash(key) & (ECMULT_PUBKEY_CACHE_SIZE - 1);
+    for (p = 0; p < ECMULT_PUBKEY_CACHE_PROBES; p++) {
+        secp256k1_ecmult_pubkey_cache_entry *e = &cache->slot[(base + p) & (ECMULT_PUBKEY_CACHE_SIZE - 1)];
+        uint32_t seq = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE);
+
+        if (seq == 0 || (seq & 1)) {
+            continue;
+        }
+        if (memcmp(e->key, key, 64) != 0) {
+            continue;
+        }
+        memcpy(pre, e->pre_a, sizeof(e->pre_a));
+        *globalz = e->z;
+        /* The copies above are only trusted if the slot was not rewritten
+         * underneath; the counter re-check covers the key compare too. */
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&e->seq, __ATOMIC_RELAXED) != seq) {
+            continue;
+        }
+        __atomic_store_n(&e->stamp, __atomic_add_fetch(&cache->tick, 1, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+        return 1;
+    }
+#else
+    (void)cache;
+    (void)a;
+    (void)pre;
+    (void)globalz;
+#endif
+    return 0;
+}
+
+/** Memoize a freshly built table. The probe window prefers an empty slot and
+ *  otherwise evicts its least recently used entry. */
+static void secp256k1_ecmult_pubkey_cache_store(secp256k1_ecmult_pubkey_cache *cache, const secp256k1_gej *a, const secp256k1_ge *pre, const secp256k1_fe *globalz) {
+#if defined(__GNUC__)
+    unsigned char key[64];
+    secp256k1_ecmult_pubkey_cache_entry *e;
+    size_t base;
+    size_t victim;
+    uint32_t victim_stamp = 0;
+    uint32_t seq;
+    int p;
+
+    if (cache == NULL || !secp256k1_ecmult_pubkey_cache_key(key, a)) {
+        return;
+    }
+    base = secp256k1_ecmult_pubkey_cache_hash(key) & (ECMULT_PUBKEY_CACHE_SIZE - 1);
+    victim = base;
+    for (p = 0; p < ECMULT_PUBKEY_CACHE_PROBES; p++) {
+        size_t at = (base + p) & (ECMULT_PUBKEY_CACHE_SIZE - 1);
+        e = &cache->slot[at];
+        seq = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE);
+        if (seq == 0) {
+            victim = at;
+            break;
+        }
+        if (!(seq & 1) && memcmp(e->key, key, 64) == 0) {
+            return; /* already cached */
+        }
+        if (p == 0 || __atomic_load_n(&e->stamp, __ATOMIC_RELAXED) < victim_stamp) {
+            victim = at;
+            victim_stamp = __atomic_load_n(&e->stamp, __ATOMIC_RELAXED);
+        }
+    }
+    e = &cache->slot[victim];
+    seq = __atomic_load_n(&e->seq, __ATOMIC_RELAXED);
+    if ((seq & 1) || !__atomic_compare_exchange_n(&e->seq, &seq, seq + 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        return; /* another writer owns the slot: dropping the store is fine */
+    }
+    memcpy(e->key, key, 64);
+    memcpy(e->pre_a, pre, sizeof(e->pre_a));
+    e->z = *globalz;
+    __atomic_store_n(&e->stamp, __atomic_add_fetch(&cache->tick, 1, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+    __atomic_store_n(&e->seq, seq + 2, __ATOMIC_RELEASE);
+#else
+    (void)cache;
+    (void)a;
+    (void)pre;
+    (void)globalz;
+#endif
 }
 
 /** The following two macro retrieves a particular odd multiple from a table
@@ -142,27 +307,120 @@ static void secp256k1_ecmult_odd_multiples_table_storage_var(int n, secp256k1_ge
     } \
 } while(0)
 
-#define ECMULT_TABLE_GET_GE_STORAGE(r,pre,n,w) do { \
+/** Like the above, but with a configurable distance (in entries) between
+ *  consecutive odd multiples, for tables stored in an interleaved layout. */
+#define ECMULT_TABLE_GET_GE_STORAGE_STRIDED(r,pre,n,w,stride) do { \
     VERIFY_CHECK(((n) & 1) == 1); \
     VERIFY_CHECK((n) >= -((1 << ((w)-1)) - 1)); \
     VERIFY_CHECK((n) <=  ((1 << ((w)-1)) - 1)); \
     if ((n) > 0) { \
-        secp256k1_ge_from_storage((r), &(pre)[((n)-1)/2]); \
+        secp256k1_ge_from_storage((r), &(pre)[(stride) * (((n)-1)/2)]); \
     } else { \
-        secp256k1_ge_from_storage((r), &(pre)[(-(n)-1)/2]); \
+        secp256k1_ge_from_storage((r), &(pre)[(stride) * ((-(n)-1)/2)]); \
         secp256k1_ge_neg((r), (r)); \
     } \
 } while(0)
 
+#define ECMULT_TABLE_GET_GE_STORAGE(r,pre,n,w) ECMULT_TABLE_GET_GE_STORAGE_STRIDED(r,pre,n,w,1)
+
+#ifdef USE_ENDOMORPHISM
+#ifndef _WIN32
+/** Time a synthetic wNAF-style index walk over a candidate (pre_g, pre_g_128)
+ *  arrangement, touching one cache line per lookup like the real accumulation
+ *  loop does. stride is the distance in entries between consecutive odd
+ *  multiples of the same base point. */
+static uint64_t secp256k1_ecmult_table_probe(const secp256k1_ge_storage *pre_g, const secp256k1_ge_storage *pre_g_128, int stride, int entries) {
+    struct timespec begin, end;
+    uint32_t lcg = 0x6b8b4567u;
+    uint32_t sink = 0;
+    volatile uint32_t sink_out;
+    int i;
+
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    for (i = 0; i < 8192; i++) {
+        uint32_t word;
+        lcg = lcg * 1103515245u + 12345u;
+        memcpy(&word, &pre_g[stride * (int)(lcg % (uint32_t)entries)], sizeof(word));
+        sink ^= word;
+        lcg = lcg * 1103515245u + 12345u;
+        memcpy(&word, &pre_g_128[stride * (int)(lcg % (uint32_t)entries)], sizeof(word));
+        sink ^= word;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    sink_out = sink;
+    (void)sink_out;
+    return (uint64_t)(end.tv_sec - begin.tv_sec) * 1000000000ull + (uint64_t)(end.tv_nsec - begin.tv_nsec);
+}
+#endif
+
+/** Decide whether the generator tables should be stored as the classic split
+ *  pair, or as one table with the G and 2^128*G multiples interleaved per
+ *  index so a window position's two lookups share TLB pages. The wNAF indices
+ *  are data-dependent, so the answer varies with cache and TLB geometry: a
+ *  quick benchmark of both layouts at table-build time settles it per machine. */
+static int secp256k1_ecmult_prefer_interleaved(const secp256k1_ge_storage *tab_g, const secp256k1_ge_storage *tab_g_128, int entries, const secp256k1_callback *cb) {
+#ifdef _WIN32
+    (void)tab_g;
+    (void)tab_g_128;
+    (void)entries;
+    (void)cb;
+    return 0;
+#else
+    secp256k1_ge_storage *joint = (secp256k1_ge_storage*)checked_malloc(cb, sizeof(secp256k1_ge_storage) * 2 * entries);
+    uint64_t best_split = 0;
+    uint64_t best_joint = 0;
+    uint64_t t;
+    int i;
+    int run;
+
+    for (i = 0; i < entries; i++) {
+        joint[2 * i] = tab_g[i];
+        joint[2 * i + 1] = tab_g_128[i];
+    }
+    /* The first pass only warms the caches; keep the best of the rest. */
+    for (run = 0; run < 4; run++) {
+        t = secp256k1_ecmult_table_probe(tab_g, tab_g_128, 1, entries);
+        if (run > 0 && (best_split == 0 || t < best_split)) {
+            best_split = t;
+        }
+        t = secp256k1_ecmult_table_probe(joint, joint + 1, 2, entries);
+        if (run > 0 && (best_joint == 0 || t < best_joint)) {
+            best_joint = t;
+        }
+    }
+    checked_free(joint);
+    return best_joint < best_split;
+#endif
+}
+#endif
+
 static void secp256k1_ecmult_context_init(secp256k1_ecmult_context *ctx) {
     ctx->pre_g = NULL;
 #ifdef USE_ENDOMORPHISM
     ctx->pre_g_128 = NULL;
+    ctx->pre_g_interleaved = 0;
 #endif
+    ctx->window_g = 0;
+    ctx->prealloc = 0;
+    ctx->pubkey_cache = NULL;
 }
 
-static void secp256k1_ecmult_context_build(secp256k1_ecmult_context *ctx, const secp256k1_callback *cb) {
+/* Allocate an empty per-point table cache. Kept off the arena: the cache is
+ * mutable working state, not part of the precomputed tables, and is always
+ * freed by secp256k1_ecmult_context_clear. */
+static void secp256k1_ecmult_pubkey_cache_create(secp256k1_ecmult_context *ctx, const secp256k1_callback *cb) {
+#if defined(__GNUC__)
+    ctx->pubkey_cache = (secp256k1_ecmult_pubkey_cache*)checked_malloc(cb, sizeof(*ctx->pubkey_cache));
+    memset(ctx->pubkey_cache, 0, sizeof(*ctx->pubkey_cache));
+#else
+    (void)cb;
+    ctx->pubkey_cache = NULL;
+#endif
+}
+
+static void secp256k1_ecmult_context_build(secp256k1_ecmult_context *ctx, int window_g, secp256k1_arena *arena, const secp256k1_callback *cb) {
     secp256k1_gej gj;
+    int entries = ECMULT_TABLE_SIZE(window_g);
 
     if (ctx->pre_g != NULL) {
         return;
@@ -171,57 +429,213 @@ static void secp256k1_ecmult_context_build(secp256k1_ecmult_context *ctx, const
     /* get the generator */
     secp256k1_gej_set_ge(&gj, &secp256k1_ge_const_g);
 
-    ctx->pre_g = (secp256k1_ge_storage (*)[])checked_malloc(cb, sizeof((*ctx->pre_g)[0]) * ECMULT_TABLE_SIZE(WINDOW_G));
-
-    /* precompute the tables with odd multiples */
-    secp256k1_ecmult_odd_multiples_table_storage_var(ECMULT_TABLE_SIZE(WINDOW_G), *ctx->pre_g, &gj, cb);
-
+    ctx->window_g = window_g;
+    ctx->prealloc = (arena != NULL);
+    secp256k1_ecmult_pubkey_cache_create(ctx, cb);
 #ifdef USE_ENDOMORPHISM
     {
         secp256k1_gej g_128j;
+        secp256k1_ge_storage *tab_g = (secp256k1_ge_storage*)checked_malloc(cb, sizeof(secp256k1_ge_storage) * entries);
+        secp256k1_ge_storage *tab_g_128 = (secp256k1_ge_storage*)checked_malloc(cb, sizeof(secp256k1_ge_storage) * entries);
         int i;
 
-        ctx->pre_g_128 = (secp256k1_ge_storage (*)[])checked_malloc(cb, sizeof((*ctx->pre_g_128)[0]) * ECMULT_TABLE_SIZE(WINDOW_G));
+        /* precompute the tables with odd multiples */
+        secp256k1_ecmult_odd_multiples_table_storage_var(entries, tab_g, &gj, cb);
 
         /* calculate 2^128*generator */
         g_128j = gj;
         for (i = 0; i < 128; i++) {
             secp256k1_gej_double_var(&g_128j, &g_128j, NULL);
         }
-        secp256k1_ecmult_odd_multiples_table_storage_var(ECMULT_TABLE_SIZE(WINDOW_G), *ctx->pre_g_128, &g_128j, cb);
+        secp256k1_ecmult_odd_multiples_table_storage_var(entries, tab_g_128, &g_128j, cb);
+
+        /* Benchmark the two storage layouts and keep the faster one. */
+        ctx->pre_g_interleaved = secp256k1_ecmult_prefer_interleaved(tab_g, tab_g_128, entries, cb);
+        if (ctx->pre_g_interleaved) {
+            ctx->pre_g = (secp256k1_ge_storage (*)[])secp256k1_arena_alloc(arena, cb, sizeof((*ctx->pre_g)[0]) * 2 * entries);
+            for (i = 0; i < entries; i++) {
+                (*ctx->pre_g)[2 * i] = tab_g[i];
+                (*ctx->pre_g)[2 * i + 1] = tab_g_128[i];
+            }
+            ctx->pre_g_128 = NULL;
+        } else {
+            ctx->pre_g = (secp256k1_ge_storage (*)[])secp256k1_arena_alloc(arena, cb, sizeof((*ctx->pre_g)[0]) * entries);
+            memcpy(*ctx->pre_g, tab_g, sizeof(secp256k1_ge_storage) * entries);
+            ctx->pre_g_128 = (secp256k1_ge_storage (*)[])secp256k1_arena_alloc(arena, cb, sizeof((*ctx->pre_g_128)[0]) * entries);
+            memcpy(*ctx->pre_g_128, tab_g_128, sizeof(secp256k1_ge_storage) * entries);
+        }
+
+        checked_free(tab_g_128);
+        checked_free(tab_g);
     }
+#else
+    ctx->pre_g = (secp256k1_ge_storage (*)[])secp256k1_arena_alloc(arena, cb, sizeof((*ctx->pre_g)[0]) * entries);
+
+    /* precompute the tables with odd multiples */
+    secp256k1_ecmult_odd_multiples_table_storage_var(entries, *ctx->pre_g, &gj, cb);
 #endif
 }
 
 static void secp256k1_ecmult_context_clone(secp256k1_ecmult_context *dst,
-                                           const secp256k1_ecmult_context *src, const secp256k1_callback *cb) {
+                                           const secp256k1_ecmult_context *src, secp256k1_arena *arena, const secp256k1_callback *cb) {
+    dst->prealloc = (arena != NULL);
+    dst->window_g = src->window_g;
+    /* The clone starts with a cache of its own; memoized tables are derived
+     * data and refill on use. */
+    secp256k1_ecmult_pubkey_cache_create(dst, cb);
+#ifdef USE_ENDOMORPHISM
+    dst->pre_g_interleaved = src->pre_g_interleaved;
+#endif
     if (src->pre_g == NULL) {
         dst->pre_g = NULL;
     } else {
-        size_t size = sizeof((*dst->pre_g)[0]) * ECMULT_TABLE_SIZE(WINDOW_G);
-        dst->pre_g = (secp256k1_ge_storage (*)[])checked_malloc(cb, size);
+        size_t size = sizeof((*dst->pre_g)[0]) * ECMULT_TABLE_SIZE(src->window_g);
+#ifdef USE_ENDOMORPHISM
+        if (src->pre_g_interleaved) {
+            size *= 2;
+        }
+#endif
+        dst->pre_g = (secp256k1_ge_storage (*)[])secp256k1_arena_alloc(arena, cb, size);
         memcpy(dst->pre_g, src->pre_g, size);
     }
 #ifdef USE_ENDOMORPHISM
     if (src->pre_g_128 == NULL) {
         dst->pre_g_128 = NULL;
     } else {
-        size_t size = sizeof((*dst->pre_g_128)[0]) * ECMULT_TABLE_SIZE(WINDOW_G);
-        dst->pre_g_128 = (secp256k1_ge_storage (*)[])checked_malloc(cb, size);
+        size_t size = sizeof((*dst->pre_g_128)[0]) * ECMULT_TABLE_SIZE(src->window_g);
+        dst->pre_g_128 = (secp256k1_ge_storage (*)[])secp256k1_arena_alloc(arena, cb, size);
         memcpy(dst->pre_g_128, src->pre_g_128, size);
     }
 #endif
 }
 
+/* Header of a flat, self-describing image of a built generator table set.
+ * The image holds no pointers, only the header followed by the raw table
+ * entries, so it can live in caller-owned memory shared across threads and
+ * processes (a file mapping works as-is). The header is one cache line, so
+ * the tables keep their alignment when the image itself is 64-byte aligned;
+ * 8-byte alignment is the hard requirement. */
+#define SECP256K1_ECMULT_TABLE_MAGIC 0x45434d54u /* "ECMT" */
+#define SECP256K1_ECMULT_TABLE_VERSION 1u
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    int32_t window_g;
+    int32_t interleaved;   /* both tables interleaved per index, see ecmult.h */
+    uint32_t entry_size;   /* sizeof(secp256k1_ge_storage); layout cross-check */
+    uint32_t tables;       /* generator wNAF tables in the image (1 or 2) */
+    unsigned char pad[40]; /* reserved, zero; sizes the header to 64 bytes */
+} secp256k1_ecmult_table_header;
+
+static size_t secp256k1_ecmult_context_image_size(const secp256k1_ecmult_context *ctx) {
+    size_t bytes = sizeof(secp256k1_ge_storage) * ECMULT_TABLE_SIZE(ctx->window_g);
+#ifdef USE_ENDOMORPHISM
+    bytes *= 2;
+#endif
+    return sizeof(secp256k1_ecmult_table_header) + bytes;
+}
+
+/* Write the context's generator tables into caller-owned memory as a flat
+ * image. Returns the image size, writing only when buf is large enough, so
+ * a NULL/0 call sizes the allocation. The source layout (window, split or
+ * interleaved storage) is preserved as probed at build time. */
+static size_t secp256k1_ecmult_context_export(const secp256k1_ecmult_context *ctx, unsigned char *buf, size_t size) {
+    size_t const need = secp256k1_ecmult_context_image_size(ctx);
+    size_t const table_bytes = sizeof(secp256k1_ge_storage) * ECMULT_TABLE_SIZE(ctx->window_g);
+    secp256k1_ecmult_table_header hdr;
+
+    VERIFY_CHECK(secp256k1_ecmult_context_is_built(ctx));
+    if (buf == NULL || size < need) {
+        return need;
+    }
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = SECP256K1_ECMULT_TABLE_MAGIC;
+    hdr.version = SECP256K1_ECMULT_TABLE_VERSION;
+    hdr.window_g = ctx->window_g;
+    hdr.entry_size = (uint32_t)sizeof(secp256k1_ge_storage);
+#ifdef USE_ENDOMORPHISM
+    hdr.interleaved = ctx->pre_g_interleaved;
+    hdr.tables = 2;
+    memcpy(buf, &hdr, sizeof(hdr));
+    if (ctx->pre_g_interleaved) {
+        memcpy(buf + sizeof(hdr), *ctx->pre_g, 2 * table_bytes);
+    } else {
+        memcpy(buf + sizeof(hdr), *ctx->pre_g, table_bytes);
+        memcpy(buf + sizeof(hdr) + table_bytes, *ctx->pre_g_128, table_bytes);
+    }
+#else
+    hdr.interleaved = 0;
+    hdr.tables = 1;
+    memcpy(buf, &hdr, sizeof(hdr));
+    memcpy(buf + sizeof(hdr), *ctx->pre_g, table_bytes);
+#endif
+    return need;
+}
+
+/* Point an ecmult context at the tables of a flat image without copying.
+ * The image must outlive every use of the context; nothing is allocated, so
+ * the context needs no teardown (and must not reach context_clear with
+ * prealloc unset). The per-point cache is left out: the attached view is
+ * meant for stateless sharing, where mutable state would defeat the point.
+ * Returns 0 when the image is malformed or was built under an incompatible
+ * library configuration. */
+static int secp256k1_ecmult_context_attach(secp256k1_ecmult_context *ctx, const void *image, size_t size) {
+    secp256k1_ecmult_table_header hdr;
+    size_t table_bytes;
+    unsigned char *tables;
+
+    secp256k1_ecmult_context_init(ctx);
+    if (image == NULL || ((uintptr_t)image & 7) != 0 || size < sizeof(hdr)) {
+        return 0;
+    }
+    memcpy(&hdr, image, sizeof(hdr));
+    if (hdr.magic != SECP256K1_ECMULT_TABLE_MAGIC ||
+        hdr.version != SECP256K1_ECMULT_TABLE_VERSION ||
+        hdr.entry_size != sizeof(secp256k1_ge_storage) ||
+        hdr.window_g < 2 || hdr.window_g > WINDOW_G) {
+        return 0;
+    }
+    table_bytes = sizeof(secp256k1_ge_storage) * ECMULT_TABLE_SIZE(hdr.window_g);
+    /* The tables are write-once data shared read-only from here on; the
+     * image parameter stays const in the signature and the cast below only
+     * reconciles that with the context's non-const field. */
+    tables = (unsigned char *)(uintptr_t)image + sizeof(hdr);
+#ifdef USE_ENDOMORPHISM
+    if (hdr.tables != 2 || size < sizeof(hdr) + 2 * table_bytes) {
+        return 0;
+    }
+    ctx->pre_g = (secp256k1_ge_storage (*)[])tables;
+    if (hdr.interleaved) {
+        ctx->pre_g_interleaved = 1;
+        ctx->pre_g_128 = NULL;
+    } else {
+        ctx->pre_g_interleaved = 0;
+        ctx->pre_g_128 = (secp256k1_ge_storage (*)[])(tables + table_bytes);
+    }
+#else
+    if (hdr.tables != 1 || hdr.interleaved != 0 || size < sizeof(hdr) + table_bytes) {
+        return 0;
+    }
+    ctx->pre_g = (secp256k1_ge_storage (*)[])tables;
+#endif
+    ctx->window_g = hdr.window_g;
+    ctx->prealloc = 1;
+    return 1;
+}
+
 static int secp256k1_ecmult_context_is_built(const secp256k1_ecmult_context *ctx) {
     return ctx->pre_g != NULL;
 }
 
 static void secp256k1_ecmult_context_clear(secp256k1_ecmult_context *ctx) {
-    free(ctx->pre_g);
+    if (!ctx->prealloc) {
+        checked_free(ctx->pre_g);
 #ifdef USE_ENDOMORPHISM
-    free(ctx->pre_g_128);
+        checked_free(ctx->pre_g_128);
 #endif
+    }
+    checked_free(ctx->pubkey_cache);
     secp256k1_ecmult_context_init(ctx);
 }
 
@@ -232,12 +646,43 @@ static void secp256k1_ecmult_context_clear(secp256k1_ecmult_context *ctx) {
  *  - the number of set values in wnaf is returned. This number is at most 256, and at most one more
  *    than the number of bits in the (absolute value) of the input.
  */
+/** Count trailing zero bits of a nonzero 64-bit value. */
+static SECP256K1_INLINE int secp256k1_ctz64_var(uint64_t x) {
+    VERIFY_CHECK(x != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    /* De Bruijn multiplication, the table-driven fallback. */
+    {
+        static const int debruijn[64] = {
+             0,  1,  2, 53,  3,  7, 54, 27,  4, 38, 41,  8, 34, 55, 48, 28,
+            62,  5, 39, 46, 44, 42, 22,  9, 24, 35, 59, 56, 49, 18, 29, 11,
+            63, 52,  6, 26, 37, 40, 33, 47, 61, 45, 43, 21, 23, 58, 17, 10,
+            51, 25, 36, 32, 60, 20, 57, 16, 50, 31, 19, 15, 30, 14, 13, 12
+        };
+        return debruijn[((x & (0 - x)) * 0x022FDD63CC95386DULL) >> 58];
+    }
+#endif
+}
+
+/** Return 64 bits of a 256-bit little-endian limb array starting at bit
+ *  position pos (0 <= pos < 256); bits past the top read as zero, which is
+ *  why the array carries a fifth, zero limb. */
+static SECP256K1_INLINE uint64_t secp256k1_wnaf_bits64(const uint64_t *limbs, int pos) {
+    /* The double shift keeps the high half well-defined when pos is a
+     * multiple of 64 (a single shift by 64 would be undefined). */
+    return (limbs[pos >> 6] >> (pos & 63)) | ((limbs[(pos >> 6) + 1] << 1) << (63 - (pos & 63)));
+}
+
 static int secp256k1_ecmult_wnaf(int *wnaf, int len, const secp256k1_scalar *a, int w) {
     secp256k1_scalar s = *a;
+    unsigned char b[32];
+    uint64_t limbs[5];
     int last_set_bit = -1;
     int bit = 0;
     int sign = 1;
     int carry = 0;
+    int i, j;
 
     VERIFY_CHECK(wnaf != NULL);
     VERIFY_CHECK(0 <= len && len <= 256);
@@ -251,20 +696,41 @@ static int secp256k1_ecmult_wnaf(int *wnaf, int len, const secp256k1_scalar *a,
         sign = -1;
     }
 
+    secp256k1_scalar_get_b32(b, &s);
+    for (i = 0; i < 4; i++) {
+        limbs[i] = 0;
+        for (j = 0; j < 8; j++) {
+            limbs[i] |= (uint64_t)b[31 - 8*i - j] << (8*j);
+        }
+    }
+    limbs[4] = 0;
+
+    /* Instead of testing one data-dependent bit per iteration (a mispredicted
+     * branch per bit on random scalars), xor a 64-bit window against the
+     * carry mask and jump straight to the next differing bit with a trailing
+     * zero count. The only data-dependent branch left is the per-digit loop
+     * itself. */
     while (bit < len) {
         int now;
         int word;
-        if (secp256k1_scalar_get_bits(&s, bit, 1) == (unsigned int)carry) {
-            bit++;
+        uint64_t window = secp256k1_wnaf_bits64(limbs, bit) ^ (0 - (uint64_t)carry);
+        if (window == 0) {
+            /* The next 64 bits all extend the current run of carry-valued
+             * bits; skip them whole. */
+            bit += 64;
             continue;
         }
+        bit += secp256k1_ctz64_var(window);
+        if (bit >= len) {
+            break;
+        }
 
         now = w;
         if (now > len - bit) {
             now = len - bit;
         }
 
-        word = secp256k1_scalar_get_bits_var(&s, bit, now) + carry;
+        word = (int)(secp256k1_wnaf_bits64(limbs, bit) & (((uint64_t)1 << now) - 1)) + carry;
 
         carry = (word >> (w-1)) & 1;
         word -= carry << w;
@@ -278,44 +744,72 @@ static int secp256k1_ecmult_wnaf(int *wnaf, int len, const secp256k1_scalar *a,
     CHECK(carry == 0);
     while (bit < 256) {
         CHECK(secp256k1_scalar_get_bits(&s, bit++, 1) == 0);
-    } 
+    }
 #endif
     return last_set_bit + 1;
 }
 
-static void secp256k1_ecmult(const secp256k1_ecmult_context *ctx, secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_scalar *na, const secp256k1_scalar *ng) {
+/* The per-call temporary tables of secp256k1_ecmult, grouped so they can live
+ * either in the caller's frame or in a reused scratch space. */
+typedef struct {
     secp256k1_ge pre_a[ECMULT_TABLE_SIZE(WINDOW_A)];
+#ifdef USE_ENDOMORPHISM
+    secp256k1_ge pre_a_lam[ECMULT_TABLE_SIZE(WINDOW_A)];
+    int wnaf_na_1[130];
+    int wnaf_na_lam[130];
+    int wnaf_ng_1[129];
+    int wnaf_ng_128[129];
+#else
+    int wnaf_na[256];
+    int wnaf_ng[256];
+#endif
+} secp256k1_ecmult_scratch_state;
+
+/* Scratch size sufficient for one secp256k1_ecmult_scratch call. */
+#define SECP256K1_ECMULT_SCRATCH_SIZE (sizeof(secp256k1_ecmult_scratch_state) + 16)
+
+static void secp256k1_ecmult_scratch(const secp256k1_ecmult_context *ctx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_scalar *na, const secp256k1_scalar *ng) {
+    secp256k1_ecmult_scratch_state stack_state;
+    secp256k1_ecmult_scratch_state *st = &stack_state;
     secp256k1_ge tmpa;
     secp256k1_fe Z;
 #ifdef USE_ENDOMORPHISM
-    secp256k1_ge pre_a_lam[ECMULT_TABLE_SIZE(WINDOW_A)];
     secp256k1_scalar na_1, na_lam;
     /* Splitted G factors. */
     secp256k1_scalar ng_1, ng_128;
-    int wnaf_na_1[130];
-    int wnaf_na_lam[130];
+    /* Base and entry stride of the generator tables, resolving the storage
+     * layout the context build picked. */
+    const secp256k1_ge_storage *pre_g;
+    const secp256k1_ge_storage *pre_g_128;
+    int g_stride;
     int bits_na_1;
     int bits_na_lam;
-    int wnaf_ng_1[129];
     int bits_ng_1;
-    int wnaf_ng_128[129];
     int bits_ng_128;
 #else
-    int wnaf_na[256];
     int bits_na;
-    int wnaf_ng[256];
     int bits_ng;
 #endif
+    int wg = ctx->window_g;
     int i;
     int bits;
 
+    if (scratch != NULL) {
+        secp256k1_ecmult_scratch_state *alloc;
+        secp256k1_scratch_reset(scratch);
+        alloc = (secp256k1_ecmult_scratch_state*)secp256k1_scratch_alloc(scratch, sizeof(*alloc));
+        if (alloc != NULL) {
+            st = alloc;
+        }
+    }
+
 #ifdef USE_ENDOMORPHISM
     /* split na into na_1 and na_lam (where na = na_1 + na_lam*lambda, and na_1 and na_lam are ~128 bit) */
     secp256k1_scalar_split_lambda(&na_1, &na_lam, na);
 
     /* build wnaf representation for na_1 and na_lam. */
-    bits_na_1   = secp256k1_ecmult_wnaf(wnaf_na_1,   130, &na_1,   WINDOW_A);
-    bits_na_lam = secp256k1_ecmult_wnaf(wnaf_na_lam, 130, &na_lam, WINDOW_A);
+    bits_na_1   = secp256k1_ecmult_wnaf(st->wnaf_na_1,   130, &na_1,   WINDOW_A);
+    bits_na_lam = secp256k1_ecmult_wnaf(st->wnaf_na_lam, 130, &na_lam, WINDOW_A);
     VERIFY_CHECK(bits_na_1 <= 130);
     VERIFY_CHECK(bits_na_lam <= 130);
     bits = bits_na_1;
@@ -324,7 +818,7 @@ static void secp256k1_ecmult(const secp256k1_ecmult_context *ctx, secp256k1_gej
     }
 #else
     /* build wnaf representation for na. */
-    bits_na     = secp256k1_ecmult_wnaf(wnaf_na,     256, na,      WINDOW_A);
+    bits_na     = secp256k1_ecmult_wnaf(st->wnaf_na,     256, na,      WINDOW_A);
     bits = bits_na;
 #endif
 
@@ -337,28 +831,43 @@ static void secp256k1_ecmult(const secp256k1_ecmult_context *ctx, secp256k1_gej
      * affine. Compared to the base used for other points, they have a Z ratio
      * of 1/Z, so we can use secp256k1_gej_add_zinv_var, which uses the same
      * isomorphism to efficiently add with a known Z inverse.
-     */
-    secp256k1_ecmult_odd_multiples_table_globalz_windowa(pre_a, &Z, a);
+     *
+     * Repeated points (the same pubkey verified again and again) take their
+     * table from the per-context cache instead of rebuilding it. */
+    if (!secp256k1_ecmult_pubkey_cache_lookup(ctx->pubkey_cache, a, st->pre_a, &Z)) {
+        secp256k1_ecmult_odd_multiples_table_globalz_windowa(st->pre_a, &Z, a);
+        secp256k1_ecmult_pubkey_cache_store(ctx->pubkey_cache, a, st->pre_a, &Z);
+    }
 
 #ifdef USE_ENDOMORPHISM
     for (i = 0; i < ECMULT_TABLE_SIZE(WINDOW_A); i++) {
-        secp256k1_ge_mul_lambda(&pre_a_lam[i], &pre_a[i]);
+        secp256k1_ge_mul_lambda(&st->pre_a_lam[i], &st->pre_a[i]);
     }
 
     /* split ng into ng_1 and ng_128 (where gn = gn_1 + gn_128*2^128, and gn_1 and gn_128 are ~128 bit) */
     secp256k1_scalar_split_128(&ng_1, &ng_128, ng);
 
     /* Build wnaf representation for ng_1 and ng_128 */
-    bits_ng_1   = secp256k1_ecmult_wnaf(wnaf_ng_1,   129, &ng_1,   WINDOW_G);
-    bits_ng_128 = secp256k1_ecmult_wnaf(wnaf_ng_128, 129, &ng_128, WINDOW_G);
+    bits_ng_1   = secp256k1_ecmult_wnaf(st->wnaf_ng_1,   129, &ng_1,   wg);
+    bits_ng_128 = secp256k1_ecmult_wnaf(st->wnaf_ng_128, 129, &ng_128, wg);
     if (bits_ng_1 > bits) {
         bits = bits_ng_1;
     }
     if (bits_ng_128 > bits) {
         bits = bits_ng_128;
     }
+
+    if (ctx->pre_g_interleaved) {
+        pre_g = *ctx->pre_g;
+        pre_g_128 = *ctx->pre_g + 1;
+        g_stride = 2;
+    } else {
+        pre_g = *ctx->pre_g;
+        pre_g_128 = *ctx->pre_g_128;
+        g_stride = 1;
+    }
 #else
-    bits_ng     = secp256k1_ecmult_wnaf(wnaf_ng,     256, ng,      WINDOW_G);
+    bits_ng     = secp256k1_ecmult_wnaf(st->wnaf_ng,     256, ng,      wg);
     if (bits_ng > bits) {
         bits = bits_ng;
     }
@@ -370,30 +879,30 @@ static void secp256k1_ecmult(const secp256k1_ecmult_context *ctx, secp256k1_gej
         int n;
         secp256k1_gej_double_var(r, r, NULL);
 #ifdef USE_ENDOMORPHISM
-        if (i < bits_na_1 && (n = wnaf_na_1[i])) {
-            ECMULT_TABLE_GET_GE(&tmpa, pre_a, n, WINDOW_A);
-            secp256k1_gej_add_ge_var(r, r, &tmpa, NULL);
+        if (i < bits_na_1 && (n = st->wnaf_na_1[i])) {
+            ECMULT_TABLE_GET_GE(&tmpa, st->pre_a, n, WINDOW_A);
+            secp256k1_gej_add_ge_var_relaxed(r, r, &tmpa);
         }
-        if (i < bits_na_lam && (n = wnaf_na_lam[i])) {
-            ECMULT_TABLE_GET_GE(&tmpa, pre_a_lam, n, WINDOW_A);
-            secp256k1_gej_add_ge_var(r, r, &tmpa, NULL);
+        if (i < bits_na_lam && (n = st->wnaf_na_lam[i])) {
+            ECMULT_TABLE_GET_GE(&tmpa, st->pre_a_lam, n, WINDOW_A);
+            secp256k1_gej_add_ge_var_relaxed(r, r, &tmpa);
         }
-        if (i < bits_ng_1 && (n = wnaf_ng_1[i])) {
-            ECMULT_TABLE_GET_GE_STORAGE(&tmpa, *ctx->pre_g, n, WINDOW_G);
-            secp256k1_gej_add_zinv_var(r, r, &tmpa, &Z);
+        if (i < bits_ng_1 && (n = st->wnaf_ng_1[i])) {
+            ECMULT_TABLE_GET_GE_STORAGE_STRIDED(&tmpa, pre_g, n, wg, g_stride);
+            secp256k1_gej_add_zinv_var_relaxed(r, r, &tmpa, &Z);
         }
-        if (i < bits_ng_128 && (n = wnaf_ng_128[i])) {
-            ECMULT_TABLE_GET_GE_STORAGE(&tmpa, *ctx->pre_g_128, n, WINDOW_G);
-            secp256k1_gej_add_zinv_var(r, r, &tmpa, &Z);
+        if (i < bits_ng_128 && (n = st->wnaf_ng_128[i])) {
+            ECMULT_TABLE_GET_GE_STORAGE_STRIDED(&tmpa, pre_g_128, n, wg, g_stride);
+            secp256k1_gej_add_zinv_var_relaxed(r, r, &tmpa, &Z);
         }
 #else
-        if (i < bits_na && (n = wnaf_na[i])) {
-            ECMULT_TABLE_GET_GE(&tmpa, pre_a, n, WINDOW_A);
-            secp256k1_gej_add_ge_var(r, r, &tmpa, NULL);
+        if (i < bits_na && (n = st->wnaf_na[i])) {
+            ECMULT_TABLE_GET_GE(&tmpa, st->pre_a, n, WINDOW_A);
+            secp256k1_gej_add_ge_var_relaxed(r, r, &tmpa);
         }
-        if (i < bits_ng && (n = wnaf_ng[i])) {
-            ECMULT_TABLE_GET_GE_STORAGE(&tmpa, *ctx->pre_g, n, WINDOW_G);
-            secp256k1_gej_add_zinv_var(r, r, &tmpa, &Z);
+        if (i < bits_ng && (n = st->wnaf_ng[i])) {
+            ECMULT_TABLE_GET_GE_STORAGE(&tmpa, *ctx->pre_g, n, wg);
+            secp256k1_gej_add_zinv_var_relaxed(r, r, &tmpa, &Z);
         }
 #endif
     }
@@ -403,4 +912,89 @@ static void secp256k1_ecmult(const secp256k1_ecmult_context *ctx, secp256k1_gej
     }
 }
 
+static void secp256k1_ecmult(const secp256k1_ecmult_context *ctx, secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_scalar *na, const secp256k1_scalar *ng) {
+    secp256k1_ecmult_scratch(ctx, NULL, r, a, na, ng);
+}
+
+#include "ecmult_pippenger_impl.h"
+
+/* Scratch size sufficient for one secp256k1_ecmult_multi_var call over n points. */
+#define SECP256K1_ECMULT_MULTI_SCRATCH_SIZE(n) \
+    ((n) * (ECMULT_TABLE_SIZE(WINDOW_A) * sizeof(secp256k1_ge) + 256 * sizeof(int) + sizeof(int)) + 3 * 16)
+
+static int secp256k1_ecmult_multi_var(const secp256k1_ecmult_context *ctx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *scalars, const secp256k1_gej *points, size_t n, const secp256k1_scalar *ng) {
+    secp256k1_ge tmpa;
+    secp256k1_ge *pre_a;
+    int *wnaf_na;
+    int *bits_na;
+    const secp256k1_ge_storage *pre_g = *ctx->pre_g;
+    int g_stride = 1;
+    int wnaf_ng[256];
+    int bits_ng = 0;
+    int bits = 0;
+    size_t k;
+    int i;
+
+#ifdef USE_ENDOMORPHISM
+    if (ctx->pre_g_interleaved) {
+        g_stride = 2;
+    }
+#endif
+
+    if (n >= ECMULT_PIPPENGER_THRESHOLD) {
+        /* The bucket method needs far less scratch than Strauss, so a scratch
+         * sized for this call can never make it fail. */
+        return secp256k1_ecmult_pippenger_var(scratch, r, scalars, points, n, ng);
+    }
+
+    secp256k1_scratch_reset(scratch);
+    pre_a = (secp256k1_ge*)secp256k1_scratch_alloc(scratch, n * ECMULT_TABLE_SIZE(WINDOW_A) * sizeof(secp256k1_ge));
+    wnaf_na = (int*)secp256k1_scratch_alloc(scratch, n * 256 * sizeof(int));
+    bits_na = (int*)secp256k1_scratch_alloc(scratch, n * sizeof(int));
+    if (pre_a == NULL || wnaf_na == NULL || bits_na == NULL) {
+        return 0;
+    }
+
+    /* Build a wnaf representation and an affine odd-multiples table per point.
+     * The tables are made truly affine (one field inverse per point), so the
+     * accumulation loop below can use the plain mixed addition formula. */
+    for (k = 0; k < n; k++) {
+        secp256k1_gej prej[ECMULT_TABLE_SIZE(WINDOW_A)];
+        secp256k1_fe zr[ECMULT_TABLE_SIZE(WINDOW_A)];
+        if (secp256k1_gej_is_infinity(&points[k]) || secp256k1_scalar_is_zero(&scalars[k])) {
+            bits_na[k] = 0;
+            continue;
+        }
+        bits_na[k] = secp256k1_ecmult_wnaf(wnaf_na + k*256, 256, &scalars[k], WINDOW_A);
+        if (bits_na[k] > bits) {
+            bits = bits_na[k];
+        }
+        secp256k1_ecmult_odd_multiples_table(ECMULT_TABLE_SIZE(WINDOW_A), prej, zr, &points[k]);
+        secp256k1_ge_set_table_gej_var(pre_a + k*ECMULT_TABLE_SIZE(WINDOW_A), prej, zr, ECMULT_TABLE_SIZE(WINDOW_A));
+    }
+    if (ng != NULL && !secp256k1_scalar_is_zero(ng)) {
+        bits_ng = secp256k1_ecmult_wnaf(wnaf_ng, 256, ng, ctx->window_g);
+        if (bits_ng > bits) {
+            bits = bits_ng;
+        }
+    }
+
+    secp256k1_gej_set_infinity(r);
+    for (i = bits - 1; i >= 0; i--) {
+        int w;
+        secp256k1_gej_double_var(r, r, NULL);
+        for (k = 0; k < n; k++) {
+            if (i < bits_na[k] && (w = wnaf_na[k*256 + i])) {
+                ECMULT_TABLE_GET_GE(&tmpa, pre_a + k*ECMULT_TABLE_SIZE(WINDOW_A), w, WINDOW_A);
+                secp256k1_gej_add_ge_var_relaxed(r, r, &tmpa);
+            }
+        }
+        if (i < bits_ng && (w = wnaf_ng[i])) {
+            ECMULT_TABLE_GET_GE_STORAGE_STRIDED(&tmpa, pre_g, w, ctx->window_g, g_stride);
+            secp256k1_gej_add_ge_var_relaxed(r, r, &tmpa);
+        }
+    }
+    return 1;
+}
+
 #endif
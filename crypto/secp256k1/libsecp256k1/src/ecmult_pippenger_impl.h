@@ -0,0 +1,112 @@
+/**********************************************************************
+ * Copyright (c) 2017 The go-ethereumai Authors                       *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_ECMULT_PIPPENGER_IMPL_H_
+#define _SECP256K1_ECMULT_PIPPENGER_IMPL_H_
+
+#include "group.h"
+#include "scalar.h"
+#include "ecmult.h"
+
+/* Pippenger's bucket method for multi-scalar multiplication.
+ *
+ * The scalars are processed in windows of bucket_window bits. Within a
+ * window every point whose digit is d is added into bucket d, and the
+ * buckets are then combined with the running-sum trick so bucket d ends up
+ * weighted by d using only two additions per bucket. Amortized over many
+ * points this needs O(n / log n) group operations per point, beating the
+ * Strauss path above some size; the per-point cost is one addition per
+ * window regardless of digit value. */
+
+/* Number of points above which secp256k1_ecmult_multi_var prefers the
+ * bucket method over Strauss. */
+#define ECMULT_PIPPENGER_THRESHOLD 88
+
+static int secp256k1_pippenger_bucket_window(size_t n) {
+    if (n <= 4) {
+        return 2;
+    } else if (n <= 20) {
+        return 3;
+    } else if (n <= 57) {
+        return 4;
+    } else if (n <= 136) {
+        return 5;
+    } else if (n <= 235) {
+        return 6;
+    } else if (n <= 1260) {
+        return 7;
+    } else if (n <= 4420) {
+        return 9;
+    } else if (n <= 7880) {
+        return 10;
+    } else if (n <= 16050) {
+        return 11;
+    }
+    return 12;
+}
+
+static int secp256k1_ecmult_pippenger_var(secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *scalars, const secp256k1_gej *points, size_t n, const secp256k1_scalar *ng) {
+    int bucket_window = secp256k1_pippenger_bucket_window(n);
+    size_t nbuckets = (size_t)1 << bucket_window;
+    int nwindows = (255 / bucket_window) + 1;
+    secp256k1_gej *buckets;
+    secp256k1_gej running;
+    secp256k1_gej gj;
+    int have_ng = ng != NULL && !secp256k1_scalar_is_zero(ng);
+    int wi;
+    size_t i, b;
+
+    secp256k1_scratch_reset(scratch);
+    buckets = (secp256k1_gej*)secp256k1_scratch_alloc(scratch, nbuckets * sizeof(*buckets));
+    if (buckets == NULL) {
+        return 0;
+    }
+    if (have_ng) {
+        secp256k1_gej_set_ge(&gj, &secp256k1_ge_const_g);
+    }
+
+    secp256k1_gej_set_infinity(r);
+    for (wi = nwindows - 1; wi >= 0; wi--) {
+        int offset = wi * bucket_window;
+        int bits = offset + bucket_window <= 256 ? bucket_window : 256 - offset;
+        int j;
+        unsigned int digit;
+        if (wi != nwindows - 1) {
+            for (j = 0; j < bucket_window; j++) {
+                secp256k1_gej_double_var(r, r, NULL);
+            }
+        }
+        for (b = 0; b < nbuckets; b++) {
+            secp256k1_gej_set_infinity(&buckets[b]);
+        }
+        for (i = 0; i < n; i++) {
+            if (secp256k1_gej_is_infinity(&points[i])) {
+                continue;
+            }
+            digit = secp256k1_scalar_get_bits_var(&scalars[i], offset, bits);
+            if (digit) {
+                secp256k1_gej_add_var(&buckets[digit], &buckets[digit], &points[i], NULL);
+            }
+        }
+        if (have_ng) {
+            digit = secp256k1_scalar_get_bits_var(ng, offset, bits);
+            if (digit) {
+                secp256k1_gej_add_var(&buckets[digit], &buckets[digit], &gj, NULL);
+            }
+        }
+        /* Running sum: after step b the running total holds the sum of all
+         * buckets >= b, so adding it into r once per step weights bucket b
+         * by exactly b. */
+        secp256k1_gej_set_infinity(&running);
+        for (b = nbuckets - 1; b > 0; b--) {
+            secp256k1_gej_add_var(&running, &running, &buckets[b], NULL);
+            secp256k1_gej_add_var(r, r, &running, NULL);
+        }
+    }
+    return 1;
+}
+
+#endif
@@ -84,6 +84,18 @@ static void secp256k1_fe_negate(secp256k1_fe *r, const secp256k1_fe *a, int m);
  *  small integer. */
 static void secp256k1_fe_mul_int(secp256k1_fe *r, int a);
 
+/** Doubles a field element: secp256k1_fe_mul_int specialized to the constant 2, spelled as a limb
+ *  shift. Doubles the magnitude. */
+static void secp256k1_fe_double(secp256k1_fe *r);
+
+/** Triples a field element: secp256k1_fe_mul_int specialized to the constant 3, spelled as a limb
+ *  shift-add. Triples the magnitude. */
+static void secp256k1_fe_triple(secp256k1_fe *r);
+
+/** Quadruples a field element: secp256k1_fe_mul_int specialized to the constant 4, spelled as a limb
+ *  shift. Multiplies the magnitude by 4. */
+static void secp256k1_fe_quad(secp256k1_fe *r);
+
 /** Adds a field element to another. The result has the sum of the inputs' magnitudes as magnitude. */
 static void secp256k1_fe_add(secp256k1_fe *r, const secp256k1_fe *a);
 
@@ -402,6 +402,65 @@ SECP256K1_INLINE static void secp256k1_fe_mul_int(secp256k1_fe *r, int a) {
 #endif
 }
 
+/* Specializations of secp256k1_fe_mul_int for the constants the group
+ * formulas use, spelled as shifts and shift-adds so every target compiles
+ * them to the same few instructions instead of relying on the optimizer to
+ * strength-reduce a constant multiply. Their names also carry the
+ * magnitude growth at the call site. */
+SECP256K1_INLINE static void secp256k1_fe_double(secp256k1_fe *r) {
+    r->n[0] <<= 1;
+    r->n[1] <<= 1;
+    r->n[2] <<= 1;
+    r->n[3] <<= 1;
+    r->n[4] <<= 1;
+    r->n[5] <<= 1;
+    r->n[6] <<= 1;
+    r->n[7] <<= 1;
+    r->n[8] <<= 1;
+    r->n[9] <<= 1;
+#ifdef VERIFY
+    r->magnitude *= 2;
+    r->normalized = 0;
+    secp256k1_fe_verify(r);
+#endif
+}
+
+SECP256K1_INLINE static void secp256k1_fe_triple(secp256k1_fe *r) {
+    r->n[0] += r->n[0] << 1;
+    r->n[1] += r->n[1] << 1;
+    r->n[2] += r->n[2] << 1;
+    r->n[3] += r->n[3] << 1;
+    r->n[4] += r->n[4] << 1;
+    r->n[5] += r->n[5] << 1;
+    r->n[6] += r->n[6] << 1;
+    r->n[7] += r->n[7] << 1;
+    r->n[8] += r->n[8] << 1;
+    r->n[9] += r->n[9] << 1;
+#ifdef VERIFY
+    r->magnitude *= 3;
+    r->normalized = 0;
+    secp256k1_fe_verify(r);
+#endif
+}
+
+SECP256K1_INLINE static void secp256k1_fe_quad(secp256k1_fe *r) {
+    r->n[0] <<= 2;
+    r->n[1] <<= 2;
+    r->n[2] <<= 2;
+    r->n[3] <<= 2;
+    r->n[4] <<= 2;
+    r->n[5] <<= 2;
+    r->n[6] <<= 2;
+    r->n[7] <<= 2;
+    r->n[8] <<= 2;
+    r->n[9] <<= 2;
+#ifdef VERIFY
+    r->magnitude *= 4;
+    r->normalized = 0;
+    secp256k1_fe_verify(r);
+#endif
+}
+
 SECP256K1_INLINE static void secp256k1_fe_add(secp256k1_fe *r, const secp256k1_fe *a) {
 #ifdef VERIFY
     secp256k1_fe_verify(a);
@@ -1049,6 +1108,7 @@ static void secp256k1_fe_mul(secp256k1_fe *r, const secp256k1_fe *a, const secp2
     secp256k1_fe_verify(b);
     VERIFY_CHECK(r != b);
 #endif
+    SECP256K1_OPCOUNT(fe_mul);
     secp256k1_fe_mul_inner(r->n, a->n, b->n);
 #ifdef VERIFY
     r->magnitude = 1;
@@ -1062,6 +1122,7 @@ static void secp256k1_fe_sqr(secp256k1_fe *r, const secp256k1_fe *a) {
     VERIFY_CHECK(a->magnitude <= 8);
     secp256k1_fe_verify(a);
 #endif
+    SECP256K1_OPCOUNT(fe_sqr);
     secp256k1_fe_sqr_inner(r->n, a->n);
 #ifdef VERIFY
     r->magnitude = 1;
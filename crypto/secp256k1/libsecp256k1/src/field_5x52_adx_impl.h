@@ -0,0 +1,81 @@
+/**********************************************************************
+ * Copyright (c) 2017 The go-ethereumai Authors                       *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_FIELD_ADX_IMPL_H_
+#define _SECP256K1_FIELD_ADX_IMPL_H_
+
+#include "cpu_features.h"
+
+/* Runtime-dispatched 5x52 field kernels for x86_64.
+ *
+ * The portable int128 inner kernels are expanded twice: once with the
+ * baseline ISA and once allowing the compiler to emit MULX/ADCX/ADOX, which
+ * shortens the carry chains that dominate fe_mul/fe_sqr. CPUID picks the
+ * variant once per process on the first call. The second expansion needs the
+ * include guard of the int128 header dropped. */
+
+#define secp256k1_fe_mul_inner secp256k1_fe_mul_inner_generic
+#define secp256k1_fe_sqr_inner secp256k1_fe_sqr_inner_generic
+#include "field_5x52_int128_impl.h"
+#undef secp256k1_fe_mul_inner
+#undef secp256k1_fe_sqr_inner
+#undef _SECP256K1_FIELD_INNER5X52_IMPL_H_
+
+#pragma GCC push_options
+#pragma GCC target("bmi2,adx")
+#define secp256k1_fe_mul_inner secp256k1_fe_mul_inner_adx
+#define secp256k1_fe_sqr_inner secp256k1_fe_sqr_inner_adx
+#include "field_5x52_int128_impl.h"
+#undef secp256k1_fe_mul_inner
+#undef secp256k1_fe_sqr_inner
+#pragma GCC pop_options
+
+static int secp256k1_fe_have_adx(void) {
+    uint32_t flags = secp256k1_cpu_features();
+    return (flags & SECP256K1_CPU_BMI2) != 0 && (flags & SECP256K1_CPU_ADX) != 0;
+}
+
+static void secp256k1_fe_mul_inner_select(uint64_t *r, const uint64_t *a, const uint64_t * SECP256K1_RESTRICT b);
+static void secp256k1_fe_sqr_inner_select(uint64_t *r, const uint64_t *a);
+
+/* Both pointers start at the selector; the first call through either swings
+ * both to the CPUID-chosen kernel. Re-running the selection on a rare race is
+ * harmless since every outcome is identical. */
+static void (*secp256k1_fe_mul_inner_ptr)(uint64_t *r, const uint64_t *a, const uint64_t * SECP256K1_RESTRICT b) = secp256k1_fe_mul_inner_select;
+static void (*secp256k1_fe_sqr_inner_ptr)(uint64_t *r, const uint64_t *a) = secp256k1_fe_sqr_inner_select;
+
+static void secp256k1_fe_mul_inner_select(uint64_t *r, const uint64_t *a, const uint64_t * SECP256K1_RESTRICT b) {
+    int adx = secp256k1_fe_have_adx();
+    secp256k1_fe_mul_inner_ptr = adx ? secp256k1_fe_mul_inner_adx : secp256k1_fe_mul_inner_generic;
+    secp256k1_fe_sqr_inner_ptr = adx ? secp256k1_fe_sqr_inner_adx : secp256k1_fe_sqr_inner_generic;
+    secp256k1_fe_mul_inner_ptr(r, a, b);
+}
+
+static void secp256k1_fe_sqr_inner_select(uint64_t *r, const uint64_t *a) {
+    int adx = secp256k1_fe_have_adx();
+    secp256k1_fe_mul_inner_ptr = adx ? secp256k1_fe_mul_inner_adx : secp256k1_fe_mul_inner_generic;
+    secp256k1_fe_sqr_inner_ptr = adx ? secp256k1_fe_sqr_inner_adx : secp256k1_fe_sqr_inner_generic;
+    secp256k1_fe_sqr_inner_ptr(r, a);
+}
+
+SECP256K1_INLINE static void secp256k1_fe_mul_inner(uint64_t *r, const uint64_t *a, const uint64_t * SECP256K1_RESTRICT b) {
+    secp256k1_fe_mul_inner_ptr(r, a, b);
+}
+
+SECP256K1_INLINE static void secp256k1_fe_sqr_inner(uint64_t *r, const uint64_t *a) {
+    secp256k1_fe_sqr_inner_ptr(r, a);
+}
+
+/* Resolve the kernel pointers eagerly; called from secp256k1_context_create
+ * so no signing or verification ever pays the selection branch. */
+#define SECP256K1_HAVE_FE_SELECT_IMPL 1
+static void secp256k1_fe_select_impl(void) {
+    int adx = secp256k1_fe_have_adx();
+    secp256k1_fe_mul_inner_ptr = adx ? secp256k1_fe_mul_inner_adx : secp256k1_fe_mul_inner_generic;
+    secp256k1_fe_sqr_inner_ptr = adx ? secp256k1_fe_sqr_inner_adx : secp256k1_fe_sqr_inner_generic;
+}
+
+#endif
@@ -0,0 +1,98 @@
+/**********************************************************************
+ * Copyright (c) 2017 The go-ethereumai Authors                       *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_FIELD_X4_IMPL_H_
+#define _SECP256K1_FIELD_X4_IMPL_H_
+
+/* 4-lane batch interface over the 5x52 field representation.
+ *
+ * Independent per-transaction recoveries have no data dependencies between
+ * their field operations, so four of them can share one instruction stream.
+ * The batch entry points below fix the API and memory layout for that shape:
+ * four elements in transposed (limb-major) order so a lane kernel can load
+ * one limb of all four elements with a single aligned access.
+ *
+ * The current kernel interleaves the four scalar multiplications, which
+ * already overlaps their multiply latencies on wide cores. A true AVX2 lane
+ * implementation needs a radix change (52-bit limbs do not fit the 32x32
+ * vector multiplier), which is deliberately kept out of this layer so it can
+ * be swapped in behind the same API. */
+
+#define SECP256K1_FE_X4_LANES 4
+
+typedef struct {
+    /* limbs[i][j] is limb i of lane j. */
+    uint64_t limbs[5][SECP256K1_FE_X4_LANES];
+} secp256k1_fe_x4;
+
+/* Gather four field elements into transposed lane form. */
+static void secp256k1_fe_x4_gather(secp256k1_fe_x4 *r, const secp256k1_fe *a) {
+    int i, j;
+    for (i = 0; i < 5; i++) {
+        for (j = 0; j < SECP256K1_FE_X4_LANES; j++) {
+            r->limbs[i][j] = a[j].n[i];
+        }
+    }
+}
+
+/* Scatter transposed lane form back into four field elements. The outputs
+ * inherit the magnitude/normalized bookkeeping of the scalar kernel. */
+static void secp256k1_fe_x4_scatter(secp256k1_fe *r, const secp256k1_fe_x4 *a) {
+    int i, j;
+    for (j = 0; j < SECP256K1_FE_X4_LANES; j++) {
+        for (i = 0; i < 5; i++) {
+            r[j].n[i] = a->limbs[i][j];
+        }
+#ifdef VERIFY
+        r[j].magnitude = 1;
+        r[j].normalized = 0;
+#endif
+    }
+}
+
+/* r[j] = a[j] * b[j] for four independent lanes. */
+static void secp256k1_fe_mul_x4(secp256k1_fe_x4 *r, const secp256k1_fe_x4 *a, const secp256k1_fe_x4 *b) {
+    uint64_t ta[4][5], tb[4][5], tr[4][5];
+    int i, j;
+    for (j = 0; j < SECP256K1_FE_X4_LANES; j++) {
+        for (i = 0; i < 5; i++) {
+            ta[j][i] = a->limbs[i][j];
+            tb[j][i] = b->limbs[i][j];
+        }
+    }
+    /* Four independent carry chains; the compiler is free to interleave. */
+    secp256k1_fe_mul_inner(tr[0], ta[0], tb[0]);
+    secp256k1_fe_mul_inner(tr[1], ta[1], tb[1]);
+    secp256k1_fe_mul_inner(tr[2], ta[2], tb[2]);
+    secp256k1_fe_mul_inner(tr[3], ta[3], tb[3]);
+    for (j = 0; j < SECP256K1_FE_X4_LANES; j++) {
+        for (i = 0; i < 5; i++) {
+            r->limbs[i][j] = tr[j][i];
+        }
+    }
+}
+
+/* r[j] = a[j]^2 for four independent lanes. */
+static void secp256k1_fe_sqr_x4(secp256k1_fe_x4 *r, const secp256k1_fe_x4 *a) {
+    uint64_t ta[4][5], tr[4][5];
+    int i, j;
+    for (j = 0; j < SECP256K1_FE_X4_LANES; j++) {
+        for (i = 0; i < 5; i++) {
+            ta[j][i] = a->limbs[i][j];
+        }
+    }
+    secp256k1_fe_sqr_inner(tr[0], ta[0]);
+    secp256k1_fe_sqr_inner(tr[1], ta[1]);
+    secp256k1_fe_sqr_inner(tr[2], ta[2]);
+    secp256k1_fe_sqr_inner(tr[3], ta[3]);
+    for (j = 0; j < SECP256K1_FE_X4_LANES; j++) {
+        for (i = 0; i < 5; i++) {
+            r->limbs[i][j] = tr[j][i];
+        }
+    }
+}
+
+#endif
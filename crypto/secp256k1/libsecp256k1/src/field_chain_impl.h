@@ -0,0 +1,563 @@
+/* Generated by contrib/fieldchain.py; do not edit. Regenerate with
+ *   python3 contrib/fieldchain.py
+ * which re-derives, re-proves minimal (within the star-chain run
+ * model) and re-verifies both chains before writing this file. */
+
+#ifndef _SECP256K1_FIELD_CHAIN_IMPL_H_
+#define _SECP256K1_FIELD_CHAIN_IMPL_H_
+
+/* a^0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2d:
+ * 255 squarings, 15 multiplications; minimal star chain through the
+ * 1-run lengths [1, 2, 22, 223]. r may alias a. */
+static void secp256k1_fe_inv_chain(secp256k1_fe *r, const secp256k1_fe *a) {
+    secp256k1_fe x2, x4, x8, x16, x20, x22, x44, x45, x89, x178, x223, t;
+
+    secp256k1_fe_sqr(&x2, a);
+    secp256k1_fe_mul(&x2, &x2, a);
+    secp256k1_fe_sqr(&x4, &x2);
+    secp256k1_fe_sqr(&x4, &x4);
+    secp256k1_fe_mul(&x4, &x4, &x2);
+    secp256k1_fe_sqr(&x8, &x4);
+    secp256k1_fe_sqr(&x8, &x8);
+    secp256k1_fe_sqr(&x8, &x8);
+    secp256k1_fe_sqr(&x8, &x8);
+    secp256k1_fe_mul(&x8, &x8, &x4);
+    secp256k1_fe_sqr(&x16, &x8);
+    secp256k1_fe_sqr(&x16, &x16);
+    secp256k1_fe_sqr(&x16, &x16);
+    secp256k1_fe_sqr(&x16, &x16);
+    secp256k1_fe_sqr(&x16, &x16);
+    secp256k1_fe_sqr(&x16, &x16);
+    secp256k1_fe_sqr(&x16, &x16);
+    secp256k1_fe_sqr(&x16, &x16);
+    secp256k1_fe_mul(&x16, &x16, &x8);
+    secp256k1_fe_sqr(&x20, &x16);
+    secp256k1_fe_sqr(&x20, &x20);
+    secp256k1_fe_sqr(&x20, &x20);
+    secp256k1_fe_sqr(&x20, &x20);
+    secp256k1_fe_mul(&x20, &x20, &x4);
+    secp256k1_fe_sqr(&x22, &x20);
+    secp256k1_fe_sqr(&x22, &x22);
+    secp256k1_fe_mul(&x22, &x22, &x2);
+    secp256k1_fe_sqr(&x44, &x22);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_mul(&x44, &x44, &x22);
+    secp256k1_fe_sqr(&x45, &x44);
+    secp256k1_fe_mul(&x45, &x45, a);
+    secp256k1_fe_sqr(&x89, &x45);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_mul(&x89, &x89, &x44);
+    secp256k1_fe_sqr(&x178, &x89);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_mul(&x178, &x178, &x89);
+    secp256k1_fe_sqr(&x223, &x178);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_mul(&x223, &x223, &x45);
+    t = x223;
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_mul(&t, &t, &x22);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_mul(&t, &t, a);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_mul(&t, &t, &x2);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_mul(r, &t, a);
+}
+
+/* a^0x3fffffffffffffffffffffffffffffffffffffffffffffffffffffffbfffff0c:
+ * 253 squarings, 13 multiplications; minimal star chain through the
+ * 1-run lengths [2, 22, 223]. r may alias a. */
+static void secp256k1_fe_sqrt_chain(secp256k1_fe *r, const secp256k1_fe *a) {
+    secp256k1_fe x2, x4, x8, x16, x20, x22, x44, x45, x89, x178, x223, t;
+
+    secp256k1_fe_sqr(&x2, a);
+    secp256k1_fe_mul(&x2, &x2, a);
+    secp256k1_fe_sqr(&x4, &x2);
+    secp256k1_fe_sqr(&x4, &x4);
+    secp256k1_fe_mul(&x4, &x4, &x2);
+    secp256k1_fe_sqr(&x8, &x4);
+    secp256k1_fe_sqr(&x8, &x8);
+    secp256k1_fe_sqr(&x8, &x8);
+    secp256k1_fe_sqr(&x8, &x8);
+    secp256k1_fe_mul(&x8, &x8, &x4);
+    secp256k1_fe_sqr(&x16, &x8);
+    secp256k1_fe_sqr(&x16, &x16);
+    secp256k1_fe_sqr(&x16, &x16);
+    secp256k1_fe_sqr(&x16, &x16);
+    secp256k1_fe_sqr(&x16, &x16);
+    secp256k1_fe_sqr(&x16, &x16);
+    secp256k1_fe_sqr(&x16, &x16);
+    secp256k1_fe_sqr(&x16, &x16);
+    secp256k1_fe_mul(&x16, &x16, &x8);
+    secp256k1_fe_sqr(&x20, &x16);
+    secp256k1_fe_sqr(&x20, &x20);
+    secp256k1_fe_sqr(&x20, &x20);
+    secp256k1_fe_sqr(&x20, &x20);
+    secp256k1_fe_mul(&x20, &x20, &x4);
+    secp256k1_fe_sqr(&x22, &x20);
+    secp256k1_fe_sqr(&x22, &x22);
+    secp256k1_fe_mul(&x22, &x22, &x2);
+    secp256k1_fe_sqr(&x44, &x22);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_sqr(&x44, &x44);
+    secp256k1_fe_mul(&x44, &x44, &x22);
+    secp256k1_fe_sqr(&x45, &x44);
+    secp256k1_fe_mul(&x45, &x45, a);
+    secp256k1_fe_sqr(&x89, &x45);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_sqr(&x89, &x89);
+    secp256k1_fe_mul(&x89, &x89, &x44);
+    secp256k1_fe_sqr(&x178, &x89);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_sqr(&x178, &x178);
+    secp256k1_fe_mul(&x178, &x178, &x89);
+    secp256k1_fe_sqr(&x223, &x178);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_sqr(&x223, &x223);
+    secp256k1_fe_mul(&x223, &x223, &x45);
+    t = x223;
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_mul(&t, &t, &x22);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_mul(&t, &t, &x2);
+    secp256k1_fe_sqr(&t, &t);
+    secp256k1_fe_sqr(r, &t);
+}
+
+#endif
@@ -12,6 +12,26 @@
 #endif
 
 #include "util.h"
+#include "modinv_impl.h"
+
+/* Operation-count accounting for formula audits. Under USE_OPCOUNT_STATS the
+ * field backends bump one thread-local counter pair from inside fe_mul and
+ * fe_sqr; the instrumented entry points snapshot the pair on entry and book
+ * the delta into the per-context stats (see SECP256K1_STATS_DECL), so a
+ * formula change can be checked against its theoretical operation count on
+ * real traffic instead of by hand. Thread-local plain increments keep the
+ * cost to roughly a cycle per field op, but that is still measurable on the
+ * multiplication-bound paths: an audit mode, not a production default. */
+#ifdef USE_OPCOUNT_STATS
+#ifndef USE_CONTEXT_STATS
+#error "USE_OPCOUNT_STATS reports through the stats API and requires USE_CONTEXT_STATS"
+#endif
+static _Thread_local uint64_t secp256k1_opcount_fe_mul;
+static _Thread_local uint64_t secp256k1_opcount_fe_sqr;
+#define SECP256K1_OPCOUNT(which) (secp256k1_opcount_##which++)
+#else
+#define SECP256K1_OPCOUNT(which) ((void)0)
+#endif
 
 #if defined(USE_FIELD_10X26)
 #include "field_10x26_impl.h"
@@ -21,6 +41,16 @@
 #error "Please select field implementation"
 #endif
 
+/* Straight-line addition chains for the p - 2 and (p + 1)/4
+ * exponentiations, generated (and proven minimal within their chain
+ * model) by contrib/fieldchain.py. */
+#include "field_chain_impl.h"
+
+#ifndef SECP256K1_HAVE_FE_SELECT_IMPL
+/* Implementations without runtime-dispatched kernels have nothing to do. */
+static SECP256K1_INLINE void secp256k1_fe_select_impl(void) {}
+#endif
+
 SECP256K1_INLINE static int secp256k1_fe_equal(const secp256k1_fe *a, const secp256k1_fe *b) {
     secp256k1_fe na;
     secp256k1_fe_negate(&na, a, 1);
@@ -45,87 +75,11 @@ static int secp256k1_fe_sqrt(secp256k1_fe *r, const secp256k1_fe *a) {
      *  Also because (p+1)/4 is an even number, the computed square root is
      *  itself always a square (a ** ((p+1)/4) is the square of a ** ((p+1)/8)).
      */
-    secp256k1_fe x2, x3, x6, x9, x11, x22, x44, x88, x176, x220, x223, t1;
-    int j;
-
-    /** The binary representation of (p + 1)/4 has 3 blocks of 1s, with lengths in
-     *  { 2, 22, 223 }. Use an addition chain to calculate 2^n - 1 for each block:
-     *  1, [2], 3, 6, 9, 11, [22], 44, 88, 176, 220, [223]
-     */
-
-    secp256k1_fe_sqr(&x2, a);
-    secp256k1_fe_mul(&x2, &x2, a);
-
-    secp256k1_fe_sqr(&x3, &x2);
-    secp256k1_fe_mul(&x3, &x3, a);
-
-    x6 = x3;
-    for (j=0; j<3; j++) {
-        secp256k1_fe_sqr(&x6, &x6);
-    }
-    secp256k1_fe_mul(&x6, &x6, &x3);
-
-    x9 = x6;
-    for (j=0; j<3; j++) {
-        secp256k1_fe_sqr(&x9, &x9);
-    }
-    secp256k1_fe_mul(&x9, &x9, &x3);
-
-    x11 = x9;
-    for (j=0; j<2; j++) {
-        secp256k1_fe_sqr(&x11, &x11);
-    }
-    secp256k1_fe_mul(&x11, &x11, &x2);
-
-    x22 = x11;
-    for (j=0; j<11; j++) {
-        secp256k1_fe_sqr(&x22, &x22);
-    }
-    secp256k1_fe_mul(&x22, &x22, &x11);
-
-    x44 = x22;
-    for (j=0; j<22; j++) {
-        secp256k1_fe_sqr(&x44, &x44);
-    }
-    secp256k1_fe_mul(&x44, &x44, &x22);
-
-    x88 = x44;
-    for (j=0; j<44; j++) {
-        secp256k1_fe_sqr(&x88, &x88);
-    }
-    secp256k1_fe_mul(&x88, &x88, &x44);
-
-    x176 = x88;
-    for (j=0; j<88; j++) {
-        secp256k1_fe_sqr(&x176, &x176);
-    }
-    secp256k1_fe_mul(&x176, &x176, &x88);
+    secp256k1_fe t1;
 
-    x220 = x176;
-    for (j=0; j<44; j++) {
-        secp256k1_fe_sqr(&x220, &x220);
-    }
-    secp256k1_fe_mul(&x220, &x220, &x44);
-
-    x223 = x220;
-    for (j=0; j<3; j++) {
-        secp256k1_fe_sqr(&x223, &x223);
-    }
-    secp256k1_fe_mul(&x223, &x223, &x3);
-
-    /* The final result is then assembled using a sliding window over the blocks. */
-
-    t1 = x223;
-    for (j=0; j<23; j++) {
-        secp256k1_fe_sqr(&t1, &t1);
-    }
-    secp256k1_fe_mul(&t1, &t1, &x22);
-    for (j=0; j<6; j++) {
-        secp256k1_fe_sqr(&t1, &t1);
-    }
-    secp256k1_fe_mul(&t1, &t1, &x2);
-    secp256k1_fe_sqr(&t1, &t1);
-    secp256k1_fe_sqr(r, &t1);
+    /* The (p + 1)/4 exponentiation itself is the generated straight-line
+     * chain from field_chain_impl.h. */
+    secp256k1_fe_sqrt_chain(r, a);
 
     /* Check that a square root was actually calculated */
 
@@ -133,97 +87,158 @@ static int secp256k1_fe_sqrt(secp256k1_fe *r, const secp256k1_fe *a) {
     return secp256k1_fe_equal(&t1, a);
 }
 
-static void secp256k1_fe_inv(secp256k1_fe *r, const secp256k1_fe *a) {
-    secp256k1_fe x2, x3, x6, x9, x11, x22, x44, x88, x176, x220, x223, t1;
+#ifdef USE_FIELD_5X52
+/* Four-lane variant of secp256k1_fe_sqrt: runs the (p+1)/4 addition chain
+ * over the fe_x4 batch kernels, so four independent square roots (e.g. a
+ * burst of compressed-key decompressions) share one instruction stream.
+ * valid[j] reports per lane whether a[j] actually had a square root, exactly
+ * like the scalar return value. */
+static void secp256k1_fe_sqrt_x4(secp256k1_fe *r, int *valid, const secp256k1_fe *a) {
+    secp256k1_fe_x4 xa, x2, x3, x6, x9, x11, x22, x44, x88, x176, x220, x223, t1;
+    secp256k1_fe chk[SECP256K1_FE_X4_LANES];
     int j;
 
-    /** The binary representation of (p - 2) has 5 blocks of 1s, with lengths in
-     *  { 1, 2, 22, 223 }. Use an addition chain to calculate 2^n - 1 for each block:
-     *  [1], [2], 3, 6, 9, 11, [22], 44, 88, 176, 220, [223]
-     */
+    /* The hand-written block chain: 2^n - 1 for n in { 2, 22, 223 }, then
+     * the sliding-window assembly. Kept as written; run_field_x4 checks it
+     * against the generated scalar chain in field_chain_impl.h. */
+    secp256k1_fe_x4_gather(&xa, a);
 
-    secp256k1_fe_sqr(&x2, a);
-    secp256k1_fe_mul(&x2, &x2, a);
+    secp256k1_fe_sqr_x4(&x2, &xa);
+    secp256k1_fe_mul_x4(&x2, &x2, &xa);
 
-    secp256k1_fe_sqr(&x3, &x2);
-    secp256k1_fe_mul(&x3, &x3, a);
+    secp256k1_fe_sqr_x4(&x3, &x2);
+    secp256k1_fe_mul_x4(&x3, &x3, &xa);
 
     x6 = x3;
     for (j=0; j<3; j++) {
-        secp256k1_fe_sqr(&x6, &x6);
+        secp256k1_fe_sqr_x4(&x6, &x6);
     }
-    secp256k1_fe_mul(&x6, &x6, &x3);
+    secp256k1_fe_mul_x4(&x6, &x6, &x3);
 
     x9 = x6;
     for (j=0; j<3; j++) {
-        secp256k1_fe_sqr(&x9, &x9);
+        secp256k1_fe_sqr_x4(&x9, &x9);
     }
-    secp256k1_fe_mul(&x9, &x9, &x3);
+    secp256k1_fe_mul_x4(&x9, &x9, &x3);
 
     x11 = x9;
     for (j=0; j<2; j++) {
-        secp256k1_fe_sqr(&x11, &x11);
+        secp256k1_fe_sqr_x4(&x11, &x11);
     }
-    secp256k1_fe_mul(&x11, &x11, &x2);
+    secp256k1_fe_mul_x4(&x11, &x11, &x2);
 
     x22 = x11;
     for (j=0; j<11; j++) {
-        secp256k1_fe_sqr(&x22, &x22);
+        secp256k1_fe_sqr_x4(&x22, &x22);
     }
-    secp256k1_fe_mul(&x22, &x22, &x11);
+    secp256k1_fe_mul_x4(&x22, &x22, &x11);
 
     x44 = x22;
     for (j=0; j<22; j++) {
-        secp256k1_fe_sqr(&x44, &x44);
+        secp256k1_fe_sqr_x4(&x44, &x44);
     }
-    secp256k1_fe_mul(&x44, &x44, &x22);
+    secp256k1_fe_mul_x4(&x44, &x44, &x22);
 
     x88 = x44;
     for (j=0; j<44; j++) {
-        secp256k1_fe_sqr(&x88, &x88);
+        secp256k1_fe_sqr_x4(&x88, &x88);
     }
-    secp256k1_fe_mul(&x88, &x88, &x44);
+    secp256k1_fe_mul_x4(&x88, &x88, &x44);
 
     x176 = x88;
     for (j=0; j<88; j++) {
-        secp256k1_fe_sqr(&x176, &x176);
+        secp256k1_fe_sqr_x4(&x176, &x176);
     }
-    secp256k1_fe_mul(&x176, &x176, &x88);
+    secp256k1_fe_mul_x4(&x176, &x176, &x88);
 
     x220 = x176;
     for (j=0; j<44; j++) {
-        secp256k1_fe_sqr(&x220, &x220);
+        secp256k1_fe_sqr_x4(&x220, &x220);
     }
-    secp256k1_fe_mul(&x220, &x220, &x44);
+    secp256k1_fe_mul_x4(&x220, &x220, &x44);
 
     x223 = x220;
     for (j=0; j<3; j++) {
-        secp256k1_fe_sqr(&x223, &x223);
+        secp256k1_fe_sqr_x4(&x223, &x223);
     }
-    secp256k1_fe_mul(&x223, &x223, &x3);
-
-    /* The final result is then assembled using a sliding window over the blocks. */
+    secp256k1_fe_mul_x4(&x223, &x223, &x3);
 
     t1 = x223;
     for (j=0; j<23; j++) {
-        secp256k1_fe_sqr(&t1, &t1);
+        secp256k1_fe_sqr_x4(&t1, &t1);
     }
-    secp256k1_fe_mul(&t1, &t1, &x22);
-    for (j=0; j<5; j++) {
-        secp256k1_fe_sqr(&t1, &t1);
+    secp256k1_fe_mul_x4(&t1, &t1, &x22);
+    for (j=0; j<6; j++) {
+        secp256k1_fe_sqr_x4(&t1, &t1);
     }
-    secp256k1_fe_mul(&t1, &t1, a);
-    for (j=0; j<3; j++) {
-        secp256k1_fe_sqr(&t1, &t1);
+    secp256k1_fe_mul_x4(&t1, &t1, &x2);
+    secp256k1_fe_sqr_x4(&t1, &t1);
+    secp256k1_fe_sqr_x4(&t1, &t1);
+    secp256k1_fe_x4_scatter(r, &t1);
+
+    /* Check per lane that a square root was actually calculated. */
+    secp256k1_fe_sqr_x4(&t1, &t1);
+    secp256k1_fe_x4_scatter(chk, &t1);
+    for (j = 0; j < SECP256K1_FE_X4_LANES; j++) {
+        valid[j] = secp256k1_fe_equal(&chk[j], &a[j]);
     }
-    secp256k1_fe_mul(&t1, &t1, &x2);
-    for (j=0; j<2; j++) {
-        secp256k1_fe_sqr(&t1, &t1);
-    }
-    secp256k1_fe_mul(r, a, &t1);
+}
+#endif
+
+/* Fermat inversion via an addition chain for p - 2. Kept as the fallback
+ * for targets without the safegcd kernels and for cross-checking them.
+ * The chain body itself is generated, see field_chain_impl.h. */
+static void secp256k1_fe_inv_fermat(secp256k1_fe *r, const secp256k1_fe *a) {
+    secp256k1_fe_inv_chain(r, a);
+}
+
+static void secp256k1_fe_inv(secp256k1_fe *r, const secp256k1_fe *a) {
+#ifdef SECP256K1_HAVE_SAFEGCD
+    unsigned char b[32];
+    int res;
+    secp256k1_fe c = *a;
+    secp256k1_fe_normalize(&c);
+    secp256k1_fe_get_b32(b, &c);
+    secp256k1_modinv64_b32(b, &secp256k1_modinv64_fe);
+    res = secp256k1_fe_set_b32(r, b);
+    (void)res;
+    VERIFY_CHECK(res);
+#else
+    secp256k1_fe_inv_fermat(r, a);
+#endif
 }
 
 static void secp256k1_fe_inv_var(secp256k1_fe *r, const secp256k1_fe *a) {
+    if (secp256k1_vartime_kernels) {
+        /* secp256k1 field prime, value p defined in "Standards for Efficient Cryptography" (SEC2) 2.7.1. */
+        static const unsigned char prime[32] = {
+            0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+            0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+            0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+            0xFF,0xFF,0xFF,0xFE,0xFF,0xFF,0xFC,0x2F
+        };
+        unsigned char b[32];
+        int res;
+        secp256k1_fe c = *a;
+        secp256k1_fe_normalize_var(&c);
+        secp256k1_fe_get_b32(b, &c);
+        secp256k1_modinv_bin_var(b, b, prime);
+        res = secp256k1_fe_set_b32(r, b);
+        (void)res;
+        VERIFY_CHECK(res);
+#ifdef VERIFY
+        if (!secp256k1_fe_normalizes_to_zero_var(&c)) {
+            static const secp256k1_fe negone = SECP256K1_FE_CONST(
+                0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL,
+                0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFEUL, 0xFFFFFC2EUL
+            );
+            secp256k1_fe_mul(&c, &c, r);
+            secp256k1_fe_add(&c, &negone);
+            VERIFY_CHECK(secp256k1_fe_normalizes_to_zero_var(&c));
+        }
+#endif
+        return;
+    }
 #if defined(USE_FIELD_INV_BUILTIN)
     secp256k1_fe_inv(r, a);
 #elif defined(USE_FIELD_INV_NUM)
@@ -0,0 +1,226 @@
+/**********************************************************************
+ * Copyright (c) 2018 The go-ethereumai Authors                       *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+/* libFuzzer target for the flat batch FFI layer (../../ffi.h).
+ *
+ * The batch and async surfaces carry state the tests.c style cannot reach:
+ * the worker pool dispatch, the recovery memoization table, arena records,
+ * descriptor validation and the interactions between them across a sequence
+ * of calls. The fuzz input is a structured script of FFI calls rather than
+ * raw bytes, so coverage-guided mutation explores call sequences and
+ * boundary sizes instead of burning its budget on the descriptor magic:
+ *
+ *   record: op     1 byte   FFI op selector (0 probes the abi_version check)
+ *           flags  1 byte   descriptor flags
+ *           n      1 byte   batch size, capped at FUZZ_FFI_MAX_N
+ *           ctrl   1 byte   bit0: 65-byte pubkey stride (else 33)
+ *                           bit1: race a serial-path batch on a second thread
+ *                           bit2: sign the batch inputs so success paths run
+ *           data   the input arrays back to back - signatures, then
+ *                  messages, then public keys - cycled when short
+ *
+ * A script is up to FUZZ_FFI_MAX_CALLS records back to back, which is what
+ * lets the fuzzer find sequence bugs (a poisoned cache entry surfacing in a
+ * later call, pool state leaking between batches). ctrl bit1 pairs the
+ * batch with a concurrent serial-path batch on a second thread - the
+ * supported concurrency shape, since pooled batches serialize on the
+ * publisher - so a thread-sanitized run exercises the dispatch interleaving.
+ *
+ * Build (from this directory, clang with libFuzzer):
+ *
+ *   clang -O1 -g -fsanitize=fuzzer,address -I. -I.. -D_GNU_SOURCE \
+ *     -DUSE_ENDOMORPHISM -DUSE_NUM_NONE -DUSE_FIELD_INV_BUILTIN \
+ *     -DUSE_SCALAR_INV_BUILTIN -DUSE_FIELD_5X52 -DUSE_SCALAR_4X64 \
+ *     -DHAVE___INT128 -DNDEBUG -DENABLE_MODULE_RECOVERY \
+ *     -DENABLE_MODULE_SCHNORR -DENABLE_MODULE_ECDH \
+ *     fuzz_ffi.c -o fuzz_ffi -lpthread
+ *
+ * swap -fsanitize=fuzzer,thread in for the interleaving runs. Seed the
+ * corpus from a production trace with ../contrib/ffi_corpus.py, so the
+ * fuzzer starts from the call mix validators actually see. -DFUZZ_FFI_DRIVER
+ * adds a main() that replays corpus files without libFuzzer, for running
+ * the corpus as a plain regression suite under any compiler.
+ */
+
+#include "secp256k1.c"
+#include "../../ext.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FUZZ_FFI_MAX_N     12
+#define FUZZ_FFI_MAX_CALLS 4
+
+/* Largest strides of any op: 65-byte signatures, 65-byte keys, and the
+ * arena op's 86-byte output records. All batch arrays obey the 64-byte
+ * aligned-buffer contract of ffi.h. */
+static unsigned char fuzz_sigs[FUZZ_FFI_MAX_N * 65] __attribute__((aligned(SECP256K1_FFI_BUF_ALIGN)));
+static unsigned char fuzz_msgs[FUZZ_FFI_MAX_N * 32] __attribute__((aligned(SECP256K1_FFI_BUF_ALIGN)));
+static unsigned char fuzz_pubkeys[FUZZ_FFI_MAX_N * 65] __attribute__((aligned(SECP256K1_FFI_BUF_ALIGN)));
+static unsigned char fuzz_out[FUZZ_FFI_MAX_N * SECP256K1_FFI_ARENA_RECORD_SIZE] __attribute__((aligned(SECP256K1_FFI_BUF_ALIGN)));
+static int fuzz_results[FUZZ_FFI_MAX_N];
+
+static secp256k1_context *fuzz_ctx;
+
+/* Copies len pool bytes starting at off into dst, cycling when the pool is
+ * short (or zeroing when empty), and returns the next offset. Sequential
+ * calls lay the record's arrays out back to back, so a corpus entry built
+ * from a production trace reproduces the exact call inputs. */
+static size_t fuzz_take(unsigned char *dst, size_t len, const uint8_t *pool, size_t poolsize, size_t off) {
+    size_t i;
+    if (poolsize == 0) {
+        memset(dst, 0, len);
+        return off;
+    }
+    for (i = 0; i < len; i++) {
+        dst[i] = pool[(off + i) % poolsize];
+    }
+    return off + len;
+}
+
+/* Overwrites entry i of the batch arrays with a genuinely valid signature
+ * over its message, so the success paths (recovery, verification, arena
+ * marshalling, cache stores and later cache hits) run instead of failing at
+ * the first scalar check. The key is derived from the entry so scripts can
+ * still explore repeated-signer patterns. */
+static void fuzz_sign_entry(size_t i, size_t sigstride, size_t pubstride) {
+    unsigned char seckey[32];
+    secp256k1_ecdsa_recoverable_signature rsig;
+    secp256k1_pubkey pubkey;
+    size_t publen = pubstride;
+    int recid = 0;
+
+    memset(seckey, 0x42 + (unsigned char)(i & 3), sizeof(seckey));
+    if (!secp256k1_ec_pubkey_create(fuzz_ctx, &pubkey, seckey) ||
+        !secp256k1_ecdsa_sign_recoverable(fuzz_ctx, &rsig, fuzz_msgs + i*32, seckey, NULL, NULL)) {
+        return;
+    }
+    secp256k1_ecdsa_recoverable_signature_serialize_compact(fuzz_ctx,
+        fuzz_sigs + i*sigstride, &recid, &rsig);
+    if (sigstride == 65) {
+        fuzz_sigs[i*sigstride + 64] = (unsigned char)recid;
+    }
+    secp256k1_ec_pubkey_serialize(fuzz_ctx, fuzz_pubkeys + i*pubstride, &publen, &pubkey,
+        pubstride == 33 ? SECP256K1_EC_COMPRESSED : SECP256K1_EC_UNCOMPRESSED);
+}
+
+#ifndef _WIN32
+#include <pthread.h>
+
+/* The racing thread runs a serial-path batch (n below the pool threshold)
+ * over its own arrays, the one concurrent shape the layer supports. */
+static unsigned char race_sigs[4 * 65] __attribute__((aligned(SECP256K1_FFI_BUF_ALIGN)));
+static unsigned char race_msgs[4 * 32] __attribute__((aligned(SECP256K1_FFI_BUF_ALIGN)));
+static int race_results[4];
+
+static void* fuzz_race_thread(void *arg) {
+    secp256k1_ffi_batch race;
+    (void)arg;
+    memset(&race, 0, sizeof(race));
+    race.abi_version = SECP256K1_FFI_ABI_VERSION;
+    race.op = SECP256K1_FFI_OP_SIG_VALIDATE;
+    race.flags = SECP256K1_FFI_FLAG_LOW_S;
+    race.sigs = race_sigs;
+    race.msgs = race_msgs;
+    race.n = 4;
+    race.results = race_results;
+    secp256k1_ffi_execute(fuzz_ctx, &race);
+    return NULL;
+}
+#endif
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    int calls;
+
+    if (fuzz_ctx == NULL) {
+        fuzz_ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    }
+    for (calls = 0; calls < FUZZ_FFI_MAX_CALLS && size >= 4; calls++) {
+        secp256k1_ffi_batch batch;
+        size_t n = data[2] % (FUZZ_FFI_MAX_N + 1);
+        size_t pubstride = (data[3] & 1) ? 65 : 33;
+        size_t sigstride;
+        size_t want, i;
+        int race = 0;
+
+        memset(&batch, 0, sizeof(batch));
+        batch.op = data[0] % (SECP256K1_FFI_OP_ECDSA_RECOVER_ARENA + 1);
+        /* op 0 probes descriptor validation: a wrong abi_version must fail
+         * closed no matter what else the record says. */
+        batch.abi_version = batch.op == 0 ? SECP256K1_FFI_ABI_VERSION + 1 : SECP256K1_FFI_ABI_VERSION;
+        batch.flags = data[1];
+        sigstride = (batch.op == SECP256K1_FFI_OP_ECDSA_VERIFY ||
+            batch.op == SECP256K1_FFI_OP_SCHNORR_VERIFY) ? 64 : 65;
+#ifndef _WIN32
+        race = (data[3] & 2) != 0;
+#endif
+
+        /* Consume this record's data slice before building the arrays, so
+         * every later record keeps its own bytes under mutation. */
+        want = 4 + n * (sigstride + 32 + pubstride);
+        if (want > size) {
+            want = size;
+        }
+        i = fuzz_take(fuzz_sigs, n * sigstride, data + 4, want - 4, 0);
+        i = fuzz_take(fuzz_msgs, n * 32, data + 4, want - 4, i);
+        (void)fuzz_take(fuzz_pubkeys, n * pubstride, data + 4, want - 4, i);
+        memset(fuzz_out, 0, sizeof(fuzz_out));
+        if (data[3] & 4) {
+            for (i = 0; i < n; i++) {
+                fuzz_sign_entry(i, sigstride, pubstride);
+            }
+        }
+        data += want;
+        size -= want;
+
+        batch.sigs = fuzz_sigs;
+        batch.msgs = fuzz_msgs;
+        batch.pubkeys = fuzz_pubkeys;
+        batch.pubkey_stride = pubstride;
+        batch.out = fuzz_out;
+        batch.n = n;
+        batch.results = fuzz_results;
+
+#ifndef _WIN32
+        if (race) {
+            pthread_t thread;
+            int spawned = pthread_create(&thread, NULL, fuzz_race_thread, NULL) == 0;
+            secp256k1_ffi_execute(fuzz_ctx, &batch);
+            if (spawned) {
+                pthread_join(thread, NULL);
+            }
+            continue;
+        }
+#endif
+        secp256k1_ffi_execute(fuzz_ctx, &batch);
+    }
+    return 0;
+}
+
+#ifdef FUZZ_FFI_DRIVER
+#include <stdio.h>
+
+/* Replays corpus files without libFuzzer, so the corpus doubles as a plain
+ * regression suite under any compiler and sanitizer mix. */
+int main(int argc, char **argv) {
+    int i;
+    for (i = 1; i < argc; i++) {
+        FILE *f = fopen(argv[i], "rb");
+        unsigned char buf[1 << 16];
+        size_t n;
+        if (f == NULL) {
+            fprintf(stderr, "fuzz_ffi: cannot open %s\n", argv[i]);
+            return 1;
+        }
+        n = fread(buf, 1, sizeof(buf), f);
+        fclose(f);
+        LLVMFuzzerTestOneInput(buf, n);
+    }
+    printf("fuzz_ffi: %d files ok\n", argc - 1);
+    return 0;
+}
+#endif
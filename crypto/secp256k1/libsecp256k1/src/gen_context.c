@@ -13,6 +13,12 @@
 #include "group_impl.h"
 #include "ecmult_gen_impl.h"
 
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <unistd.h>
+#define GEN_CONTEXT_THREADS 1
+#endif
+
 static void default_error_callback_fn(const char* str, void* data) {
     (void)data;
     fprintf(stderr, "[libsecp256k1] internal consistency check failed: %s\n", str);
@@ -24,51 +30,288 @@ static const secp256k1_callback default_error_callback = {
     NULL
 };
 
+/* The table rows are independent: row j only needs (PREC_G)^j * G and the
+ * j'th blinding point, both of which are a handful of doublings away from
+ * the previous row's bases. The bases are walked out serially, then the
+ * expensive per-row work (PREC_G point additions and a batch inversion) is
+ * farmed out across threads, and each finished row is checkpointed to a
+ * scratch file so an interrupted run resumes instead of starting over. */
+
+typedef secp256k1_ge_storage gen_context_table[ECMULT_GEN_PREC_N][ECMULT_GEN_PREC_G];
+
+/* Scratch file holding finished rows. Raw in-memory dumps of
+ * secp256k1_ge_storage, so it is only meaningful to the host that wrote it;
+ * it lives next to the generated header and is deleted once the header is
+ * out. Layout: header, per-row done flags, then the rows at fixed offsets. */
+static const char gen_context_checkpoint_file[] = "src/ecmult_static_context.bin";
+
+typedef struct {
+    uint32_t magic;
+    uint32_t prec_bits;
+} gen_context_checkpoint_header;
+
+#define GEN_CONTEXT_CHECKPOINT_MAGIC 0x53435458u /* "SCTX" */
+#define GEN_CONTEXT_ROW_BYTES (sizeof(secp256k1_ge_storage) * ECMULT_GEN_PREC_G)
+#define GEN_CONTEXT_ROW_OFFSET(j) \
+    (sizeof(gen_context_checkpoint_header) + ECMULT_GEN_PREC_N + (j) * GEN_CONTEXT_ROW_BYTES)
+
+typedef struct {
+    gen_context_table *table;
+    secp256k1_gej gbase[ECMULT_GEN_PREC_N];    /* (PREC_G)^j * G */
+    secp256k1_gej numsbase[ECMULT_GEN_PREC_N]; /* j'th blinding point */
+    unsigned char done[ECMULT_GEN_PREC_N];
+    FILE *checkpoint;
+    int next_row;
+#ifdef GEN_CONTEXT_THREADS
+    pthread_mutex_t lock;
+#endif
+} gen_context_state;
+
+/* Walk the row bases out from G and the nothing-up-my-sleeve point, exactly
+ * as secp256k1_ecmult_gen_context_build does inline. */
+static void gen_context_compute_bases(gen_context_state *state) {
+    secp256k1_gej nums_gej;
+    int i, j;
+
+    {
+        static const unsigned char nums_b32[33] = "The scalar for this x is unknown";
+        secp256k1_fe nums_x;
+        secp256k1_ge nums_ge;
+        int r;
+        r = secp256k1_fe_set_b32(&nums_x, nums_b32);
+        (void)r;
+        VERIFY_CHECK(r);
+        r = secp256k1_ge_set_xo_var(&nums_ge, &nums_x, 0);
+        (void)r;
+        VERIFY_CHECK(r);
+        secp256k1_gej_set_ge(&nums_gej, &nums_ge);
+        /* Add G to make the bits in x uniformly distributed. */
+        secp256k1_gej_add_ge_var(&nums_gej, &nums_gej, &secp256k1_ge_const_g, NULL);
+    }
+
+    secp256k1_gej_set_ge(&state->gbase[0], &secp256k1_ge_const_g);
+    state->numsbase[0] = nums_gej;
+    for (j = 1; j < ECMULT_GEN_PREC_N; j++) {
+        state->gbase[j] = state->gbase[j - 1];
+        for (i = 0; i < ECMULT_GEN_PREC_B; i++) {
+            secp256k1_gej_double_var(&state->gbase[j], &state->gbase[j], NULL);
+        }
+        secp256k1_gej_double_var(&state->numsbase[j], &state->numsbase[j - 1], NULL);
+        if (j == ECMULT_GEN_PREC_N - 1) {
+            /* In the last row, numsbase is (1 - 2^j) * nums instead. */
+            secp256k1_gej_neg(&state->numsbase[j], &state->numsbase[j]);
+            secp256k1_gej_add_var(&state->numsbase[j], &state->numsbase[j], &nums_gej, NULL);
+        }
+    }
+}
+
+/* Compute row j: (numsbase, numsbase + gbase, ..., numsbase + (PREC_G-1)*gbase). */
+static void gen_context_compute_row(gen_context_state *state, int j) {
+    secp256k1_gej precj[ECMULT_GEN_PREC_G];
+    secp256k1_ge prec[ECMULT_GEN_PREC_G];
+    int i;
+
+    precj[0] = state->numsbase[j];
+    for (i = 1; i < ECMULT_GEN_PREC_G; i++) {
+        secp256k1_gej_add_var(&precj[i], &precj[i - 1], &state->gbase[j], NULL);
+    }
+    secp256k1_ge_set_all_gej_var(prec, precj, ECMULT_GEN_PREC_G, &default_error_callback);
+    for (i = 0; i < ECMULT_GEN_PREC_G; i++) {
+        secp256k1_ge_to_storage(&(*state->table)[j][i], &prec[i]);
+    }
+}
+
+/* Persist a finished row: the row data is flushed before its done flag so a
+ * crash can never mark a half-written row as usable. Serialized under the
+ * state lock when running threaded. */
+static void gen_context_checkpoint_row(gen_context_state *state, int j) {
+    unsigned char flag = 1;
+    FILE *fp = state->checkpoint;
+    if (fp == NULL) {
+        return;
+    }
+    if (fseek(fp, (long)GEN_CONTEXT_ROW_OFFSET(j), SEEK_SET) != 0 ||
+        fwrite(&(*state->table)[j][0], GEN_CONTEXT_ROW_BYTES, 1, fp) != 1 ||
+        fflush(fp) != 0 ||
+        fseek(fp, (long)(sizeof(gen_context_checkpoint_header) + j), SEEK_SET) != 0 ||
+        fwrite(&flag, 1, 1, fp) != 1 ||
+        fflush(fp) != 0) {
+        /* checkpointing is best effort; the run still completes in memory */
+        fclose(fp);
+        state->checkpoint = NULL;
+    }
+}
+
+/* Load finished rows from an earlier interrupted run, or start a fresh
+ * checkpoint file. Returns the number of rows recovered. */
+static int gen_context_checkpoint_open(gen_context_state *state) {
+    gen_context_checkpoint_header header;
+    int recovered = 0;
+    int j;
+    FILE *fp = fopen(gen_context_checkpoint_file, "rb+");
+
+    if (fp != NULL) {
+        if (fread(&header, sizeof(header), 1, fp) == 1 &&
+            header.magic == GEN_CONTEXT_CHECKPOINT_MAGIC &&
+            header.prec_bits == ECMULT_GEN_PREC_BITS &&
+            fread(state->done, ECMULT_GEN_PREC_N, 1, fp) == 1) {
+            for (j = 0; j < ECMULT_GEN_PREC_N; j++) {
+                if (!state->done[j]) {
+                    continue;
+                }
+                if (fseek(fp, (long)GEN_CONTEXT_ROW_OFFSET(j), SEEK_SET) != 0 ||
+                    fread(&(*state->table)[j][0], GEN_CONTEXT_ROW_BYTES, 1, fp) != 1) {
+                    state->done[j] = 0;
+                    continue;
+                }
+                recovered++;
+            }
+            state->checkpoint = fp;
+            return recovered;
+        }
+        /* stale or foreign file: regenerate it from scratch */
+        fclose(fp);
+        memset(state->done, 0, sizeof(state->done));
+    }
+
+    fp = fopen(gen_context_checkpoint_file, "wb+");
+    if (fp == NULL) {
+        return 0;
+    }
+    header.magic = GEN_CONTEXT_CHECKPOINT_MAGIC;
+    header.prec_bits = ECMULT_GEN_PREC_BITS;
+    if (fwrite(&header, sizeof(header), 1, fp) != 1 ||
+        fwrite(state->done, ECMULT_GEN_PREC_N, 1, fp) != 1 ||
+        fflush(fp) != 0) {
+        fclose(fp);
+        return 0;
+    }
+    state->checkpoint = fp;
+    return 0;
+}
+
+#ifdef GEN_CONTEXT_THREADS
+
+static void *gen_context_worker(void *arg) {
+    gen_context_state *state = (gen_context_state *)arg;
+    for (;;) {
+        int j;
+        pthread_mutex_lock(&state->lock);
+        for (j = state->next_row; j < ECMULT_GEN_PREC_N && state->done[j]; j++);
+        state->next_row = j + 1;
+        pthread_mutex_unlock(&state->lock);
+        if (j >= ECMULT_GEN_PREC_N) {
+            return NULL;
+        }
+        gen_context_compute_row(state, j);
+        pthread_mutex_lock(&state->lock);
+        state->done[j] = 1;
+        gen_context_checkpoint_row(state, j);
+        pthread_mutex_unlock(&state->lock);
+    }
+}
+
+static void gen_context_compute_rows(gen_context_state *state) {
+    pthread_t threads[ECMULT_GEN_PREC_N];
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int num_threads = cpus > 0 ? (int)cpus : 1;
+    int started = 0;
+    int t;
+
+    if (num_threads > ECMULT_GEN_PREC_N) {
+        num_threads = ECMULT_GEN_PREC_N;
+    }
+    pthread_mutex_init(&state->lock, NULL);
+    for (t = 1; t < num_threads; t++) {
+        if (pthread_create(&threads[t], NULL, gen_context_worker, state) != 0) {
+            break;
+        }
+        started = t;
+    }
+    gen_context_worker(state);
+    for (t = 1; t <= started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    pthread_mutex_destroy(&state->lock);
+}
+
+#else
+
+static void gen_context_compute_rows(gen_context_state *state) {
+    int j;
+    for (j = 0; j < ECMULT_GEN_PREC_N; j++) {
+        if (state->done[j]) {
+            continue;
+        }
+        gen_context_compute_row(state, j);
+        state->done[j] = 1;
+        gen_context_checkpoint_row(state, j);
+    }
+}
+
+#endif
+
 int main(int argc, char **argv) {
-    secp256k1_ecmult_gen_context ctx;
+    gen_context_state state;
+    gen_context_table table;
     int inner;
     int outer;
+    int recovered;
     FILE* fp;
 
     (void)argc;
     (void)argv;
 
+    memset(&state, 0, sizeof(state));
+    state.table = &table;
+    recovered = gen_context_checkpoint_open(&state);
+    if (recovered != 0) {
+        fprintf(stderr, "gen_context: resuming, %d of %d rows recovered\n", recovered, ECMULT_GEN_PREC_N);
+    }
+    gen_context_compute_bases(&state);
+    gen_context_compute_rows(&state);
+    if (state.checkpoint != NULL) {
+        fclose(state.checkpoint);
+    }
+
     fp = fopen("src/ecmult_static_context.h","w");
     if (fp == NULL) {
         fprintf(stderr, "Could not open src/ecmult_static_context.h for writing!\n");
         return -1;
     }
-    
+
     fprintf(fp, "#ifndef _SECP256K1_ECMULT_STATIC_CONTEXT_\n");
     fprintf(fp, "#define _SECP256K1_ECMULT_STATIC_CONTEXT_\n");
     fprintf(fp, "#include \"group.h\"\n");
+    fprintf(fp, "#include \"ecmult_gen.h\"\n");
     fprintf(fp, "#define SC SECP256K1_GE_STORAGE_CONST\n");
-    fprintf(fp, "static const secp256k1_ge_storage secp256k1_ecmult_static_context[64][16] = {\n");
+    fprintf(fp, "#if ECMULT_GEN_PREC_BITS != %d\n", ECMULT_GEN_PREC_BITS);
+    fprintf(fp, "#error \"Table generated for ECMULT_GEN_PREC_BITS=%d, rebuild gen_context with the matching value.\"\n", ECMULT_GEN_PREC_BITS);
+    fprintf(fp, "#endif\n");
+    fprintf(fp, "static const secp256k1_ge_storage secp256k1_ecmult_static_context[ECMULT_GEN_PREC_N][ECMULT_GEN_PREC_G] = {\n");
 
-    secp256k1_ecmult_gen_context_init(&ctx);
-    secp256k1_ecmult_gen_context_build(&ctx, &default_error_callback);
-    for(outer = 0; outer != 64; outer++) {
+    for(outer = 0; outer != ECMULT_GEN_PREC_N; outer++) {
         fprintf(fp,"{\n");
-        for(inner = 0; inner != 16; inner++) {
-            fprintf(fp,"    SC(%uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu)", SECP256K1_GE_STORAGE_CONST_GET((*ctx.prec)[outer][inner]));
-            if (inner != 15) {
+        for(inner = 0; inner != ECMULT_GEN_PREC_G; inner++) {
+            fprintf(fp,"    SC(%uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu)", SECP256K1_GE_STORAGE_CONST_GET(table[outer][inner]));
+            if (inner != ECMULT_GEN_PREC_G - 1) {
                 fprintf(fp,",\n");
             } else {
                 fprintf(fp,"\n");
             }
         }
-        if (outer != 63) {
+        if (outer != ECMULT_GEN_PREC_N - 1) {
             fprintf(fp,"},\n");
         } else {
             fprintf(fp,"}\n");
         }
     }
     fprintf(fp,"};\n");
-    secp256k1_ecmult_gen_context_clear(&ctx);
-    
+
     fprintf(fp, "#undef SC\n");
     fprintf(fp, "#endif\n");
     fclose(fp);
-    
+    remove(gen_context_checkpoint_file);
+
     return 0;
 }
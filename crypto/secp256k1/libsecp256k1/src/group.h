@@ -115,9 +115,18 @@ static void secp256k1_gej_add_ge(secp256k1_gej *r, const secp256k1_gej *a, const
     guarantee, and b is allowed to be infinity. If rzr is non-NULL, r->z = a->z * *rzr (a cannot be infinity in that case). */
 static void secp256k1_gej_add_ge_var(secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_ge *b, secp256k1_fe *rzr);
 
+/** Like secp256k1_gej_add_ge_var with rzr == NULL, but defers the input normalizations. Only
+    valid when a was produced by the doubling or addition formulas themselves (see the magnitude
+    accounting in group_impl.h), as in the inner secp256k1_ecmult loop. */
+static void secp256k1_gej_add_ge_var_relaxed(secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_ge *b);
+
 /** Set r equal to the sum of a and b (with the inverse of b's Z coordinate passed as bzinv). */
 static void secp256k1_gej_add_zinv_var(secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_ge *b, const secp256k1_fe *bzinv);
 
+/** Like secp256k1_gej_add_zinv_var, but defers the input normalizations under the same
+    precondition on a as secp256k1_gej_add_ge_var_relaxed. */
+static void secp256k1_gej_add_zinv_var_relaxed(secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_ge *b, const secp256k1_fe *bzinv);
+
 #ifdef USE_ENDOMORPHISM
 /** Set r to be equal to lambda times a, where lambda is chosen in a way such that this is very fast. */
 static void secp256k1_ge_mul_lambda(secp256k1_ge *r, const secp256k1_ge *a);
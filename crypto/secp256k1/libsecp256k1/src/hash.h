@@ -25,6 +25,10 @@ typedef struct {
 } secp256k1_hmac_sha256_t;
 
 static void secp256k1_hmac_sha256_initialize(secp256k1_hmac_sha256_t *hash, const unsigned char *key, size_t size);
+/** Resume from a key-derived midstate (a secp256k1_hmac_sha256_t right after
+ *  initialize), skipping the two key-schedule compressions when the same key
+ *  is used for many MACs. */
+static void secp256k1_hmac_sha256_resume(secp256k1_hmac_sha256_t *hash, const secp256k1_hmac_sha256_t *mid);
 static void secp256k1_hmac_sha256_write(secp256k1_hmac_sha256_t *hash, const unsigned char *data, size_t size);
 static void secp256k1_hmac_sha256_finalize(secp256k1_hmac_sha256_t *hash, unsigned char *out32);
 
@@ -8,11 +8,22 @@
 #define _SECP256K1_HASH_IMPL_H_
 
 #include "hash.h"
+#include "cpu_features.h"
 
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
 
+/* Hardware SHA-256 support. On x86_64 the SHA-NI kernel is selected at
+ * runtime via CPUID (same dispatch shape as the ADX field kernels); on
+ * AArch64 the crypto-extension kernel is a compile-time choice since the
+ * compiler only exposes the intrinsics when already targeting it. */
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(WORDS_BIGENDIAN)
+#define SECP256K1_SHA256_DISPATCH_SHANI 1
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRYPTO) && !defined(WORDS_BIGENDIAN)
+#define SECP256K1_SHA256_USE_ARMV8 1
+#endif
+
 #define Ch(x,y,z) ((z) ^ ((x) & ((y) ^ (z))))
 #define Maj(x,y,z) (((x) & (y)) | ((z) & ((x) | (y))))
 #define Sigma0(x) (((x) >> 2 | (x) << 30) ^ ((x) >> 13 | (x) << 19) ^ ((x) >> 22 | (x) << 10))
@@ -46,7 +57,8 @@ static void secp256k1_sha256_initialize(secp256k1_sha256_t *hash) {
 }
 
 /** Perform one SHA-256 transformation, processing 16 big endian 32-bit words. */
-static void secp256k1_sha256_transform(uint32_t* s, const uint32_t* chunk) {
+#ifndef SECP256K1_SHA256_USE_ARMV8
+static void secp256k1_sha256_transform_generic(uint32_t* s, const uint32_t* chunk) {
     uint32_t a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
     uint32_t w0, w1, w2, w3, w4, w5, w6, w7, w8, w9, w10, w11, w12, w13, w14, w15;
 
@@ -127,6 +139,118 @@ static void secp256k1_sha256_transform(uint32_t* s, const uint32_t* chunk) {
     s[6] += g;
     s[7] += h;
 }
+#endif /* !SECP256K1_SHA256_USE_ARMV8 */
+
+#if defined(SECP256K1_SHA256_DISPATCH_SHANI) || defined(SECP256K1_SHA256_USE_ARMV8)
+static const uint32_t secp256k1_sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+#endif
+
+#ifdef SECP256K1_SHA256_DISPATCH_SHANI
+
+#include <immintrin.h>
+
+#pragma GCC push_options
+#pragma GCC target("sha,sse4.1")
+static void secp256k1_sha256_transform_shani(uint32_t* s, const uint32_t* chunk) {
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, tmp, wk, m[4];
+    __m128i abef_save, cdgh_save;
+    int i;
+
+    /* The sha256rnds2 instruction wants the state as ABEF/CDGH vectors. */
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&s[0]), 0xB1);    /* CDAB */
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&s[4]), 0x1B); /* EFGH */
+    state0 = _mm_alignr_epi8(tmp, state1, 8);                                 /* ABEF */
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);                              /* CDGH */
+    abef_save = state0;
+    cdgh_save = state1;
+
+    for (i = 0; i < 4; i++) {
+        m[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(chunk + 4*i)), bswap);
+    }
+    for (i = 0; i < 16; i++) {
+        wk = _mm_add_epi32(m[i & 3], _mm_loadu_si128((const __m128i*)&secp256k1_sha256_k[4*i]));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(wk, 0x0E));
+        if (i < 12) {
+            /* W[4i+16..4i+19] from the four most recent message vectors. */
+            m[i & 3] = _mm_sha256msg2_epu32(
+                _mm_add_epi32(_mm_sha256msg1_epu32(m[i & 3], m[(i + 1) & 3]),
+                              _mm_alignr_epi8(m[(i + 3) & 3], m[(i + 2) & 3], 4)),
+                m[(i + 3) & 3]);
+        }
+    }
+
+    state0 = _mm_add_epi32(state0, abef_save);
+    state1 = _mm_add_epi32(state1, cdgh_save);
+    tmp = _mm_shuffle_epi32(state0, 0x1B);       /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xB1);    /* DCHG */
+    _mm_storeu_si128((__m128i*)&s[0], _mm_blend_epi16(tmp, state1, 0xF0)); /* DCBA */
+    _mm_storeu_si128((__m128i*)&s[4], _mm_alignr_epi8(state1, tmp, 8));    /* HGFE */
+}
+#pragma GCC pop_options
+
+static int secp256k1_sha256_have_shani(void) {
+    return (secp256k1_cpu_features() & SECP256K1_CPU_SHANI) != 0;
+}
+
+static void secp256k1_sha256_transform_select(uint32_t* s, const uint32_t* chunk);
+
+/* Starts at the selector; the first call swings it to the CPUID-chosen
+ * kernel. Re-running the selection on a rare race is harmless since every
+ * outcome is identical. */
+static void (*secp256k1_sha256_transform_ptr)(uint32_t* s, const uint32_t* chunk) = secp256k1_sha256_transform_select;
+
+static void secp256k1_sha256_transform_select(uint32_t* s, const uint32_t* chunk) {
+    secp256k1_sha256_transform_ptr = secp256k1_sha256_have_shani() ? secp256k1_sha256_transform_shani : secp256k1_sha256_transform_generic;
+    secp256k1_sha256_transform_ptr(s, chunk);
+}
+
+SECP256K1_INLINE static void secp256k1_sha256_transform(uint32_t* s, const uint32_t* chunk) {
+    secp256k1_sha256_transform_ptr(s, chunk);
+}
+
+#elif defined(SECP256K1_SHA256_USE_ARMV8)
+
+#include <arm_neon.h>
+
+static void secp256k1_sha256_transform(uint32_t* s, const uint32_t* chunk) {
+    uint32x4_t abcd = vld1q_u32(&s[0]);
+    uint32x4_t efgh = vld1q_u32(&s[4]);
+    uint32x4_t abcd_save = abcd, efgh_save = efgh;
+    uint32x4_t wk, tmp, m[4];
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        m[i] = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(vld1q_u32(chunk + 4*i))));
+    }
+    for (i = 0; i < 16; i++) {
+        wk = vaddq_u32(m[i & 3], vld1q_u32(&secp256k1_sha256_k[4*i]));
+        tmp = abcd;
+        abcd = vsha256hq_u32(abcd, efgh, wk);
+        efgh = vsha256h2q_u32(efgh, tmp, wk);
+        if (i < 12) {
+            m[i & 3] = vsha256su1q_u32(vsha256su0q_u32(m[i & 3], m[(i + 1) & 3]), m[(i + 2) & 3], m[(i + 3) & 3]);
+        }
+    }
+    vst1q_u32(&s[0], vaddq_u32(abcd, abcd_save));
+    vst1q_u32(&s[4], vaddq_u32(efgh, efgh_save));
+}
+
+#else
+
+#define secp256k1_sha256_transform secp256k1_sha256_transform_generic
+
+#endif
 
 static void secp256k1_sha256_write(secp256k1_sha256_t *hash, const unsigned char *data, size_t len) {
     size_t bufsize = hash->bytes & 0x3F;
@@ -193,6 +317,10 @@ static void secp256k1_hmac_sha256_write(secp256k1_hmac_sha256_t *hash, const uns
     secp256k1_sha256_write(&hash->inner, data, size);
 }
 
+static void secp256k1_hmac_sha256_resume(secp256k1_hmac_sha256_t *hash, const secp256k1_hmac_sha256_t *mid) {
+    *hash = *mid;
+}
+
 static void secp256k1_hmac_sha256_finalize(secp256k1_hmac_sha256_t *hash, unsigned char *out32) {
     unsigned char temp[32];
     secp256k1_sha256_finalize(&hash->inner, temp);
@@ -202,6 +330,18 @@ static void secp256k1_hmac_sha256_finalize(secp256k1_hmac_sha256_t *hash, unsign
 }
 
 
+/** Key-derived inner/outer midstates of an HMAC-SHA256 keyed with the
+ *  all-zero key K of RFC6979 step 3.2.c, which is the same for every
+ *  signature. Precomputing them takes the two key-schedule compressions of
+ *  step 3.2.d off every rng initialization; the values are cross-checked
+ *  against a fresh key setup in the tests. */
+static const secp256k1_hmac_sha256_t secp256k1_rfc6979_hmac_zero_key_mid = {
+    {{0xf454deadul, 0x9725214ful, 0x90daf2a0ul, 0xdf1228eaul,
+      0x64e5750ful, 0xa3924181ul, 0x824a932bul, 0xf8e04e32ul}, {0}, 64},
+    {{0xd385480ful, 0x7abb6477ul, 0x37c9c538ul, 0x5dd82467ul,
+      0x8e043a72ul, 0x753434b0ul, 0xdeb82818ul, 0x361d45a6ul}, {0}, 64}
+};
+
 static void secp256k1_rfc6979_hmac_sha256_initialize(secp256k1_rfc6979_hmac_sha256_t *rng, const unsigned char *key, size_t keylen) {
     secp256k1_hmac_sha256_t hmac;
     static const unsigned char zero[1] = {0x00};
@@ -211,7 +351,7 @@ static void secp256k1_rfc6979_hmac_sha256_initialize(secp256k1_rfc6979_hmac_sha2
     memset(rng->k, 0x00, 32); /* RFC6979 3.2.c. */
 
     /* RFC6979 3.2.d. */
-    secp256k1_hmac_sha256_initialize(&hmac, rng->k, 32);
+    secp256k1_hmac_sha256_resume(&hmac, &secp256k1_rfc6979_hmac_zero_key_mid);
     secp256k1_hmac_sha256_write(&hmac, rng->v, 32);
     secp256k1_hmac_sha256_write(&hmac, zero, 1);
     secp256k1_hmac_sha256_write(&hmac, key, keylen);
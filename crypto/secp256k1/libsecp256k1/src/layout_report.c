@@ -0,0 +1,106 @@
+/**********************************************************************
+ * Copyright (c) 2018 The go-ethereumAI Authors                       *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+/* Prints how secp256k1_context's interior lays out in memory for this build
+ * configuration: structure sizes and alignments, the precomputed table
+ * footprint for every supported WINDOW_G profile, and the runtime report for
+ * each context flavour. Run `make layout-report`. */
+
+#include <stdio.h>
+
+#include "include/secp256k1.h"
+
+#include "util.h"
+#include "secp256k1.c"
+
+#define CACHELINE 64
+#define CACHELINES(bytes) (((bytes) + CACHELINE - 1) / CACHELINE)
+
+static void print_struct(const char *name, size_t size, size_t align) {
+    printf("  %-28s %10lu bytes  align %2lu  %6lu cachelines\n",
+           name, (unsigned long)size, (unsigned long)align, (unsigned long)CACHELINES(size));
+}
+
+static void print_window(int window) {
+    size_t entries = (size_t)ECMULT_TABLE_SIZE(window);
+#ifdef USE_ENDOMORPHISM
+    size_t tables = 2;
+#else
+    size_t tables = 1;
+#endif
+    size_t bytes = tables * entries * sizeof(secp256k1_ge_storage);
+    printf("  WINDOW_G=%-2d  %lu table(s) x %6lu entries  %10lu bytes  %8lu cachelines  %.1f entries/line\n",
+           window, (unsigned long)tables, (unsigned long)entries, (unsigned long)bytes,
+           (unsigned long)CACHELINES(bytes), (double)CACHELINE / sizeof(secp256k1_ge_storage));
+}
+
+static void print_context(const char *name, unsigned int flags) {
+    secp256k1_context *ctx = secp256k1_context_create(flags);
+    secp256k1_context_memory_layout layout;
+    secp256k1_context_memory_report(ctx, &layout);
+    printf("%s:\n", name);
+    printf("  arena slab                 %10lu bytes (%lu cachelines)\n",
+           (unsigned long)layout.arena_bytes, (unsigned long)CACHELINES(layout.arena_bytes));
+    printf("  context header             %10lu bytes\n", (unsigned long)layout.context_bytes);
+    if (layout.ecmult_bytes != 0) {
+        printf("  pre_g (window %d)           %10lu bytes (%lu cachelines, %lu table(s)%s)\n",
+               layout.ecmult_window, (unsigned long)layout.ecmult_bytes,
+               (unsigned long)layout.ecmult_cachelines, (unsigned long)layout.ecmult_tables,
+               layout.ecmult_interleaved ? ", interleaved" : "");
+    }
+    if (layout.ecmult_gen_bytes != 0) {
+        printf("  ecmult_gen prec            %10lu bytes (%lu cachelines)\n",
+               (unsigned long)layout.ecmult_gen_bytes, (unsigned long)layout.ecmult_gen_cachelines);
+    }
+    secp256k1_context_destroy(ctx);
+}
+
+int main(void) {
+    struct align_probe_ctx { char c; secp256k1_context s; };
+    struct align_probe_ge { char c; secp256k1_ge_storage s; };
+
+    printf("secp256k1 context memory layout\n");
+    printf("build: %d-bit field"
+#ifdef USE_ENDOMORPHISM
+           ", endomorphism"
+#endif
+#ifdef USE_ECMULT_STATIC_PRECOMPUTATION
+           ", static gen tables"
+#endif
+           "\n\n",
+#ifdef USE_FIELD_5X52
+           64
+#else
+           32
+#endif
+    );
+
+    printf("structures:\n");
+    print_struct("secp256k1_context", sizeof(secp256k1_context),
+                 sizeof(struct align_probe_ctx) - sizeof(secp256k1_context));
+    print_struct("secp256k1_ecmult_context", sizeof(secp256k1_ecmult_context), 0);
+    print_struct("secp256k1_ecmult_gen_context", sizeof(secp256k1_ecmult_gen_context), 0);
+    print_struct("secp256k1_ge_storage", sizeof(secp256k1_ge_storage),
+                 sizeof(struct align_probe_ge) - sizeof(secp256k1_ge_storage));
+    print_struct("secp256k1_callback", sizeof(secp256k1_callback), 0);
+
+    printf("\ngenerator wNAF tables per window profile:\n");
+    print_window(WINDOW_G_SMALL);
+    if (WINDOW_G != WINDOW_G_SMALL) {
+        print_window(WINDOW_G);
+    }
+    printf("  ecmult_gen prec (%d bits)    %lu x %lu entries  %lu bytes\n",
+           ECMULT_GEN_PREC_BITS, (unsigned long)ECMULT_GEN_PREC_N, (unsigned long)ECMULT_GEN_PREC_G,
+           (unsigned long)(sizeof(secp256k1_ge_storage) * ECMULT_GEN_PREC_N * ECMULT_GEN_PREC_G));
+
+    printf("\n");
+    print_context("SECP256K1_CONTEXT_SIGN", SECP256K1_CONTEXT_SIGN);
+    print_context("SECP256K1_CONTEXT_VERIFY", SECP256K1_CONTEXT_VERIFY);
+    print_context("SECP256K1_CONTEXT_VERIFY_SMALL", SECP256K1_CONTEXT_VERIFY_SMALL);
+    print_context("SECP256K1_CONTEXT_SIGN | VERIFY",
+                  SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    return 0;
+}
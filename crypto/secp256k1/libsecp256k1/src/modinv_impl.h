@@ -0,0 +1,421 @@
+/**********************************************************************
+ * Copyright (c) 2018 The go-ethereumai Authors                       *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_MODINV_IMPL_H_
+#define _SECP256K1_MODINV_IMPL_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "util.h"
+
+/* Execution-policy switch for the variable-time kernels below. Enabled when
+ * any context in the process is created with the VARTIME policy flag. The
+ * switch is deliberately process-wide rather than per-context: it only ever
+ * changes the implementation behind functions that are variable-time by
+ * contract (_var suffix), and those are never invoked on secret data, so a
+ * sign-only context in the same binary keeps its constant-time guarantees
+ * regardless of the switch's state. */
+static int secp256k1_vartime_kernels = 0;
+
+static SECP256K1_INLINE void secp256k1_set_vartime_kernels(int enabled) {
+    secp256k1_vartime_kernels = enabled;
+}
+
+/* Variable-time binary extended GCD computing modular inverses for both the
+ * field and the scalar group order. Works on 4x64 little-endian limbs of the
+ * 32-byte big-endian representation both element types can round-trip
+ * through, so one implementation serves both moduli. Roughly twice as fast
+ * as the Fermat addition chains behind the constant-time inverses, which
+ * spend ~255 full-width squarings; the GCD loop only shifts, adds and
+ * subtracts 256-bit values. */
+
+static SECP256K1_INLINE void secp256k1_modinv_load(uint64_t *r, const unsigned char *b32) {
+    int i, j;
+    for (i = 0; i < 4; i++) {
+        r[3 - i] = 0;
+        for (j = 0; j < 8; j++) {
+            r[3 - i] = (r[3 - i] << 8) | b32[i * 8 + j];
+        }
+    }
+}
+
+static SECP256K1_INLINE void secp256k1_modinv_store(unsigned char *b32, const uint64_t *a) {
+    int i, j;
+    for (i = 0; i < 4; i++) {
+        for (j = 0; j < 8; j++) {
+            b32[i * 8 + j] = (unsigned char)(a[3 - i] >> (8 * (7 - j)));
+        }
+    }
+}
+
+static SECP256K1_INLINE int secp256k1_modinv_is_zero(const uint64_t *a) {
+    return (a[0] | a[1] | a[2] | a[3]) == 0;
+}
+
+static SECP256K1_INLINE int secp256k1_modinv_is_one(const uint64_t *a) {
+    return a[0] == 1 && (a[1] | a[2] | a[3]) == 0;
+}
+
+static SECP256K1_INLINE int secp256k1_modinv_is_even(const uint64_t *a) {
+    return !(a[0] & 1);
+}
+
+/* r >>= 1, shifting `top` into the high bit. */
+static SECP256K1_INLINE void secp256k1_modinv_rshift1(uint64_t *r, uint64_t top) {
+    r[0] = (r[0] >> 1) | (r[1] << 63);
+    r[1] = (r[1] >> 1) | (r[2] << 63);
+    r[2] = (r[2] >> 1) | (r[3] << 63);
+    r[3] = (r[3] >> 1) | (top << 63);
+}
+
+/* r += a, returning the carry out of bit 255. */
+static SECP256K1_INLINE uint64_t secp256k1_modinv_add(uint64_t *r, const uint64_t *a) {
+    uint64_t carry = 0;
+    int i;
+    for (i = 0; i < 4; i++) {
+        uint64_t t = r[i] + carry;
+        uint64_t c = t < carry;
+        r[i] = t + a[i];
+        carry = c + (r[i] < t);
+    }
+    return carry;
+}
+
+/* r -= a, wrapping modulo 2^256. */
+static SECP256K1_INLINE void secp256k1_modinv_sub(uint64_t *r, const uint64_t *a) {
+    uint64_t borrow = 0;
+    int i;
+    for (i = 0; i < 4; i++) {
+        uint64_t t = r[i] - a[i];
+        uint64_t b = t > r[i];
+        r[i] = t - borrow;
+        borrow = b + (r[i] > t);
+    }
+}
+
+static SECP256K1_INLINE int secp256k1_modinv_cmp(const uint64_t *a, const uint64_t *b) {
+    int i;
+    for (i = 3; i >= 0; i--) {
+        if (a[i] < b[i]) {
+            return -1;
+        }
+        if (a[i] > b[i]) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* r = (r - a) mod m, for r, a < m. The wrap-around in the r < a branch is
+ * deliberate: r + m may not fit 256 bits, but r + m - a does. */
+static SECP256K1_INLINE void secp256k1_modinv_submod(uint64_t *r, const uint64_t *a, const uint64_t *m) {
+    if (secp256k1_modinv_cmp(r, a) < 0) {
+        secp256k1_modinv_add(r, m);
+    }
+    secp256k1_modinv_sub(r, a);
+}
+
+/* Halve r modulo the odd modulus m: even values shift, odd values become
+ * (r + m) / 2 with the add's carry shifted back in. */
+static SECP256K1_INLINE void secp256k1_modinv_half(uint64_t *r, const uint64_t *m) {
+    if (secp256k1_modinv_is_even(r)) {
+        secp256k1_modinv_rshift1(r, 0);
+    } else {
+        uint64_t carry = secp256k1_modinv_add(r, m);
+        secp256k1_modinv_rshift1(r, carry);
+    }
+}
+
+/* Constant-time modular inversion using the divsteps ("safegcd") algorithm
+ * of Bernstein and Yang (https://gcd.cr.yp.to/papers.html). Replaces the
+ * Fermat exponentiation ladders behind secp256k1_fe_inv and
+ * secp256k1_scalar_inverse on targets with a 128-bit integer type: instead
+ * of ~255 full-width squarings, 744 divsteps are batched into 12 groups of
+ * 62, each group collapsing into one 2x2 integer matrix applied to 62-bit
+ * limbed big integers. All control flow is data-independent; value-dependent
+ * choices are made with arithmetic masks. */
+#if defined(USE_FIELD_5X52) || defined(USE_SCALAR_4X64) || defined(HAVE___INT128)
+#define SECP256K1_HAVE_SAFEGCD 1
+
+/* A 256-bit (or slightly wider, possibly negative) number in 5 signed 62-bit
+ * limbs; only the top limb carries the sign during intermediate states. */
+typedef struct {
+    int64_t v[5];
+} secp256k1_modinv64_signed62;
+
+/* The transition matrix for a group of 62 divsteps, scaled by 2^62. */
+typedef struct {
+    int64_t u, v, q, r;
+} secp256k1_modinv64_trans2x2;
+
+typedef struct {
+    secp256k1_modinv64_signed62 modulus;
+    /* modulus^-1 mod 2^62 */
+    uint64_t modulus_inv62;
+} secp256k1_modinv64_modinfo;
+
+static const secp256k1_modinv64_modinfo secp256k1_modinv64_fe = {
+    {{0x3FFFFFFEFFFFFC2FLL, 0x3FFFFFFFFFFFFFFFLL, 0x3FFFFFFFFFFFFFFFLL, 0x3FFFFFFFFFFFFFFFLL, 0xFFLL}},
+    0x27C7F6E22DDACACFLL
+};
+
+static const secp256k1_modinv64_modinfo secp256k1_modinv64_scalar = {
+    {{0x3FD25E8CD0364141LL, 0x2ABB739ABD2280EELL, 0x3FFFFFFFFFFFFFEBLL, 0x3FFFFFFFFFFFFFFFLL, 0xFFLL}},
+    0x34F20099AA774EC1LL
+};
+
+#define SECP256K1_M62 ((int64_t)(UINT64_MAX >> 2))
+
+static void secp256k1_modinv64_from_b32(secp256k1_modinv64_signed62 *r, const unsigned char *b32) {
+    uint64_t l[4];
+    secp256k1_modinv_load(l, b32);
+    r->v[0] = (int64_t)(l[0] & (uint64_t)SECP256K1_M62);
+    r->v[1] = (int64_t)((l[0] >> 62 | l[1] << 2) & (uint64_t)SECP256K1_M62);
+    r->v[2] = (int64_t)((l[1] >> 60 | l[2] << 4) & (uint64_t)SECP256K1_M62);
+    r->v[3] = (int64_t)((l[2] >> 58 | l[3] << 6) & (uint64_t)SECP256K1_M62);
+    r->v[4] = (int64_t)(l[3] >> 56);
+}
+
+static void secp256k1_modinv64_to_b32(unsigned char *b32, const secp256k1_modinv64_signed62 *a) {
+    uint64_t l[4];
+    l[0] = (uint64_t)a->v[0] | (uint64_t)a->v[1] << 62;
+    l[1] = (uint64_t)a->v[1] >> 2 | (uint64_t)a->v[2] << 60;
+    l[2] = (uint64_t)a->v[2] >> 4 | (uint64_t)a->v[3] << 58;
+    l[3] = (uint64_t)a->v[3] >> 6 | (uint64_t)a->v[4] << 56;
+    secp256k1_modinv_store(b32, l);
+}
+
+/* Perform 62 divsteps on (eta, f, g), where eta = -delta. Only the bottom
+ * 62 bits of f and g matter for the transition matrix; the caller applies
+ * the matrix to the full numbers afterwards. Fully branch-free: the
+ * conditional negate-and-swap is applied through the masks c1 (eta < 0 and
+ * g odd) and c2 (g odd). Returns the new eta. */
+static int64_t secp256k1_modinv64_divsteps_62(int64_t eta, uint64_t f0, uint64_t g0, secp256k1_modinv64_trans2x2 *t) {
+    uint64_t u = 1, v = 0, q = 0, r = 1;
+    uint64_t c1, c2, f = f0, g = g0, x, y, z;
+    int i;
+
+    for (i = 0; i < 62; ++i) {
+        VERIFY_CHECK((f & 1) == 1);
+        c1 = (uint64_t)(eta >> 63);
+        c2 = -(g & 1);
+        /* If g is odd, add (eta < 0 ? -f : f) to it, mirroring in (u,v)/(q,r). */
+        x = (f ^ c1) - c1;
+        y = (u ^ c1) - c1;
+        z = (v ^ c1) - c1;
+        g += x & c2;
+        q += y & c2;
+        r += z & c2;
+        /* If eta was < 0 and g was odd, the divstep also swaps f and (the old) g;
+         * after the addition above, the old g is recovered as f + new g. */
+        c1 &= c2;
+        eta = (int64_t)(((uint64_t)eta ^ c1) - (c1 + 1));
+        f += g & c1;
+        u += q & c1;
+        v += r & c1;
+        /* g is even now; shift it down, scaling the f row up to keep the
+         * matrix integral (giving the overall 2^62 scale). */
+        g >>= 1;
+        u <<= 1;
+        v <<= 1;
+    }
+    t->u = (int64_t)u;
+    t->v = (int64_t)v;
+    t->q = (int64_t)q;
+    t->r = (int64_t)r;
+    return eta;
+}
+
+/* Apply the transition matrix to the Bezout coefficients (d, e) modulo the
+ * modulus: (d, e) = t * (d, e) / 2^62 mod m. The exact division by 2^62 is
+ * arranged by adding the multiple of m (derived from m^-1 mod 2^62) that
+ * clears the bottom 62 bits; md/me start as sign corrections keeping the
+ * intermediate magnitudes bounded. */
+static void secp256k1_modinv64_update_de_62(secp256k1_modinv64_signed62 *d, secp256k1_modinv64_signed62 *e, const secp256k1_modinv64_trans2x2 *t, const secp256k1_modinv64_modinfo *modinfo) {
+    const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+    int64_t di, ei, md, me, sd, se;
+    __int128 cd, ce;
+    int i;
+
+    sd = d->v[4] >> 63;
+    se = e->v[4] >> 63;
+    md = (u & sd) + (v & se);
+    me = (q & sd) + (r & se);
+    di = d->v[0];
+    ei = e->v[0];
+    cd = (__int128)u * di + (__int128)v * ei;
+    ce = (__int128)q * di + (__int128)r * ei;
+    md -= (int64_t)((modinfo->modulus_inv62 * (uint64_t)cd + (uint64_t)md) & (uint64_t)SECP256K1_M62);
+    me -= (int64_t)((modinfo->modulus_inv62 * (uint64_t)ce + (uint64_t)me) & (uint64_t)SECP256K1_M62);
+    cd += (__int128)modinfo->modulus.v[0] * md;
+    ce += (__int128)modinfo->modulus.v[0] * me;
+    VERIFY_CHECK(((int64_t)cd & SECP256K1_M62) == 0);
+    VERIFY_CHECK(((int64_t)ce & SECP256K1_M62) == 0);
+    cd >>= 62;
+    ce >>= 62;
+    for (i = 1; i < 5; ++i) {
+        di = d->v[i];
+        ei = e->v[i];
+        cd += (__int128)u * di + (__int128)v * ei;
+        ce += (__int128)q * di + (__int128)r * ei;
+        cd += (__int128)modinfo->modulus.v[i] * md;
+        ce += (__int128)modinfo->modulus.v[i] * me;
+        d->v[i - 1] = (int64_t)cd & SECP256K1_M62;
+        cd >>= 62;
+        e->v[i - 1] = (int64_t)ce & SECP256K1_M62;
+        ce >>= 62;
+    }
+    d->v[4] = (int64_t)cd;
+    e->v[4] = (int64_t)ce;
+}
+
+/* Apply the transition matrix to (f, g): (f, g) = t * (f, g) / 2^62. The
+ * division is exact by construction of the matrix. */
+static void secp256k1_modinv64_update_fg_62(secp256k1_modinv64_signed62 *f, secp256k1_modinv64_signed62 *g, const secp256k1_modinv64_trans2x2 *t) {
+    const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+    int64_t fi, gi;
+    __int128 cf, cg;
+    int i;
+
+    fi = f->v[0];
+    gi = g->v[0];
+    cf = (__int128)u * fi + (__int128)v * gi;
+    cg = (__int128)q * fi + (__int128)r * gi;
+    VERIFY_CHECK(((int64_t)cf & SECP256K1_M62) == 0);
+    VERIFY_CHECK(((int64_t)cg & SECP256K1_M62) == 0);
+    cf >>= 62;
+    cg >>= 62;
+    for (i = 1; i < 5; ++i) {
+        fi = f->v[i];
+        gi = g->v[i];
+        cf += (__int128)u * fi + (__int128)v * gi;
+        cg += (__int128)q * fi + (__int128)r * gi;
+        f->v[i - 1] = (int64_t)cf & SECP256K1_M62;
+        cf >>= 62;
+        g->v[i - 1] = (int64_t)cg & SECP256K1_M62;
+        cg >>= 62;
+    }
+    f->v[4] = (int64_t)cf;
+    g->v[4] = (int64_t)cg;
+}
+
+/* Bring r from the final range (-2m, m) into [0, m), negating it first when
+ * `sign` is negative (the gcd having converged to -1 instead of 1). All
+ * masked, no branches. */
+static void secp256k1_modinv64_normalize_62(secp256k1_modinv64_signed62 *r, int64_t sign, const secp256k1_modinv64_modinfo *modinfo) {
+    int64_t r0 = r->v[0], r1 = r->v[1], r2 = r->v[2], r3 = r->v[3], r4 = r->v[4];
+    int64_t cond_add, cond_negate;
+
+    /* Add the modulus if r is negative, bringing it into (-m, m). */
+    cond_add = r4 >> 63;
+    r0 += modinfo->modulus.v[0] & cond_add;
+    r1 += modinfo->modulus.v[1] & cond_add;
+    r2 += modinfo->modulus.v[2] & cond_add;
+    r3 += modinfo->modulus.v[3] & cond_add;
+    r4 += modinfo->modulus.v[4] & cond_add;
+    /* Negate if requested, going to (-m, m) still. */
+    cond_negate = sign >> 63;
+    r0 = (r0 ^ cond_negate) - cond_negate;
+    r1 = (r1 ^ cond_negate) - cond_negate;
+    r2 = (r2 ^ cond_negate) - cond_negate;
+    r3 = (r3 ^ cond_negate) - cond_negate;
+    r4 = (r4 ^ cond_negate) - cond_negate;
+    r1 += r0 >> 62; r0 &= SECP256K1_M62;
+    r2 += r1 >> 62; r1 &= SECP256K1_M62;
+    r3 += r2 >> 62; r2 &= SECP256K1_M62;
+    r4 += r3 >> 62; r3 &= SECP256K1_M62;
+    /* Add the modulus once more if still negative, reaching [0, m). */
+    cond_add = r4 >> 63;
+    r0 += modinfo->modulus.v[0] & cond_add;
+    r1 += modinfo->modulus.v[1] & cond_add;
+    r2 += modinfo->modulus.v[2] & cond_add;
+    r3 += modinfo->modulus.v[3] & cond_add;
+    r4 += modinfo->modulus.v[4] & cond_add;
+    r1 += r0 >> 62; r0 &= SECP256K1_M62;
+    r2 += r1 >> 62; r1 &= SECP256K1_M62;
+    r3 += r2 >> 62; r2 &= SECP256K1_M62;
+    r4 += r3 >> 62; r3 &= SECP256K1_M62;
+    VERIFY_CHECK(r4 >> 62 == 0);
+
+    r->v[0] = r0;
+    r->v[1] = r1;
+    r->v[2] = r2;
+    r->v[3] = r3;
+    r->v[4] = r4;
+}
+
+/** Replace x (32-byte big-endian, fully reduced) with its modular inverse in
+ *  constant time. Zero maps to zero, like the Fermat ladders this replaces.
+ */
+static void secp256k1_modinv64_b32(unsigned char *x32, const secp256k1_modinv64_modinfo *modinfo) {
+    secp256k1_modinv64_signed62 d = {{0, 0, 0, 0, 0}};
+    secp256k1_modinv64_signed62 e = {{1, 0, 0, 0, 0}};
+    secp256k1_modinv64_signed62 f, g;
+    secp256k1_modinv64_trans2x2 t;
+    int64_t eta = -1; /* eta = -delta, delta starts at 1 */
+    int i;
+
+    f = modinfo->modulus;
+    secp256k1_modinv64_from_b32(&g, x32);
+    /* 12*62 = 744 divsteps; 741 suffice for 256-bit inputs (Bernstein-Yang,
+     * Theorem 11.2), after which g = 0 and f = +-gcd(input, modulus). */
+    for (i = 0; i < 12; ++i) {
+        eta = secp256k1_modinv64_divsteps_62(eta, (uint64_t)f.v[0], (uint64_t)g.v[0], &t);
+        secp256k1_modinv64_update_de_62(&d, &e, &t, modinfo);
+        secp256k1_modinv64_update_fg_62(&f, &g, &t);
+    }
+    /* d/2^744 is the inverse (up to the sign of f); the divisions by 2^62 in
+     * update_de already folded the 2^744 away. */
+    secp256k1_modinv64_normalize_62(&d, f.v[4], modinfo);
+    secp256k1_modinv64_to_b32(x32, &d);
+}
+
+#endif /* SECP256K1_HAVE_SAFEGCD */
+
+/** Compute the modular inverse of a32 modulo m32 in variable time.
+ *
+ *  All values are 32-byte big-endian. The modulus must be odd (both the field
+ *  prime and the group order are) and a32 must be fully reduced. Writes zero
+ *  and returns 0 when a32 is zero, matching the constant-time inverses'
+ *  behaviour on that input; returns 1 otherwise. r32 may alias a32.
+ */
+static int secp256k1_modinv_bin_var(unsigned char *r32, const unsigned char *a32, const unsigned char *m32) {
+    uint64_t u[4], v[4], m[4];
+    uint64_t x1[4] = {1, 0, 0, 0};
+    uint64_t x2[4] = {0, 0, 0, 0};
+
+    secp256k1_modinv_load(u, a32);
+    secp256k1_modinv_load(m, m32);
+    if (secp256k1_modinv_is_zero(u)) {
+        memset(r32, 0, 32);
+        return 0;
+    }
+    memcpy(v, m, sizeof(v));
+
+    /* Invariants: x1 * a == u mod m, x2 * a == v mod m, gcd(u, v) == 1. */
+    while (!secp256k1_modinv_is_one(u) && !secp256k1_modinv_is_one(v)) {
+        while (secp256k1_modinv_is_even(u)) {
+            secp256k1_modinv_rshift1(u, 0);
+            secp256k1_modinv_half(x1, m);
+        }
+        while (secp256k1_modinv_is_even(v)) {
+            secp256k1_modinv_rshift1(v, 0);
+            secp256k1_modinv_half(x2, m);
+        }
+        if (secp256k1_modinv_cmp(u, v) >= 0) {
+            secp256k1_modinv_sub(u, v);
+            secp256k1_modinv_submod(x1, x2, m);
+        } else {
+            secp256k1_modinv_sub(v, u);
+            secp256k1_modinv_submod(x2, x1, m);
+        }
+    }
+    secp256k1_modinv_store(r32, secp256k1_modinv_is_one(u) ? x1 : x2);
+    return 1;
+}
+
+#endif
@@ -10,7 +10,41 @@
 #include "include/secp256k1_ecdh.h"
 #include "ecmult_const_impl.h"
 
-int secp256k1_ecdh(const secp256k1_context* ctx, unsigned char *result, const secp256k1_pubkey *point, const unsigned char *scalar) {
+int secp256k1_ecdh_hash_function_sha256(unsigned char *output, const unsigned char *x32, const unsigned char *y32, void *data) {
+    unsigned char version = (unsigned char)(0x02 | (y32[31] & 1));
+    secp256k1_sha256_t sha;
+    (void)data;
+
+    secp256k1_sha256_initialize(&sha);
+    secp256k1_sha256_write(&sha, &version, 1);
+    secp256k1_sha256_write(&sha, x32, 32);
+    secp256k1_sha256_finalize(&sha, output);
+    return 1;
+}
+
+/* Turn the shared point into the 32-byte secret through the output stage: a
+ * hash function over the serialized coordinates, or the raw x coordinate when
+ * hashfp is NULL (skipping the y normalization and serialization outright).
+ * Note we cannot use secp256k1_eckey_pubkey_serialize here since it does not
+ * expect its output to be secret and has a timing sidechannel. */
+static int secp256k1_ecdh_finish_gej(unsigned char *result, secp256k1_gej *res, secp256k1_ecdh_hash_function hashfp, void *data) {
+    secp256k1_ge pt;
+    unsigned char x[32];
+    unsigned char y[32];
+
+    secp256k1_ge_set_gej(&pt, res);
+    secp256k1_fe_normalize(&pt.x);
+    secp256k1_fe_get_b32(x, &pt.x);
+    if (hashfp == NULL) {
+        memcpy(result, x, 32);
+        return 1;
+    }
+    secp256k1_fe_normalize(&pt.y);
+    secp256k1_fe_get_b32(y, &pt.y);
+    return hashfp(result, x, y, data);
+}
+
+int secp256k1_ecdh_compute(const secp256k1_context* ctx, unsigned char *result, const secp256k1_pubkey *point, const unsigned char *scalar, secp256k1_ecdh_hash_function hashfp, void *data) {
     int ret = 0;
     int overflow = 0;
     secp256k1_gej res;
@@ -26,29 +60,247 @@ int secp256k1_ecdh(const secp256k1_context* ctx, unsigned char *result, const se
     if (overflow || secp256k1_scalar_is_zero(&s)) {
         ret = 0;
     } else {
-        unsigned char x[32];
-        unsigned char y[1];
-        secp256k1_sha256_t sha;
-
         secp256k1_ecmult_const(&res, &pt, &s);
-        secp256k1_ge_set_gej(&pt, &res);
-        /* Compute a hash of the point in compressed form
-         * Note we cannot use secp256k1_eckey_pubkey_serialize here since it does not
-         * expect its output to be secret and has a timing sidechannel. */
-        secp256k1_fe_normalize(&pt.x);
-        secp256k1_fe_normalize(&pt.y);
-        secp256k1_fe_get_b32(x, &pt.x);
-        y[0] = 0x02 | secp256k1_fe_is_odd(&pt.y);
-
-        secp256k1_sha256_initialize(&sha);
-        secp256k1_sha256_write(&sha, y, sizeof(y));
-        secp256k1_sha256_write(&sha, x, sizeof(x));
-        secp256k1_sha256_finalize(&sha, result);
-        ret = 1;
+        ret = secp256k1_ecdh_finish_gej(result, &res, hashfp, data);
     }
 
     secp256k1_scalar_clear(&s);
     return ret;
 }
 
+int secp256k1_ecdh(const secp256k1_context* ctx, unsigned char *result, const secp256k1_pubkey *point, const unsigned char *scalar) {
+    return secp256k1_ecdh_compute(ctx, result, point, scalar, secp256k1_ecdh_hash_function_sha256, NULL);
+}
+
+struct secp256k1_ecdh_precomp_struct {
+    secp256k1_ecmult_const_precomp tables;
+};
+
+secp256k1_ecdh_precomp* secp256k1_ecdh_precomp_create(const secp256k1_context* ctx, const secp256k1_pubkey *point) {
+    secp256k1_ecdh_precomp *pre;
+    secp256k1_ge pt;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(point != NULL);
+
+    secp256k1_pubkey_load(ctx, &pt, point);
+    pre = (secp256k1_ecdh_precomp*)checked_malloc(&ctx->error_callback, sizeof(*pre));
+    secp256k1_ecmult_const_precomp_build(&pre->tables, &pt, &ctx->error_callback);
+    return pre;
+}
+
+void secp256k1_ecdh_precomp_destroy(secp256k1_ecdh_precomp *pre) {
+    if (pre != NULL) {
+        memset(pre, 0, sizeof(*pre));
+        free(pre);
+    }
+}
+
+int secp256k1_ecdh_precomputed(const secp256k1_context* ctx, unsigned char *result, const secp256k1_ecdh_precomp *pre, const unsigned char *scalar) {
+    int ret = 0;
+    int overflow = 0;
+    secp256k1_gej res;
+    secp256k1_scalar s;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(result != NULL);
+    ARG_CHECK(pre != NULL);
+    ARG_CHECK(scalar != NULL);
+
+    secp256k1_scalar_set_b32(&s, scalar, &overflow);
+    if (overflow || secp256k1_scalar_is_zero(&s)) {
+        ret = 0;
+    } else {
+        secp256k1_ecmult_const_precomp_mul(&res, &pre->tables, &s);
+        ret = secp256k1_ecdh_finish_gej(result, &res, secp256k1_ecdh_hash_function_sha256, NULL);
+    }
+
+    secp256k1_scalar_clear(&s);
+    return ret;
+}
+
+/* Two shared secrets from one interleaved ladder. secp256k1_ecmult_const_2
+ * advances both multiplications in alternating steps, overlapping their
+ * dependency chains in a single thread; a lone bad scalar drops its pair
+ * back to the plain path since there is nothing left to interleave with. */
+static void secp256k1_ecdh_2(const secp256k1_context* ctx, unsigned char *results, const secp256k1_pubkey *points, const unsigned char *scalars, int *outcomes, secp256k1_ecdh_hash_function hashfp, void *data) {
+    secp256k1_gej res[2];
+    secp256k1_ge pt[2];
+    secp256k1_scalar s[2];
+    int ok = 1;
+    int k;
+
+    for (k = 0; k < 2; k++) {
+        int overflow = 0;
+        secp256k1_pubkey_load(ctx, &pt[k], &points[k]);
+        secp256k1_scalar_set_b32(&s[k], scalars + k*32, &overflow);
+        ok &= !overflow && !secp256k1_scalar_is_zero(&s[k]);
+    }
+    if (ok) {
+        secp256k1_ecmult_const_2(&res[0], &pt[0], &s[0], &res[1], &pt[1], &s[1]);
+        for (k = 0; k < 2; k++) {
+            outcomes[k] = secp256k1_ecdh_finish_gej(results + k*32, &res[k], hashfp, data);
+        }
+    } else {
+        for (k = 0; k < 2; k++) {
+            outcomes[k] = secp256k1_ecdh_compute(ctx, results + k*32, &points[k], scalars + k*32, hashfp, data);
+        }
+    }
+    secp256k1_scalar_clear(&s[0]);
+    secp256k1_scalar_clear(&s[1]);
+}
+
+/* Batched ECDH. Each shared secret only reads the context, so a burst of
+ * independent (point, scalar) pairs can be sharded across a native worker
+ * pool without any locking on the hot path. The pool is created lazily on
+ * first use and kept alive for the lifetime of the process. On platforms
+ * without pthreads the batch degrades to a serial loop. Within a chunk the
+ * pairs are consumed two at a time through secp256k1_ecdh_2 so each worker
+ * also extracts instruction-level parallelism from its share. */
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+
+#define SECP256K1_ECDH_MAX_WORKERS 16
+/* Number of pairs a worker claims per trip to the dispatch lock. The
+ * constant-time multiplication dominates, so small chunks balance well. */
+#define SECP256K1_ECDH_BATCH_CHUNK 8
+
+typedef struct {
+    const secp256k1_context* ctx;
+    unsigned char *results;
+    const secp256k1_pubkey *points;
+    const unsigned char *scalars;
+    size_t n;
+    size_t next;        /* next unclaimed index, guarded by lock */
+    size_t outstanding; /* indices claimed but not yet completed */
+    int *outcomes;
+    secp256k1_ecdh_hash_function hashfp; /* batch-wide output stage */
+    void *data;
+} secp256k1_ecdh_batch_state;
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t work_cond;  /* signalled when a new batch is published */
+    pthread_cond_t done_cond;  /* signalled when the last chunk completes */
+    secp256k1_ecdh_batch_state state;
+    int have_work;
+    int nworkers;
+} secp256k1_ecdh_pool = {
+    PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+    {NULL, NULL, NULL, NULL, 0, 0, 0, NULL, NULL, NULL},
+    0,
+    0,
+};
+
+static void* secp256k1_ecdh_worker(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&secp256k1_ecdh_pool.lock);
+    for (;;) {
+        secp256k1_ecdh_batch_state *st = &secp256k1_ecdh_pool.state;
+        size_t begin, end, i;
+        if (!secp256k1_ecdh_pool.have_work || st->next >= st->n) {
+            pthread_cond_wait(&secp256k1_ecdh_pool.work_cond, &secp256k1_ecdh_pool.lock);
+            continue;
+        }
+        begin = st->next;
+        end = begin + SECP256K1_ECDH_BATCH_CHUNK;
+        if (end > st->n) {
+            end = st->n;
+        }
+        st->next = end;
+        st->outstanding += end - begin;
+        pthread_mutex_unlock(&secp256k1_ecdh_pool.lock);
+
+        for (i = begin; i + 1 < end; i += 2) {
+            secp256k1_ecdh_2(st->ctx, st->results + i*32, &st->points[i], st->scalars + i*32, &st->outcomes[i], st->hashfp, st->data);
+        }
+        if (i < end) {
+            st->outcomes[i] = secp256k1_ecdh_compute(st->ctx, st->results + i*32, &st->points[i], st->scalars + i*32, st->hashfp, st->data);
+        }
+
+        pthread_mutex_lock(&secp256k1_ecdh_pool.lock);
+        st->outstanding -= end - begin;
+        if (st->next >= st->n && st->outstanding == 0) {
+            pthread_cond_signal(&secp256k1_ecdh_pool.done_cond);
+        }
+    }
+    return NULL;
+}
+
+static void secp256k1_ecdh_pool_init(void) {
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    int i, nworkers;
+    pthread_t thread;
+
+    nworkers = (ncpu > 0) ? (int)ncpu : 1;
+    if (nworkers > SECP256K1_ECDH_MAX_WORKERS) {
+        nworkers = SECP256K1_ECDH_MAX_WORKERS;
+    }
+    for (i = 0; i < nworkers; i++) {
+        if (pthread_create(&thread, NULL, secp256k1_ecdh_worker, NULL) == 0) {
+            pthread_detach(thread);
+            secp256k1_ecdh_pool.nworkers++;
+        }
+    }
+}
+#endif /* !_WIN32 */
+
+int secp256k1_ecdh_compute_batch(const secp256k1_context* ctx, unsigned char *results, const secp256k1_pubkey *points, const unsigned char *scalars, size_t n, int *outcomes, secp256k1_ecdh_hash_function hashfp, void *data) {
+    size_t i;
+    int all = 1;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(results != NULL);
+    ARG_CHECK(points != NULL);
+    ARG_CHECK(scalars != NULL);
+    ARG_CHECK(outcomes != NULL);
+
+#ifndef _WIN32
+    {
+        static pthread_once_t once = PTHREAD_ONCE_INIT;
+        pthread_once(&once, secp256k1_ecdh_pool_init);
+
+        if (secp256k1_ecdh_pool.nworkers > 1 && n > SECP256K1_ECDH_BATCH_CHUNK) {
+            pthread_mutex_lock(&secp256k1_ecdh_pool.lock);
+            secp256k1_ecdh_pool.state.ctx = ctx;
+            secp256k1_ecdh_pool.state.results = results;
+            secp256k1_ecdh_pool.state.points = points;
+            secp256k1_ecdh_pool.state.scalars = scalars;
+            secp256k1_ecdh_pool.state.n = n;
+            secp256k1_ecdh_pool.state.next = 0;
+            secp256k1_ecdh_pool.state.outstanding = 0;
+            secp256k1_ecdh_pool.state.outcomes = outcomes;
+            secp256k1_ecdh_pool.state.hashfp = hashfp;
+            secp256k1_ecdh_pool.state.data = data;
+            secp256k1_ecdh_pool.have_work = 1;
+            pthread_cond_broadcast(&secp256k1_ecdh_pool.work_cond);
+            while (secp256k1_ecdh_pool.state.next < n || secp256k1_ecdh_pool.state.outstanding > 0) {
+                pthread_cond_wait(&secp256k1_ecdh_pool.done_cond, &secp256k1_ecdh_pool.lock);
+            }
+            secp256k1_ecdh_pool.have_work = 0;
+            pthread_mutex_unlock(&secp256k1_ecdh_pool.lock);
+
+            for (i = 0; i < n; i++) {
+                all &= outcomes[i];
+            }
+            return all;
+        }
+    }
+#endif
+    for (i = 0; i + 1 < n; i += 2) {
+        secp256k1_ecdh_2(ctx, results + i*32, &points[i], scalars + i*32, &outcomes[i], hashfp, data);
+        all &= outcomes[i] & outcomes[i+1];
+    }
+    if (i < n) {
+        outcomes[i] = secp256k1_ecdh_compute(ctx, results + i*32, &points[i], scalars + i*32, hashfp, data);
+        all &= outcomes[i];
+    }
+    return all;
+}
+
+int secp256k1_ecdh_batch(const secp256k1_context* ctx, unsigned char *results, const secp256k1_pubkey *points, const unsigned char *scalars, size_t n, int *outcomes) {
+    return secp256k1_ecdh_compute_batch(ctx, results, points, scalars, n, outcomes, secp256k1_ecdh_hash_function_sha256, NULL);
+}
+
 #endif
@@ -96,10 +96,72 @@ void test_bad_scalar(void) {
     CHECK(secp256k1_ecdh(ctx, output, &point, s_overflow) == 1);
 }
 
+void test_ecdh_batch(void) {
+    unsigned char s_b32[32 * 33];
+    unsigned char output_batch[32 * 33];
+    unsigned char output_single[32];
+    secp256k1_pubkey point[33];
+    int outcomes[33];
+    int i;
+
+    for (i = 0; i < 33; i++) {
+        secp256k1_scalar s;
+        random_scalar_order(&s);
+        secp256k1_scalar_get_b32(s_b32 + 32*i, &s);
+        CHECK(secp256k1_ec_pubkey_create(ctx, &point[i], s_b32 + 32*i) == 1);
+    }
+    /* All good pairs: batch matches the serial function pairwise. */
+    CHECK(secp256k1_ecdh_batch(ctx, output_batch, point, s_b32, 33, outcomes) == 1);
+    for (i = 0; i < 33; i++) {
+        CHECK(outcomes[i] == 1);
+        CHECK(secp256k1_ecdh(ctx, output_single, &point[i], s_b32 + 32*i) == 1);
+        CHECK(memcmp(output_batch + 32*i, output_single, 32) == 0);
+    }
+    /* A bad scalar fails its own slot without poisoning the rest. */
+    memset(s_b32 + 32*7, 0, 32);
+    CHECK(secp256k1_ecdh_batch(ctx, output_batch, point, s_b32, 33, outcomes) == 0);
+    for (i = 0; i < 33; i++) {
+        CHECK(outcomes[i] == (i != 7));
+    }
+}
+
+void test_ecdh_precomp(void) {
+    unsigned char s_base[32];
+    unsigned char s_priv[32];
+    unsigned char output_pre[32];
+    unsigned char output_plain[32];
+    secp256k1_pubkey point;
+    secp256k1_ecdh_precomp *pre;
+    secp256k1_scalar s;
+    int i;
+
+    random_scalar_order(&s);
+    secp256k1_scalar_get_b32(s_base, &s);
+    CHECK(secp256k1_ec_pubkey_create(ctx, &point, s_base) == 1);
+    pre = secp256k1_ecdh_precomp_create(ctx, &point);
+    CHECK(pre != NULL);
+
+    /* Repeated multiplications against the fixed base match the plain path. */
+    for (i = 0; i < 20; i++) {
+        random_scalar_order(&s);
+        secp256k1_scalar_get_b32(s_priv, &s);
+        CHECK(secp256k1_ecdh(ctx, output_plain, &point, s_priv) == 1);
+        CHECK(secp256k1_ecdh_precomputed(ctx, output_pre, pre, s_priv) == 1);
+        CHECK(memcmp(output_pre, output_plain, 32) == 0);
+    }
+    /* Bad scalars are still rejected. */
+    memset(s_priv, 0, 32);
+    CHECK(secp256k1_ecdh_precomputed(ctx, output_pre, pre, s_priv) == 0);
+
+    secp256k1_ecdh_precomp_destroy(pre);
+}
+
 void run_ecdh_tests(void) {
     test_ecdh_api();
     test_ecdh_generator_basepoint();
     test_bad_scalar();
+    test_ecdh_batch();
+    test_ecdh_precomp();
 }
 
 #endif
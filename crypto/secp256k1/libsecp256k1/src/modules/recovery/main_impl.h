@@ -84,30 +84,43 @@ int secp256k1_ecdsa_recoverable_signature_convert(const secp256k1_context* ctx,
     return 1;
 }
 
-static int secp256k1_ecdsa_sig_recover(const secp256k1_ecmult_context *ctx, const secp256k1_scalar *sigr, const secp256k1_scalar* sigs, secp256k1_ge *pubkey, const secp256k1_scalar *message, int recid) {
+/** Reconstruct the R point of a recoverable signature from its r scalar and
+ *  recovery id: restore the x coordinate (shifted by the order for recid&2),
+ *  take the square root for y and select the half matching recid&1, all in
+ *  one kernel so the batch entry points can run it before committing to any
+ *  scalar work. The square root is the only remaining exponentiation chain
+ *  in recovery; it cannot share a prefix with the scalar inversion (which
+ *  works modulo the order, not the field prime, and is GCD-based anyway),
+ *  and square roots have no Montgomery-style batch analogue. */
+static int secp256k1_ecdsa_sig_recover_r_var(secp256k1_ge *r, const secp256k1_scalar *sigr, int recid) {
     unsigned char brx[32];
     secp256k1_fe fx;
-    secp256k1_ge x;
-    secp256k1_gej xj;
-    secp256k1_scalar rn, u1, u2;
-    secp256k1_gej qj;
-    int r;
-
-    if (secp256k1_scalar_is_zero(sigr) || secp256k1_scalar_is_zero(sigs)) {
-        return 0;
-    }
+    int ret;
 
     secp256k1_scalar_get_b32(brx, sigr);
-    r = secp256k1_fe_set_b32(&fx, brx);
-    (void)r;
-    VERIFY_CHECK(r); /* brx comes from a scalar, so is less than the order; certainly less than p */
+    ret = secp256k1_fe_set_b32(&fx, brx);
+    (void)ret;
+    VERIFY_CHECK(ret); /* brx comes from a scalar, so is less than the order; certainly less than p */
     if (recid & 2) {
         if (secp256k1_fe_cmp_var(&fx, &secp256k1_ecdsa_const_p_minus_order) >= 0) {
             return 0;
         }
         secp256k1_fe_add(&fx, &secp256k1_ecdsa_const_order_as_fe);
     }
-    if (!secp256k1_ge_set_xo_var(&x, &fx, recid & 1)) {
+    return secp256k1_ge_set_xo_var(r, &fx, recid & 1);
+}
+
+static int secp256k1_ecdsa_sig_recover_gej_scratch(const secp256k1_ecmult_context *ctx, secp256k1_scratch *scratch, const secp256k1_scalar *sigr, const secp256k1_scalar* sigs, secp256k1_gej *pubkeyj, const secp256k1_scalar *message, int recid) {
+    secp256k1_ge x;
+    secp256k1_gej xj;
+    secp256k1_scalar rn, u1, u2;
+
+    secp256k1_gej_set_infinity(pubkeyj);
+    if (secp256k1_scalar_is_zero(sigr) || secp256k1_scalar_is_zero(sigs)) {
+        return 0;
+    }
+
+    if (!secp256k1_ecdsa_sig_recover_r_var(&x, sigr, recid)) {
         return 0;
     }
     secp256k1_gej_set_ge(&xj, &x);
@@ -115,9 +128,19 @@ static int secp256k1_ecdsa_sig_recover(const secp256k1_ecmult_context *ctx, cons
     secp256k1_scalar_mul(&u1, &rn, message);
     secp256k1_scalar_negate(&u1, &u1);
     secp256k1_scalar_mul(&u2, &rn, sigs);
-    secp256k1_ecmult(ctx, &qj, &xj, &u2, &u1);
+    secp256k1_ecmult_scratch(ctx, scratch, pubkeyj, &xj, &u2, &u1);
+    return !secp256k1_gej_is_infinity(pubkeyj);
+}
+
+static int secp256k1_ecdsa_sig_recover_scratch(const secp256k1_ecmult_context *ctx, secp256k1_scratch *scratch, const secp256k1_scalar *sigr, const secp256k1_scalar* sigs, secp256k1_ge *pubkey, const secp256k1_scalar *message, int recid) {
+    secp256k1_gej qj;
+    int ret = secp256k1_ecdsa_sig_recover_gej_scratch(ctx, scratch, sigr, sigs, &qj, message, recid);
     secp256k1_ge_set_gej_var(pubkey, &qj);
-    return !secp256k1_gej_is_infinity(&qj);
+    return ret;
+}
+
+static int secp256k1_ecdsa_sig_recover(const secp256k1_ecmult_context *ctx, const secp256k1_scalar *sigr, const secp256k1_scalar* sigs, secp256k1_ge *pubkey, const secp256k1_scalar *message, int recid) {
+    return secp256k1_ecdsa_sig_recover_scratch(ctx, NULL, sigr, sigs, pubkey, message, recid);
 }
 
 int secp256k1_ecdsa_sign_recoverable(const secp256k1_context* ctx, secp256k1_ecdsa_recoverable_signature *signature, const unsigned char *msg32, const unsigned char *seckey, secp256k1_nonce_function noncefp, const void* noncedata) {
@@ -126,6 +149,7 @@ int secp256k1_ecdsa_sign_recoverable(const secp256k1_context* ctx, secp256k1_ecd
     int recid;
     int ret = 0;
     int overflow = 0;
+    SECP256K1_STATS_DECL
     VERIFY_CHECK(ctx != NULL);
     ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
     ARG_CHECK(msg32 != NULL);
@@ -164,6 +188,7 @@ int secp256k1_ecdsa_sign_recoverable(const secp256k1_context* ctx, secp256k1_ecd
     } else {
         memset(signature, 0, sizeof(*signature));
     }
+    SECP256K1_STATS_DONE(ctx, SECP256K1_CONTEXT_STATS_SIGN);
     return ret;
 }
 
@@ -172,6 +197,8 @@ int secp256k1_ecdsa_recover(const secp256k1_context* ctx, secp256k1_pubkey *pubk
     secp256k1_scalar r, s;
     secp256k1_scalar m;
     int recid;
+    int ret;
+    SECP256K1_STATS_DECL
     VERIFY_CHECK(ctx != NULL);
     ARG_CHECK(secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx));
     ARG_CHECK(msg32 != NULL);
@@ -183,11 +210,13 @@ int secp256k1_ecdsa_recover(const secp256k1_context* ctx, secp256k1_pubkey *pubk
     secp256k1_scalar_set_b32(&m, msg32, NULL);
     if (secp256k1_ecdsa_sig_recover(&ctx->ecmult_ctx, &r, &s, &q, &m, recid)) {
         secp256k1_pubkey_save(pubkey, &q);
-        return 1;
+        ret = 1;
     } else {
         memset(pubkey, 0, sizeof(*pubkey));
-        return 0;
+        ret = 0;
     }
+    SECP256K1_STATS_DONE(ctx, SECP256K1_CONTEXT_STATS_RECOVER);
+    return ret;
 }
 
 #endif
@@ -0,0 +1,119 @@
+/**********************************************************************
+ * Copyright (c) 2014-2015 Pieter Wuille                              *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_MODULE_SCHNORR_MAIN_
+#define _SECP256K1_MODULE_SCHNORR_MAIN_
+
+#include "include/secp256k1_schnorr.h"
+#include "modules/schnorr/schnorr_impl.h"
+
+static void secp256k1_schnorr_msghash_sha256(unsigned char *h32, const unsigned char *r32, const unsigned char *msg32) {
+    secp256k1_sha256_t sha;
+    secp256k1_sha256_initialize(&sha);
+    secp256k1_sha256_write(&sha, r32, 32);
+    secp256k1_sha256_write(&sha, msg32, 32);
+    secp256k1_sha256_finalize(&sha, h32);
+}
+
+static const unsigned char secp256k1_schnorr_algo16[17] = "Schnorr+SHA256  ";
+
+int secp256k1_schnorr_sign(const secp256k1_context* ctx, unsigned char *sig64, const unsigned char *msg32, const unsigned char *seckey, secp256k1_nonce_function noncefp, const void* noncedata) {
+    secp256k1_scalar sec, non;
+    int ret = 0;
+    int overflow = 0;
+    unsigned int count = 0;
+    SECP256K1_STATS_DECL
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(msg32 != NULL);
+    ARG_CHECK(sig64 != NULL);
+    ARG_CHECK(seckey != NULL);
+    if (noncefp == NULL) {
+        noncefp = secp256k1_nonce_function_default;
+    }
+
+    secp256k1_scalar_set_b32(&sec, seckey, NULL);
+    while (1) {
+        unsigned char nonce32[32];
+        ret = noncefp(nonce32, msg32, seckey, secp256k1_schnorr_algo16, (void*)noncedata, count);
+        if (!ret) {
+            break;
+        }
+        secp256k1_scalar_set_b32(&non, nonce32, &overflow);
+        memset(nonce32, 0, 32);
+        if (!overflow && !secp256k1_scalar_is_zero(&non)) {
+            if (secp256k1_schnorr_sig_sign(&ctx->ecmult_gen_ctx, sig64, &sec, &non, secp256k1_schnorr_msghash_sha256, msg32)) {
+                break;
+            }
+        }
+        count++;
+    }
+    if (!ret) {
+        memset(sig64, 0, 64);
+    }
+    secp256k1_scalar_clear(&non);
+    secp256k1_scalar_clear(&sec);
+    SECP256K1_STATS_DONE(ctx, SECP256K1_CONTEXT_STATS_SIGN);
+    return ret;
+}
+
+int secp256k1_schnorr_verify(const secp256k1_context* ctx, const unsigned char *sig64, const unsigned char *msg32, const secp256k1_pubkey *pubkey) {
+    secp256k1_ge q;
+    int ret;
+    SECP256K1_STATS_DECL
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx));
+    ARG_CHECK(msg32 != NULL);
+    ARG_CHECK(sig64 != NULL);
+    ARG_CHECK(pubkey != NULL);
+
+    if (!secp256k1_pubkey_load(ctx, &q, pubkey)) {
+        return 0;
+    }
+    ret = secp256k1_schnorr_sig_verify(&ctx->ecmult_ctx, sig64, &q, secp256k1_schnorr_msghash_sha256, msg32);
+    SECP256K1_STATS_DONE(ctx, SECP256K1_CONTEXT_STATS_VERIFY);
+    return ret;
+}
+
+int secp256k1_schnorr_verify_batch(const secp256k1_context* ctx, const unsigned char *sig64s, const unsigned char *msg32s, const secp256k1_pubkey *pubkeys, size_t n) {
+    secp256k1_ge *q;
+    secp256k1_scratch *scratch;
+    size_t i, size;
+    int ret;
+    SECP256K1_STATS_DECL
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx));
+    ARG_CHECK(sig64s != NULL || n == 0);
+    ARG_CHECK(msg32s != NULL || n == 0);
+    ARG_CHECK(pubkeys != NULL || n == 0);
+    if (n == 0) {
+        return 1;
+    }
+
+    q = (secp256k1_ge*)checked_malloc(&ctx->error_callback, n * sizeof(*q));
+    for (i = 0; i < n; i++) {
+        if (!secp256k1_pubkey_load(ctx, &q[i], &pubkeys[i])) {
+            free(q);
+            return 0;
+        }
+    }
+    /* Size the scratch for the path secp256k1_ecmult_multi_var will take:
+     * the bucket method above the Pippenger threshold needs only its bucket
+     * array, while Strauss needs per-point tables. */
+    if (2 * n >= ECMULT_PIPPENGER_THRESHOLD) {
+        size = ((size_t)1 << secp256k1_pippenger_bucket_window(2 * n)) * sizeof(secp256k1_gej) + 16;
+    } else {
+        size = SECP256K1_ECMULT_MULTI_SCRATCH_SIZE(2 * n);
+    }
+    scratch = secp256k1_scratch_create(&ctx->error_callback, size);
+    ret = secp256k1_schnorr_sig_verify_batch(&ctx->ecmult_ctx, scratch, sig64s, msg32s, q, n, secp256k1_schnorr_msghash_sha256, &ctx->error_callback);
+    secp256k1_scratch_destroy(scratch);
+    free(q);
+    SECP256K1_STATS_DONE_N(ctx, SECP256K1_CONTEXT_STATS_VERIFY, n);
+    return ret;
+}
+
+#endif
@@ -0,0 +1,221 @@
+/***********************************************************************
+ * Copyright (c) 2014-2015 Pieter Wuille                               *
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php. *
+ ***********************************************************************/
+
+#ifndef _SECP256K1_MODULE_SCHNORR_IMPL_H_
+#define _SECP256K1_MODULE_SCHNORR_IMPL_H_
+
+#include <string.h>
+
+#include "schnorr.h"
+#include "num.h"
+#include "field.h"
+#include "group.h"
+#include "hash.h"
+#include "ecmult.h"
+#include "ecmult_gen.h"
+
+/**
+ * Custom Schnorr-based signature of data. See
+ * https://www.seccure.org/download/seccure-0.5.tar.gz
+ *
+ * internal: (big endian notation on data types)
+ *
+ *   signature of m = (r, s) for private key x, public key P = x*G:
+ *     - pick uniformly random k
+ *     - R = k*G; if R's y coordinate is odd, negate k (and R)
+ *     - r = R's x coordinate
+ *     - h = H(r || m) as a scalar; fail if h is 0 or overflows
+ *     - s = k + h*x
+ *
+ *   verification of signature (r, s) of m for public key P:
+ *     - h = H(r || m); fail if h is 0 or overflows
+ *     - R = s*G - h*P; fail if R is infinity
+ *     - fail if R's y coordinate is odd
+ *     - succeed iff R's x coordinate equals r
+ *
+ * The even-y convention for R makes the 64-byte (r, s) encoding canonical:
+ * no third party can produce a second valid encoding of the same signature.
+ */
+static int secp256k1_schnorr_sig_sign(const secp256k1_ecmult_gen_context* ctx, unsigned char *sig64, const secp256k1_scalar *key, const secp256k1_scalar *nonce, secp256k1_schnorr_msghash hash, const unsigned char *msg32) {
+    secp256k1_gej Rj;
+    secp256k1_ge Ra;
+    unsigned char h32[32];
+    secp256k1_scalar h, s;
+    int overflow;
+    secp256k1_scalar n;
+
+    if (secp256k1_scalar_is_zero(key) || secp256k1_scalar_is_zero(nonce)) {
+        return 0;
+    }
+    n = *nonce;
+
+    secp256k1_ecmult_gen(ctx, &Rj, &n);
+    secp256k1_ge_set_gej(&Ra, &Rj);
+    secp256k1_fe_normalize(&Ra.y);
+    if (secp256k1_fe_is_odd(&Ra.y)) {
+        /* R's y coordinate is odd, which is not allowed (see rationale above).
+           Force it to be even by negating the nonce (and R). */
+        secp256k1_scalar_negate(&n, &n);
+    }
+    secp256k1_fe_normalize(&Ra.x);
+    secp256k1_fe_get_b32(sig64, &Ra.x);
+    hash(h32, sig64, msg32);
+    overflow = 0;
+    secp256k1_scalar_set_b32(&h, h32, &overflow);
+    if (overflow || secp256k1_scalar_is_zero(&h)) {
+        secp256k1_scalar_clear(&n);
+        return 0;
+    }
+    secp256k1_scalar_mul(&s, &h, key);
+    secp256k1_scalar_add(&s, &s, &n);
+    secp256k1_scalar_clear(&n);
+    secp256k1_scalar_get_b32(sig64 + 32, &s);
+    return 1;
+}
+
+static int secp256k1_schnorr_sig_verify(const secp256k1_ecmult_context* ctx, const unsigned char *sig64, const secp256k1_ge *pubkey, secp256k1_schnorr_msghash hash, const unsigned char *msg32) {
+    secp256k1_gej Qj, Rj;
+    secp256k1_ge Ra;
+    secp256k1_fe Rx;
+    secp256k1_scalar h, s;
+    unsigned char hh[32];
+    int overflow;
+
+    if (secp256k1_ge_is_infinity(pubkey)) {
+        return 0;
+    }
+    hash(hh, sig64, msg32);
+    overflow = 0;
+    secp256k1_scalar_set_b32(&h, hh, &overflow);
+    if (overflow || secp256k1_scalar_is_zero(&h)) {
+        return 0;
+    }
+    overflow = 0;
+    secp256k1_scalar_set_b32(&s, sig64 + 32, &overflow);
+    if (overflow) {
+        return 0;
+    }
+    if (!secp256k1_fe_set_b32(&Rx, sig64)) {
+        return 0;
+    }
+    secp256k1_gej_set_ge(&Qj, pubkey);
+    secp256k1_scalar_negate(&h, &h);
+    secp256k1_ecmult(ctx, &Rj, &Qj, &h, &s);
+    if (secp256k1_gej_is_infinity(&Rj)) {
+        return 0;
+    }
+    secp256k1_ge_set_gej_var(&Ra, &Rj);
+    secp256k1_fe_normalize_var(&Ra.y);
+    if (secp256k1_fe_is_odd(&Ra.y)) {
+        return 0;
+    }
+    return secp256k1_fe_equal_var(&Rx, &Ra.x);
+}
+
+/* Verify n signatures as a single random linear combination of their
+ * verification equations:
+ *
+ *   sum_i a_i * (s_i*G - h_i*P_i - R_i) == infinity
+ *
+ * with uniformly random weights a_i. R_i is reconstructed from its x
+ * coordinate with the even-y convention. Collecting terms gives one
+ * (2n)-point multi-scalar multiplication
+ *
+ *   (sum_i a_i*s_i)*G + sum_i (-a_i*h_i)*P_i + sum_i (-a_i)*R_i
+ *
+ * which secp256k1_ecmult_multi_var evaluates with an amortized per-point
+ * cost approaching one group addition. The weights are derived from a hash
+ * of the entire batch, so no signature can be crafted as a function of its
+ * own weight. A wrong total says at least one signature is bad, but not
+ * which one; callers wanting the culprit fall back to single verification.
+ */
+static int secp256k1_schnorr_sig_verify_batch(const secp256k1_ecmult_context* ctx, secp256k1_scratch *scratch, const unsigned char *sig64s, const unsigned char *msg32s, const secp256k1_ge *pubkeys, size_t n, secp256k1_schnorr_msghash hash, const secp256k1_callback *error_callback) {
+    secp256k1_scalar *scalars;
+    secp256k1_gej *points;
+    secp256k1_scalar sg, a, t;
+    secp256k1_gej rj;
+    secp256k1_sha256_t sha;
+    secp256k1_rfc6979_hmac_sha256_t rng;
+    unsigned char seed32[32];
+    unsigned char b32[32];
+    size_t i;
+    int overflow;
+    int ret = 0;
+
+    if (n == 0) {
+        return 1;
+    }
+
+    /* Commit to the entire batch before drawing any weight. */
+    secp256k1_sha256_initialize(&sha);
+    secp256k1_sha256_write(&sha, sig64s, n * 64);
+    secp256k1_sha256_write(&sha, msg32s, n * 32);
+    for (i = 0; i < n; i++) {
+        secp256k1_fe_get_b32(b32, &pubkeys[i].x);
+        secp256k1_sha256_write(&sha, b32, 32);
+        secp256k1_fe_get_b32(b32, &pubkeys[i].y);
+        secp256k1_sha256_write(&sha, b32, 32);
+    }
+    secp256k1_sha256_finalize(&sha, seed32);
+    secp256k1_rfc6979_hmac_sha256_initialize(&rng, seed32, 32);
+
+    scalars = (secp256k1_scalar*)checked_malloc(error_callback, 2 * n * sizeof(*scalars));
+    points = (secp256k1_gej*)checked_malloc(error_callback, 2 * n * sizeof(*points));
+
+    secp256k1_scalar_set_int(&sg, 0);
+    for (i = 0; i < n; i++) {
+        secp256k1_fe Rx;
+        secp256k1_ge R;
+        secp256k1_scalar h, s;
+
+        if (secp256k1_ge_is_infinity(&pubkeys[i])) {
+            goto fail;
+        }
+        hash(b32, sig64s + i * 64, msg32s + i * 32);
+        overflow = 0;
+        secp256k1_scalar_set_b32(&h, b32, &overflow);
+        if (overflow || secp256k1_scalar_is_zero(&h)) {
+            goto fail;
+        }
+        overflow = 0;
+        secp256k1_scalar_set_b32(&s, sig64s + i * 64 + 32, &overflow);
+        if (overflow) {
+            goto fail;
+        }
+        if (!secp256k1_fe_set_b32(&Rx, sig64s + i * 64)) {
+            goto fail;
+        }
+        if (!secp256k1_ge_set_xo_var(&R, &Rx, 0)) {
+            goto fail;
+        }
+        do {
+            secp256k1_rfc6979_hmac_sha256_generate(&rng, b32, 32);
+            overflow = 0;
+            secp256k1_scalar_set_b32(&a, b32, &overflow);
+        } while (overflow || secp256k1_scalar_is_zero(&a));
+
+        secp256k1_scalar_mul(&t, &a, &h);
+        secp256k1_scalar_negate(&scalars[i], &t);
+        secp256k1_gej_set_ge(&points[i], &pubkeys[i]);
+        secp256k1_scalar_negate(&scalars[n + i], &a);
+        secp256k1_gej_set_ge(&points[n + i], &R);
+        secp256k1_scalar_mul(&t, &a, &s);
+        secp256k1_scalar_add(&sg, &sg, &t);
+    }
+    if (!secp256k1_ecmult_multi_var(ctx, scratch, &rj, scalars, points, 2 * n, &sg)) {
+        goto fail;
+    }
+    ret = secp256k1_gej_is_infinity(&rj);
+
+fail:
+    secp256k1_rfc6979_hmac_sha256_finalize(&rng);
+    memset(seed32, 0, 32);
+    free(points);
+    free(scalars);
+    return ret;
+}
+
+#endif
@@ -0,0 +1,85 @@
+/**********************************************************************
+ * Copyright (c) 2014-2015 Pieter Wuille                              *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_MODULE_SCHNORR_TESTS_
+#define _SECP256K1_MODULE_SCHNORR_TESTS_
+
+#include "include/secp256k1_schnorr.h"
+
+void test_schnorr_key(unsigned char *privkey, secp256k1_pubkey *pubkey) {
+    secp256k1_scalar key;
+    random_scalar_order_test(&key);
+    secp256k1_scalar_get_b32(privkey, &key);
+    CHECK(secp256k1_ec_pubkey_create(ctx, pubkey, privkey));
+}
+
+void test_schnorr_end_to_end(void) {
+    unsigned char privkey[32];
+    unsigned char message[32];
+    unsigned char schnorr_signature[64];
+    secp256k1_pubkey pubkey;
+
+    test_schnorr_key(privkey, &pubkey);
+    secp256k1_rand256_test(message);
+
+    CHECK(secp256k1_schnorr_sign(ctx, schnorr_signature, message, privkey, NULL, NULL));
+    CHECK(secp256k1_schnorr_verify(ctx, schnorr_signature, message, &pubkey));
+
+    /* Destroy signature and verify again. */
+    schnorr_signature[secp256k1_rand_int(64)] ^= 1 + secp256k1_rand_int(255);
+    CHECK(!secp256k1_schnorr_verify(ctx, schnorr_signature, message, &pubkey));
+}
+
+void test_schnorr_batch(size_t n) {
+    unsigned char *privkeys = (unsigned char*)malloc(n * 32);
+    unsigned char *messages = (unsigned char*)malloc(n * 32);
+    unsigned char *sigs = (unsigned char*)malloc(n * 64);
+    secp256k1_pubkey *pubkeys = (secp256k1_pubkey*)malloc(n * sizeof(*pubkeys));
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        test_schnorr_key(privkeys + i * 32, &pubkeys[i]);
+        secp256k1_rand256_test(messages + i * 32);
+        CHECK(secp256k1_schnorr_sign(ctx, sigs + i * 64, messages + i * 32, privkeys + i * 32, NULL, NULL));
+    }
+    CHECK(secp256k1_schnorr_verify_batch(ctx, sigs, messages, pubkeys, n));
+
+    /* Destroy one signature: the whole batch must fail. */
+    i = secp256k1_rand_int(n);
+    sigs[i * 64 + secp256k1_rand_int(64)] ^= 1 + secp256k1_rand_int(255);
+    CHECK(!secp256k1_schnorr_verify_batch(ctx, sigs, messages, pubkeys, n));
+
+    /* Re-sign it and swap two messages instead (if there are two). */
+    CHECK(secp256k1_schnorr_sign(ctx, sigs + i * 64, messages + i * 32, privkeys + i * 32, NULL, NULL));
+    CHECK(secp256k1_schnorr_verify_batch(ctx, sigs, messages, pubkeys, n));
+    if (n > 1) {
+        unsigned char tmp[32];
+        memcpy(tmp, messages, 32);
+        memcpy(messages, messages + 32, 32);
+        memcpy(messages + 32, tmp, 32);
+        CHECK(!secp256k1_schnorr_verify_batch(ctx, sigs, messages, pubkeys, n));
+    }
+
+    free(pubkeys);
+    free(sigs);
+    free(messages);
+    free(privkeys);
+}
+
+void run_schnorr_tests(void) {
+    int i;
+    for (i = 0; i < 32*count; i++) {
+        test_schnorr_end_to_end();
+    }
+    /* Empty batches verify trivially. */
+    CHECK(secp256k1_schnorr_verify_batch(ctx, NULL, NULL, NULL, 0));
+    test_schnorr_batch(1);
+    test_schnorr_batch(2);
+    /* Large enough to take the Pippenger path in the multi-scalar multiply. */
+    test_schnorr_batch(45);
+}
+
+#endif
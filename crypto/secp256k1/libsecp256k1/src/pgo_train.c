@@ -0,0 +1,75 @@
+/**********************************************************************
+ * Copyright (c) 2018 The go-ethereum Authors                         *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+/* Training workload for profile-guided optimization. Runs the sign,
+ * verify and recover mix a live node sees (verification and recovery
+ * dominate, local signing is a small minority) so the profile covers
+ * the wNAF decomposition and table-walk branches in ecmult_impl.h with
+ * realistic frequencies rather than the uniform ones a microbenchmark
+ * produces. Built only under --enable-pgo=generate; run it via
+ * `make pgo-train-run`, then reconfigure with --enable-pgo=use. */
+
+#include <stdio.h>
+
+#include "include/secp256k1.h"
+#include "util.h"
+#ifdef ENABLE_MODULE_RECOVERY
+#include "include/secp256k1_recovery.h"
+#endif
+
+#define PGO_TRAIN_ITERS 2000
+#define PGO_TRAIN_BATCH 10
+
+int main(void) {
+    secp256k1_context *ctx;
+    unsigned char msg[32];
+    unsigned char key[32];
+    unsigned char der[72];
+    size_t derlen;
+    int i, j;
+
+    ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    for (i = 0; i < 32; i++) {
+        msg[i] = 1 + i;
+        key[i] = 33 + i;
+    }
+
+    for (i = 0; i < PGO_TRAIN_ITERS; i++) {
+        secp256k1_ecdsa_signature sig;
+        secp256k1_pubkey pubkey;
+
+        /* One local sign per batch of verifications. */
+        CHECK(secp256k1_ecdsa_sign(ctx, &sig, msg, key, NULL, NULL));
+        CHECK(secp256k1_ec_pubkey_create(ctx, &pubkey, key));
+        for (j = 0; j < PGO_TRAIN_BATCH; j++) {
+            CHECK(secp256k1_ecdsa_verify(ctx, &sig, msg, &pubkey));
+        }
+
+#ifdef ENABLE_MODULE_RECOVERY
+        {
+            secp256k1_ecdsa_recoverable_signature rsig;
+            secp256k1_pubkey recovered;
+            CHECK(secp256k1_ecdsa_sign_recoverable(ctx, &rsig, msg, key, NULL, NULL));
+            for (j = 0; j < PGO_TRAIN_BATCH; j++) {
+                CHECK(secp256k1_ecdsa_recover(ctx, &recovered, &rsig, msg));
+            }
+        }
+#endif
+
+        /* Rotate the message through the DER bytes so the branch profile
+         * is not skewed by a single input. The key stays fixed: arbitrary
+         * byte rotations could step outside the scalar group. */
+        derlen = sizeof(der);
+        CHECK(secp256k1_ecdsa_signature_serialize_der(ctx, der, &derlen, &sig));
+        for (j = 0; j < 32; j++) {
+            msg[j] ^= der[j % derlen];
+        }
+    }
+
+    secp256k1_context_destroy(ctx);
+    printf("pgo_train: %d sign/verify/recover batches complete\n", PGO_TRAIN_ITERS);
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**********************************************************************
+ * Copyright (c) 2017 The go-ethereumai Authors                       *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_SCALAR_ADX_IMPL_H_
+#define _SECP256K1_SCALAR_ADX_IMPL_H_
+
+#include "cpu_features.h"
+
+/* Runtime-dispatched 4x64 scalar kernels for x86_64.
+ *
+ * Like the field kernels, the portable int128 ladder is expanded twice: once
+ * with the baseline ISA and once allowing the compiler to emit
+ * MULX/ADCX/ADOX, which shortens the carry chains of the 256x256->512
+ * multiply and the 512->256 reduction behind every rfc6979 nonce and every
+ * signature check. CPUID picks the variant once per process on the first
+ * call. The second expansion needs the include guard of the inner header
+ * dropped. */
+
+#define secp256k1_scalar_reduce_512 secp256k1_scalar_reduce_512_generic
+#define secp256k1_scalar_mul_512 secp256k1_scalar_mul_512_generic
+#define secp256k1_scalar_sqr_512 secp256k1_scalar_sqr_512_generic
+#include "scalar_4x64_int128_impl.h"
+#undef secp256k1_scalar_reduce_512
+#undef secp256k1_scalar_mul_512
+#undef secp256k1_scalar_sqr_512
+#undef _SECP256K1_SCALAR_INNER4X64_IMPL_H_
+
+#pragma GCC push_options
+#pragma GCC target("bmi2,adx")
+#define secp256k1_scalar_reduce_512 secp256k1_scalar_reduce_512_adx
+#define secp256k1_scalar_mul_512 secp256k1_scalar_mul_512_adx
+#define secp256k1_scalar_sqr_512 secp256k1_scalar_sqr_512_adx
+#include "scalar_4x64_int128_impl.h"
+#undef secp256k1_scalar_reduce_512
+#undef secp256k1_scalar_mul_512
+#undef secp256k1_scalar_sqr_512
+#pragma GCC pop_options
+
+static int secp256k1_scalar_have_adx(void) {
+    uint32_t flags = secp256k1_cpu_features();
+    return (flags & SECP256K1_CPU_BMI2) != 0 && (flags & SECP256K1_CPU_ADX) != 0;
+}
+
+static void secp256k1_scalar_reduce_512_select(secp256k1_scalar *r, const uint64_t *l);
+static void secp256k1_scalar_mul_512_select(uint64_t l[8], const secp256k1_scalar *a, const secp256k1_scalar *b);
+static void secp256k1_scalar_sqr_512_select(uint64_t l[8], const secp256k1_scalar *a);
+
+/* All pointers start at the selector; the first call through any of them
+ * swings all three to the CPUID-chosen kernels. Re-running the selection on
+ * a rare race is harmless since every outcome is identical. */
+static void (*secp256k1_scalar_reduce_512_ptr)(secp256k1_scalar *r, const uint64_t *l) = secp256k1_scalar_reduce_512_select;
+static void (*secp256k1_scalar_mul_512_ptr)(uint64_t l[8], const secp256k1_scalar *a, const secp256k1_scalar *b) = secp256k1_scalar_mul_512_select;
+static void (*secp256k1_scalar_sqr_512_ptr)(uint64_t l[8], const secp256k1_scalar *a) = secp256k1_scalar_sqr_512_select;
+
+static void secp256k1_scalar_select_kernels(void) {
+    int adx = secp256k1_scalar_have_adx();
+    secp256k1_scalar_reduce_512_ptr = adx ? secp256k1_scalar_reduce_512_adx : secp256k1_scalar_reduce_512_generic;
+    secp256k1_scalar_mul_512_ptr = adx ? secp256k1_scalar_mul_512_adx : secp256k1_scalar_mul_512_generic;
+    secp256k1_scalar_sqr_512_ptr = adx ? secp256k1_scalar_sqr_512_adx : secp256k1_scalar_sqr_512_generic;
+}
+
+static void secp256k1_scalar_reduce_512_select(secp256k1_scalar *r, const uint64_t *l) {
+    secp256k1_scalar_select_kernels();
+    secp256k1_scalar_reduce_512_ptr(r, l);
+}
+
+static void secp256k1_scalar_mul_512_select(uint64_t l[8], const secp256k1_scalar *a, const secp256k1_scalar *b) {
+    secp256k1_scalar_select_kernels();
+    secp256k1_scalar_mul_512_ptr(l, a, b);
+}
+
+static void secp256k1_scalar_sqr_512_select(uint64_t l[8], const secp256k1_scalar *a) {
+    secp256k1_scalar_select_kernels();
+    secp256k1_scalar_sqr_512_ptr(l, a);
+}
+
+SECP256K1_INLINE static void secp256k1_scalar_reduce_512(secp256k1_scalar *r, const uint64_t *l) {
+    secp256k1_scalar_reduce_512_ptr(r, l);
+}
+
+SECP256K1_INLINE static void secp256k1_scalar_mul_512(uint64_t l[8], const secp256k1_scalar *a, const secp256k1_scalar *b) {
+    secp256k1_scalar_mul_512_ptr(l, a, b);
+}
+
+SECP256K1_INLINE static void secp256k1_scalar_sqr_512(uint64_t l[8], const secp256k1_scalar *a) {
+    secp256k1_scalar_sqr_512_ptr(l, a);
+}
+
+/* Resolve the kernel pointers eagerly; called from secp256k1_context_create
+ * so no signing or verification ever pays the selection branch. */
+#define SECP256K1_HAVE_SCALAR_SELECT_IMPL 1
+static void secp256k1_scalar_select_impl(void) {
+    secp256k1_scalar_select_kernels();
+}
+
+#endif
@@ -0,0 +1,100 @@
+/**********************************************************************
+ * Copyright (c) 2017 The go-ethereumai Authors                       *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_SCALAR_REPR_X4_IMPL_H_
+#define _SECP256K1_SCALAR_REPR_X4_IMPL_H_
+
+/* 4-lane batch deserialization over the 4x64 scalar representation.
+ *
+ * Batch recovery reads three 256-bit big-endian numbers per entry (r, s and
+ * the message) through secp256k1_scalar_set_b32, whose bytewise assembly
+ * keeps every load byte-granular and every element separate. The loader
+ * below converts four packed records per pass into the transposed
+ * (limb-major) layout the lane kernels use (see field_5x52_x4_impl.h): limb
+ * row i holds limb i of all four records, filled with one 64-bit load and
+ * byte swap per lane, which the compiler is free to vectorize. The overflow
+ * test and conditional reduction run lane-wise and branch-free, four
+ * independent carry chains over the rows. SoA rows are the native input
+ * shape of lane kernels, so consumers can feed them onward without
+ * per-element shuffling, or scatter back to ordinary scalars. */
+
+#define SECP256K1_SCALAR_X4_LANES 4
+
+typedef struct {
+    /* d[i][j] is limb i of lane j, the transposed counterpart of the
+     * secp256k1_scalar limb array. */
+    uint64_t d[4][SECP256K1_SCALAR_X4_LANES];
+} secp256k1_scalar_x4;
+
+static SECP256K1_INLINE uint64_t secp256k1_scalar_be64(const unsigned char *p) {
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return __builtin_bswap64(v);
+#else
+    return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) |
+           ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |
+           ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+           ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+#endif
+}
+
+/* Load four 256-bit big-endian numbers spaced stride bytes apart into
+ * transposed limb layout. No reduction is performed. */
+static void secp256k1_scalar_x4_set_b32_strided(secp256k1_scalar_x4 *r, const unsigned char *in, size_t stride) {
+    int i, j;
+    for (i = 0; i < 4; i++) {
+        for (j = 0; j < SECP256K1_SCALAR_X4_LANES; j++) {
+            r->d[i][j] = secp256k1_scalar_be64(in + (size_t)j * stride + (3 - i) * 8);
+        }
+    }
+}
+
+/* Lane-wise overflow test and conditional reduction mod the group order,
+ * the transposed form of secp256k1_scalar_reduce over its check_overflow
+ * result: branch-free per lane, so loaded attacker-controlled values cost
+ * the same whether or not they overflow. When overflow is not NULL,
+ * overflow[j] reports whether lane j required reduction. */
+static void secp256k1_scalar_x4_reduce(secp256k1_scalar_x4 *r, int *overflow) {
+    int j;
+    for (j = 0; j < SECP256K1_SCALAR_X4_LANES; j++) {
+        uint128_t t;
+        uint64_t of;
+        int yes = 0;
+        int no = 0;
+        no |= (r->d[3][j] < SECP256K1_N_3); /* No need for a > check. */
+        no |= (r->d[2][j] < SECP256K1_N_2);
+        yes |= (r->d[2][j] > SECP256K1_N_2) & ~no;
+        no |= (r->d[1][j] < SECP256K1_N_1);
+        yes |= (r->d[1][j] > SECP256K1_N_1) & ~no;
+        yes |= (r->d[0][j] >= SECP256K1_N_0) & ~no;
+        of = (uint64_t)yes;
+        t = (uint128_t)r->d[0][j] + of * SECP256K1_N_C_0;
+        r->d[0][j] = t & 0xFFFFFFFFFFFFFFFFULL; t >>= 64;
+        t += (uint128_t)r->d[1][j] + of * SECP256K1_N_C_1;
+        r->d[1][j] = t & 0xFFFFFFFFFFFFFFFFULL; t >>= 64;
+        t += (uint128_t)r->d[2][j] + of * SECP256K1_N_C_2;
+        r->d[2][j] = t & 0xFFFFFFFFFFFFFFFFULL; t >>= 64;
+        t += (uint128_t)r->d[3][j];
+        r->d[3][j] = t & 0xFFFFFFFFFFFFFFFFULL;
+        if (overflow != NULL) {
+            overflow[j] = yes;
+        }
+    }
+}
+
+/* Scatter transposed lanes back into four scalars, for consumers still
+ * operating element-wise. */
+static void secp256k1_scalar_x4_scatter(secp256k1_scalar *r, const secp256k1_scalar_x4 *a) {
+    int i, j;
+    for (j = 0; j < SECP256K1_SCALAR_X4_LANES; j++) {
+        for (i = 0; i < 4; i++) {
+            r[j].d[i] = a->d[i][j];
+        }
+    }
+}
+
+#endif
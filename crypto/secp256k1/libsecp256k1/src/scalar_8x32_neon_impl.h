@@ -0,0 +1,147 @@
+/**********************************************************************
+ * Copyright (c) 2017 The go-ethereumai Authors                       *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_SCALAR_NEON_IMPL_H_
+#define _SECP256K1_SCALAR_NEON_IMPL_H_
+
+#include <time.h>
+
+#include "cpu_features.h"
+
+/* Runtime-dispatched 8x32 scalar kernels for 32-bit ARM.
+ *
+ * Like the ADX kernels on x86_64, the portable 8x32 ladder is expanded twice:
+ * once with the baseline ISA and once allowing the compiler to use the NEON
+ * register file and VMULL.U32 for the independent column products of the
+ * 256x256->512 multiply. Unlike ADX, presence of the unit does not imply a
+ * win: on some cores (Cortex-A8/A9 class) moving partial products between
+ * the NEON and integer pipelines costs more than the multiplies save, while
+ * on others the wider unit comes out ahead. So instead of trusting the HWCAP
+ * bit alone, both expansions are timed once per process with a short
+ * mul+reduce chain and the faster one is kept, in the same spirit as the
+ * context calibration in ext.h. The probe runs eagerly from
+ * secp256k1_context_create and costs tens of microseconds, noise against
+ * the light-client sync it tunes. The second expansion needs the include
+ * guard of the inner header dropped. */
+
+#define secp256k1_scalar_reduce_512 secp256k1_scalar_reduce_512_generic
+#define secp256k1_scalar_mul_512 secp256k1_scalar_mul_512_generic
+#define secp256k1_scalar_sqr_512 secp256k1_scalar_sqr_512_generic
+#include "scalar_8x32_inner_impl.h"
+#undef secp256k1_scalar_reduce_512
+#undef secp256k1_scalar_mul_512
+#undef secp256k1_scalar_sqr_512
+#undef _SECP256K1_SCALAR_INNER8X32_IMPL_H_
+
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#define secp256k1_scalar_reduce_512 secp256k1_scalar_reduce_512_neon
+#define secp256k1_scalar_mul_512 secp256k1_scalar_mul_512_neon
+#define secp256k1_scalar_sqr_512 secp256k1_scalar_sqr_512_neon
+#include "scalar_8x32_inner_impl.h"
+#undef secp256k1_scalar_reduce_512
+#undef secp256k1_scalar_mul_512
+#undef secp256k1_scalar_sqr_512
+#pragma GCC pop_options
+
+/* Iterations of the timing probe. Long enough that a mul+reduce difference
+ * of a few percent clears clock granularity, short enough to stay invisible
+ * at context creation. */
+#define SECP256K1_SCALAR_PROBE_ITERS 512
+
+static int64_t secp256k1_scalar_probe_ns(
+    void (*mul)(uint32_t *l, const secp256k1_scalar *a, const secp256k1_scalar *b),
+    void (*reduce)(secp256k1_scalar *r, const uint32_t *l)
+) {
+    struct timespec begin, end;
+    secp256k1_scalar x;
+    uint32_t l[16];
+    int i;
+    for (i = 0; i < 8; i++) {
+        x.d[i] = 0x8b65a9f1u ^ (0x9e3779b9u * (uint32_t)i);
+    }
+    /* One untimed round faults in the code and warms the caches. */
+    mul(l, &x, &x);
+    reduce(&x, l);
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    for (i = 0; i < SECP256K1_SCALAR_PROBE_ITERS; i++) {
+        mul(l, &x, &x);
+        /* Feeding the result back keeps the chain data-dependent so neither
+         * kernel can be hoisted or dead-code-eliminated. */
+        reduce(&x, l);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (int64_t)(end.tv_sec - begin.tv_sec) * 1000000000 + (end.tv_nsec - begin.tv_nsec);
+}
+
+static void secp256k1_scalar_reduce_512_select(secp256k1_scalar *r, const uint32_t *l);
+static void secp256k1_scalar_mul_512_select(uint32_t *l, const secp256k1_scalar *a, const secp256k1_scalar *b);
+static void secp256k1_scalar_sqr_512_select(uint32_t *l, const secp256k1_scalar *a);
+
+/* All pointers start at the selector; the first call through any of them
+ * swings all three to the measured winner. Re-running the probe on a rare
+ * race is harmless since every outcome is functionally identical. */
+static void (*secp256k1_scalar_reduce_512_ptr)(secp256k1_scalar *r, const uint32_t *l) = secp256k1_scalar_reduce_512_select;
+static void (*secp256k1_scalar_mul_512_ptr)(uint32_t *l, const secp256k1_scalar *a, const secp256k1_scalar *b) = secp256k1_scalar_mul_512_select;
+static void (*secp256k1_scalar_sqr_512_ptr)(uint32_t *l, const secp256k1_scalar *a) = secp256k1_scalar_sqr_512_select;
+
+static void secp256k1_scalar_select_kernels(void) {
+    int neon = (secp256k1_cpu_features() & SECP256K1_CPU_NEON) != 0;
+    if (neon) {
+        /* Two rounds each, keeping the minimum, so a scheduler blip in one
+         * round cannot pick the slower kernel for the process lifetime. */
+        int64_t generic_ns = secp256k1_scalar_probe_ns(secp256k1_scalar_mul_512_generic, secp256k1_scalar_reduce_512_generic);
+        int64_t neon_ns = secp256k1_scalar_probe_ns(secp256k1_scalar_mul_512_neon, secp256k1_scalar_reduce_512_neon);
+        int64_t t = secp256k1_scalar_probe_ns(secp256k1_scalar_mul_512_generic, secp256k1_scalar_reduce_512_generic);
+        if (t < generic_ns) {
+            generic_ns = t;
+        }
+        t = secp256k1_scalar_probe_ns(secp256k1_scalar_mul_512_neon, secp256k1_scalar_reduce_512_neon);
+        if (t < neon_ns) {
+            neon_ns = t;
+        }
+        neon = neon_ns < generic_ns;
+    }
+    secp256k1_scalar_reduce_512_ptr = neon ? secp256k1_scalar_reduce_512_neon : secp256k1_scalar_reduce_512_generic;
+    secp256k1_scalar_mul_512_ptr = neon ? secp256k1_scalar_mul_512_neon : secp256k1_scalar_mul_512_generic;
+    secp256k1_scalar_sqr_512_ptr = neon ? secp256k1_scalar_sqr_512_neon : secp256k1_scalar_sqr_512_generic;
+}
+
+static void secp256k1_scalar_reduce_512_select(secp256k1_scalar *r, const uint32_t *l) {
+    secp256k1_scalar_select_kernels();
+    secp256k1_scalar_reduce_512_ptr(r, l);
+}
+
+static void secp256k1_scalar_mul_512_select(uint32_t *l, const secp256k1_scalar *a, const secp256k1_scalar *b) {
+    secp256k1_scalar_select_kernels();
+    secp256k1_scalar_mul_512_ptr(l, a, b);
+}
+
+static void secp256k1_scalar_sqr_512_select(uint32_t *l, const secp256k1_scalar *a) {
+    secp256k1_scalar_select_kernels();
+    secp256k1_scalar_sqr_512_ptr(l, a);
+}
+
+SECP256K1_INLINE static void secp256k1_scalar_reduce_512(secp256k1_scalar *r, const uint32_t *l) {
+    secp256k1_scalar_reduce_512_ptr(r, l);
+}
+
+SECP256K1_INLINE static void secp256k1_scalar_mul_512(uint32_t *l, const secp256k1_scalar *a, const secp256k1_scalar *b) {
+    secp256k1_scalar_mul_512_ptr(l, a, b);
+}
+
+SECP256K1_INLINE static void secp256k1_scalar_sqr_512(uint32_t *l, const secp256k1_scalar *a) {
+    secp256k1_scalar_sqr_512_ptr(l, a);
+}
+
+/* Resolve the kernel pointers eagerly; called from secp256k1_context_create
+ * so no signing or verification ever pays the probe. */
+#define SECP256K1_HAVE_SCALAR_SELECT_IMPL 1
+static void secp256k1_scalar_select_impl(void) {
+    secp256k1_scalar_select_kernels();
+}
+
+#endif
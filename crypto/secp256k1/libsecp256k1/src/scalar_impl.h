@@ -9,6 +9,7 @@
 
 #include "group.h"
 #include "scalar.h"
+#include "modinv_impl.h"
 
 #if defined HAVE_CONFIG_H
 #include "libsecp256k1-config.h"
@@ -24,6 +25,11 @@
 #error "Please select scalar implementation"
 #endif
 
+#ifndef SECP256K1_HAVE_SCALAR_SELECT_IMPL
+/* Implementations without runtime-dispatched kernels have nothing to do. */
+static SECP256K1_INLINE void secp256k1_scalar_select_impl(void) {}
+#endif
+
 #ifndef USE_NUM_NONE
 static void secp256k1_scalar_get_num(secp256k1_num *r, const secp256k1_scalar *a) {
     unsigned char c[32];
@@ -64,6 +70,17 @@ static void secp256k1_scalar_inverse(secp256k1_scalar *r, const secp256k1_scalar
     VERIFY_CHECK(*r != 0);
 }
 #else
+#ifdef SECP256K1_HAVE_SAFEGCD
+    unsigned char b[32];
+    secp256k1_scalar_get_b32(b, x);
+    secp256k1_modinv64_b32(b, &secp256k1_modinv64_scalar);
+    secp256k1_scalar_set_b32(r, b, NULL);
+}
+
+/* Fermat inversion via an addition chain for n - 2. Kept as the fallback for
+ * targets without the safegcd kernels and for cross-checking them. */
+static void secp256k1_scalar_inverse_fermat(secp256k1_scalar *r, const secp256k1_scalar *x) {
+#endif
     secp256k1_scalar *t;
     int i;
     /* First compute x ^ (2^N - 1) for some values of N. */
@@ -260,6 +277,29 @@ SECP256K1_INLINE static int secp256k1_scalar_is_even(const secp256k1_scalar *a)
 #endif
 
 static void secp256k1_scalar_inverse_var(secp256k1_scalar *r, const secp256k1_scalar *x) {
+#if !defined(EXHAUSTIVE_TEST_ORDER)
+    if (secp256k1_vartime_kernels) {
+        /** secp256k1 curve order, see secp256k1_ecdsa_const_order_as_fe in ecdsa_impl.h */
+        static const unsigned char order[32] = {
+            0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+            0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFE,
+            0xBA,0xAE,0xDC,0xE6,0xAF,0x48,0xA0,0x3B,
+            0xBF,0xD2,0x5E,0x8C,0xD0,0x36,0x41,0x41
+        };
+        unsigned char b[32];
+        secp256k1_scalar t = *x;
+        secp256k1_scalar_get_b32(b, &t);
+        secp256k1_modinv_bin_var(b, b, order);
+        secp256k1_scalar_set_b32(r, b, NULL);
+#ifdef VERIFY
+        if (!secp256k1_scalar_is_zero(&t)) {
+            secp256k1_scalar_mul(&t, &t, r);
+            VERIFY_CHECK(secp256k1_scalar_is_one(&t));
+        }
+#endif
+        return;
+    }
+#endif
 #if defined(USE_SCALAR_INV_BUILTIN)
     secp256k1_scalar_inverse(r, x);
 #elif defined(USE_SCALAR_INV_NUM)
@@ -0,0 +1,31 @@
+/**********************************************************************
+ * Copyright (c) 2017 The go-ethereumai Authors                       *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_SCRATCH_
+#define _SECP256K1_SCRATCH_
+
+#include "util.h"
+
+/* A fixed-size arena for the temporary tables built on every multiplication.
+ * Reusing one scratch across many verifications keeps the table memory warm
+ * instead of re-touching fresh stack pages per signature. A scratch may only
+ * be used by one thread at a time. */
+typedef struct secp256k1_scratch_space_struct {
+    void *data;
+    size_t offset;
+    size_t max_size;
+} secp256k1_scratch;
+
+static secp256k1_scratch* secp256k1_scratch_create(const secp256k1_callback* error_callback, size_t max_size);
+static void secp256k1_scratch_destroy(secp256k1_scratch* scratch);
+
+/** Returns the scratch to its empty state, keeping the allocation. */
+static void secp256k1_scratch_reset(secp256k1_scratch* scratch);
+
+/** Returns size bytes from the scratch (aligned), or NULL if it is exhausted. */
+static void* secp256k1_scratch_alloc(secp256k1_scratch* scratch, size_t size);
+
+#endif
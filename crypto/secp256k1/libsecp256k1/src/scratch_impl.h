@@ -0,0 +1,44 @@
+/**********************************************************************
+ * Copyright (c) 2017 The go-ethereumai Authors                       *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_SCRATCH_IMPL_H_
+#define _SECP256K1_SCRATCH_IMPL_H_
+
+#include "scratch.h"
+
+#define SECP256K1_SCRATCH_ALIGN 16
+
+static secp256k1_scratch* secp256k1_scratch_create(const secp256k1_callback* error_callback, size_t max_size) {
+    secp256k1_scratch* ret = (secp256k1_scratch*)checked_malloc(error_callback, sizeof(*ret));
+    ret->data = checked_malloc(error_callback, max_size);
+    ret->offset = 0;
+    ret->max_size = max_size;
+    return ret;
+}
+
+static void secp256k1_scratch_destroy(secp256k1_scratch* scratch) {
+    if (scratch != NULL) {
+        checked_free(scratch->data);
+        checked_free(scratch);
+    }
+}
+
+static void secp256k1_scratch_reset(secp256k1_scratch* scratch) {
+    scratch->offset = 0;
+}
+
+static void* secp256k1_scratch_alloc(secp256k1_scratch* scratch, size_t size) {
+    void *ret;
+    size = (size + SECP256K1_SCRATCH_ALIGN - 1) & ~(size_t)(SECP256K1_SCRATCH_ALIGN - 1);
+    if (size > scratch->max_size - scratch->offset) {
+        return NULL;
+    }
+    ret = (unsigned char*)scratch->data + scratch->offset;
+    scratch->offset += size;
+    return ret;
+}
+
+#endif
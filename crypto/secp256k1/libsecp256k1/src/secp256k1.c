@@ -4,7 +4,17 @@
  * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
  **********************************************************************/
 
+/* ecmult_impl.h's table-layout probe uses clock_gettime/CLOCK_MONOTONIC,
+ * which strict-C89 builds (the autotools default) only expose behind a POSIX
+ * feature test macro. It has to be set before the first libc header of the
+ * translation unit, so it lives here rather than next to the probe. */
+#if !defined(_WIN32) && !defined(_GNU_SOURCE) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
 #include "include/secp256k1.h"
+#include "include/secp256k1_preallocated.h"
+#include "include/secp256k1_stats.h"
 
 #include "util.h"
 #include "num_impl.h"
@@ -17,6 +27,7 @@
 #include "ecdsa_impl.h"
 #include "eckey_impl.h"
 #include "hash_impl.h"
+#include "scratch_impl.h"
 
 #define ARG_CHECK(cond) do { \
     if (EXPECT(!(cond), 0)) { \
@@ -25,7 +36,7 @@
     } \
 } while(0)
 
-static void default_illegal_callback_fn(const char* str, void* data) {
+static SECP256K1_COLD void default_illegal_callback_fn(const char* str, void* data) {
     (void)data;
     fprintf(stderr, "[libsecp256k1] illegal argument: %s\n", str);
     abort();
@@ -36,7 +47,7 @@ static const secp256k1_callback default_illegal_callback = {
     NULL
 };
 
-static void default_error_callback_fn(const char* str, void* data) {
+static SECP256K1_COLD void default_error_callback_fn(const char* str, void* data) {
     (void)data;
     fprintf(stderr, "[libsecp256k1] internal consistency check failed: %s\n", str);
     abort();
@@ -47,54 +58,407 @@ static const secp256k1_callback default_error_callback = {
     NULL
 };
 
+#ifdef USE_CONTEXT_STATS
+#include <stdatomic.h>
+#include <time.h>
+
+/* Internal atomic mirror of secp256k1_context_stats, striped into slots so
+ * that threads hammering the same context bump disjoint counters. Threads
+ * are spread over the slots by a thread-local anchor address; collisions
+ * just share a slot, which stays correct because updates are relaxed
+ * atomics. Instrumentation then costs a few uncontended adds per operation
+ * against the hundreds of thousands of nanoseconds the operation itself
+ * takes. */
+#define SECP256K1_CONTEXT_STATS_SLOTS 16
+
+typedef struct {
+    atomic_uint_fast64_t count[SECP256K1_CONTEXT_STATS_OPS];
+    atomic_uint_fast64_t total_ns[SECP256K1_CONTEXT_STATS_OPS];
+    atomic_uint_fast64_t hist[SECP256K1_CONTEXT_STATS_OPS][SECP256K1_CONTEXT_STATS_BUCKETS];
+    atomic_uint_fast64_t batch_calls;
+    atomic_uint_fast64_t batch_items;
+#ifdef USE_OPCOUNT_STATS
+    atomic_uint_fast64_t fe_mul[SECP256K1_CONTEXT_STATS_OPS];
+    atomic_uint_fast64_t fe_sqr[SECP256K1_CONTEXT_STATS_OPS];
+#endif
+} secp256k1_stats_slot;
+
+typedef struct {
+    secp256k1_stats_slot slots[SECP256K1_CONTEXT_STATS_SLOTS];
+} secp256k1_stats;
+
+static uint64_t secp256k1_stats_clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* Entry/exit timestamps come from the raw cycle counter where one exists:
+ * rdtsc and cntvct_el0 cost a few cycles against clock_gettime's vDSO call,
+ * which is what makes always-on accounting affordable on the hot entry
+ * points. The tick rate is calibrated against the monotonic clock once and
+ * tick deltas converted to nanoseconds at record time, so the exported
+ * counters keep their units no matter which source is in use. */
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+static uint64_t secp256k1_stats_now(void) {
+    uint32_t lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return (uint64_t)lo | ((uint64_t)hi << 32);
+}
+#define SECP256K1_STATS_RAW_TICKS 1
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+static uint64_t secp256k1_stats_now(void) {
+    uint64_t ticks;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+}
+#define SECP256K1_STATS_RAW_TICKS 1
+#else
+#define secp256k1_stats_now secp256k1_stats_clock_ns
+#endif
+
+#ifdef SECP256K1_STATS_RAW_TICKS
+/* Nanoseconds elapsed since a secp256k1_stats_now sample. The scale (ticks
+ * per 1024ns) is measured over a ~100us window on first use; a calibration
+ * race costs a redundant measurement of the same value, nothing more. */
+static uint64_t secp256k1_stats_elapsed_ns(uint64_t begin) {
+    static atomic_uint_fast64_t scale_store;
+    uint64_t scale = atomic_load_explicit(&scale_store, memory_order_relaxed);
+    if (scale == 0) {
+        uint64_t ns0 = secp256k1_stats_clock_ns(), ticks0 = secp256k1_stats_now();
+        uint64_t ns1, ticks1;
+        do {
+            ns1 = secp256k1_stats_clock_ns();
+            ticks1 = secp256k1_stats_now();
+        } while (ns1 - ns0 < 100000);
+        scale = ((ticks1 - ticks0) << 10) / (ns1 - ns0);
+        if (scale == 0) {
+            scale = 1;
+        }
+        atomic_store_explicit(&scale_store, scale, memory_order_relaxed);
+    }
+    return ((secp256k1_stats_now() - begin) << 10) / scale;
+}
+#else
+static uint64_t secp256k1_stats_elapsed_ns(uint64_t begin) {
+    return secp256k1_stats_clock_ns() - begin;
+}
+#endif
+
+#ifdef USE_OPCOUNT_STATS
+/* The operation-count audit mode additionally snapshots the thread-local
+ * fe_mul/fe_sqr counters (see field_impl.h) on entry and books the delta
+ * alongside the latency sample, attributing every field operation the
+ * calling thread performed to the entry point that ran it. */
+#define SECP256K1_STATS_DECL uint64_t stats_begin = secp256k1_stats_now(); \
+    uint64_t stats_mul_begin = secp256k1_opcount_fe_mul; \
+    uint64_t stats_sqr_begin = secp256k1_opcount_fe_sqr;
+#define SECP256K1_STATS_DONE(ctx, op) do { \
+    secp256k1_stats_record((ctx), (op), stats_begin, 1); \
+    secp256k1_stats_opcount((ctx), (op), stats_mul_begin, stats_sqr_begin); } while (0)
+#define SECP256K1_STATS_DONE_N(ctx, op, n) do { \
+    secp256k1_stats_record((ctx), (op), stats_begin, (n)); \
+    secp256k1_stats_opcount((ctx), (op), stats_mul_begin, stats_sqr_begin); } while (0)
+#else
+#define SECP256K1_STATS_DECL uint64_t stats_begin = secp256k1_stats_now();
+#define SECP256K1_STATS_DONE(ctx, op) secp256k1_stats_record((ctx), (op), stats_begin, 1)
+#define SECP256K1_STATS_DONE_N(ctx, op, n) secp256k1_stats_record((ctx), (op), stats_begin, (n))
+#endif
+#define SECP256K1_STATS_BATCH(ctx, n) secp256k1_stats_batch((ctx), (n))
+#else
+#define SECP256K1_STATS_DECL
+#define SECP256K1_STATS_DONE(ctx, op)
+#define SECP256K1_STATS_DONE_N(ctx, op, n)
+#define SECP256K1_STATS_BATCH(ctx, n)
+#endif
 
 struct secp256k1_context_struct {
     secp256k1_ecmult_context ecmult_ctx;
     secp256k1_ecmult_gen_context ecmult_gen_ctx;
     secp256k1_callback illegal_callback;
     secp256k1_callback error_callback;
+    int ecmult_borrowed; /* ecmult_ctx tables are owned by another context */
+    secp256k1_arena arena; /* single slab holding the context and its tables */
+    int arena_owned;       /* slab was allocated by us, not by the caller */
+#ifdef USE_CONTEXT_STATS
+    secp256k1_stats stats;
+#endif
 };
 
-secp256k1_context* secp256k1_context_create(unsigned int flags) {
-    secp256k1_context* ret = (secp256k1_context*)checked_malloc(&default_error_callback, sizeof(secp256k1_context));
-    ret->illegal_callback = default_illegal_callback;
-    ret->error_callback = default_error_callback;
+#ifdef USE_CONTEXT_STATS
+/* Pick the calling thread's counter slot. The counters are logically
+ * mutable metadata on an otherwise read-only context, so the const
+ * qualifier is cast away here. */
+static secp256k1_stats_slot* secp256k1_stats_self(const secp256k1_context* ctx) {
+    static _Thread_local unsigned char anchor;
+    uintptr_t id = (uintptr_t)&anchor;
+    return &((secp256k1_stats*)&ctx->stats)->slots[((id >> 4) * 2654435761u) & (SECP256K1_CONTEXT_STATS_SLOTS - 1)];
+}
+
+/* Record a completed operation of `items` units (1 for single-shot entry
+ * points, the batch size for batch entry points) that started at `begin`. */
+static void secp256k1_stats_record(const secp256k1_context* ctx, int op, uint64_t begin, uint64_t items) {
+    secp256k1_stats_slot *slot = secp256k1_stats_self(ctx);
+    uint64_t ns = secp256k1_stats_elapsed_ns(begin);
+    uint64_t per = items > 1 ? ns / items : ns;
+    int bucket = 0;
+    while (per >>= 1) {
+        bucket++;
+    }
+    if (bucket >= SECP256K1_CONTEXT_STATS_BUCKETS) {
+        bucket = SECP256K1_CONTEXT_STATS_BUCKETS - 1;
+    }
+    atomic_fetch_add_explicit(&slot->count[op], items, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->total_ns[op], ns, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->hist[op][bucket], items, memory_order_relaxed);
+    if (items > 1) {
+        atomic_fetch_add_explicit(&slot->batch_calls, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&slot->batch_items, items, memory_order_relaxed);
+    }
+}
+
+#ifdef USE_OPCOUNT_STATS
+/* Book the field operations the calling thread performed since the entry
+ * point snapshotted its counters. */
+static void secp256k1_stats_opcount(const secp256k1_context* ctx, int op, uint64_t mul_begin, uint64_t sqr_begin) {
+    secp256k1_stats_slot *slot = secp256k1_stats_self(ctx);
+    atomic_fetch_add_explicit(&slot->fe_mul[op], secp256k1_opcount_fe_mul - mul_begin, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->fe_sqr[op], secp256k1_opcount_fe_sqr - sqr_begin, memory_order_relaxed);
+}
+#endif
+
+/* Book a batch entry-point call without per-operation samples, for batch
+ * paths whose inner loop already runs through an instrumented entry point. */
+static void secp256k1_stats_batch(const secp256k1_context* ctx, uint64_t items) {
+    secp256k1_stats_slot *slot = secp256k1_stats_self(ctx);
+    atomic_fetch_add_explicit(&slot->batch_calls, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->batch_items, items, memory_order_relaxed);
+}
+#endif
+
+size_t secp256k1_context_preallocated_size(unsigned int flags) {
+    size_t ret = SECP256K1_ARENA_ROUND(sizeof(secp256k1_context));
 
     if (EXPECT((flags & SECP256K1_FLAGS_TYPE_MASK) != SECP256K1_FLAGS_TYPE_CONTEXT, 0)) {
-            secp256k1_callback_call(&ret->illegal_callback,
+            secp256k1_callback_call(&default_illegal_callback,
                                     "Invalid flags");
-            free(ret);
-            return NULL;
+            return 0;
     }
 
+    if (flags & SECP256K1_FLAGS_BIT_CONTEXT_SIGN) {
+#ifndef USE_ECMULT_STATIC_PRECOMPUTATION
+        ret += SECP256K1_ARENA_ROUND(sizeof(secp256k1_ge_storage) * ECMULT_GEN_PREC_N * ECMULT_GEN_PREC_G);
+#endif
+    }
+    if (flags & SECP256K1_FLAGS_BIT_CONTEXT_VERIFY) {
+        int window_g = (flags & SECP256K1_FLAGS_BIT_CONTEXT_SMALL_TABLES) ? WINDOW_G_SMALL : WINDOW_G;
+        ret += SECP256K1_ARENA_ROUND(sizeof(secp256k1_ge_storage) * ECMULT_TABLE_SIZE(window_g));
+#ifdef USE_ENDOMORPHISM
+        ret += SECP256K1_ARENA_ROUND(sizeof(secp256k1_ge_storage) * ECMULT_TABLE_SIZE(window_g));
+#endif
+    }
+    return ret;
+}
+
+size_t secp256k1_context_preallocated_clone_size(const secp256k1_context* ctx) {
+    size_t ret = SECP256K1_ARENA_ROUND(sizeof(secp256k1_context));
+    VERIFY_CHECK(ctx != NULL);
+    if (secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx)) {
+#ifndef USE_ECMULT_STATIC_PRECOMPUTATION
+        ret += SECP256K1_ARENA_ROUND(sizeof(secp256k1_ge_storage) * ECMULT_GEN_PREC_N * ECMULT_GEN_PREC_G);
+#endif
+    }
+    if (secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx)) {
+        ret += SECP256K1_ARENA_ROUND(sizeof(secp256k1_ge_storage) * ECMULT_TABLE_SIZE(ctx->ecmult_ctx.window_g));
+#ifdef USE_ENDOMORPHISM
+        ret += SECP256K1_ARENA_ROUND(sizeof(secp256k1_ge_storage) * ECMULT_TABLE_SIZE(ctx->ecmult_ctx.window_g));
+#endif
+    }
+    return ret;
+}
+
+/* Place a context at the start of the slab and build it, carving all
+ * internal allocations out of the remainder of the slab. */
+static secp256k1_context* secp256k1_context_arena_create(void* prealloc, size_t size, unsigned int flags, int owned) {
+    secp256k1_context* ret = (secp256k1_context*)prealloc;
+    ret->arena.base = (unsigned char*)prealloc;
+    ret->arena.size = size;
+    ret->arena.alloc = SECP256K1_ARENA_ROUND(sizeof(secp256k1_context));
+    ret->arena_owned = owned;
+    ret->illegal_callback = default_illegal_callback;
+    ret->error_callback = default_error_callback;
+    ret->ecmult_borrowed = 0;
+#ifdef USE_CONTEXT_STATS
+    memset(&ret->stats, 0, sizeof(ret->stats));
+#endif
+
     secp256k1_ecmult_context_init(&ret->ecmult_ctx);
     secp256k1_ecmult_gen_context_init(&ret->ecmult_gen_ctx);
 
+    if (flags & SECP256K1_FLAGS_BIT_CONTEXT_VARTIME) {
+        /* See modinv_impl.h for why this switch is safe to flip process-wide. */
+        secp256k1_set_vartime_kernels(1);
+    }
     if (flags & SECP256K1_FLAGS_BIT_CONTEXT_SIGN) {
-        secp256k1_ecmult_gen_context_build(&ret->ecmult_gen_ctx, &ret->error_callback);
+        secp256k1_ecmult_gen_context_build(&ret->ecmult_gen_ctx, &ret->arena, &ret->error_callback);
     }
     if (flags & SECP256K1_FLAGS_BIT_CONTEXT_VERIFY) {
-        secp256k1_ecmult_context_build(&ret->ecmult_ctx, &ret->error_callback);
+        int window_g = (flags & SECP256K1_FLAGS_BIT_CONTEXT_SMALL_TABLES) ? WINDOW_G_SMALL : WINDOW_G;
+        secp256k1_ecmult_context_build(&ret->ecmult_ctx, window_g, &ret->arena, &ret->error_callback);
+    }
+
+    return ret;
+}
+
+secp256k1_context* secp256k1_context_create(unsigned int flags) {
+    void* prealloc;
+    size_t size;
+    secp256k1_fe_select_impl();
+    secp256k1_scalar_select_impl();
+
+    if (EXPECT((flags & SECP256K1_FLAGS_TYPE_MASK) != SECP256K1_FLAGS_TYPE_CONTEXT, 0)) {
+            secp256k1_callback_call(&default_illegal_callback,
+                                    "Invalid flags");
+            return NULL;
+    }
+
+    size = secp256k1_context_preallocated_size(flags);
+    prealloc = checked_malloc(&default_error_callback, size);
+    return secp256k1_context_arena_create(prealloc, size, flags, 1);
+}
+
+secp256k1_context* secp256k1_context_preallocated_create(void* prealloc, unsigned int flags) {
+    secp256k1_fe_select_impl();
+    secp256k1_scalar_select_impl();
+
+    if (EXPECT((flags & SECP256K1_FLAGS_TYPE_MASK) != SECP256K1_FLAGS_TYPE_CONTEXT, 0)) {
+            secp256k1_callback_call(&default_illegal_callback,
+                                    "Invalid flags");
+            return NULL;
     }
+    VERIFY_CHECK(prealloc != NULL);
+
+    return secp256k1_context_arena_create(prealloc, secp256k1_context_preallocated_size(flags), flags, 0);
+}
 
+static secp256k1_context* secp256k1_context_arena_clone(const secp256k1_context* ctx, void* prealloc, size_t size, int owned) {
+    secp256k1_context* ret = (secp256k1_context*)prealloc;
+    ret->arena.base = (unsigned char*)prealloc;
+    ret->arena.size = size;
+    ret->arena.alloc = SECP256K1_ARENA_ROUND(sizeof(secp256k1_context));
+    ret->arena_owned = owned;
+    ret->illegal_callback = ctx->illegal_callback;
+    ret->error_callback = ctx->error_callback;
+    ret->ecmult_borrowed = 0;
+#ifdef USE_CONTEXT_STATS
+    memset(&ret->stats, 0, sizeof(ret->stats));
+#endif
+    secp256k1_ecmult_context_clone(&ret->ecmult_ctx, &ctx->ecmult_ctx, &ret->arena, &ctx->error_callback);
+    secp256k1_ecmult_gen_context_clone(&ret->ecmult_gen_ctx, &ctx->ecmult_gen_ctx, &ret->arena, &ctx->error_callback);
     return ret;
 }
 
 secp256k1_context* secp256k1_context_clone(const secp256k1_context* ctx) {
-    secp256k1_context* ret = (secp256k1_context*)checked_malloc(&ctx->error_callback, sizeof(secp256k1_context));
+    size_t size = secp256k1_context_preallocated_clone_size(ctx);
+    void* prealloc = checked_malloc(&ctx->error_callback, size);
+    return secp256k1_context_arena_clone(ctx, prealloc, size, 1);
+}
+
+secp256k1_context* secp256k1_context_preallocated_clone(const secp256k1_context* ctx, void* prealloc) {
+    VERIFY_CHECK(ctx != NULL);
+    VERIFY_CHECK(prealloc != NULL);
+    return secp256k1_context_arena_clone(ctx, prealloc, secp256k1_context_preallocated_clone_size(ctx), 0);
+}
+
+secp256k1_context* secp256k1_context_clone_shared(const secp256k1_context* ctx) {
+    secp256k1_context* ret;
+    size_t size = SECP256K1_ARENA_ROUND(sizeof(secp256k1_context));
+    VERIFY_CHECK(ctx != NULL);
+    VERIFY_CHECK(!ctx->ecmult_borrowed);
+    if (secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx)) {
+#ifndef USE_ECMULT_STATIC_PRECOMPUTATION
+        size += SECP256K1_ARENA_ROUND(sizeof(secp256k1_ge_storage) * ECMULT_GEN_PREC_N * ECMULT_GEN_PREC_G);
+#endif
+    }
+    ret = (secp256k1_context*)checked_malloc(&ctx->error_callback, size);
+    ret->arena.base = (unsigned char*)ret;
+    ret->arena.size = size;
+    ret->arena.alloc = SECP256K1_ARENA_ROUND(sizeof(secp256k1_context));
+    ret->arena_owned = 1;
     ret->illegal_callback = ctx->illegal_callback;
     ret->error_callback = ctx->error_callback;
-    secp256k1_ecmult_context_clone(&ret->ecmult_ctx, &ctx->ecmult_ctx, &ctx->error_callback);
-    secp256k1_ecmult_gen_context_clone(&ret->ecmult_gen_ctx, &ctx->ecmult_gen_ctx, &ctx->error_callback);
+#ifdef USE_CONTEXT_STATS
+    memset(&ret->stats, 0, sizeof(ret->stats));
+#endif
+    /* The verification tables are write-once at build time, so worker clones
+     * can alias them; only the mutable generator blinding is duplicated. */
+    ret->ecmult_ctx = ctx->ecmult_ctx;
+    ret->ecmult_borrowed = 1;
+    secp256k1_ecmult_gen_context_clone(&ret->ecmult_gen_ctx, &ctx->ecmult_gen_ctx, &ret->arena, &ctx->error_callback);
     return ret;
 }
 
-void secp256k1_context_destroy(secp256k1_context* ctx) {
+void secp256k1_context_preallocated_destroy(secp256k1_context* ctx) {
     if (ctx != NULL) {
-        secp256k1_ecmult_context_clear(&ctx->ecmult_ctx);
+        if (ctx->ecmult_borrowed) {
+            /* The owning context frees the shared tables. */
+            secp256k1_ecmult_context_init(&ctx->ecmult_ctx);
+        } else {
+            secp256k1_ecmult_context_clear(&ctx->ecmult_ctx);
+        }
         secp256k1_ecmult_gen_context_clear(&ctx->ecmult_gen_ctx);
+    }
+}
+
+void secp256k1_context_destroy(secp256k1_context* ctx) {
+    if (ctx != NULL) {
+        int owned = ctx->arena_owned;
+        secp256k1_context_preallocated_destroy(ctx);
+        if (owned) {
+            /* The tables live in the same slab as the context itself. */
+            checked_free(ctx);
+        }
+    }
+}
 
-        free(ctx);
+void secp256k1_context_abandon(secp256k1_context* ctx) {
+    if (ctx != NULL) {
+        /* Only the generator blinding state is secret; the multiplication
+         * tables are public write-once data, so neither they nor the slab
+         * they share with the context are touched. Process exit reclaims
+         * the memory. */
+        secp256k1_scalar_clear(&ctx->ecmult_gen_ctx.blind);
+        secp256k1_gej_clear(&ctx->ecmult_gen_ctx.initial);
+    }
+}
+
+void secp256k1_context_memory_report(const secp256k1_context* ctx, secp256k1_context_memory_layout *layout) {
+    VERIFY_CHECK(ctx != NULL);
+    VERIFY_CHECK(layout != NULL);
+    memset(layout, 0, sizeof(*layout));
+    layout->context_bytes = sizeof(secp256k1_context);
+    layout->arena_bytes = ctx->arena.size;
+    layout->entry_bytes = sizeof(secp256k1_ge_storage);
+    {
+        struct secp256k1_ge_storage_align_probe { char c; secp256k1_ge_storage s; };
+        layout->entry_alignment = sizeof(struct secp256k1_ge_storage_align_probe) - sizeof(secp256k1_ge_storage);
+    }
+    if (secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx)) {
+        layout->ecmult_window = ctx->ecmult_ctx.window_g;
+        layout->ecmult_entries = ECMULT_TABLE_SIZE(ctx->ecmult_ctx.window_g);
+#ifdef USE_ENDOMORPHISM
+        layout->ecmult_tables = 2;
+        layout->ecmult_interleaved = ctx->ecmult_ctx.pre_g_interleaved;
+#else
+        layout->ecmult_tables = 1;
+#endif
+        layout->ecmult_bytes = layout->ecmult_tables * layout->ecmult_entries * sizeof(secp256k1_ge_storage);
+        layout->ecmult_cachelines = (layout->ecmult_bytes + 63) / 64;
+        layout->ecmult_borrowed = ctx->ecmult_borrowed;
+    }
+    if (secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx)) {
+        layout->ecmult_gen_bytes = sizeof(secp256k1_ge_storage) * ECMULT_GEN_PREC_N * ECMULT_GEN_PREC_G;
+        layout->ecmult_gen_cachelines = (layout->ecmult_gen_bytes + 63) / 64;
     }
 }
 
@@ -147,6 +511,15 @@ static void secp256k1_pubkey_save(secp256k1_pubkey* pubkey, secp256k1_ge* ge) {
     }
 }
 
+secp256k1_scratch_space* secp256k1_scratch_space_create(const secp256k1_context* ctx, size_t max_size) {
+    VERIFY_CHECK(ctx != NULL);
+    return secp256k1_scratch_create(&ctx->error_callback, max_size);
+}
+
+void secp256k1_scratch_space_destroy(secp256k1_scratch_space* scratch) {
+    secp256k1_scratch_destroy(scratch);
+}
+
 int secp256k1_ec_pubkey_parse(const secp256k1_context* ctx, secp256k1_pubkey* pubkey, const unsigned char *input, size_t inputlen) {
     secp256k1_ge Q;
 
@@ -185,6 +558,79 @@ int secp256k1_ec_pubkey_serialize(const secp256k1_context* ctx, unsigned char *o
     return ret;
 }
 
+size_t secp256k1_ec_pubkey_parse_batch(const secp256k1_context* ctx, secp256k1_pubkey* pubkeys, int* results, const unsigned char *input, size_t n, unsigned int flags) {
+    size_t i;
+    size_t keylen;
+    size_t count = 0;
+    int compressed;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(pubkeys != NULL);
+    ARG_CHECK(input != NULL || n == 0);
+    ARG_CHECK((flags & SECP256K1_FLAGS_TYPE_MASK) == SECP256K1_FLAGS_TYPE_COMPRESSION);
+    compressed = flags & SECP256K1_FLAGS_BIT_COMPRESSION;
+    keylen = compressed ? 33 : 65;
+
+    for (i = 0; i < n; i++) {
+        const unsigned char *pub = input + i * keylen;
+        secp256k1_ge Q;
+        int ret;
+        if (compressed) {
+            secp256k1_fe x;
+            ret = (pub[0] == 0x02 || pub[0] == 0x03) &&
+                  secp256k1_fe_set_b32(&x, pub + 1) &&
+                  secp256k1_ge_set_xo_var(&Q, &x, pub[0] == 0x03);
+        } else {
+            /* The caller-asserted format replaces the per-key tag dispatch:
+             * both coordinates are on the wire, so validation is a single
+             * curve-equation check with no square root. */
+            secp256k1_fe x, y;
+            ret = pub[0] == 0x04 &&
+                  secp256k1_fe_set_b32(&x, pub + 1) &&
+                  secp256k1_fe_set_b32(&y, pub + 33);
+            if (ret) {
+                secp256k1_ge_set_xy(&Q, &x, &y);
+                ret = secp256k1_ge_is_valid_var(&Q);
+            }
+        }
+        if (ret) {
+            secp256k1_pubkey_save(&pubkeys[i], &Q);
+            count++;
+        } else {
+            memset(&pubkeys[i], 0, sizeof(pubkeys[i]));
+        }
+        if (results != NULL) {
+            results[i] = ret;
+        }
+    }
+    return count;
+}
+
+size_t secp256k1_ec_pubkey_serialize_batch(const secp256k1_context* ctx, unsigned char *output, const secp256k1_pubkey* pubkeys, size_t n, unsigned int flags) {
+    size_t i;
+    size_t keylen;
+    size_t count = 0;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(output != NULL || n == 0);
+    ARG_CHECK(pubkeys != NULL);
+    ARG_CHECK((flags & SECP256K1_FLAGS_TYPE_MASK) == SECP256K1_FLAGS_TYPE_COMPRESSION);
+    keylen = (flags & SECP256K1_FLAGS_BIT_COMPRESSION) ? 33 : 65;
+
+    for (i = 0; i < n; i++) {
+        unsigned char *pub = output + i * keylen;
+        secp256k1_ge Q;
+        size_t len = keylen;
+        if (secp256k1_pubkey_load(ctx, &Q, &pubkeys[i]) &&
+            secp256k1_eckey_pubkey_serialize(&Q, pub, &len, flags & SECP256K1_FLAGS_BIT_COMPRESSION)) {
+            count++;
+        } else {
+            memset(pub, 0, keylen);
+        }
+    }
+    return count;
+}
+
 static void secp256k1_ecdsa_signature_load(const secp256k1_context* ctx, secp256k1_scalar* r, secp256k1_scalar* s, const secp256k1_ecdsa_signature* sig) {
     (void)ctx;
     if (sizeof(secp256k1_scalar) == 32) {
@@ -294,6 +740,8 @@ int secp256k1_ecdsa_verify(const secp256k1_context* ctx, const secp256k1_ecdsa_s
     secp256k1_ge q;
     secp256k1_scalar r, s;
     secp256k1_scalar m;
+    int ret;
+    SECP256K1_STATS_DECL
     VERIFY_CHECK(ctx != NULL);
     ARG_CHECK(secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx));
     ARG_CHECK(msg32 != NULL);
@@ -302,9 +750,58 @@ int secp256k1_ecdsa_verify(const secp256k1_context* ctx, const secp256k1_ecdsa_s
 
     secp256k1_scalar_set_b32(&m, msg32, NULL);
     secp256k1_ecdsa_signature_load(ctx, &r, &s, sig);
+    ret = (!secp256k1_scalar_is_high(&s) &&
+           secp256k1_pubkey_load(ctx, &q, pubkey) &&
+           secp256k1_ecdsa_sig_verify(&ctx->ecmult_ctx, &r, &s, &q, &m));
+    SECP256K1_STATS_DONE(ctx, SECP256K1_CONTEXT_STATS_VERIFY);
+    return ret;
+}
+
+size_t secp256k1_context_tables_export(const secp256k1_context* ctx, void *buf, size_t size) {
+    VERIFY_CHECK(ctx != NULL);
+    if (!secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx)) {
+        return 0;
+    }
+    return secp256k1_ecmult_context_export(&ctx->ecmult_ctx, (unsigned char *)buf, size);
+}
+
+int secp256k1_ecdsa_verify_stateless(const void *tables, size_t size, const secp256k1_ecdsa_signature *sig, const unsigned char *msg32, const secp256k1_pubkey *pubkey) {
+    secp256k1_ecmult_context ecmult_ctx;
+    secp256k1_ge q;
+    secp256k1_scalar r, s;
+    secp256k1_scalar m;
+
+    /* No context means no illegal-argument callback; everything fails
+     * closed instead. */
+    if (sig == NULL || msg32 == NULL || pubkey == NULL) {
+        return 0;
+    }
+    if (!secp256k1_ecmult_context_attach(&ecmult_ctx, tables, size)) {
+        return 0;
+    }
+    /* Normally context creation picks the runtime kernels; a stateless
+     * caller may never create one. Both selectors are one-shot. */
+    secp256k1_fe_select_impl();
+    secp256k1_scalar_select_impl();
+
+    secp256k1_scalar_set_b32(&m, msg32, NULL);
+    secp256k1_ecdsa_signature_load(NULL, &r, &s, sig);
+    /* secp256k1_pubkey_load, without the callback on the failure path */
+    if (sizeof(secp256k1_ge_storage) == 64) {
+        secp256k1_ge_storage ges;
+        memcpy(&ges, &pubkey->data[0], 64);
+        secp256k1_ge_from_storage(&q, &ges);
+    } else {
+        secp256k1_fe x, y;
+        secp256k1_fe_set_b32(&x, pubkey->data);
+        secp256k1_fe_set_b32(&y, pubkey->data + 32);
+        secp256k1_ge_set_xy(&q, &x, &y);
+    }
+    if (secp256k1_fe_is_zero(&q.x)) {
+        return 0;
+    }
     return (!secp256k1_scalar_is_high(&s) &&
-            secp256k1_pubkey_load(ctx, &q, pubkey) &&
-            secp256k1_ecdsa_sig_verify(&ctx->ecmult_ctx, &r, &s, &q, &m));
+            secp256k1_ecdsa_sig_verify(&ecmult_ctx, &r, &s, &q, &m));
 }
 
 static int nonce_function_rfc6979(unsigned char *nonce32, const unsigned char *msg32, const unsigned char *key32, const unsigned char *algo16, void *data, unsigned int counter) {
@@ -347,6 +844,7 @@ int secp256k1_ecdsa_sign(const secp256k1_context* ctx, secp256k1_ecdsa_signature
     secp256k1_scalar sec, non, msg;
     int ret = 0;
     int overflow = 0;
+    SECP256K1_STATS_DECL
     VERIFY_CHECK(ctx != NULL);
     ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
     ARG_CHECK(msg32 != NULL);
@@ -385,6 +883,7 @@ int secp256k1_ecdsa_sign(const secp256k1_context* ctx, secp256k1_ecdsa_signature
     } else {
         memset(signature, 0, sizeof(*signature));
     }
+    SECP256K1_STATS_DONE(ctx, SECP256K1_CONTEXT_STATS_SIGN);
     return ret;
 }
 
@@ -548,6 +1047,67 @@ int secp256k1_ec_pubkey_combine(const secp256k1_context* ctx, secp256k1_pubkey *
     return 1;
 }
 
+void secp256k1_context_stats_get(const secp256k1_context* ctx, secp256k1_context_stats *stats) {
+    VERIFY_CHECK(ctx != NULL);
+    VERIFY_CHECK(stats != NULL);
+#ifdef USE_CONTEXT_STATS
+    {
+        int s, op, b;
+        memset(stats, 0, sizeof(*stats));
+        for (s = 0; s < SECP256K1_CONTEXT_STATS_SLOTS; s++) {
+            const secp256k1_stats_slot *src = &ctx->stats.slots[s];
+            for (op = 0; op < SECP256K1_CONTEXT_STATS_OPS; op++) {
+                stats->count[op] += atomic_load_explicit(&src->count[op], memory_order_relaxed);
+                stats->total_ns[op] += atomic_load_explicit(&src->total_ns[op], memory_order_relaxed);
+                for (b = 0; b < SECP256K1_CONTEXT_STATS_BUCKETS; b++) {
+                    stats->hist[op][b] += atomic_load_explicit(&src->hist[op][b], memory_order_relaxed);
+                }
+            }
+            stats->batch_calls += atomic_load_explicit(&src->batch_calls, memory_order_relaxed);
+            stats->batch_items += atomic_load_explicit(&src->batch_items, memory_order_relaxed);
+#ifdef USE_OPCOUNT_STATS
+            for (op = 0; op < SECP256K1_CONTEXT_STATS_OPS; op++) {
+                stats->fe_mul[op] += atomic_load_explicit(&src->fe_mul[op], memory_order_relaxed);
+                stats->fe_sqr[op] += atomic_load_explicit(&src->fe_sqr[op], memory_order_relaxed);
+            }
+#endif
+        }
+    }
+#else
+    (void)ctx;
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+void secp256k1_context_stats_reset(secp256k1_context* ctx) {
+    VERIFY_CHECK(ctx != NULL);
+#ifdef USE_CONTEXT_STATS
+    {
+        int s, op, b;
+        for (s = 0; s < SECP256K1_CONTEXT_STATS_SLOTS; s++) {
+            secp256k1_stats_slot *slot = &ctx->stats.slots[s];
+            for (op = 0; op < SECP256K1_CONTEXT_STATS_OPS; op++) {
+                atomic_store_explicit(&slot->count[op], 0, memory_order_relaxed);
+                atomic_store_explicit(&slot->total_ns[op], 0, memory_order_relaxed);
+                for (b = 0; b < SECP256K1_CONTEXT_STATS_BUCKETS; b++) {
+                    atomic_store_explicit(&slot->hist[op][b], 0, memory_order_relaxed);
+                }
+            }
+            atomic_store_explicit(&slot->batch_calls, 0, memory_order_relaxed);
+            atomic_store_explicit(&slot->batch_items, 0, memory_order_relaxed);
+#ifdef USE_OPCOUNT_STATS
+            for (op = 0; op < SECP256K1_CONTEXT_STATS_OPS; op++) {
+                atomic_store_explicit(&slot->fe_mul[op], 0, memory_order_relaxed);
+                atomic_store_explicit(&slot->fe_sqr[op], 0, memory_order_relaxed);
+            }
+#endif
+        }
+    }
+#else
+    (void)ctx;
+#endif
+}
+
 #ifdef ENABLE_MODULE_ECDH
 # include "modules/ecdh/main_impl.h"
 #endif
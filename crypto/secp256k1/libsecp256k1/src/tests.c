@@ -4,6 +4,13 @@
  * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
  **********************************************************************/
 
+/* This TU pulls in secp256k1.c below, after the libc headers, so the POSIX
+ * feature test macro that file sets for the ecmult table-layout probe comes
+ * too late here. Repeat it ahead of the first libc header instead. */
+#if !defined(_WIN32) && !defined(_GNU_SOURCE) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
 #if defined HAVE_CONFIG_H
 #include "libsecp256k1-config.h"
 #endif
@@ -13,6 +20,11 @@
 
 #include <time.h>
 
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 #include "secp256k1.c"
 #include "include/secp256k1.h"
 #include "testrand_impl.h"
@@ -210,9 +222,41 @@ void run_context_tests(void) {
     secp256k1_context_set_illegal_callback(vrfy, NULL, NULL);
     secp256k1_context_set_illegal_callback(sign, NULL, NULL);
 
+    /*** memory layout report reflects the tables that were actually built ***/
+    {
+        secp256k1_context_memory_layout layout;
+        secp256k1_context_memory_report(sign, &layout);
+        CHECK(layout.context_bytes == sizeof(secp256k1_context));
+        CHECK(layout.arena_bytes >= layout.context_bytes);
+        CHECK(layout.entry_bytes == sizeof(secp256k1_ge_storage));
+        CHECK(layout.ecmult_bytes == 0 && layout.ecmult_entries == 0);
+#ifndef USE_ECMULT_STATIC_PRECOMPUTATION
+        CHECK(layout.ecmult_gen_bytes == sizeof(secp256k1_ge_storage) * ECMULT_GEN_PREC_N * ECMULT_GEN_PREC_G);
+        CHECK(layout.ecmult_gen_cachelines == (layout.ecmult_gen_bytes + 63) / 64);
+#endif
+        secp256k1_context_memory_report(vrfy, &layout);
+        CHECK(layout.ecmult_window == WINDOW_G);
+        CHECK(layout.ecmult_entries == ECMULT_TABLE_SIZE(WINDOW_G));
+        CHECK(layout.ecmult_bytes == layout.ecmult_tables * layout.ecmult_entries * sizeof(secp256k1_ge_storage));
+        CHECK(layout.arena_bytes >= layout.ecmult_bytes);
+        CHECK(!layout.ecmult_borrowed);
+        {
+            secp256k1_context *small = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY_SMALL);
+            secp256k1_context *shared = secp256k1_context_clone_shared(vrfy);
+            secp256k1_context_memory_report(small, &layout);
+            CHECK(layout.ecmult_window == WINDOW_G_SMALL);
+            CHECK(layout.ecmult_entries == ECMULT_TABLE_SIZE(WINDOW_G_SMALL));
+            secp256k1_context_memory_report(shared, &layout);
+            CHECK(layout.ecmult_borrowed);
+            CHECK(layout.arena_bytes < layout.ecmult_bytes);
+            secp256k1_context_destroy(shared);
+            secp256k1_context_destroy(small);
+        }
+    }
+
     /* This shouldn't leak memory, due to already-set tests. */
-    secp256k1_ecmult_gen_context_build(&sign->ecmult_gen_ctx, NULL);
-    secp256k1_ecmult_context_build(&vrfy->ecmult_ctx, NULL);
+    secp256k1_ecmult_gen_context_build(&sign->ecmult_gen_ctx, NULL, NULL);
+    secp256k1_ecmult_context_build(&vrfy->ecmult_ctx, WINDOW_G, NULL, NULL);
 
     /* obtain a working nonce */
     do {
@@ -227,6 +271,31 @@ void run_context_tests(void) {
     CHECK(secp256k1_ecdsa_sig_verify(&vrfy->ecmult_ctx, &sigr, &sigs, &pub, &msg));
     CHECK(secp256k1_ecdsa_sig_verify(&both->ecmult_ctx, &sigr, &sigs, &pub, &msg));
 
+    /*** contexts placed in caller-provided memory ***/
+    {
+        size_t prealloc_size = secp256k1_context_preallocated_size(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+        void *prealloc = malloc(prealloc_size);
+        void *prealloc_clone = malloc(prealloc_size);
+        secp256k1_context *pre;
+        secp256k1_context *pre_clone;
+
+        CHECK(prealloc_size >= sizeof(secp256k1_context));
+        CHECK(prealloc != NULL && prealloc_clone != NULL);
+        pre = secp256k1_context_preallocated_create(prealloc, SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+        CHECK(pre == (secp256k1_context*)prealloc);
+        CHECK(secp256k1_ecdsa_sig_sign(&pre->ecmult_gen_ctx, &sigr, &sigs, &key, &msg, &nonce, NULL));
+        CHECK(secp256k1_ecdsa_sig_verify(&pre->ecmult_ctx, &sigr, &sigs, &pub, &msg));
+
+        /* A clone of a fully built context needs the same amount of memory. */
+        CHECK(secp256k1_context_preallocated_clone_size(pre) == prealloc_size);
+        pre_clone = secp256k1_context_preallocated_clone(pre, prealloc_clone);
+        secp256k1_context_preallocated_destroy(pre);
+        free(prealloc);
+        CHECK(secp256k1_ecdsa_sig_verify(&pre_clone->ecmult_ctx, &sigr, &sigs, &pub, &msg));
+        secp256k1_context_preallocated_destroy(pre_clone);
+        free(prealloc_clone);
+    }
+
     /* cleanup */
     secp256k1_context_destroy(none);
     secp256k1_context_destroy(sign);
@@ -236,6 +305,44 @@ void run_context_tests(void) {
     secp256k1_context_destroy(NULL);
 }
 
+void run_small_table_context_tests(void) {
+    /* The reduced-window profile must interoperate with the default one:
+     * either context verifies what the other produced. */
+    secp256k1_context *small = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY_SMALL);
+    secp256k1_context *full = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    secp256k1_context *clone;
+    int i;
+
+    CHECK(small->ecmult_ctx.window_g == WINDOW_G_SMALL);
+    CHECK(full->ecmult_ctx.window_g == WINDOW_G);
+    CHECK(secp256k1_context_preallocated_size(SECP256K1_CONTEXT_VERIFY_SMALL) <=
+          secp256k1_context_preallocated_size(SECP256K1_CONTEXT_VERIFY));
+
+    for (i = 0; i < 8; i++) {
+        unsigned char privkey[32];
+        unsigned char message[32];
+        secp256k1_scalar key;
+        secp256k1_pubkey pubkey;
+        secp256k1_ecdsa_signature signature;
+
+        random_scalar_order_test(&key);
+        secp256k1_scalar_get_b32(privkey, &key);
+        secp256k1_rand256_test(message);
+        CHECK(secp256k1_ec_pubkey_create(small, &pubkey, privkey));
+        CHECK(secp256k1_ecdsa_sign(small, &signature, message, privkey, NULL, NULL));
+        CHECK(secp256k1_ecdsa_verify(small, &signature, message, &pubkey));
+        CHECK(secp256k1_ecdsa_verify(full, &signature, message, &pubkey));
+    }
+
+    /* Cloning preserves the profile. */
+    clone = secp256k1_context_clone(small);
+    CHECK(clone->ecmult_ctx.window_g == WINDOW_G_SMALL);
+    secp256k1_context_destroy(clone);
+
+    secp256k1_context_destroy(full);
+    secp256k1_context_destroy(small);
+}
+
 /***** HASH TESTS *****/
 
 void run_sha256_tests(void) {
@@ -316,6 +423,15 @@ void run_hmac_sha256_tests(void) {
             CHECK(memcmp(out, outputs[i], 32) == 0);
         }
     }
+    {
+        /* The precomputed zero-key midstate must match a fresh key setup. */
+        static const unsigned char zero_key[32] = {0};
+        secp256k1_hmac_sha256_t hasher;
+        secp256k1_hmac_sha256_initialize(&hasher, zero_key, 32);
+        CHECK(memcmp(hasher.inner.s, secp256k1_rfc6979_hmac_zero_key_mid.inner.s, sizeof(hasher.inner.s)) == 0);
+        CHECK(memcmp(hasher.outer.s, secp256k1_rfc6979_hmac_zero_key_mid.outer.s, sizeof(hasher.outer.s)) == 0);
+        CHECK(hasher.inner.bytes == 64 && hasher.outer.bytes == 64);
+    }
 }
 
 void run_rfc6979_hmac_sha256_tests(void) {
@@ -1633,6 +1749,55 @@ int fe_memcmp(const secp256k1_fe *a, const secp256k1_fe *b) {
     return memcmp(a, &t, sizeof(secp256k1_fe));
 }
 
+#ifdef USE_FIELD_5X52
+void run_field_x4(void) {
+    int i, j;
+    for (i = 0; i < 10 * count; i++) {
+        secp256k1_fe a[4], b[4], r[4], exp;
+        secp256k1_fe_x4 xa, xb, xr;
+        for (j = 0; j < 4; j++) {
+            random_fe(&a[j]);
+            random_fe(&b[j]);
+        }
+        secp256k1_fe_x4_gather(&xa, a);
+        secp256k1_fe_x4_gather(&xb, b);
+        secp256k1_fe_mul_x4(&xr, &xa, &xb);
+        secp256k1_fe_x4_scatter(r, &xr);
+        for (j = 0; j < 4; j++) {
+            secp256k1_fe_mul(&exp, &a[j], &b[j]);
+            CHECK(check_fe_equal(&exp, &r[j]));
+        }
+        secp256k1_fe_sqr_x4(&xr, &xa);
+        secp256k1_fe_x4_scatter(r, &xr);
+        for (j = 0; j < 4; j++) {
+            secp256k1_fe_sqr(&exp, &a[j]);
+            CHECK(check_fe_equal(&exp, &r[j]));
+        }
+    }
+}
+
+void run_sqrt_x4(void) {
+    int i, j;
+    for (i = 0; i < 10 * count; i++) {
+        secp256k1_fe a[4], r[4], exp;
+        int valid[4], expvalid[4];
+        for (j = 0; j < 4; j++) {
+            random_fe(&a[j]);
+            secp256k1_fe_normalize(&a[j]);
+            expvalid[j] = secp256k1_fe_sqrt(&exp, &a[j]);
+        }
+        secp256k1_fe_sqrt_x4(r, valid, a);
+        for (j = 0; j < 4; j++) {
+            CHECK(valid[j] == expvalid[j]);
+            if (valid[j]) {
+                secp256k1_fe_sqrt(&exp, &a[j]);
+                CHECK(check_fe_equal(&exp, &r[j]));
+            }
+        }
+    }
+}
+#endif
+
 void run_field_misc(void) {
     secp256k1_fe x;
     secp256k1_fe y;
@@ -1702,6 +1867,22 @@ void run_field_misc(void) {
         secp256k1_fe_add(&q, &x);
         CHECK(check_fe_equal(&y, &z));
         CHECK(check_fe_equal(&q, &y));
+        /* Test that the specialized double/triple/quad kernels agree with mul_int. */
+        y = x;
+        secp256k1_fe_mul_int(&y, 2);
+        z = x;
+        secp256k1_fe_double(&z);
+        CHECK(check_fe_equal(&y, &z));
+        y = x;
+        secp256k1_fe_mul_int(&y, 3);
+        z = x;
+        secp256k1_fe_triple(&z);
+        CHECK(check_fe_equal(&y, &z));
+        y = x;
+        secp256k1_fe_mul_int(&y, 4);
+        z = x;
+        secp256k1_fe_quad(&z);
+        CHECK(check_fe_equal(&y, &z));
     }
 }
 
@@ -1751,6 +1932,61 @@ void run_field_inv_all_var(void) {
     }
 }
 
+void run_vartime_inverse(void) {
+    secp256k1_fe x, xi, xig;
+    secp256k1_scalar s, si, sig;
+    int i;
+    /* The GCD-based kernels behind the vartime policy must agree with the
+     * constant-time inverses on every input, including zero. */
+    for (i = 0; i < 10*count; i++) {
+        random_fe_non_zero(&x);
+        random_scalar_order_test(&s);
+        secp256k1_set_vartime_kernels(0);
+        secp256k1_fe_inv_var(&xi, &x);
+        secp256k1_scalar_inverse_var(&si, &s);
+        secp256k1_set_vartime_kernels(1);
+        secp256k1_fe_inv_var(&xig, &x);
+        secp256k1_scalar_inverse_var(&sig, &s);
+        secp256k1_set_vartime_kernels(0);
+        CHECK(check_fe_equal(&xi, &xig));
+        CHECK(secp256k1_scalar_eq(&si, &sig));
+    }
+    secp256k1_fe_clear(&x);
+    secp256k1_scalar_set_int(&s, 0);
+    secp256k1_set_vartime_kernels(1);
+    secp256k1_fe_inv_var(&xig, &x);
+    secp256k1_scalar_inverse_var(&sig, &s);
+    secp256k1_set_vartime_kernels(0);
+    CHECK(secp256k1_fe_normalizes_to_zero_var(&xig));
+    CHECK(secp256k1_scalar_is_zero(&sig));
+}
+
+#ifdef SECP256K1_HAVE_SAFEGCD
+void run_safegcd_inverse(void) {
+    secp256k1_fe x, xi, xif;
+    secp256k1_scalar s, si, sif;
+    int i;
+    /* The constant-time safegcd inverses must agree with the Fermat ladders
+     * they replaced on every input, including zero. */
+    for (i = 0; i < 10*count; i++) {
+        random_fe_non_zero(&x);
+        random_scalar_order_test(&s);
+        secp256k1_fe_inv(&xi, &x);
+        secp256k1_fe_inv_fermat(&xif, &x);
+        secp256k1_scalar_inverse(&si, &s);
+        secp256k1_scalar_inverse_fermat(&sif, &s);
+        CHECK(check_fe_equal(&xi, &xif));
+        CHECK(secp256k1_scalar_eq(&si, &sif));
+    }
+    secp256k1_fe_clear(&x);
+    secp256k1_scalar_set_int(&s, 0);
+    secp256k1_fe_inv(&xi, &x);
+    secp256k1_scalar_inverse(&si, &s);
+    CHECK(secp256k1_fe_normalizes_to_zero_var(&xi));
+    CHECK(secp256k1_scalar_is_zero(&si));
+}
+#endif
+
 void run_sqr(void) {
     secp256k1_fe x, s;
 
@@ -2678,6 +2914,18 @@ void test_scalar_split(void) {
     random_scalar_order_test(&full);
     secp256k1_scalar_split_lambda(&s1, &slam, &full);
 
+    /* check that the decomposition reconstructs: s1 + lambda*slam == full */
+    {
+        static const secp256k1_scalar lambda = SECP256K1_SCALAR_CONST(
+            0x5363AD4CUL, 0xC05C30E0UL, 0xA5261C02UL, 0x8812645AUL,
+            0x122E22EAUL, 0x20816678UL, 0xDF02967CUL, 0x1B23BD72UL
+        );
+        secp256k1_scalar rebuilt;
+        secp256k1_scalar_mul(&rebuilt, &lambda, &slam);
+        secp256k1_scalar_add(&rebuilt, &rebuilt, &s1);
+        CHECK(secp256k1_scalar_eq(&rebuilt, &full));
+    }
+
     /* check that both are <= 128 bits in size */
     if (secp256k1_scalar_is_high(&s1)) {
         secp256k1_scalar_negate(&s1, &s1);
@@ -3099,6 +3347,85 @@ void run_ec_pubkey_parse_test(void) {
     }
 }
 
+void run_ec_pubkey_batch_test(void) {
+    unsigned char in65[8 * 65];
+    unsigned char in33[8 * 33];
+    unsigned char out65[8 * 65];
+    unsigned char out33[8 * 33];
+    secp256k1_pubkey pubkeys[8];
+    secp256k1_pubkey parsed[8];
+    secp256k1_pubkey zero_pk;
+    int results[8];
+    int32_t ecount = 0;
+    size_t i;
+
+    memset(&zero_pk, 0, sizeof(zero_pk));
+    secp256k1_context_set_illegal_callback(ctx, counting_illegal_callback_fn, &ecount);
+
+    /* Generate random keys and their serializations. */
+    for (i = 0; i < 8; i++) {
+        secp256k1_scalar sk;
+        unsigned char sk32[32];
+        size_t len = 65;
+        random_scalar_order_test(&sk);
+        secp256k1_scalar_get_b32(sk32, &sk);
+        CHECK(secp256k1_ec_pubkey_create(ctx, &pubkeys[i], sk32) == 1);
+        CHECK(secp256k1_ec_pubkey_serialize(ctx, &in65[i * 65], &len, &pubkeys[i], SECP256K1_EC_UNCOMPRESSED) == 1);
+        len = 33;
+        CHECK(secp256k1_ec_pubkey_serialize(ctx, &in33[i * 33], &len, &pubkeys[i], SECP256K1_EC_COMPRESSED) == 1);
+    }
+
+    /* An all-valid uncompressed batch round-trips. */
+    CHECK(secp256k1_ec_pubkey_parse_batch(ctx, parsed, results, in65, 8, SECP256K1_EC_UNCOMPRESSED) == 8);
+    for (i = 0; i < 8; i++) {
+        CHECK(results[i] == 1);
+        CHECK(memcmp(&parsed[i], &pubkeys[i], sizeof(parsed[i])) == 0);
+    }
+    CHECK(secp256k1_ec_pubkey_serialize_batch(ctx, out65, parsed, 8, SECP256K1_EC_UNCOMPRESSED) == 8);
+    CHECK(memcmp(out65, in65, sizeof(in65)) == 0);
+
+    /* Compressed likewise, with a NULL results array. */
+    CHECK(secp256k1_ec_pubkey_parse_batch(ctx, parsed, NULL, in33, 8, SECP256K1_EC_COMPRESSED) == 8);
+    for (i = 0; i < 8; i++) {
+        CHECK(memcmp(&parsed[i], &pubkeys[i], sizeof(parsed[i])) == 0);
+    }
+    CHECK(secp256k1_ec_pubkey_serialize_batch(ctx, out33, parsed, 8, SECP256K1_EC_COMPRESSED) == 8);
+    CHECK(memcmp(out33, in33, sizeof(in33)) == 0);
+    CHECK(ecount == 0);
+
+    /* A hybrid header parses on its own but fails the asserted uncompressed
+     * format, and a corrupted coordinate fails the curve check; the other
+     * slots are unaffected. */
+    in65[3 * 65] = 0x06 | (in65[3 * 65 + 64] & 1);
+    in65[5 * 65 + 40] ^= 0x20;
+    CHECK(secp256k1_ec_pubkey_parse(ctx, &parsed[0], &in65[3 * 65], 65) == 1);
+    CHECK(secp256k1_ec_pubkey_parse_batch(ctx, parsed, results, in65, 8, SECP256K1_EC_UNCOMPRESSED) == 6);
+    for (i = 0; i < 8; i++) {
+        CHECK(results[i] == (i != 3 && i != 5));
+        CHECK(memcmp(&parsed[i], (i != 3 && i != 5) ? &pubkeys[i] : &zero_pk, sizeof(parsed[i])) == 0);
+    }
+    CHECK(ecount == 0);
+
+    /* Serializing the zeroized failure slots raises the illegal-argument
+     * callback per bad key and zero-fills their output. */
+    CHECK(secp256k1_ec_pubkey_serialize_batch(ctx, out65, parsed, 8, SECP256K1_EC_UNCOMPRESSED) == 6);
+    CHECK(ecount == 2);
+    for (i = 0; i < 65; i++) {
+        CHECK(out65[3 * 65 + i] == 0);
+    }
+
+    /* Illegal args. */
+    CHECK(secp256k1_ec_pubkey_parse_batch(ctx, parsed, results, NULL, 8, SECP256K1_EC_UNCOMPRESSED) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_ec_pubkey_parse_batch(ctx, parsed, results, in65, 8, ~0) == 0);
+    CHECK(ecount == 4);
+    CHECK(secp256k1_ec_pubkey_parse_batch(ctx, parsed, results, NULL, 0, SECP256K1_EC_UNCOMPRESSED) == 0);
+    CHECK(secp256k1_ec_pubkey_serialize_batch(ctx, NULL, parsed, 0, SECP256K1_EC_COMPRESSED) == 0);
+    CHECK(ecount == 4);
+
+    secp256k1_context_set_illegal_callback(ctx, NULL, NULL);
+}
+
 void run_eckey_edge_case_test(void) {
     const unsigned char orderc[32] = {
         0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
@@ -4394,11 +4721,20 @@ void run_ecdsa_openssl(void) {
 int main(int argc, char **argv) {
     unsigned char seed16[16] = {0};
     unsigned char run32[32] = {0};
+    int shards = 1;
+    int shard = 0;
+
     /* find iteration count */
     if (argc > 1) {
         count = strtol(argv[1], NULL, 0);
     }
 
+    /* find shard count: "tests <count> <seed> <shards>" splits a
+     * full-strength run across that many processes */
+    if (argc > 3) {
+        shards = strtol(argv[3], NULL, 0);
+    }
+
     /* find random seed */
     if (argc > 2) {
         int pos = 0;
@@ -4428,6 +4764,46 @@ int main(int argc, char **argv) {
         }
         fclose(frand);
     }
+
+#ifndef _WIN32
+    /* Sharded mode: fork one worker per shard, each running a fraction of
+     * the iterations on its own partition of the seed space, so a
+     * full-strength run finishes in wall time count/shards. A failing shard
+     * prints its own seed and count and stays reproducible standalone. */
+    if (shards > 1) {
+        for (shard = 0; shard < shards; shard++) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                break;
+            }
+            if (pid < 0) {
+                fprintf(stderr, "FAILED: could not fork shard %d\n", shard);
+                return 1;
+            }
+        }
+        if (shard == shards) {
+            /* Parent: collect the workers. */
+            int status;
+            int failed = 0;
+            while (wait(&status) > 0) {
+                if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                    failed++;
+                }
+            }
+            if (failed != 0) {
+                printf("FAILED: %d of %d shards reported errors\n", failed, shards);
+                return 1;
+            }
+            printf("all %d shards passed\n", shards);
+            return 0;
+        }
+        /* Worker: derive this shard's seed and share of the iterations. */
+        seed16[0] ^= (unsigned char)shard;
+        seed16[1] ^= (unsigned char)(shard >> 8);
+        count = (count + shards - 1) / shards;
+        printf("shard %d of %d\n", shard, shards);
+    }
+#endif
     secp256k1_rand_seed(seed16);
 
     printf("test count = %i\n", count);
@@ -4435,6 +4811,7 @@ int main(int argc, char **argv) {
 
     /* initialize */
     run_context_tests();
+    run_small_table_context_tests();
     ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
     if (secp256k1_rand_bits(1)) {
         secp256k1_rand256(run32);
@@ -4460,7 +4837,15 @@ int main(int argc, char **argv) {
     run_field_inv();
     run_field_inv_var();
     run_field_inv_all_var();
+    run_vartime_inverse();
+#ifdef SECP256K1_HAVE_SAFEGCD
+    run_safegcd_inverse();
+#endif
     run_field_misc();
+#ifdef USE_FIELD_5X52
+    run_field_x4();
+    run_sqrt_x4();
+#endif
     run_field_convert();
     run_sqr();
     run_sqrt();
@@ -4485,6 +4870,7 @@ int main(int argc, char **argv) {
 
     /* EC point parser test */
     run_ec_pubkey_parse_test();
+    run_ec_pubkey_batch_test();
 
     /* EC key edge cases */
     run_eckey_edge_case_test();
@@ -20,7 +20,20 @@ typedef struct {
     const void* data;
 } secp256k1_callback;
 
-static SECP256K1_INLINE void secp256k1_callback_call(const secp256k1_callback * const cb, const char * const text) {
+/* For functions only reached on failure paths. Calls to a cold function are
+ * laid out as unlikely and the surrounding failure code is moved into the
+ * caller's .text.unlikely partition, so the hot entry points present the
+ * front end with straight-line success code; noinline keeps the callee
+ * itself (and its string arguments' setup) out of the hot section too. */
+#if defined(__GNUC__) && (__GNUC__ >= 4 || defined(__clang__))
+#define SECP256K1_COLD __attribute__((cold, noinline, unused))
+#else
+#define SECP256K1_COLD
+#endif
+
+/* Every ARG_CHECK, out-of-memory and internal-error path funnels through
+ * here, so marking it cold outlines all of them at once. */
+static SECP256K1_COLD void secp256k1_callback_call(const secp256k1_callback * const cb, const char * const text) {
     cb->fn(text, (void*)cb->data);
 }
 
@@ -68,11 +81,71 @@ static SECP256K1_INLINE void secp256k1_callback_call(const secp256k1_callback *
 #define VERIFY_SETUP(stmt)
 #endif
 
+#ifdef USE_NATIVEMEM_TRACKING
+/* Subsystem-tagged allocation tracking, provided by the embedding build (see
+ * nativemem.h in the wrapping package). Routing the checked allocator pair
+ * through it attributes this library's heap usage in the process-wide native
+ * memory snapshot; standalone library builds keep plain malloc/free. */
+void *nativemem_malloc(int subsys, size_t size);
+void nativemem_free(int subsys, void *ptr);
+#define NATIVEMEM_SUBSYS_SECP256K1 0
+#endif
+
 static SECP256K1_INLINE void *checked_malloc(const secp256k1_callback* cb, size_t size) {
+#ifdef USE_NATIVEMEM_TRACKING
+    void *ret = nativemem_malloc(NATIVEMEM_SUBSYS_SECP256K1, size);
+#else
     void *ret = malloc(size);
-    if (ret == NULL) {
+#endif
+    if (EXPECT(ret == NULL, 0)) {
+        secp256k1_callback_call(cb, "Out of memory");
+    }
+    return ret;
+}
+
+/* checked_free releases checked_malloc'd memory, keeping the tracked byte
+ * counters balanced. Without tracking it is plain free. */
+static SECP256K1_INLINE void checked_free(void *ptr) {
+#ifdef USE_NATIVEMEM_TRACKING
+    nativemem_free(NATIVEMEM_SUBSYS_SECP256K1, ptr);
+#else
+    free(ptr);
+#endif
+}
+
+/* Bump allocator over a caller-provided slab. Long-lived per-context
+ * allocations (the precomputed tables) are carved out of one block so that
+ * creating and destroying many ephemeral contexts does not fragment the
+ * heap, and so that a context can be placed in pre-reserved or shared
+ * memory. Allocations are never freed individually; the slab is released
+ * (or not, for caller-owned memory) as a whole. */
+typedef struct {
+    unsigned char *base;
+    size_t size;
+    size_t alloc;
+} secp256k1_arena;
+
+/* All arena allocations are rounded up to this alignment, which also bounds
+ * the alignment a caller-provided slab must have. malloc'd memory always
+ * qualifies. */
+#define SECP256K1_ARENA_ALIGN 16
+#define SECP256K1_ARENA_ROUND(size) (((size) + SECP256K1_ARENA_ALIGN - 1) & ~(size_t)(SECP256K1_ARENA_ALIGN - 1))
+
+/* Carve size bytes out of the arena. A NULL arena falls back to the heap,
+ * for callers (tests, the static table generator) that build an ecmult
+ * context without a surrounding secp256k1_context. */
+static SECP256K1_INLINE void *secp256k1_arena_alloc(secp256k1_arena *arena, const secp256k1_callback* cb, size_t size) {
+    void *ret;
+    if (arena == NULL) {
+        return checked_malloc(cb, size);
+    }
+    size = SECP256K1_ARENA_ROUND(size);
+    if (EXPECT(size > arena->size - arena->alloc, 0)) {
         secp256k1_callback_call(cb, "Out of memory");
+        return NULL;
     }
+    ret = arena->base + arena->alloc;
+    arena->alloc += size;
     return ret;
 }
 
@@ -0,0 +1,117 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <stdlib.h>
+
+#include "nativemem.h"
+
+#if defined(__GLIBC__) || defined(__linux__)
+#include <malloc.h>
+#define NATIVEMEM_USABLE(ptr) malloc_usable_size(ptr)
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define NATIVEMEM_USABLE(ptr) malloc_size(ptr)
+#else
+/* No usable-size query: byte attribution degrades to zero, the alloc and
+ * free event counters keep working. */
+#define NATIVEMEM_USABLE(ptr) ((size_t)0)
+#endif
+
+// Counters are padded to their own cachelines so concurrent subsystems do not
+// false-share; the layout mirrors the per-slot padding in the context stats.
+typedef struct {
+	unsigned long long live_bytes;
+	unsigned long long peak_bytes;
+	unsigned long long live_allocs;
+	unsigned long long total_allocs;
+	unsigned long long total_frees;
+	unsigned long long pad[3];
+} nativemem_counters;
+
+static nativemem_counters nativemem_state[NATIVEMEM_SUBSYS_COUNT];
+
+void nativemem_account(int subsys, long long bytes, int allocs, int frees) {
+	nativemem_counters *c;
+	unsigned long long live, peak;
+
+	if (subsys < 0 || subsys >= NATIVEMEM_SUBSYS_COUNT) {
+		return;
+	}
+	c = &nativemem_state[subsys];
+	live = __atomic_add_fetch(&c->live_bytes, (unsigned long long)bytes, __ATOMIC_RELAXED);
+	if (allocs > 0) {
+		__atomic_add_fetch(&c->total_allocs, (unsigned long long)allocs, __ATOMIC_RELAXED);
+		__atomic_add_fetch(&c->live_allocs, (unsigned long long)allocs, __ATOMIC_RELAXED);
+	}
+	if (frees > 0) {
+		__atomic_add_fetch(&c->total_frees, (unsigned long long)frees, __ATOMIC_RELAXED);
+		__atomic_sub_fetch(&c->live_allocs, (unsigned long long)frees, __ATOMIC_RELAXED);
+	}
+	/* Racing peaks may settle slightly low; the watermark is monitoring
+	 * data, not an invariant. */
+	peak = __atomic_load_n(&c->peak_bytes, __ATOMIC_RELAXED);
+	while (bytes > 0 && live > peak) {
+		if (__atomic_compare_exchange_n(&c->peak_bytes, &peak, live, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+			break;
+		}
+	}
+}
+
+void *nativemem_malloc(int subsys, size_t size) {
+	void *ret = malloc(size);
+	if (ret != NULL) {
+		nativemem_account(subsys, (long long)NATIVEMEM_USABLE(ret), 1, 0);
+	}
+	return ret;
+}
+
+void *nativemem_calloc(int subsys, size_t nmemb, size_t size) {
+	void *ret = calloc(nmemb, size);
+	if (ret != NULL) {
+		nativemem_account(subsys, (long long)NATIVEMEM_USABLE(ret), 1, 0);
+	}
+	return ret;
+}
+
+void *nativemem_realloc(int subsys, void *ptr, size_t size) {
+	long long old = (ptr != NULL) ? (long long)NATIVEMEM_USABLE(ptr) : 0;
+	void *ret = realloc(ptr, size);
+	if (ret == NULL) {
+		return NULL;
+	}
+	nativemem_account(subsys, (long long)NATIVEMEM_USABLE(ret) - old, (ptr == NULL) ? 1 : 0, 0);
+	return ret;
+}
+
+void nativemem_free(int subsys, void *ptr) {
+	if (ptr == NULL) {
+		return;
+	}
+	nativemem_account(subsys, -(long long)NATIVEMEM_USABLE(ptr), 0, 1);
+	free(ptr);
+}
+
+void nativemem_snapshot(nativemem_stats stats[NATIVEMEM_SUBSYS_COUNT]) {
+	int i;
+	for (i = 0; i < NATIVEMEM_SUBSYS_COUNT; i++) {
+		nativemem_counters *c = &nativemem_state[i];
+		stats[i].live_bytes = __atomic_load_n(&c->live_bytes, __ATOMIC_RELAXED);
+		stats[i].peak_bytes = __atomic_load_n(&c->peak_bytes, __ATOMIC_RELAXED);
+		stats[i].live_allocs = __atomic_load_n(&c->live_allocs, __ATOMIC_RELAXED);
+		stats[i].total_allocs = __atomic_load_n(&c->total_allocs, __ATOMIC_RELAXED);
+		stats[i].total_frees = __atomic_load_n(&c->total_frees, __ATOMIC_RELAXED);
+	}
+}
@@ -0,0 +1,64 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+package secp256k1
+
+/*
+#include "nativemem.h"
+*/
+import "C"
+
+// NativeMemStats is a per-subsystem snapshot of the native allocation
+// tracker: how much heap memory a vendored C library holds right now, its
+// high water mark and its allocation churn. Byte counters are exact where
+// the platform allocator reports usable sizes (glibc, darwin) and zero
+// elsewhere; the event counters always work.
+type NativeMemStats struct {
+	LiveBytes   uint64
+	PeakBytes   uint64
+	LiveAllocs  uint64
+	TotalAllocs uint64
+	TotalFrees  uint64
+}
+
+// NativeMemSubsystems names the tracked native subsystems, indexed like the
+// NativeMemSnapshot result.
+var NativeMemSubsystems = [...]string{
+	C.NATIVEMEM_SUBSYS_SECP256K1: "secp256k1",
+	C.NATIVEMEM_SUBSYS_DUKTAPE:   "duktape",
+	C.NATIVEMEM_SUBSYS_HIDAPI:    "hidapi",
+	C.NATIVEMEM_SUBSYS_EAIASH:    "eaiash",
+}
+
+// NativeMemSnapshot returns the allocation counters of all tracked native
+// subsystems, attributing native memory growth to the vendored library
+// producing it. Counters are updated with relaxed atomics on the allocation
+// paths, so the snapshot is cheap but not atomic across subsystems.
+func NativeMemSnapshot() [len(NativeMemSubsystems)]NativeMemStats {
+	var (
+		cs  [C.NATIVEMEM_SUBSYS_COUNT]C.nativemem_stats
+		ret [len(NativeMemSubsystems)]NativeMemStats
+	)
+	C.nativemem_snapshot(&cs[0])
+	for i := range ret {
+		ret[i].LiveBytes = uint64(cs[i].live_bytes)
+		ret[i].PeakBytes = uint64(cs[i].peak_bytes)
+		ret[i].LiveAllocs = uint64(cs[i].live_allocs)
+		ret[i].TotalAllocs = uint64(cs[i].total_allocs)
+		ret[i].TotalFrees = uint64(cs[i].total_frees)
+	}
+	return ret
+}
@@ -0,0 +1,65 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+// Subsystem-tagged native allocation tracker. Every vendored native library
+// in the binary (secp256k1, duktape, hidapi, eaiash) routes its heap traffic
+// through the hooks below with a subsystem tag, so a snapshot attributes
+// native memory growth to the library producing it instead of leaving one
+// opaque RSS number. The other packages reference the hooks as weak symbols
+// and fall back to plain malloc when this translation unit is not linked in,
+// keeping each vendored library buildable on its own.
+//
+// Tracking is byte-exact where the allocator can report usable sizes (glibc,
+// darwin); elsewhere the live byte counters stay zero and only the event
+// counters remain. All counters are relaxed atomics: the snapshot is a
+// monitoring view, not a synchronization point.
+
+#ifndef SECP256K1_EXT_NATIVEMEM_H
+#define SECP256K1_EXT_NATIVEMEM_H
+
+#include <stddef.h>
+
+#define NATIVEMEM_SUBSYS_SECP256K1 0
+#define NATIVEMEM_SUBSYS_DUKTAPE   1
+#define NATIVEMEM_SUBSYS_HIDAPI    2
+#define NATIVEMEM_SUBSYS_EAIASH    3
+#define NATIVEMEM_SUBSYS_COUNT     4
+
+typedef struct {
+	unsigned long long live_bytes;   /* bytes currently allocated */
+	unsigned long long peak_bytes;   /* high water mark of live_bytes */
+	unsigned long long live_allocs;  /* allocations not yet freed */
+	unsigned long long total_allocs; /* allocations since process start */
+	unsigned long long total_frees;  /* frees since process start */
+} nativemem_stats;
+
+/* Tracked drop-in replacements for the libc allocator. Returned pointers are
+ * plain heap pointers: passing one to an untracked free() is memory-safe and
+ * only costs attribution accuracy. */
+void *nativemem_malloc(int subsys, size_t size);
+void *nativemem_calloc(int subsys, size_t nmemb, size_t size);
+void *nativemem_realloc(int subsys, void *ptr, size_t size);
+void nativemem_free(int subsys, void *ptr);
+
+/* nativemem_account books an allocation delta a subsystem has measured
+ * itself, for allocators (duktape's budget heaps) that already keep exact
+ * byte counts and should not pay a second size query. */
+void nativemem_account(int subsys, long long bytes, int allocs, int frees);
+
+/* nativemem_snapshot copies the counters of all subsystems into stats. */
+void nativemem_snapshot(nativemem_stats stats[NATIVEMEM_SUBSYS_COUNT]);
+
+#endif /* SECP256K1_EXT_NATIVEMEM_H */
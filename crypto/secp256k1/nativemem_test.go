@@ -0,0 +1,61 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+package secp256k1
+
+import (
+	"testing"
+
+	"github.com/ethereumai/go-ethereumai/crypto/randentropy"
+)
+
+// Tests that batch work is attributed to the secp256k1 subsystem in the
+// native allocation snapshot and that the scratch allocations it churns
+// through are balanced by matching frees.
+func TestNativeMemSnapshot(t *testing.T) {
+	before := NativeMemSnapshot()
+
+	const batch = 8
+	msgs := make([][]byte, batch)
+	sigs := make([][]byte, batch)
+	for i := 0; i < batch; i++ {
+		_, seckey := generateKeyPair()
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msgs[i], seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		sigs[i] = sig
+	}
+	if _, err := RecoverPubkeyBatch(msgs, sigs); err != nil {
+		t.Fatalf("batch recover error: %s", err)
+	}
+
+	after := NativeMemSnapshot()
+	sub := after[0] // NATIVEMEM_SUBSYS_SECP256K1
+	if sub.TotalAllocs <= before[0].TotalAllocs {
+		t.Errorf("secp256k1 allocations not attributed: have %d, had %d", sub.TotalAllocs, before[0].TotalAllocs)
+	}
+	// The batch scratch buffers are all released again: the net live alloc
+	// count must not have grown by the batch churn.
+	churn := (after[0].TotalAllocs - before[0].TotalAllocs) - (after[0].TotalFrees - before[0].TotalFrees)
+	if churn > 2 {
+		t.Errorf("batch scratch allocations leaked: %d more allocs than frees", churn)
+	}
+	if sub.PeakBytes < sub.LiveBytes {
+		t.Errorf("peak watermark %d below live bytes %d", sub.PeakBytes, sub.LiveBytes)
+	}
+}
@@ -17,17 +17,43 @@
 // Package secp256k1 wraps the bitcoin secp256k1 C library.
 package secp256k1
 
+// The C sources below are compiled directly into this translation unit, so a
+// profile trained with the library's --enable-pgo flow (see libsecp256k1/src/
+// pgo_train.c) is consumed here by pointing the cgo build at it:
+//
+//	CGO_CFLAGS="-fprofile-use=<profile dir> -fprofile-correction" go build
+//
+// No archive relinking is needed; the profiled functions are rebuilt in place.
+
 /*
 #cgo CFLAGS: -I./libsecp256k1
 #cgo CFLAGS: -I./libsecp256k1/src/
+#cgo linux CFLAGS: -D_GNU_SOURCE
+#define USE_ENDOMORPHISM
 #define USE_NUM_NONE
-#define USE_FIELD_10X26
+#if defined(__x86_64__) || defined(__aarch64__)
+#  define HAVE___INT128
+#  define USE_FIELD_5X52
+#  define USE_SCALAR_4X64
+#  if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#    define USE_FIELD_5X52_ADX
+#    define USE_SCALAR_4X64_ADX
+#  endif
+#else
+#  define USE_FIELD_10X26
+#  define USE_SCALAR_8X32
+#  if defined(__arm__) && defined(__linux__) && defined(__GNUC__) && !defined(__clang__)
+#    define USE_SCALAR_8X32_NEON
+#  endif
+#endif
 #define USE_FIELD_INV_BUILTIN
-#define USE_SCALAR_8X32
 #define USE_SCALAR_INV_BUILTIN
+#define USE_CONTEXT_STATS
+#define USE_NATIVEMEM_TRACKING
 #define NDEBUG
 #include "./libsecp256k1/src/secp256k1.c"
 #include "./libsecp256k1/src/modules/recovery/main_impl.h"
+#include "./libsecp256k1/src/modules/schnorr/main_impl.h"
 #include "ext.h"
 
 typedef void (*callbackFunc) (const char* msg, void* data);
@@ -39,6 +65,7 @@ import "C"
 import (
 	"errors"
 	"math/big"
+	"sync/atomic"
 	"unsafe"
 )
 
@@ -51,6 +78,189 @@ func init() {
 	C.secp256k1_context_set_error_callback(context, C.callbackFunc(C.secp256k1GoPanicError), nil)
 }
 
+// LoadSharedContext switches the package to a context whose verification
+// tables are backed by the file at path, mapped shared and read-only. The
+// first process on a machine builds the tables and writes the file; every
+// later process maps the same physical pages instead of rebuilding them.
+// It must be called during startup, before the package is used concurrently.
+// On platforms without shared mappings it degrades to a private context.
+func LoadSharedContext(path string) error {
+	cpath := C.CString(path)
+	defer C.free(unsafe.Pointer(cpath))
+	ctx := C.secp256k1_ext_context_create_mmap(cpath)
+	if ctx == nil {
+		return errors.New("secp256k1: shared context creation failed")
+	}
+	C.secp256k1_context_set_illegal_callback(ctx, C.callbackFunc(C.secp256k1GoPanicIllegal), nil)
+	C.secp256k1_context_set_error_callback(ctx, C.callbackFunc(C.secp256k1GoPanicError), nil)
+	// The previous context is leaked deliberately: it may still be referenced
+	// by calls racing with startup, and there is exactly one swap per process.
+	context = ctx
+	return nil
+}
+
+// Calibrate switches the package to a context whose verification table
+// geometry was picked by timing this machine. The first call on a host
+// probes a short burst of verifications against each table profile — large
+// tables win on most hardware, but cache-constrained parts come out ahead
+// with the small profile — and caches the verdict in the file at path, so
+// later starts skip the probe. Like LoadSharedContext it must be called
+// during startup, before the package is used concurrently.
+func Calibrate(path string) error {
+	cpath := C.CString(path)
+	defer C.free(unsafe.Pointer(cpath))
+	ctx := C.secp256k1_ext_context_create_calibrated(cpath)
+	if ctx == nil {
+		return errors.New("secp256k1: calibrated context creation failed")
+	}
+	C.secp256k1_context_set_illegal_callback(ctx, C.callbackFunc(C.secp256k1GoPanicIllegal), nil)
+	C.secp256k1_context_set_error_callback(ctx, C.callbackFunc(C.secp256k1GoPanicError), nil)
+	// As in LoadSharedContext, the previous context is deliberately leaked.
+	context = ctx
+	return nil
+}
+
+// ShareRecoveryCache switches the native recovery memoization table to one
+// backed by the file at path, mapped shared and writable by every node
+// process on the machine. Colocated instances gossip largely the same
+// transactions, so with a shared table each unique signature is recovered
+// once per host by whichever process sees it first; the others answer from
+// the table. A file left by a different build layout is rejected and the
+// process keeps its private table. Like LoadSharedContext it must be called
+// during startup, before the package is used concurrently.
+func ShareRecoveryCache(path string) error {
+	cpath := C.CString(path)
+	defer C.free(unsafe.Pointer(cpath))
+	if C.secp256k1_ffi_recover_cache_share(cpath) == 0 {
+		return errors.New("secp256k1: shared recovery cache attach failed")
+	}
+	return nil
+}
+
+// SaveWarmState snapshots the warm native caches — the recovery memoization
+// table and the per-context odd-multiples LRU — to the file at path, replacing
+// any previous snapshot atomically. Without it every restart runs cold for
+// minutes while the caches repopulate; with it the next process picks up where
+// this one left off. The natural call site is graceful shutdown, after the
+// batch entry points have quiesced.
+func SaveWarmState(path string) error {
+	cpath := C.CString(path)
+	defer C.free(unsafe.Pointer(cpath))
+	if C.secp256k1_ffi_warm_save(context, cpath) == 0 {
+		return errors.New("secp256k1: warm state snapshot failed")
+	}
+	return nil
+}
+
+// RestoreWarmState loads a snapshot written by SaveWarmState and returns the
+// number of sections restored. Zero means nothing usable was found — a missing
+// file, a foreign endianness or a snapshot from a different build layout — and
+// the process simply starts cold, as before. Like LoadSharedContext it must be
+// called during startup, before the package is used concurrently.
+func RestoreWarmState(path string) int {
+	cpath := C.CString(path)
+	defer C.free(unsafe.Pointer(cpath))
+	return int(C.secp256k1_ffi_warm_load(context, cpath))
+}
+
+// EnableNUMA replicates the verification tables once per NUMA node and pins
+// the native pool workers to their local replica, avoiding cross-socket table
+// fetches on multi-socket machines. It must be called during startup, before
+// the batch or async APIs first run. It returns the number of node replicas
+// in use; zero means single-node hardware or an unsupported platform, where
+// the shared tables are kept as-is.
+func EnableNUMA() int {
+	return int(C.secp256k1_ext_numa_enable(context))
+}
+
+// CapabilityReport returns a JSON description of what the native layer is
+// actually running on this host: the kernels the runtime dispatch selected,
+// the verification table geometry in effect, worker pool sizes, NUMA mode,
+// calibration provenance and per-subsystem feature flags. Nominally identical
+// hosts can legitimately differ on all of these, so ops tooling chasing a
+// performance delta can diff two reports instead of two binaries. The key set
+// only ever grows; consumers must ignore keys they do not know. Returns the
+// empty string on platforms without the native report.
+func CapabilityReport() string {
+	buf := make([]C.char, 4096)
+	n := C.secp256k1_ffi_capability_report(context, &buf[0], C.size_t(len(buf)))
+	return C.GoStringN(&buf[0], C.int(n))
+}
+
+// RefreshBlinding rotates the projective blinding used to harden signing
+// against side channels. It swaps in a pair prepared by an earlier call (two
+// plain copies, no point multiplication) and schedules the next pair on a
+// background thread, so the refresh cost is never paid on the signing path.
+// seed may be nil to rotate on the existing entropy alone, or 32 bytes of
+// fresh entropy to chain in. It reports whether this call swapped in a fresh
+// pair. Like the underlying context randomization it must not race a
+// concurrent signer.
+func RefreshBlinding(seed []byte) bool {
+	var seedPtr *C.uchar
+	if len(seed) == 32 {
+		seedPtr = (*C.uchar)(unsafe.Pointer(&seed[0]))
+	}
+	return C.secp256k1_ext_blind_refresh(context, seedPtr) != 0
+}
+
+// StatsBuckets is the number of latency histogram buckets; bucket b counts
+// operations whose latency was in [2^b, 2^(b+1)) nanoseconds, with the last
+// bucket absorbing everything slower.
+const StatsBuckets = C.SECP256K1_CONTEXT_STATS_BUCKETS
+
+// ContextStats is a snapshot of the operation counters the C library keeps
+// for the package context: how many sign/verify/recover operations it served,
+// the wall-clock time they took, their latency distribution and the occupancy
+// of the batch entry points. The counters are updated with relaxed atomics on
+// the hot paths, so snapshots are cheap but not atomic across counters.
+type ContextStats struct {
+	SignCount, VerifyCount, RecoverCount uint64
+	SignNanos, VerifyNanos, RecoverNanos uint64
+	SignHist                             [StatsBuckets]uint64
+	VerifyHist                           [StatsBuckets]uint64
+	RecoverHist                          [StatsBuckets]uint64
+	BatchCalls, BatchItems               uint64
+	// Field multiplications and squarings per operation, for auditing
+	// formula changes. Only maintained when the C library is compiled with
+	// the USE_OPCOUNT_STATS audit flag; zero otherwise.
+	SignFeMul, VerifyFeMul, RecoverFeMul uint64
+	SignFeSqr, VerifyFeSqr, RecoverFeSqr uint64
+}
+
+// Stats returns a snapshot of the context's operation counters.
+func Stats() ContextStats {
+	var (
+		cs  C.secp256k1_context_stats
+		ret ContextStats
+	)
+	C.secp256k1_context_stats_get(context, &cs)
+	ret.SignCount = uint64(cs.count[C.SECP256K1_CONTEXT_STATS_SIGN])
+	ret.VerifyCount = uint64(cs.count[C.SECP256K1_CONTEXT_STATS_VERIFY])
+	ret.RecoverCount = uint64(cs.count[C.SECP256K1_CONTEXT_STATS_RECOVER])
+	ret.SignNanos = uint64(cs.total_ns[C.SECP256K1_CONTEXT_STATS_SIGN])
+	ret.VerifyNanos = uint64(cs.total_ns[C.SECP256K1_CONTEXT_STATS_VERIFY])
+	ret.RecoverNanos = uint64(cs.total_ns[C.SECP256K1_CONTEXT_STATS_RECOVER])
+	for b := 0; b < StatsBuckets; b++ {
+		ret.SignHist[b] = uint64(cs.hist[C.SECP256K1_CONTEXT_STATS_SIGN][b])
+		ret.VerifyHist[b] = uint64(cs.hist[C.SECP256K1_CONTEXT_STATS_VERIFY][b])
+		ret.RecoverHist[b] = uint64(cs.hist[C.SECP256K1_CONTEXT_STATS_RECOVER][b])
+	}
+	ret.BatchCalls = uint64(cs.batch_calls)
+	ret.BatchItems = uint64(cs.batch_items)
+	ret.SignFeMul = uint64(cs.fe_mul[C.SECP256K1_CONTEXT_STATS_SIGN])
+	ret.VerifyFeMul = uint64(cs.fe_mul[C.SECP256K1_CONTEXT_STATS_VERIFY])
+	ret.RecoverFeMul = uint64(cs.fe_mul[C.SECP256K1_CONTEXT_STATS_RECOVER])
+	ret.SignFeSqr = uint64(cs.fe_sqr[C.SECP256K1_CONTEXT_STATS_SIGN])
+	ret.VerifyFeSqr = uint64(cs.fe_sqr[C.SECP256K1_CONTEXT_STATS_VERIFY])
+	ret.RecoverFeSqr = uint64(cs.fe_sqr[C.SECP256K1_CONTEXT_STATS_RECOVER])
+	return ret
+}
+
+// ResetStats resets the context's operation counters to zero.
+func ResetStats() {
+	C.secp256k1_context_stats_reset(context)
+}
+
 var (
 	ErrInvalidMsgLen       = errors.New("invalid message length, need 32 bytes")
 	ErrInvalidSignatureLen = errors.New("invalid signature length")
@@ -59,6 +269,7 @@ var (
 	ErrInvalidPubkey       = errors.New("invalid public key")
 	ErrSignFailed          = errors.New("signing failed")
 	ErrRecoverFailed       = errors.New("recovery failed")
+	ErrVerifyFailed        = errors.New("verification failed")
 )
 
 // Sign creates a recoverable ECDSA signature.
@@ -98,6 +309,56 @@ func Sign(msg []byte, seckey []byte) ([]byte, error) {
 	return sig, nil
 }
 
+// PrecomputeNonces derives signing nonces from the given 32-byte high-entropy
+// seeds and precomputes their public points into a process-wide pool, moving
+// the expensive point multiplication off the signing critical path. It returns
+// the number of nonces actually pooled; seeds that are not valid nonzero
+// scalars, or that exceed the pool capacity, are dropped.
+func PrecomputeNonces(seeds [][]byte) int {
+	flat := make([]byte, 0, 32*len(seeds))
+	for _, seed := range seeds {
+		if len(seed) != 32 {
+			continue
+		}
+		flat = append(flat, seed...)
+	}
+	if len(flat) == 0 {
+		return 0
+	}
+	seeddata := (*C.uchar)(unsafe.Pointer(&flat[0]))
+	return int(C.secp256k1_ext_nonce_pool_fill(context, seeddata, C.size_t(len(flat)/32)))
+}
+
+// SignPooled creates a recoverable ECDSA signature like Sign, but consumes a
+// nonce precomputed by PrecomputeNonces instead of deriving one with rfc6979.
+// It fails with ErrSignFailed when the pool is empty. The caller is
+// responsible for seeding the pool with high-entropy material; unlike Sign
+// the produced signatures are not deterministic.
+func SignPooled(msg []byte, seckey []byte) ([]byte, error) {
+	if len(msg) != 32 {
+		return nil, ErrInvalidMsgLen
+	}
+	if len(seckey) != 32 {
+		return nil, ErrInvalidKey
+	}
+	seckeydata := (*C.uchar)(unsafe.Pointer(&seckey[0]))
+	if C.secp256k1_ec_seckey_verify(context, seckeydata) != 1 {
+		return nil, ErrInvalidKey
+	}
+
+	var (
+		msgdata = (*C.uchar)(unsafe.Pointer(&msg[0]))
+		sig     = make([]byte, 65)
+		sigdata = (*C.uchar)(unsafe.Pointer(&sig[0]))
+		recid   C.int
+	)
+	if C.secp256k1_ext_ecdsa_sign_pooled(context, sigdata, &recid, msgdata, seckeydata) == 0 {
+		return nil, ErrSignFailed
+	}
+	sig[64] = byte(recid) // add back recid to get 65 bytes sig
+	return sig, nil
+}
+
 // RecoverPubkey returns the the public key of the signer.
 // msg must be the 32-byte hash of the message to be signed.
 // sig must be a 65-byte compact ECDSA signature containing the
@@ -121,6 +382,710 @@ func RecoverPubkey(msg []byte, sig []byte) ([]byte, error) {
 	return pubkey, nil
 }
 
+// RecoverAddressInput recovers the public key of the signer and returns the
+// raw 64-byte X || Y buffer that address derivation hashes, skipping the
+// uncompressed-key prefix byte and the pubkey marshalling round-trip.
+func RecoverAddressInput(msg []byte, sig []byte) ([]byte, error) {
+	if len(msg) != 32 {
+		return nil, ErrInvalidMsgLen
+	}
+	if err := checkSignature(sig); err != nil {
+		return nil, err
+	}
+
+	var (
+		input   = make([]byte, 64)
+		sigdata = (*C.uchar)(unsafe.Pointer(&sig[0]))
+		msgdata = (*C.uchar)(unsafe.Pointer(&msg[0]))
+	)
+	if C.secp256k1_ext_ecdsa_recover_address_input(context, (*C.uchar)(unsafe.Pointer(&input[0])), sigdata, msgdata) == 0 {
+		return nil, ErrRecoverFailed
+	}
+	return input, nil
+}
+
+// RecoverAddress recovers the 20-byte address of the signer of a signed
+// message, fusing the Keccak-256 of the recovered public key into the
+// recovery call. This avoids the Go-side hasher allocation and pubkey copy
+// that deriving the address from RecoverPubkey would pay per transaction.
+func RecoverAddress(msg []byte, sig []byte) ([]byte, error) {
+	if len(msg) != 32 {
+		return nil, ErrInvalidMsgLen
+	}
+	if err := checkSignature(sig); err != nil {
+		return nil, err
+	}
+
+	var (
+		addr    = make([]byte, 20)
+		sigdata = (*C.uchar)(unsafe.Pointer(&sig[0]))
+		msgdata = (*C.uchar)(unsafe.Pointer(&msg[0]))
+	)
+	if C.secp256k1_ext_ecdsa_recover_address(context, (*C.uchar)(unsafe.Pointer(&addr[0])), sigdata, msgdata) == 0 {
+		return nil, ErrRecoverFailed
+	}
+	return addr, nil
+}
+
+// PrefetchSignatureData hints the native layer that data holds signature
+// material for a batch that will be submitted shortly — typically the
+// transactions region of a block body right after RLP decode, well before
+// sender recovery runs. The native side issues advisory cache prefetches for
+// the region and for the leading verification-table lines, so the later
+// batch starts on warm lines instead of compulsory misses. Purely advisory:
+// hinting for work that never arrives is harmless.
+func PrefetchSignatureData(data []byte) {
+	if len(data) == 0 {
+		return
+	}
+	C.secp256k1_ext_prefetch_sigdata(context,
+		(*C.uchar)(unsafe.Pointer(&data[0])), C.size_t(len(data)))
+}
+
+// batchHeartbeatWord is the address of the native batch heartbeat, captured
+// once at startup so reads never enter cgo.
+var batchHeartbeatWord = (*uint64)(unsafe.Pointer(C.secp256k1_ext_batch_heartbeat()))
+
+// BatchHeartbeat samples the native batch heartbeat. The batch kernels and
+// their worker pool bump the counter while they make progress, so a watchdog
+// comparing successive samples can tell a slow-but-alive batch (counter
+// still moving, e.g. through a page-fault storm) from a genuinely wedged one
+// (counter frozen) instead of going by call duration alone. The read is a
+// plain atomic load with no cgo transition, cheap enough to poll from a
+// supervision loop. The absolute value carries no meaning.
+func BatchHeartbeat() uint64 {
+	return atomic.LoadUint64(batchHeartbeatWord)
+}
+
+// RecoverPubkeyBatch recovers the public keys of a batch of signed messages,
+// paying the cgo transition cost once for the whole batch instead of once per
+// signature. msgs must contain 32-byte message hashes and sigs the matching
+// 65-byte compact signatures. The result holds one public key per input; if
+// any recovery failed, the corresponding entry is nil and ErrRecoverFailed is
+// returned alongside the partial results.
+func RecoverPubkeyBatch(msgs [][]byte, sigs [][]byte) ([][]byte, error) {
+	if len(msgs) != len(sigs) {
+		return nil, ErrInvalidSignatureLen
+	}
+	n := len(msgs)
+	if n == 0 {
+		return nil, nil
+	}
+	for i := 0; i < n; i++ {
+		if len(msgs[i]) != 32 {
+			return nil, ErrInvalidMsgLen
+		}
+		if err := checkSignature(sigs[i]); err != nil {
+			return nil, err
+		}
+	}
+	// Flatten the inputs so the C side can walk them without per-item pointers.
+	var (
+		msgdata = alignedBuffer(n * 32)
+		sigdata = alignedBuffer(n * 65)
+		pubkeys = alignedBuffer(n * 65)
+		results = make([]C.int, n)
+	)
+	for i := 0; i < n; i++ {
+		copy(msgdata[i*32:], msgs[i])
+		copy(sigdata[i*65:], sigs[i])
+	}
+	ok := C.secp256k1_ext_ecdsa_recover_batch(
+		context,
+		(*C.uchar)(unsafe.Pointer(&pubkeys[0])),
+		(*C.uchar)(unsafe.Pointer(&sigdata[0])),
+		(*C.uchar)(unsafe.Pointer(&msgdata[0])),
+		C.size_t(n),
+		&results[0],
+	)
+	out := make([][]byte, n)
+	for i := 0; i < n; i++ {
+		if results[i] != 0 {
+			out[i] = pubkeys[i*65 : (i+1)*65 : (i+1)*65]
+		}
+	}
+	if ok == 0 {
+		return out, ErrRecoverFailed
+	}
+	return out, nil
+}
+
+// RecoverPubkeyAddressBatch recovers the public keys and signer addresses of
+// a batch of signed messages in one cgo call. The native side marshals every
+// output into one contiguous arena of packed status/pubkey/address records
+// (layout in ffi.h) with the address derivation fused into the batch, so the
+// results come back as a single region that is sliced here instead of n
+// scattered pointer writes. The entries of failed recoveries are nil and
+// ErrRecoverFailed is returned alongside the partial results.
+func RecoverPubkeyAddressBatch(msgs [][]byte, sigs [][]byte) ([][]byte, [][]byte, error) {
+	if len(msgs) != len(sigs) {
+		return nil, nil, ErrInvalidSignatureLen
+	}
+	n := len(msgs)
+	if n == 0 {
+		return nil, nil, nil
+	}
+	for i := 0; i < n; i++ {
+		if len(msgs[i]) != 32 {
+			return nil, nil, ErrInvalidMsgLen
+		}
+		if err := checkSignature(sigs[i]); err != nil {
+			return nil, nil, err
+		}
+	}
+	// Flatten the inputs so the C side can walk them without per-item pointers.
+	var (
+		msgdata = alignedBuffer(n * 32)
+		sigdata = alignedBuffer(n * 65)
+		arena   = make([]byte, C.secp256k1_ext_recover_arena_size(C.size_t(n)))
+		stride  = int(C.secp256k1_ext_recover_arena_size(1))
+	)
+	for i := 0; i < n; i++ {
+		copy(msgdata[i*32:], msgs[i])
+		copy(sigdata[i*65:], sigs[i])
+	}
+	ok := C.secp256k1_ext_ecdsa_recover_arena(
+		context,
+		(*C.uchar)(unsafe.Pointer(&arena[0])),
+		(*C.uchar)(unsafe.Pointer(&sigdata[0])),
+		(*C.uchar)(unsafe.Pointer(&msgdata[0])),
+		C.size_t(n),
+	)
+	pubkeys := make([][]byte, n)
+	addrs := make([][]byte, n)
+	for i := 0; i < n; i++ {
+		rec := arena[i*stride : (i+1)*stride : (i+1)*stride]
+		if rec[0] == 1 {
+			pubkeys[i] = rec[1:66:66]
+			addrs[i] = rec[66:86:86]
+		}
+	}
+	if ok == 0 {
+		return pubkeys, addrs, ErrRecoverFailed
+	}
+	return pubkeys, addrs, nil
+}
+
+// ChecksumAddresses renders a batch of 20-byte addresses as EIP-55
+// checksummed "0x"-prefixed hex strings in one native call. The casing
+// pattern of each address costs a Keccak-256 of its own hex form, so a
+// large RPC response rendered one Go-side hasher at a time pays thousands
+// of separate hashes; the native kernel runs them four lanes at a time
+// through the interleaved permutation. Entries that are not 20 bytes long
+// come back as empty strings.
+func ChecksumAddresses(addrs [][]byte) []string {
+	n := len(addrs)
+	if n == 0 {
+		return nil
+	}
+	addrdata := alignedBuffer(n * 20)
+	for i := 0; i < n; i++ {
+		if len(addrs[i]) == 20 {
+			copy(addrdata[i*20:], addrs[i])
+		}
+	}
+	hexdata := make([]byte, n*C.SECP256K1_FFI_ADDRESS_HEX_SIZE)
+	C.secp256k1_ffi_checksum_addresses(
+		(*C.uint8_t)(unsafe.Pointer(&addrdata[0])),
+		C.size_t(n),
+		(*C.char)(unsafe.Pointer(&hexdata[0])),
+	)
+	stride := int(C.SECP256K1_FFI_ADDRESS_HEX_SIZE)
+	out := make([]string, n)
+	for i := 0; i < n; i++ {
+		if len(addrs[i]) == 20 {
+			out[i] = string(hexdata[i*stride : (i+1)*stride])
+		}
+	}
+	return out
+}
+
+// VerifyRecover runs the recovery kernel once for either call shape of the
+// RPC layer. With a nil pubkey it recovers and returns the signer's 65-byte
+// public key like RecoverPubkey. With a known pubkey it checks the signature
+// against it, comparing the recovered point natively instead of paying the
+// serialization and Go-side comparison of a recover-then-compare round-trip,
+// and returns the key on success.
+func VerifyRecover(msg []byte, sig []byte, pubkey []byte) ([]byte, error) {
+	if len(msg) != 32 {
+		return nil, ErrInvalidMsgLen
+	}
+	if err := checkSignature(sig); err != nil {
+		return nil, err
+	}
+	var (
+		sigdata = (*C.uchar)(unsafe.Pointer(&sig[0]))
+		msgdata = (*C.uchar)(unsafe.Pointer(&msg[0]))
+	)
+	if pubkey != nil {
+		keydata := (*C.uchar)(unsafe.Pointer(&pubkey[0]))
+		if C.secp256k1_ext_ecdsa_verify_recover(context, nil, nil, sigdata, msgdata, keydata, C.size_t(len(pubkey))) == 0 {
+			return nil, ErrRecoverFailed
+		}
+		return pubkey, nil
+	}
+	out := make([]byte, 65)
+	if C.secp256k1_ext_ecdsa_verify_recover(context, nil, (*C.uchar)(unsafe.Pointer(&out[0])), sigdata, msgdata, nil, 0) == 0 {
+		return nil, ErrRecoverFailed
+	}
+	return out, nil
+}
+
+// VerifyRecoverBatch processes a mixed batch of signed messages in one cgo
+// call. Every signature runs the recovery kernel once; entries with a known
+// 65-byte uncompressed public key are checked against it right after the
+// shared multiplication, entries with a nil key have their signer recovered.
+// pubkeys may be nil to recover every entry. The result holds the expected or
+// recovered key of every entry that checked out; if any entry failed, the
+// corresponding entry is nil and ErrRecoverFailed is returned alongside the
+// partial results.
+func VerifyRecoverBatch(msgs [][]byte, sigs [][]byte, pubkeys [][]byte) ([][]byte, error) {
+	if len(msgs) != len(sigs) || (pubkeys != nil && len(pubkeys) != len(sigs)) {
+		return nil, ErrInvalidSignatureLen
+	}
+	n := len(msgs)
+	if n == 0 {
+		return nil, nil
+	}
+	for i := 0; i < n; i++ {
+		if len(msgs[i]) != 32 {
+			return nil, ErrInvalidMsgLen
+		}
+		if err := checkSignature(sigs[i]); err != nil {
+			return nil, err
+		}
+		if pubkeys != nil && pubkeys[i] != nil && len(pubkeys[i]) != 65 {
+			return nil, ErrInvalidPubkey
+		}
+	}
+	// Flatten the inputs so the C side can walk them without per-item pointers.
+	// Entries without a known key stay zeroed, which the native side reads as
+	// "recover the signer".
+	var (
+		msgdata = alignedBuffer(n * 32)
+		sigdata = alignedBuffer(n * 65)
+		keydata = alignedBuffer(n * 65)
+		out     = alignedBuffer(n * 65)
+		results = make([]C.int, n)
+	)
+	for i := 0; i < n; i++ {
+		copy(msgdata[i*32:], msgs[i])
+		copy(sigdata[i*65:], sigs[i])
+		if pubkeys != nil && pubkeys[i] != nil {
+			copy(keydata[i*65:], pubkeys[i])
+		}
+	}
+	ok := C.secp256k1_ext_ecdsa_verify_recover_batch(
+		context,
+		(*C.uchar)(unsafe.Pointer(&out[0])),
+		(*C.uchar)(unsafe.Pointer(&sigdata[0])),
+		(*C.uchar)(unsafe.Pointer(&msgdata[0])),
+		(*C.uchar)(unsafe.Pointer(&keydata[0])),
+		C.size_t(n),
+		&results[0],
+	)
+	keys := make([][]byte, n)
+	for i := 0; i < n; i++ {
+		if results[i] != 0 {
+			keys[i] = out[i*65 : (i+1)*65 : (i+1)*65]
+		}
+	}
+	if ok == 0 {
+		return keys, ErrRecoverFailed
+	}
+	return keys, nil
+}
+
+// A Job is an in-flight asynchronous operation on the native worker pool.
+// Submission copies its inputs and returns immediately, so the caller can
+// keep decoding while the pool works; the result is collected with Wait or
+// WaitVerified, which must be called exactly once.
+type Job struct {
+	ptr *C.secp256k1_ext_job
+	out []byte
+}
+
+// RecoverPubkeyAsync submits the recovery of a signed message to the native
+// worker pool and returns without blocking. msg and sig may be reused as soon
+// as the call returns; the recovered key is collected with Wait.
+func RecoverPubkeyAsync(msg []byte, sig []byte) (*Job, error) {
+	if len(msg) != 32 {
+		return nil, ErrInvalidMsgLen
+	}
+	if err := checkSignature(sig); err != nil {
+		return nil, err
+	}
+	sigdata := (*C.uchar)(unsafe.Pointer(&sig[0]))
+	msgdata := (*C.uchar)(unsafe.Pointer(&msg[0]))
+	return &Job{
+		ptr: C.secp256k1_ext_job_submit_recover(context, sigdata, msgdata),
+		out: make([]byte, 65),
+	}, nil
+}
+
+// VerifySignatureAsync submits a [R || S] signature check to the native
+// worker pool and returns without blocking. The outcome is collected with
+// WaitVerified.
+func VerifySignatureAsync(pubkey, msg, signature []byte) (*Job, error) {
+	if len(msg) != 32 || len(signature) != 64 || len(pubkey) == 0 {
+		return nil, ErrInvalidSignatureLen
+	}
+	sigdata := (*C.uchar)(unsafe.Pointer(&signature[0]))
+	msgdata := (*C.uchar)(unsafe.Pointer(&msg[0]))
+	keydata := (*C.uchar)(unsafe.Pointer(&pubkey[0]))
+	return &Job{
+		ptr: C.secp256k1_ext_job_submit_verify(context, sigdata, msgdata, keydata, C.size_t(len(pubkey))),
+	}, nil
+}
+
+// Wait blocks until the job completes and returns its output, the recovered
+// 65-byte public key for recovery jobs. It releases the native job; waiting
+// on a job twice returns an error.
+func (j *Job) Wait() ([]byte, error) {
+	if j.ptr == nil {
+		return nil, ErrRecoverFailed
+	}
+	var outdata *C.uchar
+	if j.out != nil {
+		outdata = (*C.uchar)(unsafe.Pointer(&j.out[0]))
+	}
+	ok := C.secp256k1_ext_job_wait(j.ptr, outdata)
+	j.ptr = nil
+	if ok == 0 {
+		return nil, ErrRecoverFailed
+	}
+	return j.out, nil
+}
+
+// WaitVerified blocks until a verification job completes and reports whether
+// the signature verified. It releases the native job.
+func (j *Job) WaitVerified() bool {
+	if j.ptr == nil {
+		return false
+	}
+	ok := C.secp256k1_ext_job_wait(j.ptr, nil)
+	j.ptr = nil
+	return ok != 0
+}
+
+// A Stream is a batch of recoveries on the native worker pool whose results
+// are delivered in completion order rather than submission order: the pool
+// posts each result to a lock-free queue as it finishes, so the caller can
+// start processing early completions while stragglers still verify. A stream
+// has a single consumer; Next, Poll and Close must not be called concurrently.
+type Stream struct {
+	ptr       *C.secp256k1_ext_stream
+	n         int
+	delivered int
+	verify    bool // Verification stream: no key output, failures are ErrVerifyFailed
+}
+
+// RecoverPubkeyBatchStream submits the recovery of a batch of signed messages
+// to the native worker pool and returns without blocking. msgs must contain
+// 32-byte message hashes and sigs the matching 65-byte compact signatures;
+// both may be reused as soon as the call returns. Results are collected with
+// Next or Poll and the stream must be released with Close.
+func RecoverPubkeyBatchStream(msgs [][]byte, sigs [][]byte) (*Stream, error) {
+	if len(msgs) != len(sigs) {
+		return nil, ErrInvalidSignatureLen
+	}
+	n := len(msgs)
+	for i := 0; i < n; i++ {
+		if len(msgs[i]) != 32 {
+			return nil, ErrInvalidMsgLen
+		}
+		if err := checkSignature(sigs[i]); err != nil {
+			return nil, err
+		}
+	}
+	if n == 0 {
+		return &Stream{}, nil
+	}
+	s := &Stream{ptr: C.secp256k1_ext_stream_create(context, C.size_t(n)), n: n}
+	for i := 0; i < n; i++ {
+		sigdata := (*C.uchar)(unsafe.Pointer(&sigs[i][0]))
+		msgdata := (*C.uchar)(unsafe.Pointer(&msgs[i][0]))
+		C.secp256k1_ext_stream_submit_recover(s.ptr, context, sigdata, msgdata)
+	}
+	return s, nil
+}
+
+// VerifySignatureBatchStream submits the verification of a batch of [R || S]
+// signatures to the native worker pool and returns without blocking, so an
+// invalid signature can be acted on the moment it fails instead of after the
+// slowest entry of the batch. The inputs may be reused as soon as the call
+// returns. Results are collected with Next or Poll — a nil error means the
+// entry verified — and the stream must be released with Close.
+func VerifySignatureBatchStream(pubkeys, msgs, signatures [][]byte) (*Stream, error) {
+	n := len(signatures)
+	if len(pubkeys) != n || len(msgs) != n {
+		return nil, ErrInvalidSignatureLen
+	}
+	for i := 0; i < n; i++ {
+		if len(msgs[i]) != 32 {
+			return nil, ErrInvalidMsgLen
+		}
+		if len(signatures[i]) != 64 {
+			return nil, ErrInvalidSignatureLen
+		}
+		if len(pubkeys[i]) == 0 {
+			return nil, ErrInvalidPubkey
+		}
+	}
+	if n == 0 {
+		return &Stream{verify: true}, nil
+	}
+	s := &Stream{ptr: C.secp256k1_ext_stream_create(context, C.size_t(n)), n: n, verify: true}
+	for i := 0; i < n; i++ {
+		sigdata := (*C.uchar)(unsafe.Pointer(&signatures[i][0]))
+		msgdata := (*C.uchar)(unsafe.Pointer(&msgs[i][0]))
+		keydata := (*C.uchar)(unsafe.Pointer(&pubkeys[i][0]))
+		C.secp256k1_ext_stream_submit_verify(s.ptr, context, sigdata, msgdata, keydata, C.size_t(len(pubkeys[i])))
+	}
+	return s, nil
+}
+
+// Next blocks until another entry of the batch completes and returns its
+// submission index along with the recovered 65-byte public key, or
+// ErrRecoverFailed if that recovery failed. On verification streams the key
+// is always nil and a failed entry reports ErrVerifyFailed. Once every entry
+// has been delivered, it returns index -1 and no error.
+func (s *Stream) Next() (int, []byte, error) {
+	return s.collect(true)
+}
+
+// Poll is Next without blocking: it returns index -1 and no error when no
+// further entry has completed yet.
+func (s *Stream) Poll() (int, []byte, error) {
+	return s.collect(false)
+}
+
+func (s *Stream) collect(block bool) (int, []byte, error) {
+	if s.ptr == nil {
+		return -1, nil, nil
+	}
+	blocking := C.int(0)
+	if block {
+		blocking = 1
+	}
+	index := C.secp256k1_ext_stream_next(s.ptr, blocking)
+	if index < 0 {
+		return -1, nil, nil
+	}
+	s.delivered++
+	if s.verify {
+		if C.secp256k1_ext_stream_result(s.ptr, C.size_t(index), nil) == 0 {
+			return int(index), nil, ErrVerifyFailed
+		}
+		return int(index), nil, nil
+	}
+	out := make([]byte, 65)
+	ok := C.secp256k1_ext_stream_result(s.ptr, C.size_t(index), (*C.uchar)(unsafe.Pointer(&out[0])))
+	if ok == 0 {
+		return int(index), nil, ErrRecoverFailed
+	}
+	return int(index), out, nil
+}
+
+// Close releases the native stream. Undelivered entries may still be running
+// on the pool, so Close drains them first; their results are discarded. The
+// stream must not be used afterwards.
+func (s *Stream) Close() {
+	if s.ptr == nil {
+		return
+	}
+	for s.delivered < s.n {
+		if C.secp256k1_ext_stream_next(s.ptr, 1) < 0 {
+			break
+		}
+		s.delivered++
+	}
+	C.secp256k1_ext_stream_destroy(s.ptr)
+	s.ptr = nil
+}
+
+// PrescreenSignature cheaply rejects a 65-byte compact signature that full
+// parsing would reject anyway: r or s zero or not below the group order, or
+// an invalid recovery id. It touches no context or tables, so ingress paths
+// can discard malformed input before queuing real recovery work. A passing
+// signature is not necessarily valid.
+func PrescreenSignature(sig []byte) bool {
+	if len(sig) != 65 {
+		return false
+	}
+	return C.secp256k1_ext_sig_prescreen((*C.uchar)(unsafe.Pointer(&sig[0]))) != 0
+}
+
+// PrescreenSignatureBatch prescreens a batch of 65-byte compact signatures in
+// a single cgo call, returning the per-signature outcome and the number that
+// passed. Signatures of the wrong length fail their slot.
+func PrescreenSignatureBatch(sigs [][]byte) ([]bool, int) {
+	n := len(sigs)
+	if n == 0 {
+		return nil, 0
+	}
+	var (
+		sigdata = alignedBuffer(n * 65)
+		results = make([]C.int, n)
+		out     = make([]bool, n)
+	)
+	for i := 0; i < n; i++ {
+		if len(sigs[i]) == 65 {
+			copy(sigdata[i*65:], sigs[i])
+		} // a zeroed slot fails the r/s range check
+	}
+	passed := C.secp256k1_ext_sig_prescreen_batch(
+		(*C.uchar)(unsafe.Pointer(&sigdata[0])),
+		C.size_t(n),
+		&results[0],
+	)
+	for i := 0; i < n; i++ {
+		out[i] = results[i] != 0
+	}
+	return out, int(passed)
+}
+
+// ValidateSignature checks the consensus encoding rules of a 65-byte
+// [R || S || V] signature natively: r and s in range, v 0 or 1 and, when
+// homestead is set, s in the canonical low half of the group. The half-order
+// comparison rides the same masked byte pass as the range checks, replacing a
+// big.Int comparison and its allocations per transaction. A true result says
+// nothing about whether the signature verifies.
+func ValidateSignature(sig []byte, homestead bool) bool {
+	if len(sig) != 65 {
+		return false
+	}
+	hs := C.int(0)
+	if homestead {
+		hs = 1
+	}
+	return C.secp256k1_ext_sig_validate((*C.uchar)(unsafe.Pointer(&sig[0])), hs) != 0
+}
+
+// ValidateSignatureBatch checks the consensus encoding rules of a batch of
+// 65-byte [R || S || V] signatures in a single cgo call, returning the
+// per-signature outcome and the number that passed. Signatures of the wrong
+// length fail their slot.
+func ValidateSignatureBatch(sigs [][]byte, homestead bool) ([]bool, int) {
+	n := len(sigs)
+	if n == 0 {
+		return nil, 0
+	}
+	var (
+		sigdata = alignedBuffer(n * 65)
+		results = make([]C.int, n)
+		out     = make([]bool, n)
+	)
+	for i := 0; i < n; i++ {
+		if len(sigs[i]) == 65 {
+			copy(sigdata[i*65:], sigs[i])
+		} // a zeroed slot fails the r/s range check
+	}
+	hs := C.int(0)
+	if homestead {
+		hs = 1
+	}
+	passed := C.secp256k1_ext_sig_validate_batch(
+		(*C.uchar)(unsafe.Pointer(&sigdata[0])),
+		C.size_t(n),
+		hs,
+		&results[0],
+	)
+	for i := 0; i < n; i++ {
+		out[i] = results[i] != 0
+	}
+	return out, int(passed)
+}
+
+// DERToCompactBatch transcodes a batch of canonical DER signatures into
+// 64-byte [R || S] compact form in a single cgo call. The native kernel
+// streams between the encodings at the byte level — no per-entry signature
+// object — and enforces strict DER and the scalar range in the same pass.
+// The result holds one compact signature per input; entries that were not
+// canonical DER are nil. ok reports whether the whole batch transcoded.
+func DERToCompactBatch(ders [][]byte) (out [][]byte, ok bool) {
+	n := len(ders)
+	if n == 0 {
+		return nil, true
+	}
+	total := 0
+	for i := 0; i < n; i++ {
+		total += len(ders[i])
+	}
+	if total == 0 {
+		return make([][]byte, n), false
+	}
+	// Pack the variable-length inputs with an offsets array; fixed strides
+	// do not fit DER.
+	var (
+		derdata = alignedBuffer(total)
+		offsets = make([]C.uint32_t, n+1)
+		outdata = alignedBuffer(n * 64)
+		results = make([]C.int, n)
+		at      = 0
+	)
+	for i := 0; i < n; i++ {
+		copy(derdata[at:], ders[i])
+		at += len(ders[i])
+		offsets[i+1] = C.uint32_t(at)
+	}
+	passed := C.secp256k1_ext_der_to_compact_batch(
+		(*C.uchar)(unsafe.Pointer(&outdata[0])),
+		(*C.uchar)(unsafe.Pointer(&derdata[0])),
+		&offsets[0],
+		C.size_t(n),
+		&results[0],
+	)
+	out = make([][]byte, n)
+	for i := 0; i < n; i++ {
+		if results[i] != 0 {
+			out[i] = outdata[i*64 : (i+1)*64 : (i+1)*64]
+		}
+	}
+	return out, int(passed) == n
+}
+
+// CompactToDERBatch transcodes a batch of 64-byte [R || S] compact
+// signatures into canonical DER in a single cgo call, the inverse of
+// DERToCompactBatch. Entries whose components are not below the group order
+// (or of the wrong length) are nil. ok reports whether the whole batch
+// transcoded.
+func CompactToDERBatch(sigs [][]byte) (out [][]byte, ok bool) {
+	n := len(sigs)
+	if n == 0 {
+		return nil, true
+	}
+	const derMax = 72 // SECP256K1_FFI_DER_MAX
+	var (
+		sigdata = alignedBuffer(n * 64)
+		derdata = alignedBuffer(n * derMax)
+		offsets = make([]C.uint32_t, n+1)
+		results = make([]C.int, n)
+		short   = false
+	)
+	for i := 0; i < n; i++ {
+		if len(sigs[i]) == 64 {
+			copy(sigdata[i*64:], sigs[i])
+		} else {
+			short = true // a zeroed slot still transcodes; fail it below
+		}
+	}
+	passed := C.secp256k1_ext_compact_to_der_batch(
+		(*C.uchar)(unsafe.Pointer(&derdata[0])),
+		&offsets[0],
+		(*C.uchar)(unsafe.Pointer(&sigdata[0])),
+		C.size_t(n),
+		&results[0],
+	)
+	out = make([][]byte, n)
+	for i := 0; i < n; i++ {
+		if results[i] != 0 && len(sigs[i]) == 64 {
+			out[i] = derdata[offsets[i]:offsets[i+1]:offsets[i+1]]
+		}
+	}
+	return out, int(passed) == n && !short
+}
+
 // VerifySignature checks that the given pubkey created signature over message.
 // The signature should be in [R || S] format.
 func VerifySignature(pubkey, msg, signature []byte) bool {
@@ -133,6 +1098,193 @@ func VerifySignature(pubkey, msg, signature []byte) bool {
 	return C.secp256k1_ext_ecdsa_verify(context, sigdata, msgdata, keydata, C.size_t(len(pubkey))) != 0
 }
 
+// VerifySignatureBatch checks a batch of [R || S] signatures over their
+// messages in a single cgo call, sharding the work across the native worker
+// pool. All public keys must share one serialization length. It returns the
+// per-signature outcome and whether the whole batch verified.
+func VerifySignatureBatch(pubkeys, msgs, signatures [][]byte) ([]bool, bool) {
+	n := len(signatures)
+	if len(pubkeys) != n || len(msgs) != n {
+		return nil, false
+	}
+	if n == 0 {
+		return nil, true
+	}
+	keylen := len(pubkeys[0])
+	for i := 0; i < n; i++ {
+		if len(msgs[i]) != 32 || len(signatures[i]) != 64 || len(pubkeys[i]) != keylen || keylen == 0 {
+			return nil, false
+		}
+	}
+	var (
+		sigdata = alignedBuffer(n * 64)
+		msgdata = alignedBuffer(n * 32)
+		keydata = alignedBuffer(n * keylen)
+		results = make([]C.int, n)
+	)
+	for i := 0; i < n; i++ {
+		copy(sigdata[i*64:], signatures[i])
+		copy(msgdata[i*32:], msgs[i])
+		copy(keydata[i*keylen:], pubkeys[i])
+	}
+	ok := C.secp256k1_ext_ecdsa_verify_batch_parallel(
+		context,
+		(*C.uchar)(unsafe.Pointer(&sigdata[0])),
+		(*C.uchar)(unsafe.Pointer(&msgdata[0])),
+		(*C.uchar)(unsafe.Pointer(&keydata[0])),
+		C.size_t(keylen),
+		C.size_t(n),
+		&results[0],
+	)
+	out := make([]bool, n)
+	for i := 0; i < n; i++ {
+		out[i] = results[i] != 0
+	}
+	return out, ok != 0
+}
+
+// SchnorrSign creates a 64-byte [R.x || S] Schnorr signature of msg.
+//
+// The caller is responsible for ensuring that msg cannot be chosen
+// directly by an attacker. It is usually preferable to use a cryptographic
+// hash function on any input before handing it to this function.
+func SchnorrSign(msg []byte, seckey []byte) ([]byte, error) {
+	if len(msg) != 32 {
+		return nil, ErrInvalidMsgLen
+	}
+	if len(seckey) != 32 {
+		return nil, ErrInvalidKey
+	}
+	seckeydata := (*C.uchar)(unsafe.Pointer(&seckey[0]))
+	if C.secp256k1_ec_seckey_verify(context, seckeydata) != 1 {
+		return nil, ErrInvalidKey
+	}
+
+	var (
+		sig     = make([]byte, 64)
+		sigdata = (*C.uchar)(unsafe.Pointer(&sig[0]))
+		msgdata = (*C.uchar)(unsafe.Pointer(&msg[0]))
+	)
+	if C.secp256k1_schnorr_sign(context, sigdata, msgdata, seckeydata, nil, nil) == 0 {
+		return nil, ErrSignFailed
+	}
+	return sig, nil
+}
+
+// SchnorrVerify checks that the given Schnorr signature is valid for the
+// given message and public key.
+func SchnorrVerify(pubkey, msg, signature []byte) bool {
+	if len(msg) != 32 || len(signature) != 64 || len(pubkey) == 0 {
+		return false
+	}
+	var (
+		pubkeystruct C.secp256k1_pubkey
+		sigdata      = (*C.uchar)(unsafe.Pointer(&signature[0]))
+		msgdata      = (*C.uchar)(unsafe.Pointer(&msg[0]))
+		keydata      = (*C.uchar)(unsafe.Pointer(&pubkey[0]))
+	)
+	if C.secp256k1_ec_pubkey_parse(context, &pubkeystruct, keydata, C.size_t(len(pubkey))) == 0 {
+		return false
+	}
+	return C.secp256k1_schnorr_verify(context, sigdata, msgdata, &pubkeystruct) != 0
+}
+
+// SchnorrVerifyBatch checks a batch of 64-byte Schnorr signatures over their
+// messages in a single cgo call. The whole batch is verified as one random
+// linear combination evaluated with a single multi-scalar multiplication, so
+// the amortized per-signature cost approaches one group addition; only when
+// the combination rejects are the signatures re-verified individually to fill
+// in the per-signature outcome. All public keys must share one serialization
+// length. It returns the per-signature outcome and whether the whole batch
+// verified.
+func SchnorrVerifyBatch(pubkeys, msgs, signatures [][]byte) ([]bool, bool) {
+	n := len(signatures)
+	if len(pubkeys) != n || len(msgs) != n {
+		return nil, false
+	}
+	if n == 0 {
+		return nil, true
+	}
+	keylen := len(pubkeys[0])
+	for i := 0; i < n; i++ {
+		if len(msgs[i]) != 32 || len(signatures[i]) != 64 || len(pubkeys[i]) != keylen || keylen == 0 {
+			return nil, false
+		}
+	}
+	var (
+		sigdata = alignedBuffer(n * 64)
+		msgdata = alignedBuffer(n * 32)
+		keydata = alignedBuffer(n * keylen)
+		results = make([]C.int, n)
+	)
+	for i := 0; i < n; i++ {
+		copy(sigdata[i*64:], signatures[i])
+		copy(msgdata[i*32:], msgs[i])
+		copy(keydata[i*keylen:], pubkeys[i])
+	}
+	ok := C.secp256k1_ext_schnorr_verify_batch(
+		context,
+		(*C.uchar)(unsafe.Pointer(&sigdata[0])),
+		(*C.uchar)(unsafe.Pointer(&msgdata[0])),
+		(*C.uchar)(unsafe.Pointer(&keydata[0])),
+		C.size_t(keylen),
+		C.size_t(n),
+		&results[0],
+	)
+	out := make([]bool, n)
+	for i := 0; i < n; i++ {
+		out[i] = results[i] != 0
+	}
+	return out, ok != 0
+}
+
+// MultiScalarMult computes sum(scalars[i] * points[i]) + gscalar*G in a single
+// Strauss-Shamir pass, the primitive behind random-linear-combination batch
+// verification. Points are encoded as two 256bit big-endian numbers, scalars
+// as 32-byte big-endian numbers; gscalar may be nil. The doublings of the
+// multiplication loop are shared across all points, so the per-point cost
+// shrinks as the batch grows. It runs in variable time and must only be used
+// on public inputs.
+func MultiScalarMult(points, scalars [][]byte, gscalar []byte) ([]byte, error) {
+	n := len(points)
+	if len(scalars) != n {
+		return nil, ErrInvalidKey
+	}
+	if gscalar != nil && len(gscalar) != 32 {
+		return nil, ErrInvalidKey
+	}
+	if n == 0 && gscalar == nil {
+		return nil, ErrInvalidKey
+	}
+	var (
+		ptdata = make([]byte, n*64+1) // one spare byte so &ptdata[0] exists for n == 0
+		scdata = make([]byte, n*32+1)
+		out    = make([]byte, 64)
+	)
+	for i := 0; i < n; i++ {
+		if len(points[i]) != 64 || len(scalars[i]) != 32 {
+			return nil, ErrInvalidKey
+		}
+		copy(ptdata[i*64:], points[i])
+		copy(scdata[i*32:], scalars[i])
+	}
+	var gdata *C.uchar
+	if gscalar != nil {
+		gdata = (*C.uchar)(unsafe.Pointer(&gscalar[0]))
+	}
+	if C.secp256k1_ext_ecmult_multi(
+		context,
+		(*C.uchar)(unsafe.Pointer(&out[0])),
+		(*C.uchar)(unsafe.Pointer(&ptdata[0])),
+		(*C.uchar)(unsafe.Pointer(&scdata[0])),
+		gdata,
+		C.size_t(n),
+	) == 0 {
+		return nil, ErrInvalidKey
+	}
+	return out, nil
+}
+
 // DecompressPubkey parses a public key in the 33-byte compressed format.
 // It returns non-nil coordinates if the public key is valid.
 func DecompressPubkey(pubkey []byte) (x, y *big.Int) {
@@ -152,6 +1304,43 @@ func DecompressPubkey(pubkey []byte) (x, y *big.Int) {
 	return new(big.Int).SetBytes(out[1:33]), new(big.Int).SetBytes(out[33:])
 }
 
+// DecompressPubkeyBatch parses a batch of 33-byte compressed public keys in
+// one cgo call; the square roots that dominate decompression run four lanes
+// at a time natively. The result holds one 65-byte uncompressed key per
+// input; entries whose key was invalid are nil, and ok reports whether the
+// whole batch parsed.
+func DecompressPubkeyBatch(pubkeys [][]byte) (out [][]byte, ok bool) {
+	n := len(pubkeys)
+	if n == 0 {
+		return nil, true
+	}
+	keydata := alignedBuffer(n * 33)
+	for i := 0; i < n; i++ {
+		if len(pubkeys[i]) != 33 {
+			return nil, false
+		}
+		copy(keydata[i*33:], pubkeys[i])
+	}
+	var (
+		outdata = alignedBuffer(n * 65)
+		results = make([]C.int, n)
+	)
+	all := C.secp256k1_ext_pubkey_decompress_batch(
+		context,
+		(*C.uchar)(unsafe.Pointer(&outdata[0])),
+		(*C.uchar)(unsafe.Pointer(&keydata[0])),
+		C.size_t(n),
+		&results[0],
+	)
+	out = make([][]byte, n)
+	for i := 0; i < n; i++ {
+		if results[i] != 0 {
+			out[i] = outdata[i*65 : (i+1)*65 : (i+1)*65]
+		}
+	}
+	return out, all != 0
+}
+
 // CompressPubkey encodes a public key to 33-byte compressed format.
 func CompressPubkey(x, y *big.Int) []byte {
 	var (
@@ -168,6 +1357,20 @@ func CompressPubkey(x, y *big.Int) []byte {
 	return out
 }
 
+// alignedBuffer returns a zeroed size-byte slice whose backing array starts
+// on a 64-byte boundary and is padded to a multiple of 64 bytes, the
+// aligned-buffer contract of the flat FFI layer (ffi.h). Batch submissions
+// built in such buffers let the native deserializers use aligned vector
+// loads over the flat arrays; the cost per entry is tiny but multiplies by
+// millions of signatures.
+func alignedBuffer(size int) []byte {
+	const align = C.SECP256K1_FFI_BUF_ALIGN
+	padded := (size + align - 1) &^ (align - 1)
+	raw := make([]byte, padded+align-1)
+	off := (align - int(uintptr(unsafe.Pointer(&raw[0]))&(align-1))) & (align - 1)
+	return raw[off : off+size : off+padded]
+}
+
 func checkSignature(sig []byte) error {
 	if len(sig) != 65 {
 		return ErrInvalidSignatureLen
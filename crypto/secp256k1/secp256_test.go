@@ -22,7 +22,14 @@ import (
 	"crypto/elliptic"
 	"crypto/rand"
 	"encoding/hex"
+	"io/ioutil"
+	"math/big"
+	"os"
+	"path/filepath"
+	"strings"
 	"testing"
+	"time"
+	"unsafe"
 
 	"github.com/ethereumai/go-ethereumai/common/math"
 	"github.com/ethereumai/go-ethereumai/crypto/randentropy"
@@ -95,6 +102,421 @@ func TestInvalidRecoveryID(t *testing.T) {
 	}
 }
 
+func TestPrescreenSignature(t *testing.T) {
+	_, seckey := generateKeyPair()
+	msg := randentropy.GetEntropyCSPRNG(32)
+	sig, err := Sign(msg, seckey)
+	if err != nil {
+		t.Fatalf("signature error: %s", err)
+	}
+	if !PrescreenSignature(sig) {
+		t.Errorf("valid signature rejected by prescreen")
+	}
+	// The group order n, big endian.
+	order := []byte{
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe,
+		0xba, 0xae, 0xdc, 0xe6, 0xaf, 0x48, 0xa0, 0x3b,
+		0xbf, 0xd2, 0x5e, 0x8c, 0xd0, 0x36, 0x41, 0x41,
+	}
+	bad := make([][]byte, 0)
+	for _, mutate := range []func(s []byte){
+		func(s []byte) { copy(s[:32], make([]byte, 32)) },   // r = 0
+		func(s []byte) { copy(s[32:64], make([]byte, 32)) }, // s = 0
+		func(s []byte) { copy(s[:32], order) },              // r = n
+		func(s []byte) { copy(s[32:64], order) },            // s = n
+		func(s []byte) {
+			for i := 0; i < 64; i++ {
+				s[i] = 0xff // r and s far above n
+			}
+		},
+		func(s []byte) { s[64] = 4 }, // invalid recovery id
+	} {
+		mutated := make([]byte, 65)
+		copy(mutated, sig)
+		mutate(mutated)
+		if PrescreenSignature(mutated) {
+			t.Errorf("malformed signature passed prescreen: %x", mutated)
+		}
+		bad = append(bad, mutated)
+	}
+	// n-1 is in range for both scalars, whether or not it verifies.
+	edge := make([]byte, 65)
+	copy(edge[:32], order)
+	copy(edge[32:64], order)
+	edge[31]--
+	edge[63]--
+	if !PrescreenSignature(edge) {
+		t.Errorf("in-range signature rejected by prescreen")
+	}
+	if PrescreenSignature(sig[:64]) {
+		t.Errorf("truncated signature passed prescreen")
+	}
+
+	batch := append([][]byte{sig, edge}, bad...)
+	results, passed := PrescreenSignatureBatch(batch)
+	if passed != 2 {
+		t.Errorf("batch pass count mismatch: want: 2 have: %d", passed)
+	}
+	for i, res := range results {
+		if res != (i < 2) {
+			t.Errorf("batch prescreen mismatch at %d: want: %t have: %t", i, i < 2, res)
+		}
+	}
+}
+
+func TestValidateSignature(t *testing.T) {
+	_, seckey := generateKeyPair()
+	msg := randentropy.GetEntropyCSPRNG(32)
+	sig, err := Sign(msg, seckey)
+	if err != nil {
+		t.Fatalf("signature error: %s", err)
+	}
+	// Sign produces canonical low-S signatures, valid under both rule sets.
+	if !ValidateSignature(sig, false) || !ValidateSignature(sig, true) {
+		t.Errorf("valid signature rejected")
+	}
+	// The high-S twin n-s is only acceptable before homestead.
+	highS := make([]byte, 65)
+	copy(highS, sig)
+	s := new(big.Int).SetBytes(sig[32:64])
+	s.Sub(S256().Params().N, s)
+	s.FillBytes(highS[32:64])
+	if !ValidateSignature(highS, false) {
+		t.Errorf("high-S signature rejected under frontier rules")
+	}
+	if ValidateSignature(highS, true) {
+		t.Errorf("high-S signature accepted under homestead rules")
+	}
+	// s == n/2 exactly is still low.
+	halfS := make([]byte, 65)
+	copy(halfS, sig)
+	new(big.Int).Rsh(S256().Params().N, 1).FillBytes(halfS[32:64])
+	if !ValidateSignature(halfS, true) {
+		t.Errorf("half-order S rejected under homestead rules")
+	}
+	// Zero scalars and recovery ids above 1 fail both rule sets.
+	zeroS := make([]byte, 65)
+	copy(zeroS, sig)
+	copy(zeroS[32:64], make([]byte, 32))
+	badV := make([]byte, 65)
+	copy(badV, sig)
+	badV[64] = 2
+	for _, bad := range [][]byte{zeroS, badV, sig[:64]} {
+		if ValidateSignature(bad, false) || ValidateSignature(bad, true) {
+			t.Errorf("malformed signature accepted: %x", bad)
+		}
+	}
+
+	results, passed := ValidateSignatureBatch([][]byte{sig, highS, zeroS, badV}, true)
+	if passed != 1 {
+		t.Errorf("batch pass count mismatch: want: 1 have: %d", passed)
+	}
+	for i, res := range results {
+		if res != (i == 0) {
+			t.Errorf("batch validate mismatch at %d: want: %t have: %t", i, i == 0, res)
+		}
+	}
+}
+
+func TestEnableNUMA(t *testing.T) {
+	// On single-node hardware this must report zero replicas and leave the
+	// pools fully functional; on multi-node hardware the batch below runs
+	// against the per-node replicas.
+	nodes := EnableNUMA()
+	if nodes < 0 {
+		t.Fatalf("negative replica count: %d", nodes)
+	}
+	pubkey, seckey := generateKeyPair()
+	msg := randentropy.GetEntropyCSPRNG(32)
+	sig, err := Sign(msg, seckey)
+	if err != nil {
+		t.Fatalf("signature error: %s", err)
+	}
+	results, ok := VerifySignatureBatch(
+		[][]byte{pubkey, pubkey}, [][]byte{msg, msg}, [][]byte{sig[:64], sig[:64]})
+	if !ok || !results[0] || !results[1] {
+		t.Error("batch verification failed after EnableNUMA")
+	}
+}
+
+func TestRefreshBlinding(t *testing.T) {
+	pubkey, seckey := generateKeyPair()
+	msg := randentropy.GetEntropyCSPRNG(32)
+	seed := randentropy.GetEntropyCSPRNG(32)
+
+	// The first call only schedules background preparation; a later call
+	// swaps the staged pair in.
+	RefreshBlinding(seed)
+	applied := false
+	for i := 0; i < 1000 && !applied; i++ {
+		time.Sleep(time.Millisecond)
+		applied = RefreshBlinding(nil)
+	}
+	if !applied {
+		t.Fatal("prepared blinding pair was never swapped in")
+	}
+
+	// Signing must still round-trip under the fresh blinding.
+	sig, err := Sign(msg, seckey)
+	if err != nil {
+		t.Fatalf("signature error: %s", err)
+	}
+	recovered, err := RecoverPubkey(msg, sig)
+	if err != nil {
+		t.Fatalf("recover error: %s", err)
+	}
+	if !bytes.Equal(recovered, pubkey) {
+		t.Errorf("pubkey mismatch: want: %x have: %x", pubkey, recovered)
+	}
+}
+
+func TestContextStats(t *testing.T) {
+	const batch = 4
+	_, seckey := generateKeyPair()
+	msg := randentropy.GetEntropyCSPRNG(32)
+
+	ResetStats()
+	sig, err := Sign(msg, seckey)
+	if err != nil {
+		t.Fatalf("sign error: %s", err)
+	}
+	if _, err := RecoverPubkey(msg, sig); err != nil {
+		t.Fatalf("recover error: %s", err)
+	}
+	msgs := make([][]byte, batch)
+	sigs := make([][]byte, batch)
+	for i := range msgs {
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		if sigs[i], err = Sign(msgs[i], seckey); err != nil {
+			t.Fatalf("sign error: %s", err)
+		}
+	}
+	if _, err := RecoverPubkeyBatch(msgs, sigs); err != nil {
+		t.Fatalf("batch recover error: %s", err)
+	}
+
+	stats := Stats()
+	if want := uint64(1 + batch); stats.SignCount != want {
+		t.Errorf("sign count mismatch: want: %d have: %d", want, stats.SignCount)
+	}
+	if want := uint64(1 + batch); stats.RecoverCount != want {
+		t.Errorf("recover count mismatch: want: %d have: %d", want, stats.RecoverCount)
+	}
+	if stats.SignNanos == 0 || stats.RecoverNanos == 0 {
+		t.Errorf("expected non-zero op times, have sign: %d recover: %d", stats.SignNanos, stats.RecoverNanos)
+	}
+	if stats.BatchCalls != 1 || stats.BatchItems != batch {
+		t.Errorf("batch occupancy mismatch: want: 1/%d have: %d/%d", batch, stats.BatchCalls, stats.BatchItems)
+	}
+	var signHist, recoverHist uint64
+	for b := 0; b < StatsBuckets; b++ {
+		signHist += stats.SignHist[b]
+		recoverHist += stats.RecoverHist[b]
+	}
+	if signHist != stats.SignCount || recoverHist != stats.RecoverCount {
+		t.Errorf("histogram sums mismatch counts: sign %d/%d recover %d/%d",
+			signHist, stats.SignCount, recoverHist, stats.RecoverCount)
+	}
+
+	ResetStats()
+	if stats = Stats(); stats != (ContextStats{}) {
+		t.Errorf("expected zeroed stats after reset, have %+v", stats)
+	}
+}
+
+func TestAsyncJobs(t *testing.T) {
+	const jobs = 32
+	var (
+		pubkeys = make([][]byte, jobs)
+		msgs    = make([][]byte, jobs)
+		sigs    = make([][]byte, jobs)
+		handles = make([]*Job, jobs)
+	)
+	for i := 0; i < jobs; i++ {
+		pubkey, seckey := generateKeyPair()
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msgs[i], seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		pubkeys[i], sigs[i] = pubkey, sig
+	}
+	// Recovery jobs all complete with the right key.
+	for i := 0; i < jobs; i++ {
+		handle, err := RecoverPubkeyAsync(msgs[i], sigs[i])
+		if err != nil {
+			t.Fatalf("submit error: %s", err)
+		}
+		handles[i] = handle
+	}
+	for i := 0; i < jobs; i++ {
+		recovered, err := handles[i].Wait()
+		if err != nil {
+			t.Errorf("recover job %d error: %s", i, err)
+		} else if !bytes.Equal(pubkeys[i], recovered) {
+			t.Errorf("pubkey %d mismatch: want: %x have: %x", i, pubkeys[i], recovered)
+		}
+	}
+	// Waiting twice is an error, not a crash.
+	if _, err := handles[0].Wait(); err != ErrRecoverFailed {
+		t.Errorf("second wait: got %v, want %v", err, ErrRecoverFailed)
+	}
+	// Verification jobs agree with the synchronous path; a corrupted
+	// message fails only its own job.
+	msgs[7][0] ^= 0x01
+	for i := 0; i < jobs; i++ {
+		handle, err := VerifySignatureAsync(pubkeys[i], msgs[i], sigs[i][:64])
+		if err != nil {
+			t.Fatalf("submit error: %s", err)
+		}
+		handles[i] = handle
+	}
+	for i := 0; i < jobs; i++ {
+		if handles[i].WaitVerified() != (i != 7) {
+			t.Errorf("verify job %d mismatch", i)
+		}
+	}
+}
+
+func TestRecoverStream(t *testing.T) {
+	const batch = 32
+	var (
+		pubkeys = make([][]byte, batch)
+		msgs    = make([][]byte, batch)
+		sigs    = make([][]byte, batch)
+	)
+	for i := 0; i < batch; i++ {
+		pubkey, seckey := generateKeyPair()
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msgs[i], seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		pubkeys[i], sigs[i] = pubkey, sig
+	}
+	// Overflow one signature's s value past the group order; its entry must
+	// fail alone.
+	for b := 32; b < 64; b++ {
+		sigs[11][b] = 0xff
+	}
+	stream, err := RecoverPubkeyBatchStream(msgs, sigs)
+	if err != nil {
+		t.Fatalf("submit error: %s", err)
+	}
+	defer stream.Close()
+
+	// Every entry arrives exactly once, in whatever order, with its key.
+	seen := make([]bool, batch)
+	for {
+		index, recovered, err := stream.Next()
+		if index < 0 {
+			break
+		}
+		if seen[index] {
+			t.Fatalf("entry %d delivered twice", index)
+		}
+		seen[index] = true
+		if index == 11 {
+			if err != ErrRecoverFailed {
+				t.Errorf("corrupted entry: got %v, want %v", err, ErrRecoverFailed)
+			}
+			continue
+		}
+		if err != nil {
+			t.Errorf("recover entry %d error: %s", index, err)
+		} else if !bytes.Equal(pubkeys[index], recovered) {
+			t.Errorf("pubkey %d mismatch: want: %x have: %x", index, pubkeys[index], recovered)
+		}
+	}
+	for i := 0; i < batch; i++ {
+		if !seen[i] {
+			t.Errorf("entry %d never delivered", i)
+		}
+	}
+	// A drained stream reports exhaustion from both accessors.
+	if index, _, _ := stream.Next(); index != -1 {
+		t.Errorf("next after drain: got %d, want -1", index)
+	}
+	if index, _, _ := stream.Poll(); index != -1 {
+		t.Errorf("poll after drain: got %d, want -1", index)
+	}
+}
+
+func TestVerifyStream(t *testing.T) {
+	const batch = 32
+	var (
+		pubkeys = make([][]byte, batch)
+		msgs    = make([][]byte, batch)
+		sigs    = make([][]byte, batch)
+	)
+	for i := 0; i < batch; i++ {
+		pubkey, seckey := generateKeyPair()
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msgs[i], seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		pubkeys[i], sigs[i] = pubkey, sig[:64]
+	}
+	// Corrupt one signature; its entry must fail alone.
+	sigs[7] = append([]byte{}, sigs[7]...)
+	sigs[7][10] ^= 0x01
+	stream, err := VerifySignatureBatchStream(pubkeys, msgs, sigs)
+	if err != nil {
+		t.Fatalf("submit error: %s", err)
+	}
+	defer stream.Close()
+
+	// Every entry arrives exactly once, in whatever order, with its verdict.
+	seen := make([]bool, batch)
+	for {
+		index, key, err := stream.Next()
+		if index < 0 {
+			break
+		}
+		if seen[index] {
+			t.Fatalf("entry %d delivered twice", index)
+		}
+		seen[index] = true
+		if key != nil {
+			t.Errorf("entry %d: unexpected key output %x", index, key)
+		}
+		if index == 7 {
+			if err != ErrVerifyFailed {
+				t.Errorf("corrupted entry: got %v, want %v", err, ErrVerifyFailed)
+			}
+			continue
+		}
+		if err != nil {
+			t.Errorf("verify entry %d error: %s", index, err)
+		}
+	}
+	for i := 0; i < batch; i++ {
+		if !seen[i] {
+			t.Errorf("entry %d never delivered", i)
+		}
+	}
+	if index, _, _ := stream.Next(); index != -1 {
+		t.Errorf("next after drain: got %d, want -1", index)
+	}
+}
+
+func TestAlignedBuffer(t *testing.T) {
+	for _, size := range []int{1, 31, 32, 63, 64, 65, 1000, 16*65 + 1} {
+		buf := alignedBuffer(size)
+		if len(buf) != size {
+			t.Fatalf("size %d: length mismatch: have %d", size, len(buf))
+		}
+		if addr := uintptr(unsafe.Pointer(&buf[0])); addr%64 != 0 {
+			t.Errorf("size %d: base not 64-byte aligned: %#x", size, addr)
+		}
+		if cap(buf)%64 != 0 || cap(buf) < size {
+			t.Errorf("size %d: padding mismatch: cap %d", size, cap(buf))
+		}
+	}
+}
+
 func TestSignAndRecover(t *testing.T) {
 	pubkey1, seckey := generateKeyPair()
 	msg := randentropy.GetEntropyCSPRNG(32)
@@ -111,6 +533,808 @@ func TestSignAndRecover(t *testing.T) {
 	}
 }
 
+func TestSignAndRecoverBatch(t *testing.T) {
+	const batch = 16
+	var (
+		pubkeys = make([][]byte, batch)
+		msgs    = make([][]byte, batch)
+		sigs    = make([][]byte, batch)
+	)
+	for i := 0; i < batch; i++ {
+		pubkey, seckey := generateKeyPair()
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msgs[i], seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		pubkeys[i], sigs[i] = pubkey, sig
+	}
+	recovered, err := RecoverPubkeyBatch(msgs, sigs)
+	if err != nil {
+		t.Fatalf("batch recover error: %s", err)
+	}
+	for i := 0; i < batch; i++ {
+		if !bytes.Equal(pubkeys[i], recovered[i]) {
+			t.Errorf("pubkey %d mismatch: want: %x have: %x", i, pubkeys[i], recovered[i])
+		}
+	}
+	// A corrupted signature must fail its own slot without poisoning the rest.
+	for i := 32; i < 64; i++ {
+		sigs[3][i] = 0xff // overflow s, guaranteed parse failure
+	}
+	recovered, err = RecoverPubkeyBatch(msgs, sigs)
+	if err != ErrRecoverFailed {
+		t.Fatalf("got %q, want %q", err, ErrRecoverFailed)
+	}
+	for i := 0; i < batch; i++ {
+		if i == 3 {
+			continue
+		}
+		if !bytes.Equal(pubkeys[i], recovered[i]) {
+			t.Errorf("pubkey %d mismatch after partial failure", i)
+		}
+	}
+}
+
+func TestTranscodeDERBatch(t *testing.T) {
+	const batch = 16
+	sigs := make([][]byte, batch)
+	for i := 0; i < batch; i++ {
+		_, seckey := generateKeyPair()
+		msg := randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msg, seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		sigs[i] = sig[:64] // drop the recovery id
+	}
+	// Components with leading zero bytes and high bits exercise the
+	// minimal-integer edges of the encoder.
+	sigs = append(sigs, append(make([]byte, 33), sigs[0][33:]...))
+	copy(sigs[batch][33:], []byte{0x80})
+	ders, ok := CompactToDERBatch(sigs)
+	if !ok {
+		t.Fatal("canonical batch failed to transcode to DER")
+	}
+	back, ok := DERToCompactBatch(ders)
+	if !ok {
+		t.Fatal("transcoded DER failed to transcode back")
+	}
+	for i := range sigs {
+		if !bytes.Equal(sigs[i], back[i]) {
+			t.Errorf("sig %d: round trip mismatch: want %x have %x", i, sigs[i], back[i])
+		}
+	}
+	// Non-canonical inputs must fail their slot without disturbing the rest.
+	bad := [][]byte{
+		append(append([]byte{}, ders[0]...), 0x00),         // garbage after tuple
+		append([]byte{0x30, 0x81}, ders[1][1:]...),         // non-minimal length form
+		nil,                                                // empty
+		append(append([]byte{}, ders[2][:4]...), 0x00),     // truncated
+		{0x30, 0x06, 0x02, 0x01, 0x81, 0x02, 0x01, 0x01},   // negative r
+		{0x30, 0x07, 0x02, 0x02, 0x00, 0x01, 0x02, 0x01, 0x01}, // padded r
+	}
+	mixed := append(bad, ders[3])
+	out, ok := DERToCompactBatch(mixed)
+	if ok {
+		t.Error("batch with malformed entries reported ok")
+	}
+	for i := range bad {
+		if out[i] != nil {
+			t.Errorf("malformed DER %d transcoded: %x", i, out[i])
+		}
+	}
+	if !bytes.Equal(out[len(bad)], sigs[3]) {
+		t.Error("canonical entry poisoned by malformed neighbours")
+	}
+	// An out-of-range component must be rejected in both directions.
+	over := make([]byte, 64)
+	S256().Params().N.FillBytes(over[:32])
+	copy(over[32:], sigs[0][32:])
+	if out, ok := CompactToDERBatch([][]byte{over}); ok || out[0] != nil {
+		t.Error("component at the group order transcoded to DER")
+	}
+}
+
+func TestPrefetchSignatureData(t *testing.T) {
+	// Purely advisory: hinting must never disturb a following recovery,
+	// whatever region it covers.
+	PrefetchSignatureData(nil)
+	PrefetchSignatureData([]byte{0x01})
+
+	const batch = 8
+	var (
+		pubkeys = make([][]byte, batch)
+		msgs    = make([][]byte, batch)
+		sigs    = make([][]byte, batch)
+		region  = make([]byte, 0, batch*(65+32))
+	)
+	for i := 0; i < batch; i++ {
+		pubkey, seckey := generateKeyPair()
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msgs[i], seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		pubkeys[i], sigs[i] = pubkey, sig
+		region = append(region, sig...)
+		region = append(region, msgs[i]...)
+	}
+	PrefetchSignatureData(region)
+	recovered, err := RecoverPubkeyBatch(msgs, sigs)
+	if err != nil {
+		t.Fatalf("batch recover error: %s", err)
+	}
+	for i := 0; i < batch; i++ {
+		if !bytes.Equal(pubkeys[i], recovered[i]) {
+			t.Errorf("pubkey %d mismatch after prefetch hint", i)
+		}
+	}
+}
+
+func TestBatchHeartbeat(t *testing.T) {
+	const batch = 8
+	var (
+		msgs = make([][]byte, batch)
+		sigs = make([][]byte, batch)
+	)
+	for i := 0; i < batch; i++ {
+		_, seckey := generateKeyPair()
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msgs[i], seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		sigs[i] = sig
+	}
+	before := BatchHeartbeat()
+	if _, err := RecoverPubkeyBatch(msgs, sigs); err != nil {
+		t.Fatalf("batch recover error: %s", err)
+	}
+	// the batch loops bump the heartbeat while they progress; a completed
+	// batch must have moved it
+	if after := BatchHeartbeat(); after == before {
+		t.Errorf("heartbeat did not move across a batch: %d", after)
+	}
+}
+
+func TestRecoverPubkeyAddressBatch(t *testing.T) {
+	const batch = 16
+	var (
+		pubkeys = make([][]byte, batch)
+		msgs    = make([][]byte, batch)
+		sigs    = make([][]byte, batch)
+	)
+	for i := 0; i < batch; i++ {
+		pubkey, seckey := generateKeyPair()
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msgs[i], seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		pubkeys[i], sigs[i] = pubkey, sig
+	}
+	recovered, addrs, err := RecoverPubkeyAddressBatch(msgs, sigs)
+	if err != nil {
+		t.Fatalf("arena recover error: %s", err)
+	}
+	for i := 0; i < batch; i++ {
+		if !bytes.Equal(pubkeys[i], recovered[i]) {
+			t.Errorf("pubkey %d mismatch: want: %x have: %x", i, pubkeys[i], recovered[i])
+		}
+		want, err := RecoverAddress(msgs[i], sigs[i])
+		if err != nil {
+			t.Fatalf("address recover error: %s", err)
+		}
+		if !bytes.Equal(want, addrs[i]) {
+			t.Errorf("address %d mismatch: want: %x have: %x", i, want, addrs[i])
+		}
+	}
+	// A corrupted signature must fail its own slot without poisoning the rest.
+	for i := 32; i < 64; i++ {
+		sigs[5][i] = 0xff // overflow s, guaranteed parse failure
+	}
+	recovered, addrs, err = RecoverPubkeyAddressBatch(msgs, sigs)
+	if err != ErrRecoverFailed {
+		t.Fatalf("got %q, want %q", err, ErrRecoverFailed)
+	}
+	for i := 0; i < batch; i++ {
+		if i == 5 {
+			if recovered[i] != nil || addrs[i] != nil {
+				t.Errorf("corrupted slot %d not reported as failed", i)
+			}
+			continue
+		}
+		if !bytes.Equal(pubkeys[i], recovered[i]) {
+			t.Errorf("pubkey %d mismatch after partial failure", i)
+		}
+	}
+}
+
+func TestSharedRecoveryCache(t *testing.T) {
+	// Recovery through the file-backed shared table must stay byte-identical,
+	// and the recovered keys must actually land in the backing file, where a
+	// colocated process mapping the same path would pick them up.
+	path := filepath.Join(os.TempDir(), "secp256k1-shared-rcc-test")
+	os.Remove(path)
+	defer os.Remove(path)
+
+	if err := ShareRecoveryCache(path); err != nil {
+		t.Fatalf("shared cache attach error: %s", err)
+	}
+	const batch = 8
+	var (
+		pubkeys = make([][]byte, batch)
+		msgs    = make([][]byte, batch)
+		sigs    = make([][]byte, batch)
+	)
+	for i := 0; i < batch; i++ {
+		pubkey, seckey := generateKeyPair()
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msgs[i], seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		pubkeys[i], sigs[i] = pubkey, sig
+	}
+	for pass := 0; pass < 2; pass++ {
+		recovered, err := RecoverPubkeyBatch(msgs, sigs)
+		if err != nil {
+			t.Fatalf("pass %d batch recover error: %s", pass, err)
+		}
+		for i := 0; i < batch; i++ {
+			if !bytes.Equal(pubkeys[i], recovered[i]) {
+				t.Errorf("pass %d pubkey %d mismatch: want: %x have: %x", pass, i, pubkeys[i], recovered[i])
+			}
+		}
+	}
+	blob, err := ioutil.ReadFile(path)
+	if err != nil {
+		t.Fatalf("backing file read error: %s", err)
+	}
+	for i := 0; i < batch; i++ {
+		if !bytes.Contains(blob, pubkeys[i]) {
+			t.Errorf("pubkey %d missing from the shared backing file", i)
+		}
+	}
+	// A backing file with a foreign layout must be rejected, not mapped.
+	bogus := filepath.Join(os.TempDir(), "secp256k1-shared-rcc-bogus")
+	os.Remove(bogus)
+	defer os.Remove(bogus)
+	if err := ioutil.WriteFile(bogus, []byte("not a cache"), 0600); err != nil {
+		t.Fatal(err)
+	}
+	if err := ShareRecoveryCache(bogus); err == nil {
+		t.Errorf("foreign backing file accepted")
+	}
+}
+
+func TestChecksumAddresses(t *testing.T) {
+	// The EIP-55 test vectors, and every ragged tail length of the
+	// four-lane kernel around them.
+	vectors := []string{
+		"0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed",
+		"0xfB6916095ca1df60bB79Ce92cE3Ea74c37c5d359",
+		"0xdbF03B407c01E7cD3CBea99509d93f8DDDC8C6FB",
+		"0xD1220A0cf47c7B9Be7A2E6BA89F429762e7b9aDb",
+	}
+	raw := make([][]byte, len(vectors))
+	for i, v := range vectors {
+		raw[i] = make([]byte, 20)
+		if _, err := hex.Decode(raw[i], []byte(strings.ToLower(v[2:]))); err != nil {
+			t.Fatalf("vector %d decode error: %s", i, err)
+		}
+	}
+	for n := 1; n <= 9; n++ {
+		addrs := make([][]byte, n)
+		for i := 0; i < n; i++ {
+			addrs[i] = raw[i%len(raw)]
+		}
+		out := ChecksumAddresses(addrs)
+		if len(out) != n {
+			t.Fatalf("batch %d: got %d results", n, len(out))
+		}
+		for i := 0; i < n; i++ {
+			if out[i] != vectors[i%len(vectors)] {
+				t.Errorf("batch %d entry %d: want %s have %s", n, i, vectors[i%len(vectors)], out[i])
+			}
+		}
+	}
+	// Malformed entries come back empty without disturbing their neighbours.
+	out := ChecksumAddresses([][]byte{raw[0], {0x01}, raw[1]})
+	if out[0] != vectors[0] || out[1] != "" || out[2] != vectors[1] {
+		t.Errorf("mixed batch mishandled: %q", out)
+	}
+}
+
+func TestWarmStateRoundTrip(t *testing.T) {
+	// A snapshot taken after a recovery batch must land on disk with the
+	// recovered keys inside, restore cleanly, and leave recovery results
+	// byte-identical; garbage at the path must be rejected, not restored.
+	path := filepath.Join(os.TempDir(), "secp256k1-warmstate-test")
+	os.Remove(path)
+	defer os.Remove(path)
+
+	const batch = 8
+	var (
+		pubkeys = make([][]byte, batch)
+		msgs    = make([][]byte, batch)
+		sigs    = make([][]byte, batch)
+	)
+	for i := 0; i < batch; i++ {
+		pubkey, seckey := generateKeyPair()
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msgs[i], seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		pubkeys[i], sigs[i] = pubkey, sig
+	}
+	if _, err := RecoverPubkeyBatch(msgs, sigs); err != nil {
+		t.Fatalf("batch recover error: %s", err)
+	}
+	if err := SaveWarmState(path); err != nil {
+		t.Fatalf("warm state save error: %s", err)
+	}
+	blob, err := ioutil.ReadFile(path)
+	if err != nil {
+		t.Fatalf("snapshot read error: %s", err)
+	}
+	if !bytes.HasPrefix(blob, []byte("secpwrm1")) {
+		t.Fatalf("snapshot magic missing: %x", blob[:8])
+	}
+	for i := 0; i < batch; i++ {
+		if !bytes.Contains(blob, pubkeys[i]) {
+			t.Errorf("pubkey %d missing from the snapshot", i)
+		}
+	}
+	if restored := RestoreWarmState(path); restored == 0 {
+		t.Fatalf("own snapshot not restored")
+	}
+	recovered, err := RecoverPubkeyBatch(msgs, sigs)
+	if err != nil {
+		t.Fatalf("post-restore batch recover error: %s", err)
+	}
+	for i := 0; i < batch; i++ {
+		if !bytes.Equal(pubkeys[i], recovered[i]) {
+			t.Errorf("pubkey %d mismatch after restore: want: %x have: %x", i, pubkeys[i], recovered[i])
+		}
+	}
+	// A snapshot with a foreign layout must be skipped, not misread.
+	bogus := filepath.Join(os.TempDir(), "secp256k1-warmstate-bogus")
+	os.Remove(bogus)
+	defer os.Remove(bogus)
+	if err := ioutil.WriteFile(bogus, []byte("not a snapshot"), 0600); err != nil {
+		t.Fatal(err)
+	}
+	if restored := RestoreWarmState(bogus); restored != 0 {
+		t.Errorf("foreign snapshot accepted: %d sections", restored)
+	}
+}
+
+func TestCalibratedContext(t *testing.T) {
+	// Whichever table geometry the probe picks, the calibrated context must
+	// keep producing correct results, the verdict must land in the cache
+	// file, and a second calibration must accept the cached verdict.
+	path := filepath.Join(os.TempDir(), "secp256k1-calibrate-test")
+	os.Remove(path)
+	defer os.Remove(path)
+
+	for pass := 0; pass < 2; pass++ {
+		if err := Calibrate(path); err != nil {
+			t.Fatalf("pass %d calibration error: %s", pass, err)
+		}
+		pubkey, seckey := generateKeyPair()
+		msg := randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msg, seckey)
+		if err != nil {
+			t.Fatalf("pass %d signature error: %s", pass, err)
+		}
+		recovered, err := RecoverPubkey(msg, sig)
+		if err != nil {
+			t.Fatalf("pass %d recover error: %s", pass, err)
+		}
+		if !bytes.Equal(pubkey, recovered) {
+			t.Errorf("pass %d pubkey mismatch: want: %x have: %x", pass, pubkey, recovered)
+		}
+	}
+	blob, err := ioutil.ReadFile(path)
+	if err != nil {
+		t.Fatalf("verdict file read error: %s", err)
+	}
+	if !bytes.HasPrefix(blob, []byte("secp-calib-1 ")) {
+		t.Errorf("implausible verdict file: %q", blob)
+	}
+}
+
+func TestRecoverBatchMemoized(t *testing.T) {
+	// The second pass over the same signatures is served from the native
+	// recovery cache; it must return byte-identical keys, and entries the
+	// cache has never seen must still recover correctly alongside the hits.
+	const batch = 32
+	var (
+		pubkeys = make([][]byte, batch)
+		msgs    = make([][]byte, batch)
+		sigs    = make([][]byte, batch)
+	)
+	for i := 0; i < batch; i++ {
+		pubkey, seckey := generateKeyPair()
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msgs[i], seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		pubkeys[i], sigs[i] = pubkey, sig
+	}
+	if _, err := RecoverPubkeyBatch(msgs, sigs); err != nil {
+		t.Fatalf("priming batch recover error: %s", err)
+	}
+	// Replace half the batch with fresh signatures to mix hits and misses.
+	for i := 0; i < batch; i += 2 {
+		pubkey, seckey := generateKeyPair()
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msgs[i], seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		pubkeys[i], sigs[i] = pubkey, sig
+	}
+	recovered, err := RecoverPubkeyBatch(msgs, sigs)
+	if err != nil {
+		t.Fatalf("mixed batch recover error: %s", err)
+	}
+	for i := 0; i < batch; i++ {
+		if !bytes.Equal(pubkeys[i], recovered[i]) {
+			t.Errorf("pubkey %d mismatch: want: %x have: %x", i, pubkeys[i], recovered[i])
+		}
+	}
+	// A memoized signature must still verify only against its own signer.
+	if _, err := VerifyRecoverBatch(msgs[:2], sigs[:2], pubkeys[:2]); err != nil {
+		t.Errorf("verify mode rejected memoized signers: %s", err)
+	}
+	if _, err := VerifyRecoverBatch(msgs[1:2], sigs[1:2], pubkeys[3:4]); err != ErrRecoverFailed {
+		t.Errorf("verify mode accepted a foreign key for a memoized signature: %v", err)
+	}
+}
+
+func TestVerifyRecover(t *testing.T) {
+	pubkey, seckey := generateKeyPair()
+	msg := randentropy.GetEntropyCSPRNG(32)
+	sig, err := Sign(msg, seckey)
+	if err != nil {
+		t.Fatalf("signature error: %s", err)
+	}
+	// Recover mode: nil expected key returns the signer.
+	recovered, err := VerifyRecover(msg, sig, nil)
+	if err != nil {
+		t.Fatalf("recover mode error: %s", err)
+	}
+	if !bytes.Equal(pubkey, recovered) {
+		t.Errorf("pubkey mismatch: want: %x have: %x", pubkey, recovered)
+	}
+	// Verify mode: the right key passes, a different signer's key fails.
+	if _, err := VerifyRecover(msg, sig, pubkey); err != nil {
+		t.Errorf("verify mode rejected the signer's key: %s", err)
+	}
+	otherkey, _ := generateKeyPair()
+	if _, err := VerifyRecover(msg, sig, otherkey); err != ErrRecoverFailed {
+		t.Errorf("verify mode accepted a foreign key: %v", err)
+	}
+}
+
+func TestVerifyRecoverBatch(t *testing.T) {
+	const batch = 16
+	var (
+		pubkeys  = make([][]byte, batch)
+		expected = make([][]byte, batch)
+		msgs     = make([][]byte, batch)
+		sigs     = make([][]byte, batch)
+	)
+	for i := 0; i < batch; i++ {
+		pubkey, seckey := generateKeyPair()
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msgs[i], seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		pubkeys[i], sigs[i] = pubkey, sig
+		// Mixed batch: every other entry knows its signer up front.
+		if i%2 == 0 {
+			expected[i] = pubkey
+		}
+	}
+	// Entry 5 claims the wrong signer: its slot must fail alone.
+	expected[5] = pubkeys[4]
+	keys, err := VerifyRecoverBatch(msgs, sigs, expected)
+	if err != ErrRecoverFailed {
+		t.Fatalf("got %q, want %q", err, ErrRecoverFailed)
+	}
+	for i := 0; i < batch; i++ {
+		if i == 5 {
+			if keys[i] != nil {
+				t.Errorf("mismatched entry %d passed", i)
+			}
+			continue
+		}
+		if !bytes.Equal(pubkeys[i], keys[i]) {
+			t.Errorf("pubkey %d mismatch: want: %x have: %x", i, pubkeys[i], keys[i])
+		}
+	}
+	// All-recover shape: nil pubkeys behaves like RecoverPubkeyBatch.
+	keys, err = VerifyRecoverBatch(msgs, sigs, nil)
+	if err != nil {
+		t.Fatalf("batch recover error: %s", err)
+	}
+	for i := 0; i < batch; i++ {
+		if !bytes.Equal(pubkeys[i], keys[i]) {
+			t.Errorf("pubkey %d mismatch in recover-all batch", i)
+		}
+	}
+}
+
+func TestVerifySignatureBatch(t *testing.T) {
+	const batch = 64 // large enough to engage the worker pool
+	var (
+		pubkeys = make([][]byte, batch)
+		msgs    = make([][]byte, batch)
+		sigs    = make([][]byte, batch)
+	)
+	for i := 0; i < batch; i++ {
+		pubkey, seckey := generateKeyPair()
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msgs[i], seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		pubkeys[i], sigs[i] = pubkey, sig[:64]
+	}
+	results, ok := VerifySignatureBatch(pubkeys, msgs, sigs)
+	if !ok {
+		t.Fatal("batch did not verify")
+	}
+	for i, valid := range results {
+		if !valid {
+			t.Errorf("signature %d did not verify", i)
+		}
+	}
+	// Flipping one message bit must fail exactly that slot.
+	msgs[7][0] ^= 0x01
+	results, ok = VerifySignatureBatch(pubkeys, msgs, sigs)
+	if ok {
+		t.Fatal("batch verified with corrupted message")
+	}
+	for i, valid := range results {
+		if valid != (i != 7) {
+			t.Errorf("signature %d: valid=%v, want %v", i, valid, i != 7)
+		}
+	}
+}
+
+func TestSchnorrSignAndVerify(t *testing.T) {
+	pubkey, seckey := generateKeyPair()
+	msg := randentropy.GetEntropyCSPRNG(32)
+	sig, err := SchnorrSign(msg, seckey)
+	if err != nil {
+		t.Fatalf("sign error: %s", err)
+	}
+	if !SchnorrVerify(pubkey, msg, sig) {
+		t.Errorf("signature did not verify")
+	}
+	sig[32] ^= 0x01
+	if SchnorrVerify(pubkey, msg, sig) {
+		t.Errorf("corrupted signature verified")
+	}
+}
+
+func TestSchnorrVerifyBatch(t *testing.T) {
+	const batch = 64 // large enough to engage the Pippenger multi-scalar path
+	var (
+		pubkeys = make([][]byte, batch)
+		msgs    = make([][]byte, batch)
+		sigs    = make([][]byte, batch)
+	)
+	for i := 0; i < batch; i++ {
+		pubkey, seckey := generateKeyPair()
+		msgs[i] = randentropy.GetEntropyCSPRNG(32)
+		sig, err := SchnorrSign(msgs[i], seckey)
+		if err != nil {
+			t.Fatalf("signature error: %s", err)
+		}
+		pubkeys[i], sigs[i] = pubkey, sig
+	}
+	results, ok := SchnorrVerifyBatch(pubkeys, msgs, sigs)
+	if !ok {
+		t.Fatal("batch did not verify")
+	}
+	for i, valid := range results {
+		if !valid {
+			t.Errorf("signature %d did not verify", i)
+		}
+	}
+	// Flipping one message bit must fail exactly that slot.
+	msgs[7][0] ^= 0x01
+	results, ok = SchnorrVerifyBatch(pubkeys, msgs, sigs)
+	if ok {
+		t.Fatal("batch verified with corrupted message")
+	}
+	for i, valid := range results {
+		if valid != (i != 7) {
+			t.Errorf("signature %d: valid=%v, want %v", i, valid, i != 7)
+		}
+	}
+}
+
+func TestLoadSharedContext(t *testing.T) {
+	dir, err := ioutil.TempDir("", "secp256k1-tables")
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer os.RemoveAll(dir)
+	path := filepath.Join(dir, "verification-tables")
+
+	// The first load builds the tables and publishes the file, the second maps
+	// it. Signing and recovery must work identically against both contexts.
+	for round := 0; round < 2; round++ {
+		if err := LoadSharedContext(path); err != nil {
+			t.Fatalf("round %d: %v", round, err)
+		}
+		if round == 0 {
+			if _, err := os.Stat(path); err != nil {
+				t.Fatalf("table file not published: %v", err)
+			}
+		}
+		pubkey1, seckey := generateKeyPair()
+		msg := randentropy.GetEntropyCSPRNG(32)
+		sig, err := Sign(msg, seckey)
+		if err != nil {
+			t.Fatalf("round %d: signature error: %s", round, err)
+		}
+		pubkey2, err := RecoverPubkey(msg, sig)
+		if err != nil {
+			t.Fatalf("round %d: recover error: %s", round, err)
+		}
+		if !bytes.Equal(pubkey1, pubkey2) {
+			t.Errorf("round %d: pubkey mismatch: want: %x have: %x", round, pubkey1, pubkey2)
+		}
+		if !VerifySignature(pubkey1, msg, sig[:64]) {
+			t.Errorf("round %d: signature did not verify", round)
+		}
+	}
+}
+
+func TestScalarMultSession(t *testing.T) {
+	curve := S256()
+	pubkey, _ := generateKeyPair()
+	x, y := new(big.Int).SetBytes(pubkey[1:33]), new(big.Int).SetBytes(pubkey[33:])
+
+	session := NewScalarMultSession(x, y)
+	defer session.Close()
+	for i := 0; i < 16; i++ {
+		scalar := randentropy.GetEntropyCSPRNG(32)
+		wantX, wantY := curve.ScalarMult(x, y, scalar)
+		haveX, haveY := session.ScalarMult(scalar)
+		if wantX.Cmp(haveX) != 0 || wantY.Cmp(haveY) != 0 {
+			t.Fatalf("session mismatch: want (%x, %x) have (%x, %x)", wantX, wantY, haveX, haveY)
+		}
+	}
+	// An invalid (zero) scalar must fail like ScalarMult does.
+	if gotX, gotY := session.ScalarMult(make([]byte, 32)); gotX != nil || gotY != nil {
+		t.Errorf("zero scalar: expected nil result, got (%v, %v)", gotX, gotY)
+	}
+}
+
+func TestDecompressPubkeyBatch(t *testing.T) {
+	const n = 9
+	compressed := make([][]byte, n)
+	for i := 0; i < n; i++ {
+		pubkey, _ := generateKeyPair()
+		x, y := new(big.Int).SetBytes(pubkey[1:33]), new(big.Int).SetBytes(pubkey[33:])
+		compressed[i] = CompressPubkey(x, y)
+	}
+	// Corrupt two entries: a bogus prefix and an x with no square root on the
+	// curve (flipping a coordinate bit almost surely yields a non-residue,
+	// and the reference DecompressPubkey agrees either way).
+	compressed[2][0] = 0x05
+	compressed[6][1] ^= 0x40
+
+	out, ok := DecompressPubkeyBatch(compressed)
+	if ok {
+		t.Errorf("batch with invalid keys reported ok")
+	}
+	for i := 0; i < n; i++ {
+		wantX, wantY := DecompressPubkey(compressed[i])
+		if wantX == nil {
+			if out[i] != nil {
+				t.Errorf("key %d: expected failure, got %x", i, out[i])
+			}
+			continue
+		}
+		if out[i] == nil {
+			t.Errorf("key %d: unexpected failure", i)
+			continue
+		}
+		haveX := new(big.Int).SetBytes(out[i][1:33])
+		haveY := new(big.Int).SetBytes(out[i][33:])
+		if wantX.Cmp(haveX) != 0 || wantY.Cmp(haveY) != 0 {
+			t.Errorf("key %d: mismatch: want (%x, %x) have (%x, %x)", i, wantX, wantY, haveX, haveY)
+		}
+	}
+}
+
+func TestMultiScalarMult(t *testing.T) {
+	const n = 5
+	var (
+		curve   = S256()
+		points  = make([][]byte, n)
+		scalars = make([][]byte, n)
+		accX    *big.Int
+		accY    *big.Int
+	)
+	gscalar := randentropy.GetEntropyCSPRNG(32)
+	accX, accY = curve.ScalarBaseMult(gscalar)
+	for i := 0; i < n; i++ {
+		pubkey, _ := generateKeyPair()
+		points[i] = pubkey[1:]
+		scalars[i] = randentropy.GetEntropyCSPRNG(32)
+
+		x, y := new(big.Int).SetBytes(points[i][:32]), new(big.Int).SetBytes(points[i][32:])
+		px, py := curve.ScalarMult(x, y, scalars[i])
+		accX, accY = curve.Add(accX, accY, px, py)
+	}
+	out, err := MultiScalarMult(points, scalars, gscalar)
+	if err != nil {
+		t.Fatalf("multi scalar mult error: %s", err)
+	}
+	want := append(math.PaddedBigBytes(accX, 32), math.PaddedBigBytes(accY, 32)...)
+	if !bytes.Equal(out, want) {
+		t.Errorf("result mismatch: want: %x have: %x", want, out)
+	}
+	// A generator-only combination must also work.
+	out, err = MultiScalarMult(nil, nil, gscalar)
+	if err != nil {
+		t.Fatalf("generator-only error: %s", err)
+	}
+	gx, gy := curve.ScalarBaseMult(gscalar)
+	want = append(math.PaddedBigBytes(gx, 32), math.PaddedBigBytes(gy, 32)...)
+	if !bytes.Equal(out, want) {
+		t.Errorf("generator-only mismatch: want: %x have: %x", want, out)
+	}
+}
+
+func TestMultiScalarMultLarge(t *testing.T) {
+	// Large enough to take the Pippenger bucket path instead of Strauss.
+	const n = 100
+	var (
+		curve   = S256()
+		points  = make([][]byte, n)
+		scalars = make([][]byte, n)
+		exp     = new(big.Int)
+	)
+	gscalar := randentropy.GetEntropyCSPRNG(32)
+	exp.SetBytes(gscalar)
+	// Use points k[i]*G so the expected result is (gscalar + sum k[i]*s[i])*G,
+	// computable with a single base multiplication.
+	for i := 0; i < n; i++ {
+		k := randentropy.GetEntropyCSPRNG(32)
+		x, y := curve.ScalarBaseMult(k)
+		points[i] = append(math.PaddedBigBytes(x, 32), math.PaddedBigBytes(y, 32)...)
+		scalars[i] = randentropy.GetEntropyCSPRNG(32)
+
+		term := new(big.Int).Mul(new(big.Int).SetBytes(k), new(big.Int).SetBytes(scalars[i]))
+		exp.Add(exp, term)
+	}
+	exp.Mod(exp, curve.N)
+	out, err := MultiScalarMult(points, scalars, gscalar)
+	if err != nil {
+		t.Fatalf("multi scalar mult error: %s", err)
+	}
+	ex, ey := curve.ScalarBaseMult(math.PaddedBigBytes(exp, 32))
+	want := append(math.PaddedBigBytes(ex, 32), math.PaddedBigBytes(ey, 32)...)
+	if !bytes.Equal(out, want) {
+		t.Errorf("result mismatch: want: %x have: %x", want, out)
+	}
+}
+
 func TestSignDeterministic(t *testing.T) {
 	_, seckey := generateKeyPair()
 	msg := make([]byte, 32)
@@ -129,6 +1353,37 @@ func TestSignDeterministic(t *testing.T) {
 	}
 }
 
+func TestSignPooled(t *testing.T) {
+	pubkey, seckey := generateKeyPair()
+
+	const n = 8
+	seeds := make([][]byte, n)
+	for i := range seeds {
+		seeds[i] = randentropy.GetEntropyCSPRNG(32)
+	}
+	if added := PrecomputeNonces(seeds); added != n {
+		t.Fatalf("pooled %d nonces, want %d", added, n)
+	}
+	for i := 0; i < n; i++ {
+		msg := randentropy.GetEntropyCSPRNG(32)
+		sig, err := SignPooled(msg, seckey)
+		if err != nil {
+			t.Fatalf("iteration %d: sign error: %s", i, err)
+		}
+		recovered, err := RecoverPubkey(msg, sig)
+		if err != nil {
+			t.Fatalf("iteration %d: recover error: %s", i, err)
+		}
+		if !bytes.Equal(pubkey, recovered) {
+			t.Fatalf("iteration %d: pubkey mismatch: want: %x have: %x", i, pubkey, recovered)
+		}
+	}
+	// the pool is exhausted now
+	if _, err := SignPooled(randentropy.GetEntropyCSPRNG(32), seckey); err != ErrSignFailed {
+		t.Fatalf("expected %v on empty pool, got %v", ErrSignFailed, err)
+	}
+}
+
 func TestRandomMessagesWithSameKey(t *testing.T) {
 	pubkey, seckey := generateKeyPair()
 	keys := func() ([]byte, []byte) {
@@ -202,6 +1457,45 @@ func TestRandomMessagesAgainstValidSig(t *testing.T) {
 	}
 }
 
+func TestRecoverAddressInput(t *testing.T) {
+	_, seckey := generateKeyPair()
+	msg := randentropy.GetEntropyCSPRNG(32)
+	sig, err := Sign(msg, seckey)
+	if err != nil {
+		t.Fatalf("sign error: %s", err)
+	}
+	pubkey, err := RecoverPubkey(msg, sig)
+	if err != nil {
+		t.Fatalf("recover error: %s", err)
+	}
+	input, err := RecoverAddressInput(msg, sig)
+	if err != nil {
+		t.Fatalf("recover address input error: %s", err)
+	}
+	if !bytes.Equal(input, pubkey[1:]) {
+		t.Errorf("hash input mismatch: want: %x have: %x", pubkey[1:], input)
+	}
+}
+
+func TestRecoverAddress(t *testing.T) {
+	// The expected address is the well-known one derived from this secret
+	// key, pinning the native Keccak-256 against an external reference.
+	seckey, _ := hex.DecodeString("45a915e4d060149eb4365960e6a7a45f334393093061116b197e3240065ff2d8")
+	want, _ := hex.DecodeString("a94f5374fce5edbc8e2a8697c15331677e6ebf0b")
+	msg := randentropy.GetEntropyCSPRNG(32)
+	sig, err := Sign(msg, seckey)
+	if err != nil {
+		t.Fatalf("sign error: %s", err)
+	}
+	addr, err := RecoverAddress(msg, sig)
+	if err != nil {
+		t.Fatalf("recover address error: %s", err)
+	}
+	if !bytes.Equal(addr, want) {
+		t.Errorf("address mismatch: want: %x have: %x", want, addr)
+	}
+}
+
 // Useful when the underlying libsecp256k1 API changes to quickly
 // check only recover function without use of signature function
 func TestRecoverSanity(t *testing.T) {
@@ -23,12 +23,15 @@ import (
 	"crypto/elliptic"
 	"fmt"
 
+	"github.com/ethereumai/go-ethereumai/common"
 	"github.com/ethereumai/go-ethereumai/common/math"
+	"github.com/ethereumai/go-ethereumai/crypto/replay"
 	"github.com/ethereumai/go-ethereumai/crypto/secp256k1"
 )
 
 // Ecrecover returns the uncompressed public key that created the given signature.
 func Ecrecover(hash, sig []byte) ([]byte, error) {
+	replay.CaptureRecover(hash, sig)
 	return secp256k1.RecoverPubkey(hash, sig)
 }
 
@@ -64,6 +67,7 @@ func Sign(hash []byte, prv *ecdsa.PrivateKey) (sig []byte, err error) {
 // The public key should be in compressed (33 bytes) or uncompressed (65 bytes) format.
 // The signature should have the 64 byte [R || S] format.
 func VerifySignature(pubkey, hash, signature []byte) bool {
+	replay.CaptureVerify(pubkey, hash, signature)
 	return secp256k1.VerifySignature(pubkey, hash, signature)
 }
 
@@ -85,3 +89,29 @@ func CompressPubkey(pubkey *ecdsa.PublicKey) []byte {
 func S256() elliptic.Curve {
 	return secp256k1.S256()
 }
+
+// ChecksumAddresses renders the given addresses as EIP-55 checksummed hex
+// strings through one native batch call, instead of one Keccak-256 state per
+// address like Address.Hex.
+func ChecksumAddresses(addrs []common.Address) []string {
+	packed := make([][]byte, len(addrs))
+	for i := range addrs {
+		packed[i] = addrs[i][:]
+	}
+	return secp256k1.ChecksumAddresses(packed)
+}
+
+// SaveWarmState snapshots the native warm caches to the file at path so the
+// next process can start warm. It belongs in graceful shutdown, after the
+// signature workload has quiesced.
+func SaveWarmState(path string) error {
+	return secp256k1.SaveWarmState(path)
+}
+
+// RestoreWarmState loads a snapshot written by SaveWarmState, returning the
+// number of cache sections restored. Zero means no usable snapshot was found
+// and the process starts cold. It must run during startup, before signature
+// recovery is used concurrently.
+func RestoreWarmState(path string) int {
+	return secp256k1.RestoreWarmState(path)
+}
@@ -26,6 +26,7 @@ import (
 	"math/big"
 
 	"github.com/btcsuite/btcd/btcec"
+	"github.com/ethereumai/go-ethereumai/common"
 )
 
 // Ecrecover returns the uncompressed public key that created the given signature.
@@ -115,3 +116,26 @@ func CompressPubkey(pubkey *ecdsa.PublicKey) []byte {
 func S256() elliptic.Curve {
 	return btcec.S256()
 }
+
+// ChecksumAddresses renders the given addresses as EIP-55 checksummed hex
+// strings. Without the native batch kernel it falls back to the one-hash-per
+// -address Address.Hex path.
+func ChecksumAddresses(addrs []common.Address) []string {
+	out := make([]string, len(addrs))
+	for i := range addrs {
+		out[i] = addrs[i].Hex()
+	}
+	return out
+}
+
+// SaveWarmState is a no-op without the native secp256k1 layer; there is no
+// warm native state to snapshot.
+func SaveWarmState(path string) error {
+	return nil
+}
+
+// RestoreWarmState is a no-op without the native secp256k1 layer; it reports
+// zero restored sections.
+func RestoreWarmState(path string) int {
+	return 0
+}
@@ -57,6 +57,7 @@ type TraceConfig struct {
 	*vm.LogConfig
 	Tracer  *string
 	Timeout *string
+	Profile *string // Sampling interval to profile the JavaScript tracer code at
 	Reexec  *uint64
 }
 
@@ -66,6 +67,15 @@ type txTraceResult struct {
 	Error  string      `json:"error,omitempty"`  // Trace failure produced by the tracer
 }
 
+// txTraceProfileResult wraps a JavaScript trace result with the sampling
+// profile of the tracer code itself, returned when profiling was requested.
+// The profile attributes trace time to the tracer script's own functions, so
+// a user can see the hotspots of a slow tracer without our involvement.
+type txTraceProfileResult struct {
+	Result  interface{}            `json:"result"`
+	Profile []tracers.ProfileEntry `json:"profile"`
+}
+
 // blockTraceTask represents a single block trace task when an entire chain is
 // being traced.
 type blockTraceTask struct {
@@ -572,6 +582,14 @@ func (api *PrivateDebugAPI) traceTx(ctx context.Context, message core.Message, v
 		if tracer, err = tracers.New(*config.Tracer); err != nil {
 			return nil, err
 		}
+		// Arm the sampling profiler on the tracer code if requested
+		if config.Profile != nil {
+			interval, err := time.ParseDuration(*config.Profile)
+			if err != nil {
+				return nil, err
+			}
+			tracer.(*tracers.Tracer).StartProfiling(interval)
+		}
 		// Handle timeouts and RPC cancellations
 		deadlineCtx, cancel := context.WithTimeout(ctx, timeout)
 		go func() {
@@ -604,7 +622,11 @@ func (api *PrivateDebugAPI) traceTx(ctx context.Context, message core.Message, v
 		}, nil
 
 	case *tracers.Tracer:
-		return tracer.GetResult()
+		result, err := tracer.GetResult()
+		if err != nil || config.Profile == nil {
+			return result, err
+		}
+		return &txTraceProfileResult{Result: result, Profile: tracer.StopProfiling()}, nil
 
 	default:
 		panic(fmt.Sprintf("bad tracer type %T", tracer))
@@ -0,0 +1,201 @@
+// Copyright 2018 The go-ethereumai Authors
+// This file is part of the go-ethereumai library.
+//
+// The go-ethereumai library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The go-ethereumai library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the go-ethereumai library. If not, see <http://www.gnu.org/licenses/>.
+
+package tracers
+
+import (
+	"encoding/binary"
+	"errors"
+	"io/ioutil"
+	"math/rand"
+	"os"
+	"path/filepath"
+	"sort"
+	"strconv"
+	"sync"
+
+	mmap "github.com/edsrzf/mmap-go"
+	"github.com/ethereumai/go-ethereumai/common"
+	"github.com/ethereumai/go-ethereumai/crypto"
+	duktape "gopkg.in/olebedev/go-duktape.v3"
+)
+
+// registryMagic identifies precompiled tracer registry files. Duktape bytecode
+// is tied to the build that produced it, so the registry is a local cache like
+// the eaiash verification caches, not a portable artifact.
+var registryMagic = []byte("duktrcr1")
+
+// errInvalidRegistry is returned when a registry file fails its sanity checks
+// or no longer covers the tracers shipped with this release.
+var errInvalidRegistry = errors.New("invalid tracer registry")
+
+// tracerRegistry is the process-wide view of the shared registry file. The
+// segments index bytecode dumps in place inside the read-only mapping, so
+// every heap on the machine instantiates the common tracers from the same
+// physical pages.
+var tracerRegistry = struct {
+	sync.RWMutex
+	file     *os.File
+	mem      mmap.MMap
+	segments map[common.Hash][]byte
+}{}
+
+// registrySegment returns the mmap'd bytecode dump for the given source hash,
+// or nil if the registry is not loaded or does not contain the snippet.
+func registrySegment(key common.Hash) []byte {
+	tracerRegistry.RLock()
+	seg := tracerRegistry.segments[key]
+	tracerRegistry.RUnlock()
+	return seg
+}
+
+// registrySources collects the exact snippets tracer instantiation evaluates:
+// every built in tracer wrapped the way New wraps it, plus the big integer
+// library every tracer VM loads.
+func registrySources() []string {
+	names := make([]string, 0, len(all))
+	for name := range all {
+		names = append(names, name)
+	}
+	sort.Strings(names)
+
+	sources := []string{bigIntegerJS}
+	for _, name := range names {
+		sources = append(sources, "("+all[name]+")")
+	}
+	return sources
+}
+
+// LoadTracerRegistry points the package at a shared registry of precompiled
+// tracer bytecode, mapped read-only from the file at path. The first process
+// on a machine compiles the built in tracers and writes the file; every later
+// process (and every heap within one) loads the same physical pages instead
+// of holding a private copy of each dump. A stale or corrupted file is
+// rebuilt in place. It returns the number of tracers served from the mapping
+// and must be called during startup, before tracers are created concurrently.
+func LoadTracerRegistry(path string) (int, error) {
+	file, mem, segments, err := mapRegistry(path)
+	if err != nil {
+		if err = writeRegistry(path); err != nil {
+			return 0, err
+		}
+		if file, mem, segments, err = mapRegistry(path); err != nil {
+			return 0, err
+		}
+	}
+	tracerRegistry.Lock()
+	// Any previous mapping is leaked deliberately: racing instantiations may
+	// still be loading out of it, and there is exactly one swap per process.
+	tracerRegistry.file, tracerRegistry.mem, tracerRegistry.segments = file, mem, segments
+	tracerRegistry.Unlock()
+
+	return len(segments), nil
+}
+
+// mapRegistry maps the registry file at path read-only and indexes its
+// bytecode segments. It fails if the file is malformed or misses any of the
+// tracers this release ships, so the caller can rebuild it.
+func mapRegistry(path string) (*os.File, mmap.MMap, map[common.Hash][]byte, error) {
+	file, err := os.OpenFile(path, os.O_RDONLY, 0644)
+	if err != nil {
+		return nil, nil, nil, err
+	}
+	mem, err := mmap.Map(file, mmap.RDONLY, 0)
+	if err != nil {
+		file.Close()
+		return nil, nil, nil, err
+	}
+	segments, err := parseRegistry(mem)
+	if err != nil {
+		mem.Unmap()
+		file.Close()
+		return nil, nil, nil, err
+	}
+	return file, mem, segments, nil
+}
+
+// parseRegistry indexes the bytecode segments of a mapped registry file,
+// returning slices pointing into the mapping itself.
+func parseRegistry(data []byte) (map[common.Hash][]byte, error) {
+	if len(data) < len(registryMagic)+4 || string(data[:len(registryMagic)]) != string(registryMagic) {
+		return nil, errInvalidRegistry
+	}
+	count := binary.LittleEndian.Uint32(data[len(registryMagic):])
+	data = data[len(registryMagic)+4:]
+
+	segments := make(map[common.Hash][]byte, count)
+	for i := uint32(0); i < count; i++ {
+		if len(data) < common.HashLength+4 {
+			return nil, errInvalidRegistry
+		}
+		var key common.Hash
+		copy(key[:], data[:common.HashLength])
+
+		size := binary.LittleEndian.Uint32(data[common.HashLength:])
+		data = data[common.HashLength+4:]
+		if uint32(len(data)) < size {
+			return nil, errInvalidRegistry
+		}
+		segments[key] = data[:size:size]
+		data = data[size:]
+	}
+	// Refuse mappings predating the current tracer set so they get rebuilt
+	for _, src := range registrySources() {
+		if _, ok := segments[crypto.Keccak256Hash([]byte(src))]; !ok {
+			return nil, errInvalidRegistry
+		}
+	}
+	return segments, nil
+}
+
+// writeRegistry compiles the built in tracers in a throwaway VM and publishes
+// their bytecode dumps atomically at path, via a temporary file and a rename.
+func writeRegistry(path string) error {
+	vm := duktape.New()
+	defer vm.DestroyHeap()
+
+	sources := registrySources()
+
+	blob := append([]byte{}, registryMagic...)
+	blob = append(blob, make([]byte, 4)...)
+	binary.LittleEndian.PutUint32(blob[len(registryMagic):], uint32(len(sources)))
+
+	for _, src := range sources {
+		if err := vm.PcompileString(duktape.CompileEval, src); err != nil {
+			return err
+		}
+		vm.DumpFunction()
+		ptr, size := vm.GetBuffer(-1)
+		if ptr == nil {
+			vm.Pop()
+			return errInvalidRegistry
+		}
+		blob = append(blob, crypto.Keccak256([]byte(src))...)
+		blob = append(blob, make([]byte, 4)...)
+		binary.LittleEndian.PutUint32(blob[len(blob)-4:], uint32(size))
+		blob = append(blob, makeSlice(ptr, size)...)
+		vm.Pop()
+	}
+	// Ensure the data folder exists and publish the registry atomically
+	if err := os.MkdirAll(filepath.Dir(path), 0755); err != nil {
+		return err
+	}
+	temp := path + "." + strconv.Itoa(rand.Int())
+	if err := ioutil.WriteFile(temp, blob, 0644); err != nil {
+		return err
+	}
+	return os.Rename(temp, path)
+}
@@ -20,13 +20,17 @@ import (
 	"bytes"
 	"encoding/json"
 	"errors"
+	"io/ioutil"
 	"math/big"
+	"os"
+	"path/filepath"
 	"testing"
 	"time"
 
 	"github.com/ethereumai/go-ethereumai/common"
 	"github.com/ethereumai/go-ethereumai/core/vm"
 	"github.com/ethereumai/go-ethereumai/params"
+	duktape "gopkg.in/olebedev/go-duktape.v3"
 )
 
 type account struct{}
@@ -71,6 +75,25 @@ func TestTracing(t *testing.T) {
 	}
 }
 
+func TestPooledPropkeys(t *testing.T) {
+	// The pinned callback keys must survive VM reuse: the later rounds run
+	// on recycled heaps whose registries were pinned by the earlier ones,
+	// and every round must deliver identical results through them.
+	for round := 0; round < 3; round++ {
+		tracer, err := New("{count: 0, step: function(log, db) { this.count += 1; }, fault: function() {}, result: function() { return this.count; }}")
+		if err != nil {
+			t.Fatalf("round %d: %v", round, err)
+		}
+		ret, err := runTrace(tracer)
+		if err != nil {
+			t.Fatalf("round %d: %v", round, err)
+		}
+		if !bytes.Equal(ret, []byte("3")) {
+			t.Errorf("round %d: expected return value to be 3, got %s", round, string(ret))
+		}
+	}
+}
+
 func TestStack(t *testing.T) {
 	tracer, err := New("{depths: [], step: function(log) { this.depths.push(log.stack.length()); }, fault: function() {}, result: function() { return this.depths; }}")
 	if err != nil {
@@ -86,6 +109,23 @@ func TestStack(t *testing.T) {
 	}
 }
 
+func TestWordAccessors(t *testing.T) {
+	// The native getUint256 views must match peek indexing and degrade to
+	// undefined when out of range or when the memory buffer is empty
+	tracer, err := New("{words: [], step: function(log) { for (var i = 0; i < log.stack.length(); i++) { this.words.push(log.stack.getUint256(i)[31]); } if (log.stack.getUint256(log.stack.length()) !== undefined) { this.words.push(-1); } if (log.memory.getUint256(0) !== undefined) { this.words.push(-2); } }, fault: function() {}, result: function() { return this.words; }}")
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	ret, err := runTrace(tracer)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(ret, []byte("[1,1,1]")) {
+		t.Errorf("Expected return value to be [1,1,1], got %s", string(ret))
+	}
+}
+
 func TestOpcodes(t *testing.T) {
 	tracer, err := New("{opcodes: [], step: function(log) { this.opcodes.push(log.op.toString()); }, fault: function() {}, result: function() { return this.opcodes; }}")
 	if err != nil {
@@ -101,11 +141,64 @@ func TestOpcodes(t *testing.T) {
 	}
 }
 
-func TestHalt(t *testing.T) {
-	t.Skip("duktape doesn't support abortion")
+func TestStepBatching(t *testing.T) {
+	// Decode the opcode byte out of each packed record to verify both the
+	// batch delivery and the record layout
+	tracer, err := New("{ops: [], stepBatch: function(batch) { for (var i = 0; i < batch.length; i += 32) { this.ops.push(batch[i+24]); } }, fault: function() {}, result: function() { return this.ops; }}")
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	ret, err := runTrace(tracer)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(ret, []byte("[96,96,0]")) {
+		t.Errorf("Expected return value to be [96,96,0], got %s", string(ret))
+	}
+}
+
+func TestTracerRegistry(t *testing.T) {
+	// Build the registry in a scratch folder, make sure a second load serves
+	// the same tracer set from the published file, and that a built in tracer
+	// instantiated out of the mapping still runs
+	dir, err := ioutil.TempDir("", "tracer-registry")
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer os.RemoveAll(dir)
+
+	path := filepath.Join(dir, "tracers.bin")
+	built, err := LoadTracerRegistry(path)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if want := len(all) + 1; built != want { // every built in tracer plus the big integer library
+		t.Errorf("registry size mismatch: have %d, want %d", built, want)
+	}
+	mapped, err := LoadTracerRegistry(path)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if mapped != built {
+		t.Errorf("remapped registry size mismatch: have %d, want %d", mapped, built)
+	}
+	tracer, err := New("opcountTracer")
+	if err != nil {
+		t.Fatal(err)
+	}
+	ret, err := runTrace(tracer)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(ret, []byte("3")) {
+		t.Errorf("Expected return value to be 3, got %s", string(ret))
+	}
+}
 
+func TestHalt(t *testing.T) {
 	timeout := errors.New("stahp")
-	tracer, err := New("{step: function() { while(1); }, result: function() { return null; }}")
+	tracer, err := New("{step: function() { while(1); }, fault: function() {}, result: function() { return null; }}")
 	if err != nil {
 		t.Fatal(err)
 	}
@@ -120,6 +213,59 @@ func TestHalt(t *testing.T) {
 	}
 }
 
+func TestHeapBudget(t *testing.T) {
+	// A script growing its heap without bound must fail inside its own VM
+	// with an out-of-memory error instead of dragging the process down
+	exceeded := 0
+	vm, budget := duktape.NewWithBudget(2*1024*1024, func(used, limit, requested uint64) { exceeded++ })
+	defer func() {
+		vm.DestroyHeap()
+		budget.Destroy()
+	}()
+
+	// The trailing counter keeps the strings unique, duktape interns equal
+	// strings so identical ones would share a single allocation
+	if err := vm.PevalString("var hog = []; for (var i = 0; i < 1000; i++) { hog.push(new Array(65536).join('x') + i); }"); err == nil {
+		t.Fatalf("unbounded allocation did not error")
+	}
+	if exceeded == 0 {
+		t.Errorf("out-of-budget callback not invoked")
+	}
+	if budget.Peak() == 0 || budget.Used() > budget.Peak() {
+		t.Errorf("implausible accounting: used %d, peak %d", budget.Used(), budget.Peak())
+	}
+}
+
+func TestProfiling(t *testing.T) {
+	// A tracer burning its time inside a named helper must show up with that
+	// helper dominating the sampled profile
+	tracer, err := New("{burn: function burn() { var a = 0; for (var i = 0; i < 1000000; i++) { a += i % 7; } return a; }, step: function(log) { this.burn(); }, fault: function() {}, result: function() { return null; }}")
+	if err != nil {
+		t.Fatal(err)
+	}
+	tracer.StartProfiling(250 * time.Microsecond)
+
+	if _, err = runTrace(tracer); err != nil {
+		t.Fatal(err)
+	}
+	profile := tracer.StopProfiling()
+	if len(profile) == 0 {
+		t.Fatalf("no call-stack samples captured")
+	}
+	burned := false
+	for _, entry := range profile {
+		if entry.Name == "burn" {
+			burned = true
+			if entry.Self == 0 || entry.Total < entry.Self {
+				t.Errorf("implausible sample counts for burn: self %d, total %d", entry.Self, entry.Total)
+			}
+		}
+	}
+	if !burned {
+		t.Errorf("hot function missing from profile: %v", profile)
+	}
+}
+
 func TestHaltBetweenSteps(t *testing.T) {
 	tracer, err := New("{step: function() {}, fault: function() {}, result: function() { return null; }}")
 	if err != nil {
@@ -112,26 +112,42 @@ func (s *PublicTxPoolAPI) Content() map[string]map[string]map[string]*RPCTransac
 		"queued":  make(map[string]map[string]*RPCTransaction),
 	}
 	pending, queue := s.b.TxPoolContent()
+	accounts, hexes := checksumPoolAccounts(pending, queue)
 
 	// Flatten the pending transactions
-	for account, txs := range pending {
+	for i, account := range accounts[:len(pending)] {
 		dump := make(map[string]*RPCTransaction)
-		for _, tx := range txs {
+		for _, tx := range pending[account] {
 			dump[fmt.Sprintf("%d", tx.Nonce())] = newRPCPendingTransaction(tx)
 		}
-		content["pending"][account.Hex()] = dump
+		content["pending"][hexes[i]] = dump
 	}
 	// Flatten the queued transactions
-	for account, txs := range queue {
+	for i, account := range accounts[len(pending):] {
 		dump := make(map[string]*RPCTransaction)
-		for _, tx := range txs {
+		for _, tx := range queue[account] {
 			dump[fmt.Sprintf("%d", tx.Nonce())] = newRPCPendingTransaction(tx)
 		}
-		content["queued"][account.Hex()] = dump
+		content["queued"][hexes[len(pending)+i]] = dump
 	}
 	return content
 }
 
+// checksumPoolAccounts renders the account addresses of a pool content dump
+// as EIP-55 checksummed strings in one native batch, instead of one
+// Keccak-256 per address. It returns the accounts in rendering order, pending
+// ones first, alongside their checksummed forms.
+func checksumPoolAccounts(pending, queue map[common.Address]types.Transactions) ([]common.Address, []string) {
+	accounts := make([]common.Address, 0, len(pending)+len(queue))
+	for account := range pending {
+		accounts = append(accounts, account)
+	}
+	for account := range queue {
+		accounts = append(accounts, account)
+	}
+	return accounts, crypto.ChecksumAddresses(accounts)
+}
+
 // Status returns the number of pending and queued transaction in the pool.
 func (s *PublicTxPoolAPI) Status() map[string]hexutil.Uint {
 	pending, queue := s.b.Stats()
@@ -149,6 +165,7 @@ func (s *PublicTxPoolAPI) Inspect() map[string]map[string]map[string]string {
 		"queued":  make(map[string]map[string]string),
 	}
 	pending, queue := s.b.TxPoolContent()
+	accounts, hexes := checksumPoolAccounts(pending, queue)
 
 	// Define a formatter to flatten a transaction into a string
 	var format = func(tx *types.Transaction) string {
@@ -158,20 +175,20 @@ func (s *PublicTxPoolAPI) Inspect() map[string]map[string]map[string]string {
 		return fmt.Sprintf("contract creation: %v wei + %v gas × %v wei", tx.Value(), tx.Gas(), tx.GasPrice())
 	}
 	// Flatten the pending transactions
-	for account, txs := range pending {
+	for i, account := range accounts[:len(pending)] {
 		dump := make(map[string]string)
-		for _, tx := range txs {
+		for _, tx := range pending[account] {
 			dump[fmt.Sprintf("%d", tx.Nonce())] = format(tx)
 		}
-		content["pending"][account.Hex()] = dump
+		content["pending"][hexes[i]] = dump
 	}
 	// Flatten the queued transactions
-	for account, txs := range queue {
+	for i, account := range accounts[len(pending):] {
 		dump := make(map[string]string)
-		for _, tx := range txs {
+		for _, tx := range queue[account] {
 			dump[fmt.Sprintf("%d", tx.Nonce())] = format(tx)
 		}
-		content["queued"][account.Hex()] = dump
+		content["queued"][hexes[len(pending)+i]] = dump
 	}
 	return content
 }
@@ -41,6 +41,7 @@ const (
 	datadirStaticNodes     = "static-nodes.json"  // Path within the datadir to the static node list
 	datadirTrustedNodes    = "trusted-nodes.json" // Path within the datadir to the trusted node list
 	datadirNodeDatabase    = "nodes"              // Path within the datadir to store the node infos
+	datadirWarmState       = "warmstate"          // Path within the datadir to the native warm-cache snapshot
 )
 
 // Config represents a small collection of configuration values to fine tune the
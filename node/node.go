@@ -27,6 +27,7 @@ import (
 	"sync"
 
 	"github.com/ethereumai/go-ethereumai/accounts"
+	"github.com/ethereumai/go-ethereumai/crypto"
 	"github.com/ethereumai/go-ethereumai/eaidb"
 	"github.com/ethereumai/go-ethereumai/event"
 	"github.com/ethereumai/go-ethereumai/internal/debug"
@@ -146,6 +147,14 @@ func (n *Node) Start() error {
 	if err := n.openDataDir(); err != nil {
 		return err
 	}
+	// Reload any native warm-cache snapshot left by the previous run, so the
+	// first blocks import at steady-state speed instead of repopulating the
+	// caches for minutes.
+	if path := n.config.resolvePath(datadirWarmState); path != "" {
+		if restored := crypto.RestoreWarmState(path); restored > 0 {
+			n.log.Debug("Restored native warm state", "sections", restored)
+		}
+	}
 
 	// Initialize the p2p server. This creates the node key and
 	// discovery databases.
@@ -424,6 +433,14 @@ func (n *Node) Stop() error {
 	n.services = nil
 	n.server = nil
 
+	// With the services and the p2p server down the signature workload has
+	// quiesced; snapshot the native warm caches so the next start is warm.
+	if path := n.config.resolvePath(datadirWarmState); path != "" {
+		if err := crypto.SaveWarmState(path); err != nil {
+			n.log.Error("Failed to save native warm state", "err", err)
+		}
+	}
+
 	// Release instance directory lock.
 	if n.instanceDirLock != nil {
 		if err := n.instanceDirLock.Release(); err != nil {